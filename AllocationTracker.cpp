@@ -0,0 +1,189 @@
+#include "AllocationTracker.h"
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+#ifdef _WIN32
+#include <Windows.h>
+#include <malloc.h>
+#endif
+
+namespace {
+
+// operator new より先に使われても困らないよう、定数初期化される静的領域に置く
+constinit AllocationTracker gInstance;
+
+const char* const kTagNames[] = {"untagged", "scene", "enemy", "hitEffect", "deathParticles", "fireworks", "ghost"};
+
+} // namespace
+
+thread_local AllocationTag AllocationTracker::currentTag_ = AllocationTag::kUntagged;
+
+/// <summary>
+/// インスタンスの取得
+/// </summary>
+/// <returns></returns>
+AllocationTracker* AllocationTracker::GetInstance() { return &gInstance; }
+
+/// <summary>
+/// 確保を記録（operator new から呼ばれる。ここでは確保しないこと）
+/// </summary>
+/// <param name="size"></param>
+void AllocationTracker::RecordAllocation(size_t size) {
+	size_t tag = static_cast<size_t>(currentTag_);
+
+	frameAllocations_.fetch_add(1, std::memory_order_relaxed);
+	frameBytes_.fetch_add(size, std::memory_order_relaxed);
+	frameTagAllocations_[tag].fetch_add(1, std::memory_order_relaxed);
+	frameTagBytes_[tag].fetch_add(size, std::memory_order_relaxed);
+}
+
+/// <summary>
+/// フレームの区切り（前のフレームを締めて検査する。メインループの先頭で呼ぶ）
+/// </summary>
+void AllocationTracker::BeginFrame() {
+	lastFrame_.allocations = frameAllocations_.exchange(0, std::memory_order_relaxed);
+	lastFrame_.bytes = frameBytes_.exchange(0, std::memory_order_relaxed);
+	lastFrame_.frees = frameFrees_.exchange(0, std::memory_order_relaxed);
+	for (size_t i = 0; i < lastFrame_.tagAllocations.size(); ++i) {
+		lastFrame_.tagAllocations[i] = frameTagAllocations_[i].exchange(0, std::memory_order_relaxed);
+		lastFrame_.tagBytes[i] = frameTagBytes_[i].exchange(0, std::memory_order_relaxed);
+	}
+
+	total_.allocations += lastFrame_.allocations;
+	total_.bytes += lastFrame_.bytes;
+	total_.frees += lastFrame_.frees;
+	for (size_t i = 0; i < total_.tagAllocations.size(); ++i) {
+		total_.tagAllocations[i] += lastFrame_.tagAllocations[i];
+		total_.tagBytes[i] += lastFrame_.tagBytes[i];
+	}
+
+	// 定常状態が続いていれば検査
+	if (isSteadyState_) {
+		if (steadyFrames_ >= kSteadyStateWarmupFrames && lastFrame_.allocations > 0) {
+			++steadyStateViolations_;
+			ReportSteadyStateAllocation();
+		}
+		++steadyFrames_;
+	} else {
+		steadyFrames_ = 0;
+	}
+	isSteadyState_ = false;
+}
+
+/// <summary>
+/// 分類名
+/// </summary>
+/// <param name="tag"></param>
+/// <returns></returns>
+const char* AllocationTracker::GetTagName(AllocationTag tag) { return kTagNames[static_cast<size_t>(tag)]; }
+
+/// <summary>
+/// 定常状態での確保を報告（ALLOCATION_TRACKER_STRICT なら assert で止める）
+/// </summary>
+void AllocationTracker::ReportSteadyStateAllocation() const {
+	// 確保しないよう固定長のバッファに書く
+	char message[512];
+	int length = std::snprintf(message, sizeof(message), "steady-state allocation: %llu allocs, %llu bytes", static_cast<unsigned long long>(lastFrame_.allocations),
+	                           static_cast<unsigned long long>(lastFrame_.bytes));
+	for (size_t i = 0; i < lastFrame_.tagAllocations.size() && length > 0 && static_cast<size_t>(length) < sizeof(message); ++i) {
+		if (lastFrame_.tagAllocations[i] > 0) {
+			length += std::snprintf(message + length, sizeof(message) - static_cast<size_t>(length), " [%s %llu]", kTagNames[i], static_cast<unsigned long long>(lastFrame_.tagAllocations[i]));
+		}
+	}
+
+#ifdef _WIN32
+	OutputDebugStringA(message);
+	OutputDebugStringA("\n");
+#else
+	std::fprintf(stderr, "%s\n", message);
+#endif
+
+#ifdef ALLOCATION_TRACKER_STRICT
+	assert(!"allocation during steady-state play");
+#endif
+}
+
+#ifdef ALLOCATION_TRACKER_ENABLED
+
+///====================================================
+/// グローバルな operator new / delete の差し替え
+///====================================================
+
+namespace {
+
+void* Allocate(size_t size) {
+	AllocationTracker::GetInstance()->RecordAllocation(size);
+	return std::malloc(size != 0 ? size : 1);
+}
+
+void* AllocateAligned(size_t size, std::align_val_t alignment) {
+	AllocationTracker::GetInstance()->RecordAllocation(size);
+	size_t align = static_cast<size_t>(alignment);
+#ifdef _WIN32
+	return _aligned_malloc(size != 0 ? size : 1, align);
+#else
+	// aligned_alloc はサイズがアラインメントの倍数である必要がある
+	size_t rounded = (size + align - 1) / align * align;
+	return std::aligned_alloc(align, rounded != 0 ? rounded : align);
+#endif
+}
+
+void Free(void* pointer) {
+	if (pointer) {
+		AllocationTracker::GetInstance()->RecordFree();
+		std::free(pointer);
+	}
+}
+
+void FreeAligned(void* pointer) {
+	if (pointer) {
+		AllocationTracker::GetInstance()->RecordFree();
+#ifdef _WIN32
+		_aligned_free(pointer);
+#else
+		std::free(pointer);
+#endif
+	}
+}
+
+} // namespace
+
+void* operator new(size_t size) {
+	void* pointer = Allocate(size);
+	if (!pointer) {
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+void* operator new[](size_t size) { return operator new(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+
+void operator delete(void* pointer) noexcept { Free(pointer); }
+void operator delete[](void* pointer) noexcept { Free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { Free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { Free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { Free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { Free(pointer); }
+
+void* operator new(size_t size, std::align_val_t alignment) {
+	void* pointer = AllocateAligned(size, alignment);
+	if (!pointer) {
+		throw std::bad_alloc();
+	}
+	return pointer;
+}
+void* operator new[](size_t size, std::align_val_t alignment) { return operator new(size, alignment); }
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept { return AllocateAligned(size, alignment); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete(void* pointer, size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { FreeAligned(pointer); }
+
+#endif
@@ -0,0 +1,159 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+// デバッグビルドか ENABLE_ALLOCATION_TRACKER 指定時だけ operator new を差し替えて数える
+#if (defined(_DEBUG) || defined(ENABLE_ALLOCATION_TRACKER)) && !defined(DISABLE_ALLOCATION_TRACKER)
+#define ALLOCATION_TRACKER_ENABLED
+#endif
+
+// デバッグビルドでは定常状態での確保を assert で止める（DISABLE_ALLOCATION_TRACKER_STRICT で報告だけにできる）
+#if defined(ALLOCATION_TRACKER_ENABLED) && defined(_DEBUG) && !defined(DISABLE_ALLOCATION_TRACKER_STRICT) && !defined(ALLOCATION_TRACKER_STRICT)
+#define ALLOCATION_TRACKER_STRICT
+#endif
+
+/// <summary>
+/// 確保元の分類（ALLOCATION_TAG のスコープ中の確保がここに計上される）
+/// </summary>
+enum class AllocationTag : uint8_t {
+	kUntagged,       // 指定なし
+	kScene,          // シーンの生成・Reset
+	kEnemy,          // 敵とそのリスト
+	kHitEffect,      // ヒットエフェクトとそのリスト
+	kDeathParticles, // 死亡パーティクル
+	kFireworks,      // 花火
+	kGhost,          // ゴーストの記録
+
+	kCount // 要素数
+};
+
+/// <summary>
+/// ヒープ確保の回数・バイト数をフレームごと、分類ごとに数える
+/// </summary>
+class AllocationTracker {
+public:
+	// 1フレーム分（または累計）の数
+	struct Counts {
+		uint64_t allocations = 0; // 確保回数
+		uint64_t bytes = 0;       // 確保したバイト数
+		uint64_t frees = 0;       // 解放回数
+		std::array<uint64_t, static_cast<size_t>(AllocationTag::kCount)> tagAllocations{};
+		std::array<uint64_t, static_cast<size_t>(AllocationTag::kCount)> tagBytes{};
+	};
+
+	// 定常状態に入ってから検査を始めるまでのフレーム数（初回だけの確保を見逃す）
+	static inline const uint32_t kSteadyStateWarmupFrames = 60;
+
+private:
+	// 今のフレームの数（どのスレッドからも足される）
+	std::atomic<uint64_t> frameAllocations_;
+	std::atomic<uint64_t> frameBytes_;
+	std::atomic<uint64_t> frameFrees_;
+	std::array<std::atomic<uint64_t>, static_cast<size_t>(AllocationTag::kCount)> frameTagAllocations_;
+	std::array<std::atomic<uint64_t>, static_cast<size_t>(AllocationTag::kCount)> frameTagBytes_;
+
+	// 直前のフレームと累計（メインスレッドの BeginFrame でだけ更新）
+	Counts lastFrame_;
+	Counts total_;
+
+	// 今のフレームが定常状態か（MarkSteadyState で毎フレーム立てる）
+	bool isSteadyState_ = false;
+	// 定常状態が何フレーム続いているか
+	uint32_t steadyFrames_ = 0;
+	// 定常状態で確保したフレーム数
+	uint64_t steadyStateViolations_ = 0;
+
+	// 呼んだスレッドの今の分類
+	static thread_local AllocationTag currentTag_;
+
+public:
+	/// <summary>
+	/// インスタンスの取得
+	/// </summary>
+	/// <returns></returns>
+	static AllocationTracker* GetInstance();
+	/// <summary>
+	/// このビルドで数えているか
+	/// </summary>
+	/// <returns></returns>
+	static constexpr bool IsEnabled() {
+#ifdef ALLOCATION_TRACKER_ENABLED
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	/// <summary>
+	/// 確保を記録（operator new から呼ばれる。ここでは確保しないこと）
+	/// </summary>
+	/// <param name="size"></param>
+	void RecordAllocation(size_t size);
+	/// <summary>
+	/// 解放を記録（operator delete から呼ばれる）
+	/// </summary>
+	void RecordFree() { frameFrees_.fetch_add(1, std::memory_order_relaxed); }
+
+	/// <summary>
+	/// フレームの区切り（前のフレームを締めて検査する。メインループの先頭で呼ぶ）
+	/// </summary>
+	void BeginFrame();
+	/// <summary>
+	/// 今のフレームは定常状態（確保が無いはず）だと印を付ける
+	/// </summary>
+	void MarkSteadyState() { isSteadyState_ = true; }
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const Counts& GetLastFrame() const { return lastFrame_; }
+	const Counts& GetTotal() const { return total_; }
+	uint64_t GetSteadyStateViolations() const { return steadyStateViolations_; }
+
+	/// <summary>
+	/// 呼んだスレッドの分類
+	/// </summary>
+	static AllocationTag GetCurrentTag() { return currentTag_; }
+	static void SetCurrentTag(AllocationTag tag) { currentTag_ = tag; }
+
+	/// <summary>
+	/// 分類名
+	/// </summary>
+	/// <param name="tag"></param>
+	/// <returns></returns>
+	static const char* GetTagName(AllocationTag tag);
+
+private:
+	/// <summary>
+	/// 定常状態での確保を報告（ALLOCATION_TRACKER_STRICT なら assert で止める）
+	/// </summary>
+	void ReportSteadyStateAllocation() const;
+};
+
+/// <summary>
+/// スコープ中の確保を tag に計上する
+/// </summary>
+class AllocationTagScope {
+private:
+	AllocationTag previous_;
+
+public:
+	explicit AllocationTagScope(AllocationTag tag) : previous_(AllocationTracker::GetCurrentTag()) { AllocationTracker::SetCurrentTag(tag); }
+	~AllocationTagScope() { AllocationTracker::SetCurrentTag(previous_); }
+
+	AllocationTagScope(const AllocationTagScope&) = delete;
+	AllocationTagScope& operator=(const AllocationTagScope&) = delete;
+};
+
+#define ALLOCATION_TRACKER_CONCAT_INNER(a, b) a##b
+#define ALLOCATION_TRACKER_CONCAT(a, b) ALLOCATION_TRACKER_CONCAT_INNER(a, b)
+
+#ifdef ALLOCATION_TRACKER_ENABLED
+// スコープ中の確保の分類（AllocationTag::k○○ を渡す）
+#define ALLOCATION_TAG(tag) AllocationTagScope ALLOCATION_TRACKER_CONCAT(allocationTag_, __LINE__)(tag)
+#else
+#define ALLOCATION_TAG(tag) ((void)0)
+#endif
@@ -0,0 +1,140 @@
+#include "AssetCache.h"
+#include <iterator>
+
+using namespace KamataEngine;
+
+/// <summary>
+/// インスタンスの取得
+/// </summary>
+/// <returns></returns>
+AssetCache* AssetCache::GetInstance() {
+	static AssetCache instance;
+	return &instance;
+}
+
+/// <summary>
+/// モデルを取得（無ければ読み込む）。使い終わったら ReleaseModel で返す
+/// </summary>
+/// <param name="name">Resources 下のモデル名</param>
+/// <param name="smoothing">スムージング</param>
+/// <returns></returns>
+Model* AssetCache::AcquireModel(const std::string& name, bool smoothing) {
+	std::string key = MakeKey(name, smoothing);
+
+	auto it = models_.find(key);
+	if (it != models_.end()) {
+		++stats_.hits;
+		++it->second.refCount;
+		return it->second.model;
+	}
+
+	++stats_.misses;
+
+	ModelEntry entry;
+	entry.model = Model::CreateFromOBJ(name, smoothing);
+	entry.refCount = 1;
+	entry.keepAlive = defaultKeepAlive_;
+
+	modelKeys_[entry.model] = key;
+	models_.emplace(key, entry);
+
+	return entry.model;
+}
+
+/// <summary>
+/// モデルの参照を返す（nullptrやキャッシュ外のモデルは無視）
+/// </summary>
+/// <param name="model"></param>
+void AssetCache::ReleaseModel(const Model* model) {
+	if (!model) {
+		return;
+	}
+
+	auto keyIt = modelKeys_.find(model);
+	if (keyIt == modelKeys_.end()) {
+		return;
+	}
+
+	auto it = models_.find(keyIt->second);
+	if (it->second.refCount == 0) {
+		return;
+	}
+
+	++stats_.releases;
+	--it->second.refCount;
+
+	if (it->second.refCount == 0 && it->second.keepAlive == KeepAlive::kNone) {
+		Evict(it);
+	}
+}
+
+/// <summary>
+/// 参照が0になったときの扱いを設定
+/// </summary>
+/// <param name="name"></param>
+/// <param name="smoothing"></param>
+/// <param name="keepAlive"></param>
+void AssetCache::SetKeepAlive(const std::string& name, bool smoothing, KeepAlive keepAlive) {
+	auto it = models_.find(MakeKey(name, smoothing));
+	if (it == models_.end()) {
+		return;
+	}
+
+	it->second.keepAlive = keepAlive;
+
+	if (it->second.refCount == 0 && keepAlive == KeepAlive::kNone) {
+		Evict(it);
+	}
+}
+
+/// <summary>
+/// 参照0で kUntilTrim のモデルを解放
+/// </summary>
+void AssetCache::Trim() {
+	for (auto it = models_.begin(); it != models_.end();) {
+		auto next = std::next(it);
+		if (it->second.refCount == 0 && it->second.keepAlive != KeepAlive::kForever) {
+			Evict(it);
+		}
+		it = next;
+	}
+}
+
+/// <summary>
+/// 全て解放（エンジン終了前に呼ぶ）
+/// </summary>
+void AssetCache::Finalize() {
+	for (auto& [key, entry] : models_) {
+		delete entry.model;
+		++stats_.evictions;
+	}
+	models_.clear();
+	modelKeys_.clear();
+}
+
+/// <summary>
+/// 参照数の取得（キャッシュに無ければ0）
+/// </summary>
+/// <param name="name"></param>
+/// <param name="smoothing"></param>
+/// <returns></returns>
+uint32_t AssetCache::GetRefCount(const std::string& name, bool smoothing) const {
+	auto it = models_.find(MakeKey(name, smoothing));
+	return it != models_.end() ? it->second.refCount : 0;
+}
+
+/// <summary>
+/// キャッシュのキー
+/// </summary>
+std::string AssetCache::MakeKey(const std::string& name, bool smoothing) { return smoothing ? name + "#smooth" : name; }
+
+/// <summary>
+/// モデルの解放
+/// </summary>
+void AssetCache::Evict(std::unordered_map<std::string, ModelEntry>::iterator it) {
+	modelKeys_.erase(it->second.model);
+	delete it->second.model;
+	models_.erase(it);
+
+	++stats_.evictions;
+}
@@ -0,0 +1,116 @@
+#pragma once
+#include "KamataEngine.h"
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/// <summary>
+/// シーンをまたいで共有するアセットのキャッシュ（名前で引き、参照カウントで管理）
+/// </summary>
+class AssetCache {
+public:
+	// 参照が0になったときの扱い
+	enum class KeepAlive {
+		kNone,      // すぐに解放
+		kUntilTrim, // Trim() まで残す（シーン切り替えをまたいで再利用）
+		kForever,   // Finalize() まで残す
+	};
+
+	// 統計
+	struct Stats {
+		uint32_t hits = 0;      // キャッシュから返した回数
+		uint32_t misses = 0;    // 読み込んだ回数
+		uint32_t releases = 0;  // 参照を返された回数
+		uint32_t evictions = 0; // 解放した回数
+	};
+
+private:
+	// モデル1個分
+	struct ModelEntry {
+		KamataEngine::Model* model = nullptr;
+		uint32_t refCount = 0;
+		KeepAlive keepAlive = KeepAlive::kUntilTrim;
+	};
+
+	// キー（名前＋スムージング）→ モデル
+	std::unordered_map<std::string, ModelEntry> models_;
+	// モデル → キー（解放時の逆引き）
+	std::unordered_map<const KamataEngine::Model*, std::string> modelKeys_;
+
+	// 新しく読み込んだモデルの既定の扱い
+	KeepAlive defaultKeepAlive_ = KeepAlive::kUntilTrim;
+
+	Stats stats_;
+
+public:
+	/// <summary>
+	/// インスタンスの取得
+	/// </summary>
+	/// <returns></returns>
+	static AssetCache* GetInstance();
+
+	/// <summary>
+	/// モデルを取得（無ければ読み込む）。使い終わったら ReleaseModel で返す
+	/// </summary>
+	/// <param name="name">Resources 下のモデル名</param>
+	/// <param name="smoothing">スムージング</param>
+	/// <returns></returns>
+	KamataEngine::Model* AcquireModel(const std::string& name, bool smoothing = false);
+	/// <summary>
+	/// モデルの参照を返す（nullptrやキャッシュ外のモデルは無視）
+	/// </summary>
+	/// <param name="model"></param>
+	void ReleaseModel(const KamataEngine::Model* model);
+
+	/// <summary>
+	/// 参照が0になったときの扱いを設定
+	/// </summary>
+	/// <param name="name"></param>
+	/// <param name="smoothing"></param>
+	/// <param name="keepAlive"></param>
+	void SetKeepAlive(const std::string& name, bool smoothing, KeepAlive keepAlive);
+	/// <summary>
+	/// 新しく読み込むモデルの既定の扱いを設定
+	/// </summary>
+	/// <param name="keepAlive"></param>
+	void SetDefaultKeepAlive(KeepAlive keepAlive) { defaultKeepAlive_ = keepAlive; }
+
+	/// <summary>
+	/// 参照0で kUntilTrim のモデルを解放
+	/// </summary>
+	void Trim();
+	/// <summary>
+	/// 全て解放（エンジン終了前に呼ぶ）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 統計のリセット
+	/// </summary>
+	void ResetStats() { stats_ = {}; }
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const Stats& GetStats() const { return stats_; }
+	uint32_t GetModelCount() const { return static_cast<uint32_t>(models_.size()); }
+	uint32_t GetRefCount(const std::string& name, bool smoothing = false) const;
+
+private:
+	AssetCache() = default;
+	~AssetCache() = default;
+	AssetCache(const AssetCache&) = delete;
+	AssetCache& operator=(const AssetCache&) = delete;
+
+	/// <summary>
+	/// キャッシュのキー
+	/// </summary>
+	static std::string MakeKey(const std::string& name, bool smoothing);
+
+	/// <summary>
+	/// モデルの解放
+	/// </summary>
+	void Evict(std::unordered_map<std::string, ModelEntry>::iterator it);
+};
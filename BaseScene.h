@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include <vector>
+
+/// <summary>
+/// シーンの基底（SceneManager が持ち続け、再入場は Reset で行う）
+/// </summary>
+class BaseScene {
+public:
+	/// <summary>
+	/// デストラクタ
+	/// </summary>
+	virtual ~BaseScene() = default;
+
+	/// <summary>
+	/// 準備処理（ワーカースレッドで呼べる。GPUリソースには触れない）
+	/// </summary>
+	virtual void Prepare() {}
+	/// <summary>
+	/// 初期化処理（最初の1回だけ）
+	/// </summary>
+	virtual void Initialize() = 0;
+	/// <summary>
+	/// 確保済みのものを使い回して開始時の状態に戻す
+	/// </summary>
+	virtual void Reset() = 0;
+	/// <summary>
+	/// 更新処理
+	/// </summary>
+	virtual void Update() = 0;
+	/// <summary>
+	/// 描画処理
+	/// </summary>
+	virtual void Draw() = 0;
+
+	/// <summary>
+	/// シーンが終わったか
+	/// </summary>
+	/// <returns></returns>
+	virtual bool IsFinished() const = 0;
+	/// <summary>
+	/// 終わったあと、同じシーンをやり直すか
+	/// </summary>
+	/// <returns></returns>
+	virtual bool IsRetryRequested() const { return false; }
+
+	/// <summary>
+	/// Initialize で AssetCache から取るモデル（全てスムージングあり）。切り替え前に1フレーム1個ずつ読み込んでおく
+	/// </summary>
+	/// <returns></returns>
+	virtual const std::vector<std::string>& GetModelNames() const {
+		static const std::vector<std::string> kNone;
+		return kNone;
+	}
+};
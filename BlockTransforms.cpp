@@ -0,0 +1,85 @@
+#define NOMINMAX
+#include "BlockTransforms.h"
+#include "JobSystem.h"
+#include "WorldTransformUpdater.h"
+
+using namespace KamataEngine;
+
+/// <summary>
+/// インスタンスバッファと同じ並びでまとめて確保・初期化
+/// </summary>
+/// <param name="tileBatch"></param>
+void BlockTransforms::Generate(const TileBatch& tileBatch) {
+	Clear();
+
+	numBlockHorizontal_ = tileBatch.GetNumBlockHorizontal();
+
+	// 確保は1回だけ（以降は要素のアドレスが変わらない）
+	count_ = tileBatch.GetInstanceCount();
+	transforms_ = std::make_unique<WorldTransform[]>(count_);
+	slots_.assign(tileBatch.GetTileCount(), kEmptySlot);
+
+	const std::vector<TileInstance>& instances = tileBatch.GetInstances();
+	for (uint32_t slot = 0; slot < static_cast<uint32_t>(instances.size()); ++slot) {
+		const TileInstance& instance = instances[slot];
+
+		WorldTransform& worldTransform = transforms_[slot];
+		worldTransform.Initialize();
+		worldTransform.translation_ = {instance.x, instance.y, instance.z};
+
+		slots_[instance.tileIndex] = static_cast<int32_t>(slot);
+	}
+}
+
+/// <summary>
+/// 全ブロックの行列更新（配列を先頭から順に）
+/// </summary>
+void BlockTransforms::Update() {
+	// 各ブロックの行列は独立しているので、連続した範囲ごとに並列に
+	JobSystem::GetInstance()->ParallelFor("BlockTransforms::Update (job)", count_, kUpdateChunkSize, [this](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			WorldTransformUpdate(transforms_[i]);
+		}
+	});
+}
+
+/// <summary>
+/// 全ブロックの描画
+/// </summary>
+/// <param name="model"></param>
+/// <param name="camera"></param>
+void BlockTransforms::Draw(Model* model, const Camera& camera) const {
+	for (uint32_t i = 0; i < count_; ++i) {
+		model->Draw(transforms_[i], camera);
+	}
+}
+
+/// <summary>
+/// 解放
+/// </summary>
+void BlockTransforms::Clear() {
+	transforms_.reset();
+	count_ = 0;
+	slots_.clear();
+	slots_.shrink_to_fit();
+	numBlockHorizontal_ = 0;
+}
+
+/// <summary>
+/// タイルのトランスフォームを取得（ブロックが無ければnullptr）
+/// </summary>
+/// <param name="xIndex"></param>
+/// <param name="yIndex"></param>
+/// <returns></returns>
+const WorldTransform* BlockTransforms::Find(uint32_t xIndex, uint32_t yIndex) const {
+	if (xIndex >= numBlockHorizontal_) {
+		return nullptr;
+	}
+
+	size_t tileIndex = static_cast<size_t>(yIndex) * numBlockHorizontal_ + xIndex;
+	if (tileIndex >= slots_.size() || slots_[tileIndex] == kEmptySlot) {
+		return nullptr;
+	}
+
+	return &transforms_[slots_[tileIndex]];
+}
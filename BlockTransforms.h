@@ -0,0 +1,68 @@
+#pragma once
+#include "KamataEngine.h"
+#include "TileBatch.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/// <summary>
+/// ブロックのワールドトランスフォームを1本の連続配列で持つ（タイル番号→スロットの表で引く）
+/// </summary>
+class BlockTransforms {
+public:
+	// ブロックの無いタイル
+	static inline const int32_t kEmptySlot = -1;
+	// 行列更新を並列にするときの1つのジョブの最小のブロック数
+	static inline const uint32_t kUpdateChunkSize = 256;
+
+private:
+	// トランスフォーム（TileBatch のインスタンスと同じ並び。WorldTransform のコピー・ムーブに頼らないよう配列で持つ）
+	std::unique_ptr<KamataEngine::WorldTransform[]> transforms_;
+	uint32_t count_ = 0;
+
+	// タイル番号 → スロット番号
+	std::vector<int32_t> slots_;
+
+	// 横のブロック数
+	uint32_t numBlockHorizontal_ = 0;
+
+public:
+	/// <summary>
+	/// インスタンスバッファと同じ並びでまとめて確保・初期化
+	/// </summary>
+	/// <param name="tileBatch"></param>
+	void Generate(const TileBatch& tileBatch);
+
+	/// <summary>
+	/// 全ブロックの行列更新（配列を先頭から順に）
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// 全ブロックの描画
+	/// </summary>
+	/// <param name="model"></param>
+	/// <param name="camera"></param>
+	void Draw(KamataEngine::Model* model, const KamataEngine::Camera& camera) const;
+
+	/// <summary>
+	/// 解放
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// タイルのトランスフォームを取得（ブロックが無ければnullptr）
+	/// </summary>
+	/// <param name="xIndex"></param>
+	/// <param name="yIndex"></param>
+	/// <returns></returns>
+	const KamataEngine::WorldTransform* Find(uint32_t xIndex, uint32_t yIndex) const;
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const KamataEngine::WorldTransform* GetTransforms() const { return transforms_.get(); }
+	uint32_t GetCount() const { return count_; }
+};
@@ -23,7 +23,39 @@ void CameraController::Reset() {
 	const WorldTransform& targetWorldTransform = target_->GetWorldTransform();
 	// 追従対象とオフセットからカメラの座標を計算
 	camera_->translation_ = targetWorldTransform.translation_ + targetOffset_;
+	// 前回の追従の勢いを持ち越さない
+	smoothedVelocity_ = {0, 0, 0};
 }
+/// <summary>
+/// 状態を記録に書く
+/// </summary>
+/// <param name="snapshot"></param>
+void CameraController::SaveState(SimulationSnapshot& snapshot) const {
+	State state;
+	state.cameraTranslation = camera_->translation_;
+	state.cameraRotation = camera_->rotation_;
+	state.targetPosition = targetPosition_;
+	state.targetVelocity = targetVelocity_;
+	state.smoothedVelocity = smoothedVelocity_;
+	snapshot.Write(state);
+}
+
+/// <summary>
+/// 状態を記録から戻す
+/// </summary>
+/// <param name="reader"></param>
+void CameraController::LoadState(SimulationSnapshot::Reader& reader) {
+	State state;
+	reader.Read(state);
+	camera_->translation_ = state.cameraTranslation;
+	camera_->rotation_ = state.cameraRotation;
+	targetPosition_ = state.targetPosition;
+	targetVelocity_ = state.targetVelocity;
+	smoothedVelocity_ = state.smoothedVelocity;
+
+	camera_->UpdateMatrix();
+}
+
 /// <summary>
 /// 更新
 /// </summary>
@@ -1,5 +1,6 @@
 #pragma once
 #include "KamataEngine.h"
+#include "SimulationSnapshot.h"
 
 class Player;
 
@@ -37,6 +38,15 @@ private:
 	float lookAheadScaleX_ = 12.0f;    // 横の先読み量（調整可）
 	float lookAheadScaleY_ = 4.0f;     // 縦の先読み量（かなり小さく）
 
+	// 記録に書く状態（カメラの位置も含める）
+	struct State {
+		KamataEngine::Vector3 cameraTranslation;
+		KamataEngine::Vector3 cameraRotation;
+		KamataEngine::Vector3 targetPosition;
+		KamataEngine::Vector3 targetVelocity;
+		KamataEngine::Vector3 smoothedVelocity;
+	};
+
 public:
 	/// <summary>
 	/// 初期化
@@ -51,6 +61,12 @@ public:
 	/// </summary>
 	void Reset();
 	/// <summary>
+	/// 追従の勢いとカメラの位置を記録に書く / 記録から戻す（戻したら行列も作り直す）
+	/// </summary>
+	/// <param name="snapshot"></param>
+	void SaveState(SimulationSnapshot& snapshot) const;
+	void LoadState(SimulationSnapshot::Reader& reader);
+	/// <summary>
 	/// 線形補間
 	/// </summary>
 	/// <param name="start"></param>
@@ -0,0 +1,220 @@
+#define NOMINMAX
+#include "DdsTexture.h"
+#include "FileUtility.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace {
+
+// DDS のヘッダ（"DDS " の後ろ。リトルエンディアン前提）
+struct DdsPixelFormat {
+	uint32_t size;
+	uint32_t flags;
+	uint32_t fourCC;
+	uint32_t rgbBitCount;
+	uint32_t bitMask[4];
+};
+
+struct DdsHeader {
+	uint32_t size;
+	uint32_t flags;
+	uint32_t height;
+	uint32_t width;
+	uint32_t pitchOrLinearSize;
+	uint32_t depth;
+	uint32_t mipMapCount;
+	uint32_t reserved1[11];
+	DdsPixelFormat pixelFormat;
+	uint32_t caps;
+	uint32_t caps2;
+	uint32_t caps3;
+	uint32_t caps4;
+	uint32_t reserved2;
+};
+static_assert(sizeof(DdsHeader) == 124, "DDS のヘッダは124バイト");
+
+constexpr uint32_t MakeFourCC(char a, char b, char c, char d) {
+	return static_cast<uint32_t>(static_cast<uint8_t>(a)) | static_cast<uint32_t>(static_cast<uint8_t>(b)) << 8 | static_cast<uint32_t>(static_cast<uint8_t>(c)) << 16 |
+	       static_cast<uint32_t>(static_cast<uint8_t>(d)) << 24;
+}
+
+constexpr uint32_t kMagic = MakeFourCC('D', 'D', 'S', ' ');
+constexpr uint32_t kFourCCDxt1 = MakeFourCC('D', 'X', 'T', '1');
+constexpr uint32_t kFourCCDxt5 = MakeFourCC('D', 'X', 'T', '5');
+
+// dwFlags
+constexpr uint32_t kFlagCaps = 0x1;
+constexpr uint32_t kFlagHeight = 0x2;
+constexpr uint32_t kFlagWidth = 0x4;
+constexpr uint32_t kFlagPixelFormat = 0x1000;
+constexpr uint32_t kFlagMipMapCount = 0x20000;
+constexpr uint32_t kFlagLinearSize = 0x80000;
+// ddspf.dwFlags
+constexpr uint32_t kPixelFormatFourCC = 0x4;
+// dwCaps
+constexpr uint32_t kCapsComplex = 0x8;
+constexpr uint32_t kCapsTexture = 0x1000;
+constexpr uint32_t kCapsMipMap = 0x400000;
+
+} // namespace
+
+/// <summary>
+/// ファイルをマップしてヘッダを読む（形式が違う・大きさが足りなければ false）
+/// </summary>
+/// <param name="filePath"></param>
+/// <returns></returns>
+bool DdsTexture::Open(const std::string& filePath) {
+	Close();
+	if (!file_.Open(filePath)) {
+		return false;
+	}
+	if (!Parse(file_.GetData(), file_.GetSize())) {
+		Close();
+		return false;
+	}
+	return true;
+}
+
+/// <summary>
+/// メモリ上の DDS のヘッダを読む（data はこのオブジェクトより長く持つこと）
+/// </summary>
+/// <param name="data"></param>
+/// <param name="size"></param>
+/// <returns></returns>
+bool DdsTexture::Parse(const uint8_t* data, size_t size) {
+	mipCount_ = 0;
+	if (size < sizeof(uint32_t) + sizeof(DdsHeader)) {
+		return false;
+	}
+
+	uint32_t magic;
+	std::memcpy(&magic, data, sizeof(magic));
+	DdsHeader header;
+	std::memcpy(&header, data + sizeof(magic), sizeof(header));
+	if (magic != kMagic || header.size != sizeof(DdsHeader) || header.pixelFormat.size != sizeof(DdsPixelFormat) || !(header.pixelFormat.flags & kPixelFormatFourCC)) {
+		return false;
+	}
+
+	if (header.pixelFormat.fourCC == kFourCCDxt1) {
+		format_ = Format::kBC1;
+	} else if (header.pixelFormat.fourCC == kFourCCDxt5) {
+		format_ = Format::kBC3;
+	} else {
+		return false;
+	}
+
+	uint32_t mipCount = (header.flags & kFlagMipMapCount) ? (std::max)(header.mipMapCount, 1u) : 1u;
+	if (header.width == 0 || header.height == 0 || mipCount > GetFullMipCount(header.width, header.height) || mipCount > kMaxMipCount) {
+		return false;
+	}
+
+	// ミップを大きい順に切り出す
+	size_t offset = sizeof(magic) + sizeof(header);
+	uint32_t width = header.width;
+	uint32_t height = header.height;
+	for (uint32_t i = 0; i < mipCount; ++i) {
+		size_t levelSize = GetLevelSize(format_, width, height);
+		if (levelSize > size - offset) {
+			return false;
+		}
+		Level& level = levels_[i];
+		level.data = data + offset;
+		level.size = levelSize;
+		level.width = width;
+		level.height = height;
+		level.rowCount = (height + 3) / 4;
+		level.rowPitch = static_cast<uint32_t>(levelSize / level.rowCount);
+		offset += levelSize;
+		width = (std::max)(width / 2, 1u);
+		height = (std::max)(height / 2, 1u);
+	}
+
+	width_ = header.width;
+	height_ = header.height;
+	mipCount_ = mipCount;
+	return true;
+}
+
+/// <summary>
+/// 閉じる
+/// </summary>
+void DdsTexture::Close() {
+	file_.Close();
+	width_ = 0;
+	height_ = 0;
+	mipCount_ = 0;
+}
+
+/// <summary>
+/// 書く（levels は大きい順。一時ファイルに書いてから置き換える）
+/// </summary>
+/// <param name="filePath"></param>
+/// <param name="format"></param>
+/// <param name="width"></param>
+/// <param name="height"></param>
+/// <param name="levels">ミップごとのブロック列</param>
+/// <returns>成功したか</returns>
+bool DdsTexture::Write(const std::string& filePath, Format format, uint32_t width, uint32_t height, const std::vector<std::vector<uint8_t>>& levels) {
+	if (width == 0 || height == 0 || levels.empty() || levels.size() > GetFullMipCount(width, height)) {
+		return false;
+	}
+	uint32_t levelWidth = width;
+	uint32_t levelHeight = height;
+	for (const std::vector<uint8_t>& level : levels) {
+		if (level.size() != GetLevelSize(format, levelWidth, levelHeight)) {
+			return false;
+		}
+		levelWidth = (std::max)(levelWidth / 2, 1u);
+		levelHeight = (std::max)(levelHeight / 2, 1u);
+	}
+
+	DdsHeader header{};
+	header.size = sizeof(DdsHeader);
+	header.flags = kFlagCaps | kFlagHeight | kFlagWidth | kFlagPixelFormat | kFlagLinearSize | (levels.size() > 1 ? kFlagMipMapCount : 0);
+	header.height = height;
+	header.width = width;
+	header.pitchOrLinearSize = static_cast<uint32_t>(levels[0].size());
+	header.mipMapCount = static_cast<uint32_t>(levels.size());
+	header.pixelFormat.size = sizeof(DdsPixelFormat);
+	header.pixelFormat.flags = kPixelFormatFourCC;
+	header.pixelFormat.fourCC = format == Format::kBC1 ? kFourCCDxt1 : kFourCCDxt5;
+	header.caps = kCapsTexture | (levels.size() > 1 ? kCapsComplex | kCapsMipMap : 0);
+
+	return FileUtility::WriteAtomically(filePath, [&](std::ofstream& file) {
+		file.write(reinterpret_cast<const char*>(&kMagic), sizeof(kMagic));
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (const std::vector<uint8_t>& level : levels) {
+			file.write(reinterpret_cast<const char*>(level.data()), static_cast<std::streamsize>(level.size()));
+		}
+	});
+}
+
+/// <summary>
+/// width x height の1段のバイト数
+/// </summary>
+/// <param name="format"></param>
+/// <param name="width"></param>
+/// <param name="height"></param>
+/// <returns></returns>
+size_t DdsTexture::GetLevelSize(Format format, uint32_t width, uint32_t height) {
+	// 端の半端な画素もブロック1個ぶん使う
+	size_t blockColumns = (static_cast<size_t>(width) + 3) / 4;
+	size_t blockRows = (static_cast<size_t>(height) + 3) / 4;
+	return blockColumns * blockRows * GetBlockSize(format);
+}
+
+/// <summary>
+/// 1x1 までのミップの段数
+/// </summary>
+/// <param name="width"></param>
+/// <param name="height"></param>
+/// <returns></returns>
+uint32_t DdsTexture::GetFullMipCount(uint32_t width, uint32_t height) {
+	uint32_t count = 1;
+	for (uint32_t size = (std::max)(width, height); size > 1; size /= 2) {
+		++count;
+	}
+	return count;
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// ミップ付き・ブロック圧縮済みの DDS（GPU にそのまま渡せる形。Tools/TextureBaker が書く）
+/// ・ヘッダは DX9 形式（FourCC の DXT1 / DXT5）。DirectXTex・WIC のどちらでも読める
+/// ・読むときはファイルをマップし、各ミップの先頭と大きさを返すだけ（展開はしない）
+/// </summary>
+class DdsTexture {
+public:
+	// 画素の形式
+	enum class Format : uint32_t {
+		kBC1, // 4x4 画素を8バイト（不透明な画像）
+		kBC3, // 4x4 画素を16バイト（α付きの画像）
+	};
+
+	// ミップの上限（16384 x 16384 まで）
+	static inline const uint32_t kMaxMipCount = 15;
+
+	// ミップ1段
+	struct Level {
+		const uint8_t* data = nullptr;
+		size_t size = 0;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t rowPitch = 0; // ブロック1行のバイト数
+		uint32_t rowCount = 0; // ブロックの行数
+	};
+
+private:
+	MappedFile file_;
+	Format format_ = Format::kBC1;
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+	uint32_t mipCount_ = 0;
+	Level levels_[kMaxMipCount];
+
+public:
+	/// <summary>
+	/// ファイルをマップしてヘッダを読む（形式が違う・大きさが足りなければ false）
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <returns></returns>
+	bool Open(const std::string& filePath);
+	/// <summary>
+	/// メモリ上の DDS のヘッダを読む（data はこのオブジェクトより長く持つこと）
+	/// </summary>
+	/// <param name="data"></param>
+	/// <param name="size"></param>
+	/// <returns></returns>
+	bool Parse(const uint8_t* data, size_t size);
+	/// <summary>
+	/// 閉じる
+	/// </summary>
+	void Close();
+
+	/// <summary>
+	/// 書く（levels は大きい順。一時ファイルに書いてから置き換える）
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <param name="format"></param>
+	/// <param name="width"></param>
+	/// <param name="height"></param>
+	/// <param name="levels">ミップごとのブロック列</param>
+	/// <returns>成功したか</returns>
+	static bool Write(const std::string& filePath, Format format, uint32_t width, uint32_t height, const std::vector<std::vector<uint8_t>>& levels);
+
+	/// <summary>
+	/// 1ブロックのバイト数
+	/// </summary>
+	/// <param name="format"></param>
+	/// <returns></returns>
+	static uint32_t GetBlockSize(Format format) { return format == Format::kBC1 ? 8 : 16; }
+	/// <summary>
+	/// width x height の1段のバイト数
+	/// </summary>
+	/// <param name="format"></param>
+	/// <param name="width"></param>
+	/// <param name="height"></param>
+	/// <returns></returns>
+	static size_t GetLevelSize(Format format, uint32_t width, uint32_t height);
+	/// <summary>
+	/// 1x1 までのミップの段数
+	/// </summary>
+	/// <param name="width"></param>
+	/// <param name="height"></param>
+	/// <returns></returns>
+	static uint32_t GetFullMipCount(uint32_t width, uint32_t height);
+	/// <summary>
+	/// 形式の名前（マニフェストに書くもの）
+	/// </summary>
+	/// <param name="format"></param>
+	/// <returns></returns>
+	static const char* GetFormatName(Format format) { return format == Format::kBC1 ? "BC1" : "BC3"; }
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	Format GetFormat() const { return format_; }
+	uint32_t GetWidth() const { return width_; }
+	uint32_t GetHeight() const { return height_; }
+	uint32_t GetMipCount() const { return mipCount_; }
+	const Level& GetLevel(uint32_t index) const { return levels_[index]; }
+};
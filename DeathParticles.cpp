@@ -26,15 +26,64 @@ void DeathParticles::Initialize(KamataEngine::Model* model, KamataEngine::Camera
 
 	// 色
 	objectColor_.Initialize();
-	color_ = {1, 1, 1, 1};
 
 	// ワールド変換の初期化
 	for (WorldTransform& worldTransform : worldTransforms_) {
 		worldTransform.Initialize();
+	}
+
+	Reset(position);
+}
+
+/// <summary>
+/// 指定位置から演出をやり直す（確保済みのものを使い回す）
+/// </summary>
+/// <param name="position"></param>
+void DeathParticles::Reset(const Vector3& position) {
+	isFinished_ = false;
+	counter_ = 0.0f;
+
+	color_ = {1, 1, 1, 1};
+	objectColor_.SetColor(color_);
+
+	for (WorldTransform& worldTransform : worldTransforms_) {
 		worldTransform.translation_ = position;
 	}
 }
 
+/// <summary>
+/// 状態を記録に書く
+/// </summary>
+/// <param name="snapshot"></param>
+void DeathParticles::SaveState(SimulationSnapshot& snapshot) const {
+	State state;
+	for (uint32_t i = 0; i < kNumParticles; ++i) {
+		state.transforms[i].Save(worldTransforms_[i]);
+	}
+	state.color = color_;
+	state.counter = counter_;
+	state.isFinished = isFinished_ ? 1u : 0u;
+	snapshot.Write(state);
+}
+
+/// <summary>
+/// 状態を記録から戻す
+/// </summary>
+/// <param name="reader"></param>
+void DeathParticles::LoadState(SimulationSnapshot::Reader& reader) {
+	State state;
+	reader.Read(state);
+	for (uint32_t i = 0; i < kNumParticles; ++i) {
+		state.transforms[i].Load(worldTransforms_[i]);
+	}
+	color_ = state.color;
+	counter_ = state.counter;
+	isFinished_ = state.isFinished != 0;
+
+	// 色は共有の定数バッファなので、戻したら転送し直す
+	objectColor_.SetColor(color_);
+}
+
 /// <summary>
 /// 更新
 /// </summary>
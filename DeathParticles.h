@@ -1,5 +1,6 @@
 #pragma once
 #include "KamataEngine.h"
+#include "SimulationSnapshot.h"
 #include <array>
 #include <numbers>
 
@@ -31,6 +32,14 @@ private:
 	// カメラ
 	KamataEngine::Camera* camera_ = nullptr;
 
+	// 記録に書く状態
+	struct State {
+		SimulationSnapshot::TransformState transforms[kNumParticles];
+		KamataEngine::Vector4 color;
+		float counter;
+		uint32_t isFinished; // 詰め物を作らないよう4バイトで持つ
+	};
+
 public:
 	/// <summary>
 	/// 初期化
@@ -40,6 +49,17 @@ public:
 	/// <param name="position"></param>
 	void Initialize(KamataEngine::Model* model, KamataEngine::Camera* camera, const KamataEngine::Vector3& position);
 	/// <summary>
+	/// 指定位置から演出をやり直す（確保済みのものを使い回す）
+	/// </summary>
+	/// <param name="position"></param>
+	void Reset(const KamataEngine::Vector3& position);
+	/// <summary>
+	/// 経過時間・色・粒の位置を記録に書く / 記録から戻す
+	/// </summary>
+	/// <param name="snapshot"></param>
+	void SaveState(SimulationSnapshot& snapshot) const;
+	void LoadState(SimulationSnapshot::Reader& reader);
+	/// <summary>
 	/// 更新
 	/// </summary>
 	void Update();
@@ -1,7 +1,9 @@
 #define NOMINMAX
 #include "Enemy.h"
+#include "FlowField.h"
 #include "GameScene.h"
 #include "Player.h"
+#include "Profiler.h"
 #include "WorldTransformUpdater.h"
 #include <algorithm>
 #include <cassert>
@@ -25,8 +27,23 @@ void Enemy::Initialize(Model* model, Camera* camera, const Vector3& position) {
 
 	worldTransform_.Initialize();
 
+	// 位置・状態の初期化
+	Reset(position);
+}
+
+/// <summary>
+/// 状態を初期値に戻して指定位置に置き直す（リトライ・休眠からの復帰用）
+/// </summary>
+void Enemy::Reset(const Vector3& position, LRDirection direction) {
+	// 振るまい
+	behavior_ = Behavior::kWalk;
+	behaviorRequest_ = Behavior::kUnknown;
+	isDead_ = false;
+	isCollisionDisabled_ = false;
+	deathAnimetionTimer_ = 0.0f;
+
 	// 速度を設定
-	velocity_ = {-kWalkSpeed, 0, 0};
+	velocity_ = {direction == LRDirection::kRight ? kWalkSpeed : -kWalkSpeed, 0, 0};
 
 	// 見た目の左右向きも初期化
 	lrDirection_ = (velocity_.x >= 0.0f) ? LRDirection::kRight : LRDirection::kLeft;
@@ -39,14 +56,63 @@ void Enemy::Initialize(Model* model, Camera* camera, const Vector3& position) {
 
 	// 位置調整
 	worldTransform_.translation_ = position;
+	worldTransform_.rotation_ = {};
 	// Player と同じ角度テーブル（Right: 90°, Left: 270°）
 	float destinationRotationYTable[] = {std::numbers::pi_v<float>, 0.0f};
 	worldTransform_.rotation_.y = destinationRotationYTable[static_cast<uint32_t>(lrDirection_)];
 }
+
+/// <summary>
+/// 状態を記録に書く
+/// </summary>
+/// <param name="snapshot"></param>
+void Enemy::SaveState(SimulationSnapshot& snapshot) const {
+	State state;
+	state.transform.Save(worldTransform_);
+	state.velocity = velocity_;
+	state.behavior = behavior_;
+	state.behaviorRequest = behaviorRequest_;
+	state.turnState = turnState_;
+	state.lrDirection = lrDirection_;
+	state.nextDirection = nextDirection_;
+	state.isDead = isDead_;
+	state.isCollisionDisabled = isCollisionDisabled_;
+	state.waitTurnTimer = waitTurnTimer_;
+	state.turnTimer = turnTimer_;
+	state.turnFirstRotationY = turnFirstRotationY_;
+	state.deathAnimetionTimer = deathAnimetionTimer_;
+	state.walkTimer = walkTimer_;
+	snapshot.Write(state);
+}
+
+/// <summary>
+/// 状態を記録から戻す
+/// </summary>
+/// <param name="reader"></param>
+void Enemy::LoadState(SimulationSnapshot::Reader& reader) {
+	State state;
+	reader.Read(state);
+	state.transform.Load(worldTransform_);
+	velocity_ = state.velocity;
+	behavior_ = state.behavior;
+	behaviorRequest_ = state.behaviorRequest;
+	turnState_ = state.turnState;
+	lrDirection_ = state.lrDirection;
+	nextDirection_ = state.nextDirection;
+	isDead_ = state.isDead;
+	isCollisionDisabled_ = state.isCollisionDisabled;
+	waitTurnTimer_ = state.waitTurnTimer;
+	turnTimer_ = state.turnTimer;
+	turnFirstRotationY_ = state.turnFirstRotationY;
+	deathAnimetionTimer_ = state.deathAnimetionTimer;
+	walkTimer_ = state.walkTimer;
+}
+
 /// <summary>
 /// 更新
 /// </summary>
 void Enemy::Update() {
+	PROFILE_ZONE("Enemy::Update");
 
 	if (behaviorRequest_ != Behavior::kUnknown) {
 		// 振るまいを変更
@@ -142,6 +208,9 @@ void Enemy::BehaviorWalkUpdate() {
 		}
 	}
 
+	// プレイヤーを追う（向きを変えるなら待ち → 旋回へ）
+	FollowFlowField();
+
 	// 旋回中/待ち中は歩行移動しない
 	if (turnState_ != TurnState::kWalk) {
 		return;
@@ -315,16 +384,46 @@ void Enemy::ReactToWallHit(const CollisionMapInfo& info) {
 	}
 
 	// 壁に当たったら一旦停止し、少し待ってから旋回して反対へ進む
+	StartTurn((lrDirection_ == LRDirection::kRight) ? LRDirection::kLeft : LRDirection::kRight);
+}
+
+void Enemy::StartTurn(LRDirection nextDirection) {
 	turnState_ = TurnState::kWait;
 	waitTurnTimer_ = kWaitBeforeTurn;
 
-	// 次に向く方向を決める（現在の向きの反対）
-	nextDirection_ = (lrDirection_ == LRDirection::kRight) ? LRDirection::kLeft : LRDirection::kRight;
+	// 次に向く方向
+	nextDirection_ = nextDirection;
 
 	// 待ち/旋回中は移動を止める
 	velocity_.x = 0.0f;
 }
 
+void Enemy::FollowFlowField() {
+	if (!flowField_ || turnState_ != TurnState::kWalk) {
+		return;
+	}
+
+	// 今いるタイルで1回引くだけ（経路探索は FlowField 側で全員分まとめて済んでいる）
+	FlowField::Step step;
+	if (!flowField_->GetStep(worldTransform_.translation_, step)) {
+		return;
+	}
+	// 跳べないので、ジャンプが要る段差は今まで通り歩いて折り返す
+	if (step.move == FlowField::Move::kJump) {
+		return;
+	}
+
+	float dx = step.position.x - worldTransform_.translation_.x;
+	if (std::abs(dx) < kChaseDeadZone) {
+		return;
+	}
+
+	LRDirection desiredDirection = (dx > 0.0f) ? LRDirection::kRight : LRDirection::kLeft;
+	if (desiredDirection != lrDirection_) {
+		StartTurn(desiredDirection);
+	}
+}
+
 /// <summary>
 /// 衝突応答
 /// </summary>
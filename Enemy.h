@@ -1,10 +1,12 @@
 #pragma once
 #include "AABB.h"
 #include "KamataEngine.h"
+#include "SimulationSnapshot.h"
 
 class Player;
 class GameScene;
 class MapChipField;
+class FlowField;
 
 class Enemy {
 public:
@@ -16,7 +18,7 @@ public:
 	};
 
 	// プレイヤーと同じ左右向き（見た目の向き制御に使う）
-	enum class LRDirection {
+	enum class LRDirection : uint8_t {
 		kRight,
 		kLeft,
 	};
@@ -107,12 +109,47 @@ private:
 
 	GameScene* gameScene_ = nullptr;
 
+	// プレイヤーへの経路（設定されていれば、その向きへ歩く）
+	const FlowField* flowField_ = nullptr;
+	// 次のタイルがこれより近ければ向きを変えない（タイルの中心付近での振り返りを防ぐ）
+	static inline const float kChaseDeadZone = 0.05f;
+
+	// 記録に書く状態
+	struct State {
+		SimulationSnapshot::TransformState transform;
+		KamataEngine::Vector3 velocity;
+		Behavior behavior;
+		Behavior behaviorRequest;
+		TurnState turnState;
+		LRDirection lrDirection;
+		LRDirection nextDirection;
+		bool isDead;
+		bool isCollisionDisabled;
+		float waitTurnTimer;
+		float turnTimer;
+		float turnFirstRotationY;
+		float deathAnimetionTimer;
+		float walkTimer;
+	};
+
 public:
 	/// <summary>
 	/// 初期化
 	/// </summary>
 	void Initialize(KamataEngine::Model* model, KamataEngine::Camera* camera, const KamataEngine::Vector3& position);
 	/// <summary>
+	/// 状態を初期値に戻して指定位置に置き直す（リトライ・休眠からの復帰用）
+	/// </summary>
+	/// <param name="position"></param>
+	/// <param name="direction">歩き出す向き</param>
+	void Reset(const KamataEngine::Vector3& position, LRDirection direction = LRDirection::kLeft);
+	/// <summary>
+	/// 歩行・旋回・死亡演出の状態を記録に書く / 記録から戻す
+	/// </summary>
+	/// <param name="snapshot"></param>
+	void SaveState(SimulationSnapshot& snapshot) const;
+	void LoadState(SimulationSnapshot::Reader& reader);
+	/// <summary>
 	/// 更新
 	/// </summary>
 	void Update();
@@ -147,6 +184,10 @@ public:
 	void MoveByCollisionResult(const CollisionMapInfo& info);
 	// 壁に当たったときの処理（反転）
 	void ReactToWallHit(const CollisionMapInfo& info);
+	// 待ち → 旋回を始める
+	void StartTurn(LRDirection nextDirection);
+	// 経路の次のタイルの方へ向きを変える
+	void FollowFlowField();
 
 	// 旋回用のイージング（Playerと同じ）
 	float EaseInOutSine(float turnProgress);
@@ -177,8 +218,12 @@ public:
 	/// <returns></returns>
 	KamataEngine::Vector3 GetWorldPosition();
 	AABB GetAABB();
+	const KamataEngine::WorldTransform& GetWorldTransform() const { return worldTransform_; }
 	bool IsDead() const;
 	bool IsCollisionDisabled() const;
+	static float GetWalkSpeed() { return kWalkSpeed; }
+	// 休眠させるときに残す向き（旋回中なら旋回後の向き）
+	LRDirection GetDirection() const { return turnState_ == TurnState::kWalk ? lrDirection_ : nextDirection_; }
 
 	/// <summary>
 	/// セッター
@@ -186,6 +231,11 @@ public:
 	/// <param name="gameScene"></param>
 	void SetGameScene(GameScene* gameScene) { gameScene_ = gameScene; }
 	/// <summary>
+	/// セッター（nullptr なら壁で折り返すだけ）
+	/// </summary>
+	/// <param name="flowField"></param>
+	void SetFlowField(const FlowField* flowField) { flowField_ = flowField; }
+	/// <summary>
 	/// セッター
 	/// </summary>
 	/// <param name="mapChipField"></param>
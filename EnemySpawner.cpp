@@ -0,0 +1,326 @@
+#define NOMINMAX
+#include "EnemySpawner.h"
+#include "AllocationTracker.h"
+#include "JobSystem.h"
+#include "MapChipField.h"
+#include "Profiler.h"
+#include "RenderPipeline.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace KamataEngine;
+
+/// <summary>
+/// デストラクタ
+/// </summary>
+EnemySpawner::~EnemySpawner() { Clear(); }
+
+/// <summary>
+/// マップの kEnemySpawn から記録を作る（敵はまだ実体化しない）
+/// </summary>
+void EnemySpawner::Initialize(MapChipField* mapChipField, Model* model, Camera* camera, GameScene* gameScene) {
+	assert(mapChipField);
+	assert(model);
+
+	Clear();
+
+	mapChipField_ = mapChipField;
+	flowField_ = nullptr;
+	model_ = model;
+	camera_ = camera;
+	gameScene_ = gameScene;
+
+	// 出現位置を左から順に集める
+	const uint32_t numBlockHorizontal = mapChipField_->GetNumBlockHorizontal();
+	const uint32_t numBlockVirtical = mapChipField_->GetNumBlockVirtical();
+	for (uint32_t x = 0; x < numBlockHorizontal; ++x) {
+		for (uint32_t y = 0; y < numBlockVirtical; ++y) {
+			if (mapChipField_->GetMapChipTypeByIndex(x, y) != MapChipType::kEnemySpawn) {
+				continue;
+			}
+			Vector3 position = mapChipField_->GetMapChipPositionByIndex(x, y);
+			spawnRecords_.push_back({position.x, position.y, kNone, Enemy::LRDirection::kLeft, State::kDormant});
+		}
+	}
+
+	chunkHeads_.resize(numBlockHorizontal / kChunkColumns + 1);
+
+	// 画面内に同時に出る程度の数は先に作っておく
+	uint32_t poolSize = std::min<uint32_t>(kInitialPoolSize, static_cast<uint32_t>(spawnRecords_.size()));
+	activeEnemies_.reserve(poolSize);
+	activeRecords_.reserve(poolSize);
+	freeEnemies_.reserve(poolSize);
+	for (uint32_t i = 0; i < poolSize; ++i) {
+		Enemy* enemy = new Enemy();
+		enemy->Initialize(model_, camera_, {});
+		enemy->SetGameScene(gameScene_);
+		enemy->SetMapChipField(mapChipField_);
+		freeEnemies_.push_back(enemy);
+	}
+
+	Reset();
+}
+
+/// <summary>
+/// 敵に追わせる経路
+/// </summary>
+void EnemySpawner::SetFlowField(const FlowField* flowField) {
+	flowField_ = flowField;
+	for (Enemy* enemy : activeEnemies_) {
+		enemy->SetFlowField(flowField_);
+	}
+	for (Enemy* enemy : freeEnemies_) {
+		enemy->SetFlowField(flowField_);
+	}
+}
+
+/// <summary>
+/// 全員を出現位置の休眠状態に戻す（確保済みの実体は使い回す）
+/// </summary>
+void EnemySpawner::Reset() {
+	// 実体は全て返す
+	freeEnemies_.insert(freeEnemies_.end(), activeEnemies_.begin(), activeEnemies_.end());
+	activeEnemies_.clear();
+	activeRecords_.clear();
+
+	records_ = spawnRecords_;
+	std::fill(chunkHeads_.begin(), chunkHeads_.end(), kNone);
+	for (uint32_t i = 0; i < static_cast<uint32_t>(records_.size()); ++i) {
+		LinkDormant(i);
+	}
+
+	// 次の UpdateActivation で範囲内を全て起こす
+	activeChunkFirst_ = 0;
+	activeChunkLast_ = -1;
+}
+
+/// <summary>
+/// 記録の表と実体化中の敵の状態を書く
+/// </summary>
+/// <param name="snapshot"></param>
+void EnemySpawner::SaveState(SimulationSnapshot& snapshot) const {
+	snapshot.WriteArray(records_);
+	snapshot.WriteArray(chunkHeads_);
+	snapshot.WriteArray(activeRecords_);
+	snapshot.Write(activeChunkFirst_);
+	snapshot.Write(activeChunkLast_);
+
+	// 実体は activeRecords_ と同じ並び
+	for (const Enemy* enemy : activeEnemies_) {
+		enemy->SaveState(snapshot);
+	}
+}
+
+/// <summary>
+/// 記録の表と実体化中の敵の状態を戻す
+/// </summary>
+/// <param name="reader"></param>
+void EnemySpawner::LoadState(SimulationSnapshot::Reader& reader) {
+	// 実体は全て返してから、記録の数だけ取り直す
+	freeEnemies_.insert(freeEnemies_.end(), activeEnemies_.begin(), activeEnemies_.end());
+	activeEnemies_.clear();
+
+	reader.ReadArray(records_);
+	reader.ReadArray(chunkHeads_);
+	reader.ReadArray(activeRecords_);
+	reader.Read(activeChunkFirst_);
+	reader.Read(activeChunkLast_);
+
+	for (size_t i = 0; i < activeRecords_.size(); ++i) {
+		Enemy* enemy = AcquireEnemy();
+		enemy->LoadState(reader);
+
+		ALLOCATION_TAG(AllocationTag::kEnemy);
+		activeEnemies_.push_back(enemy);
+	}
+}
+
+/// <summary>
+/// カメラの位置に合わせて起こす・眠らせる。倒された敵もここで外す
+/// </summary>
+void EnemySpawner::UpdateActivation(float cameraX) {
+	PROFILE_ZONE("EnemySpawner::UpdateActivation");
+
+	if (chunkHeads_.empty()) {
+		return;
+	}
+
+	// 倒された敵・範囲から1区画以上離れた敵を記録に戻す（境目で出たり消えたりしないよう1区画分の余裕）
+	int32_t first = ChunkOf(cameraX - kActivationHalfWidth);
+	int32_t last = ChunkOf(cameraX + kActivationHalfWidth);
+	for (size_t i = 0; i < activeEnemies_.size();) {
+		Enemy* enemy = activeEnemies_[i];
+		if (enemy->IsDead()) {
+			Release(i, State::kDead);
+			continue;
+		}
+		int32_t chunk = ChunkOf(enemy->GetWorldPosition().x);
+		if (chunk < first - 1 || chunk > last + 1) {
+			Release(i, State::kDormant);
+			continue;
+		}
+		++i;
+	}
+
+	// 新しく範囲に入った区画を起こす
+	if (first != activeChunkFirst_ || last != activeChunkLast_) {
+		for (int32_t chunk = first; chunk <= last; ++chunk) {
+			if (chunk < activeChunkFirst_ || chunk > activeChunkLast_) {
+				WakeChunk(chunk);
+			}
+		}
+		activeChunkFirst_ = first;
+		activeChunkLast_ = last;
+	}
+}
+
+/// <summary>
+/// 実体化中の敵の更新
+/// </summary>
+void EnemySpawner::Update() {
+	PROFILE_ZONE("EnemySpawner::Update");
+
+	// 敵の更新はマップと流れ場を読むだけで互いに干渉しないので、塊に分けて並列に
+	JobSystem::GetInstance()->ParallelFor("Enemy::Update (job)", static_cast<uint32_t>(activeEnemies_.size()), kUpdateChunkSize, [this](uint32_t begin, uint32_t end) {
+		for (uint32_t i = begin; i < end; ++i) {
+			activeEnemies_[i]->Update();
+		}
+	});
+}
+
+/// <summary>
+/// 実体化中の敵の描画
+/// </summary>
+void EnemySpawner::Draw() {
+	for (Enemy* enemy : activeEnemies_) {
+		enemy->Draw();
+	}
+}
+
+/// <summary>
+/// 実体化中の敵を描画の記録に写す
+/// </summary>
+/// <param name="snapshot"></param>
+/// <param name="modelId"></param>
+void EnemySpawner::Capture(FrameSnapshot& snapshot, uint32_t modelId) const {
+	for (const Enemy* enemy : activeEnemies_) {
+		snapshot.Add(modelId, enemy->GetWorldTransform());
+	}
+}
+
+/// <summary>
+/// 解放
+/// </summary>
+void EnemySpawner::Clear() {
+	for (Enemy* enemy : activeEnemies_) {
+		delete enemy;
+	}
+	for (Enemy* enemy : freeEnemies_) {
+		delete enemy;
+	}
+	activeEnemies_.clear();
+	activeRecords_.clear();
+	freeEnemies_.clear();
+
+	spawnRecords_.clear();
+	records_.clear();
+	chunkHeads_.clear();
+	activeChunkFirst_ = 0;
+	activeChunkLast_ = -1;
+}
+
+/// <summary>
+/// 位置から区画番号
+/// </summary>
+int32_t EnemySpawner::ChunkOf(float x) const {
+	// マップの外は端の区画として扱う
+	const float maxX = static_cast<float>(mapChipField_->GetNumBlockHorizontal());
+	uint32_t xIndex = mapChipField_->GetMapChipIndexSetByPosition({std::clamp(x, 0.0f, maxX), 0.0f, 0.0f}).xIndex;
+	return std::min(static_cast<int32_t>(xIndex / kChunkColumns), static_cast<int32_t>(chunkHeads_.size()) - 1);
+}
+
+/// <summary>
+/// 区画の休眠記録を全て実体化
+/// </summary>
+void EnemySpawner::WakeChunk(int32_t chunk) {
+	uint32_t recordIndex = chunkHeads_[chunk];
+	chunkHeads_[chunk] = kNone;
+
+	while (recordIndex != kNone) {
+		Record& record = records_[recordIndex];
+		uint32_t next = record.next;
+
+		Enemy* enemy = AcquireEnemy();
+		enemy->Reset({record.x, record.y, 0.0f}, record.direction);
+
+		record.state = State::kActive;
+		record.next = kNone;
+
+		// 実体化の上限を超えたときだけ確保が起きる
+		ALLOCATION_TAG(AllocationTag::kEnemy);
+		activeEnemies_.push_back(enemy);
+		activeRecords_.push_back(recordIndex);
+
+		recordIndex = next;
+	}
+}
+
+/// <summary>
+/// 実体化中の敵を記録に戻して実体を返す
+/// </summary>
+void EnemySpawner::Release(size_t activeIndex, State state) {
+	Enemy* enemy = activeEnemies_[activeIndex];
+	uint32_t recordIndex = activeRecords_[activeIndex];
+
+	// 位置と向きだけを残す
+	Record& record = records_[recordIndex];
+	Vector3 position = enemy->GetWorldPosition();
+	record.x = position.x;
+	record.y = position.y;
+	record.direction = enemy->GetDirection();
+	record.state = state;
+	if (state == State::kDormant) {
+		LinkDormant(recordIndex);
+	}
+
+	// 末尾と入れ替えて外す（並び順は問わない）
+	activeEnemies_[activeIndex] = activeEnemies_.back();
+	activeRecords_[activeIndex] = activeRecords_.back();
+	activeEnemies_.pop_back();
+	activeRecords_.pop_back();
+
+	freeEnemies_.push_back(enemy);
+}
+
+/// <summary>
+/// 休眠記録を区画のリストにつなぐ
+/// </summary>
+void EnemySpawner::LinkDormant(uint32_t recordIndex) {
+	Record& record = records_[recordIndex];
+	int32_t chunk = ChunkOf(record.x);
+
+	record.state = State::kDormant;
+	record.next = chunkHeads_[chunk];
+	chunkHeads_[chunk] = recordIndex;
+}
+
+/// <summary>
+/// 使っていない実体を1つ取り出す（足りなければ生成）
+/// </summary>
+Enemy* EnemySpawner::AcquireEnemy() {
+	if (!freeEnemies_.empty()) {
+		Enemy* enemy = freeEnemies_.back();
+		freeEnemies_.pop_back();
+		return enemy;
+	}
+
+	ALLOCATION_TAG(AllocationTag::kEnemy);
+	Enemy* enemy = new Enemy();
+	enemy->Initialize(model_, camera_, {});
+	enemy->SetGameScene(gameScene_);
+	enemy->SetMapChipField(mapChipField_);
+	enemy->SetFlowField(flowField_);
+	// 返すときに確保が起きないよう、返却先も合わせて広げておく
+	freeEnemies_.reserve(activeEnemies_.size() + 1);
+	return enemy;
+}
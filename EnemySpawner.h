@@ -0,0 +1,171 @@
+#pragma once
+#include "Enemy.h"
+
+#include <cstdint>
+#include <vector>
+
+struct FrameSnapshot;
+class FlowField;
+class GameScene;
+class MapChipField;
+
+/// <summary>
+/// マップの敵の出現位置から敵を出し、カメラの近くにいる敵だけを実体化して動かす
+/// （離れた敵は位置と向きだけの記録にして休眠させる）
+/// </summary>
+class EnemySpawner {
+public:
+	// 記録の状態
+	enum class State : uint8_t {
+		kDormant, // 休眠中（記録だけ）
+		kActive,  // 実体化して更新中
+		kDead,    // 倒された（リトライまで出さない）
+	};
+
+	// 休眠中の敵の記録（1体16バイト）
+	struct Record {
+		float x;                      // 位置 X
+		float y;                      // 位置 Y
+		uint32_t next;                // 同じ区画の次の休眠記録（kNone で終わり）
+		Enemy::LRDirection direction; // 向き
+		State state;                  // 状態
+		uint8_t padding[2];           // 詰め物を明示（記録のバイト列を毎回同じにする）
+	};
+	static_assert(sizeof(Record) == 16, "Record は記録にそのまま書くので詰め物を残さない");
+
+	// 記録の終端
+	static inline const uint32_t kNone = UINT32_MAX;
+
+	// 区画の幅（ブロック数）。起こす・眠らせるはこの単位で行う
+	static inline const uint32_t kChunkColumns = 8;
+	// 実体化する範囲（カメラ中心からの横幅の半分。画面の端より少し外まで）
+	static inline const float kActivationHalfWidth = 20.0f;
+	// 最初に確保しておく実体の数
+	static inline const uint32_t kInitialPoolSize = 16;
+	// 更新を並列にするときの1つのジョブの最小の敵の数
+	static inline const uint32_t kUpdateChunkSize = 32;
+
+private:
+	// 出現位置（リトライ用）と現在の記録
+	std::vector<Record> spawnRecords_;
+	std::vector<Record> records_;
+
+	// 区画ごとの休眠記録の先頭（records_ の next でつながる）
+	std::vector<uint32_t> chunkHeads_;
+
+	// 実体化中の敵と、その記録番号（同じ並び）
+	std::vector<Enemy*> activeEnemies_;
+	std::vector<uint32_t> activeRecords_;
+	// 使っていない実体
+	std::vector<Enemy*> freeEnemies_;
+
+	// 今起きている区画の範囲（first > last なら無し）
+	int32_t activeChunkFirst_ = 0;
+	int32_t activeChunkLast_ = -1;
+
+	// 実体の生成に使うもの
+	KamataEngine::Model* model_ = nullptr;
+	KamataEngine::Camera* camera_ = nullptr;
+	GameScene* gameScene_ = nullptr;
+	MapChipField* mapChipField_ = nullptr;
+	const FlowField* flowField_ = nullptr;
+
+public:
+	~EnemySpawner();
+
+	/// <summary>
+	/// マップの kEnemySpawn から記録を作る（敵はまだ実体化しない）
+	/// </summary>
+	/// <param name="mapChipField"></param>
+	/// <param name="model"></param>
+	/// <param name="camera"></param>
+	/// <param name="gameScene"></param>
+	void Initialize(MapChipField* mapChipField, KamataEngine::Model* model, KamataEngine::Camera* camera, GameScene* gameScene);
+
+	/// <summary>
+	/// 敵に追わせる経路（確保済みの実体にも、これから作る実体にも設定する）
+	/// </summary>
+	/// <param name="flowField"></param>
+	void SetFlowField(const FlowField* flowField);
+
+	/// <summary>
+	/// 全員を出現位置の休眠状態に戻す（確保済みの実体は使い回す）
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// 記録の表と実体化中の敵の状態を書く / 戻す（実体は確保済みのものを使い回す）
+	/// </summary>
+	/// <param name="snapshot"></param>
+	void SaveState(SimulationSnapshot& snapshot) const;
+	void LoadState(SimulationSnapshot::Reader& reader);
+
+	/// <summary>
+	/// カメラの位置に合わせて起こす・眠らせる。倒された敵もここで外す
+	/// </summary>
+	/// <param name="cameraX"></param>
+	void UpdateActivation(float cameraX);
+
+	/// <summary>
+	/// 実体化中の敵の更新
+	/// </summary>
+	void Update();
+
+	/// <summary>
+	/// 実体化中の敵の描画
+	/// </summary>
+	void Draw();
+
+	/// <summary>
+	/// 実体化中の敵を描画の記録に写す（RenderPipeline 用）
+	/// </summary>
+	/// <param name="snapshot"></param>
+	/// <param name="modelId">バックエンドに登録したモデルID</param>
+	void Capture(FrameSnapshot& snapshot, uint32_t modelId) const;
+
+	/// <summary>
+	/// 解放
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<Enemy*>& GetActiveEnemies() const { return activeEnemies_; }
+	uint32_t GetRecordCount() const { return static_cast<uint32_t>(records_.size()); }
+	uint32_t GetPoolSize() const { return static_cast<uint32_t>(activeEnemies_.size() + freeEnemies_.size()); }
+
+private:
+	/// <summary>
+	/// 位置から区画番号
+	/// </summary>
+	/// <param name="x"></param>
+	/// <returns></returns>
+	int32_t ChunkOf(float x) const;
+
+	/// <summary>
+	/// 区画の休眠記録を全て実体化
+	/// </summary>
+	/// <param name="chunk"></param>
+	void WakeChunk(int32_t chunk);
+
+	/// <summary>
+	/// 実体化中の敵を記録に戻して実体を返す
+	/// </summary>
+	/// <param name="activeIndex"></param>
+	/// <param name="state">戻した後の状態</param>
+	void Release(size_t activeIndex, State state);
+
+	/// <summary>
+	/// 休眠記録を区画のリストにつなぐ
+	/// </summary>
+	/// <param name="recordIndex"></param>
+	void LinkDormant(uint32_t recordIndex);
+
+	/// <summary>
+	/// 使っていない実体を1つ取り出す（足りなければ生成）
+	/// </summary>
+	/// <returns></returns>
+	Enemy* AcquireEnemy();
+};
@@ -78,6 +78,36 @@ void Fade::UpdateFadeOut() {
 	sprite_->SetColor(Vector4(0, 0, 0, std::clamp(counter_ / duration_, 0.0f, 1.0f)));
 }
 
+/// <summary>
+/// 状態を記録に書く
+/// </summary>
+/// <param name="snapshot"></param>
+void Fade::SaveState(SimulationSnapshot& snapshot) const { snapshot.Write(State{status_, duration_, counter_}); }
+
+/// <summary>
+/// 状態を記録から戻す
+/// </summary>
+/// <param name="reader"></param>
+void Fade::LoadState(SimulationSnapshot::Reader& reader) {
+	State state;
+	reader.Read(state);
+	status_ = state.status;
+	duration_ = state.duration;
+	counter_ = state.counter;
+
+	// 次の Update を待たずに見た目を合わせる
+	switch (status_) {
+	case Status::FadeIn:
+		sprite_->SetColor(Vector4(0, 0, 0, std::clamp(1.0f - counter_ / duration_, 0.0f, 1.0f)));
+		break;
+	case Status::FadeOut:
+		sprite_->SetColor(Vector4(0, 0, 0, std::clamp(counter_ / duration_, 0.0f, 1.0f)));
+		break;
+	default:
+		break;
+	}
+}
+
 /// <summary>
 /// フェード終了
 /// </summary>
@@ -1,5 +1,6 @@
 #pragma once
 #include "KamataEngine.h"
+#include "SimulationSnapshot.h"
 
 class Fade {
 public:
@@ -20,6 +21,13 @@ private:
 	// 経過時間カウンター
 	float counter_ = 0.0f;
 
+	// 記録に書く状態
+	struct State {
+		Status status;
+		float duration;
+		float counter;
+	};
+
 public:
 	/// <summary>
 	/// 初期化
@@ -50,6 +58,13 @@ public:
 	/// </summary>
 	void Stop();
 
+	/// <summary>
+	/// 状態と経過時間を記録に書く / 記録から戻す
+	/// </summary>
+	/// <param name="snapshot"></param>
+	void SaveState(SimulationSnapshot& snapshot) const;
+	void LoadState(SimulationSnapshot::Reader& reader);
+
 	/// <summary>
 	/// フェード終了判定
 	/// </summary>
@@ -0,0 +1,51 @@
+#include "FileUtility.h"
+
+#include <filesystem>
+#include <system_error>
+
+/// <summary>
+/// ファイルのバイト数と更新時刻
+/// </summary>
+/// <param name="path"></param>
+/// <returns></returns>
+FileUtility::Stamp FileUtility::GetStamp(const std::string& path) {
+	Stamp stamp;
+	std::error_code errorCode;
+	uint64_t size = std::filesystem::file_size(path, errorCode);
+	if (errorCode) {
+		return stamp;
+	}
+	std::filesystem::file_time_type time = std::filesystem::last_write_time(path, errorCode);
+	if (errorCode) {
+		return stamp;
+	}
+	stamp.size = size;
+	stamp.time = static_cast<int64_t>(time.time_since_epoch().count());
+	return stamp;
+}
+
+/// <summary>
+/// 一時ファイルに書いてから置き換える
+/// </summary>
+/// <param name="path"></param>
+/// <param name="write">開いた一時ファイルに中身を書く</param>
+/// <returns>書けて置き換えられたか</returns>
+bool FileUtility::WriteAtomically(const std::string& path, const std::function<void(std::ofstream&)>& write) {
+	std::string temporaryPath = path + ".tmp";
+	std::error_code errorCode;
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			return false;
+		}
+		write(file);
+		if (!file.good()) {
+			file.close();
+			std::filesystem::remove(temporaryPath, errorCode);
+			return false;
+		}
+	}
+
+	std::filesystem::rename(temporaryPath, path, errorCode);
+	return !errorCode;
+}
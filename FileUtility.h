@@ -0,0 +1,32 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <string>
+
+/// <summary>
+/// キャッシュ・記録のファイルを扱う共通の処理
+/// </summary>
+class FileUtility {
+public:
+	// ファイルの状態（無ければ両方0。時刻は同じマシンの中でだけ比べられる値）
+	struct Stamp {
+		uint64_t size = 0;
+		int64_t time = 0;
+	};
+
+	/// <summary>
+	/// ファイルのバイト数と更新時刻
+	/// </summary>
+	/// <param name="path"></param>
+	/// <returns></returns>
+	static Stamp GetStamp(const std::string& path);
+
+	/// <summary>
+	/// 途中で落ちても壊れたファイルが残らないよう、一時ファイル（path + ".tmp"）に書いてから置き換える
+	/// </summary>
+	/// <param name="path"></param>
+	/// <param name="write">開いた一時ファイルに中身を書く</param>
+	/// <returns>書けて置き換えられたか</returns>
+	static bool WriteAtomically(const std::string& path, const std::function<void(std::ofstream&)>& write);
+};
@@ -1,10 +1,13 @@
 #include "Fireworks.h"
+#include "AllocationTracker.h"
+#include "JobSystem.h"
+#include "Profiler.h"
 #include "Random.h"
+#include "RenderPipeline.h"
 #include "WorldTransformUpdater.h"
 
 #include <algorithm> // clamp
-#include <cmath>     // sin, cos, pow
-#include <numbers>   // pi_v
+#include <cmath>     // pow
 #include <utility>   // std::move
 
 using namespace KamataEngine::MathUtility;
@@ -15,18 +18,15 @@ void Fireworks::Initialize(KamataEngine::Model* particleModel, KamataEngine::Cam
 }
 
 void Fireworks::Burst(const KamataEngine::Vector3& explosionCenter, int particleCount, float minSpeed, float maxSpeed, float minLifetimeSec, float maxLifetimeSec) {
-	Random::SeedEngine();
+	ALLOCATION_TAG(AllocationTag::kFireworks);
 
-	for (int i = 0; i < particleCount; ++i) {
-		const float azimuthAngleRad = Random::GeneraterFloat(0.0f, 2.0f * std::numbers::pi_v<float>); // θ
-		const float polarAngleRad = Random::GeneraterFloat(0.0f, std::numbers::pi_v<float>);          // φ
-		const float initialSpeed = Random::GeneraterFloat(minSpeed, maxSpeed);
+	// 花火用の列（毎回シードし直さない）
+	Random::Stream& random = Random::GetStream(Random::System::kFireworks);
 
-		KamataEngine::Vector3 direction = {
-		    std::sin(polarAngleRad) * std::cos(azimuthAngleRad),
-		    std::cos(polarAngleRad),
-		    std::sin(polarAngleRad) * std::sin(azimuthAngleRad),
-		};
+	for (int i = 0; i < particleCount; ++i) {
+		// 球面上に一様な向き（極角を一様に取ると両極に偏るため）
+		const KamataEngine::Vector3 direction = random.NextUnitVector();
+		const float initialSpeed = random.NextFloat(minSpeed, maxSpeed);
 
 		// 粒をヒープ確保（auto禁止なので明示型で）
 		std::unique_ptr<Spark> spark(new Spark());
@@ -36,8 +36,8 @@ void Fireworks::Burst(const KamataEngine::Vector3& explosionCenter, int particle
 
 		spark->velocity = direction * initialSpeed;
 		spark->elapsedTimeSec = 0.0f;
-		spark->lifetimeSec = Random::GeneraterFloat(minLifetimeSec, maxLifetimeSec);
-		spark->startScale = Random::GeneraterFloat(0.12f, 0.22f);
+		spark->lifetimeSec = random.NextFloat(minLifetimeSec, maxLifetimeSec);
+		spark->startScale = random.NextFloat(0.12f, 0.22f);
 		spark->endScale = 0.0f;
 		spark->isAlive = true;
 
@@ -46,37 +46,41 @@ void Fireworks::Burst(const KamataEngine::Vector3& explosionCenter, int particle
 }
 
 void Fireworks::Update(float deltaTimeSec) {
+	PROFILE_ZONE("Fireworks::Update");
+
 	const float airDragFactor = 0.98f;              // 空気抵抗（1に近いほど弱い）
 	const float gravityAcceleration = -9.8f * 0.6f; // 下向き重力（y+が上想定）
 
-	// 物理更新
-	for (std::size_t i = 0; i < particles_.size(); ++i) {
-		Spark* s = particles_[i].get();
-		if (!s->isAlive) {
-			continue;
+	// 物理更新（粒どうしは独立しているので、塊に分けて並列に）
+	JobSystem::GetInstance()->ParallelFor("Fireworks::Update (job)", static_cast<uint32_t>(particles_.size()), kUpdateChunkSize, [&](uint32_t begin, uint32_t end) {
+		for (std::size_t i = begin; i < end; ++i) {
+			Spark* s = particles_[i].get();
+			if (!s->isAlive) {
+				continue;
+			}
+
+			s->elapsedTimeSec += deltaTimeSec;
+			if (s->elapsedTimeSec >= s->lifetimeSec) {
+				s->isAlive = false;
+				continue;
+			}
+
+			// 速度更新
+			s->velocity.y += gravityAcceleration * deltaTimeSec;
+			// 60FPS基準で drag を適用（可変フレームでも近似的に効く）
+			s->velocity = s->velocity * std::pow(airDragFactor, deltaTimeSec * 60.0f);
+
+			// 位置更新
+			s->worldTransform.translation_ = s->worldTransform.translation_ + s->velocity * deltaTimeSec;
+
+			// スケール補間
+			const float lifeRatio = std::clamp(s->elapsedTimeSec / s->lifetimeSec, 0.0f, 1.0f);
+			const float scale = Lerp(s->startScale, s->endScale, Smooth(lifeRatio));
+			s->worldTransform.scale_ = {scale, scale, scale};
+
+			WorldTransformUpdate(s->worldTransform);
 		}
-
-		s->elapsedTimeSec += deltaTimeSec;
-		if (s->elapsedTimeSec >= s->lifetimeSec) {
-			s->isAlive = false;
-			continue;
-		}
-
-		// 速度更新
-		s->velocity.y += gravityAcceleration * deltaTimeSec;
-		// 60FPS基準で drag を適用（可変フレームでも近似的に効く）
-		s->velocity = s->velocity * std::pow(airDragFactor, deltaTimeSec * 60.0f);
-
-		// 位置更新
-		s->worldTransform.translation_ = s->worldTransform.translation_ + s->velocity * deltaTimeSec;
-
-		// スケール補間
-		const float lifeRatio = std::clamp(s->elapsedTimeSec / s->lifetimeSec, 0.0f, 1.0f);
-		const float scale = Lerp(s->startScale, s->endScale, Smooth(lifeRatio));
-		s->worldTransform.scale_ = {scale, scale, scale};
-
-		WorldTransformUpdate(s->worldTransform);
-	}
+	});
 
 	// 死亡済みの粒を削除（手動ループ：auto不使用）
 	for (std::size_t i = 0; i < particles_.size(); /* 手動で進める */) {
@@ -101,6 +105,63 @@ void Fireworks::Draw() {
 	}
 }
 
+void Fireworks::Capture(FrameSnapshot& snapshot, uint32_t modelId) const {
+	for (std::size_t i = 0; i < particles_.size(); ++i) {
+		const Spark* s = particles_[i].get();
+		if (!s->isAlive) {
+			continue;
+		}
+		snapshot.Add(modelId, s->worldTransform);
+	}
+}
+
+void Fireworks::SaveState(SimulationSnapshot& snapshot) const {
+	snapshot.Write(static_cast<uint32_t>(particles_.size()));
+	for (std::size_t i = 0; i < particles_.size(); ++i) {
+		const Spark* s = particles_[i].get();
+
+		SparkState state;
+		state.transform.Save(s->worldTransform);
+		state.velocity = s->velocity;
+		state.elapsedTimeSec = s->elapsedTimeSec;
+		state.lifetimeSec = s->lifetimeSec;
+		state.startScale = s->startScale;
+		state.endScale = s->endScale;
+		state.isAlive = s->isAlive ? 1u : 0u;
+		snapshot.Write(state);
+	}
+}
+
+void Fireworks::LoadState(SimulationSnapshot::Reader& reader) {
+	uint32_t count = 0;
+	reader.Read(count);
+
+	// 数を合わせる（減らすのは末尾から。増やす分だけ確保）
+	if (particles_.size() > count) {
+		particles_.resize(count);
+	}
+	while (particles_.size() < count) {
+		ALLOCATION_TAG(AllocationTag::kFireworks);
+		std::unique_ptr<Spark> spark(new Spark());
+		spark->worldTransform.Initialize();
+		particles_.push_back(std::move(spark));
+	}
+
+	for (std::size_t i = 0; i < particles_.size(); ++i) {
+		Spark* s = particles_[i].get();
+
+		SparkState state;
+		reader.Read(state);
+		state.transform.Load(s->worldTransform);
+		s->velocity = state.velocity;
+		s->elapsedTimeSec = state.elapsedTimeSec;
+		s->lifetimeSec = state.lifetimeSec;
+		s->startScale = state.startScale;
+		s->endScale = state.endScale;
+		s->isAlive = state.isAlive != 0;
+	}
+}
+
 float Fireworks::Lerp(float a, float b, float t) { return a + (b - a) * t; }
 
 float Fireworks::Smooth(float t) {
@@ -1,9 +1,12 @@
 #pragma once
 #include "KamataEngine.h"
+#include "SimulationSnapshot.h"
 #include <cstddef> // std::size_t
 #include <memory>  // std::unique_ptr
 #include <vector>
 
+struct FrameSnapshot;
+
 class Fireworks {
 public:
 	~Fireworks() {}
@@ -20,9 +23,22 @@ public:
 	// 描画
 	void Draw();
 
+	// 生きている粒を描画の記録に写す（RenderPipeline 用）
+	void Capture(FrameSnapshot& snapshot, uint32_t modelId) const;
+
 	bool IsEmpty() const { return particles_.empty(); }
 
+	// 全ての粒を消す（リトライ用）
+	void Clear() { particles_.clear(); }
+
+	// 粒の状態を記録に書く / 記録から戻す（足りない粒だけ確保する）
+	void SaveState(SimulationSnapshot& snapshot) const;
+	void LoadState(SimulationSnapshot::Reader& reader);
+
 private:
+	// 更新を並列にするときの1つのジョブの最小の粒の数
+	static inline const uint32_t kUpdateChunkSize = 256;
+
 	struct Spark {
 		KamataEngine::WorldTransform worldTransform; // 粒の変換
 		KamataEngine::Vector3 velocity;              // 速度
@@ -33,6 +49,17 @@ private:
 		bool isAlive;                                // 生存フラグ
 	};
 
+	// 記録に書く粒1つ分
+	struct SparkState {
+		SimulationSnapshot::TransformState transform;
+		KamataEngine::Vector3 velocity;
+		float elapsedTimeSec;
+		float lifetimeSec;
+		float startScale;
+		float endScale;
+		uint32_t isAlive; // 詰め物を作らないよう4バイトで持つ
+	};
+
 	KamataEngine::Model* particleModel_ = nullptr;
 	KamataEngine::Camera* camera_ = nullptr;
 
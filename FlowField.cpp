@@ -0,0 +1,429 @@
+#define NOMINMAX
+#include "FlowField.h"
+#include "MapChipField.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 辺のコスト（歩き1ブロックを2とする）
+const uint32_t kWalkCost = 2;
+const uint32_t kJumpCost = 2;
+// 落下のコストに数える深さの上限（深い穴でも落ちるのは一瞬）
+const uint32_t kMaxFallCostDepth = 8;
+
+// 作成時の順向きの辺
+struct ForwardEdge {
+	uint32_t from;
+	uint32_t to;
+	uint16_t cost;
+	FlowField::Move move;
+};
+
+} // namespace
+
+/// <summary>
+/// 物理定数から跳んで届く範囲を求める
+/// </summary>
+FlowField::Reach FlowField::MakeReach(float jumpSpeed, float gravity, float horizontalSpeed, int airJumpCount) {
+	Reach reach = {0, 1};
+	if (jumpSpeed <= 0.0f || gravity <= 0.0f) {
+		return reach;
+	}
+
+	// 1回の最高到達点 v^2 / 2g、同じ高さに戻るまでの時間 2v / g（最高点で跳び直すたびに足される）
+	const float jumpCount = static_cast<float>(1 + std::max(airJumpCount, 0));
+	const float apex = jumpSpeed * jumpSpeed / (2.0f * gravity) * jumpCount;
+	const float airTime = 2.0f * jumpSpeed / gravity * jumpCount;
+	reach.jumpHeight = static_cast<uint32_t>(std::floor(apex));
+	reach.jumpDistance = std::max(1u, static_cast<uint32_t>(std::floor(horizontalSpeed * airTime)));
+	return reach;
+}
+
+/// <summary>
+/// マップから立てるタイルと移動の辺を作る（読み込み時に1回）
+/// </summary>
+void FlowField::Initialize(const MapChipField* mapChipField, const Reach& reach) {
+	assert(mapChipField);
+
+	Clear();
+
+	mapChipField_ = mapChipField;
+	numBlockHorizontal_ = mapChipField_->GetNumBlockHorizontal();
+	numBlockVirtical_ = mapChipField_->GetNumBlockVirtical();
+
+	///===========================================
+	/// 立てるタイルに番号を振る
+	///===========================================
+
+	nodeOfTile_.assign(static_cast<size_t>(numBlockHorizontal_) * numBlockVirtical_, kNoNode);
+	for (uint32_t y = 0; y < numBlockVirtical_; ++y) {
+		for (uint32_t x = 0; x < numBlockHorizontal_; ++x) {
+			if (IsStandable(x, y)) {
+				nodeOfTile_[static_cast<size_t>(y) * numBlockHorizontal_ + x] = static_cast<uint32_t>(tileOfNode_.size());
+				tileOfNode_.push_back(y * numBlockHorizontal_ + x);
+			}
+		}
+	}
+
+	///===========================================
+	/// 歩き・落下・ジャンプの辺
+	///===========================================
+
+	std::vector<ForwardEdge> edges;
+	edges.reserve(tileOfNode_.size() * 4);
+
+	const int32_t width = static_cast<int32_t>(numBlockHorizontal_);
+	const int32_t jumpDistance = static_cast<int32_t>(reach.jumpDistance);
+	const int32_t jumpHeight = static_cast<int32_t>(reach.jumpHeight);
+
+	for (uint32_t from = 0; from < static_cast<uint32_t>(tileOfNode_.size()); ++from) {
+		const int32_t x = static_cast<int32_t>(tileOfNode_[from] % numBlockHorizontal_);
+		const int32_t y = static_cast<int32_t>(tileOfNode_[from] / numBlockHorizontal_);
+
+		for (int32_t side : {-1, 1}) {
+			const int32_t nx = x + side;
+			if (nx < 0 || nx >= width || IsBlock(nx, y)) {
+				continue;
+			}
+
+			// 歩き：隣も立てる
+			uint32_t neighbor = nodeOfTile_[static_cast<size_t>(y) * numBlockHorizontal_ + nx];
+			if (neighbor != kNoNode) {
+				edges.push_back({from, neighbor, static_cast<uint16_t>(kWalkCost), Move::kWalk});
+				continue;
+			}
+
+			// 落下：隣が空中なら、下へ落ちて最初に立てるタイル
+			for (uint32_t ny = static_cast<uint32_t>(y) + 1; ny < numBlockVirtical_ && !IsBlock(nx, ny); ++ny) {
+				uint32_t landing = nodeOfTile_[static_cast<size_t>(ny) * numBlockHorizontal_ + nx];
+				if (landing != kNoNode) {
+					uint32_t depth = std::min(ny - static_cast<uint32_t>(y), kMaxFallCostDepth);
+					edges.push_back({from, landing, static_cast<uint16_t>(kWalkCost + depth), Move::kFall});
+					break;
+				}
+			}
+		}
+
+		// ジャンプ：真上に登ってから、着地する高さを横に進む（その間にブロックが無いこと）
+		for (int32_t dy = 0; dy <= jumpHeight; ++dy) {
+			const int32_t ty = y - dy;
+			// 登る途中（少なくとも頭上1マス）が空いていること
+			if (y - std::max(dy, 1) < 0 || IsBlock(x, y - std::max(dy, 1))) {
+				break;
+			}
+
+			for (int32_t side : {-1, 1}) {
+				for (int32_t dx = 1; dx <= jumpDistance; ++dx) {
+					const int32_t tx = x + side * dx;
+					if (tx < 0 || tx >= width) {
+						break;
+					}
+					// 横に進む高さ（同じ高さへの跳び越えなら頭上の段）にブロックがあればそれ以上先へは跳べない
+					if (IsBlock(tx, ty) || (dy == 0 && IsBlock(tx, y - 1))) {
+						break;
+					}
+					// 同じ高さの隣は歩き
+					if (dy == 0 && dx == 1) {
+						continue;
+					}
+
+					uint32_t to = nodeOfTile_[static_cast<size_t>(ty) * numBlockHorizontal_ + tx];
+					if (to == kNoNode) {
+						continue;
+					}
+					// 同じ高さへは、途中に穴があるときだけ跳ぶ
+					if (dy == 0 && nodeOfTile_[static_cast<size_t>(y) * numBlockHorizontal_ + (x + side)] != kNoNode) {
+						continue;
+					}
+
+					uint32_t cost = kJumpCost + kWalkCost * static_cast<uint32_t>(dx + dy);
+					edges.push_back({from, to, static_cast<uint16_t>(cost), Move::kJump});
+				}
+			}
+		}
+	}
+
+	///===========================================
+	/// 逆向きにまとめる（目標から広げるため）
+	///===========================================
+
+	const uint32_t nodeCount = static_cast<uint32_t>(tileOfNode_.size());
+	incomingOffsets_.assign(nodeCount + 1, 0);
+	for (const ForwardEdge& edge : edges) {
+		++incomingOffsets_[edge.to + 1];
+		maxEdgeCost_ = std::max<uint32_t>(maxEdgeCost_, edge.cost);
+	}
+	for (uint32_t i = 0; i < nodeCount; ++i) {
+		incomingOffsets_[i + 1] += incomingOffsets_[i];
+	}
+
+	incoming_.resize(edges.size());
+	std::vector<uint32_t> cursor(incomingOffsets_.begin(), incomingOffsets_.end() - 1);
+	for (const ForwardEdge& edge : edges) {
+		incoming_[cursor[edge.to]++] = {edge.from, edge.cost, edge.move};
+	}
+
+	cells_.assign(nodeCount, {kUnreachable, kNoNode, 0, Move::kNone});
+	buildCells_.assign(nodeCount, {kUnreachable, kNoNode, 0, Move::kNone});
+	buckets_.resize(maxEdgeCost_ + 1);
+	// 1つのバケツには同じ距離の登録だけが入り、同じタイルは同じ距離で2度入らないので、タイル数あれば作り直し中に広がらない
+	for (std::vector<uint32_t>& bucket : buckets_) {
+		bucket.reserve(nodeCount);
+	}
+}
+
+/// <summary>
+/// 目標の位置を渡して計算を進める
+/// </summary>
+void FlowField::Update(const Vector3& targetPosition, uint32_t budget) {
+	PROFILE_ZONE("FlowField::Update");
+
+	uint32_t target = FindNode(targetPosition);
+	if (target != kNoNode) {
+		requestedTarget_ = target;
+	}
+
+	// 目標のタイルが変わったときだけ作り直す（作成中なら終わってから）
+	if (!isBuilding_ && requestedTarget_ != kNoNode && requestedTarget_ != publishedTarget_) {
+		BeginBuild(requestedTarget_);
+	}
+	if (isBuilding_) {
+		ContinueBuild(budget);
+	}
+}
+
+/// <summary>
+/// 作成中の計算を最後まで進める
+/// </summary>
+void FlowField::Flush() {
+	if (!isBuilding_ && requestedTarget_ != kNoNode && requestedTarget_ != publishedTarget_) {
+		BeginBuild(requestedTarget_);
+	}
+	if (isBuilding_) {
+		ContinueBuild(UINT32_MAX);
+	}
+}
+
+/// <summary>
+/// 公開中の表（作成中ならその途中経過も）を記録に書く
+/// </summary>
+/// <param name="snapshot"></param>
+void FlowField::SaveState(SimulationSnapshot& snapshot) const {
+	State state;
+	state.publishedStamp = publishedStamp_;
+	state.buildStamp = buildStamp_;
+	state.publishedTarget = publishedTarget_;
+	state.currentDistance = currentDistance_;
+	state.queuedCount = queuedCount_;
+	state.buildTarget = buildTarget_;
+	state.requestedTarget = requestedTarget_;
+	state.completedBuilds = completedBuilds_;
+	state.isBuilding = isBuilding_ ? 1u : 0u;
+	snapshot.Write(state);
+
+	snapshot.WriteArray(cells_);
+	if (isBuilding_) {
+		snapshot.WriteArray(buildCells_);
+		for (const std::vector<uint32_t>& bucket : buckets_) {
+			snapshot.WriteArray(bucket);
+		}
+	}
+}
+
+/// <summary>
+/// 記録から戻す
+/// </summary>
+/// <param name="reader"></param>
+void FlowField::LoadState(SimulationSnapshot::Reader& reader) {
+	State state;
+	reader.Read(state);
+
+	reader.ReadArray(cells_);
+	if (state.isBuilding) {
+		reader.ReadArray(buildCells_);
+		for (std::vector<uint32_t>& bucket : buckets_) {
+			reader.ReadArray(bucket);
+		}
+	} else {
+		// 作成中の表は戻さないので、残っている計算結果を無効にしておく（これから使う世代と重ならないように）
+		for (Cell& cell : buildCells_) {
+			cell.stamp = 0;
+		}
+	}
+
+	publishedStamp_ = state.publishedStamp;
+	buildStamp_ = state.buildStamp;
+	publishedTarget_ = state.publishedTarget;
+	currentDistance_ = state.currentDistance;
+	queuedCount_ = state.queuedCount;
+	buildTarget_ = state.buildTarget;
+	requestedTarget_ = state.requestedTarget;
+	completedBuilds_ = state.completedBuilds;
+	isBuilding_ = state.isBuilding != 0;
+}
+
+/// <summary>
+/// 位置から次の1歩を引く
+/// </summary>
+bool FlowField::GetStep(const Vector3& position, Step& step) const {
+	if (!IsReady()) {
+		return false;
+	}
+
+	uint32_t node = FindNode(position);
+	if (node == kNoNode) {
+		return false;
+	}
+
+	const Cell& cell = cells_[node];
+	if (cell.stamp != publishedStamp_ || cell.next == kNoNode) {
+		return false;
+	}
+
+	uint32_t tile = tileOfNode_[cell.next];
+	step.position = mapChipField_->GetMapChipPositionByIndex(tile % numBlockHorizontal_, tile / numBlockHorizontal_);
+	step.move = cell.move;
+	step.distance = cell.distance;
+	return true;
+}
+
+/// <summary>
+/// 解放
+/// </summary>
+void FlowField::Clear() {
+	mapChipField_ = nullptr;
+	numBlockHorizontal_ = 0;
+	numBlockVirtical_ = 0;
+
+	nodeOfTile_.clear();
+	tileOfNode_.clear();
+	incomingOffsets_.clear();
+	incoming_.clear();
+	cells_.clear();
+	buildCells_.clear();
+	buckets_.clear();
+
+	publishedStamp_ = 0;
+	buildStamp_ = 0;
+	publishedTarget_ = kNoNode;
+	maxEdgeCost_ = 1;
+	currentDistance_ = 0;
+	queuedCount_ = 0;
+	buildTarget_ = kNoNode;
+	isBuilding_ = false;
+	requestedTarget_ = kNoNode;
+	completedBuilds_ = 0;
+}
+
+/// <summary>
+/// 立てるタイルか（空いていて、すぐ下がブロック）
+/// </summary>
+bool FlowField::IsStandable(uint32_t xIndex, uint32_t yIndex) const { return yIndex + 1 < numBlockVirtical_ && !IsBlock(xIndex, yIndex) && IsBlock(xIndex, yIndex + 1); }
+
+bool FlowField::IsBlock(uint32_t xIndex, uint32_t yIndex) const { return mapChipField_->GetMapChipTypeByIndex(xIndex, yIndex) == MapChipType::kBlock; }
+
+/// <summary>
+/// 位置に対応するノード（空中なら kGroundSearchDepth まで下を探す）
+/// </summary>
+uint32_t FlowField::FindNode(const Vector3& position) const {
+	if (nodeOfTile_.empty() || position.x < -0.5f || position.y < -0.5f) {
+		return kNoNode;
+	}
+
+	MapChipField::IndexSet indexSet = mapChipField_->GetMapChipIndexSetByPosition(position);
+	if (indexSet.xIndex >= numBlockHorizontal_ || indexSet.yIndex >= numBlockVirtical_) {
+		return kNoNode;
+	}
+
+	for (uint32_t depth = 0; depth <= kGroundSearchDepth && indexSet.yIndex + depth < numBlockVirtical_; ++depth) {
+		uint32_t y = indexSet.yIndex + depth;
+		uint32_t node = nodeOfTile_[static_cast<size_t>(y) * numBlockHorizontal_ + indexSet.xIndex];
+		if (node != kNoNode) {
+			return node;
+		}
+		if (IsBlock(indexSet.xIndex, y)) {
+			break;
+		}
+	}
+	return kNoNode;
+}
+
+/// <summary>
+/// 目標から作り直しを始める
+/// </summary>
+void FlowField::BeginBuild(uint32_t target) {
+	// 世代を進めるだけで前の計算結果は無効になる（表を埋め直さない）
+	++buildStamp_;
+	if (buildStamp_ == publishedStamp_) {
+		++buildStamp_;
+	}
+
+	for (std::vector<uint32_t>& bucket : buckets_) {
+		bucket.clear();
+	}
+	currentDistance_ = 0;
+	queuedCount_ = 0;
+	buildTarget_ = target;
+	isBuilding_ = true;
+
+	Relax(target, 0, kNoNode, Move::kNone);
+}
+
+/// <summary>
+/// 作り直しを budget タイル分進める
+/// </summary>
+void FlowField::ContinueBuild(uint32_t budget) {
+	const uint32_t bucketCount = static_cast<uint32_t>(buckets_.size());
+
+	while (budget > 0 && queuedCount_ > 0) {
+		std::vector<uint32_t>& bucket = buckets_[currentDistance_ % bucketCount];
+		if (bucket.empty()) {
+			++currentDistance_;
+			continue;
+		}
+
+		uint32_t node = bucket.back();
+		bucket.pop_back();
+		--queuedCount_;
+
+		// 後からより近い距離が見つかった古い登録は飛ばす
+		if (buildCells_[node].distance != currentDistance_) {
+			continue;
+		}
+
+		// このタイルへ来られるタイルを広げる
+		for (uint32_t i = incomingOffsets_[node]; i < incomingOffsets_[node + 1]; ++i) {
+			const Edge& edge = incoming_[i];
+			Relax(edge.from, currentDistance_ + edge.cost, node, edge.move);
+		}
+		--budget;
+	}
+
+	if (queuedCount_ == 0) {
+		// 作り終えたので公開する
+		std::swap(cells_, buildCells_);
+		publishedStamp_ = buildStamp_;
+		publishedTarget_ = buildTarget_;
+		isBuilding_ = false;
+		++completedBuilds_;
+	}
+}
+
+/// <summary>
+/// 作成中の表に距離を書いてバケツに入れる
+/// </summary>
+void FlowField::Relax(uint32_t node, uint32_t distance, uint32_t next, Move move) {
+	Cell& cell = buildCells_[node];
+	if (cell.stamp == buildStamp_ && cell.distance <= distance) {
+		return;
+	}
+
+	cell = {distance, next, buildStamp_, move};
+	buckets_[distance % buckets_.size()].push_back(node);
+	++queuedCount_;
+}
@@ -0,0 +1,198 @@
+#pragma once
+#include "KamataEngine.h"
+#include "SimulationSnapshot.h"
+
+#include <cstdint>
+#include <vector>
+
+class MapChipField;
+
+/// <summary>
+/// 立てるタイルごとに「プレイヤーへ向かう次の1歩」を持つ表（全ての敵が1回引くだけで経路を得る）
+/// 目標のタイルが変わったときだけ作り直し、作り直しは数フレームに分けて進める
+/// </summary>
+class FlowField {
+public:
+	// 次の1歩の動き方
+	enum class Move : uint8_t {
+		kNone, // 目標に着いている・道が無い
+		kWalk, // 隣へ歩く
+		kFall, // 横へ出て落ちる
+		kJump, // 跳んで上・先の足場へ
+	};
+
+	// 跳んで届く範囲（ブロック数）
+	struct Reach {
+		uint32_t jumpHeight;   // 上に登れる段数
+		uint32_t jumpDistance; // 横に跳べる距離
+	};
+
+	// 次の1歩
+	struct Step {
+		KamataEngine::Vector3 position; // 次のタイルの中心
+		Move move;                      // 動き方
+		uint32_t distance;              // 目標までのコスト
+	};
+
+	// 道が無い・未計算
+	static inline const uint32_t kUnreachable = UINT32_MAX;
+	// 1フレームに確定させるタイル数の目安
+	static inline const uint32_t kDefaultBudget = 4096;
+	// 空中にいるときに足場を探す深さ（ブロック数）
+	static inline const uint32_t kGroundSearchDepth = 4;
+
+private:
+	// 逆向きの辺（from から このタイルへ来られる）
+	struct Edge {
+		uint32_t from;
+		uint16_t cost;
+		Move move;
+	};
+
+	// タイルごとの計算結果（stamp が世代と一致するときだけ有効）
+	struct Cell {
+		uint32_t distance;
+		uint32_t next;
+		uint32_t stamp;
+		Move move;
+		uint8_t padding[3]; // 詰め物を明示（記録のバイト列を毎回同じにする）
+	};
+	static_assert(sizeof(Cell) == 16, "Cell は記録にそのまま書くので詰め物を残さない");
+
+	// タイル番号のない場所
+	static inline const uint32_t kNoNode = UINT32_MAX;
+
+	const MapChipField* mapChipField_ = nullptr;
+	uint32_t numBlockHorizontal_ = 0;
+	uint32_t numBlockVirtical_ = 0;
+
+	// タイル → ノード番号（立てないタイルは kNoNode）、ノード → タイル
+	std::vector<uint32_t> nodeOfTile_;
+	std::vector<uint32_t> tileOfNode_;
+
+	// 逆向きの辺（CSR 形式。incomingOffsets_[v]～[v+1] が v へ入る辺）
+	std::vector<uint32_t> incomingOffsets_;
+	std::vector<Edge> incoming_;
+
+	// 公開中の表と作成中の表（作り終えたら入れ替える）
+	std::vector<Cell> cells_;
+	std::vector<Cell> buildCells_;
+	uint32_t publishedStamp_ = 0;
+	uint32_t buildStamp_ = 0;
+	uint32_t publishedTarget_ = kNoNode;
+
+	// 作成中の状態（距離ごとのバケツで Dijkstra を進める）
+	std::vector<std::vector<uint32_t>> buckets_;
+	uint32_t maxEdgeCost_ = 1;
+	uint32_t currentDistance_ = 0;
+	uint32_t queuedCount_ = 0;
+	uint32_t buildTarget_ = kNoNode;
+	bool isBuilding_ = false;
+
+	// 次に作る目標（作成中に変わったら、作り終えてから最新の目標で作り直す）
+	uint32_t requestedTarget_ = kNoNode;
+
+	// 統計
+	uint32_t completedBuilds_ = 0;
+
+	// 記録に書く状態（表は別に書く）
+	struct State {
+		uint32_t publishedStamp;
+		uint32_t buildStamp;
+		uint32_t publishedTarget;
+		uint32_t currentDistance;
+		uint32_t queuedCount;
+		uint32_t buildTarget;
+		uint32_t requestedTarget;
+		uint32_t completedBuilds;
+		uint32_t isBuilding;
+	};
+
+public:
+	/// <summary>
+	/// 物理定数から跳んで届く範囲を求める（速度・加速度は1フレームあたり、ブロックの大きさを1とする）
+	/// </summary>
+	/// <param name="jumpSpeed">ジャンプの初速度</param>
+	/// <param name="gravity">重力加速度</param>
+	/// <param name="horizontalSpeed">空中での横の速さ</param>
+	/// <param name="airJumpCount">空中で追加できるジャンプの回数（最高点で跳び直す）</param>
+	/// <returns></returns>
+	static Reach MakeReach(float jumpSpeed, float gravity, float horizontalSpeed, int airJumpCount = 0);
+
+	/// <summary>
+	/// マップから立てるタイルと移動の辺を作る（読み込み時に1回）
+	/// </summary>
+	/// <param name="mapChipField"></param>
+	/// <param name="reach"></param>
+	void Initialize(const MapChipField* mapChipField, const Reach& reach);
+
+	/// <summary>
+	/// 目標の位置を渡して計算を進める（目標のタイルが変わっていなければほぼ何もしない）
+	/// </summary>
+	/// <param name="targetPosition"></param>
+	/// <param name="budget">このフレームで確定させるタイル数の上限</param>
+	void Update(const KamataEngine::Vector3& targetPosition, uint32_t budget = kDefaultBudget);
+
+	/// <summary>
+	/// 作成中の計算を最後まで進める（読み込み直後など）
+	/// </summary>
+	void Flush();
+
+	/// <summary>
+	/// 位置から次の1歩を引く（空中なら少し下の足場で引く）
+	/// </summary>
+	/// <param name="position"></param>
+	/// <param name="step"></param>
+	/// <returns>道があれば true</returns>
+	bool GetStep(const KamataEngine::Vector3& position, Step& step) const;
+
+	/// <summary>
+	/// 公開中の表（作成中ならその途中経過も）を記録に書く / 記録から戻す
+	/// 作成中でなければ途中経過は書かないので、ほとんどの場合は公開中の表1枚分
+	/// </summary>
+	/// <param name="snapshot"></param>
+	void SaveState(SimulationSnapshot& snapshot) const;
+	void LoadState(SimulationSnapshot::Reader& reader);
+
+	/// <summary>
+	/// 解放
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetNodeCount() const { return static_cast<uint32_t>(tileOfNode_.size()); }
+	uint32_t GetEdgeCount() const { return static_cast<uint32_t>(incoming_.size()); }
+	uint32_t GetCompletedBuilds() const { return completedBuilds_; }
+	bool IsBuilding() const { return isBuilding_; }
+	bool IsReady() const { return publishedTarget_ != kNoNode; }
+
+private:
+	/// <summary>
+	/// 立てるタイルか（空いていて、すぐ下がブロック）
+	/// </summary>
+	bool IsStandable(uint32_t xIndex, uint32_t yIndex) const;
+	bool IsBlock(uint32_t xIndex, uint32_t yIndex) const;
+
+	/// <summary>
+	/// 位置に対応するノード（空中なら kGroundSearchDepth まで下を探す）
+	/// </summary>
+	uint32_t FindNode(const KamataEngine::Vector3& position) const;
+
+	/// <summary>
+	/// 目標から作り直しを始める
+	/// </summary>
+	void BeginBuild(uint32_t target);
+
+	/// <summary>
+	/// 作り直しを budget タイル分進める
+	/// </summary>
+	void ContinueBuild(uint32_t budget);
+
+	/// <summary>
+	/// 作成中の表に距離を書いてバケツに入れる
+	/// </summary>
+	void Relax(uint32_t node, uint32_t distance, uint32_t next, Move move);
+};
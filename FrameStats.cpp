@@ -0,0 +1,138 @@
+#define NOMINMAX
+#include "FrameStats.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+/// <summary>
+/// 並べ済みの値からパーセンタイル（最近傍）
+/// </summary>
+double Percentile(const std::vector<float>& sorted, double percent) {
+	if (sorted.empty()) {
+		return 0.0;
+	}
+	size_t rank = static_cast<size_t>(std::ceil(percent / 100.0 * static_cast<double>(sorted.size())));
+	rank = std::clamp<size_t>(rank, 1, sorted.size());
+	return sorted[rank - 1];
+}
+
+int64_t NowNanoseconds() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+} // namespace
+
+/// <summary>
+/// インスタンスの取得
+/// </summary>
+/// <returns></returns>
+FrameStats* FrameStats::GetInstance() {
+	static FrameStats instance;
+	return &instance;
+}
+
+/// <summary>
+/// 1フレーム分の値を記録
+/// </summary>
+/// <param name="name">系列名</param>
+/// <param name="milliseconds"></param>
+void FrameStats::Record(const char* name, double milliseconds) {
+	auto it = std::find_if(series_.begin(), series_.end(), [name](const Series& series) { return series.name == name; });
+	if (it == series_.end()) {
+		Series series;
+		series.name = name;
+		series.window.reserve(kWindowSize);
+		series_.push_back(std::move(series));
+		it = series_.end() - 1;
+	}
+
+	Series& series = *it;
+	if (series.window.size() < kWindowSize) {
+		series.window.push_back(static_cast<float>(milliseconds));
+	} else {
+		series.window[series.samples % kWindowSize] = static_cast<float>(milliseconds);
+	}
+	++series.samples;
+
+	series.max = std::max(series.max, milliseconds);
+	if (milliseconds > kFrameBudgetMs) {
+		++series.overBudget;
+	}
+	if (milliseconds > kHitchMs) {
+		++series.hitches;
+	}
+}
+
+/// <summary>
+/// 集計（記録が無ければ samples == 0）
+/// </summary>
+/// <param name="name">系列名</param>
+/// <returns></returns>
+FrameStats::Summary FrameStats::GetSummary(const std::string& name) const {
+	for (const Series& series : series_) {
+		if (series.name == name) {
+			return Summarize(series);
+		}
+	}
+	return Summary{};
+}
+
+/// <summary>
+/// 全系列を CSV で書き出す
+/// </summary>
+/// <param name="filePath"></param>
+/// <returns>書き出せたか</returns>
+bool FrameStats::WriteCsv(const std::string& filePath) const {
+	std::FILE* file = std::fopen(filePath.c_str(), "w");
+	if (!file) {
+		return false;
+	}
+
+	std::fprintf(file, "series,samples,window,mean_ms,p50_ms,p95_ms,p99_ms,window_max_ms,max_ms,over_budget,hitches\n");
+	for (const Series& series : series_) {
+		Summary summary = Summarize(series);
+		std::fprintf(file, "%s,%llu,%u,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%llu,%llu\n", series.name.c_str(), static_cast<unsigned long long>(summary.samples), summary.window, summary.mean,
+		             summary.p50, summary.p95, summary.p99, summary.windowMax, summary.max, static_cast<unsigned long long>(summary.overBudget),
+		             static_cast<unsigned long long>(summary.hitches));
+	}
+
+	return std::fclose(file) == 0;
+}
+
+/// <summary>
+/// 集計
+/// </summary>
+/// <param name="series"></param>
+/// <returns></returns>
+FrameStats::Summary FrameStats::Summarize(const Series& series) {
+	Summary summary;
+	summary.samples = series.samples;
+	summary.window = static_cast<uint32_t>(series.window.size());
+	summary.max = series.max;
+	summary.overBudget = series.overBudget;
+	summary.hitches = series.hitches;
+
+	if (series.window.empty()) {
+		return summary;
+	}
+
+	std::vector<float> sorted = series.window;
+	std::sort(sorted.begin(), sorted.end());
+
+	double total = 0.0;
+	for (float value : sorted) {
+		total += value;
+	}
+	summary.mean = total / static_cast<double>(sorted.size());
+	summary.p50 = Percentile(sorted, 50.0);
+	summary.p95 = Percentile(sorted, 95.0);
+	summary.p99 = Percentile(sorted, 99.0);
+	summary.windowMax = sorted.back();
+
+	return summary;
+}
+
+FrameStatsScope::FrameStatsScope(const char* name) : name_(name), begin_(NowNanoseconds()) {}
+
+FrameStatsScope::~FrameStatsScope() { FrameStats::GetInstance()->Record(name_, static_cast<double>(NowNanoseconds() - begin_) / 1.0e6); }
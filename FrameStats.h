@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// フレーム時間の統計（系列ごとに直近の値を持ち、パーセンタイルとヒッチ数を出す）
+/// </summary>
+class FrameStats {
+public:
+	// 直近何フレーム分でパーセンタイルを出すか
+	static inline const uint32_t kWindowSize = 600;
+	// 1フレームの予算（ミリ秒）
+	static inline const double kFrameBudgetMs = 1000.0 / 60.0;
+	// ヒッチとみなす時間（垂直同期を1回取りこぼす長さ）
+	static inline const double kHitchMs = kFrameBudgetMs * 2.0;
+
+	// 1系列の集計結果（ミリ秒）
+	struct Summary {
+		uint64_t samples = 0;    // 記録した総数
+		uint32_t window = 0;     // パーセンタイルに使った数
+		double mean = 0.0;       // 直近の平均
+		double p50 = 0.0;        // 直近の中央値
+		double p95 = 0.0;        // 直近の95パーセンタイル
+		double p99 = 0.0;        // 直近の99パーセンタイル
+		double windowMax = 0.0;  // 直近の最大
+		double max = 0.0;        // 全期間の最大
+		uint64_t overBudget = 0; // 予算を超えた回数
+		uint64_t hitches = 0;    // ヒッチの回数
+	};
+
+private:
+	// 1系列分
+	struct Series {
+		std::string name;
+		std::vector<float> window; // 直近の値（リングバッファ）
+		uint64_t samples = 0;
+		double max = 0.0;
+		uint64_t overBudget = 0;
+		uint64_t hitches = 0;
+	};
+
+	// 記録順に並べる（系列は十数個なので線形に探す）
+	std::vector<Series> series_;
+
+public:
+	/// <summary>
+	/// インスタンスの取得
+	/// </summary>
+	/// <returns></returns>
+	static FrameStats* GetInstance();
+
+	/// <summary>
+	/// 1フレーム分の値を記録
+	/// </summary>
+	/// <param name="name">系列名</param>
+	/// <param name="milliseconds"></param>
+	void Record(const char* name, double milliseconds);
+
+	/// <summary>
+	/// 集計（記録が無ければ samples == 0）
+	/// </summary>
+	/// <param name="name">系列名</param>
+	/// <returns></returns>
+	Summary GetSummary(const std::string& name) const;
+	/// <summary>
+	/// 全系列を CSV で書き出す
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <returns>書き出せたか</returns>
+	bool WriteCsv(const std::string& filePath) const;
+	/// <summary>
+	/// 記録を捨てる
+	/// </summary>
+	void Reset() { series_.clear(); }
+
+private:
+	FrameStats() = default;
+	~FrameStats() = default;
+	FrameStats(const FrameStats&) = delete;
+	FrameStats& operator=(const FrameStats&) = delete;
+
+	/// <summary>
+	/// 集計
+	/// </summary>
+	/// <param name="series"></param>
+	/// <returns></returns>
+	static Summary Summarize(const Series& series);
+};
+
+/// <summary>
+/// スコープを抜けるまでの時間を FrameStats に記録する
+/// </summary>
+class FrameStatsScope {
+private:
+	const char* name_;
+	int64_t begin_;
+
+public:
+	explicit FrameStatsScope(const char* name);
+	~FrameStatsScope();
+
+	FrameStatsScope(const FrameStatsScope&) = delete;
+	FrameStatsScope& operator=(const FrameStatsScope&) = delete;
+};
@@ -1,57 +1,76 @@
 #define NOMINMAX
 #include "GameScene.h"
+#include "AllocationTracker.h"
+#include "AssetCache.h"
 #include "Fireworks.h"
+#include "FrameStats.h"
+#include "HudFont.h"
+#include "Profiler.h"
 #include "Random.h"
+#include "ScenePreloader.h"
+#include "UiAtlas.h"
 #include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <thread>
 
 using namespace KamataEngine;
 using namespace KamataEngine::MathUtility;
 
+namespace {
+
+// フェーズごとの FrameStats の系列名（Phase の並び順）
+const char* const kUpdateStatNames[] = {"GameScene.Update.kFadeIn", "GameScene.Update.kPlay", "GameScene.Update.kDeath", "GameScene.Update.kClear", "GameScene.Update.kFadeOut"};
+const char* const kDrawStatNames[] = {"GameScene.Draw.kFadeIn", "GameScene.Draw.kPlay", "GameScene.Draw.kDeath", "GameScene.Draw.kClear", "GameScene.Draw.kFadeOut"};
+
+// Initialize で AssetCache から取るモデル（SceneManager が切り替え前に読み込んでおく）
+const std::vector<std::string> kModelNames = {"player", "attackEffect", "deathParticle", "enemy", "hitEffect", "cloud", "goal", "fireworks", "skyDome", "block"};
+
+} // namespace
+
 /// <summary>
 /// デストラクタ
 /// </summary>
 GameScene::~GameScene() {
 	// プレイヤー
-	delete modelPlayer_;
-	delete modelAttack_;
+	AssetCache::GetInstance()->ReleaseModel(modelPlayer_);
+	AssetCache::GetInstance()->ReleaseModel(modelAttack_);
 	delete player_;
 
 	// 死亡時のパーティクル
-	delete modelDeathParticle_;
-	delete deathParticles_;
+	AssetCache::GetInstance()->ReleaseModel(modelDeathParticle_);
+	delete deathParticlesPool_;
+	deathParticles_ = nullptr;
 
 	// 敵
-	delete modelEnemy_;
-	for (Enemy* enemy : enemies_) {
-		delete enemy;
-	}
-	enemies_.clear();
+	AssetCache::GetInstance()->ReleaseModel(modelEnemy_);
+	enemySpawner_.Clear();
 
 	// ヒットエフェクト
-	delete modelHitEffect_;
+	AssetCache::GetInstance()->ReleaseModel(modelHitEffect_);
 	for (HitEffect* hitEffect : hitEffects_) {
 		delete hitEffect;
 	}
 	hitEffects_.clear();
+	for (HitEffect* hitEffect : freeHitEffects_) {
+		delete hitEffect;
+	}
+	freeHitEffects_.clear();
 
 	// ブロック
-	delete modelBlock_;
+	AssetCache::GetInstance()->ReleaseModel(modelBlock_);
 
-	for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-			delete worldTransformBlock;
-		}
-	}
-	worldTransformBlocks_.clear();
+	blockTransforms_.Clear();
 
 	// ゴール
-	delete modelGoal_;
+	AssetCache::GetInstance()->ReleaseModel(modelGoal_);
 
+	AssetCache::GetInstance()->ReleaseModel(modelFireworksParticle_);
 	delete fireworks_;
 	fireworks_ = nullptr;
 
 	// 天球
-	delete modelSkydome_;
+	AssetCache::GetInstance()->ReleaseModel(modelSkydome_);
 	delete skydome_;
 
 	// マップチップフィールド
@@ -70,7 +89,7 @@ GameScene::~GameScene() {
 	delete sprToTitle_;
 	sprToTitle_ = nullptr;
 
-	delete modelCloud_;
+	AssetCache::GetInstance()->ReleaseModel(modelCloud_);
 	modelCloud_ = nullptr;
 	for (size_t i = 0; i < worldTransformClouds_.size(); ++i) {
 		delete worldTransformClouds_[i];
@@ -83,6 +102,44 @@ GameScene::~GameScene() {
 	sprHintJump_ = nullptr;
 }
 
+/// <summary>
+/// 準備処理（ワーカースレッドで呼べる。GPUリソースには触れない）
+/// </summary>
+void GameScene::Prepare() {
+	///===========================================
+	/// マップチップフィールド
+	/// ===========================================
+
+	mapChipField_ = new MapChipField;
+	mapChipField_->LoadMapChipCsv(kMapPath);
+
+	// 移動グラフ（初回は軌道を試して作り、マップの横に保存する）
+	navGraph_.LoadOrBuild(kMapPath, *mapChipField_, NavGraph::MakePlayerPhysics());
+
+	///===========================================
+	/// ゴースト
+	/// ===========================================
+
+	// これまでの速い記録（無い・別のマップのものなら空）
+	ghostBoard_.Load(kGhostBoardPath, GhostBoard::ComputeMapKey(*mapChipField_));
+
+	///===========================================
+	/// ブロック
+	/// ===========================================
+
+	// インスタンスバッファ（ブロックを列順に1本にまとめる）
+	blockBatch_.Build(*mapChipField_);
+
+	///===========================================
+	/// モデルのファイル
+	/// ===========================================
+
+	// 読み込み自体はメインスレッドで行うので、ファイルだけ先に読んでおく
+	ScenePreloader::PrefetchModelFiles({"player", "attackEffect", "deathParticle", "enemy", "hitEffect", "block", "cloud", "goal", "fireworks", "skydome"});
+
+	isPrepared_ = true;
+}
+
 /// <summary>
 /// 初期化処理
 /// </summary>
@@ -113,16 +170,18 @@ void GameScene::Initialize() {
 	/// マップチップフィールド
 	/// ===========================================
 
-	mapChipField_ = new MapChipField;
-	mapChipField_->LoadMapChipCsv("Resources/blocks.csv");
+	// 準備がまだなら、ここでまとめて行う
+	if (!isPrepared_) {
+		Prepare();
+	}
 
 	///===========================================
 	/// プレイヤー
 	/// ===========================================
 
 	// 3Dモデルの生成
-	modelPlayer_ = Model::CreateFromOBJ("player", true);
-	modelAttack_ = Model::CreateFromOBJ("attackEffect", true);
+	modelPlayer_ = AssetCache::GetInstance()->AcquireModel("player", true);
+	modelAttack_ = AssetCache::GetInstance()->AcquireModel("attackEffect", true);
 
 	// プレイヤーの生成
 	player_ = new Player();
@@ -139,39 +198,46 @@ void GameScene::Initialize() {
 	/// ===========================================
 
 	// 3Dモデルの生成
-	modelDeathParticle_ = Model::CreateFromOBJ("deathParticle", true);
+	modelDeathParticle_ = AssetCache::GetInstance()->AcquireModel("deathParticle", true);
 
 	///===========================================
 	/// 敵
 	/// ===========================================
 
 	// 3Dモデルの生成
-	modelEnemy_ = Model::CreateFromOBJ("enemy", true);
-
-	for (uint32_t i = 0; i < 3; ++i) {
-		// 敵の生成
-		Enemy* newEnemy = new Enemy();
+	modelEnemy_ = AssetCache::GetInstance()->AcquireModel("enemy", true);
 
-		Vector3 enemyPosition = mapChipField_->GetMapChipPositionByIndex(30 + 10 * i, 18);
+	// マップの出現位置を記録する（実体化は UpdateActivation でカメラの近くだけ）
+	enemySpawner_.Initialize(mapChipField_, modelEnemy_, &camera_, this);
 
-		// 敵の初期化
-		newEnemy->Initialize(modelEnemy_, &camera_, enemyPosition);
-		newEnemy->SetGameScene(this);
-		newEnemy->SetMapChipField(mapChipField_);
-
-		enemies_.push_back(newEnemy);
-	}
+	// 追跡用の経路（跳べる高さはプレイヤーの空中ジャンプ込み、横の距離は敵の歩く速さで見積もる）
+	flowField_.Initialize(mapChipField_, FlowField::MakeReach(Player::GetJumpAcceleration(), Player::GetGravityAcceleration(), Enemy::GetWalkSpeed(), Player::GetMaxJumpCount()));
+	flowField_.Update(playerPosition);
+	flowField_.Flush();
+	enemySpawner_.SetFlowField(&flowField_);
 
 	///===========================================
 	/// ヒットエフェクト
 	/// ===========================================
 
 	// 3Dモデルの生成
-	modelHitEffect_ = Model::CreateFromOBJ("hitEffect", true);
+	modelHitEffect_ = AssetCache::GetInstance()->AcquireModel("hitEffect", true);
 
 	HitEffect::SetModel(modelHitEffect_);
 	HitEffect::SetCamera(&camera_);
 
+	// 同時に出る程度の数は先に作っておく（ヒットのたびに確保しない）
+	{
+		ALLOCATION_TAG(AllocationTag::kHitEffect);
+		hitEffects_.reserve(kHitEffectPoolSize);
+		freeHitEffects_.reserve(kHitEffectPoolSize);
+		for (uint32_t i = 0; i < kHitEffectPoolSize; ++i) {
+			HitEffect* hitEffect = new HitEffect();
+			hitEffect->Initialize();
+			freeHitEffects_.push_back(hitEffect);
+		}
+	}
+
 	///===========================================
 	/// ブロック
 	/// ===========================================
@@ -181,10 +247,10 @@ void GameScene::Initialize() {
 	///===========================================
 	/// 雲（背景）
 	///===========================================
-	modelCloud_ = Model::CreateFromOBJ("cloud", true);
+	modelCloud_ = AssetCache::GetInstance()->AcquireModel("cloud", true);
 
-	// 乱数エンジン初期化（毎回同じ配置で良いなら省略可）
-	Random::SeedEngine();
+	// 背景配置用の列（シードは Random::SetGlobalSeed で決まる）
+	Random::Stream& random = Random::GetStream(Random::System::kScenery);
 
 	// マップの横幅から X 範囲を決める（左右に少し余白）
 	uint32_t mapW = mapChipField_->GetNumBlockHorizontal();
@@ -209,11 +275,11 @@ void GameScene::Initialize() {
 		WorldTransform* wt = new WorldTransform();
 		wt->Initialize();
 
-		// ランダム座標とスケール（Random::GeneraterFloat(min, max) を使用）
-		float x = Random::GeneraterFloat(xMin, xMax);
-		float y = Random::GeneraterFloat(yMin, yMax);
-		float z = Random::GeneraterFloat(zMin, zMax);
-		float s = Random::GeneraterFloat(sMin, sMax);
+		// ランダム座標とスケール
+		float x = random.NextFloat(xMin, xMax);
+		float y = random.NextFloat(yMin, yMax);
+		float z = random.NextFloat(zMin, zMax);
+		float s = random.NextFloat(sMin, sMax);
 
 		wt->translation_ = {x, y, z};
 		wt->scale_ = {s, s, 1.0f};
@@ -221,7 +287,6 @@ void GameScene::Initialize() {
 		worldTransformClouds_.push_back(wt);
 	}
 
-	Random::SeedEngine(); // 乱数エンジン初期化
 
 	///===========================================
 	/// ゴール
@@ -241,26 +306,35 @@ void GameScene::Initialize() {
 			break;
 	}
 
+	// 開始位置からゴールまでの経路（HUD にジャンプの回数を出す）
+	routeJumpCount_ = UINT32_MAX;
+	std::vector<NavGraph::PathLink> route;
+	if (hasGoal_ && navGraph_.FindPath(playerPosition, worldTransformGoal_.translation_, route)) {
+		routeJumpCount_ = static_cast<uint32_t>(std::count_if(route.begin(), route.end(), [](const NavGraph::PathLink& link) { return link.kind == NavGraph::LinkKind::kJump; }));
+	}
+
 	///===========================================
 	/// ゴール
 	/// ===========================================
 
-	modelGoal_ = Model::CreateFromOBJ("goal", true);
-	modelFireworksParticle_ = Model::CreateFromOBJ("fireworks", true);
+	modelGoal_ = AssetCache::GetInstance()->AcquireModel("goal", true);
+	modelFireworksParticle_ = AssetCache::GetInstance()->AcquireModel("fireworks", true);
 
 	///===========================================
 	/// 天球
 	/// ===========================================
 
-	modelSkydome_ = Model::CreateFromOBJ("skyDome", true);
+	modelSkydome_ = AssetCache::GetInstance()->AcquireModel("skyDome", true);
 
 	// 天球の生成
 	skydome_ = new Skydome();
 	// 天球の初期化
 	skydome_->Initialize(modelSkydome_, &camera_);
 
-	texClearBanner_ = TextureManager::Load("text/clear.png");
-	sprClearBanner_ = Sprite::Create(texClearBanner_, {640.0f, 240.0f}, {1, 1, 1, 0}, {0.5f, 0.5f});
+	// 文字の画像はまとめて1枚のテクスチャから
+	uiAtlas_.Initialize(UiAtlas::kData);
+
+	sprClearBanner_ = uiAtlas_.CreateSprite("text/clear.png", {640.0f, 240.0f}, {1, 1, 1, 0}, {0.5f, 0.5f});
 
 	bannerScale_ = 1.0f;
 	bannerAlpha_ = 0.0f;
@@ -294,40 +368,72 @@ void GameScene::Initialize() {
 	AxisIndicator::GetInstance()->SetVisible(true);
 	AxisIndicator::GetInstance()->SetTargetCamera(&debugCamera_->GetCamera());
 
-	texCount_[0] = TextureManager::Load("text/number/0.png");
-	texCount_[1] = TextureManager::Load("text/number/1.png");
-	texCount_[2] = TextureManager::Load("text/number/2.png");
-	texCount_[3] = TextureManager::Load("text/number/3.png");
-
-	// アンカーを中心にして作る（ズレ防止）
-	for (int i = 0; i <= 3; ++i) {
-		sprCount_[i] = Sprite::Create(texCount_[i], countPos_, {1, 1, 1, 1}, {0.5f, 0.5f});
-	}
+	// === HUD の文字（数字・ASCII を1枚のアトラスで） ===
+	hudText_.Reserve(kHudQuadCount);
+	hudTextRenderer_.Initialize(HudFont::kTexturePath, HudFont::kAtlasWidth, HudFont::kAtlasHeight, kHudQuadCount);
 	countIndex_ = 3;
 
 	// === スタート画像 ===
-	texStart_ = TextureManager::Load("text/startText.png");
-	sprStart_ = Sprite::Create(texStart_, countPos_, {1, 1, 1, 1}, {0.5f, 0.5f});
+	sprStart_ = uiAtlas_.CreateSprite("text/startText.png", countPos_, {1, 1, 1, 1}, {0.5f, 0.5f});
 
 	// 最初はカウント中
 	startPhase_ = StartPhase::kCounting;
 
-	texToTitle_ = TextureManager::Load("text/backTitleText.png");
-	sprToTitle_ = Sprite::Create(texToTitle_, {640.0f, 520.0f}, {1, 1, 1, 0}, {0.5f, 0.5f});
+	sprToTitle_ = uiAtlas_.CreateSprite("text/backTitleText.png", {640.0f, 520.0f}, {1, 1, 1, 0}, {0.5f, 0.5f});
 
 	// === 下部チュートリアルヒント ===
-	texHintMove_ = TextureManager::Load("text/tutorial/move.png"); // 「いどう ← →」
-	texHintJump_ = TextureManager::Load("text/tutorial/jump.png"); // 「スペース ジャンプ」
-	texHintAttack_ = TextureManager::Load("text/tutorial/attack.png");
-
 	// アンカーを下中央にしておくと、Yの整列が楽
-	sprHintMove_ = Sprite::Create(texHintMove_, hintMovePos_, {1, 1, 1, 1}, {0.5f, 1.0f});
-	sprHintJump_ = Sprite::Create(texHintJump_, hintJumpPos_, {1, 1, 1, 1}, {0.5f, 1.0f});
-	sprHintAttack_ = Sprite::Create(texHintAttack_, hintAttackPos_, {1, 1, 1, 1}, {0.5f, 1.0f});
-	// 例：幅360px・高さ72pxくらいに
-	sprHintMove_->SetSize({360.0f, 72.0f});
-	sprHintJump_->SetSize({400.0f, 72.0f}); // 画像の横幅に合わせて微調整
-	sprHintAttack_->SetSize({400.0f, 72.0f});
+	sprHintMove_ = uiAtlas_.CreateSprite("text/tutorial/move.png", hintMovePos_, {1, 1, 1, 1}, {0.5f, 1.0f}); // 「いどう ← →」
+	sprHintJump_ = uiAtlas_.CreateSprite("text/tutorial/jump.png", hintJumpPos_, {1, 1, 1, 1}, {0.5f, 1.0f}); // 「スペース ジャンプ」
+	sprHintAttack_ = uiAtlas_.CreateSprite("text/tutorial/attack.png", hintAttackPos_, {1, 1, 1, 1}, {0.5f, 1.0f});
+	// 例：幅360px・高さ72pxくらいに（元画像をこの大きさで描いたのと同じになる）
+	uiAtlas_.SetSpriteSize(sprHintMove_, "text/tutorial/move.png", {360.0f, 72.0f});
+	uiAtlas_.SetSpriteSize(sprHintJump_, "text/tutorial/jump.png", {400.0f, 72.0f}); // 画像の横幅に合わせて微調整
+	uiAtlas_.SetSpriteSize(sprHintAttack_, "text/tutorial/attack.png", {400.0f, 72.0f});
+
+	///===========================================
+	/// 描画キュー
+	/// ===========================================
+
+	// 登録順がそのまま描画順になる（雲は天球より後に描く）
+	renderBackend_.Initialize(&camera_);
+	renderModelSkydome_ = renderBackend_.RegisterModel(modelSkydome_);
+	renderModelBlock_ = renderBackend_.RegisterModel(modelBlock_);
+	renderModelGoal_ = renderBackend_.RegisterModel(modelGoal_);
+	renderModelCloud_ = renderBackend_.RegisterModel(modelCloud_);
+	renderModelEnemy_ = renderBackend_.RegisterModel(modelEnemy_);
+	renderModelPlayer_ = renderBackend_.RegisterModel(modelPlayer_);
+	renderModelAttack_ = renderBackend_.RegisterModel(modelAttack_);
+	renderModelFireworks_ = renderBackend_.RegisterModel(modelFireworksParticle_);
+
+	// ゴーストはプレイヤーのモデルを半透明で
+	ghostColor_.Initialize();
+	ghostColor_.SetColor({1.0f, 1.0f, 1.0f, 0.35f});
+	renderMaterialGhost_ = renderBackend_.RegisterMaterial(&ghostColor_);
+
+	// ブロックはインスタンスバッファと同じ順に静的テーブルへ並べておく
+	blockTransformBase_ = renderBackend_.GetStaticTransformCount();
+	for (uint32_t i = 0; i < blockTransforms_.GetCount(); ++i) {
+		renderBackend_.AddStaticTransform(blockTransforms_.GetTransforms()[i]);
+	}
+
+	// コア数が1なら描画スレッドは立てず、更新の後にその場で組み立てる
+	renderPipeline_.Initialize(renderBackend_.GetStaticTransformCount(), std::thread::hardware_concurrency() > 1);
+
+	///===========================================
+	/// ゴースト
+	/// ===========================================
+
+	playFrame_ = 0;
+	ghostRecording_.Begin();
+	ghostRace_.Initialize(ghostBoard_.GetEntries());
+
+	///===========================================
+	/// 状態の記録
+	/// ===========================================
+
+	// 読み込み直後の状態を残しておき、リトライではこれに戻す
+	SaveSnapshot(startSnapshot_);
 }
 
 /// <summary>
@@ -336,55 +442,244 @@ void GameScene::Initialize() {
 void GameScene::GenerateBlocks() {
 
 	// ブロックモデルを生成
-	modelBlock_ = Model::CreateFromOBJ("block", true);
-
-	// 要素数
-	uint32_t numBlockVirtical = mapChipField_->GetNumBlockVirtical();
-	uint32_t numBlockHorizontal = mapChipField_->GetNumBlockHorizontal();
-
-	// 要素数を変更(縦のブロック数)
-	worldTransformBlocks_.resize(numBlockVirtical);
-	for (uint32_t i = 0; i < numBlockVirtical; ++i) {
-		// 1行の要素数を設定(横のブロック数)
-		worldTransformBlocks_[i].resize(numBlockHorizontal);
-	}
-
-	// キューブを生成
-	for (uint32_t i = 0; i < numBlockVirtical; ++i) {
-		for (uint32_t j = 0; j < numBlockHorizontal; ++j) {
-			if (mapChipField_->GetMapChipTypeByIndex(j, i) == MapChipType::kBlock) {
-				WorldTransform* worldTransform = new WorldTransform();
-				worldTransform->Initialize();
-				worldTransformBlocks_[i][j] = worldTransform;
-				worldTransformBlocks_[i][j]->translation_ = mapChipField_->GetMapChipPositionByIndex(j, i);
-			}
+	modelBlock_ = AssetCache::GetInstance()->AcquireModel("block", true);
+
+	// トランスフォームはインスタンスバッファ（Prepare で作成済み）と同じ並びの連続配列にまとめて確保
+	blockTransforms_.Generate(blockBatch_);
+}
+
+/// <summary>
+/// Initialize で AssetCache から取るモデル
+/// </summary>
+/// <returns></returns>
+const std::vector<std::string>& GameScene::GetModelNames() const { return kModelNames; }
+
+/// <summary>
+/// リトライ（読み込み直後の記録に戻す。確保済みのプレイヤー・敵・ブロック・スプライトはそのまま使い回す）
+/// </summary>
+void GameScene::Reset() {
+	// フェーズ・カウントダウン・フェード・プレイヤー・敵・経路・エフェクト・乱数・カメラまで記録から戻る
+	bool isLoaded = LoadSnapshot(startSnapshot_);
+	assert(isLoaded);
+	(void)isLoaded;
+
+	///===========================================
+	/// 記録に含めない見た目
+	/// ===========================================
+
+	if (sprClearBanner_) {
+		sprClearBanner_->SetColor({1, 1, 1, 0});
+	}
+	if (sprVignette_) {
+		sprVignette_->SetColor({1, 1, 1, 0});
+	}
+	if (sprToTitle_) {
+		sprToTitle_->SetColor({1, 1, 1, 0});
+	}
+
+	// 走りの記録は最初から。ゴーストも開始位置へ
+	ghostRecording_.Begin();
+	ghostRace_.Update(playFrame_);
+
+	// リトライ前の記録は描かない
+	renderPipeline_.Reset();
+
+	// チュートリアルと入れ替わりで使うので、軸表示の対象を戻す
+	AxisIndicator::GetInstance()->SetVisible(true);
+	AxisIndicator::GetInstance()->SetTargetCamera(&debugCamera_->GetCamera());
+}
+
+/// <summary>
+/// ゲームの状態を記録に書く
+/// </summary>
+/// <param name="snapshot"></param>
+void GameScene::SaveSnapshot(SimulationSnapshot& snapshot) const {
+	PROFILE_ZONE("GameScene::SaveSnapshot");
+
+	snapshot.Begin();
+
+	///===========================================
+	/// シーン
+	/// ===========================================
+
+	SceneState state = {};
+	state.phase = phase_;
+	state.startPhase = startPhase_;
+	state.clearStep = clearStep_;
+	state.countIndex = countIndex_;
+	state.startCounter = startCounter_;
+	state.startTextTimer = startTextTimer_;
+	state.clearTimer = clearTimer_;
+	state.fireworksTimer = fireworksTimer_;
+	state.nextFirework = nextFirework_;
+	state.bannerScale = bannerScale_;
+	state.bannerAlpha = bannerAlpha_;
+	state.vignetteAlpha = vignetteAlpha_;
+	state.hitEffectCount = static_cast<uint32_t>(hitEffects_.size());
+	state.playFrame = playFrame_;
+	state.isGameStart = isGameStart_;
+	state.isFinished = isFinished_;
+	state.isClear = isClear_;
+	state.isRetryRequested = isRetryRequested_;
+	state.hasDeathParticles = deathParticles_ != nullptr;
+	state.hasFireworks = fireworks_ != nullptr;
+	snapshot.Write(state);
+
+	// 乱数（メインスレッドの、用途ごとの列）
+	for (uint32_t i = 0; i < static_cast<uint32_t>(Random::System::kCount); ++i) {
+		snapshot.Write(Random::GetStream(static_cast<Random::System>(i)).GetState());
+	}
+
+	fade_->SaveState(snapshot);
+
+	///===========================================
+	/// キャラクター
+	/// ===========================================
+
+	player_->SaveState(snapshot);
+	cameraController_->SaveState(snapshot);
+	enemySpawner_.SaveState(snapshot);
+	flowField_.SaveState(snapshot);
+
+	///===========================================
+	/// エフェクト
+	/// ===========================================
+
+	if (deathParticles_) {
+		deathParticles_->SaveState(snapshot);
+	}
+	for (const HitEffect* hitEffect : hitEffects_) {
+		hitEffect->SaveState(snapshot);
+	}
+	if (fireworks_) {
+		fireworks_->SaveState(snapshot);
+	}
+}
+
+/// <summary>
+/// 記録から状態を戻す
+/// </summary>
+/// <param name="snapshot"></param>
+/// <returns>読めたか</returns>
+bool GameScene::LoadSnapshot(const SimulationSnapshot& snapshot) {
+	PROFILE_ZONE("GameScene::LoadSnapshot");
+
+	SimulationSnapshot::Reader reader(snapshot);
+	if (!snapshot.BeginRead(reader)) {
+		return false;
+	}
+
+	///===========================================
+	/// シーン
+	/// ===========================================
+
+	SceneState state;
+	reader.Read(state);
+	phase_ = state.phase;
+	startPhase_ = state.startPhase;
+	clearStep_ = state.clearStep;
+	countIndex_ = state.countIndex;
+	startCounter_ = state.startCounter;
+	startTextTimer_ = state.startTextTimer;
+	clearTimer_ = state.clearTimer;
+	fireworksTimer_ = state.fireworksTimer;
+	nextFirework_ = state.nextFirework;
+	bannerScale_ = state.bannerScale;
+	bannerAlpha_ = state.bannerAlpha;
+	vignetteAlpha_ = state.vignetteAlpha;
+	playFrame_ = state.playFrame;
+	isGameStart_ = state.isGameStart;
+	isFinished_ = state.isFinished;
+	isClear_ = state.isClear;
+	isRetryRequested_ = state.isRetryRequested;
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(Random::System::kCount); ++i) {
+		Random::Stream::State streamState;
+		reader.Read(streamState);
+		Random::GetStream(static_cast<Random::System>(i)).SetState(streamState);
+	}
+
+	fade_->LoadState(reader);
+
+	///===========================================
+	/// キャラクター
+	/// ===========================================
+
+	player_->LoadState(reader);
+	cameraController_->LoadState(reader);
+	enemySpawner_.LoadState(reader);
+	flowField_.LoadState(reader);
+
+	///===========================================
+	/// エフェクト
+	/// ===========================================
+
+	// 死亡時のパーティクル（実体は1つを使い回す）
+	deathParticles_ = nullptr;
+	if (state.hasDeathParticles) {
+		if (!deathParticlesPool_) {
+			ALLOCATION_TAG(AllocationTag::kDeathParticles);
+			deathParticlesPool_ = new DeathParticles;
+			deathParticlesPool_->Initialize(modelDeathParticle_, &camera_, {});
 		}
+		deathParticles_ = deathParticlesPool_;
+		deathParticles_->LoadState(reader);
+	}
+
+	// ヒットエフェクト（使い回しの実体で数だけ合わせる）
+	while (hitEffects_.size() > state.hitEffectCount) {
+		freeHitEffects_.push_back(hitEffects_.back());
+		hitEffects_.pop_back();
+	}
+	while (hitEffects_.size() < state.hitEffectCount) {
+		hitEffects_.push_back(AcquireHitEffect());
+	}
+	for (HitEffect* hitEffect : hitEffects_) {
+		hitEffect->LoadState(reader);
 	}
+
+	// 花火
+	if (state.hasFireworks) {
+		if (!fireworks_) {
+			ALLOCATION_TAG(AllocationTag::kFireworks);
+			fireworks_ = new Fireworks();
+			fireworks_->Initialize(modelFireworksParticle_, &camera_);
+		}
+		fireworks_->LoadState(reader);
+	} else if (fireworks_) {
+		fireworks_->Clear();
+	}
+
+	assert(reader.IsEnd());
+	return true;
 }
 
 /// <summary>
 /// 更新処理
 /// </summary>
 void GameScene::Update() {
+	PROFILE_ZONE("GameScene::Update");
+	// 開始時のフェーズに計上する
+	FrameStatsScope frameStats(kUpdateStatNames[static_cast<size_t>(phase_)]);
+
 	const float dt = 1.0f / 60.0f;
 
-	if (isGameStart_) {
-		// 死亡フラグの立った敵を削除
-		enemies_.remove_if([](Enemy* enemy) {
-			if (enemy->IsDead()) {
-				delete enemy;
-				return true;
-			}
-			return false;
-		});
+	// カメラの近くの敵だけ実体化する（倒された敵もここで外し、実体はリトライで使い回す）
+	enemySpawner_.UpdateActivation(camera_.translation_.x);
+	// プレイヤーのタイルが変わったときだけ経路を作り直す（数フレームに分けて進む）
+	flowField_.Update(player_->GetWorldTransform().translation_);
 
-		hitEffects_.remove_if([](HitEffect* hitEffect) {
+	if (isGameStart_) {
+		// 消えたものは使い回しに戻す（記録と合わせるため、残りの並びは変えない）
+		size_t aliveCount = 0;
+		for (HitEffect* hitEffect : hitEffects_) {
 			if (hitEffect->IsDead()) {
-				delete hitEffect;
-				return true;
+				freeHitEffects_.push_back(hitEffect);
+			} else {
+				hitEffects_[aliveCount++] = hitEffect;
 			}
-			return false;
-		});
+		}
+		hitEffects_.resize(aliveCount);
 	} else if (startPhase_ == StartPhase::kShowStart) {
 		// 「スタート！」表示中
 		startTextTimer_ -= dt;
@@ -421,6 +716,14 @@ void GameScene::Update() {
 
 	// フェーズの更新
 	ChangePhase();
+
+	// 描画の記録を渡す（組み立ては次の更新と並んで描画スレッドで行う）
+	CaptureSnapshot();
+
+	// 操作中は毎フレームの確保が無いはず（AllocationTracker が検査する）
+	if (phase_ == Phase::kPlay && isGameStart_) {
+		AllocationTracker::GetInstance()->MarkSteadyState();
+	}
 }
 
 /// <summary>
@@ -428,11 +731,34 @@ void GameScene::Update() {
 /// </summary>
 /// <param name="spawnPosition"></param>
 void GameScene::CreateHitEffect(const Vector3& spawnPosition) {
-	HitEffect* newHitEffect = HitEffect::Create(spawnPosition);
+	HitEffect* newHitEffect = AcquireHitEffect();
+	newHitEffect->Reset(spawnPosition);
 	hitEffects_.push_back(newHitEffect);
 }
 
+/// <summary>
+/// 使っていないヒットエフェクトを1つ取り出す（足りなければ生成）
+/// </summary>
+/// <returns></returns>
+HitEffect* GameScene::AcquireHitEffect() {
+	if (!freeHitEffects_.empty()) {
+		HitEffect* hitEffect = freeHitEffects_.back();
+		freeHitEffects_.pop_back();
+		return hitEffect;
+	}
+
+	ALLOCATION_TAG(AllocationTag::kHitEffect);
+	HitEffect* hitEffect = new HitEffect();
+	hitEffect->Initialize();
+	// 出すとき・戻すときに確保が起きないよう、両方を全体の数まで広げておく
+	hitEffects_.reserve(hitEffects_.size() + 1);
+	freeHitEffects_.reserve(hitEffects_.size() + 1);
+	return hitEffect;
+}
+
 void GameScene::CheckAllCollisions() {
+	PROFILE_ZONE("GameScene::CheckAllCollisions");
+
 #pragma region プレイヤーと敵の当たり判定
 	{
 		// 判定対象1と2の座標
@@ -443,7 +769,7 @@ void GameScene::CheckAllCollisions() {
 		aabb1 = player_->GetAABB();
 
 		// プレイヤーと敵の弾全ての当たり判定
-		for (Enemy* enemy : enemies_) {
+		for (Enemy* enemy : enemySpawner_.GetActiveEnemies()) {
 			// 敵の弾の座標
 			aabb2 = enemy->GetAABB();
 
@@ -474,6 +800,9 @@ void GameScene::CheckAllCollisions() {
 			phase_ = Phase::kClear;
 			isClear_ = true;
 
+			// 速い順に入れば記録を残す（タイムは止まった playFrame_ を HUD で出す）
+			SaveGhost();
+
 			// クリア演出の初期化
 			clearStep_ = ClearStep::kSlow;
 			clearTimer_ = 0.0f;
@@ -488,6 +817,7 @@ void GameScene::CheckAllCollisions() {
 				sprVignette_->SetColor({1, 1, 1, 0});
 
 			// 花火生成
+			ALLOCATION_TAG(AllocationTag::kFireworks);
 			if (!fireworks_) {
 				fireworks_ = new Fireworks();
 				// 粒モデルは既存の死亡パーティクル用モデルを使い回し可
@@ -513,6 +843,65 @@ void GameScene::CheckAllCollisions() {
 #pragma endregion
 }
 
+/// <summary>
+/// HUD の文字を積み直す
+/// </summary>
+void GameScene::BuildHud() {
+	hudText_.Clear();
+
+	const uint32_t white = TextBatch::kColorWhite;
+
+	// カウントダウン（画面中央に大きく）
+	if (!isGameStart_ && startPhase_ == StartPhase::kCounting && countIndex_ >= 1 && countIndex_ <= 9) {
+		const char text[2] = {static_cast<char>('0' + countIndex_), '\0'};
+		Vector2 position = {countPos_.x, countPos_.y - HudFont::kDigits.lineHeight * kCountScale * 0.5f};
+		hudText_.AddText(HudFont::kDigits, text, position, kCountScale, white, TextBatch::Align::kCenter);
+	}
+
+	if (phase_ == Phase::kClear || phase_ == Phase::kFadeOut) {
+		// クリアタイム（ゴールで止まった playFrame_）
+		if (clearStep_ == ClearStep::kShowTime) {
+			Vector2 position = {clearTimePos_.x, clearTimePos_.y - HudFont::kDigits.lineHeight * kClearTimeScale * 0.5f};
+			hudText_.AddTime(HudFont::kDigits, playFrame_, position, kClearTimeScale, white, TextBatch::Align::kCenter);
+		}
+		return;
+	}
+
+	// 走行タイム
+	hudText_.AddTime(HudFont::kDigits, playFrame_, runTimePos_, kRunTimeScale, white, TextBatch::Align::kCenter);
+
+	// 統計（1位のタイム・ゴールまでの経路のジャンプ回数・走っているゴースト・実体化している敵）
+	char best[TextBatch::kTimeBufferSize] = "--:--.--";
+	if (!ghostBoard_.GetEntries().empty()) {
+		TextBatch::FormatTime(ghostBoard_.GetEntries().front().GetClearFrame(), best);
+	}
+	char route[24] = "--";
+	if (routeJumpCount_ != UINT32_MAX) {
+		std::snprintf(route, sizeof(route), "%u JUMPS", routeJumpCount_);
+	}
+	char stats[160];
+	std::snprintf(stats, sizeof(stats), "BEST    %s\nROUTE   %s\nGHOSTS  %u\nENEMIES %u/%u", best, route, ghostRace_.GetCount(),
+	              static_cast<uint32_t>(enemySpawner_.GetActiveEnemies().size()), enemySpawner_.GetRecordCount());
+	hudText_.AddText(HudFont::kAscii, stats, statsPos_, kStatsScale, TextBatch::PackColor(1.0f, 1.0f, 1.0f, 0.85f));
+}
+
+/// <summary>
+/// ゴールした走りを記録に加える
+/// </summary>
+void GameScene::SaveGhost() {
+	ALLOCATION_TAG(AllocationTag::kGhost);
+
+	ghostRecording_.Finish();
+	if (ghostBoard_.Submit(ghostRecording_) < 0) {
+		return;
+	}
+	ghostBoard_.Save(kGhostBoardPath);
+
+	// 一覧が並び替わったので、今の走りも加えて走らせ直す
+	ghostRace_.Initialize(ghostBoard_.GetEntries());
+	ghostRace_.Update(playFrame_);
+}
+
 /// <summary>
 /// フェーズの切り替え処理
 /// </summary>
@@ -574,17 +963,7 @@ void GameScene::UpdateFadeIn() {
 	/// ===========================================
 
 	// ブロックの更新
-	for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-
-			// nullptrならスキップ
-			if (!worldTransformBlock) {
-				continue;
-			}
-
-			WorldTransformUpdate(*worldTransformBlock);
-		}
-	}
+	blockTransforms_.Update();
 
 	// ゴールの行列更新（見た目を出すために必須）
 	if (hasGoal_) {
@@ -600,12 +979,17 @@ void GameScene::UpdateFadeIn() {
 /// ゲームプレイフェーズの処理
 /// </summary>
 void GameScene::UpdatePlay() {
+	PROFILE_ZONE("GameScene::UpdatePlay");
+
 	///===========================================
 	/// 天球
 	/// ===========================================
 
 	skydome_->Update();
 
+	// 入力は開始前も毎フレーム渡す（開始前から押していたキーで跳ばないよう、押し始めの判定をキーボードと揃える）
+	player_->SetInput(PlayerInput::FromKeyboard());
+
 	if (isGameStart_) {
 		///===========================================
 		/// プレイヤー
@@ -613,6 +997,15 @@ void GameScene::UpdatePlay() {
 
 		player_->Update();
 
+		///===========================================
+		/// ゴースト
+		/// ===========================================
+
+		// 走りを記録し、ゴーストを同じフレームの姿へ
+		ghostRecording_.Record(player_->GetWorldTransform(), player_->IsAttackEffect() ? GhostRecording::kFlagAttackEffect : 0);
+		ghostRace_.Update(playFrame_);
+		++playFrame_;
+
 		if (player_->IsDead()) {
 			// 死亡演出フェーズ(デスフェーズ)に切り替え
 			phase_ = Phase::kDeath;
@@ -620,18 +1013,22 @@ void GameScene::UpdatePlay() {
 			// プレイヤーの座標を取得
 			const Vector3& deathParticlesPosition = player_->GetWorldPosition();
 
-			// デスパーティクルを発生、初期化
-			deathParticles_ = new DeathParticles;
-			deathParticles_->Initialize(modelDeathParticle_, &camera_, deathParticlesPosition);
+			// デスパーティクルを発生、初期化（2回目以降は使い回す）
+			if (!deathParticlesPool_) {
+				ALLOCATION_TAG(AllocationTag::kDeathParticles);
+				deathParticlesPool_ = new DeathParticles;
+				deathParticlesPool_->Initialize(modelDeathParticle_, &camera_, deathParticlesPosition);
+			} else {
+				deathParticlesPool_->Reset(deathParticlesPosition);
+			}
+			deathParticles_ = deathParticlesPool_;
 		}
 
 		///===========================================
 		/// 敵
 		/// ===========================================
 
-		for (Enemy* enemy : enemies_) {
-			enemy->Update();
-		}
+		enemySpawner_.Update();
 
 		///===========================================
 		/// ヒットエフェクト
@@ -686,17 +1083,7 @@ void GameScene::UpdatePlay() {
 	/// ===========================================
 
 	// ブロックの更新
-	for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-
-			// nullptrならスキップ
-			if (!worldTransformBlock) {
-				continue;
-			}
-
-			WorldTransformUpdate(*worldTransformBlock);
-		}
-	}
+	blockTransforms_.Update();
 
 	// ゴールの行列更新（見た目を出すために必須）
 	if (hasGoal_) {
@@ -718,9 +1105,10 @@ void GameScene::UpdatePlay() {
 /// </summary>
 void GameScene::UpdateDeath() {
 	if (deathParticles_ && deathParticles_->IsFinished()) {
-		// フェードアウト開始
+		// フェードアウト開始（終わったらリトライ）
 		fade_->Start(Fade::Status::FadeOut, duration_);
 		phase_ = Phase::kFadeOut;
+		isRetryRequested_ = true;
 	}
 
 	///===========================================
@@ -733,9 +1121,7 @@ void GameScene::UpdateDeath() {
 	/// 敵
 	/// ===========================================
 
-	for (Enemy* enemy : enemies_) {
-		enemy->Update();
-	}
+	enemySpawner_.Update();
 
 	///===========================================
 	/// 死亡時のパーティクル
@@ -750,17 +1136,7 @@ void GameScene::UpdateDeath() {
 	/// ===========================================
 
 	// ブロックの更新
-	for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-
-			// nullptrならスキップ
-			if (!worldTransformBlock) {
-				continue;
-			}
-
-			WorldTransformUpdate(*worldTransformBlock);
-		}
-	}
+	blockTransforms_.Update();
 
 	for (size_t i = 0; i < worldTransformClouds_.size(); ++i) {
 		WorldTransformUpdate(*worldTransformClouds_[i]); // ポインタ参照（auto不使用）
@@ -815,13 +1191,14 @@ void GameScene::UpdateClear() {
 			if (fireworksTimer_ >= nextFirework_) {
 				fireworksTimer_ = 0.0f;
 				// 次の間隔をちょいランダムに（0.20～0.45秒）
-				nextFirework_ = 0.20f + (float)(rand() % 26) / 100.0f; // 簡易乱数
+				Random::Stream& random = Random::GetStream(Random::System::kFireworks);
+				nextFirework_ = random.NextFloat(0.20f, 0.45f);
 
 				// ゴール上空の箱にランダム生成
 				Vector3 c = worldTransformGoal_.translation_;
-				float rx = ((rand() % 100) / 100.0f) * 16.0f - 8.0f; // [-8,8]
-				float ry = ((rand() % 100) / 100.0f) * 6.0f + 6.0f;  // [6,12]
-				float rz = ((rand() % 100) / 100.0f) * 6.0f - 3.0f;  // [-3,3]
+				float rx = random.NextFloat(-8.0f, 8.0f);
+				float ry = random.NextFloat(6.0f, 12.0f);
+				float rz = random.NextFloat(-3.0f, 3.0f);
 
 				fireworks_->Burst(c + Vector3{rx, ry, rz}, 80, 3.0f, 7.0f);
 			}
@@ -854,7 +1231,9 @@ void GameScene::UpdateClear() {
 		bannerAlpha_ = t;
 
 		if (sprClearBanner_) {
-			sprClearBanner_->SetSize({bannerScale_, bannerScale_});
+			// 元画像の大きさに対する倍率
+			Vector2 size = uiAtlas_.GetSourceSize("text/clear.png");
+			uiAtlas_.SetSpriteSize(sprClearBanner_, "text/clear.png", {size.x * bannerScale_, size.y * bannerScale_});
 			sprClearBanner_->SetColor({1, 1, 1, bannerAlpha_});
 		}
 
@@ -904,9 +1283,7 @@ void GameScene::UpdateFadeOut() {
 	/// 敵
 	/// ===========================================
 
-	for (Enemy* enemy : enemies_) {
-		enemy->Update();
-	}
+	enemySpawner_.Update();
 
 	///===========================================
 	/// 死亡時のパーティクル
@@ -921,17 +1298,7 @@ void GameScene::UpdateFadeOut() {
 	/// ===========================================
 
 	// ブロックの更新
-	for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-
-			// nullptrならスキップ
-			if (!worldTransformBlock) {
-				continue;
-			}
-
-			WorldTransformUpdate(*worldTransformBlock);
-		}
-	}
+	blockTransforms_.Update();
 
 	///===========================================
 	/// カメラ
@@ -975,40 +1342,16 @@ void GameScene::UpdateFadeOut() {
 /// 描画処理
 /// </summary>
 void GameScene::Draw() {
+	PROFILE_ZONE("GameScene::Draw");
+	FrameStatsScope frameStats(kDrawStatNames[static_cast<size_t>(phase_)]);
 
 	// モデルの描画前処理
 	Model::PreDraw();
 
-	// 敵の描画
-	for (Enemy* enemy : enemies_) {
-		enemy->Draw();
-	}
+	// 天球・ブロック・ゴール・雲・敵・プレイヤー・花火（描画スレッドで組み立て済みのコマンド）
+	renderPipeline_.Execute(renderBackend_);
 
-	// ブロックの描画
-	for (std::vector<WorldTransform*>& worldTransformBlockLine : worldTransformBlocks_) {
-		for (WorldTransform* worldTransformBlock : worldTransformBlockLine) {
-
-			// nullptrならスキップ
-			if (!worldTransformBlock) {
-				continue;
-			}
-
-			modelBlock_->Draw(*worldTransformBlock, camera_);
-		}
-	}
-
-	if (hasGoal_) {
-		modelGoal_->Draw(worldTransformGoal_, camera_);
-	}
-
-	skydome_->Draw();
-
-	for (size_t i = 0; i < worldTransformClouds_.size(); ++i) {
-		modelCloud_->Draw(*worldTransformClouds_[i], camera_);
-	}
-
-	// プレイヤーの描画
-	player_->Draw();
+	// 以下は記録を取らずにその場で描く（透明度や色を共有のバッファで毎フレーム書き換えるので写せない。組み立て済みのものより1フレーム新しい）
 
 	// 死亡時のパーティクルの描画
 	if (deathParticles_) {
@@ -1020,11 +1363,6 @@ void GameScene::Draw() {
 		hitEffect->Draw();
 	}
 
-	// 花火
-	if ((phase_ == Phase::kClear || phase_ == Phase::kFadeOut) && fireworks_) {
-		fireworks_->Draw();
-	}
-
 	// モデルの描画後処理
 	Model::PostDraw();
 
@@ -1043,15 +1381,9 @@ void GameScene::Draw() {
 		sprHintAttack_->Draw();
 	}
 
-	if (!isGameStart_) {
-		if (startPhase_ == StartPhase::kCounting) {
-			if (sprCount_[countIndex_]) {
-				sprCount_[countIndex_]->Draw();
-			}
-		} else if (startPhase_ == StartPhase::kShowStart) {
-			if (sprStart_) {
-				sprStart_->Draw();
-			}
+	if (!isGameStart_ && startPhase_ == StartPhase::kShowStart) {
+		if (sprStart_) {
+			sprStart_->Draw();
 		}
 	}
 
@@ -1062,6 +1394,10 @@ void GameScene::Draw() {
 			sprClearBanner_->Draw();
 	}
 
+	// カウントダウン・タイム・統計（アトラス1枚の文字をまとめて）
+	BuildHud();
+	hudTextRenderer_.Draw(hudText_);
+
 	if (sprToTitle_) {
 		sprToTitle_->Draw();
 	}
@@ -1072,6 +1408,55 @@ void GameScene::Draw() {
 	fade_->Draw();
 }
 
+/// <summary>
+/// 描画の記録を取って描画スレッドに渡す
+/// </summary>
+void GameScene::CaptureSnapshot() {
+	PROFILE_ZONE("GameScene::CaptureSnapshot");
+
+	FrameSnapshot& snapshot = renderPipeline_.BeginSnapshot();
+
+	snapshot.cameraTranslation = camera_.translation_;
+	snapshot.matView = camera_.matView;
+	snapshot.matProjection = camera_.matProjection;
+
+	// 天球
+	skydome_->Capture(snapshot, renderModelSkydome_);
+
+	// ブロック（カメラに写る列の範囲を1バッチで。行列は静的テーブルのものをそのまま使う）
+	TileBatch::Range blockRange = {0, blockBatch_.GetInstanceCount()};
+	if (!isDebugCameraActive_) {
+		blockRange = blockBatch_.GetVisibleRange(camera_);
+	}
+	snapshot.AddStatic(renderModelBlock_, 0, blockTransformBase_ + blockRange.first, blockRange.count);
+
+	// ゴール
+	if (hasGoal_) {
+		snapshot.Add(renderModelGoal_, worldTransformGoal_);
+	}
+
+	// 雲
+	for (const WorldTransform* worldTransformCloud : worldTransformClouds_) {
+		snapshot.Add(renderModelCloud_, *worldTransformCloud);
+	}
+
+	// 敵
+	enemySpawner_.Capture(snapshot, renderModelEnemy_);
+
+	// プレイヤー
+	player_->Capture(snapshot, renderModelPlayer_, renderModelAttack_);
+
+	// ゴースト
+	ghostRace_.Capture(snapshot, renderModelPlayer_, renderModelAttack_, renderMaterialGhost_);
+
+	// 花火
+	if ((phase_ == Phase::kClear || phase_ == Phase::kFadeOut) && fireworks_) {
+		fireworks_->Capture(snapshot, renderModelFireworks_);
+	}
+
+	renderPipeline_.Publish();
+}
+
 float GameScene::Lerp(float a, float b, float t) { return a + (b - a) * t; }
 float GameScene::Smooth(float t) {
 	t = std::clamp(t, 0.0f, 1.0f);
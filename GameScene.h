@@ -1,20 +1,34 @@
 #pragma once
 #include "AffineMatrix.h"
+#include "BaseScene.h"
+#include "BlockTransforms.h"
 #include "CameraController.h"
 #include "DeathParticles.h"
 #include "Enemy.h"
+#include "EnemySpawner.h"
 #include "Fade.h"
+#include "FlowField.h"
+#include "GhostRace.h"
+#include "GhostRecording.h"
 #include "HitEffect.h"
 #include "KamataEngine.h"
 #include "MapChipField.h"
+#include "ModelRenderBackend.h"
+#include "NavGraph.h"
 #include "Player.h"
+#include "RenderPipeline.h"
+#include "SimulationSnapshot.h"
 #include "Skydome.h"
+#include "SpriteAtlas.h"
+#include "TextBatch.h"
+#include "TextRenderer.h"
+#include "TileBatch.h"
 
 #include <vector>
 
 class Fireworks;
 
-class GameScene {
+class GameScene : public BaseScene {
 public:
 	// ゲームのフェーズ
 	enum class Phase {
@@ -36,20 +50,22 @@ private:
 	// スタートフラグ
 	bool isGameStart_ = false;
 
+	// Prepare が済んだか
+	bool isPrepared_ = false;
+
 	// 終了フラグ
 	bool isFinished_ = false;
 	bool isClear_ = false;
+	// 終了後にやり直すか（死亡時）
+	bool isRetryRequested_ = false;
 
 	float startCounter_ = 3.0f;
 	static inline const float kStartWaitTime = 0.0f;
 
 	// === カウントダウン/スタート表示 ===
-	uint32_t texCount_[5] = {}; // 0〜4（0は別用途で保持）
-	KamataEngine::Sprite* sprCount_[5] = {nullptr};
-	int countIndex_ = 3; // 3→2→1
+	int countIndex_ = 3; // 3→2→1（数字は HUD の文字で描く）
 
-	uint32_t texStart_ = 0; // 「スタート！」画像
-	KamataEngine::Sprite* sprStart_ = nullptr;
+	KamataEngine::Sprite* sprStart_ = nullptr; // 「スタート！」画像
 
 	enum class StartPhase { kCounting, kShowStart, kPlaying };
 	StartPhase startPhase_ = StartPhase::kCounting;
@@ -75,7 +91,6 @@ private:
 	float nextFirework_ = 0.25f;
 
 	// バナー & ビネット
-	uint32_t texClearBanner_ = 0;
 	KamataEngine::Sprite* sprClearBanner_ = nullptr;
 
 	uint32_t texVignette_ = 0; // 中央透過・周辺暗いPNGを想定（無ければ黒1x1でもOK）
@@ -91,11 +106,34 @@ private:
 	static float Smooth(float t);      // 0→1へスムーズ
 	static float EaseOutBack(float t); // ボヨンと出る
 
-	uint32_t texToTitle_ = 0;
 	KamataEngine::Sprite* sprToTitle_ = nullptr;
 
+	// クリアタイム（"mm:ss.cc" を HUD の文字で描く）
+	static inline const float kClearTimeScale = 0.4f;       // 数字の倍率
+	KamataEngine::Vector2 clearTimePos_ = {640.0f, 400.0f}; // 中央
+
 	KamataEngine::Model* modelFireworksParticle_ = nullptr;
 
+	///===========================================
+	/// HUD の文字（カウントダウン・走行タイム・統計を1本の頂点列にまとめる）
+	/// ===========================================
+
+	// 1フレームに積む最大の文字数（TextRenderer のスプライトの数。描画中は増やさない）
+	static inline const uint32_t kHudQuadCount = 128;
+	// カウントダウンの数字の倍率
+	static inline const float kCountScale = 1.0f;
+	// 走行タイム（画面上中央）
+	static inline const float kRunTimeScale = 0.3f;
+	KamataEngine::Vector2 runTimePos_ = {640.0f, 16.0f};
+	// 統計（画面左上）
+	static inline const float kStatsScale = 2.0f;
+	KamataEngine::Vector2 statsPos_ = {16.0f, 16.0f};
+	TextBatch hudText_;
+	TextRenderer hudTextRenderer_;
+
+	// 文字の画像（スタート・クリア・ヒントなど。1枚のアトラスから）
+	SpriteAtlas uiAtlas_;
+
 	///===========================================
 	/// フェード
 	/// ===========================================
@@ -117,14 +155,32 @@ private:
 	// 攻撃時のエフェクト
 	KamataEngine::Model* modelAttack_ = nullptr;
 
+	///===========================================
+	/// ゴースト
+	/// ===========================================
+
+	// 速い順の記録の保存先
+	static inline const char* const kGhostBoardPath = "ghosts.bin";
+	// 今回の走りの記録
+	GhostRecording ghostRecording_;
+	// これまでの速い記録（全てゴーストとして一緒に走らせる）
+	GhostBoard ghostBoard_;
+	GhostRace ghostRace_;
+	// 開始してからのフレーム数（ゴーストの再生位置）
+	uint32_t playFrame_ = 0;
+	// ゴーストの見た目（半透明）
+	KamataEngine::ObjectColor ghostColor_;
+	uint32_t renderMaterialGhost_ = 0;
+
 	///===========================================
 	/// 死亡時のパーティクル
 	/// ===========================================
 
 	// モデルデータ
 	KamataEngine::Model* modelDeathParticle_ = nullptr;
-	// パーティクル
+	// パーティクル（演出中のみ。実体は deathParticlesPool_ を使い回す）
 	DeathParticles* deathParticles_ = nullptr;
+	DeathParticles* deathParticlesPool_ = nullptr;
 
 	///===========================================
 	/// 敵
@@ -132,8 +188,13 @@ private:
 
 	// モデルデータ
 	KamataEngine::Model* modelEnemy_ = nullptr;
-	// 敵
-	std::list<Enemy*> enemies_;
+	// 敵（マップの出現位置から出し、カメラの近くだけ実体化する）
+	EnemySpawner enemySpawner_;
+	// 敵がプレイヤーを追うための経路（プレイヤーのいるタイルが変わったら数フレームかけて作り直す）
+	FlowField flowField_;
+	// 足場の移動グラフ（.nav キャッシュから読む）と、開始位置からゴールまでの経路のジャンプ回数（経路が無ければ UINT32_MAX）
+	NavGraph navGraph_;
+	uint32_t routeJumpCount_ = UINT32_MAX;
 
 	///===========================================
 	/// ヒットエフェクト
@@ -141,8 +202,11 @@ private:
 
 	// 攻撃ヒット時のエフェクト
 	KamataEngine::Model* modelHitEffect_ = nullptr;
-	// ヒットエフェクト
-	std::list<HitEffect*> hitEffects_;
+	// ヒットエフェクト（出ている順。消えたものは freeHitEffects_ に戻して使い回す）
+	std::vector<HitEffect*> hitEffects_;
+	std::vector<HitEffect*> freeHitEffects_;
+	// 先に作っておくヒットエフェクトの数（同時に出る程度）
+	static inline const uint32_t kHitEffectPoolSize = 8;
 
 	///===========================================
 	/// ブロック
@@ -150,8 +214,12 @@ private:
 
 	// モデルデータ
 	KamataEngine::Model* modelBlock_ = nullptr;
-	// ブロック用のWorldTransform(二次配列)
-	std::vector<std::vector<KamataEngine::WorldTransform*>> worldTransformBlocks_;
+	// ブロック用のWorldTransform（連続配列＋タイル番号→スロットの表）
+	BlockTransforms blockTransforms_;
+	// ブロックのインスタンスバッファ（1バッチで描く）
+	TileBatch blockBatch_;
+	// 描画バックエンドの静的テーブル上のブロックの先頭
+	uint32_t blockTransformBase_ = 0;
 
 	///===========================================
 	/// 天球
@@ -166,6 +234,8 @@ private:
 	/// マップチップフィールド
 	/// ===========================================
 
+	// マップの CSV（移動グラフのキャッシュはこの横に置く）
+	static inline const char* const kMapPath = "Resources/blocks.csv";
 	MapChipField* mapChipField_ = nullptr;
 
 	///===========================================
@@ -176,6 +246,25 @@ private:
 	KamataEngine::Model* modelCloud_ = nullptr;
 	std::vector<KamataEngine::WorldTransform*> worldTransformClouds_;
 
+	///===========================================
+	/// 描画キュー
+	/// ===========================================
+
+	// 更新の最後に描画の記録を取り、描画スレッドがコマンドを組み立てる（描画は更新より1フレーム遅れる）
+	RenderPipeline renderPipeline_;
+	// 組み立てたコマンドを実際に描くバックエンド
+	ModelRenderBackend renderBackend_;
+
+	// バックエンドに登録したモデルID
+	uint32_t renderModelSkydome_ = 0;
+	uint32_t renderModelBlock_ = 0;
+	uint32_t renderModelGoal_ = 0;
+	uint32_t renderModelCloud_ = 0;
+	uint32_t renderModelEnemy_ = 0;
+	uint32_t renderModelPlayer_ = 0;
+	uint32_t renderModelAttack_ = 0;
+	uint32_t renderModelFireworks_ = 0;
+
 	///===========================================
 	/// カメラ
 	/// ===========================================
@@ -187,10 +276,39 @@ private:
 
 	CameraController* cameraController_ = nullptr;
 
+	///===========================================
+	/// 状態の記録
+	/// ===========================================
+
+	// 記録に書くシーン自身の状態（フェーズとタイマー）
+	struct SceneState {
+		Phase phase;
+		StartPhase startPhase;
+		ClearStep clearStep;
+		int countIndex;
+		float startCounter;
+		float startTextTimer;
+		float clearTimer;
+		float fireworksTimer;
+		float nextFirework;
+		float bannerScale;
+		float bannerAlpha;
+		float vignetteAlpha;
+		uint32_t hitEffectCount;
+		uint32_t playFrame;
+		bool isGameStart;
+		bool isFinished;
+		bool isClear;
+		bool isRetryRequested;
+		bool hasDeathParticles;
+		bool hasFireworks;
+		bool padding[2]; // 詰め物を明示（記録のバイト列を毎回同じにする）
+	};
+
+	// 読み込み直後の記録（リトライはここへ戻す）
+	SimulationSnapshot startSnapshot_;
+
 	// === 下部チュートリアルヒント ===
-	uint32_t texHintMove_ = 0;
-	uint32_t texHintJump_ = 0;
-	uint32_t texHintAttack_ = 0;
 	KamataEngine::Sprite* sprHintMove_ = nullptr;
 	KamataEngine::Sprite* sprHintJump_ = nullptr;
 	KamataEngine::Sprite* sprHintAttack_ = nullptr;
@@ -203,25 +321,55 @@ public:
 	/// <summary>
 	/// デストラクタ
 	/// </summary>
-	~GameScene();
+	~GameScene() override;
 	/// <summary>
 	/// ブロックの初期化
 	/// </summary>
 	void GenerateBlocks();
+
 	/// <summary>
-	/// 初期化処理
+	/// ゲームの状態（フェーズ・タイマー・プレイヤー・敵・経路・エフェクト・乱数）を記録に書く
 	/// </summary>
-	void Initialize();
+	/// <param name="snapshot"></param>
+	void SaveSnapshot(SimulationSnapshot& snapshot) const;
+	/// <summary>
+	/// 記録から状態を戻す（同じマップで Initialize 済みのシーンに対して使う）
+	/// </summary>
+	/// <param name="snapshot"></param>
+	/// <returns>読めたか</returns>
+	bool LoadSnapshot(const SimulationSnapshot& snapshot);
+	/// <summary>
+	/// 準備処理（ワーカースレッドで呼べる。GPUリソースには触れない）
+	/// </summary>
+	void Prepare() override;
+	/// <summary>
+	/// 初期化処理（メインスレッド。Prepare が済んでいなければここで行う）
+	/// </summary>
+	void Initialize() override;
+	/// <summary>
+	/// リトライ（確保済みのプレイヤー・敵・ブロック・スプライトを使い回して開始時の状態に戻す）
+	/// </summary>
+	void Reset() override;
+	/// <summary>
+	/// Initialize で AssetCache から取るモデル
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<std::string>& GetModelNames() const override;
 	/// <summary>
 	/// 更新処理
 	/// </summary>
-	void Update();
+	void Update() override;
 
 	/// <summary>
 	/// エフェクト生成
 	/// </summary>
 	/// <param name="spawnPosition"></param>
 	void CreateHitEffect(const KamataEngine::Vector3& spawnPosition);
+	/// <summary>
+	/// 使っていないヒットエフェクトを1つ取り出す（足りなければ生成）
+	/// </summary>
+	/// <returns></returns>
+	HitEffect* AcquireHitEffect();
 
 	/// <summary>
 	/// 全ての当たり判定を行う
@@ -246,6 +394,20 @@ public:
 	/// </summary>
 	void UpdateFadeOut();
 
+	/// <summary>
+	/// 描画の記録を取って描画スレッドに渡す（更新の最後に呼ぶ）
+	/// </summary>
+	void CaptureSnapshot();
+
+	/// <summary>
+	/// HUD の文字を積み直す（カウントダウン・走行タイム・統計・クリアタイム）
+	/// </summary>
+	void BuildHud();
+	/// <summary>
+	/// ゴールした走りを記録に加える（速い順に入れば保存して、ゴーストにも加える）
+	/// </summary>
+	void SaveGhost();
+
 	/// <summary>
 	/// フェーズの切り替え処理
 	/// </summary>
@@ -254,11 +416,12 @@ public:
 	/// <summary>
 	/// 描画処理
 	/// </summary>
-	void Draw();
+	void Draw() override;
 
 	/// <summary>
 	/// ゲッター
 	/// </summary>
 	/// <returns></returns>
-	bool IsFinished() const;
+	bool IsFinished() const override;
+	bool IsRetryRequested() const override { return isRetryRequested_; }
 };
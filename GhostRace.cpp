@@ -0,0 +1,125 @@
+#include "GhostRace.h"
+#include "RenderPipeline.h"
+
+#include <cmath>
+
+using namespace KamataEngine;
+
+/// <summary>
+/// 走らせる記録を決めて最初に戻す
+/// </summary>
+void GhostRace::Initialize(const std::vector<GhostRecording>& recordings) {
+	Clear();
+
+	ghosts_.resize(recordings.size());
+	for (size_t i = 0; i < recordings.size(); ++i) {
+		ghosts_[i].recording = &recordings[i];
+		Rewind(ghosts_[i]);
+	}
+	matrices_.resize(ghosts_.size());
+	flags_.resize(ghosts_.size());
+
+	Update(0);
+}
+
+/// <summary>
+/// 解放
+/// </summary>
+void GhostRace::Clear() {
+	ghosts_.clear();
+	matrices_.clear();
+	flags_.clear();
+}
+
+/// <summary>
+/// frame フレーム目の姿にする
+/// </summary>
+void GhostRace::Update(uint32_t frame) {
+	const uint32_t sampleIndex = frame / GhostRecording::kSampleInterval;
+	const float t = static_cast<float>(frame % GhostRecording::kSampleInterval) / static_cast<float>(GhostRecording::kSampleInterval);
+
+	for (size_t i = 0; i < ghosts_.size(); ++i) {
+		Ghost& ghost = ghosts_[i];
+
+		// 巻き戻されたら先頭から
+		if (sampleIndex < ghost.fromIndex) {
+			Rewind(ghost);
+		}
+
+		// 区間を進める（ゴール後は最後のサンプルで止まる）
+		while (ghost.fromIndex < sampleIndex) {
+			ghost.from = ghost.to;
+			if (ghost.reader.IsEnd()) {
+				ghost.fromIndex = sampleIndex;
+				break;
+			}
+			++ghost.fromIndex;
+			if (!ghost.reader.Next(ghost.to)) {
+				ghost.to = ghost.from;
+			}
+		}
+
+		// 位置は前後のサンプルの線形補間
+		float fromX = GhostRecording::ToPosition(ghost.from.x);
+		float fromY = GhostRecording::ToPosition(ghost.from.y);
+		float x = fromX + (GhostRecording::ToPosition(ghost.to.x) - fromX) * t;
+		float y = fromY + (GhostRecording::ToPosition(ghost.to.y) - fromY) * t;
+
+		// 向きは旋回中だけ補間して計算する
+		float cosY = ghost.cosY;
+		float sinY = ghost.sinY;
+		if (ghost.from.rotationY != ghost.to.rotationY) {
+			float fromRotationY = GhostRecording::ToRotation(ghost.from.rotationY);
+			float rotationY = fromRotationY + (GhostRecording::ToRotation(ghost.to.rotationY) - fromRotationY) * t;
+			cosY = std::cos(rotationY);
+			sinY = std::sin(rotationY);
+		} else if (ghost.cachedRotationY != ghost.from.rotationY) {
+			float rotationY = GhostRecording::ToRotation(ghost.from.rotationY);
+			ghost.cachedRotationY = ghost.from.rotationY;
+			ghost.cosY = std::cos(rotationY);
+			ghost.sinY = std::sin(rotationY);
+			cosY = ghost.cosY;
+			sinY = ghost.sinY;
+		}
+
+		// Y軸回転 → 平行移動（拡縮は無し）
+		Matrix4x4& matWorld = matrices_[i];
+		matWorld = {
+		    cosY, 0.0f, -sinY, 0.0f, //
+		    0.0f, 1.0f, 0.0f,  0.0f, //
+		    sinY, 0.0f, cosY,  0.0f, //
+		    x,    y,    ghost.recording->GetZ(), 1.0f,
+		};
+		flags_[i] = ghost.from.flags;
+	}
+}
+
+/// <summary>
+/// 描画の記録に写す
+/// </summary>
+void GhostRace::Capture(FrameSnapshot& snapshot, uint32_t modelId, uint32_t attackModelId, uint32_t materialId) const {
+	for (size_t i = 0; i < matrices_.size(); ++i) {
+		snapshot.Add(modelId, matrices_[i], materialId);
+		if (flags_[i] & GhostRecording::kFlagAttackEffect) {
+			snapshot.Add(attackModelId, matrices_[i], materialId);
+		}
+	}
+}
+
+/// <summary>
+/// 先頭から読み直す
+/// </summary>
+void GhostRace::Rewind(Ghost& ghost) {
+	ghost.reader.Begin(*ghost.recording);
+	ghost.from = {};
+	ghost.reader.Next(ghost.from);
+	if (!ghost.reader.Next(ghost.to)) {
+		ghost.to = ghost.from;
+	}
+	ghost.fromIndex = 0;
+
+	ghost.cachedRotationY = ghost.from.rotationY;
+	float rotationY = GhostRecording::ToRotation(ghost.from.rotationY);
+	ghost.cosY = std::cos(rotationY);
+	ghost.sinY = std::sin(rotationY);
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include "GhostRecording.h"
+#include "KamataEngine.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct FrameSnapshot;
+
+/// <summary>
+/// 記録したゴーストを何百体も同時に走らせる
+/// （記録を先頭から順に読み、前後のサンプルを補間して行列を作るだけ。当たり判定・物理・WorldTransform は持たない）
+/// </summary>
+class GhostRace {
+private:
+	// 1体分（読み出しの位置と、補間する前後のサンプル）
+	struct Ghost {
+		const GhostRecording* recording;
+		GhostRecording::Reader reader;
+		GhostRecording::Sample from;
+		GhostRecording::Sample to;
+		// from のサンプル番号
+		uint32_t fromIndex;
+		// 最後に計算した向きと、その cos / sin（向きが変わらない間は計算し直さない）
+		int32_t cachedRotationY;
+		float cosY;
+		float sinY;
+	};
+
+	std::vector<Ghost> ghosts_;
+	// 今のフレームの行列とフラグ（ghosts_ と同じ並び）
+	std::vector<KamataEngine::Matrix4x4> matrices_;
+	std::vector<uint8_t> flags_;
+
+public:
+	/// <summary>
+	/// 走らせる記録を決めて最初に戻す（記録は GhostRace より長く残しておくこと）
+	/// </summary>
+	/// <param name="recordings"></param>
+	void Initialize(const std::vector<GhostRecording>& recordings);
+
+	/// <summary>
+	/// 解放
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// frame フレーム目（記録を始めてから Record を呼んだ回数）の姿にする。戻るときは先頭から読み直す
+	/// </summary>
+	/// <param name="frame"></param>
+	void Update(uint32_t frame);
+
+	/// <summary>
+	/// 描画の記録に写す
+	/// </summary>
+	/// <param name="snapshot"></param>
+	/// <param name="modelId"></param>
+	/// <param name="attackModelId"></param>
+	/// <param name="materialId">半透明などの見た目</param>
+	void Capture(FrameSnapshot& snapshot, uint32_t modelId, uint32_t attackModelId, uint32_t materialId) const;
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetCount() const { return static_cast<uint32_t>(ghosts_.size()); }
+	const std::vector<KamataEngine::Matrix4x4>& GetMatrices() const { return matrices_; }
+	// 再生のために持っているバイト数（記録そのものは含まない）
+	size_t GetPlaybackBytes() const { return ghosts_.capacity() * sizeof(Ghost) + matrices_.capacity() * sizeof(KamataEngine::Matrix4x4) + flags_.capacity(); }
+
+private:
+	/// <summary>
+	/// 先頭から読み直す
+	/// </summary>
+	/// <param name="ghost"></param>
+	static void Rewind(Ghost& ghost);
+};
@@ -0,0 +1,317 @@
+#define NOMINMAX
+#include "GhostRecording.h"
+#include "FileUtility.h"
+#include "MapChipField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numbers>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 可変長整数の最大バイト数（64bit）
+const uint32_t kMaxVarintBytes = 10;
+
+/// <summary>
+/// 符号付きを、絶対値の小さいものほど小さい符号なしにする（0,-1,1,-2,... → 0,1,2,3,...）
+/// </summary>
+uint64_t ZigZag(int64_t value) { return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63); }
+int64_t UnZigZag(uint64_t value) { return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1); }
+
+/// <summary>
+/// 7bit ずつ下位から書く（続きがあれば最上位bitを立てる）
+/// </summary>
+void WriteVarint(std::vector<uint8_t>& bytes, uint64_t value) {
+	while (value >= 0x80) {
+		bytes.push_back(static_cast<uint8_t>(value | 0x80));
+		value >>= 7;
+	}
+	bytes.push_back(static_cast<uint8_t>(value));
+}
+
+/// <summary>
+/// 読む（途中で終わる・長すぎるものは失敗）
+/// </summary>
+bool ReadVarint(const std::vector<uint8_t>& bytes, size_t& offset, uint64_t& value) {
+	value = 0;
+	for (uint32_t i = 0; i < kMaxVarintBytes; ++i) {
+		if (offset >= bytes.size()) {
+			return false;
+		}
+		uint8_t byte = bytes[offset++];
+		value |= static_cast<uint64_t>(byte & 0x7F) << (7 * i);
+		if ((byte & 0x80) == 0) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/// <summary>
+/// 向きを量子化する（0〜kRotationSteps に折り返さない。回り続けても予測との差が小さいまま）
+/// </summary>
+int32_t QuantizeRotation(float radian) { return static_cast<int32_t>(std::lround(radian * static_cast<float>(GhostRecording::kRotationSteps) / (2.0f * std::numbers::pi_v<float>))); }
+
+} // namespace
+
+///====================================================
+/// 読み出し
+///====================================================
+
+/// <summary>
+/// 読み始める
+/// </summary>
+void GhostRecording::Reader::Begin(const GhostRecording& recording) {
+	recording_ = &recording;
+	offset_ = 0;
+	index_ = 0;
+	last_ = {};
+	delta_ = {};
+}
+
+/// <summary>
+/// 次のサンプルを読む
+/// </summary>
+bool GhostRecording::Reader::Next(Sample& sample) {
+	if (IsEnd()) {
+		return false;
+	}
+
+	const std::vector<uint8_t>& bytes = recording_->bytes_;
+	uint64_t x = 0;
+	uint64_t y = 0;
+	uint64_t rotationY = 0;
+	if (!ReadVarint(bytes, offset_, x) || !ReadVarint(bytes, offset_, y) || !ReadVarint(bytes, offset_, rotationY)) {
+		return false;
+	}
+
+	// x の最下位bitはフラグが変わったか
+	uint8_t flags = last_.flags;
+	if (x & 1) {
+		if (offset_ >= bytes.size()) {
+			return false;
+		}
+		flags = bytes[offset_++];
+	}
+
+	sample.x = static_cast<int32_t>(static_cast<int64_t>(last_.x) + delta_.x + UnZigZag(x >> 1));
+	sample.y = static_cast<int32_t>(static_cast<int64_t>(last_.y) + delta_.y + UnZigZag(y));
+	sample.rotationY = static_cast<int32_t>(static_cast<int64_t>(last_.rotationY) + delta_.rotationY + UnZigZag(rotationY));
+	sample.flags = flags;
+
+	delta_.x = static_cast<int32_t>(static_cast<int64_t>(sample.x) - last_.x);
+	delta_.y = static_cast<int32_t>(static_cast<int64_t>(sample.y) - last_.y);
+	delta_.rotationY = static_cast<int32_t>(static_cast<int64_t>(sample.rotationY) - last_.rotationY);
+	last_ = sample;
+	++index_;
+	return true;
+}
+
+///====================================================
+/// 記録
+///====================================================
+
+/// <summary>
+/// 記録を始める
+/// </summary>
+void GhostRecording::Begin() {
+	bytes_.clear();
+	bytes_.reserve(kReserveBytes);
+	sampleCount_ = 0;
+	clearFrame_ = 0;
+	z_ = 0.0f;
+	frame_ = 0;
+	last_ = {};
+	delta_ = {};
+}
+
+/// <summary>
+/// 1フレーム分を渡す
+/// </summary>
+void GhostRecording::Record(const WorldTransform& worldTransform, uint8_t flags) {
+	if (frame_++ % kSampleInterval != 0) {
+		return;
+	}
+
+	if (sampleCount_ == 0) {
+		z_ = worldTransform.translation_.z;
+	}
+
+	Sample sample;
+	sample.x = static_cast<int32_t>(std::lround(worldTransform.translation_.x * kPositionScale));
+	sample.y = static_cast<int32_t>(std::lround(worldTransform.translation_.y * kPositionScale));
+	sample.rotationY = QuantizeRotation(worldTransform.rotation_.y);
+	sample.flags = flags;
+	Encode(sample);
+}
+
+/// <summary>
+/// 1サンプルを詰める（直前の2サンプルからの予測との差。フラグは変わったときだけ1バイト足す）
+/// </summary>
+void GhostRecording::Encode(const Sample& sample) {
+	bool isFlagsChanged = sample.flags != last_.flags;
+
+	int64_t errorX = static_cast<int64_t>(sample.x) - (static_cast<int64_t>(last_.x) + delta_.x);
+	int64_t errorY = static_cast<int64_t>(sample.y) - (static_cast<int64_t>(last_.y) + delta_.y);
+	int64_t errorRotationY = static_cast<int64_t>(sample.rotationY) - (static_cast<int64_t>(last_.rotationY) + delta_.rotationY);
+
+	WriteVarint(bytes_, (ZigZag(errorX) << 1) | (isFlagsChanged ? 1 : 0));
+	WriteVarint(bytes_, ZigZag(errorY));
+	WriteVarint(bytes_, ZigZag(errorRotationY));
+	if (isFlagsChanged) {
+		bytes_.push_back(sample.flags);
+	}
+
+	delta_.x = static_cast<int32_t>(static_cast<int64_t>(sample.x) - last_.x);
+	delta_.y = static_cast<int32_t>(static_cast<int64_t>(sample.y) - last_.y);
+	delta_.rotationY = static_cast<int32_t>(static_cast<int64_t>(sample.rotationY) - last_.rotationY);
+	last_ = sample;
+	++sampleCount_;
+}
+
+/// <summary>
+/// 全て読んで、数と長さが合っているか確かめる
+/// </summary>
+bool GhostRecording::Validate() const {
+	if (sampleCount_ == 0) {
+		return false;
+	}
+
+	Reader reader;
+	reader.Begin(*this);
+	Sample sample;
+	while (!reader.IsEnd()) {
+		if (!reader.Next(sample)) {
+			return false;
+		}
+	}
+	return reader.GetOffset() == bytes_.size();
+}
+
+/// <summary>
+/// 量子化した向きを戻す
+/// </summary>
+float GhostRecording::ToRotation(int32_t value) { return static_cast<float>(value) * (2.0f * std::numbers::pi_v<float>) / static_cast<float>(kRotationSteps); }
+
+///====================================================
+/// 記録の一覧
+///====================================================
+
+/// <summary>
+/// マップの中身から記録の対象を表す値を作る（FNV-1a）
+/// </summary>
+uint64_t GhostBoard::ComputeMapKey(const MapChipField& mapChipField) {
+	uint64_t hash = 0xCBF29CE484222325ull;
+	auto mix = [&hash](uint32_t value) {
+		for (uint32_t i = 0; i < 4; ++i) {
+			hash ^= (value >> (i * 8)) & 0xFF;
+			hash *= 0x100000001B3ull;
+		}
+	};
+
+	mix(mapChipField.GetNumBlockHorizontal());
+	mix(mapChipField.GetNumBlockVirtical());
+	for (uint32_t y = 0; y < mapChipField.GetNumBlockVirtical(); ++y) {
+		for (uint32_t x = 0; x < mapChipField.GetNumBlockHorizontal(); ++x) {
+			mix(static_cast<uint32_t>(mapChipField.GetMapChipTypeByIndex(x, y)));
+		}
+	}
+	return hash;
+}
+
+/// <summary>
+/// 読む（1件ずつ先頭を読んで確かめてから中身を読む）
+/// </summary>
+bool GhostBoard::Load(const std::string& filePath, uint64_t mapKey) {
+	entries_.clear();
+	mapKey_ = mapKey;
+
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+
+	FileHeader header;
+	if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion ||
+	    header.mapKey != mapKey) {
+		return false;
+	}
+
+	uint32_t count = (std::min)(header.count, kCapacity);
+	entries_.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+		EntryHeader entryHeader;
+		if (!file.read(reinterpret_cast<char*>(&entryHeader), sizeof(entryHeader)) || entryHeader.byteCount > GhostRecording::kMaxBytes || entryHeader.clearFrame == 0) {
+			entries_.clear();
+			return false;
+		}
+
+		GhostRecording recording;
+		recording.bytes_.resize(entryHeader.byteCount);
+		recording.sampleCount_ = entryHeader.sampleCount;
+		recording.clearFrame_ = entryHeader.clearFrame;
+		recording.z_ = entryHeader.z;
+		if (!file.read(reinterpret_cast<char*>(recording.bytes_.data()), entryHeader.byteCount) || !recording.Validate()) {
+			entries_.clear();
+			return false;
+		}
+		entries_.push_back(std::move(recording));
+	}
+
+	// 手で並べ替えられたファイルでも速い順に
+	std::stable_sort(entries_.begin(), entries_.end(), [](const GhostRecording& a, const GhostRecording& b) { return a.clearFrame_ < b.clearFrame_; });
+	return true;
+}
+
+/// <summary>
+/// 書く
+/// </summary>
+bool GhostBoard::Save(const std::string& filePath) const {
+	FileHeader header = {};
+	std::memcpy(header.magic, kMagic, sizeof(kMagic));
+	header.version = kVersion;
+	header.mapKey = mapKey_;
+	header.count = static_cast<uint32_t>(entries_.size());
+
+	return FileUtility::WriteAtomically(filePath, [&](std::ofstream& file) {
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for (const GhostRecording& recording : entries_) {
+			EntryHeader entryHeader = {recording.sampleCount_, recording.clearFrame_, static_cast<uint32_t>(recording.bytes_.size()), recording.z_};
+			file.write(reinterpret_cast<const char*>(&entryHeader), sizeof(entryHeader));
+			file.write(reinterpret_cast<const char*>(recording.bytes_.data()), static_cast<std::streamsize>(recording.bytes_.size()));
+		}
+	});
+}
+
+/// <summary>
+/// ゴールした記録を加える
+/// </summary>
+int32_t GhostBoard::Submit(const GhostRecording& recording) {
+	if (!recording.IsFinished() || recording.sampleCount_ == 0) {
+		return -1;
+	}
+
+	// 同じタイムなら先に出したものを上に
+	std::vector<GhostRecording>::iterator position =
+	    std::upper_bound(entries_.begin(), entries_.end(), recording.clearFrame_, [](uint32_t clearFrame, const GhostRecording& entry) { return clearFrame < entry.clearFrame_; });
+	size_t rank = static_cast<size_t>(position - entries_.begin());
+	if (rank >= kCapacity) {
+		return -1;
+	}
+
+	// 記録中の余分な容量は持ち込まない
+	GhostRecording entry;
+	entry.bytes_.assign(recording.bytes_.begin(), recording.bytes_.end());
+	entry.sampleCount_ = recording.sampleCount_;
+	entry.clearFrame_ = recording.clearFrame_;
+	entry.z_ = recording.z_;
+	entries_.insert(position, std::move(entry));
+	if (entries_.size() > kCapacity) {
+		entries_.pop_back();
+	}
+	return static_cast<int32_t>(rank);
+}
@@ -0,0 +1,205 @@
+#pragma once
+#include "KamataEngine.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class MapChipField;
+
+/// <summary>
+/// 1回の走りの記録（位置・向き・状態を数フレームおきに量子化し、予測との差を可変長整数で詰めたもの）
+/// ・予測は直前の2サンプルからの等速（走り・落下はほぼ 0〜1 バイトの差に収まる）
+/// ・再生は GhostRace で行い、Player の物理は通さない
+/// </summary>
+class GhostRecording {
+public:
+	// 記録する間隔（フレーム。間は再生時に補間する）
+	static inline const uint32_t kSampleInterval = 2;
+	// 位置の量子化（1/この値 単位）
+	static inline const float kPositionScale = 512.0f;
+	// 向きの量子化（1周をこの数に分ける）
+	static inline const int32_t kRotationSteps = 4096;
+	// 記録の前に確保しておくバイト数（走っている間に確保しないよう。1サンプル3バイトで約11分）
+	static inline const size_t kReserveBytes = 64 * 1024;
+	// 読み込みで受け付ける1件の最大バイト数
+	static inline const uint32_t kMaxBytes = 4 * 1024 * 1024;
+
+	// 状態のフラグ
+	enum Flag : uint8_t {
+		kFlagAttackEffect = 1 << 0, // 攻撃エフェクトを出している
+	};
+
+	// 1サンプル（量子化済み）
+	struct Sample {
+		int32_t x;
+		int32_t y;
+		int32_t rotationY;
+		uint8_t flags;
+	};
+
+	/// <summary>
+	/// 先頭から順に読む（戻るときは Begin からやり直す）
+	/// </summary>
+	class Reader {
+	private:
+		const GhostRecording* recording_ = nullptr;
+		size_t offset_ = 0;
+		uint32_t index_ = 0;
+		// 予測に使う直前のサンプルと、その1つ前からの差
+		Sample last_ = {};
+		Sample delta_ = {};
+
+	public:
+		/// <summary>
+		/// 読み始める
+		/// </summary>
+		/// <param name="recording"></param>
+		void Begin(const GhostRecording& recording);
+		/// <summary>
+		/// 次のサンプルを読む
+		/// </summary>
+		/// <param name="sample"></param>
+		/// <returns>読めたか（終わり・壊れていれば false）</returns>
+		bool Next(Sample& sample);
+
+		/// <summary>
+		/// ゲッター
+		/// </summary>
+		/// <returns></returns>
+		uint32_t GetIndex() const { return index_; }
+		size_t GetOffset() const { return offset_; }
+		bool IsEnd() const { return recording_ == nullptr || index_ >= recording_->sampleCount_; }
+	};
+
+private:
+	// 詰めたサンプル
+	std::vector<uint8_t> bytes_;
+	uint32_t sampleCount_ = 0;
+	// ゴールまでのフレーム数（0 ならまだゴールしていない）
+	uint32_t clearFrame_ = 0;
+	// 奥行き（走っている間は変わらないので1つだけ持つ）
+	float z_ = 0.0f;
+
+	// 記録中の状態
+	uint32_t frame_ = 0;
+	Sample last_ = {};
+	Sample delta_ = {};
+
+public:
+	/// <summary>
+	/// 記録を始める（容量は残す）
+	/// </summary>
+	void Begin();
+
+	/// <summary>
+	/// 1フレーム分を渡す（毎フレーム。kSampleInterval フレームおきに記録する）
+	/// </summary>
+	/// <param name="worldTransform"></param>
+	/// <param name="flags"></param>
+	void Record(const KamataEngine::WorldTransform& worldTransform, uint8_t flags);
+
+	/// <summary>
+	/// ゴールした（ここまでのフレーム数を残す）
+	/// </summary>
+	void Finish() { clearFrame_ = frame_; }
+
+	/// <summary>
+	/// 全て読んで、数と長さが合っているか確かめる
+	/// </summary>
+	/// <returns></returns>
+	bool Validate() const;
+
+	/// <summary>
+	/// 量子化したサンプルを元の値に戻す
+	/// </summary>
+	static float ToPosition(int32_t value) { return static_cast<float>(value) / kPositionScale; }
+	static float ToRotation(int32_t value);
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<uint8_t>& GetBytes() const { return bytes_; }
+	uint32_t GetSampleCount() const { return sampleCount_; }
+	uint32_t GetClearFrame() const { return clearFrame_; }
+	float GetZ() const { return z_; }
+	bool IsFinished() const { return clearFrame_ > 0; }
+
+private:
+	friend class GhostBoard;
+	/// <summary>
+	/// 1サンプルを詰める
+	/// </summary>
+	void Encode(const Sample& sample);
+};
+
+/// <summary>
+/// マップごとの速い順の記録（ファイルは1件ずつ順に読み、全体を一度にメモリへ載せない）
+/// </summary>
+class GhostBoard {
+public:
+	// 残す件数（全てゴーストとして同時に走らせる）
+	static inline const uint32_t kCapacity = 256;
+	static inline const char kMagic[4] = {'G', 'H', 'S', 'T'};
+	static inline const uint32_t kVersion = 1;
+
+private:
+	// ファイルの先頭
+	struct FileHeader {
+		char magic[4];
+		uint32_t version;
+		uint64_t mapKey;
+		uint32_t count;
+		uint32_t padding;
+	};
+	// 1件ごとの先頭（この後ろに byteCount バイト続く）
+	struct EntryHeader {
+		uint32_t sampleCount;
+		uint32_t clearFrame;
+		uint32_t byteCount;
+		float z;
+	};
+
+	// 速い順
+	std::vector<GhostRecording> entries_;
+	// どのマップの記録か
+	uint64_t mapKey_ = 0;
+
+public:
+	/// <summary>
+	/// マップの中身から記録の対象を表す値を作る（マップが変われば古い記録は読まない）
+	/// </summary>
+	/// <param name="mapChipField"></param>
+	/// <returns></returns>
+	static uint64_t ComputeMapKey(const MapChipField& mapChipField);
+
+	/// <summary>
+	/// 読む（無い・別のマップ・壊れていれば空にして false）
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <param name="mapKey"></param>
+	/// <returns></returns>
+	bool Load(const std::string& filePath, uint64_t mapKey);
+	/// <summary>
+	/// 書く（一時ファイルに書いてから置き換える）
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <returns></returns>
+	bool Save(const std::string& filePath) const;
+
+	/// <summary>
+	/// ゴールした記録を加える（kCapacity 番以内に入らなければ何もしない）
+	/// </summary>
+	/// <param name="recording"></param>
+	/// <returns>何位に入ったか（入らなければ -1）</returns>
+	int32_t Submit(const GhostRecording& recording);
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<GhostRecording>& GetEntries() const { return entries_; }
+	uint64_t GetMapKey() const { return mapKey_; }
+};
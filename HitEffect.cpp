@@ -1,4 +1,4 @@
-#include "HItEffect.h"
+#include "HitEffect.h"
 #include "Random.h"
 #include "WorldTransformUpdater.h"
 #include <numbers>
@@ -12,9 +12,24 @@ Model* HitEffect::model_ = nullptr;
 Camera* HitEffect::camera_ = nullptr;
 
 /// <summary>
-/// 初期化
+/// 初期化（行列の確保だけ。出すときは Reset）
 /// </summary>
-void HitEffect::Initialize(const KamataEngine::Vector3& spawnPosition) {
+void HitEffect::Initialize() {
+	// 出すまでは消えている扱い
+	state_ = State::kDisappear;
+	counter_ = 0.0f;
+
+	circleWorldTransform_.Initialize();
+	for (WorldTransform& worldTransform : ellipseWorldTransforms_) {
+		worldTransform.Initialize();
+	}
+}
+
+/// <summary>
+/// 指定位置から出し直す（確保済みのものを使い回す）
+/// </summary>
+/// <param name="spawnPosition"></param>
+void HitEffect::Reset(const KamataEngine::Vector3& spawnPosition) {
 
 	state_ = State::kExpansionAnimetion;
 	counter_ = 0.0f;
@@ -23,22 +38,21 @@ void HitEffect::Initialize(const KamataEngine::Vector3& spawnPosition) {
 	/// 円形エフェクト
 	/// ===========================================
 
+	circleWorldTransform_.scale_ = {1.0f, 1.0f, 1.0f};
+	circleWorldTransform_.rotation_ = {0.0f, 0.0f, 0.0f};
 	circleWorldTransform_.translation_ = spawnPosition;
-	circleWorldTransform_.Initialize();
 
 	///============================================
 	/// 楕円エフェクト
 	/// ===========================================
 
-	// 乱数
-	Random::SeedEngine();
+	// 乱数（エフェクト用の列。毎回シードし直さない）
+	Random::Stream& random = Random::GetStream(Random::System::kHitEffect);
 
 	for (WorldTransform& worldTransform : ellipseWorldTransforms_) {
 		worldTransform.scale_ = {0.2f, 3.0f, 1.0f};
-		worldTransform.rotation_ = {0.0f, 0.0f, Random::GeneraterFloat(-std::numbers::pi_v<float>, std::numbers::pi_v<float>)};
+		worldTransform.rotation_ = {0.0f, 0.0f, random.NextFloat(-std::numbers::pi_v<float>, std::numbers::pi_v<float>)};
 		worldTransform.translation_ = spawnPosition;
-
-		worldTransform.Initialize();
 	}
 }
 
@@ -52,7 +66,8 @@ HitEffect* HitEffect::Create(const KamataEngine::Vector3& spawnPosition) {
 	// newの失敗を検出
 	assert(instance);
 	// インスタンスの初期化
-	instance->Initialize(spawnPosition);
+	instance->Initialize();
+	instance->Reset(spawnPosition);
 	// 初期化したインスタンスを返す
 	return instance;
 }
@@ -148,6 +163,36 @@ float HitEffect::EaseOut(float start, float end, float t) {
 	return start + (end - start) * easedT;
 }
 
+/// <summary>
+/// 状態を記録に書く
+/// </summary>
+/// <param name="snapshot"></param>
+void HitEffect::SaveState(SimulationSnapshot& snapshot) const {
+	SaveData data;
+	data.state = state_;
+	data.counter = counter_;
+	data.circle.Save(circleWorldTransform_);
+	for (uint32_t i = 0; i < kEllipseCount; ++i) {
+		data.ellipses[i].Save(ellipseWorldTransforms_[i]);
+	}
+	snapshot.Write(data);
+}
+
+/// <summary>
+/// 状態を記録から戻す
+/// </summary>
+/// <param name="reader"></param>
+void HitEffect::LoadState(SimulationSnapshot::Reader& reader) {
+	SaveData data;
+	reader.Read(data);
+	state_ = data.state;
+	counter_ = data.counter;
+	data.circle.Load(circleWorldTransform_);
+	for (uint32_t i = 0; i < kEllipseCount; ++i) {
+		data.ellipses[i].Load(ellipseWorldTransforms_[i]);
+	}
+}
+
 /// <summary>
 /// 描画
 /// </summary>
@@ -1,5 +1,6 @@
 #pragma once
 #include "KamataEngine.h"
+#include "SimulationSnapshot.h"
 
 class HitEffect {
 public:
@@ -25,6 +26,14 @@ private:
 	// 楕円のワールドトランスフォーム
 	std::array<KamataEngine::WorldTransform, kEllipseCount> ellipseWorldTransforms_;
 
+	// 記録に書く状態
+	struct SaveData {
+		State state;
+		float counter;
+		SimulationSnapshot::TransformState circle;
+		SimulationSnapshot::TransformState ellipses[kEllipseCount];
+	};
+
 	// モデル
 	static KamataEngine::Model* model_;
 
@@ -33,9 +42,15 @@ private:
 
 public:
 	/// <summary>
-	/// 初期化
+	/// 初期化（行列の確保だけ。出すときは Reset）
+	/// </summary>
+	void Initialize();
+
+	/// <summary>
+	/// 指定位置から出し直す（確保済みのものを使い回す）
 	/// </summary>
-	void Initialize(const KamataEngine::Vector3& spawnPosition);
+	/// <param name="spawnPosition"></param>
+	void Reset(const KamataEngine::Vector3& spawnPosition);
 
 	/// <summary>
 	/// インスタンス生成と初期化
@@ -67,6 +82,13 @@ public:
 	/// </summary>
 	void Draw();
 
+	/// <summary>
+	/// 段階・経過時間・円と楕円の変換を記録に書く / 記録から戻す
+	/// </summary>
+	/// <param name="snapshot"></param>
+	void SaveState(SimulationSnapshot& snapshot) const;
+	void LoadState(SimulationSnapshot::Reader& reader);
+
 	/// <summary>
 	/// ゲッター
 	/// </summary>
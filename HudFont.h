@@ -0,0 +1,130 @@
+// Tools/FontAtlas で生成（手で書き換えない）
+#pragma once
+#include "TextBatch.h"
+
+/// <summary>
+/// HUD のフォント（アトラス1枚に、大きい数字と ASCII の2書体）
+/// </summary>
+struct HudFont {
+	static inline const char* const kTexturePath = "text/hudFont.png";
+	static inline const uint32_t kAtlasWidth = 512;
+	static inline const uint32_t kAtlasHeight = 512;
+
+	// 大きい数字（'.' 〜 ':'。'/' は空白。等幅）
+	static inline const TextGlyph kDigitGlyphs[13] = {
+	    {2, 2, 21, 159, 12, 0, 45}, // '.'
+	    {0, 0, 0, 0, 0, 0, 45}, // '/'
+	    {25, 2, 77, 159, 11, 0, 100}, // '0'
+	    {104, 2, 43, 159, 28, 0, 100}, // '1'
+	    {149, 2, 78, 159, 11, 0, 100}, // '2'
+	    {229, 2, 79, 159, 10, 0, 100}, // '3'
+	    {310, 2, 88, 159, 6, 0, 100}, // '4'
+	    {400, 2, 76, 159, 12, 0, 100}, // '5'
+	    {2, 163, 76, 159, 12, 0, 100}, // '6'
+	    {80, 163, 75, 159, 12, 0, 100}, // '7'
+	    {157, 163, 80, 159, 10, 0, 100}, // '8'
+	    {239, 163, 76, 159, 12, 0, 100}, // '9'
+	    {317, 163, 21, 159, 12, 0, 45}, // ':'
+	};
+	static inline const TextFont kDigits = {kDigitGlyphs, 46, 13, 159.0f, 512.0f, 512.0f};
+
+	// ASCII（' ' 〜 '~'。9x18 の等幅）
+	static inline const TextGlyph kAsciiGlyphs[95] = {
+	    {0, 0, 0, 0, 0, 0, 9}, // ' '
+	    {2, 324, 9, 18, 0, 0, 9}, // '!'
+	    {13, 324, 9, 18, 0, 0, 9}, // '"'
+	    {24, 324, 9, 18, 0, 0, 9}, // '#'
+	    {35, 324, 9, 18, 0, 0, 9}, // '$'
+	    {46, 324, 9, 18, 0, 0, 9}, // '%'
+	    {57, 324, 9, 18, 0, 0, 9}, // '&'
+	    {68, 324, 9, 18, 0, 0, 9}, // '\''
+	    {79, 324, 9, 18, 0, 0, 9}, // '('
+	    {90, 324, 9, 18, 0, 0, 9}, // ')'
+	    {101, 324, 9, 18, 0, 0, 9}, // '*'
+	    {112, 324, 9, 18, 0, 0, 9}, // '+'
+	    {123, 324, 9, 18, 0, 0, 9}, // ','
+	    {134, 324, 9, 18, 0, 0, 9}, // '-'
+	    {145, 324, 9, 18, 0, 0, 9}, // '.'
+	    {156, 324, 9, 18, 0, 0, 9}, // '/'
+	    {167, 324, 9, 18, 0, 0, 9}, // '0'
+	    {178, 324, 9, 18, 0, 0, 9}, // '1'
+	    {189, 324, 9, 18, 0, 0, 9}, // '2'
+	    {200, 324, 9, 18, 0, 0, 9}, // '3'
+	    {211, 324, 9, 18, 0, 0, 9}, // '4'
+	    {222, 324, 9, 18, 0, 0, 9}, // '5'
+	    {233, 324, 9, 18, 0, 0, 9}, // '6'
+	    {244, 324, 9, 18, 0, 0, 9}, // '7'
+	    {255, 324, 9, 18, 0, 0, 9}, // '8'
+	    {266, 324, 9, 18, 0, 0, 9}, // '9'
+	    {277, 324, 9, 18, 0, 0, 9}, // ':'
+	    {288, 324, 9, 18, 0, 0, 9}, // ';'
+	    {299, 324, 9, 18, 0, 0, 9}, // '<'
+	    {310, 324, 9, 18, 0, 0, 9}, // '='
+	    {321, 324, 9, 18, 0, 0, 9}, // '>'
+	    {332, 324, 9, 18, 0, 0, 9}, // '?'
+	    {343, 324, 9, 18, 0, 0, 9}, // '@'
+	    {354, 324, 9, 18, 0, 0, 9}, // 'A'
+	    {365, 324, 9, 18, 0, 0, 9}, // 'B'
+	    {376, 324, 9, 18, 0, 0, 9}, // 'C'
+	    {387, 324, 9, 18, 0, 0, 9}, // 'D'
+	    {398, 324, 9, 18, 0, 0, 9}, // 'E'
+	    {409, 324, 9, 18, 0, 0, 9}, // 'F'
+	    {420, 324, 9, 18, 0, 0, 9}, // 'G'
+	    {431, 324, 9, 18, 0, 0, 9}, // 'H'
+	    {442, 324, 9, 18, 0, 0, 9}, // 'I'
+	    {453, 324, 9, 18, 0, 0, 9}, // 'J'
+	    {464, 324, 9, 18, 0, 0, 9}, // 'K'
+	    {475, 324, 9, 18, 0, 0, 9}, // 'L'
+	    {486, 324, 9, 18, 0, 0, 9}, // 'M'
+	    {497, 324, 9, 18, 0, 0, 9}, // 'N'
+	    {2, 344, 9, 18, 0, 0, 9}, // 'O'
+	    {13, 344, 9, 18, 0, 0, 9}, // 'P'
+	    {24, 344, 9, 18, 0, 0, 9}, // 'Q'
+	    {35, 344, 9, 18, 0, 0, 9}, // 'R'
+	    {46, 344, 9, 18, 0, 0, 9}, // 'S'
+	    {57, 344, 9, 18, 0, 0, 9}, // 'T'
+	    {68, 344, 9, 18, 0, 0, 9}, // 'U'
+	    {79, 344, 9, 18, 0, 0, 9}, // 'V'
+	    {90, 344, 9, 18, 0, 0, 9}, // 'W'
+	    {101, 344, 9, 18, 0, 0, 9}, // 'X'
+	    {112, 344, 9, 18, 0, 0, 9}, // 'Y'
+	    {123, 344, 9, 18, 0, 0, 9}, // 'Z'
+	    {134, 344, 9, 18, 0, 0, 9}, // '['
+	    {145, 344, 9, 18, 0, 0, 9}, // '\\'
+	    {156, 344, 9, 18, 0, 0, 9}, // ']'
+	    {167, 344, 9, 18, 0, 0, 9}, // '^'
+	    {178, 344, 9, 18, 0, 0, 9}, // '_'
+	    {189, 344, 9, 18, 0, 0, 9}, // '`'
+	    {200, 344, 9, 18, 0, 0, 9}, // 'a'
+	    {211, 344, 9, 18, 0, 0, 9}, // 'b'
+	    {222, 344, 9, 18, 0, 0, 9}, // 'c'
+	    {233, 344, 9, 18, 0, 0, 9}, // 'd'
+	    {244, 344, 9, 18, 0, 0, 9}, // 'e'
+	    {255, 344, 9, 18, 0, 0, 9}, // 'f'
+	    {266, 344, 9, 18, 0, 0, 9}, // 'g'
+	    {277, 344, 9, 18, 0, 0, 9}, // 'h'
+	    {288, 344, 9, 18, 0, 0, 9}, // 'i'
+	    {299, 344, 9, 18, 0, 0, 9}, // 'j'
+	    {310, 344, 9, 18, 0, 0, 9}, // 'k'
+	    {321, 344, 9, 18, 0, 0, 9}, // 'l'
+	    {332, 344, 9, 18, 0, 0, 9}, // 'm'
+	    {343, 344, 9, 18, 0, 0, 9}, // 'n'
+	    {354, 344, 9, 18, 0, 0, 9}, // 'o'
+	    {365, 344, 9, 18, 0, 0, 9}, // 'p'
+	    {376, 344, 9, 18, 0, 0, 9}, // 'q'
+	    {387, 344, 9, 18, 0, 0, 9}, // 'r'
+	    {398, 344, 9, 18, 0, 0, 9}, // 's'
+	    {409, 344, 9, 18, 0, 0, 9}, // 't'
+	    {420, 344, 9, 18, 0, 0, 9}, // 'u'
+	    {431, 344, 9, 18, 0, 0, 9}, // 'v'
+	    {442, 344, 9, 18, 0, 0, 9}, // 'w'
+	    {453, 344, 9, 18, 0, 0, 9}, // 'x'
+	    {464, 344, 9, 18, 0, 0, 9}, // 'y'
+	    {475, 344, 9, 18, 0, 0, 9}, // 'z'
+	    {486, 344, 9, 18, 0, 0, 9}, // '{'
+	    {497, 344, 9, 18, 0, 0, 9}, // '|'
+	    {2, 364, 9, 18, 0, 0, 9}, // '}'
+	    {13, 364, 9, 18, 0, 0, 9}, // '~'
+	};
+	static inline const TextFont kAscii = {kAsciiGlyphs, 32, 95, 18.0f, 512.0f, 512.0f};
+};
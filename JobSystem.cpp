@@ -0,0 +1,290 @@
+#define NOMINMAX
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <cassert>
+#include <string>
+
+// 静的メンバ変数の実体
+thread_local uint32_t JobSystem::workerIndex_ = UINT32_MAX;
+
+namespace {
+
+/// <summary>
+/// キューのロック（持つのは数命令の間だけなので回って待つ）
+/// </summary>
+class SpinLock {
+private:
+	std::atomic_flag& flag_;
+
+public:
+	explicit SpinLock(std::atomic_flag& flag) : flag_(flag) {
+		while (flag_.test_and_set(std::memory_order_acquire)) {
+			std::this_thread::yield();
+		}
+	}
+	~SpinLock() { flag_.clear(std::memory_order_release); }
+};
+
+} // namespace
+
+/// <summary>
+/// インスタンスの取得
+/// </summary>
+/// <returns></returns>
+JobSystem* JobSystem::GetInstance() {
+	static JobSystem instance;
+	return &instance;
+}
+
+/// <summary>
+/// デストラクタ
+/// </summary>
+JobSystem::~JobSystem() { Finalize(); }
+
+/// <summary>
+/// ワーカーを起動（呼んだスレッドもジョブを実行する側に入る）
+/// </summary>
+/// <param name="workerCount">ワーカースレッドの数（UINT32_MAX ならコア数 - 1）</param>
+void JobSystem::Initialize(uint32_t workerCount) {
+	Finalize();
+
+	if (workerCount == UINT32_MAX) {
+		uint32_t coreCount = std::thread::hardware_concurrency();
+		workerCount = coreCount > 1 ? coreCount - 1 : 0;
+	}
+
+	isQuitting_ = false;
+	queues_.resize(workerCount + 1);
+	for (WorkerQueue*& queue : queues_) {
+		queue = new WorkerQueue;
+	}
+
+	// 呼んだスレッドは 0 番
+	workerIndex_ = 0;
+
+	workers_.reserve(workerCount);
+	for (uint32_t i = 1; i <= workerCount; ++i) {
+		workers_.emplace_back(&JobSystem::WorkerMain, this, i);
+	}
+}
+
+/// <summary>
+/// ワーカーを止める（残ったジョブは実行してから止まる）
+/// </summary>
+void JobSystem::Finalize() {
+	if (queues_.empty()) {
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		isQuitting_ = true;
+	}
+	wakeUp_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+	workers_.clear();
+
+	// メインスレッドの分が残っていればここで実行
+	Job job;
+	while (TryTake(0, job)) {
+		Execute(job);
+	}
+
+	for (WorkerQueue* queue : queues_) {
+		delete queue;
+	}
+	queues_.clear();
+	workerIndex_ = UINT32_MAX;
+}
+
+/// <summary>
+/// ジョブを投入（counter を1増やす）
+/// </summary>
+/// <param name="job"></param>
+void JobSystem::Schedule(const Job& job) {
+	if (job.counter) {
+		job.counter->count_.fetch_add(1, std::memory_order_relaxed);
+	}
+	Enqueue(job);
+}
+
+/// <summary>
+/// dependency が 0 になってからジョブを投入（既に 0 ならすぐ投入）
+/// </summary>
+/// <param name="dependency"></param>
+/// <param name="job"></param>
+void JobSystem::ScheduleAfter(JobCounter& dependency, const Job& job) {
+	// 待っている間も、job の counter は未完了として数える
+	if (job.counter) {
+		job.counter->count_.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(dependency.mutex_);
+		if (dependency.count_.load(std::memory_order_acquire) != 0) {
+			assert(dependency.continuationCount_ < JobCounter::kMaxContinuations);
+			dependency.continuations_[dependency.continuationCount_++] = job;
+			return;
+		}
+	}
+	Enqueue(job);
+}
+
+/// <summary>
+/// counter が 0 になるまで、ほかのジョブを手伝いながら待つ
+/// </summary>
+/// <param name="counter"></param>
+void JobSystem::Wait(JobCounter& counter) {
+	Job job;
+	while (!counter.IsDone()) {
+		if (workerIndex_ != UINT32_MAX && TryTake(workerIndex_, job)) {
+			Execute(job);
+		} else {
+			std::this_thread::yield();
+		}
+	}
+}
+
+/// <summary>
+/// ワーカースレッドの処理
+/// </summary>
+/// <param name="index"></param>
+void JobSystem::WorkerMain(uint32_t index) {
+	workerIndex_ = index;
+	PROFILE_THREAD_NAME("JobWorker" + std::to_string(index));
+
+	Job job;
+	while (true) {
+		if (TryTake(index, job)) {
+			Execute(job);
+			continue;
+		}
+
+		// 仕事が無ければ、投入されるか終了するまで寝る
+		std::unique_lock<std::mutex> lock(sleepMutex_);
+		sleepingCount_.fetch_add(1, std::memory_order_seq_cst);
+		wakeUp_.wait(lock, [this]() { return isQuitting_.load() || queuedCount_.load(std::memory_order_seq_cst) > 0; });
+		sleepingCount_.fetch_sub(1, std::memory_order_relaxed);
+		if (isQuitting_.load() && queuedCount_.load() == 0) {
+			return;
+		}
+	}
+}
+
+/// <summary>
+/// 自分のキュー→ほかのキューの順に1つ取る
+/// </summary>
+/// <param name="index">呼んだスレッドのキューの番号</param>
+/// <param name="job"></param>
+/// <returns>取れたか</returns>
+bool JobSystem::TryTake(uint32_t index, Job& job) {
+	if (queuedCount_.load(std::memory_order_relaxed) == 0) {
+		return false;
+	}
+
+	// 自分のキューは後ろから（最後に積んだものがキャッシュに残っている）
+	{
+		WorkerQueue& queue = *queues_[index];
+		SpinLock lock(queue.lock);
+		if (queue.head != queue.tail) {
+			--queue.tail;
+			job = queue.jobs[queue.tail % kQueueCapacity];
+			queuedCount_.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+
+	// ほかのキューからは前から盗む（隣から順に見て、同じ相手に集中しないようにする）
+	uint32_t queueCount = static_cast<uint32_t>(queues_.size());
+	for (uint32_t offset = 1; offset < queueCount; ++offset) {
+		WorkerQueue& queue = *queues_[(index + offset) % queueCount];
+		SpinLock lock(queue.lock);
+		if (queue.head != queue.tail) {
+			job = queue.jobs[queue.head % kQueueCapacity];
+			++queue.head;
+			queuedCount_.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	return false;
+}
+
+/// <summary>
+/// ジョブを実行して counter を減らす（0 になったら後に続くジョブを投入）
+/// </summary>
+/// <param name="job"></param>
+void JobSystem::Execute(const Job& job) {
+	{
+		PROFILE_ZONE(job.name);
+		job.function(job.data, job.begin, job.end);
+	}
+	Finish(job.counter);
+}
+
+/// <summary>
+/// counter を1減らす
+/// </summary>
+/// <param name="counter"></param>
+void JobSystem::Finish(JobCounter* counter) {
+	if (!counter) {
+		return;
+	}
+
+	counter->finishingCount_.fetch_add(1, std::memory_order_acq_rel);
+	if (counter->count_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		// 最後の1つなら、後に続くジョブを取り出して投入
+		Job continuations[JobCounter::kMaxContinuations];
+		uint32_t continuationCount = 0;
+		{
+			std::lock_guard<std::mutex> lock(counter->mutex_);
+			continuationCount = counter->continuationCount_;
+			for (uint32_t i = 0; i < continuationCount; ++i) {
+				continuations[i] = counter->continuations_[i];
+			}
+			counter->continuationCount_ = 0;
+		}
+		for (uint32_t i = 0; i < continuationCount; ++i) {
+			Enqueue(continuations[i]);
+		}
+	}
+	// これ以降 counter に触れない
+	counter->finishingCount_.fetch_sub(1, std::memory_order_release);
+}
+
+/// <summary>
+/// キューへ積む（counter は増やさない）
+/// </summary>
+/// <param name="job"></param>
+void JobSystem::Enqueue(const Job& job) {
+	// 1スレッドのとき・キューを持たないスレッドからはその場で
+	if (IsSingleThreaded() || queues_.empty() || workerIndex_ == UINT32_MAX) {
+		Execute(job);
+		return;
+	}
+
+	bool isQueued = false;
+	{
+		WorkerQueue& queue = *queues_[workerIndex_];
+		SpinLock lock(queue.lock);
+		if (queue.tail - queue.head < kQueueCapacity) {
+			queue.jobs[queue.tail % kQueueCapacity] = job;
+			++queue.tail;
+			queuedCount_.fetch_add(1, std::memory_order_seq_cst);
+			isQueued = true;
+		}
+	}
+
+	// あふれたらその場で
+	if (!isQueued) {
+		Execute(job);
+		return;
+	}
+
+	// 寝ているワーカーがいれば起こす（寝る直前のワーカーを取りこぼさないよう、起こすときは同じロックを通す）
+	if (sleepingCount_.load(std::memory_order_seq_cst) > 0) {
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		wakeUp_.notify_one();
+	}
+}
@@ -0,0 +1,229 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobCounter;
+
+/// <summary>
+/// ジョブ1つ（関数と範囲。ヒープ確保しないよう関数ポインタと引数のポインタで持つ）
+/// </summary>
+struct Job {
+	void (*function)(void* data, uint32_t begin, uint32_t end) = nullptr;
+	void* data = nullptr;
+	uint32_t begin = 0;
+	uint32_t end = 0;
+	const char* name = "Job";     // プロファイラに出す名前
+	JobCounter* counter = nullptr; // 終わったら1減らす
+};
+
+/// <summary>
+/// 未完了のジョブ数（0 になると、後に続けるジョブを投入する）
+/// </summary>
+class JobCounter {
+public:
+	// 後に続けられるジョブの最大数
+	static inline const uint32_t kMaxContinuations = 8;
+
+private:
+	friend class JobSystem;
+
+	std::atomic<uint32_t> count_ = 0;
+	// 完了処理の途中のスレッド数（0 になるまで待ち手はカウンターを破棄しない）
+	std::atomic<uint32_t> finishingCount_ = 0;
+
+	// 後に続けるジョブ（追加と、最後のジョブが終わったときの取り出しだけロックする）
+	std::mutex mutex_;
+	Job continuations_[kMaxContinuations];
+	uint32_t continuationCount_ = 0;
+
+public:
+	JobCounter() = default;
+	JobCounter(const JobCounter&) = delete;
+	JobCounter& operator=(const JobCounter&) = delete;
+
+	/// <summary>
+	/// 全て終わったか（終わっていれば破棄してよい）
+	/// </summary>
+	/// <returns></returns>
+	bool IsDone() const { return count_.load(std::memory_order_acquire) == 0 && finishingCount_.load(std::memory_order_acquire) == 0; }
+};
+
+/// <summary>
+/// ワークスティーリングのジョブシステム（ワーカーごとの両端キュー。空いたワーカーは他から盗む）
+/// </summary>
+class JobSystem {
+public:
+	// ワーカー1つあたりのキューの大きさ（あふれたら投入したスレッドでその場で実行する）
+	static inline const uint32_t kQueueCapacity = 4096;
+	// ParallelFor で1ワーカーあたりに作る塊の数の目安（盗み合いで偏りをならす）
+	static inline const uint32_t kChunksPerWorker = 4;
+
+private:
+	/// <summary>
+	/// ワーカー1つ分のキュー（持ち主は後ろから、盗む側は前から取る）
+	/// </summary>
+	struct WorkerQueue {
+		std::atomic_flag lock = ATOMIC_FLAG_INIT;
+		Job jobs[kQueueCapacity];
+		uint32_t head = 0; // 盗む側が取る位置
+		uint32_t tail = 0; // 持ち主が積む位置
+	};
+
+	// 0 は Initialize を呼んだスレッド（メインスレッド）、1 以降がワーカー
+	std::vector<WorkerQueue*> queues_;
+	std::vector<std::thread> workers_;
+
+	// 仕事が無いワーカーを寝かせる（投入時に寝ているワーカーがいるときだけ起こす）
+	std::mutex sleepMutex_;
+	std::condition_variable wakeUp_;
+	std::atomic<uint32_t> sleepingCount_ = 0;
+	std::atomic<uint32_t> queuedCount_ = 0;
+	std::atomic<bool> isQuitting_ = false;
+
+	// 1スレッドで順番に実行する（デバッグ用。毎回同じ順番になる）
+	std::atomic<bool> isSingleThreaded_ = false;
+
+	// 呼んだスレッドのキューの番号（キューを持たないスレッドは UINT32_MAX）
+	static thread_local uint32_t workerIndex_;
+
+public:
+	/// <summary>
+	/// インスタンスの取得
+	/// </summary>
+	/// <returns></returns>
+	static JobSystem* GetInstance();
+
+	/// <summary>
+	/// ワーカーを起動（呼んだスレッドもジョブを実行する側に入る）
+	/// </summary>
+	/// <param name="workerCount">ワーカースレッドの数（UINT32_MAX ならコア数 - 1）</param>
+	void Initialize(uint32_t workerCount = UINT32_MAX);
+
+	/// <summary>
+	/// ワーカーを止める（残ったジョブは実行してから止まる）
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// ジョブを投入（counter を1増やす）
+	/// </summary>
+	/// <param name="job"></param>
+	void Schedule(const Job& job);
+
+	/// <summary>
+	/// dependency が 0 になってからジョブを投入（既に 0 ならすぐ投入）
+	/// </summary>
+	/// <param name="dependency"></param>
+	/// <param name="job"></param>
+	void ScheduleAfter(JobCounter& dependency, const Job& job);
+
+	/// <summary>
+	/// counter が 0 になるまで、ほかのジョブを手伝いながら待つ
+	/// </summary>
+	/// <param name="counter"></param>
+	void Wait(JobCounter& counter);
+
+	/// <summary>
+	/// [0, count) を塊に分けて並列に実行し、全て終わるまで待つ
+	/// </summary>
+	/// <param name="name">プロファイラに出す名前</param>
+	/// <param name="count">要素数</param>
+	/// <param name="minChunkSize">塊の最小の大きさ（小さすぎると分ける費用の方が大きくなる）</param>
+	/// <param name="function">function(begin, end)</param>
+	template <typename Function> void ParallelFor(const char* name, uint32_t count, uint32_t minChunkSize, const Function& function);
+
+	/// <summary>
+	/// 1スレッドで順番に実行するか（デバッグ用）
+	/// </summary>
+	/// <param name="isSingleThreaded"></param>
+	void SetSingleThreaded(bool isSingleThreaded) { isSingleThreaded_.store(isSingleThreaded); }
+	bool IsSingleThreaded() const { return isSingleThreaded_.load(std::memory_order_relaxed); }
+
+	/// <summary>
+	/// ジョブを実行するスレッドの数（メインスレッドを含む）
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetThreadCount() const { return static_cast<uint32_t>(queues_.size()); }
+
+private:
+	JobSystem() = default;
+	~JobSystem();
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	/// <summary>
+	/// ワーカースレッドの処理
+	/// </summary>
+	/// <param name="index"></param>
+	void WorkerMain(uint32_t index);
+
+	/// <summary>
+	/// 自分のキュー→ほかのキューの順に1つ取る
+	/// </summary>
+	/// <param name="index">呼んだスレッドのキューの番号</param>
+	/// <param name="job"></param>
+	/// <returns>取れたか</returns>
+	bool TryTake(uint32_t index, Job& job);
+
+	/// <summary>
+	/// ジョブを実行して counter を減らす（0 になったら後に続くジョブを投入）
+	/// </summary>
+	/// <param name="job"></param>
+	void Execute(const Job& job);
+
+	/// <summary>
+	/// counter を1減らす
+	/// </summary>
+	/// <param name="counter"></param>
+	void Finish(JobCounter* counter);
+
+	/// <summary>
+	/// キューへ積む（counter は増やさない）
+	/// </summary>
+	/// <param name="job"></param>
+	void Enqueue(const Job& job);
+};
+
+/// <summary>
+/// [0, count) を塊に分けて並列に実行し、全て終わるまで待つ
+/// </summary>
+template <typename Function> void JobSystem::ParallelFor(const char* name, uint32_t count, uint32_t minChunkSize, const Function& function) {
+	if (count == 0) {
+		return;
+	}
+
+	// 1スレッドのとき・小さいときはその場で
+	uint32_t threadCount = GetThreadCount();
+	if (IsSingleThreaded() || threadCount <= 1 || count <= minChunkSize || workerIndex_ == UINT32_MAX) {
+		function(0u, count);
+		return;
+	}
+
+	uint32_t chunkCount = (std::min)((count + minChunkSize - 1) / minChunkSize, threadCount * kChunksPerWorker);
+	uint32_t chunkSize = (count + chunkCount - 1) / chunkCount;
+
+	JobCounter counter;
+	Job job;
+	job.function = [](void* data, uint32_t begin, uint32_t end) { (*static_cast<const Function*>(data))(begin, end); };
+	job.data = const_cast<Function*>(&function);
+	job.name = name;
+	job.counter = &counter;
+
+	// 最初の塊は自分で実行するので、残りを積む
+	for (uint32_t begin = chunkSize; begin < count; begin += chunkSize) {
+		job.begin = begin;
+		job.end = (std::min)(begin + chunkSize, count);
+		Schedule(job);
+	}
+	job.begin = 0;
+	job.end = (std::min)(chunkSize, count);
+	counter.count_.fetch_add(1, std::memory_order_relaxed);
+	Execute(job);
+
+	Wait(counter);
+}
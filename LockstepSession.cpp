@@ -0,0 +1,385 @@
+#define NOMINMAX
+#include "LockstepSession.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+namespace {
+
+// 経過時間（ミリ秒）
+double ElapsedMs(std::chrono::steady_clock::time_point start) { return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count(); }
+
+} // namespace
+
+/// <summary>
+/// 初期化
+/// </summary>
+/// <param name="simulation"></param>
+/// <param name="config"></param>
+/// <returns>ソケットを開けたか</returns>
+bool LockstepSession::Initialize(VersusSimulation* simulation, const Config& config) {
+	assert(simulation);
+	assert(config.localPlayer < VersusSimulation::kPlayerCount);
+
+	simulation_ = simulation;
+	config_ = config;
+	config_.inputDelay = std::min(config_.inputDelay, kMaxInputDelay);
+	config_.maxRollback = std::clamp(config_.maxRollback, 1u, kMaxRollback);
+
+	// 巻き戻し先になりうるフレームと、今のフレームの分
+	snapshots_.resize(config_.maxRollback + 2);
+
+	SetConditions(Conditions{});
+
+	Reset();
+
+	return socket_.Open(config_.localPort);
+}
+
+/// <summary>
+/// 最初からやり直す
+/// </summary>
+void LockstepSession::Reset() {
+	simulation_->Reset();
+	frame_ = 0;
+
+	for (std::array<PlayerInput, kInputWindow>& inputs : inputs_) {
+		inputs.fill(PlayerInput{});
+	}
+	usedRemoteInputs_.fill(PlayerInput{});
+	rollbackFrame_ = kNoFrame;
+
+	// 入力遅延の分、自分の最初の数フレームは何も押していないことにする
+	inputCounts_[config_.localPlayer] = config_.inputDelay;
+	inputCounts_[GetRemotePlayer()] = 0;
+
+	remoteAckCount_ = 0;
+	remoteFrame_ = 0;
+	remoteAdvantage_ = 0;
+	timeSyncFrame_ = kNoFrame;
+
+	localHashFrames_.fill(kNoFrame);
+	remoteHashFrames_.fill(kNoFrame);
+	hashedCount_ = 0;
+
+	delayedPackets_.clear();
+	stats_ = Stats{};
+}
+
+/// <summary>
+/// 回線状況の再現を設定
+/// </summary>
+/// <param name="conditions"></param>
+void LockstepSession::SetConditions(const Conditions& conditions) {
+	conditions_ = conditions;
+	conditionsRandom_.Seed(conditions_.seed, config_.localPlayer);
+}
+
+/// <summary>
+/// 1フレーム分の処理
+/// </summary>
+/// <param name="localInput"></param>
+/// <param name="nowMs"></param>
+/// <returns>1フレーム進めたか</returns>
+bool LockstepSession::Update(const PlayerInput& localInput, double nowMs) { return Process(&localInput, nowMs); }
+
+/// <summary>
+/// フレームを進めずに、受信・巻き戻し・送信だけ行う
+/// </summary>
+/// <param name="nowMs"></param>
+void LockstepSession::Poll(double nowMs) { Process(nullptr, nowMs); }
+
+/// <summary>
+/// Update と Poll の中身
+/// </summary>
+/// <param name="localInput">無ければ進めない</param>
+/// <param name="nowMs"></param>
+/// <returns>1フレーム進めたか</returns>
+bool LockstepSession::Process(const PlayerInput* localInput, double nowMs) {
+	PROFILE_ZONE("LockstepSession::Update");
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	FlushDelayedPackets(nowMs);
+	Receive();
+
+	// 予測が外れていたらやり直す
+	stats_.lastRollbackMs = 0.0;
+	if (rollbackFrame_ != kNoFrame) {
+		std::chrono::steady_clock::time_point rollbackStart = std::chrono::steady_clock::now();
+		Rollback();
+		stats_.lastRollbackMs = ElapsedMs(rollbackStart);
+		stats_.maxRollbackMs = std::max(stats_.maxRollbackMs, stats_.lastRollbackMs);
+		stats_.totalRollbackMs += stats_.lastRollbackMs;
+	}
+
+	bool isAdvanced = false;
+	const uint32_t remoteCount = inputCounts_[GetRemotePlayer()];
+	if (!localInput) {
+		// 進めない
+	} else if (frame_ >= remoteCount + config_.maxRollback) {
+		// 相手の入力がこれ以上遅れると戻しきれないので待つ
+		++stats_.stalls;
+	} else if (frame_ % kTimeSyncInterval == 0 && frame_ != timeSyncFrame_ &&
+	           (static_cast<int32_t>(frame_) - static_cast<int32_t>(remoteFrame_) - remoteAdvantage_) / 2 >= 1) {
+		// 相手より先に進みすぎている（自分から見た差と相手から見た差の半分）ので1フレーム待ち、巻き戻しが常に起きる状態を避ける
+		timeSyncFrame_ = frame_;
+		++stats_.timeSyncWaits;
+	} else {
+		// 自分の入力は入力遅延の分だけ後のフレームに置く
+		uint32_t& localCount = inputCounts_[config_.localPlayer];
+		inputs_[config_.localPlayer][localCount % kInputWindow] = *localInput;
+		++localCount;
+
+		Advance();
+		isAdvanced = true;
+	}
+
+	HashConfirmedFrames();
+	SendInputs(nowMs);
+
+	stats_.lastUpdateMs = ElapsedMs(start);
+	stats_.maxUpdateMs = std::max(stats_.maxUpdateMs, stats_.lastUpdateMs);
+	stats_.totalUpdateMs += stats_.lastUpdateMs;
+	return isAdvanced;
+}
+
+/// <summary>
+/// 確定した入力
+/// </summary>
+/// <param name="frame"></param>
+/// <returns></returns>
+VersusSimulation::Inputs LockstepSession::GetConfirmedInputs(uint32_t frame) const {
+	assert(frame < GetConfirmedFrameCount());
+	return {inputs_[0][frame % kInputWindow], inputs_[1][frame % kInputWindow]};
+}
+
+/// <summary>
+/// 届いたパケットを全て読む
+/// </summary>
+void LockstepSession::Receive() {
+	std::array<uint8_t, kMaxPacketSize> buffer;
+	UdpSocket::Address from;
+	while (size_t size = socket_.Receive(from, buffer.data(), buffer.size())) {
+		// 相手以外からのものは捨てる
+		if (from != config_.peer) {
+			continue;
+		}
+		++stats_.packetsReceived;
+		stats_.bytesReceived += size;
+		ReadPacket(buffer.data(), size);
+	}
+}
+
+/// <summary>
+/// パケット1つを読む
+/// </summary>
+/// <param name="bytes"></param>
+/// <param name="size"></param>
+void LockstepSession::ReadPacket(const uint8_t* bytes, size_t size) {
+	if (size < sizeof(PacketHeader)) {
+		return;
+	}
+	PacketHeader header;
+	std::memcpy(&header, bytes, sizeof(header));
+	if (header.magic != kMagic || header.player != GetRemotePlayer() || header.inputCount > kMaxInputsPerPacket || size != sizeof(PacketHeader) + header.inputCount) {
+		return;
+	}
+
+	// 届いた順は問わないので、新しいものだけ使う
+	remoteAckCount_ = std::max(remoteAckCount_, header.ackCount);
+	if (header.frame >= remoteFrame_) {
+		remoteFrame_ = header.frame;
+		remoteAdvantage_ = header.advantage;
+	}
+
+	// 入力は続きから（抜けがあれば、相手が送り直してくるまで待つ）
+	uint32_t& remoteCount = inputCounts_[GetRemotePlayer()];
+	const uint8_t* inputBytes = bytes + sizeof(PacketHeader);
+	for (uint32_t i = 0; i < header.inputCount; ++i) {
+		uint32_t frame = header.inputBegin + i;
+		if (frame != remoteCount) {
+			continue;
+		}
+
+		PlayerInput input;
+		input.buttons = inputBytes[i];
+		inputs_[GetRemotePlayer()][frame % kInputWindow] = input;
+		++remoteCount;
+
+		// 予測で進めたフレームの入力が違っていたら、そこから戻す
+		if (frame < frame_ && usedRemoteInputs_[frame % kInputWindow] != input) {
+			rollbackFrame_ = std::min(rollbackFrame_, frame);
+		}
+	}
+
+	// 相手のハッシュ（同じフレームのものは何度も届くので1回だけ）
+	if (header.hashFrame != kNoFrame && remoteHashFrames_[header.hashFrame % kInputWindow] != header.hashFrame) {
+		remoteHashFrames_[header.hashFrame % kInputWindow] = header.hashFrame;
+		remoteHashes_[header.hashFrame % kInputWindow] = header.hash;
+		CompareHash(header.hashFrame);
+	}
+}
+
+/// <summary>
+/// 予測が外れたフレームまで戻してやり直す
+/// </summary>
+void LockstepSession::Rollback() {
+	PROFILE_ZONE("LockstepSession::Rollback");
+
+	const uint32_t target = rollbackFrame_;
+	rollbackFrame_ = kNoFrame;
+	assert(target < frame_ && frame_ - target < snapshots_.size());
+
+	const uint32_t current = frame_;
+	simulation_->LoadState(snapshots_[target % snapshots_.size()]);
+	frame_ = target;
+	assert(simulation_->GetFrame() == frame_);
+
+	// 戻した先の記録はそのまま使えるので、次のフレームから記録し直す
+	simulation_->Step(GatherInputs(frame_));
+	++frame_;
+	while (frame_ < current) {
+		Advance();
+	}
+
+	++stats_.rollbacks;
+	stats_.resimulatedFrames += current - target;
+	stats_.maxRollbackDepth = std::max(stats_.maxRollbackDepth, current - target);
+	// Advance で数えた分は、進めたフレーム数には入れない
+	stats_.frames -= current - target - 1;
+}
+
+/// <summary>
+/// 今のフレームの状態を記録して1フレーム進める
+/// </summary>
+void LockstepSession::Advance() {
+	simulation_->SaveState(snapshots_[frame_ % snapshots_.size()]);
+	simulation_->Step(GatherInputs(frame_));
+	++frame_;
+	++stats_.frames;
+}
+
+/// <summary>
+/// frame で使う入力（相手の分が無ければ予測）
+/// </summary>
+/// <param name="frame"></param>
+/// <returns></returns>
+VersusSimulation::Inputs LockstepSession::GatherInputs(uint32_t frame) {
+	const uint32_t remote = GetRemotePlayer();
+	const uint32_t remoteCount = inputCounts_[remote];
+
+	VersusSimulation::Inputs inputs;
+	inputs[config_.localPlayer] = inputs_[config_.localPlayer][frame % kInputWindow];
+	if (frame < remoteCount) {
+		inputs[remote] = inputs_[remote][frame % kInputWindow];
+	} else if (remoteCount > 0) {
+		// 最後に届いた入力が続くと予測する（ボタンは押しっぱなし・離しっぱなしの時間が長いので、大抵当たる）
+		inputs[remote] = inputs_[remote][(remoteCount - 1) % kInputWindow];
+	} else {
+		inputs[remote] = PlayerInput{};
+	}
+	usedRemoteInputs_[frame % kInputWindow] = inputs[remote];
+	return inputs;
+}
+
+/// <summary>
+/// 入力が揃ったフレームのハッシュを取る
+/// </summary>
+void LockstepSession::HashConfirmedFrames() {
+	// 開始時点の記録があり（frame_ より前）、それより前の入力が全て揃っているフレーム
+	const uint32_t end = std::min(frame_, GetConfirmedFrameCount() + 1);
+	for (; hashedCount_ < end; ++hashedCount_) {
+		assert(frame_ - hashedCount_ <= snapshots_.size());
+		const uint32_t frame = hashedCount_;
+		localHashes_[frame % kInputWindow] = static_cast<uint32_t>(snapshots_[frame % snapshots_.size()].ComputeHash());
+		localHashFrames_[frame % kInputWindow] = frame;
+		CompareHash(frame);
+	}
+}
+
+/// <summary>
+/// 相手のハッシュと比べる
+/// </summary>
+/// <param name="frame"></param>
+void LockstepSession::CompareHash(uint32_t frame) {
+	const uint32_t index = frame % kInputWindow;
+	if (localHashFrames_[index] != frame || remoteHashFrames_[index] != frame) {
+		return;
+	}
+
+	++stats_.hashesCompared;
+	if (localHashes_[index] != remoteHashes_[index] && stats_.desyncFrame == kNoFrame) {
+		stats_.desyncFrame = frame;
+	}
+}
+
+/// <summary>
+/// 入力と確認を送る
+/// </summary>
+/// <param name="nowMs"></param>
+void LockstepSession::SendInputs(double nowMs) {
+	// 相手が受け取ったと言ってくるまで、毎回まとめて送り直す（失ったパケットの再送を兼ねる）
+	const uint32_t localCount = inputCounts_[config_.localPlayer];
+	const uint32_t begin = std::max(remoteAckCount_, localCount - std::min(localCount, kInputWindow));
+	const uint32_t count = std::min(localCount - std::min(begin, localCount), kMaxInputsPerPacket);
+
+	PacketHeader header{};
+	header.magic = kMagic;
+	header.frame = frame_;
+	header.inputBegin = begin;
+	header.ackCount = inputCounts_[GetRemotePlayer()];
+	header.hashFrame = hashedCount_ > 0 ? hashedCount_ - 1 : kNoFrame;
+	header.hash = hashedCount_ > 0 ? localHashes_[header.hashFrame % kInputWindow] : 0;
+	header.player = static_cast<uint8_t>(config_.localPlayer);
+	header.inputCount = static_cast<uint8_t>(count);
+	header.advantage = static_cast<int8_t>(std::clamp(static_cast<int32_t>(frame_) - static_cast<int32_t>(remoteFrame_), -127, 127));
+
+	std::array<uint8_t, kMaxPacketSize> buffer;
+	std::memcpy(buffer.data(), &header, sizeof(header));
+	for (uint32_t i = 0; i < count; ++i) {
+		buffer[sizeof(header) + i] = inputs_[config_.localPlayer][(begin + i) % kInputWindow].buttons;
+	}
+	SendPacket(buffer.data(), sizeof(header) + count, nowMs);
+}
+
+/// <summary>
+/// 送る（Conditions があれば遅らせる・捨てる）
+/// </summary>
+void LockstepSession::SendPacket(const uint8_t* bytes, size_t size, double nowMs) {
+	++stats_.packetsSent;
+	stats_.bytesSent += size;
+
+	if (conditions_.lossRate > 0.0f && conditionsRandom_.NextFloat01() < conditions_.lossRate) {
+		++stats_.packetsDropped;
+		return;
+	}
+
+	if (conditions_.latencyMs <= 0.0 && conditions_.jitterMs <= 0.0) {
+		socket_.Send(config_.peer, bytes, size);
+		return;
+	}
+
+	DelayedPacket packet;
+	packet.sendTimeMs = nowMs + conditions_.latencyMs + conditions_.jitterMs * conditionsRandom_.NextFloat01();
+	packet.size = static_cast<uint32_t>(size);
+	std::memcpy(packet.bytes.data(), bytes, size);
+	delayedPackets_.push_back(packet);
+}
+
+/// <summary>
+/// 遅らせていたパケットのうち、時間が来たものを送る
+/// </summary>
+void LockstepSession::FlushDelayedPackets(double nowMs) {
+	// 揺れがあると追い越しが起きる（実際の回線と同じく、順番は保証しない）
+	for (size_t i = 0; i < delayedPackets_.size();) {
+		if (delayedPackets_[i].sendTimeMs <= nowMs) {
+			socket_.Send(config_.peer, delayedPackets_[i].bytes.data(), delayedPackets_[i].size);
+			delayedPackets_[i] = delayedPackets_.back();
+			delayedPackets_.pop_back();
+		} else {
+			++i;
+		}
+	}
+}
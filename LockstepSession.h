@@ -0,0 +1,236 @@
+#pragma once
+#include "PlayerInput.h"
+#include "Random.h"
+#include "SimulationSnapshot.h"
+#include "UdpSocket.h"
+#include "VersusSimulation.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 2人対戦を UDP で同期して進める（入力だけを送り合い、両方が同じシミュレーションを回す）
+/// ・入力遅延: 自分の入力は inputDelay フレーム後に使う。その間に相手へ届けば巻き戻しは起きない
+/// ・予測と巻き戻し: 相手の入力が届いていないフレームは直前の入力を使って進め、違っていたらそこまで戻してやり直す
+/// ・同期ずれの検出: 両者の入力が揃ったフレームの状態のハッシュを送り合って比べる
+/// </summary>
+class LockstepSession {
+public:
+	// フレーム番号が無いことを表す
+	static inline const uint32_t kNoFrame = UINT32_MAX;
+	// 入力・ハッシュを覚えておくフレーム数（入力遅延 + 巻き戻し + 往復の遅れより十分大きく）
+	static inline const uint32_t kInputWindow = 128;
+	// 1パケットに載せる入力の最大数
+	static inline const uint32_t kMaxInputsPerPacket = 64;
+	// 入力遅延・巻き戻しの上限
+	static inline const uint32_t kMaxInputDelay = 15;
+	static inline const uint32_t kMaxRollback = 30;
+	// 進み具合の調整を行う間隔（フレーム）
+	static inline const uint32_t kTimeSyncInterval = 10;
+
+	// 設定
+	struct Config {
+		uint32_t localPlayer = 0;  // 自分が何P か（0 か 1）
+		uint32_t inputDelay = 2;   // 入力遅延（フレーム）
+		uint32_t maxRollback = 8;  // これより先には進まず、相手の入力を待つ
+		uint16_t localPort = 0;    // 受け付けるポート（0 なら空いているもの）
+		UdpSocket::Address peer;   // 相手
+	};
+
+	// 回線状況の再現（検証用。送るときに遅らせる・捨てる）
+	struct Conditions {
+		double latencyMs = 0.0; // 片道の遅延
+		double jitterMs = 0.0;  // 遅延の揺れ（0〜この値を足す）
+		float lossRate = 0.0f;  // 捨てる割合（0〜1）
+		uint64_t seed = 1;      // 揺れ・損失の乱数のシード
+	};
+
+	// 集計
+	struct Stats {
+		uint64_t packetsSent = 0;
+		uint64_t packetsReceived = 0;
+		uint64_t packetsDropped = 0;   // Conditions で捨てた数
+		uint64_t bytesSent = 0;        // UDP のペイロードのみ
+		uint64_t bytesReceived = 0;
+		uint64_t frames = 0;           // 進めたフレーム数
+		uint64_t stalls = 0;           // 相手の入力待ちで進めなかった回数
+		uint64_t timeSyncWaits = 0;    // 相手より進みすぎて1フレーム待った回数
+		uint64_t rollbacks = 0;        // 巻き戻した回数
+		uint64_t resimulatedFrames = 0; // 巻き戻してやり直したフレーム数
+		uint32_t maxRollbackDepth = 0; // 一度に戻した最大フレーム数
+		uint64_t hashesCompared = 0;   // 相手とハッシュを比べたフレーム数
+		uint32_t desyncFrame = kNoFrame; // 最初に同期ずれを見つけたフレーム
+		double lastUpdateMs = 0.0;     // 直近の Update（受信・巻き戻し・1フレーム・送信）
+		double maxUpdateMs = 0.0;
+		double totalUpdateMs = 0.0;
+		double lastRollbackMs = 0.0;   // 直近の Update のうち巻き戻しにかかった分
+		double maxRollbackMs = 0.0;
+		double totalRollbackMs = 0.0;
+	};
+
+private:
+	// パケットの先頭（入力はこの後ろに1フレーム1バイトで並ぶ）
+	struct PacketHeader {
+		uint32_t magic;
+		uint32_t frame;      // 送り手が次に進めるフレーム
+		uint32_t inputBegin; // 載せた入力の最初のフレーム
+		uint32_t ackCount;   // 受け取り済みの相手の入力の数（この手前までは送り直さなくてよい）
+		uint32_t hashFrame;  // ハッシュのフレーム（無ければ kNoFrame）
+		uint32_t hash;       // そのフレームの開始時点の状態のハッシュ（下位32bit）
+		uint8_t player;      // 送り手が何P か
+		uint8_t inputCount;  // 載せた入力の数
+		int8_t advantage;    // 送り手がどれだけ先に進んでいるか（フレーム）
+		uint8_t padding;
+	};
+
+	static inline const uint32_t kMagic = 0x5453434B; // "KCST"
+	static inline const size_t kMaxPacketSize = sizeof(PacketHeader) + kMaxInputsPerPacket;
+
+	// 遅らせて送るパケット
+	struct DelayedPacket {
+		double sendTimeMs;
+		uint32_t size;
+		std::array<uint8_t, kMaxPacketSize> bytes;
+	};
+
+	VersusSimulation* simulation_ = nullptr;
+	Config config_;
+	Conditions conditions_;
+	Random::Stream conditionsRandom_;
+
+	UdpSocket socket_;
+	std::vector<DelayedPacket> delayedPackets_;
+
+	// 次に進めるフレーム（シミュレーションの GetFrame と同じ）
+	uint32_t frame_ = 0;
+
+	// 両者の入力（リングバッファ）と、揃っている数（この手前のフレームは全て確定）
+	std::array<std::array<PlayerInput, kInputWindow>, VersusSimulation::kPlayerCount> inputs_ = {};
+	std::array<uint32_t, VersusSimulation::kPlayerCount> inputCounts_ = {};
+	// 進めたときに使った相手の入力（予測が外れたかの判定用）
+	std::array<PlayerInput, kInputWindow> usedRemoteInputs_ = {};
+	// 予測が外れた最初のフレーム（無ければ kNoFrame）
+	uint32_t rollbackFrame_ = kNoFrame;
+
+	// 相手が受け取り済みの自分の入力の数
+	uint32_t remoteAckCount_ = 0;
+	// 相手が次に進めるフレームと、相手の見た進み具合
+	uint32_t remoteFrame_ = 0;
+	int32_t remoteAdvantage_ = 0;
+	// 最後に進み具合を調整したフレーム
+	uint32_t timeSyncFrame_ = kNoFrame;
+
+	// 各フレームの開始時点の状態（巻き戻し用。frame % 数 の位置）
+	std::vector<SimulationSnapshot> snapshots_;
+
+	// 状態のハッシュ（入力が揃ったフレームだけ。frame % kInputWindow の位置にフレーム番号と一緒に）
+	std::array<uint32_t, kInputWindow> localHashes_ = {};
+	std::array<uint32_t, kInputWindow> localHashFrames_ = {};
+	std::array<uint32_t, kInputWindow> remoteHashes_ = {};
+	std::array<uint32_t, kInputWindow> remoteHashFrames_ = {};
+	// ハッシュを取り終えたフレーム数
+	uint32_t hashedCount_ = 0;
+
+	Stats stats_;
+
+public:
+	/// <summary>
+	/// 初期化（ソケットを開き、シミュレーションを開始時の状態に戻す）
+	/// </summary>
+	/// <param name="simulation"></param>
+	/// <param name="config"></param>
+	/// <returns>ソケットを開けたか</returns>
+	bool Initialize(VersusSimulation* simulation, const Config& config);
+
+	/// <summary>
+	/// 最初からやり直す（ソケットはそのまま。相手も同時に呼ぶこと）
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// 1フレーム分の処理（受信 → 必要なら巻き戻し → 進められれば1フレーム進める → 送信）
+	/// </summary>
+	/// <param name="localInput">このフレームの自分の入力（入力遅延の分だけ後のフレームで使われる）</param>
+	/// <param name="nowMs">現在時刻（Conditions の遅延にだけ使う）</param>
+	/// <returns>1フレーム進めたか</returns>
+	bool Update(const PlayerInput& localInput, double nowMs);
+
+	/// <summary>
+	/// フレームを進めずに、受信・巻き戻し・送信だけ行う（決着後の待ち・一時停止中など）
+	/// </summary>
+	/// <param name="nowMs"></param>
+	void Poll(double nowMs);
+
+	/// <summary>
+	/// セッター
+	/// </summary>
+	/// <param name="peer"></param>
+	void SetPeer(const UdpSocket::Address& peer) { config_.peer = peer; }
+	void SetConditions(const Conditions& conditions);
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	uint16_t GetLocalPort() const { return socket_.GetPort(); }
+	uint32_t GetFrame() const { return frame_; }
+	// 両者の入力が揃っているフレーム数
+	uint32_t GetConfirmedFrameCount() const { return (std::min)(inputCounts_[0], inputCounts_[1]); }
+	// 今の状態が予測を含まないか
+	bool IsStateConfirmed() const { return rollbackFrame_ == kNoFrame && frame_ <= GetConfirmedFrameCount(); }
+	bool IsDesynced() const { return stats_.desyncFrame != kNoFrame; }
+	const Stats& GetStats() const { return stats_; }
+	const Config& GetConfig() const { return config_; }
+	// 確定した入力（frame < GetConfirmedFrameCount() で、直近 kInputWindow フレームのみ）
+	VersusSimulation::Inputs GetConfirmedInputs(uint32_t frame) const;
+
+private:
+	/// <summary>
+	/// Update と Poll の中身（localInput が無ければ進めない）
+	/// </summary>
+	bool Process(const PlayerInput* localInput, double nowMs);
+	/// <summary>
+	/// 届いたパケットを全て読む
+	/// </summary>
+	void Receive();
+	/// <summary>
+	/// パケット1つを読む
+	/// </summary>
+	void ReadPacket(const uint8_t* bytes, size_t size);
+	/// <summary>
+	/// 予測が外れたフレームまで戻してやり直す
+	/// </summary>
+	void Rollback();
+	/// <summary>
+	/// 今のフレームの状態を記録して1フレーム進める
+	/// </summary>
+	void Advance();
+	/// <summary>
+	/// frame で使う入力（相手の分が無ければ予測）
+	/// </summary>
+	VersusSimulation::Inputs GatherInputs(uint32_t frame);
+	/// <summary>
+	/// 入力が揃ったフレームのハッシュを取る
+	/// </summary>
+	void HashConfirmedFrames();
+	/// <summary>
+	/// 相手のハッシュと比べる
+	/// </summary>
+	void CompareHash(uint32_t frame);
+	/// <summary>
+	/// 入力と確認を送る
+	/// </summary>
+	void SendInputs(double nowMs);
+	/// <summary>
+	/// 送る（Conditions があれば遅らせる・捨てる）
+	/// </summary>
+	void SendPacket(const uint8_t* bytes, size_t size, double nowMs);
+	/// <summary>
+	/// 遅らせていたパケットのうち、時間が来たものを送る
+	/// </summary>
+	void FlushDelayedPackets(double nowMs);
+
+	uint32_t GetRemotePlayer() const { return 1 - config_.localPlayer; }
+};
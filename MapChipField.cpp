@@ -1,4 +1,5 @@
 #include "MapChipField.h"
+#include <algorithm>
 #include <cassert>
 #include <fstream>
 #include <map>
@@ -11,7 +12,8 @@ namespace {
 std::map<std::string, MapChipType> mapChipTable = {
     {"0", MapChipType::kBlank},
     {"1", MapChipType::kBlock},
-    {"2", MapChipType::kGoal}
+    {"2", MapChipType::kGoal},
+    {"3", MapChipType::kEnemySpawn}
 };
 
 }
@@ -21,11 +23,9 @@ std::map<std::string, MapChipType> mapChipTable = {
 /// </summary>
 void MapChipField::ResetMapChipData() {
 	mapChipData_.data.clear();
-	mapChipData_.data.resize(kNumBlockVirtical);
 
-	for (std::vector<MapChipType>& mapChipDataLine : mapChipData_.data) {
-		mapChipDataLine.resize(kNumBlockHorizontal);
-	}
+	numBlockVirtical_ = 0;
+	numBlockHorizontal_ = 0;
 }
 
 /// <summary>
@@ -48,23 +48,40 @@ void MapChipField::LoadMapChipCsv(const std::string& filePath) {
 	// ファイルを閉じる
 	file.close();
 
-	// CSVからマップチップデータを読み込む
-	for (uint32_t i = 0; i < kNumBlockVirtical; ++i) {
-		std::string line;
-		getline(mapChipCsv, line);
+	// CSVからマップチップデータを読み込む（行数・列数はファイルに合わせる）
+	std::string line;
+	while (getline(mapChipCsv, line)) {
+		// 改行コードの残りを除く
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		// 空行は読み飛ばす
+		if (line.empty()) {
+			continue;
+		}
 
 		// 1行分の文字列をストリームに変換して解析しやすくする
 		std::istringstream line_stream(line);
 
-		for (uint32_t j = 0; j < kNumBlockHorizontal; ++j) {
-			std::string word;
-
-			getline(line_stream, word, ',');
+		std::vector<MapChipType>& mapChipDataLine = mapChipData_.data.emplace_back();
 
+		std::string word;
+		while (getline(line_stream, word, ',')) {
+			MapChipType type = MapChipType::kBlank;
 			if (mapChipTable.contains(word)) {
-				mapChipData_.data[i][j] = mapChipTable[word];
+				type = mapChipTable[word];
 			}
+			mapChipDataLine.push_back(type);
 		}
+
+		numBlockHorizontal_ = std::max(numBlockHorizontal_, static_cast<uint32_t>(mapChipDataLine.size()));
+	}
+
+	numBlockVirtical_ = static_cast<uint32_t>(mapChipData_.data.size());
+
+	// 短い行は空白で埋めて長方形にそろえる
+	for (std::vector<MapChipType>& mapChipDataLine : mapChipData_.data) {
+		mapChipDataLine.resize(numBlockHorizontal_, MapChipType::kBlank);
 	}
 }
 
@@ -74,12 +91,12 @@ void MapChipField::LoadMapChipCsv(const std::string& filePath) {
 /// <param name="xIndex"></param>
 /// <param name="yIndex"></param>
 /// <returns></returns>
-MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) {
-	if (xIndex < 0 || kNumBlockHorizontal - 1 < xIndex) {
+MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) const {
+	if (xIndex >= numBlockHorizontal_) {
 		return MapChipType::kBlank;
 	}
 
-	if (yIndex < 0 || kNumBlockVirtical - 1 < yIndex) {
+	if (yIndex >= numBlockVirtical_) {
 		return MapChipType::kBlank;
 	}
 
@@ -92,16 +109,16 @@ MapChipType MapChipField::GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex
 /// <param name="xIndex"></param>
 /// <param name="yIndex"></param>
 /// <returns></returns>
-Vector3 MapChipField::GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) { return Vector3(kBlockWidth * xIndex, kBlockHeight * (kNumBlockVirtical - 1 - yIndex), 0); }
+Vector3 MapChipField::GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) const { return Vector3(kBlockWidth * xIndex, kBlockHeight * (numBlockVirtical_ - 1 - yIndex), 0); }
 
-uint32_t MapChipField::GetNumBlockVirtical() { return kNumBlockVirtical; }
+uint32_t MapChipField::GetNumBlockVirtical() const { return numBlockVirtical_; }
 
-uint32_t MapChipField::GetNumBlockHorizontal() { return kNumBlockHorizontal; }
+uint32_t MapChipField::GetNumBlockHorizontal() const { return numBlockHorizontal_; }
 
-MapChipField::IndexSet MapChipField::GetMapChipIndexSetByPosition(const Vector3& position) {
+MapChipField::IndexSet MapChipField::GetMapChipIndexSetByPosition(const Vector3& position) const {
 	IndexSet indexSet = {};
 	indexSet.xIndex = static_cast<uint32_t>((position.x + kBlockWidth / 2.0f) / kBlockWidth);
-	indexSet.yIndex = kNumBlockVirtical - 1 - static_cast<uint32_t>((position.y + kBlockHeight / 2.0f) / kBlockHeight);
+	indexSet.yIndex = numBlockVirtical_ - 1 - static_cast<uint32_t>((position.y + kBlockHeight / 2.0f) / kBlockHeight);
 
 	return indexSet;
 }
@@ -112,7 +129,7 @@ MapChipField::IndexSet MapChipField::GetMapChipIndexSetByPosition(const Vector3&
 /// <param name="xIndex"></param>
 /// <param name="yIndex"></param>
 /// <returns></returns>
-MapChipField::Rect MapChipField::GetRectByIndex(uint32_t xIndex, uint32_t yIndex) {
+MapChipField::Rect MapChipField::GetRectByIndex(uint32_t xIndex, uint32_t yIndex) const {
 	// 指定ブロックの中心座標を取得する
 	Vector3 center = GetMapChipPositionByIndex(xIndex, yIndex);
 
@@ -7,6 +7,7 @@ enum class MapChipType {
 	kBlank, // 空白
 	kBlock, // ブロック
 	kGoal,  // ゴール
+	kEnemySpawn, // 敵の出現位置（地形としては空白）
 };
 
 struct MapChipData {
@@ -31,9 +32,9 @@ private:
 	// 1ブロックのサイズ
 	static inline const float kBlockWidth = 1.0f;
 	static inline const float kBlockHeight = 1.0f;
-	// ブロックの個数
-	static inline const uint32_t kNumBlockVirtical = 20;
-	static inline const uint32_t kNumBlockHorizontal = 100;
+	// ブロックの個数（CSVの行数・列数で決まる）
+	uint32_t numBlockVirtical_ = 0;
+	uint32_t numBlockHorizontal_ = 0;
 
 	MapChipData mapChipData_;
 
@@ -53,17 +54,17 @@ public:
 	/// <param name="xIndex"></param>
 	/// <param name="yIndex"></param>
 	/// <returns></returns>
-	MapChipType GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex);
+	MapChipType GetMapChipTypeByIndex(uint32_t xIndex, uint32_t yIndex) const;
 	/// <summary>
 	/// マップチップのワールド座標を取得
 	/// </summary>
 	/// <param name="xIndex"></param>
 	/// <param name="yIndex"></param>
 	/// <returns></returns>
-	KamataEngine::Vector3 GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex);
-	uint32_t GetNumBlockVirtical();
-	uint32_t GetNumBlockHorizontal();
+	KamataEngine::Vector3 GetMapChipPositionByIndex(uint32_t xIndex, uint32_t yIndex) const;
+	uint32_t GetNumBlockVirtical() const;
+	uint32_t GetNumBlockHorizontal() const;
 
-	IndexSet GetMapChipIndexSetByPosition(const KamataEngine::Vector3& position);
-	Rect GetRectByIndex(uint32_t xIndex, uint32_t yIndex);
+	IndexSet GetMapChipIndexSetByPosition(const KamataEngine::Vector3& position) const;
+	Rect GetRectByIndex(uint32_t xIndex, uint32_t yIndex) const;
 };
\ No newline at end of file
@@ -0,0 +1,128 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/// <summary>
+/// デストラクタ
+/// </summary>
+MappedFile::~MappedFile() { Close(); }
+
+#ifdef _WIN32
+
+/// <summary>
+/// ファイルを開いてマップする
+/// </summary>
+/// <param name="filePath"></param>
+/// <returns>成功したか</returns>
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+	HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER fileSize{};
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mapping) {
+		CloseHandle(file);
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!view) {
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	file_ = file;
+	mapping_ = mapping;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(fileSize.QuadPart);
+	return true;
+}
+
+/// <summary>
+/// マップを解除して閉じる
+/// </summary>
+void MappedFile::Close() {
+	if (data_) {
+		UnmapViewOfFile(data_);
+	}
+	if (mapping_) {
+		CloseHandle(mapping_);
+	}
+	if (file_) {
+		CloseHandle(file_);
+	}
+
+	data_ = nullptr;
+	size_ = 0;
+	mapping_ = nullptr;
+	file_ = nullptr;
+}
+
+#else
+
+/// <summary>
+/// ファイルを開いてマップする
+/// </summary>
+/// <param name="filePath"></param>
+/// <returns>成功したか</returns>
+bool MappedFile::Open(const std::string& filePath) {
+	Close();
+
+	int fd = open(filePath.c_str(), O_RDONLY);
+	if (fd < 0) {
+		return false;
+	}
+
+	struct stat fileStat {};
+	if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+		close(fd);
+		return false;
+	}
+
+	void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	if (view == MAP_FAILED) {
+		close(fd);
+		return false;
+	}
+
+	fd_ = fd;
+	data_ = static_cast<const uint8_t*>(view);
+	size_ = static_cast<size_t>(fileStat.st_size);
+	return true;
+}
+
+/// <summary>
+/// マップを解除して閉じる
+/// </summary>
+void MappedFile::Close() {
+	if (data_) {
+		munmap(const_cast<uint8_t*>(data_), size_);
+	}
+	if (fd_ >= 0) {
+		close(fd_);
+	}
+
+	data_ = nullptr;
+	size_ = 0;
+	fd_ = -1;
+}
+
+#endif
@@ -0,0 +1,98 @@
+#include "ModelRenderBackend.h"
+#include <cassert>
+
+using namespace KamataEngine;
+
+/// <summary>
+/// 初期化
+/// </summary>
+/// <param name="camera">カメラ</param>
+void ModelRenderBackend::Initialize(const Camera* camera) {
+	// NULLポインタチェック
+	assert(camera);
+
+	camera_ = camera;
+
+	models_.clear();
+	materials_.clear();
+	transforms_.clear();
+	staticTransformCount_ = 0;
+}
+
+/// <summary>
+/// 描画に使うカメラの差し替え
+/// </summary>
+/// <param name="camera"></param>
+void ModelRenderBackend::SetCamera(const Camera* camera) {
+	assert(camera);
+
+	camera_ = camera;
+}
+
+/// <summary>
+/// モデルの登録
+/// </summary>
+/// <param name="model"></param>
+/// <returns>モデルID</returns>
+uint32_t ModelRenderBackend::RegisterModel(Model* model) {
+	assert(model);
+
+	models_.push_back(model);
+	return static_cast<uint32_t>(models_.size() - 1);
+}
+
+/// <summary>
+/// マテリアル（色変更オブジェクト）の登録
+/// </summary>
+/// <param name="objectColor"></param>
+/// <returns>マテリアルID（1から）</returns>
+uint32_t ModelRenderBackend::RegisterMaterial(const ObjectColor* objectColor) {
+	assert(objectColor);
+
+	materials_.push_back(objectColor);
+	return static_cast<uint32_t>(materials_.size());
+}
+
+/// <summary>
+/// 毎フレーム変わらないトランスフォームを登録（ClearTransformsで消えない）
+/// </summary>
+/// <param name="worldTransform"></param>
+/// <returns>コマンドに渡すインデックス</returns>
+uint32_t ModelRenderBackend::AddStaticTransform(const WorldTransform& worldTransform) {
+	// 毎フレーム分より前に並べる必要がある
+	assert(transforms_.size() == staticTransformCount_);
+
+	transforms_.push_back(&worldTransform);
+	return staticTransformCount_++;
+}
+
+/// <summary>
+/// 毎フレーム分のトランスフォームを空にする
+/// </summary>
+void ModelRenderBackend::ClearTransforms() { transforms_.resize(staticTransformCount_); }
+
+/// <summary>
+/// トランスフォームをテーブルに追加
+/// </summary>
+/// <param name="worldTransform"></param>
+/// <returns>コマンドに渡すインデックス</returns>
+uint32_t ModelRenderBackend::AddTransform(const WorldTransform& worldTransform) {
+	transforms_.push_back(&worldTransform);
+	return static_cast<uint32_t>(transforms_.size() - 1);
+}
+
+void ModelRenderBackend::DrawBatch(const RenderBatch& batch, const RenderCommand* commands) {
+	assert(batch.modelId < models_.size());
+
+	Model* model = models_[batch.modelId];
+	const ObjectColor* objectColor = (batch.materialId == 0) ? nullptr : materials_[batch.materialId - 1];
+
+	// KamataEngine にはインスタンス描画が無いので、バッチ内は1個ずつ描く
+	for (uint32_t i = 0; i < batch.commandCount; ++i) {
+		const RenderCommand& command = commands[i];
+
+		for (uint32_t j = 0; j < command.instanceCount; ++j) {
+			model->Draw(*transforms_[command.transformIndex + j], *camera_, objectColor);
+		}
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include "KamataEngine.h"
+#include "RenderQueue.h"
+
+#include <vector>
+
+/// <summary>
+/// RenderQueue のバッチを KamataEngine の Model::Draw で描画するバックエンド
+/// </summary>
+class ModelRenderBackend : public RenderBackend {
+private:
+	// 登録済みモデル（添字がモデルID）
+	std::vector<KamataEngine::Model*> models_;
+	// 登録済みマテリアル（添字-1がマテリアルID、0はモデル既定）
+	std::vector<const KamataEngine::ObjectColor*> materials_;
+	// トランスフォームテーブル（先頭 staticTransformCount_ 個はロード時に固定）
+	std::vector<const KamataEngine::WorldTransform*> transforms_;
+	uint32_t staticTransformCount_ = 0;
+
+	// カメラ
+	const KamataEngine::Camera* camera_ = nullptr;
+
+public:
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="camera">カメラ</param>
+	void Initialize(const KamataEngine::Camera* camera);
+
+	/// <summary>
+	/// 描画に使うカメラの差し替え（RenderPipeline が組み立て時点のカメラを渡す）
+	/// </summary>
+	/// <param name="camera"></param>
+	void SetCamera(const KamataEngine::Camera* camera);
+
+	/// <summary>
+	/// モデルの登録
+	/// </summary>
+	/// <param name="model"></param>
+	/// <returns>モデルID</returns>
+	uint32_t RegisterModel(KamataEngine::Model* model);
+	/// <summary>
+	/// マテリアル（色変更オブジェクト）の登録
+	/// </summary>
+	/// <param name="objectColor"></param>
+	/// <returns>マテリアルID（1から）</returns>
+	uint32_t RegisterMaterial(const KamataEngine::ObjectColor* objectColor);
+
+	/// <summary>
+	/// 毎フレーム変わらないトランスフォームを登録（ClearTransformsで消えない）
+	/// </summary>
+	/// <param name="worldTransform"></param>
+	/// <returns>コマンドに渡すインデックス</returns>
+	uint32_t AddStaticTransform(const KamataEngine::WorldTransform& worldTransform);
+	/// <summary>
+	/// 毎フレーム分のトランスフォームを空にする
+	/// </summary>
+	void ClearTransforms();
+	/// <summary>
+	/// トランスフォームをテーブルに追加
+	/// </summary>
+	/// <param name="worldTransform"></param>
+	/// <returns>コマンドに渡すインデックス</returns>
+	uint32_t AddTransform(const KamataEngine::WorldTransform& worldTransform);
+
+	void DrawBatch(const RenderBatch& batch, const RenderCommand* commands) override;
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetStaticTransformCount() const { return staticTransformCount_; }
+};
@@ -0,0 +1,776 @@
+#define NOMINMAX
+#include "NavGraph.h"
+#include "FileUtility.h"
+#include "MapChipField.h"
+#include "MappedFile.h"
+#include "Player.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+
+using namespace KamataEngine;
+
+namespace {
+
+// Player は押している間ずっと加速するので、この助走フレーム数で出る速さを横の速さとする
+const float kRunUpFrames = 40.0f;
+// 軌道を試すときの体の半分の大きさ（角をかすめただけで失敗しないよう少し小さく）
+const float kBodyHalfSize = 0.45f;
+// 試す横の速さ（runSpeed に対する割合）
+const float kSpeedRatios[] = {0.5f, 1.0f};
+
+///===========================================
+/// キャッシュ
+///===========================================
+
+struct CacheHeader {
+	char magic[4];
+	uint32_t version;
+	uint64_t csvSize;
+	int64_t csvTime;
+	NavGraph::Physics physics;
+	uint32_t numBlockHorizontal;
+	uint32_t numBlockVirtical;
+	uint32_t surfaceCount;
+	uint32_t linkCount;
+	uint32_t landmarkCount;
+};
+
+const char kCacheMagic[4] = {'N', 'A', 'V', 'G'};
+const uint32_t kCacheVersion = 1;
+
+const float kInfinity = std::numeric_limits<float>::infinity();
+
+bool SamePhysics(const NavGraph::Physics& a, const NavGraph::Physics& b) {
+	return a.jumpSpeed == b.jumpSpeed && a.gravity == b.gravity && a.maxFallSpeed == b.maxFallSpeed && a.runSpeed == b.runSpeed && a.airJumpCount == b.airJumpCount;
+}
+
+///===========================================
+/// 軌道
+///===========================================
+
+// 着地点
+struct Landing {
+	uint32_t xIndex;
+	uint32_t row;
+	uint32_t frames;
+};
+
+/// <summary>
+/// 軌道を1フレームずつ進めて着地点を求める（座標は列・行。行は下が正）
+/// ブロックにめり込んだら失敗（壁ずり・天井での跳ね返りは使わない）
+/// </summary>
+bool SimulateArc(const MapChipField& field, float x, float y, float vx, float vy, int airJumpCount, const NavGraph::Physics& physics, Landing& out) {
+	const float width = static_cast<float>(field.GetNumBlockHorizontal());
+	const float height = static_cast<float>(field.GetNumBlockVirtical());
+
+	// 体が重なるタイルにブロックがあるか
+	auto overlapsBlock = [&](float cx, float cy) {
+		int32_t x0 = static_cast<int32_t>(std::floor(cx - kBodyHalfSize + 0.5f));
+		int32_t x1 = static_cast<int32_t>(std::floor(cx + kBodyHalfSize + 0.5f));
+		int32_t y0 = static_cast<int32_t>(std::floor(cy - kBodyHalfSize + 0.5f));
+		int32_t y1 = static_cast<int32_t>(std::floor(cy + kBodyHalfSize + 0.5f));
+		for (int32_t ty = y0; ty <= y1; ++ty) {
+			for (int32_t tx = x0; tx <= x1; ++tx) {
+				if (field.GetMapChipTypeByIndex(static_cast<uint32_t>(tx), static_cast<uint32_t>(ty)) == MapChipType::kBlock) {
+					return true;
+				}
+			}
+		}
+		return false;
+	};
+
+	for (uint32_t frame = 1; frame <= NavGraph::kMaxSimulationFrames; ++frame) {
+		// Player::UpdateMovementInput と同じ順：重力 → 落下速度制限 → 最高点で空中ジャンプ
+		vy -= physics.gravity;
+		vy = std::max(vy, -physics.maxFallSpeed);
+		if (airJumpCount > 0 && vy <= 0.0f) {
+			vy = physics.jumpSpeed;
+			--airJumpCount;
+		}
+
+		x += vx;
+		y -= vy;
+		if (x < 0.0f || x > width - 1.0f || y < 0.0f || y > height - 1.0f) {
+			return false;
+		}
+
+		if (!overlapsBlock(x, y)) {
+			continue;
+		}
+
+		// 落ちている途中で足元がブロックなら、その上に着地
+		if (vy < 0.0f) {
+			uint32_t column = static_cast<uint32_t>(std::floor(x + 0.5f));
+			uint32_t floorRow = static_cast<uint32_t>(std::floor(y + kBodyHalfSize + 0.5f));
+			if (floorRow >= 1 && field.GetMapChipTypeByIndex(column, floorRow) == MapChipType::kBlock) {
+				float landedY = static_cast<float>(floorRow - 1);
+				if (!overlapsBlock(x, landedY)) {
+					out = {column, floorRow - 1, frame};
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+	return false;
+}
+
+} // namespace
+
+/// <summary>
+/// Player の定数から物理定数を作る
+/// </summary>
+NavGraph::Physics NavGraph::MakePlayerPhysics() {
+	Physics physics;
+	physics.jumpSpeed = Player::GetJumpAcceleration();
+	physics.gravity = Player::GetGravityAcceleration();
+	physics.maxFallSpeed = Player::GetMaxFallSpeed();
+	physics.runSpeed = Player::GetAcceleration() * kRunUpFrames;
+	physics.airJumpCount = Player::GetMaxJumpCount();
+	return physics;
+}
+
+/// <summary>
+/// マップからグラフを作る
+/// </summary>
+void NavGraph::Build(const MapChipField& mapChipField, const Physics& physics) {
+	PROFILE_ZONE("NavGraph::Build");
+
+	Clear();
+
+	mapChipField_ = &mapChipField;
+	numBlockHorizontal_ = mapChipField.GetNumBlockHorizontal();
+	numBlockVirtical_ = mapChipField.GetNumBlockVirtical();
+	physics_ = physics;
+
+	auto isBlock = [&](uint32_t x, uint32_t y) { return mapChipField.GetMapChipTypeByIndex(x, y) == MapChipType::kBlock; };
+	auto isStandable = [&](uint32_t x, uint32_t y) { return y + 1 < numBlockVirtical_ && !isBlock(x, y) && isBlock(x, y + 1); };
+
+	///===========================================
+	/// 足場（立てるタイルの横並び。長いものは区切る）
+	///===========================================
+
+	for (uint32_t row = 0; row < numBlockVirtical_; ++row) {
+		for (uint32_t x = 0; x < numBlockHorizontal_;) {
+			if (!isStandable(x, row)) {
+				++x;
+				continue;
+			}
+			uint32_t left = x;
+			while (x < numBlockHorizontal_ && isStandable(x, row) && x - left < kMaxSurfaceLength) {
+				++x;
+			}
+			surfaces_.push_back({row, left, x - 1, 0, 0});
+		}
+	}
+
+	rowFirstSurface_.assign(numBlockVirtical_ + 1, 0);
+	for (const Surface& surface : surfaces_) {
+		++rowFirstSurface_[surface.row + 1];
+	}
+	for (uint32_t row = 0; row < numBlockVirtical_; ++row) {
+		rowFirstSurface_[row + 1] += rowFirstSurface_[row];
+	}
+
+	///===========================================
+	/// 辺
+	///===========================================
+
+	const float walkFramesPerTile = 1.0f / physics_.runSpeed;
+	std::vector<Link> candidates;
+
+	for (uint32_t from = 0; from < static_cast<uint32_t>(surfaces_.size()); ++from) {
+		Surface& surface = surfaces_[from];
+		candidates.clear();
+
+		// 区切った続きへの歩き
+		if (surface.right + 1 < numBlockHorizontal_) {
+			uint32_t next = SurfaceAt(surface.right + 1, surface.row);
+			if (next != kNoSurface) {
+				candidates.push_back({next, surface.right, surface.right + 1, walkFramesPerTile, LinkKind::kWalk});
+			}
+		}
+		if (surface.left > 0) {
+			uint32_t previous = SurfaceAt(surface.left - 1, surface.row);
+			if (previous != kNoSurface) {
+				candidates.push_back({previous, surface.left, surface.left - 1, walkFramesPerTile, LinkKind::kWalk});
+			}
+		}
+
+		for (float side : {-1.0f, 1.0f}) {
+			// 端から1歩出て落ちる
+			uint32_t edgeX = side < 0.0f ? surface.left : surface.right;
+			int64_t outX = static_cast<int64_t>(edgeX) + static_cast<int64_t>(side);
+			if (outX >= 0 && outX < static_cast<int64_t>(numBlockHorizontal_) && !isBlock(static_cast<uint32_t>(outX), surface.row)) {
+				for (float ratio : kSpeedRatios) {
+					Landing landing;
+					if (SimulateArc(mapChipField, static_cast<float>(outX), static_cast<float>(surface.row), side * physics_.runSpeed * ratio, 0.0f, 0, physics_, landing)) {
+						uint32_t to = SurfaceAt(landing.xIndex, landing.row);
+						if (to != kNoSurface && to != from) {
+							candidates.push_back({to, edgeX, landing.xIndex, walkFramesPerTile + static_cast<float>(landing.frames), LinkKind::kFall});
+						}
+					}
+				}
+			}
+
+			// 足場のどこからでも跳ぶ（空中ジャンプの回数・横の速さを変えて試す）
+			for (uint32_t x = surface.left; x <= surface.right; ++x) {
+				for (int airJumps = 0; airJumps <= physics_.airJumpCount; ++airJumps) {
+					for (float ratio : kSpeedRatios) {
+						Landing landing;
+						if (!SimulateArc(mapChipField, static_cast<float>(x), static_cast<float>(surface.row), side * physics_.runSpeed * ratio, physics_.jumpSpeed, airJumps, physics_, landing)) {
+							continue;
+						}
+						uint32_t to = SurfaceAt(landing.xIndex, landing.row);
+						if (to == kNoSurface || to == from) {
+							continue;
+						}
+						candidates.push_back({to, x, landing.xIndex, static_cast<float>(landing.frames) + kJumpPenalty * static_cast<float>(1 + airJumps), LinkKind::kJump});
+					}
+				}
+			}
+		}
+
+		// 行き先・種類・向きごとに一番早いものだけ残す
+		std::sort(candidates.begin(), candidates.end(), [](const Link& a, const Link& b) {
+			bool aRight = a.landingX >= a.takeoffX;
+			bool bRight = b.landingX >= b.takeoffX;
+			if (a.to != b.to) {
+				return a.to < b.to;
+			}
+			if (a.kind != b.kind) {
+				return a.kind < b.kind;
+			}
+			if (aRight != bRight) {
+				return aRight < bRight;
+			}
+			return a.cost < b.cost;
+		});
+
+		surface.linkBegin = static_cast<uint32_t>(links_.size());
+		for (size_t i = 0; i < candidates.size(); ++i) {
+			const Link& link = candidates[i];
+			if (i > 0) {
+				const Link& previous = candidates[i - 1];
+				if (previous.to == link.to && previous.kind == link.kind && (previous.landingX >= previous.takeoffX) == (link.landingX >= link.takeoffX)) {
+					continue;
+				}
+			}
+			links_.push_back(link);
+		}
+		surface.linkEnd = static_cast<uint32_t>(links_.size());
+	}
+
+	FinishBuild();
+	BuildLandmarks();
+}
+
+/// <summary>
+/// レベルの横のキャッシュ（.nav）を読む。無い・古いときは作って保存する
+/// </summary>
+bool NavGraph::LoadOrBuild(const std::string& csvPath, const MapChipField& mapChipField, const Physics& physics) {
+	std::string cachePath = GetCachePath(csvPath);
+	if (ReadCache(cachePath, csvPath, physics)) {
+		mapChipField_ = &mapChipField;
+		return true;
+	}
+
+	Build(mapChipField, physics);
+	WriteCache(cachePath, csvPath);
+	return false;
+}
+
+/// <summary>
+/// キャッシュに保存
+/// </summary>
+bool NavGraph::WriteCache(const std::string& cachePath, const std::string& csvPath) const {
+	FileUtility::Stamp stamp = FileUtility::GetStamp(csvPath);
+	if (stamp.size == 0) {
+		return false;
+	}
+
+	CacheHeader header = {};
+	std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+	header.version = kCacheVersion;
+	header.csvSize = stamp.size;
+	header.csvTime = stamp.time;
+	header.physics = physics_;
+	header.numBlockHorizontal = numBlockHorizontal_;
+	header.numBlockVirtical = numBlockVirtical_;
+	header.surfaceCount = static_cast<uint32_t>(surfaces_.size());
+	header.linkCount = static_cast<uint32_t>(links_.size());
+	header.landmarkCount = landmarkCount_;
+
+	return FileUtility::WriteAtomically(cachePath, [&](std::ofstream& file) {
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(surfaces_.data()), static_cast<std::streamsize>(surfaces_.size() * sizeof(Surface)));
+		file.write(reinterpret_cast<const char*>(links_.data()), static_cast<std::streamsize>(links_.size() * sizeof(Link)));
+		file.write(reinterpret_cast<const char*>(fromLandmark_.data()), static_cast<std::streamsize>(fromLandmark_.size() * sizeof(float)));
+		file.write(reinterpret_cast<const char*>(toLandmark_.data()), static_cast<std::streamsize>(toLandmark_.size() * sizeof(float)));
+	});
+}
+
+/// <summary>
+/// キャッシュから読む（マップ・物理定数と食い違えば失敗）
+/// </summary>
+bool NavGraph::ReadCache(const std::string& cachePath, const std::string& csvPath, const Physics& physics) {
+	MappedFile file;
+	if (!file.Open(cachePath) || file.GetSize() < sizeof(CacheHeader)) {
+		return false;
+	}
+
+	CacheHeader header;
+	std::memcpy(&header, file.GetData(), sizeof(header));
+	if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 || header.version != kCacheVersion || !SamePhysics(header.physics, physics)) {
+		return false;
+	}
+
+	// マップが更新されていたら使わない
+	FileUtility::Stamp stamp = FileUtility::GetStamp(csvPath);
+	if (stamp.size != header.csvSize || stamp.time != header.csvTime) {
+		return false;
+	}
+
+	size_t surfaceBytes = static_cast<size_t>(header.surfaceCount) * sizeof(Surface);
+	size_t linkBytes = static_cast<size_t>(header.linkCount) * sizeof(Link);
+	size_t landmarkBytes = static_cast<size_t>(header.landmarkCount) * header.linkCount * sizeof(float);
+	if (header.landmarkCount > kLandmarkCount || file.GetSize() != sizeof(CacheHeader) + surfaceBytes + linkBytes + landmarkBytes * 2) {
+		return false;
+	}
+
+	Clear();
+	numBlockHorizontal_ = header.numBlockHorizontal;
+	numBlockVirtical_ = header.numBlockVirtical;
+	physics_ = header.physics;
+
+	const uint8_t* cursor = file.GetData() + sizeof(CacheHeader);
+	surfaces_.resize(header.surfaceCount);
+	std::memcpy(surfaces_.data(), cursor, surfaceBytes);
+	cursor += surfaceBytes;
+	links_.resize(header.linkCount);
+	std::memcpy(links_.data(), cursor, linkBytes);
+	cursor += linkBytes;
+	landmarkCount_ = header.landmarkCount;
+	fromLandmark_.resize(landmarkBytes / sizeof(float));
+	std::memcpy(fromLandmark_.data(), cursor, landmarkBytes);
+	cursor += landmarkBytes;
+	toLandmark_.resize(landmarkBytes / sizeof(float));
+	std::memcpy(toLandmark_.data(), cursor, landmarkBytes);
+
+	// 壊れた値で範囲外を読まないよう確かめる
+	for (const Link& link : links_) {
+		if (link.to >= header.surfaceCount) {
+			Clear();
+			return false;
+		}
+	}
+
+	// 行ごとの索引は小さいので読み込み時に作る
+	rowFirstSurface_.assign(numBlockVirtical_ + 1, 0);
+	for (const Surface& surface : surfaces_) {
+		if (surface.row >= numBlockVirtical_ || surface.linkBegin > surface.linkEnd || surface.linkEnd > header.linkCount) {
+			Clear();
+			return false;
+		}
+		++rowFirstSurface_[surface.row + 1];
+	}
+	for (uint32_t row = 0; row < numBlockVirtical_; ++row) {
+		rowFirstSurface_[row + 1] += rowFirstSurface_[row];
+	}
+
+	FinishBuild();
+	return true;
+}
+
+/// <summary>
+/// A* で経路を探す
+/// </summary>
+bool NavGraph::FindPath(const Vector3& start, const Vector3& goal, std::vector<PathLink>& out, float* cost) {
+	out.clear();
+	lastExpandedCount_ = 0;
+
+	uint32_t startSurface = FindSurface(start);
+	uint32_t goalSurface = FindSurface(goal);
+	if (startSurface == kNoSurface || goalSurface == kNoSurface) {
+		return false;
+	}
+
+	MapChipField::IndexSet startIndex = mapChipField_->GetMapChipIndexSetByPosition(start);
+	MapChipField::IndexSet goalIndex = mapChipField_->GetMapChipIndexSetByPosition(goal);
+	const uint32_t startX = std::clamp(startIndex.xIndex, surfaces_[startSurface].left, surfaces_[startSurface].right);
+	const uint32_t goalX = std::clamp(goalIndex.xIndex, surfaces_[goalSurface].left, surfaces_[goalSurface].right);
+
+	const float walkFramesPerTile = 1.0f / physics_.runSpeed;
+	auto walkFrames = [&](uint32_t from, uint32_t to) { return static_cast<float>(from > to ? from - to : to - from) * walkFramesPerTile; };
+
+	///===========================================
+	/// 目印から見たゴール・出発点
+	///===========================================
+
+	// 目印からゴールまで・ゴールから目印までの最短コスト（ゴールの足場に入る辺・出る辺から求める）
+	float goalFrom[kLandmarkCount];
+	float goalTo[kLandmarkCount];
+	float startFrom[kLandmarkCount];
+	float startTo[kLandmarkCount];
+	auto fromSurface = [&](uint32_t surface, uint32_t x, float* result) {
+		std::fill(result, result + landmarkCount_, kInfinity);
+		for (uint32_t k = incomingBegin_[surface]; k < incomingBegin_[surface + 1]; ++k) {
+			uint32_t i = incomingLinks_[k];
+			const float* from = &fromLandmark_[i * landmarkCount_];
+			float walk = walkFrames(links_[i].landingX, x);
+			for (uint32_t l = 0; l < landmarkCount_; ++l) {
+				result[l] = std::min(result[l], from[l] + walk);
+			}
+		}
+	};
+	auto toSurface = [&](uint32_t surface, uint32_t x, float* result) {
+		std::fill(result, result + landmarkCount_, kInfinity);
+		for (uint32_t j = surfaces_[surface].linkBegin; j < surfaces_[surface].linkEnd; ++j) {
+			const float* to = &toLandmark_[j * landmarkCount_];
+			float walk = walkFrames(x, links_[j].takeoffX) + links_[j].cost;
+			for (uint32_t l = 0; l < landmarkCount_; ++l) {
+				result[l] = std::min(result[l], walk + to[l]);
+			}
+		}
+	};
+	fromSurface(goalSurface, goalX, goalFrom);
+	toSurface(goalSurface, goalX, goalTo);
+
+	// 目印を通した到達の矛盾で、届かない組は探さずに返す
+	// （出発点から目印に届かないのにゴールからは届く、目印から出発点に届くのにゴールには届かない）
+	if (startSurface != goalSurface) {
+		fromSurface(startSurface, startX, startFrom);
+		toSurface(startSurface, startX, startTo);
+		for (uint32_t l = 0; l < landmarkCount_; ++l) {
+			if ((startTo[l] == kInfinity && goalTo[l] < kInfinity) || (startFrom[l] < kInfinity && goalFrom[l] == kInfinity)) {
+				return false;
+			}
+		}
+	}
+
+	// 辺 link で着いた点からゴールまでの見積もり（横の距離 / runSpeed と、目印を使った三角不等式の大きい方）
+	// ゴールに届かないことが分かれば無限大
+	auto estimate = [&](uint32_t link) {
+		float h = walkFrames(links_[link].landingX, goalX);
+		const float* from = &fromLandmark_[link * landmarkCount_];
+		const float* to = &toLandmark_[link * landmarkCount_];
+		for (uint32_t l = 0; l < landmarkCount_; ++l) {
+			if (from[l] < kInfinity) {
+				if (goalFrom[l] == kInfinity) {
+					return kInfinity;
+				}
+				h = std::max(h, goalFrom[l] - from[l]);
+			}
+			if (to[l] < kInfinity) {
+				if (goalTo[l] < kInfinity) {
+					h = std::max(h, to[l] - goalTo[l]);
+				}
+			} else if (goalTo[l] < kInfinity) {
+				return kInfinity;
+			}
+		}
+		return h;
+	};
+
+	///===========================================
+	/// 探索
+	///===========================================
+
+	// f が同じなら g の大きい（ゴールに近い）方を先に
+	auto greater = [](const OpenEntry& a, const OpenEntry& b) { return a.f > b.f || (a.f == b.f && a.g < b.g); };
+
+	// 状態は足場（最初に着いた列で歩きの距離を測る）。末尾はゴールに着いた状態
+	const uint32_t goalState = static_cast<uint32_t>(surfaces_.size());
+
+	// 世代を進めて前回の結果を無効にする
+	if (++searchStamp_ == 0) {
+		std::fill(stamps_.begin(), stamps_.end(), 0);
+		searchStamp_ = 1;
+	}
+	open_.clear();
+
+	auto push = [&](uint32_t state, float g, float h, uint32_t via, uint32_t entryX) {
+		if (stamps_[state] == searchStamp_ && gScores_[state] <= g) {
+			return;
+		}
+		stamps_[state] = searchStamp_;
+		gScores_[state] = g;
+		parents_[state] = via;
+		entryX_[state] = entryX;
+		open_.push_back({g + h, g, state});
+		std::push_heap(open_.begin(), open_.end(), greater);
+	};
+
+	push(startSurface, 0.0f, walkFrames(startX, goalX), kNoSurface, startX);
+
+	while (!open_.empty()) {
+		std::pop_heap(open_.begin(), open_.end(), greater);
+		OpenEntry entry = open_.back();
+		open_.pop_back();
+
+		// 後からより近い経路が見つかった古い登録は飛ばす
+		const uint32_t state = entry.state;
+		const float g = gScores_[state];
+		if (entry.g > g) {
+			continue;
+		}
+
+		if (state == goalState) {
+			// 辺をたどって並べる
+			for (uint32_t surface = parents_[goalState]; parents_[surface] != kNoSurface;) {
+				const Link& link = links_[parents_[surface]];
+				uint32_t from = linkSources_[parents_[surface]];
+				out.push_back({TilePosition(link.takeoffX, surfaces_[from].row), TilePosition(link.landingX, surfaces_[link.to].row), link.kind});
+				surface = from;
+			}
+			std::reverse(out.begin(), out.end());
+			if (cost) {
+				*cost = g;
+			}
+			return true;
+		}
+
+		++lastExpandedCount_;
+
+		const uint32_t x = entryX_[state];
+		const Surface& surface = surfaces_[state];
+
+		if (state == goalSurface) {
+			push(goalState, g + walkFrames(x, goalX), 0.0f, state, goalX);
+		}
+
+		for (uint32_t i = surface.linkBegin; i < surface.linkEnd; ++i) {
+			const Link& link = links_[i];
+			float next = g + walkFrames(x, link.takeoffX) + link.cost;
+			// 既に同じかより近い経路があるなら見積もりを計算しない
+			if (stamps_[link.to] == searchStamp_ && gScores_[link.to] <= next) {
+				continue;
+			}
+			float h = estimate(i);
+			if (h == kInfinity) {
+				continue;
+			}
+			push(link.to, next, h, i, link.landingX);
+		}
+	}
+
+	return false;
+}
+
+/// <summary>
+/// 位置の足場（空中なら kGroundSearchDepth まで下を探す）
+/// </summary>
+uint32_t NavGraph::FindSurface(const Vector3& position) const {
+	if (!mapChipField_ || surfaces_.empty() || position.x < -0.5f || position.y < -0.5f) {
+		return kNoSurface;
+	}
+
+	MapChipField::IndexSet indexSet = mapChipField_->GetMapChipIndexSetByPosition(position);
+	if (indexSet.xIndex >= numBlockHorizontal_ || indexSet.yIndex >= numBlockVirtical_) {
+		return kNoSurface;
+	}
+
+	for (uint32_t depth = 0; depth <= kGroundSearchDepth && indexSet.yIndex + depth < numBlockVirtical_; ++depth) {
+		uint32_t surface = SurfaceAt(indexSet.xIndex, indexSet.yIndex + depth);
+		if (surface != kNoSurface) {
+			return surface;
+		}
+		if (mapChipField_->GetMapChipTypeByIndex(indexSet.xIndex, indexSet.yIndex + depth) == MapChipType::kBlock) {
+			break;
+		}
+	}
+	return kNoSurface;
+}
+
+/// <summary>
+/// 解放
+/// </summary>
+void NavGraph::Clear() {
+	mapChipField_ = nullptr;
+	numBlockHorizontal_ = 0;
+	numBlockVirtical_ = 0;
+	physics_ = {};
+
+	surfaces_.clear();
+	rowFirstSurface_.clear();
+	links_.clear();
+
+	linkSources_.clear();
+	incomingBegin_.clear();
+	incomingLinks_.clear();
+	landmarkCount_ = 0;
+	fromLandmark_.clear();
+	toLandmark_.clear();
+
+	gScores_.clear();
+	parents_.clear();
+	entryX_.clear();
+	stamps_.clear();
+	open_.clear();
+	searchStamp_ = 0;
+	lastExpandedCount_ = 0;
+}
+
+/// <summary>
+/// キャッシュの場所（CSV と同じ場所・名前で拡張子だけ .nav）
+/// </summary>
+std::string NavGraph::GetCachePath(const std::string& csvPath) { return std::filesystem::path(csvPath).replace_extension(".nav").string(); }
+
+/// <summary>
+/// 列・行から足場（無ければ kNoSurface）
+/// </summary>
+uint32_t NavGraph::SurfaceAt(uint32_t xIndex, uint32_t row) const {
+	if (row >= numBlockVirtical_) {
+		return kNoSurface;
+	}
+
+	// 行の中は左端の順に並んでいるので二分探索
+	std::vector<Surface>::const_iterator first = surfaces_.begin() + rowFirstSurface_[row];
+	std::vector<Surface>::const_iterator last = surfaces_.begin() + rowFirstSurface_[row + 1];
+	std::vector<Surface>::const_iterator found = std::upper_bound(first, last, xIndex, [](uint32_t x, const Surface& surface) { return x < surface.left; });
+	if (found == first) {
+		return kNoSurface;
+	}
+	--found;
+	return xIndex <= found->right ? static_cast<uint32_t>(found - surfaces_.begin()) : kNoSurface;
+}
+
+/// <summary>
+/// 探索の作業領域を作り直す
+/// </summary>
+void NavGraph::FinishBuild() {
+	// 辺の出発元（経路を組み立てるときに使う）
+	linkSources_.resize(links_.size());
+	for (uint32_t surface = 0; surface < static_cast<uint32_t>(surfaces_.size()); ++surface) {
+		std::fill(linkSources_.begin() + surfaces_[surface].linkBegin, linkSources_.begin() + surfaces_[surface].linkEnd, surface);
+	}
+
+	// 足場ごとの入ってくる辺
+	incomingBegin_.assign(surfaces_.size() + 1, 0);
+	for (const Link& link : links_) {
+		++incomingBegin_[link.to + 1];
+	}
+	for (size_t surface = 0; surface < surfaces_.size(); ++surface) {
+		incomingBegin_[surface + 1] += incomingBegin_[surface];
+	}
+	incomingLinks_.resize(links_.size());
+	std::vector<uint32_t> cursor(incomingBegin_.begin(), incomingBegin_.end() - 1);
+	for (uint32_t i = 0; i < static_cast<uint32_t>(links_.size()); ++i) {
+		incomingLinks_[cursor[links_[i].to]++] = i;
+	}
+
+	size_t stateCount = surfaces_.size() + 1;
+	gScores_.assign(stateCount, 0.0f);
+	parents_.assign(stateCount, 0);
+	entryX_.assign(stateCount, 0);
+	stamps_.assign(stateCount, 0);
+	open_.reserve(links_.size() + 1);
+	searchStamp_ = 0;
+}
+
+/// <summary>
+/// 目印を選んで、目印からの・目印までの最短コストを求める
+/// </summary>
+void NavGraph::BuildLandmarks() {
+	PROFILE_ZONE("NavGraph::BuildLandmarks");
+
+	const size_t linkCount = links_.size();
+	landmarkCount_ = static_cast<uint32_t>(std::min<size_t>(kLandmarkCount, linkCount));
+	fromLandmark_.assign(landmarkCount_ * linkCount, kInfinity);
+	toLandmark_.assign(landmarkCount_ * linkCount, kInfinity);
+	if (landmarkCount_ == 0) {
+		return;
+	}
+
+	// 最初は一番左の到着点。以降は今ある目印から一番遠い到着点を選ぶ（遠い目印ほど見積もりがよくなる）
+	uint32_t landmark = 0;
+	for (uint32_t i = 1; i < static_cast<uint32_t>(linkCount); ++i) {
+		if (links_[i].landingX < links_[landmark].landingX) {
+			landmark = i;
+		}
+	}
+
+	std::vector<float> from(linkCount);
+	std::vector<float> to(linkCount);
+	std::vector<float> nearest(linkCount, kInfinity);
+	for (uint32_t l = 0; l < landmarkCount_; ++l) {
+		ComputeLinkDistances(landmark, false, from.data());
+		ComputeLinkDistances(landmark, true, to.data());
+
+		// 探索で1つの到着点の値をまとめて読めるよう、到着点ごとに目印の値を並べる
+		float farthest = -1.0f;
+		for (uint32_t i = 0; i < static_cast<uint32_t>(linkCount); ++i) {
+			fromLandmark_[i * landmarkCount_ + l] = from[i];
+			toLandmark_[i * landmarkCount_ + l] = to[i];
+
+			// 行き来できない点は遠さを測れないので、届く向きの分だけで比べる
+			float distance = (from[i] < kInfinity ? from[i] : 0.0f) + (to[i] < kInfinity ? to[i] : 0.0f);
+			nearest[i] = std::min(nearest[i], distance);
+			if (nearest[i] > farthest) {
+				farthest = nearest[i];
+				landmark = i;
+			}
+		}
+	}
+}
+
+/// <summary>
+/// 辺の到着点どうしの最短コスト（reverse なら各点から target まで、そうでなければ target から各点まで）
+/// </summary>
+void NavGraph::ComputeLinkDistances(uint32_t target, bool reverse, float* distances) {
+	const float walkFramesPerTile = 1.0f / physics_.runSpeed;
+	auto greater = [](const OpenEntry& a, const OpenEntry& b) { return a.f > b.f; };
+
+	std::fill(distances, distances + links_.size(), kInfinity);
+	distances[target] = 0.0f;
+	open_.clear();
+	open_.push_back({0.0f, 0.0f, target});
+
+	while (!open_.empty()) {
+		std::pop_heap(open_.begin(), open_.end(), greater);
+		OpenEntry entry = open_.back();
+		open_.pop_back();
+		if (entry.f > distances[entry.state]) {
+			continue;
+		}
+
+		if (!reverse) {
+			// 着いた足場から出る辺へ（足場の上を歩いてから辺をたどる）
+			const Link& arrival = links_[entry.state];
+			const Surface& surface = surfaces_[arrival.to];
+			for (uint32_t next = surface.linkBegin; next < surface.linkEnd; ++next) {
+				const Link& link = links_[next];
+				float distance = entry.f + std::abs(static_cast<float>(link.takeoffX) - static_cast<float>(arrival.landingX)) * walkFramesPerTile + link.cost;
+				if (distance < distances[next]) {
+					distances[next] = distance;
+					open_.push_back({distance, 0.0f, next});
+					std::push_heap(open_.begin(), open_.end(), greater);
+				}
+			}
+		} else {
+			// この辺の出発元の足場に入ってくる辺から
+			const Link& departure = links_[entry.state];
+			uint32_t source = linkSources_[entry.state];
+			for (uint32_t k = incomingBegin_[source]; k < incomingBegin_[source + 1]; ++k) {
+				uint32_t previous = incomingLinks_[k];
+				float distance = entry.f + std::abs(static_cast<float>(departure.takeoffX) - static_cast<float>(links_[previous].landingX)) * walkFramesPerTile + departure.cost;
+				if (distance < distances[previous]) {
+					distances[previous] = distance;
+					open_.push_back({distance, 0.0f, previous});
+					std::push_heap(open_.begin(), open_.end(), greater);
+				}
+			}
+		}
+	}
+}
+
+/// <summary>
+/// 列・行のワールド座標
+/// </summary>
+Vector3 NavGraph::TilePosition(uint32_t xIndex, uint32_t row) const { return mapChipField_->GetMapChipPositionByIndex(xIndex, row); }
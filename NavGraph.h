@@ -0,0 +1,192 @@
+#pragma once
+#include "KamataEngine.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class MapChipField;
+
+/// <summary>
+/// 足場（立てるタイルの横並び）をノード、歩き・落下・ジャンプを辺にした移動グラフ
+/// ジャンプと落下は物理定数で軌道を1フレームずつ試して確かめる。結果はレベルの横に保存して次回から読むだけにする
+/// </summary>
+class NavGraph {
+public:
+	// 辺の種類
+	enum class LinkKind : uint8_t {
+		kWalk, // 隣の足場へ歩く（長い足場を区切った続き）
+		kFall, // 端から落ちる
+		kJump, // 跳ぶ（空中ジャンプを含む）
+	};
+
+	// 軌道を試すのに使う物理定数（1フレームあたり、ブロックの大きさを1とする）
+	struct Physics {
+		float jumpSpeed;    // ジャンプの初速度
+		float gravity;      // 重力加速度
+		float maxFallSpeed; // 最大落下速度
+		float runSpeed;     // 横の速さ
+		int airJumpCount;   // 空中で追加できるジャンプの回数
+	};
+
+	// 足場（row の行の left～right 列。辺は links_ の linkBegin～linkEnd）
+	struct Surface {
+		uint32_t row;
+		uint32_t left;
+		uint32_t right;
+		uint32_t linkBegin;
+		uint32_t linkEnd;
+	};
+
+	// 辺（takeoffX 列から出て、to の landingX 列に着く。cost はかかるフレーム数）
+	struct Link {
+		uint32_t to;
+		uint32_t takeoffX;
+		uint32_t landingX;
+		float cost;
+		LinkKind kind;
+	};
+
+	// 経路の1区間
+	struct PathLink {
+		KamataEngine::Vector3 takeoff; // 出る位置
+		KamataEngine::Vector3 landing; // 着く位置
+		LinkKind kind;
+	};
+
+	// 長い足場はこの長さで区切る（ノードを局所的にして、経路の歩き距離を正確にする）
+	static inline const uint32_t kMaxSurfaceLength = 16;
+	// 軌道を試す最大フレーム数
+	static inline const uint32_t kMaxSimulationFrames = 600;
+	// ジャンプ1回に上乗せするコスト（同じ時間なら歩きを選ぶ）
+	static inline const float kJumpPenalty = 6.0f;
+	// 空中にいるときに足場を探す深さ（ブロック数）
+	static inline const uint32_t kGroundSearchDepth = 4;
+	// 足場の無い場所
+	static inline const uint32_t kNoSurface = UINT32_MAX;
+	// 見積もりに使う目印の数（目印からの・目印までの最短コストを持っておき、三角不等式で残りを見積もる）
+	static inline const uint32_t kLandmarkCount = 8;
+
+private:
+	const MapChipField* mapChipField_ = nullptr;
+	uint32_t numBlockHorizontal_ = 0;
+	uint32_t numBlockVirtical_ = 0;
+	Physics physics_ = {};
+
+	// 足場（行→左端の順）と、行ごとの最初の足場
+	std::vector<Surface> surfaces_;
+	std::vector<uint32_t> rowFirstSurface_;
+	std::vector<Link> links_;
+
+	// 辺の出発元の足場と、足場ごとの入ってくる辺
+	std::vector<uint32_t> linkSources_;
+	std::vector<uint32_t> incomingBegin_;
+	std::vector<uint32_t> incomingLinks_;
+
+	// 目印（辺の到着点）からの最短コストと、目印までの最短コスト（[目印 * 辺の数 + 辺]。届かなければ無限大）
+	uint32_t landmarkCount_ = 0;
+	std::vector<float> fromLandmark_;
+	std::vector<float> toLandmark_;
+
+	// 探索の作業領域（状態は足場。末尾はゴール）
+	struct OpenEntry {
+		float f;
+		float g;
+		uint32_t state;
+	};
+	std::vector<float> gScores_;
+	std::vector<uint32_t> parents_; // 着いた辺（ゴールは最後の足場）
+	std::vector<uint32_t> entryX_;  // 着いた列
+	std::vector<uint32_t> stamps_;
+	std::vector<OpenEntry> open_;
+	uint32_t searchStamp_ = 0;
+
+	// 統計
+	uint32_t lastExpandedCount_ = 0;
+
+public:
+	/// <summary>
+	/// Player の定数から物理定数を作る
+	/// </summary>
+	/// <returns></returns>
+	static Physics MakePlayerPhysics();
+
+	/// <summary>
+	/// マップからグラフを作る（足場を探し、辺を軌道で確かめる）
+	/// </summary>
+	/// <param name="mapChipField"></param>
+	/// <param name="physics"></param>
+	void Build(const MapChipField& mapChipField, const Physics& physics);
+
+	/// <summary>
+	/// レベルの横のキャッシュ（.nav）を読む。無い・古いときは作って保存する
+	/// </summary>
+	/// <param name="csvPath">マップの CSV</param>
+	/// <param name="mapChipField">読み込み済みのマップ</param>
+	/// <param name="physics"></param>
+	/// <returns>キャッシュを読めたら true</returns>
+	bool LoadOrBuild(const std::string& csvPath, const MapChipField& mapChipField, const Physics& physics);
+
+	/// <summary>
+	/// キャッシュに保存・キャッシュから読む
+	/// </summary>
+	bool WriteCache(const std::string& cachePath, const std::string& csvPath) const;
+	bool ReadCache(const std::string& cachePath, const std::string& csvPath, const Physics& physics);
+
+	/// <summary>
+	/// A* で経路を探す（作業領域を持つので同じインスタンスで同時に呼ばない）
+	/// </summary>
+	/// <param name="start"></param>
+	/// <param name="goal"></param>
+	/// <param name="out">辺の並び（最後の辺の着地点からゴールまでは歩く）</param>
+	/// <param name="cost">かかるフレーム数</param>
+	/// <returns>経路があれば true</returns>
+	bool FindPath(const KamataEngine::Vector3& start, const KamataEngine::Vector3& goal, std::vector<PathLink>& out, float* cost = nullptr);
+
+	/// <summary>
+	/// 位置の足場（空中なら kGroundSearchDepth まで下を探す）
+	/// </summary>
+	/// <param name="position"></param>
+	/// <returns></returns>
+	uint32_t FindSurface(const KamataEngine::Vector3& position) const;
+
+	/// <summary>
+	/// 解放
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<Surface>& GetSurfaces() const { return surfaces_; }
+	const std::vector<Link>& GetLinks() const { return links_; }
+	uint32_t GetLastExpandedCount() const { return lastExpandedCount_; }
+	static std::string GetCachePath(const std::string& csvPath);
+
+private:
+	/// <summary>
+	/// 列・行から足場（無ければ kNoSurface）
+	/// </summary>
+	uint32_t SurfaceAt(uint32_t xIndex, uint32_t row) const;
+
+	/// <summary>
+	/// 辺の逆引きと探索の作業領域を作り直す
+	/// </summary>
+	void FinishBuild();
+
+	/// <summary>
+	/// 目印を選んで、目印からの・目印までの最短コストを求める
+	/// </summary>
+	void BuildLandmarks();
+
+	/// <summary>
+	/// 辺の到着点どうしの最短コスト（reverse なら各点から target まで、そうでなければ target から各点まで）
+	/// </summary>
+	void ComputeLinkDistances(uint32_t target, bool reverse, float* distances);
+
+	/// <summary>
+	/// 列・行のワールド座標
+	/// </summary>
+	KamataEngine::Vector3 TilePosition(uint32_t xIndex, uint32_t row) const;
+};
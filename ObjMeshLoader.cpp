@@ -0,0 +1,439 @@
+#include "ObjMeshLoader.h"
+#include "FileUtility.h"
+#include "MappedFile.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+namespace {
+
+// キャッシュの先頭
+struct CacheHeader {
+	char magic[4];
+	uint32_t version;
+	uint64_t objSize;
+	int64_t objTime;
+	uint64_t mtlSize;
+	int64_t mtlTime;
+	uint32_t vertexCount;
+	uint32_t indexCount;
+	uint32_t materialNameLength;
+	uint32_t textureNameLength;
+};
+
+const char kCacheMagic[4] = {'M', 'S', 'H', 'B'};
+
+/// <summary>
+/// ファイル全体を読む
+/// </summary>
+bool ReadFile(const std::string& path, std::string& out) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		return false;
+	}
+	file.seekg(0, std::ios::end);
+	out.resize(static_cast<size_t>(file.tellg()));
+	file.seekg(0, std::ios::beg);
+	file.read(out.data(), static_cast<std::streamsize>(out.size()));
+	return file.good() || file.eof();
+}
+
+/// <summary>
+/// 1行ずつ取り出す（改行コードは含まない）
+/// </summary>
+bool NextLine(std::string_view& text, std::string_view& line) {
+	if (text.empty()) {
+		return false;
+	}
+	size_t end = text.find('\n');
+	line = text.substr(0, end);
+	text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+	if (!line.empty() && line.back() == '\r') {
+		line.remove_suffix(1);
+	}
+	return true;
+}
+
+/// <summary>
+/// 空白区切りのトークンを取り出す
+/// </summary>
+std::string_view NextToken(std::string_view& line) {
+	size_t begin = line.find_first_not_of(" \t");
+	if (begin == std::string_view::npos) {
+		line = {};
+		return {};
+	}
+	line.remove_prefix(begin);
+	size_t end = line.find_first_of(" \t");
+	std::string_view token = line.substr(0, end);
+	line.remove_prefix(end == std::string_view::npos ? line.size() : end);
+	return token;
+}
+
+/// <summary>
+/// 行の残り（前後の空白を除く）
+/// </summary>
+std::string_view Rest(std::string_view line) {
+	size_t begin = line.find_first_not_of(" \t");
+	if (begin == std::string_view::npos) {
+		return {};
+	}
+	size_t end = line.find_last_not_of(" \t");
+	return line.substr(begin, end - begin + 1);
+}
+
+float ParseFloat(std::string_view token) {
+	float value = 0.0f;
+	std::from_chars(token.data(), token.data() + token.size(), value);
+	return value;
+}
+
+int32_t ParseInt(std::string_view token) {
+	int32_t value = 0;
+	std::from_chars(token.data(), token.data() + token.size(), value);
+	return value;
+}
+
+// 面の頂点（v/vt/vn の添字、0始まり、無ければ-1）
+struct FaceIndex {
+	int32_t position;
+	int32_t texcoord;
+	int32_t normal;
+
+	bool operator==(const FaceIndex& other) const { return position == other.position && texcoord == other.texcoord && normal == other.normal; }
+};
+
+struct FaceIndexHash {
+	size_t operator()(const FaceIndex& index) const {
+		uint64_t hash = static_cast<uint32_t>(index.position);
+		hash = hash * 0x9E3779B97F4A7C15ull + static_cast<uint32_t>(index.texcoord);
+		hash = hash * 0x9E3779B97F4A7C15ull + static_cast<uint32_t>(index.normal);
+		return static_cast<size_t>(hash ^ (hash >> 32));
+	}
+};
+
+/// <summary>
+/// 1始まり/負数の添字を0始まりにする（無ければ-1）
+/// </summary>
+int32_t ResolveIndex(std::string_view token, size_t count) {
+	if (token.empty()) {
+		return -1;
+	}
+	int32_t index = ParseInt(token);
+	if (index < 0) {
+		index += static_cast<int32_t>(count);
+	} else {
+		index -= 1;
+	}
+	return (index >= 0 && index < static_cast<int32_t>(count)) ? index : -1;
+}
+
+/// <summary>
+/// MTLから map_Kd を探す
+/// </summary>
+std::string FindTextureFileName(const std::string& mtlPath) {
+	std::string text;
+	if (!ReadFile(mtlPath, text)) {
+		return {};
+	}
+
+	std::string_view rest = text;
+	std::string_view line;
+	while (NextLine(rest, line)) {
+		std::string_view token = NextToken(line);
+		if (token == "map_Kd") {
+			return std::string(Rest(line));
+		}
+	}
+	return {};
+}
+
+} // namespace
+
+/// <summary>
+/// OBJ/MTLのテキスト解析（エンジンのローダーと同じく x 反転・v 反転・巻き順反転）
+/// </summary>
+/// <param name="objPath"></param>
+/// <param name="out"></param>
+/// <returns>成功したか</returns>
+bool ObjMeshLoader::ParseObj(const std::string& objPath, MeshData& out) {
+	PROFILE_ZONE("ObjMeshLoader::ParseObj");
+
+	out = MeshData{};
+
+	std::string text;
+	if (!ReadFile(objPath, text)) {
+		return false;
+	}
+
+	std::vector<float> positions;
+	std::vector<float> normals;
+	std::vector<float> texcoords;
+	std::unordered_map<FaceIndex, uint32_t, FaceIndexHash> vertexTable;
+	std::vector<uint32_t> polygon;
+
+	std::string_view rest = text;
+	std::string_view line;
+	while (NextLine(rest, line)) {
+		std::string_view identifier = NextToken(line);
+
+		if (identifier == "v") {
+			for (int i = 0; i < 3; ++i) {
+				positions.push_back(ParseFloat(NextToken(line)));
+			}
+		} else if (identifier == "vn") {
+			for (int i = 0; i < 3; ++i) {
+				normals.push_back(ParseFloat(NextToken(line)));
+			}
+		} else if (identifier == "vt") {
+			for (int i = 0; i < 2; ++i) {
+				texcoords.push_back(ParseFloat(NextToken(line)));
+			}
+		} else if (identifier == "f") {
+			polygon.clear();
+
+			for (std::string_view token = NextToken(line); !token.empty(); token = NextToken(line)) {
+				// v, v/vt, v//vn, v/vt/vn
+				std::string_view parts[3];
+				for (int i = 0; i < 3; ++i) {
+					size_t slash = token.find('/');
+					parts[i] = token.substr(0, slash);
+					if (slash == std::string_view::npos) {
+						break;
+					}
+					token.remove_prefix(slash + 1);
+				}
+
+				FaceIndex faceIndex{
+				    ResolveIndex(parts[0], positions.size() / 3),
+				    ResolveIndex(parts[1], texcoords.size() / 2),
+				    ResolveIndex(parts[2], normals.size() / 3),
+				};
+				if (faceIndex.position < 0) {
+					return false;
+				}
+
+				// 同じ組み合わせの頂点は共有する
+				auto [it, inserted] = vertexTable.try_emplace(faceIndex, static_cast<uint32_t>(out.vertices.size()));
+				if (inserted) {
+					MeshVertex vertex{};
+					const float* position = &positions[static_cast<size_t>(faceIndex.position) * 3];
+					vertex.position[0] = -position[0];
+					vertex.position[1] = position[1];
+					vertex.position[2] = position[2];
+					if (faceIndex.normal >= 0) {
+						const float* normal = &normals[static_cast<size_t>(faceIndex.normal) * 3];
+						vertex.normal[0] = -normal[0];
+						vertex.normal[1] = normal[1];
+						vertex.normal[2] = normal[2];
+					}
+					if (faceIndex.texcoord >= 0) {
+						const float* texcoord = &texcoords[static_cast<size_t>(faceIndex.texcoord) * 2];
+						vertex.uv[0] = texcoord[0];
+						vertex.uv[1] = 1.0f - texcoord[1];
+					}
+					out.vertices.push_back(vertex);
+				}
+				polygon.push_back(it->second);
+			}
+
+			// 扇状に三角形へ分割（x を反転したので巻き順も逆にする）
+			for (size_t i = 2; i < polygon.size(); ++i) {
+				out.indices.push_back(polygon[0]);
+				out.indices.push_back(polygon[i]);
+				out.indices.push_back(polygon[i - 1]);
+			}
+		} else if (identifier == "mtllib") {
+			out.materialFileName = std::string(Rest(line));
+		}
+	}
+
+	if (!out.materialFileName.empty()) {
+		std::filesystem::path mtlPath = std::filesystem::path(objPath).parent_path() / out.materialFileName;
+		out.textureFileName = FindTextureFileName(mtlPath.string());
+	}
+
+	return true;
+}
+
+/// <summary>
+/// バイナリキャッシュを書き出す
+/// </summary>
+/// <param name="cachePath"></param>
+/// <param name="objPath">元ファイル（更新時刻とサイズを記録）</param>
+/// <param name="mesh"></param>
+/// <returns>成功したか</returns>
+bool ObjMeshLoader::WriteCache(const std::string& cachePath, const std::string& objPath, const MeshData& mesh) {
+	std::filesystem::path objFilePath(objPath);
+	FileUtility::Stamp objStamp = FileUtility::GetStamp(objFilePath.string());
+	FileUtility::Stamp mtlStamp;
+	if (!mesh.materialFileName.empty()) {
+		mtlStamp = FileUtility::GetStamp((objFilePath.parent_path() / mesh.materialFileName).string());
+	}
+
+	CacheHeader header{};
+	std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+	header.version = kCacheVersion;
+	header.objSize = objStamp.size;
+	header.objTime = objStamp.time;
+	header.mtlSize = mtlStamp.size;
+	header.mtlTime = mtlStamp.time;
+	header.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+	header.indexCount = static_cast<uint32_t>(mesh.indices.size());
+	header.materialNameLength = static_cast<uint32_t>(mesh.materialFileName.size());
+	header.textureNameLength = static_cast<uint32_t>(mesh.textureFileName.size());
+
+	return FileUtility::WriteAtomically(cachePath, [&](std::ofstream& file) {
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		file.write(reinterpret_cast<const char*>(mesh.vertices.data()), static_cast<std::streamsize>(mesh.vertices.size() * sizeof(MeshVertex)));
+		file.write(reinterpret_cast<const char*>(mesh.indices.data()), static_cast<std::streamsize>(mesh.indices.size() * sizeof(uint32_t)));
+		file.write(mesh.materialFileName.data(), static_cast<std::streamsize>(mesh.materialFileName.size()));
+		file.write(mesh.textureFileName.data(), static_cast<std::streamsize>(mesh.textureFileName.size()));
+	});
+}
+
+/// <summary>
+/// バイナリキャッシュをマップして読む（元ファイルと食い違えば失敗）
+/// </summary>
+/// <param name="cachePath"></param>
+/// <param name="objPath"></param>
+/// <param name="out"></param>
+/// <returns>成功したか</returns>
+bool ObjMeshLoader::ReadCache(const std::string& cachePath, const std::string& objPath, MeshData& out) {
+	MappedFile file;
+	if (!file.Open(cachePath) || file.GetSize() < sizeof(CacheHeader)) {
+		return false;
+	}
+
+	CacheHeader header;
+	std::memcpy(&header, file.GetData(), sizeof(header));
+	if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0 || header.version != kCacheVersion) {
+		return false;
+	}
+
+	// 元ファイルが更新されていたら使わない
+	std::filesystem::path objFilePath(objPath);
+	FileUtility::Stamp objStamp = FileUtility::GetStamp(objFilePath.string());
+	if (objStamp.size != header.objSize || objStamp.time != header.objTime) {
+		return false;
+	}
+
+	size_t vertexBytes = static_cast<size_t>(header.vertexCount) * sizeof(MeshVertex);
+	size_t indexBytes = static_cast<size_t>(header.indexCount) * sizeof(uint32_t);
+	size_t expectedSize = sizeof(CacheHeader) + vertexBytes + indexBytes + header.materialNameLength + header.textureNameLength;
+	if (file.GetSize() != expectedSize) {
+		return false;
+	}
+
+	const uint8_t* cursor = file.GetData() + sizeof(CacheHeader);
+
+	std::string materialFileName(reinterpret_cast<const char*>(cursor + vertexBytes + indexBytes), header.materialNameLength);
+	if (!materialFileName.empty()) {
+		FileUtility::Stamp mtlStamp = FileUtility::GetStamp((objFilePath.parent_path() / materialFileName).string());
+		if (mtlStamp.size != header.mtlSize || mtlStamp.time != header.mtlTime) {
+			return false;
+		}
+	}
+
+	out.vertices.resize(header.vertexCount);
+	std::memcpy(out.vertices.data(), cursor, vertexBytes);
+	cursor += vertexBytes;
+
+	out.indices.resize(header.indexCount);
+	std::memcpy(out.indices.data(), cursor, indexBytes);
+	cursor += indexBytes + header.materialNameLength;
+
+	// 壊れた値で頂点の範囲外を読まないよう確かめる
+	for (uint32_t index : out.indices) {
+		if (index >= header.vertexCount) {
+			out.vertices.clear();
+			out.indices.clear();
+			return false;
+		}
+	}
+
+	out.materialFileName = std::move(materialFileName);
+	out.textureFileName.assign(reinterpret_cast<const char*>(cursor), header.textureNameLength);
+
+	return true;
+}
+
+/// <summary>
+/// 1アセットの読み込み（キャッシュが古ければ解析し直して書き直す）
+/// </summary>
+/// <param name="directory">Resources</param>
+/// <param name="name">モデル名</param>
+/// <param name="options"></param>
+/// <returns></returns>
+ObjMeshLoader::Result ObjMeshLoader::Load(const std::string& directory, const std::string& name, const Options& options) {
+	PROFILE_ZONE("ObjMeshLoader::Load");
+
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	Result result;
+	result.name = name;
+
+	std::string basePath = directory + "/" + name + "/" + name;
+	std::string objPath = basePath + ".obj";
+	std::string cachePath = basePath + kCacheExtension;
+
+	if (options.useCache && ReadCache(cachePath, objPath, result.mesh)) {
+		result.succeeded = true;
+		result.fromCache = true;
+	} else {
+		result.succeeded = ParseObj(objPath, result.mesh);
+		if (result.succeeded && options.useCache) {
+			WriteCache(cachePath, objPath, result.mesh);
+		}
+	}
+
+	result.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	return result;
+}
+
+/// <summary>
+/// 複数アセットを並列に読み込む（結果は names と同じ並び）
+/// </summary>
+/// <param name="directory">Resources</param>
+/// <param name="names">モデル名</param>
+/// <param name="options"></param>
+/// <returns></returns>
+std::vector<ObjMeshLoader::Result> ObjMeshLoader::LoadAll(const std::string& directory, const std::vector<std::string>& names, const Options& options) {
+	std::vector<Result> results(names.size());
+
+	uint32_t threadCount = options.threadCount != 0 ? options.threadCount : std::max(1u, std::thread::hardware_concurrency());
+	threadCount = std::min(threadCount, static_cast<uint32_t>(names.size()));
+
+	// 各スレッドが次のアセットを取りに行く
+	std::atomic<size_t> next = 0;
+	auto worker = [&]() {
+		for (size_t i = next.fetch_add(1); i < names.size(); i = next.fetch_add(1)) {
+			results[i] = Load(directory, names[i], options);
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(threadCount);
+	for (uint32_t i = 1; i < threadCount; ++i) {
+		threads.emplace_back([&worker]() {
+			PROFILE_THREAD_NAME("ObjMeshLoader");
+			worker();
+		});
+	}
+	// 呼び出し元のスレッドも働く
+	worker();
+
+	for (std::thread& thread : threads) {
+		thread.join();
+	}
+
+	return results;
+}
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 頂点（座標・法線・UV）
+/// </summary>
+struct MeshVertex {
+	float position[3];
+	float normal[3];
+	float uv[2];
+};
+static_assert(sizeof(MeshVertex) == 32, "MeshVertex はキャッシュにそのまま書き出す前提");
+
+/// <summary>
+/// CPU側のメッシュデータ
+/// </summary>
+struct MeshData {
+	std::vector<MeshVertex> vertices;
+	std::vector<uint32_t> indices;
+	std::string materialFileName; // mtllib（無ければ空）
+	std::string textureFileName;  // map_Kd（無ければ空）
+};
+
+/// <summary>
+/// Resources/name/name.obj を読み込む（テキスト解析はスレッドプールで並列、2回目以降はバイナリキャッシュをマップ）
+/// </summary>
+class ObjMeshLoader {
+public:
+	// バイナリキャッシュの拡張子
+	static inline const char* const kCacheExtension = ".meshbin";
+	// キャッシュ形式のバージョン（形式を変えたら上げる）
+	static inline const uint32_t kCacheVersion = 1;
+
+	// 1アセット分の読み込み結果
+	struct Result {
+		std::string name;
+		MeshData mesh;
+		bool succeeded = false;
+		bool fromCache = false;    // キャッシュから読んだか
+		double milliseconds = 0.0; // 読み込み時間
+	};
+
+	// 読み込み設定
+	struct Options {
+		bool useCache = true;     // キャッシュを読む/書く
+		uint32_t threadCount = 0; // 0ならハードウェアスレッド数
+	};
+
+public:
+	/// <summary>
+	/// 1アセットの読み込み（キャッシュが古ければ解析し直して書き直す）
+	/// </summary>
+	/// <param name="directory">Resources</param>
+	/// <param name="name">モデル名</param>
+	/// <param name="options"></param>
+	/// <returns></returns>
+	static Result Load(const std::string& directory, const std::string& name, const Options& options);
+
+	/// <summary>
+	/// 複数アセットを並列に読み込む（結果は names と同じ並び）
+	/// </summary>
+	/// <param name="directory">Resources</param>
+	/// <param name="names">モデル名</param>
+	/// <param name="options"></param>
+	/// <returns></returns>
+	static std::vector<Result> LoadAll(const std::string& directory, const std::vector<std::string>& names, const Options& options);
+
+	/// <summary>
+	/// OBJ/MTLのテキスト解析（エンジンのローダーと同じく x 反転・v 反転・巻き順反転）
+	/// </summary>
+	/// <param name="objPath"></param>
+	/// <param name="out"></param>
+	/// <returns>成功したか</returns>
+	static bool ParseObj(const std::string& objPath, MeshData& out);
+
+	/// <summary>
+	/// バイナリキャッシュを書き出す
+	/// </summary>
+	/// <param name="cachePath"></param>
+	/// <param name="objPath">元ファイル（更新時刻とサイズを記録）</param>
+	/// <param name="mesh"></param>
+	/// <returns>成功したか</returns>
+	static bool WriteCache(const std::string& cachePath, const std::string& objPath, const MeshData& mesh);
+	/// <summary>
+	/// バイナリキャッシュをマップして読む（元ファイルと食い違えば失敗）
+	/// </summary>
+	/// <param name="cachePath"></param>
+	/// <param name="objPath"></param>
+	/// <param name="out"></param>
+	/// <returns>成功したか</returns>
+	static bool ReadCache(const std::string& cachePath, const std::string& objPath, MeshData& out);
+};
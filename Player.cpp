@@ -1,6 +1,8 @@
 #define NOMINMAX
 #include "Player.h"
 #include "MapChipField.h"
+#include "Profiler.h"
+#include "RenderPipeline.h"
 #include "cassert"
 #include <cmath>
 #include <numbers>
@@ -29,19 +31,121 @@ void Player::Initialize(Model* model, Model* modelAttack, Camera* camera, const
 	worldTransform_.Initialize();
 	worldTransformAttack_.Initialize();
 
+	// 位置・状態の初期化
+	Reset(position);
+}
+
+/// <summary>
+/// 状態を初期値に戻して指定位置に置き直す（リトライ用）
+/// </summary>
+/// <param name="position"></param>
+void Player::Reset(const Vector3& position) {
+	// 振るまい
+	behavior_ = Behavior::kRoot;
+	behaviorRequest_ = Behavior::kUnknown;
+	attackPhase_ = AttackPhase::kCharge;
+	attackParameter_ = 0.0f;
+	isAttackEffect_ = false;
+
+	// 移動
+	velocity_ = {};
+	onGround_ = true;
+	jumpCount_ = 0;
+	isOnWall_ = false;
+	wallDirection_ = 0;
+
+	// 向き
+	lrDirection_ = LRDirection::kRight;
+	turnFirstRotationY_ = 0.0f;
+	turnTimer_ = 0.0f;
+
+	isDead_ = false;
+
+	input_ = {};
+	previousInput_ = {};
+
 	// 位置調整
 	worldTransform_.translation_ = position;
-	worldTransform_.rotation_.y = std::numbers::pi_v<float> / 2.0f;
+	worldTransform_.rotation_ = {0.0f, std::numbers::pi_v<float> / 2.0f, 0.0f};
+	worldTransform_.scale_ = {1.0f, 1.0f, 1.0f};
 
 	// 攻撃エフェクト用も同じ初期位置・向きに
 	worldTransformAttack_.translation_ = position;
-	worldTransformAttack_.rotation_.y = std::numbers::pi_v<float> / 2.0f;
+	worldTransformAttack_.rotation_ = {0.0f, std::numbers::pi_v<float> / 2.0f, 0.0f};
+}
+
+/// <summary>
+/// 状態を記録に書く
+/// </summary>
+/// <param name="snapshot"></param>
+void Player::SaveState(SimulationSnapshot& snapshot) const {
+	State state;
+	state.transform.Save(worldTransform_);
+	state.transformAttack.Save(worldTransformAttack_);
+	state.velocity = velocity_;
+	state.attackVelocity = attackVelocity;
+	state.behavior = behavior_;
+	state.behaviorRequest = behaviorRequest_;
+	state.attackPhase = attackPhase_;
+	state.lrDirection = lrDirection_;
+	state.turnFirstRotationY = turnFirstRotationY_;
+	state.turnTimer = turnTimer_;
+	state.attackParameter = attackParameter_;
+	state.jumpCount = jumpCount_;
+	state.wallDirection = wallDirection_;
+	state.isDead = isDead_;
+	state.onGround = onGround_;
+	state.isOnWall = isOnWall_;
+	state.isAttackEffect = isAttackEffect_;
+	state.input = input_;
+	state.previousInput = previousInput_;
+	state.padding[0] = 0;
+	state.padding[1] = 0;
+	snapshot.Write(state);
+}
+
+/// <summary>
+/// 状態を記録から戻す
+/// </summary>
+/// <param name="reader"></param>
+void Player::LoadState(SimulationSnapshot::Reader& reader) {
+	State state;
+	reader.Read(state);
+	state.transform.Load(worldTransform_);
+	state.transformAttack.Load(worldTransformAttack_);
+	velocity_ = state.velocity;
+	attackVelocity = state.attackVelocity;
+	behavior_ = state.behavior;
+	behaviorRequest_ = state.behaviorRequest;
+	attackPhase_ = state.attackPhase;
+	lrDirection_ = state.lrDirection;
+	turnFirstRotationY_ = state.turnFirstRotationY;
+	turnTimer_ = state.turnTimer;
+	attackParameter_ = state.attackParameter;
+	jumpCount_ = state.jumpCount;
+	wallDirection_ = state.wallDirection;
+	isDead_ = state.isDead;
+	onGround_ = state.onGround;
+	isOnWall_ = state.isOnWall;
+	isAttackEffect_ = state.isAttackEffect;
+	input_ = state.input;
+	previousInput_ = state.previousInput;
+}
+
+/// <summary>
+/// このフレームの入力を渡す
+/// </summary>
+/// <param name="input"></param>
+void Player::SetInput(const PlayerInput& input) {
+	previousInput_ = input_;
+	input_ = input;
 }
 
 /// <summary>
 /// 更新処理
 /// </summary>
 void Player::Update() {
+	PROFILE_ZONE("Player::Update");
 
 	if (behaviorRequest_ != Behavior::kUnknown) {
 		// 振るまいを変更
@@ -94,7 +198,7 @@ void Player::UpdateMovementInput() {
 		}
 
 		// 地上ジャンプ（スペース）
-		if (Input::GetInstance()->TriggerKey(DIK_SPACE)) {
+		if (input_.IsTrigger(PlayerInput::kJump, previousInput_)) {
 			velocity_.y = kJumpAcceleration;
 		}
 	} else {
@@ -106,7 +210,7 @@ void Player::UpdateMovementInput() {
 		velocity_.y = std::max(velocity_.y, -kMaxFallSpeed);
 
 		// 空中ジャンプ入力（スペース）
-		if (Input::GetInstance()->TriggerKey(DIK_SPACE)) {
+		if (input_.IsTrigger(PlayerInput::kJump, previousInput_)) {
 
 			// --- 壁ジャンプ優先 ---
 			if (isOnWall_ && wallDirection_ != 0) {
@@ -128,10 +232,10 @@ void Player::UpdateMovementInput() {
 	}
 
 	// ======= 横方向（左右移動） =======
-	if (Input::GetInstance()->PushKey(DIK_RIGHT) || Input::GetInstance()->PushKey(DIK_LEFT)) {
+	if (input_.IsPush(PlayerInput::kRight) || input_.IsPush(PlayerInput::kLeft)) {
 		Vector3 acceleration{};
 
-		if (Input::GetInstance()->PushKey(DIK_RIGHT)) {
+		if (input_.IsPush(PlayerInput::kRight)) {
 			// 右入力中に左向き速度が出ていたら急ブレーキ
 			if (velocity_.x < 0.0f) {
 				velocity_.x *= (1.0f - kAttenuation);
@@ -149,7 +253,7 @@ void Player::UpdateMovementInput() {
 				turnTimer_ = kTimeTurn;
 			}
 
-		} else if (Input::GetInstance()->PushKey(DIK_LEFT)) {
+		} else if (input_.IsPush(PlayerInput::kLeft)) {
 			// 左入力中に右向き速度が出ていたら急ブレーキ
 			if (velocity_.x > 0.0f) {
 				velocity_.x *= (1.0f - kAttenuation);
@@ -207,7 +311,7 @@ void Player::BehaviorRootUpdate() {
 	/// ===========================================
 
 	// 攻撃キー(E)を押したら
-	if (Input::GetInstance()->TriggerKey(DIK_E)) {
+	if (input_.IsTrigger(PlayerInput::kAttack, previousInput_)) {
 
 		// 攻撃ビヘイビアをリクエスト
 		behaviorRequest_ = Behavior::kAttack;
@@ -730,6 +834,23 @@ void Player::Draw() {
 	}
 }
 
+/// <summary>
+/// 描画の記録に写す
+/// </summary>
+/// <param name="snapshot"></param>
+/// <param name="modelId"></param>
+/// <param name="attackModelId"></param>
+void Player::Capture(FrameSnapshot& snapshot, uint32_t modelId, uint32_t attackModelId) const {
+	if (isDead_) {
+		return;
+	}
+
+	snapshot.Add(modelId, worldTransform_);
+	if (isAttackEffect_) {
+		snapshot.Add(attackModelId, worldTransformAttack_);
+	}
+}
+
 /// <summary>
 /// ゲッター
 /// </summary>
@@ -2,10 +2,13 @@
 #include "AABB.h"
 //#include "AffineMatrix.h"
 #include "KamataEngine.h"
+#include "PlayerInput.h"
+#include "SimulationSnapshot.h"
 #include "WorldTransformUpdater.h"
 
 class MapChipField;
 class Enemy;
+struct FrameSnapshot;
 
 class Player {
 public:
@@ -135,6 +138,35 @@ private:
 	// モデル
 	KamataEngine::Model* model_ = nullptr;
 
+	// 入力（キーボードは直接読まず、外から渡されたものだけで動く。通信対戦で相手の入力を流し込めるように）
+	PlayerInput input_;
+	// 前のフレームの入力（押し始めの判定用）
+	PlayerInput previousInput_;
+
+	// 記録に書く状態（ポインタ以外の、更新で変わるもの全て）
+	struct State {
+		SimulationSnapshot::TransformState transform;
+		SimulationSnapshot::TransformState transformAttack;
+		KamataEngine::Vector3 velocity;
+		KamataEngine::Vector3 attackVelocity;
+		Behavior behavior;
+		Behavior behaviorRequest;
+		AttackPhase attackPhase;
+		LRDirection lrDirection;
+		float turnFirstRotationY;
+		float turnTimer;
+		float attackParameter;
+		int jumpCount;
+		int wallDirection;
+		bool isDead;
+		bool onGround;
+		bool isOnWall;
+		bool isAttackEffect;
+		PlayerInput input;
+		PlayerInput previousInput;
+		uint8_t padding[2];
+	};
+
 public:
 	/// <summary>
 	/// 初期化処理
@@ -143,6 +175,25 @@ public:
 	/// <param name="camera">カメラ</param>
 	void Initialize(KamataEngine::Model* model, KamataEngine::Model* modelAttack, KamataEngine::Camera* camera, const KamataEngine::Vector3& position);
 
+	/// <summary>
+	/// 状態を初期値に戻して指定位置に置き直す（リトライ用）
+	/// </summary>
+	/// <param name="position"></param>
+	void Reset(const KamataEngine::Vector3& position);
+
+	/// <summary>
+	/// 動き・振るまい・攻撃の状態を記録に書く / 記録から戻す
+	/// </summary>
+	/// <param name="snapshot"></param>
+	void SaveState(SimulationSnapshot& snapshot) const;
+	void LoadState(SimulationSnapshot::Reader& reader);
+
+	/// <summary>
+	/// このフレームの入力を渡す（毎フレーム Update の前に1回。前のフレームの入力は押し始めの判定に使う）
+	/// </summary>
+	/// <param name="input"></param>
+	void SetInput(const PlayerInput& input);
+
 	/// <summary>
 	/// 更新処理
 	/// </summary>
@@ -246,6 +297,14 @@ public:
 	/// </summary>
 	void Draw();
 
+	/// <summary>
+	/// 描画の記録に写す（RenderPipeline 用。Draw と同じものを写す）
+	/// </summary>
+	/// <param name="snapshot"></param>
+	/// <param name="modelId">本体のモデルID</param>
+	/// <param name="attackModelId">攻撃エフェクトのモデルID</param>
+	void Capture(FrameSnapshot& snapshot, uint32_t modelId, uint32_t attackModelId) const;
+
 	/// <summary>
 	/// ゲッター
 	/// </summary>
@@ -256,6 +315,17 @@ public:
 	AABB GetAABB();
 	bool IsDead() const;
 	bool IsAttack() const;
+	bool IsAttackEffect() const { return isAttackEffect_; }
+
+	/// <summary>
+	/// 移動の定数（経路探索で届く範囲を求めるのに使う）
+	/// </summary>
+	/// <returns></returns>
+	static float GetAcceleration() { return kAcceleration; }
+	static float GetJumpAcceleration() { return kJumpAcceleration; }
+	static float GetGravityAcceleration() { return kGravityAcceleration; }
+	static float GetMaxFallSpeed() { return kMaxFallSpeed; }
+	static int GetMaxJumpCount() { return kMaxJumpCount; }
 
 	/// <summary>
 	/// セッター
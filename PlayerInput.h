@@ -0,0 +1,73 @@
+#pragma once
+#include "KamataEngine.h"
+
+#include <cstdint>
+
+/// <summary>
+/// プレイヤー1人・1フレーム分の入力（ボタンの押下状態だけを持つ1バイト。通信や記録にそのまま載せる）
+/// </summary>
+struct PlayerInput {
+	// ボタン
+	enum Button : uint8_t {
+		kLeft = 1 << 0,   // 左移動
+		kRight = 1 << 1,  // 右移動
+		kJump = 1 << 2,   // ジャンプ
+		kAttack = 1 << 3, // 攻撃
+	};
+
+	// キーの割り当て
+	struct KeyMap {
+		int left;
+		int right;
+		int jump;
+		int attack;
+	};
+
+	// 1人プレイ・1P の割り当て（← → / スペース / E）
+	static inline const KeyMap kKeyMapPrimary = {DIK_LEFT, DIK_RIGHT, DIK_SPACE, DIK_E};
+	// 同じキーボードで遊ぶ 2P の割り当て（A D / W / F）
+	static inline const KeyMap kKeyMapSecondary = {DIK_A, DIK_D, DIK_W, DIK_F};
+
+	uint8_t buttons = 0;
+
+	/// <summary>
+	/// 押しているか
+	/// </summary>
+	/// <param name="button"></param>
+	/// <returns></returns>
+	bool IsPush(Button button) const { return (buttons & button) != 0; }
+
+	/// <summary>
+	/// このフレームで押し始めたか
+	/// </summary>
+	/// <param name="button"></param>
+	/// <param name="previous">前のフレームの入力</param>
+	/// <returns></returns>
+	bool IsTrigger(Button button, const PlayerInput& previous) const { return IsPush(button) && !previous.IsPush(button); }
+
+	bool operator==(const PlayerInput& other) const { return buttons == other.buttons; }
+	bool operator!=(const PlayerInput& other) const { return buttons != other.buttons; }
+
+	/// <summary>
+	/// キーボードの状態から作る
+	/// </summary>
+	/// <param name="keyMap"></param>
+	/// <returns></returns>
+	static PlayerInput FromKeyboard(const KeyMap& keyMap = kKeyMapPrimary) {
+		KamataEngine::Input* input = KamataEngine::Input::GetInstance();
+		PlayerInput result;
+		if (input->PushKey(keyMap.left)) {
+			result.buttons |= kLeft;
+		}
+		if (input->PushKey(keyMap.right)) {
+			result.buttons |= kRight;
+		}
+		if (input->PushKey(keyMap.jump)) {
+			result.buttons |= kJump;
+		}
+		if (input->PushKey(keyMap.attack)) {
+			result.buttons |= kAttack;
+		}
+		return result;
+	}
+};
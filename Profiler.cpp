@@ -0,0 +1,135 @@
+#include "Profiler.h"
+#include <cstdio>
+
+namespace {
+
+/// <summary>
+/// JSON 文字列として書き出す
+/// </summary>
+void WriteJsonString(std::FILE* file, const char* text) {
+	std::fputc('"', file);
+	for (const char* c = text; *c != '\0'; ++c) {
+		if (*c == '"' || *c == '\\') {
+			std::fputc('\\', file);
+		}
+		std::fputc(*c, file);
+	}
+	std::fputc('"', file);
+}
+
+} // namespace
+
+thread_local Profiler::ThreadBuffer* Profiler::threadBuffer_ = nullptr;
+
+/// <summary>
+/// インスタンスの取得
+/// </summary>
+/// <returns></returns>
+Profiler* Profiler::GetInstance() {
+	static Profiler instance;
+	return &instance;
+}
+
+Profiler::Profiler() : epoch_(Now()) {}
+
+/// <summary>
+/// 区間を記録（呼んだスレッドのバッファへ。ロックしない）
+/// </summary>
+/// <param name="name"></param>
+/// <param name="begin"></param>
+/// <param name="end"></param>
+void Profiler::Record(const char* name, int64_t begin, int64_t end) {
+	ThreadBuffer* buffer = GetThreadBuffer();
+
+	// 書き込むのは持ち主だけなので、書いてから総数を公開すればよい
+	uint64_t index = buffer->written.load(std::memory_order_relaxed);
+	Event& event = buffer->events[index & (kEventCapacity - 1)];
+	event.name = name;
+	event.begin = begin;
+	event.end = end;
+	buffer->written.store(index + 1, std::memory_order_release);
+}
+
+/// <summary>
+/// 呼んだスレッドの表示名を設定
+/// </summary>
+/// <param name="name"></param>
+void Profiler::SetThreadName(const std::string& name) {
+	ThreadBuffer* buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	buffer->threadName = name;
+}
+
+/// <summary>
+/// ここまでの記録を捨てる
+/// </summary>
+void Profiler::Clear() {
+	std::lock_guard<std::mutex> lock(mutex_);
+	for (std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+		buffer->readFrom = buffer->written.load(std::memory_order_acquire);
+	}
+}
+
+/// <summary>
+/// Chrome の trace_event 形式（chrome://tracing, Perfetto で開ける）で書き出す
+/// </summary>
+/// <param name="filePath"></param>
+/// <returns>書き出せたか</returns>
+bool Profiler::WriteChromeTrace(const std::string& filePath) {
+	std::FILE* file = std::fopen(filePath.c_str(), "wb");
+	if (!file) {
+		return false;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+
+	std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n", file);
+	bool isFirst = true;
+
+	for (std::unique_ptr<ThreadBuffer>& buffer : buffers_) {
+		// スレッド名
+		if (!buffer->threadName.empty()) {
+			std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", isFirst ? "" : ",\n", buffer->threadId);
+			WriteJsonString(file, buffer->threadName.c_str());
+			std::fputs("}}", file);
+			isFirst = false;
+		}
+
+		// 上書きされていない分だけ（書き込み中のスレッドがあれば、最も古い数件は崩れている可能性がある）
+		uint64_t written = buffer->written.load(std::memory_order_acquire);
+		uint64_t first = written > kEventCapacity ? written - kEventCapacity : 0;
+		if (first < buffer->readFrom) {
+			first = buffer->readFrom;
+		}
+
+		for (uint64_t i = first; i < written; ++i) {
+			const Event& event = buffer->events[i & (kEventCapacity - 1)];
+			std::fprintf(file, "%s{\"name\":", isFirst ? "" : ",\n");
+			WriteJsonString(file, event.name);
+			std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}", buffer->threadId, static_cast<double>(event.begin - epoch_) / 1000.0,
+			             static_cast<double>(event.end - event.begin) / 1000.0);
+			isFirst = false;
+		}
+	}
+
+	std::fputs("\n]}\n", file);
+	return std::fclose(file) == 0;
+}
+
+/// <summary>
+/// 呼んだスレッドのバッファ（初回だけ登録する）
+/// </summary>
+/// <returns></returns>
+Profiler::ThreadBuffer* Profiler::GetThreadBuffer() {
+	if (threadBuffer_) {
+		return threadBuffer_;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex_);
+	buffers_.push_back(std::make_unique<ThreadBuffer>());
+	ThreadBuffer* buffer = buffers_.back().get();
+	buffer->threadId = static_cast<uint32_t>(buffers_.size());
+	threadBuffer_ = buffer;
+	return buffer;
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// デバッグビルドか ENABLE_PROFILER 指定時だけ計測する（リリースでは PROFILE_ZONE が消える）
+#if (defined(_DEBUG) || defined(ENABLE_PROFILER)) && !defined(DISABLE_PROFILER)
+#define PROFILER_ENABLED
+#endif
+
+/// <summary>
+/// 区間計測（スレッドごとのリングバッファに記録し、Chrome の trace_event 形式で書き出す）
+/// </summary>
+class Profiler {
+public:
+	// 1区間分
+	struct Event {
+		const char* name = nullptr; // 静的な文字列のみ（ポインタをそのまま保持する）
+		int64_t begin = 0;          // 開始（ns）
+		int64_t end = 0;            // 終了（ns）
+	};
+
+	// 1スレッドあたりの記録数（古いものから上書き）
+	static inline const uint32_t kEventCapacity = 1u << 15;
+
+private:
+	// スレッド1本分のリングバッファ（書き込みは持ち主のスレッドだけ）
+	struct ThreadBuffer {
+		std::array<Event, kEventCapacity> events;
+		std::atomic<uint64_t> written = 0; // 書き込んだ総数
+		uint64_t readFrom = 0;             // Clear() した位置（mutex_ の中でだけ触る）
+		uint32_t threadId = 0;
+		std::string threadName;
+	};
+
+	// 全スレッドのバッファ（スレッド終了後も書き出せるよう Profiler が持ち続ける）
+	std::vector<std::unique_ptr<ThreadBuffer>> buffers_;
+	// バッファの登録と書き出し用（記録中は取らない）
+	std::mutex mutex_;
+
+	// 時刻の基準
+	int64_t epoch_ = 0;
+
+	// 呼んだスレッドのバッファ（buffers_ の中を指す）
+	static thread_local ThreadBuffer* threadBuffer_;
+
+public:
+	/// <summary>
+	/// インスタンスの取得
+	/// </summary>
+	/// <returns></returns>
+	static Profiler* GetInstance();
+
+	/// <summary>
+	/// 現在時刻（ns）
+	/// </summary>
+	/// <returns></returns>
+	static int64_t Now() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
+
+	/// <summary>
+	/// 区間を記録（呼んだスレッドのバッファへ。ロックしない）
+	/// </summary>
+	/// <param name="name"></param>
+	/// <param name="begin"></param>
+	/// <param name="end"></param>
+	void Record(const char* name, int64_t begin, int64_t end);
+	/// <summary>
+	/// 呼んだスレッドの表示名を設定
+	/// </summary>
+	/// <param name="name"></param>
+	void SetThreadName(const std::string& name);
+
+	/// <summary>
+	/// ここまでの記録を捨てる
+	/// </summary>
+	void Clear();
+	/// <summary>
+	/// Chrome の trace_event 形式（chrome://tracing, Perfetto で開ける）で書き出す
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <returns>書き出せたか</returns>
+	bool WriteChromeTrace(const std::string& filePath);
+
+private:
+	Profiler();
+	~Profiler() = default;
+	Profiler(const Profiler&) = delete;
+	Profiler& operator=(const Profiler&) = delete;
+
+	/// <summary>
+	/// 呼んだスレッドのバッファ（初回だけ登録する）
+	/// </summary>
+	/// <returns></returns>
+	ThreadBuffer* GetThreadBuffer();
+};
+
+/// <summary>
+/// スコープを抜けるまでを1区間として記録する
+/// </summary>
+class ProfileZone {
+private:
+	const char* name_;
+	int64_t begin_;
+
+public:
+	explicit ProfileZone(const char* name) : name_(name), begin_(Profiler::Now()) {}
+	~ProfileZone() { Profiler::GetInstance()->Record(name_, begin_, Profiler::Now()); }
+
+	ProfileZone(const ProfileZone&) = delete;
+	ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+#define PROFILER_CONCAT_INNER(a, b) a##b
+#define PROFILER_CONCAT(a, b) PROFILER_CONCAT_INNER(a, b)
+
+#ifdef PROFILER_ENABLED
+// 区間計測（name は文字列リテラル）
+#define PROFILE_ZONE(name) ProfileZone PROFILER_CONCAT(profileZone_, __LINE__)(name)
+// スレッドの表示名
+#define PROFILE_THREAD_NAME(name) Profiler::GetInstance()->SetThreadName(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_THREAD_NAME(name) ((void)0)
+#endif
@@ -1,14 +1,183 @@
+#define NOMINMAX
 #include "Random.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <random>
 
-//静的メンバの実体と初期化
-std::random_device Random::seedGenerator_;
-std::mt19937_64 Random::randomEngine_;
+namespace {
 
-void Random::SeedEngine() { randomEngine_.seed(seedGenerator_()); }
+// 全体のシードと、その世代（変わったら各スレッドが列を作り直す）
+std::atomic<uint64_t> gGlobalSeed = Random::kDefaultSeed;
+std::atomic<uint32_t> gSeedGeneration = 1;
+// スレッドの通し番号（最初に乱数を使ったスレッドから 0, 1, 2...）
+std::atomic<uint32_t> gNextThreadIndex = 0;
 
-float Random::GeneraterFloat(float min, float max) {
-	std::uniform_real_distribution<float> distribution(min, max);
+/// <summary>
+/// シードを散らす（splitmix64）
+/// </summary>
+uint64_t SplitMix64(uint64_t& state) {
+	uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
 
-	//乱数を返す
-	return distribution(randomEngine_);
-}
\ No newline at end of file
+// スレッドごとの列
+struct ThreadStreams {
+	uint32_t threadIndex = 0;
+	uint32_t generation = 0; // 0 はまだ作っていない
+	std::array<Random::Stream, static_cast<size_t>(Random::System::kCount)> streams;
+};
+
+thread_local ThreadStreams tStreams;
+
+/// <summary>
+/// 呼んだスレッドの列を全体のシードから作り直す
+/// </summary>
+void ReseedThreadStreams(ThreadStreams& local, uint32_t generation) {
+	if (local.generation == 0) {
+		local.threadIndex = gNextThreadIndex.fetch_add(1, std::memory_order_relaxed);
+	}
+	uint64_t seed = gGlobalSeed.load(std::memory_order_relaxed);
+	for (size_t i = 0; i < local.streams.size(); ++i) {
+		local.streams[i].Seed(seed, static_cast<uint64_t>(local.threadIndex) * local.streams.size() + i);
+	}
+	local.generation = generation;
+}
+
+} // namespace
+
+///====================================================
+/// Stream
+///====================================================
+
+/// <summary>
+/// シード（同じ seed でも streamId が違えば別の列）
+/// </summary>
+/// <param name="seed"></param>
+/// <param name="streamId"></param>
+void Random::Stream::Seed(uint64_t seed, uint64_t streamId) {
+	uint64_t mixer = seed ^ (streamId * 0xD1B54A32D192ED03ull);
+	uint64_t a = SplitMix64(mixer);
+	uint64_t b = SplitMix64(mixer);
+	state_ = {static_cast<uint32_t>(a), static_cast<uint32_t>(a >> 32), static_cast<uint32_t>(b), static_cast<uint32_t>(b >> 32)};
+
+	// 全部0だと止まるので避ける
+	if ((state_[0] | state_[1] | state_[2] | state_[3]) == 0) {
+		state_[0] = 1;
+	}
+}
+
+/// <summary>
+/// [0, bound) の整数（偏りなし）
+/// </summary>
+/// <param name="bound"></param>
+/// <returns></returns>
+uint32_t Random::Stream::NextUint32(uint32_t bound) {
+	if (bound == 0) {
+		return 0;
+	}
+
+	// Lemire の方法（掛け算の上位を取り、端数の分だけ引き直す）
+	uint64_t product = static_cast<uint64_t>(NextUint32()) * bound;
+	uint32_t low = static_cast<uint32_t>(product);
+	if (low < bound) {
+		uint32_t threshold = (0u - bound) % bound;
+		while (low < threshold) {
+			product = static_cast<uint64_t>(NextUint32()) * bound;
+			low = static_cast<uint32_t>(product);
+		}
+	}
+	return static_cast<uint32_t>(product >> 32);
+}
+
+/// <summary>
+/// 球面上に一様な単位ベクトル
+/// </summary>
+/// <returns></returns>
+KamataEngine::Vector3 Random::Stream::NextUnitVector() {
+	// 高さ y を一様に、方位角を一様に取ると球面上で一様になる
+	const float y = NextFloat(-1.0f, 1.0f);
+	const float azimuth = NextFloat(0.0f, 2.0f * std::numbers::pi_v<float>);
+	const float radius = std::sqrt(std::max(0.0f, 1.0f - y * y));
+	return {radius * std::cos(azimuth), y, radius * std::sin(azimuth)};
+}
+
+/// <summary>
+/// [min, max) の実数でまとめて埋める
+/// </summary>
+/// <param name="out"></param>
+/// <param name="min"></param>
+/// <param name="max"></param>
+void Random::Stream::FillUniform(std::span<float> out, float min, float max) {
+	// 状態をローカルに持って回す（ループ中にメモリへ書き戻さない）
+	Stream local = *this;
+	const float range = max - min;
+	for (float& value : out) {
+		value = min + range * local.NextFloat01();
+	}
+	*this = local;
+}
+
+/// <summary>
+/// 球面上に一様な単位ベクトルでまとめて埋める
+/// </summary>
+/// <param name="out"></param>
+void Random::Stream::FillUnitVectors(std::span<KamataEngine::Vector3> out) {
+	Stream local = *this;
+	for (KamataEngine::Vector3& value : out) {
+		value = local.NextUnitVector();
+	}
+	*this = local;
+}
+
+///====================================================
+/// 全体
+///====================================================
+
+/// <summary>
+/// 全体のシードを設定（全スレッドの列が、次に使われるときにこのシードから作り直される）
+/// </summary>
+/// <param name="seed"></param>
+void Random::SetGlobalSeed(uint64_t seed) {
+	gGlobalSeed.store(seed, std::memory_order_relaxed);
+	gSeedGeneration.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t Random::GetGlobalSeed() { return gGlobalSeed.load(std::memory_order_relaxed); }
+
+/// <summary>
+/// 毎回違うシード（random_device を1回だけ使う）
+/// </summary>
+/// <returns></returns>
+uint64_t Random::MakeNondeterministicSeed() {
+	std::random_device device;
+	return (static_cast<uint64_t>(device()) << 32) ^ device();
+}
+
+/// <summary>
+/// 呼んだスレッドの、用途ごとの列
+/// </summary>
+/// <param name="system"></param>
+/// <returns></returns>
+Random::Stream& Random::GetStream(System system) {
+	ThreadStreams& local = tStreams;
+	uint32_t generation = gSeedGeneration.load(std::memory_order_acquire);
+	if (local.generation != generation) {
+		ReseedThreadStreams(local, generation);
+	}
+	return local.streams[static_cast<size_t>(system)];
+}
+
+/// <summary>
+/// 呼んだスレッドの kDefault の列を全体のシードから作り直す
+/// </summary>
+void Random::SeedEngine() {
+	ThreadStreams& local = tStreams;
+	uint32_t generation = gSeedGeneration.load(std::memory_order_acquire);
+	if (local.generation != generation) {
+		ReseedThreadStreams(local, generation);
+	}
+	local.streams[static_cast<size_t>(System::kDefault)].Seed(GetGlobalSeed(), static_cast<uint64_t>(local.threadIndex) * local.streams.size());
+}
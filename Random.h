@@ -1,17 +1,140 @@
 #pragma once
-#include <random>
+#include <math/Vector3.h>
+
+#include <array>
+#include <cstdint>
 #include <numbers>
+#include <span>
 
+/// <summary>
+/// 乱数（xoshiro128**。用途ごと・スレッドごとに独立した列を持ち、シードを決めれば毎回同じ結果になる）
+/// </summary>
 class Random {
-private:
+public:
+	// 用途ごとの列（互いの引いた回数に影響されない）
+	enum class System : uint32_t {
+		kDefault,   // GeneraterFloat など
+		kFireworks, // 花火
+		kHitEffect, // ヒットエフェクト
+		kScenery,   // 雲などの背景配置
+
+		kCount // 要素数
+	};
+
+	// 指定が無いときのシード
+	static inline const uint64_t kDefaultSeed = 0x4B616D6174610001ull;
+
+	/// <summary>
+	/// 乱数列1本（状態は16バイト。コピーすればその時点から同じ列を再生できる）
+	/// </summary>
+	class Stream {
+	public:
+		using State = std::array<uint32_t, 4>;
+
+	private:
+		State state_;
 
-	//乱数生成エンジン
-	static std::random_device seedGenerator_;
-	//メルセンヌ・ツイスターエンジン(64bit版)
-	static std::mt19937_64 randomEngine_;
+	public:
+		Stream() { Seed(kDefaultSeed); }
+		Stream(uint64_t seed, uint64_t streamId) { Seed(seed, streamId); }
+
+		/// <summary>
+		/// シード（同じ seed でも streamId が違えば別の列）
+		/// </summary>
+		/// <param name="seed"></param>
+		/// <param name="streamId"></param>
+		void Seed(uint64_t seed, uint64_t streamId = 0);
+
+		/// <summary>
+		/// 32bit の乱数
+		/// </summary>
+		/// <returns></returns>
+		uint32_t NextUint32() {
+			const uint32_t result = RotateLeft(state_[1] * 5u, 7) * 9u;
+			const uint32_t t = state_[1] << 9;
+			state_[2] ^= state_[0];
+			state_[3] ^= state_[1];
+			state_[1] ^= state_[2];
+			state_[0] ^= state_[3];
+			state_[2] ^= t;
+			state_[3] = RotateLeft(state_[3], 11);
+			return result;
+		}
+		/// <summary>
+		/// [0, bound) の整数（偏りなし）
+		/// </summary>
+		/// <param name="bound"></param>
+		/// <returns></returns>
+		uint32_t NextUint32(uint32_t bound);
+		/// <summary>
+		/// [0, 1) の実数
+		/// </summary>
+		/// <returns></returns>
+		float NextFloat01() { return static_cast<float>(NextUint32() >> 8) * (1.0f / 16777216.0f); }
+		/// <summary>
+		/// [min, max) の実数
+		/// </summary>
+		/// <returns></returns>
+		float NextFloat(float min, float max) { return min + (max - min) * NextFloat01(); }
+		/// <summary>
+		/// 球面上に一様な単位ベクトル
+		/// </summary>
+		/// <returns></returns>
+		KamataEngine::Vector3 NextUnitVector();
+
+		/// <summary>
+		/// [min, max) の実数でまとめて埋める
+		/// </summary>
+		/// <param name="out"></param>
+		/// <param name="min"></param>
+		/// <param name="max"></param>
+		void FillUniform(std::span<float> out, float min, float max);
+		/// <summary>
+		/// 球面上に一様な単位ベクトルでまとめて埋める
+		/// </summary>
+		/// <param name="out"></param>
+		void FillUnitVectors(std::span<KamataEngine::Vector3> out);
+
+		/// <summary>
+		/// 状態の保存・復元
+		/// </summary>
+		/// <returns></returns>
+		const State& GetState() const { return state_; }
+		void SetState(const State& state) { state_ = state; }
+
+	private:
+		static uint32_t RotateLeft(uint32_t x, int k) { return (x << k) | (x >> (32 - k)); }
+	};
 
 public:
+	/// <summary>
+	/// 全体のシードを設定（全スレッドの列が、次に使われるときにこのシードから作り直される）
+	/// </summary>
+	/// <param name="seed"></param>
+	static void SetGlobalSeed(uint64_t seed);
+	static uint64_t GetGlobalSeed();
+	/// <summary>
+	/// 毎回違うシード（random_device を1回だけ使う）
+	/// </summary>
+	/// <returns></returns>
+	static uint64_t MakeNondeterministicSeed();
+
+	/// <summary>
+	/// 呼んだスレッドの、用途ごとの列
+	/// </summary>
+	/// <param name="system"></param>
+	/// <returns></returns>
+	static Stream& GetStream(System system = System::kDefault);
 
+	/// <summary>
+	/// 呼んだスレッドの kDefault の列を全体のシードから作り直す
+	/// </summary>
 	static void SeedEngine();
-	static float GeneraterFloat(float min, float max);
+	/// <summary>
+	/// kDefault の列から [min, max) の実数
+	/// </summary>
+	/// <param name="min"></param>
+	/// <param name="max"></param>
+	/// <returns></returns>
+	static float GeneraterFloat(float min, float max) { return GetStream().NextFloat(min, max); }
 };
@@ -0,0 +1,234 @@
+#define NOMINMAX
+#include "RenderPipeline.h"
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <cassert>
+
+using namespace KamataEngine;
+
+/// <summary>
+/// デストラクタ
+/// </summary>
+RenderPipeline::~RenderPipeline() { Finalize(); }
+
+/// <summary>
+/// 初期化
+/// </summary>
+/// <param name="staticTransformCount">バックエンドの静的トランスフォームの数</param>
+/// <param name="useThread">描画スレッドを立てるか（false なら Publish でその場で組み立てる）</param>
+void RenderPipeline::Initialize(uint32_t staticTransformCount, bool useThread) {
+	Finalize();
+
+	staticTransformCount_ = staticTransformCount;
+
+	for (Slot& slot : slots_) {
+		slot.snapshot.frame = 0;
+		slot.snapshot.Clear();
+		slot.snapshot.items.reserve(kInitialTransformCount);
+		slot.queue.Reserve(kInitialTransformCount);
+		slot.camera.Initialize();
+
+		slot.transforms.reserve(kInitialTransformCount);
+		while (slot.transforms.size() < kInitialTransformCount) {
+			WorldTransform* worldTransform = new WorldTransform();
+			worldTransform->Initialize();
+			slot.transforms.push_back(worldTransform);
+		}
+	}
+
+	builtFrame_.store(0);
+	requestedFrame_.store(0);
+	writingFrame_ = 0;
+	publishedFrame_ = 0;
+	executedFrame_ = 0;
+	resetFrame_ = 0;
+
+	if (useThread) {
+		thread_ = std::thread(&RenderPipeline::RenderThreadMain, this);
+	}
+}
+
+/// <summary>
+/// 描画スレッドを止めて解放
+/// </summary>
+void RenderPipeline::Finalize() {
+	if (thread_.joinable()) {
+		// 組み立て中のフレームがあれば、それを終えてから抜ける
+		requestedFrame_.store(kQuitFrame, std::memory_order_release);
+		requestedFrame_.notify_one();
+		thread_.join();
+	}
+
+	for (Slot& slot : slots_) {
+		for (WorldTransform* worldTransform : slot.transforms) {
+			delete worldTransform;
+		}
+		slot.transforms.clear();
+	}
+}
+
+/// <summary>
+/// 次のフレームを書き込む記録を取り出す（2フレーム前の組み立てが終わるまで待つ）
+/// </summary>
+/// <returns></returns>
+FrameSnapshot& RenderPipeline::BeginSnapshot() {
+	writingFrame_ = publishedFrame_ + 1;
+
+	// 同じ面を使っていた2フレーム前を描画スレッドが読み終わるまで待つ
+	if (writingFrame_ > kSlotCount) {
+		WaitBuilt(writingFrame_ - kSlotCount);
+	}
+
+	FrameSnapshot& snapshot = slots_[writingFrame_ % kSlotCount].snapshot;
+	snapshot.Clear();
+	snapshot.frame = writingFrame_;
+	return snapshot;
+}
+
+/// <summary>
+/// 書き終えた記録を描画スレッドに渡す
+/// </summary>
+void RenderPipeline::Publish() {
+	assert(writingFrame_ == publishedFrame_ + 1);
+
+	publishedFrame_ = writingFrame_;
+
+	if (thread_.joinable() && !JobSystem::GetInstance()->IsSingleThreaded()) {
+		requestedFrame_.store(publishedFrame_, std::memory_order_release);
+		requestedFrame_.notify_one();
+		return;
+	}
+
+	// 描画スレッドを使わないときはその場で組み立てる（前のフレームを追い越さないよう先に待つ）
+	WaitBuilt(publishedFrame_ - 1);
+	Build(slots_[publishedFrame_ % kSlotCount]);
+	builtFrame_.store(publishedFrame_, std::memory_order_release);
+}
+
+/// <summary>
+/// 組み立て済みの最新のフレームを描く
+/// </summary>
+/// <param name="backend"></param>
+void RenderPipeline::Execute(ModelRenderBackend& backend) {
+	PROFILE_ZONE("RenderPipeline::Execute");
+
+	// 1つ前のフレーム（更新と重なって組み立てられた分）を描く。やり直し直後で無ければ最新を描く
+	uint64_t target = publishedFrame_ - 1;
+	if (publishedFrame_ == 0 || target <= resetFrame_) {
+		target = publishedFrame_;
+	}
+	// 戻らない（更新が止まっている間は同じフレームを描き直す）
+	target = (std::max)(target, executedFrame_);
+	if (target <= resetFrame_) {
+		return;
+	}
+
+	WaitBuilt(target);
+
+	const Slot& slot = slots_[target % kSlotCount];
+	assert(slot.snapshot.frame == target);
+	assert(backend.GetStaticTransformCount() == staticTransformCount_);
+
+	// 動くオブジェクトは静的トランスフォームの後ろに、記録の順で並べる
+	backend.ClearTransforms();
+	for (size_t i = 0; i < slot.snapshot.items.size(); ++i) {
+		backend.AddTransform(*slot.transforms[i]);
+	}
+	backend.SetCamera(&slot.camera);
+
+	slot.queue.Draw(backend);
+
+	executedFrame_ = target;
+}
+
+/// <summary>
+/// 記録を全て捨てる
+/// </summary>
+void RenderPipeline::Reset() {
+	WaitBuilt(publishedFrame_);
+
+	resetFrame_ = publishedFrame_;
+	executedFrame_ = publishedFrame_;
+}
+
+/// <summary>
+/// 描画スレッドの処理
+/// </summary>
+void RenderPipeline::RenderThreadMain() {
+	PROFILE_THREAD_NAME("Render");
+
+	uint64_t seen = 0;
+	while (true) {
+		// 新しいフレームを頼まれるまで寝る
+		requestedFrame_.wait(seen, std::memory_order_acquire);
+		uint64_t requested = requestedFrame_.load(std::memory_order_acquire);
+		if (requested == kQuitFrame) {
+			return;
+		}
+		seen = requested;
+
+		// その場で組み立てられたフレームは飛ばす
+		for (uint64_t frame = builtFrame_.load(std::memory_order_acquire) + 1; frame <= requested; ++frame) {
+			Build(slots_[frame % kSlotCount]);
+			builtFrame_.store(frame, std::memory_order_release);
+			builtFrame_.notify_all();
+		}
+	}
+}
+
+/// <summary>
+/// 記録から行列を転送し、コマンドを組み立ててバッチ化する
+/// </summary>
+/// <param name="slot"></param>
+void RenderPipeline::Build(Slot& slot) {
+	PROFILE_ZONE("RenderPipeline::Build");
+
+	const FrameSnapshot& snapshot = slot.snapshot;
+
+	// 足りない分の行列を作る（出現数が最大に達した後は確保しない）
+	while (slot.transforms.size() < snapshot.items.size()) {
+		WorldTransform* worldTransform = new WorldTransform();
+		worldTransform->Initialize();
+		slot.transforms.push_back(worldTransform);
+	}
+
+	// 行列を写して転送
+	for (size_t i = 0; i < snapshot.items.size(); ++i) {
+		WorldTransform& worldTransform = *slot.transforms[i];
+		worldTransform.matWorld_ = snapshot.items[i].matWorld;
+		worldTransform.TransferMatrix();
+	}
+
+	slot.camera.translation_ = snapshot.cameraTranslation;
+	slot.camera.matView = snapshot.matView;
+	slot.camera.matProjection = snapshot.matProjection;
+	slot.camera.TransferMatrix();
+
+	// コマンドを組み立ててバッチ化
+	slot.queue.Clear();
+	for (const RenderCommand& command : snapshot.staticCommands) {
+		slot.queue.Submit(command);
+	}
+	for (uint32_t i = 0; i < static_cast<uint32_t>(snapshot.items.size()); ++i) {
+		const FrameSnapshot::Item& item = snapshot.items[i];
+		slot.queue.Submit(item.modelId, item.materialId, staticTransformCount_ + i);
+	}
+	slot.queue.BuildBatches();
+}
+
+/// <summary>
+/// builtFrame_ が frame 以上になるまで待つ
+/// </summary>
+/// <param name="frame"></param>
+void RenderPipeline::WaitBuilt(uint64_t frame) {
+	uint64_t built = builtFrame_.load(std::memory_order_acquire);
+	if (built >= frame) {
+		return;
+	}
+
+	PROFILE_ZONE("RenderPipeline::WaitBuilt");
+	while (built < frame) {
+		builtFrame_.wait(built, std::memory_order_acquire);
+		built = builtFrame_.load(std::memory_order_acquire);
+	}
+}
@@ -0,0 +1,181 @@
+#pragma once
+#include "KamataEngine.h"
+#include "ModelRenderBackend.h"
+#include "RenderQueue.h"
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+/// <summary>
+/// 1フレーム分の描画に必要なものだけを写し取った読み取り専用の記録（シミュレーションの実体を参照しない）
+/// </summary>
+struct FrameSnapshot {
+	// 動くオブジェクト1つ分
+	struct Item {
+		uint32_t modelId;
+		uint32_t materialId;
+		KamataEngine::Matrix4x4 matWorld;
+	};
+
+	// シミュレーションのフレーム番号
+	uint64_t frame = 0;
+
+	// カメラ
+	KamataEngine::Vector3 cameraTranslation;
+	KamataEngine::Matrix4x4 matView;
+	KamataEngine::Matrix4x4 matProjection;
+
+	// バックエンドの静的トランスフォームを指すコマンド（ブロックなど、行列を写す必要が無いもの）
+	std::vector<RenderCommand> staticCommands;
+	// 動くオブジェクト
+	std::vector<Item> items;
+
+	/// <summary>
+	/// 空にする（容量は保持）
+	/// </summary>
+	void Clear() {
+		staticCommands.clear();
+		items.clear();
+	}
+
+	/// <summary>
+	/// 動くオブジェクトを1つ写す
+	/// </summary>
+	/// <param name="modelId"></param>
+	/// <param name="worldTransform"></param>
+	/// <param name="materialId"></param>
+	void Add(uint32_t modelId, const KamataEngine::WorldTransform& worldTransform, uint32_t materialId = 0) { items.push_back(Item{modelId, materialId, worldTransform.matWorld_}); }
+	/// <summary>
+	/// 動くオブジェクトを行列だけで1つ写す（WorldTransform を持たないもの）
+	/// </summary>
+	/// <param name="modelId"></param>
+	/// <param name="matWorld"></param>
+	/// <param name="materialId"></param>
+	void Add(uint32_t modelId, const KamataEngine::Matrix4x4& matWorld, uint32_t materialId = 0) { items.push_back(Item{modelId, materialId, matWorld}); }
+
+	/// <summary>
+	/// 静的トランスフォームの連続した範囲を1コマンドで積む
+	/// </summary>
+	void AddStatic(uint32_t modelId, uint32_t materialId, uint32_t firstTransformIndex, uint32_t instanceCount) {
+		if (instanceCount > 0) {
+			staticCommands.push_back(RenderCommand{modelId, materialId, firstTransformIndex, instanceCount});
+		}
+	}
+};
+
+/// <summary>
+/// シミュレーションと描画コマンドの組み立てを2スレッドに分ける
+/// （フレーム N の記録から描画スレッドがコマンドを組み立てる間に、メインスレッドはフレーム N+1 を更新する）
+/// </summary>
+class RenderPipeline {
+public:
+	// 記録の面数（書き込み中と組み立て中・描画待ちで2面）
+	static inline const uint32_t kSlotCount = 2;
+	// 1面あたり最初に作っておくトランスフォームの数
+	static inline const uint32_t kInitialTransformCount = 64;
+
+private:
+	/// <summary>
+	/// 記録1面分（記録・組み立てたキュー・写した行列・カメラ）
+	/// </summary>
+	struct Slot {
+		FrameSnapshot snapshot;
+		RenderQueue queue;
+		// 動くオブジェクトの行列を写す先（描画スレッドが転送する。足りなければ増やす）
+		std::vector<KamataEngine::WorldTransform*> transforms;
+		// 描画時点のカメラ（ビュー・射影だけを写す）
+		KamataEngine::Camera camera;
+	};
+
+	Slot slots_[kSlotCount];
+
+	// バックエンドの静的トランスフォームの数（動くオブジェクトはこの後ろに並べる）
+	uint32_t staticTransformCount_ = 0;
+
+	// 描画スレッドに終了を伝えるフレーム番号
+	static inline const uint64_t kQuitFrame = UINT64_MAX;
+
+	// 受け渡し（ロックは使わず、フレーム番号の atomic だけで行う）
+	// 組み立てが終わった最新のフレーム
+	std::atomic<uint64_t> builtFrame_ = 0;
+	// 描画スレッドに頼んだ最新のフレーム（その場で組み立てたフレームは入れない）
+	std::atomic<uint64_t> requestedFrame_ = 0;
+
+	// 以下はメインスレッドだけが触る
+	// 書き込み中のフレーム
+	uint64_t writingFrame_ = 0;
+	// 書き終えた最新のフレーム
+	uint64_t publishedFrame_ = 0;
+	// 最後に描いたフレーム
+	uint64_t executedFrame_ = 0;
+	// Reset した時点のフレーム（これ以前の記録は描かない）
+	uint64_t resetFrame_ = 0;
+
+	std::thread thread_;
+
+public:
+	~RenderPipeline();
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="staticTransformCount">バックエンドの静的トランスフォームの数</param>
+	/// <param name="useThread">描画スレッドを立てるか（false なら Publish でその場で組み立てる）</param>
+	void Initialize(uint32_t staticTransformCount, bool useThread);
+
+	/// <summary>
+	/// 描画スレッドを止めて解放
+	/// </summary>
+	void Finalize();
+
+	/// <summary>
+	/// 次のフレームを書き込む記録を取り出す（2フレーム前の組み立てが終わるまで待つ）
+	/// </summary>
+	/// <returns></returns>
+	FrameSnapshot& BeginSnapshot();
+
+	/// <summary>
+	/// 書き終えた記録を描画スレッドに渡す
+	/// </summary>
+	void Publish();
+
+	/// <summary>
+	/// 組み立て済みの最新のフレームを描く（メインスレッドで呼ぶ。D3D のコマンドリストは1本なので記録はここで行う）
+	/// 1つ前のフレームがあればそちらを描くので、描画はシミュレーションより1フレーム遅れる
+	/// </summary>
+	/// <param name="backend"></param>
+	void Execute(ModelRenderBackend& backend);
+
+	/// <summary>
+	/// 記録を全て捨てる（シーンのやり直しなど。描画スレッドの組み立てが終わるまで待つ）
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	bool IsThreaded() const { return thread_.joinable(); }
+	uint64_t GetPublishedFrame() const { return publishedFrame_; }
+	uint64_t GetExecutedFrame() const { return executedFrame_; }
+
+private:
+	/// <summary>
+	/// 描画スレッドの処理
+	/// </summary>
+	void RenderThreadMain();
+
+	/// <summary>
+	/// 記録から行列を転送し、コマンドを組み立ててバッチ化する
+	/// </summary>
+	/// <param name="slot"></param>
+	void Build(Slot& slot);
+
+	/// <summary>
+	/// builtFrame_ が frame 以上になるまで待つ
+	/// </summary>
+	/// <param name="frame"></param>
+	void WaitBuilt(uint64_t frame);
+};
@@ -0,0 +1,139 @@
+#include "RenderQueue.h"
+#include <algorithm>
+
+///===========================================
+/// NullRenderBackend
+/// ===========================================
+
+void NullRenderBackend::BeginFrame() {
+	++stats_.frames;
+
+	// フレームの頭では状態が未確定
+	currentModelId_ = UINT32_MAX;
+	currentMaterialId_ = UINT32_MAX;
+}
+
+void NullRenderBackend::DrawBatch(const RenderBatch& batch, const RenderCommand* commands) {
+	(void)commands;
+
+	++stats_.batches;
+	stats_.commands += batch.commandCount;
+	stats_.instances += batch.instanceCount;
+
+	// 状態の切り替えを数える
+	if (batch.modelId != currentModelId_) {
+		++stats_.modelChanges;
+		currentModelId_ = batch.modelId;
+	}
+	if (batch.materialId != currentMaterialId_) {
+		++stats_.materialChanges;
+		currentMaterialId_ = batch.materialId;
+	}
+}
+
+/// <summary>
+/// 統計のリセット
+/// </summary>
+void NullRenderBackend::ResetStats() { stats_ = {}; }
+
+///===========================================
+/// RenderQueue
+/// ===========================================
+
+/// <summary>
+/// 容量の確保
+/// </summary>
+/// <param name="commandCount"></param>
+void RenderQueue::Reserve(size_t commandCount) {
+	commands_.reserve(commandCount);
+	batches_.reserve(commandCount);
+}
+
+/// <summary>
+/// 溜まったコマンドを破棄（容量は保持）
+/// </summary>
+void RenderQueue::Clear() {
+	commands_.clear();
+	batches_.clear();
+}
+
+/// <summary>
+/// コマンドを積む
+/// </summary>
+/// <param name="command"></param>
+void RenderQueue::Submit(const RenderCommand& command) {
+	// 空のコマンドは積まない
+	if (command.instanceCount == 0) {
+		return;
+	}
+
+	commands_.push_back(command);
+}
+
+/// <summary>
+/// 1オブジェクト分のコマンドを積む
+/// </summary>
+void RenderQueue::Submit(uint32_t modelId, uint32_t materialId, uint32_t transformIndex) { Submit(RenderCommand{modelId, materialId, transformIndex, 1}); }
+
+/// <summary>
+/// 連続したトランスフォームをまとめて1コマンドとして積む
+/// </summary>
+void RenderQueue::SubmitInstanced(uint32_t modelId, uint32_t materialId, uint32_t firstTransformIndex, uint32_t instanceCount) {
+	Submit(RenderCommand{modelId, materialId, firstTransformIndex, instanceCount});
+}
+
+/// <summary>
+/// モデル/マテリアル順にソートし、同じ組み合わせをバッチにまとめる
+/// </summary>
+void RenderQueue::BuildBatches() {
+	batches_.clear();
+
+	// モデル → マテリアル → トランスフォーム順（同じ入力なら毎回同じ並びになる）
+	std::sort(commands_.begin(), commands_.end(), [](const RenderCommand& a, const RenderCommand& b) {
+		if (a.modelId != b.modelId) {
+			return a.modelId < b.modelId;
+		}
+		if (a.materialId != b.materialId) {
+			return a.materialId < b.materialId;
+		}
+		return a.transformIndex < b.transformIndex;
+	});
+
+	for (uint32_t i = 0; i < static_cast<uint32_t>(commands_.size()); ++i) {
+		const RenderCommand& command = commands_[i];
+
+		// 直前のバッチと同じモデル・マテリアルならインスタンスとして合流
+		if (!batches_.empty()) {
+			RenderBatch& last = batches_.back();
+			if (last.modelId == command.modelId && last.materialId == command.materialId) {
+				++last.commandCount;
+				last.instanceCount += command.instanceCount;
+				continue;
+			}
+		}
+
+		batches_.push_back(RenderBatch{command.modelId, command.materialId, i, 1, command.instanceCount});
+	}
+}
+
+/// <summary>
+/// BuildBatches 済みのバッチをバックエンドに描画させる（キューは空にしない）
+/// </summary>
+/// <param name="backend"></param>
+void RenderQueue::Draw(RenderBackend& backend) const {
+	backend.BeginFrame();
+	for (const RenderBatch& batch : batches_) {
+		backend.DrawBatch(batch, commands_.data() + batch.firstCommand);
+	}
+	backend.EndFrame();
+}
+
+/// <summary>
+/// バッチ化してバックエンドに描画させ、キューを空にする
+/// </summary>
+/// <param name="backend"></param>
+void RenderQueue::Flush(RenderBackend& backend) {
+	BuildBatches();
+	Draw(backend);
+	Clear();
+}
@@ -0,0 +1,141 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// 描画コマンド（1オブジェクト分の描画要求）
+/// </summary>
+struct RenderCommand {
+	uint32_t modelId;        // モデルID（バックエンドに登録した番号）
+	uint32_t materialId;     // マテリアルID（0はモデル既定）
+	uint32_t transformIndex; // トランスフォームテーブルの先頭インデックス
+	uint32_t instanceCount;  // 先頭から連続するトランスフォームの個数
+};
+
+/// <summary>
+/// 同じモデル・マテリアルのコマンドをまとめたインスタンスバッチ
+/// </summary>
+struct RenderBatch {
+	uint32_t modelId;
+	uint32_t materialId;
+	uint32_t firstCommand;  // ソート済みコマンド列での開始位置
+	uint32_t commandCount;  // バッチに含まれるコマンド数
+	uint32_t instanceCount; // バッチに含まれる総インスタンス数
+};
+
+/// <summary>
+/// 描画バックエンド（実際の描画APIとの橋渡し）
+/// </summary>
+class RenderBackend {
+public:
+	virtual ~RenderBackend() = default;
+
+	/// <summary>
+	/// フレーム開始
+	/// </summary>
+	virtual void BeginFrame() {}
+	/// <summary>
+	/// バッチ1つ分の描画
+	/// </summary>
+	/// <param name="batch">バッチ</param>
+	/// <param name="commands">バッチの先頭コマンド</param>
+	virtual void DrawBatch(const RenderBatch& batch, const RenderCommand* commands) = 0;
+	/// <summary>
+	/// フレーム終了
+	/// </summary>
+	virtual void EndFrame() {}
+};
+
+/// <summary>
+/// 何も描画せず、バッチ数や状態切り替え回数だけを数えるバックエンド（GPU無しでの計測用）
+/// </summary>
+class NullRenderBackend : public RenderBackend {
+public:
+	struct Stats {
+		uint32_t frames = 0;          // フレーム数
+		uint32_t batches = 0;         // バッチ数（＝ドローコール数）
+		uint32_t commands = 0;        // コマンド数
+		uint32_t instances = 0;       // インスタンス数
+		uint32_t modelChanges = 0;    // モデルの切り替え回数
+		uint32_t materialChanges = 0; // マテリアルの切り替え回数
+	};
+
+private:
+	Stats stats_;
+
+	// 直前のバッチの状態
+	uint32_t currentModelId_ = UINT32_MAX;
+	uint32_t currentMaterialId_ = UINT32_MAX;
+
+public:
+	void BeginFrame() override;
+	void DrawBatch(const RenderBatch& batch, const RenderCommand* commands) override;
+
+	/// <summary>
+	/// 統計のリセット
+	/// </summary>
+	void ResetStats();
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const Stats& GetStats() const { return stats_; }
+};
+
+/// <summary>
+/// 1フレーム分の描画コマンドを溜めて、ソート・バッチ化してからバックエンドへ流すキュー
+/// </summary>
+class RenderQueue {
+private:
+	std::vector<RenderCommand> commands_;
+	std::vector<RenderBatch> batches_;
+
+public:
+	/// <summary>
+	/// 容量の確保
+	/// </summary>
+	/// <param name="commandCount"></param>
+	void Reserve(size_t commandCount);
+	/// <summary>
+	/// 溜まったコマンドを破棄（容量は保持）
+	/// </summary>
+	void Clear();
+
+	/// <summary>
+	/// コマンドを積む
+	/// </summary>
+	/// <param name="command"></param>
+	void Submit(const RenderCommand& command);
+	/// <summary>
+	/// 1オブジェクト分のコマンドを積む
+	/// </summary>
+	void Submit(uint32_t modelId, uint32_t materialId, uint32_t transformIndex);
+	/// <summary>
+	/// 連続したトランスフォームをまとめて1コマンドとして積む
+	/// </summary>
+	void SubmitInstanced(uint32_t modelId, uint32_t materialId, uint32_t firstTransformIndex, uint32_t instanceCount);
+
+	/// <summary>
+	/// モデル/マテリアル順にソートし、同じ組み合わせをバッチにまとめる
+	/// </summary>
+	void BuildBatches();
+	/// <summary>
+	/// BuildBatches 済みのバッチをバックエンドに描画させる（キューは空にしない）
+	/// </summary>
+	/// <param name="backend"></param>
+	void Draw(RenderBackend& backend) const;
+	/// <summary>
+	/// バッチ化してバックエンドに描画させ、キューを空にする
+	/// </summary>
+	/// <param name="backend"></param>
+	void Flush(RenderBackend& backend);
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<RenderCommand>& GetCommands() const { return commands_; }
+	const std::vector<RenderBatch>& GetBatches() const { return batches_; }
+};
@@ -1,86 +1,303 @@
+#define NOMINMAX
 #include "SceneManager.h"
+#include "AllocationTracker.h"
+#include "AssetCache.h"
+#include "FrameStats.h"
 #include "GameScene.h"
+#include "TitleScene.h"
+#include "TutorialScene.h"
+#include <Windows.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
 
-// デストラクタ
+using namespace KamataEngine;
+
+namespace {
+
+// シーン名（ログ用）
+const char* const kSceneNames[] = {"title", "tutorial", "game"};
+
+size_t ToIndex(SceneManager::Scene scene) { return static_cast<size_t>(scene); }
+
+} // namespace
+
+/// <summary>
+/// デストラクタ
+/// </summary>
 SceneManager::~SceneManager() {
-	// ゲームシーン
-	delete gameScene_;
+	// 準備中のシーンがあれば終わるまで待つ
+	preloader_.Wait();
+
+	for (size_t i = 0; i < warmedModels_.size(); ++i) {
+		ReleaseWarmedModels(static_cast<Scene>(i));
+	}
+
+	for (BaseScene*& scene : scenes_) {
+		delete scene;
+		scene = nullptr;
+	}
+	stack_.clear();
 }
-// 初期化
-void SceneManager::Initialize() { 
-	//起動時のシーン
-	scene_ = Scene::kGamePlay;
-	//ゲームシーンの生成
-	gameScene_ = new GameScene();
-	//ゲームシーンの初期化
-	gameScene_->Initialize();
+
+/// <summary>
+/// 初期化
+/// </summary>
+/// <param name="first">最初のシーン</param>
+void SceneManager::Initialize(Scene first) { Push(first); }
+
+/// <summary>
+/// 更新（シーン遷移 → 現在のシーンの更新）
+/// </summary>
+void SceneManager::Update() {
+	// シーン切り替え（切り替えたフレームの時間を記録）
+	Scene previousScene = GetCurrentScene();
+	std::chrono::steady_clock::time_point changeStart = std::chrono::steady_clock::now();
+	ChangeScene();
+	if (GetCurrentScene() != previousScene) {
+		double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - changeStart).count();
+		timings_.worstChange = std::max(timings_.worstChange, milliseconds);
+		FrameStats::GetInstance()->Record("SceneManager.Change", milliseconds);
+		Report("change to", GetCurrentScene(), milliseconds);
+	}
+
+	if (!stack_.empty()) {
+		scenes_[ToIndex(stack_.back())]->Update();
+	}
 }
-// シーンのチェンジ
-void SceneManager::ChangeScene() {
-	switch (scene_) { 
-	case Scene::kTitle:
-	
-	break;
-	case Scene::kSelect:
 
-		break;
-	case Scene::kGamePlay:
+/// <summary>
+/// 描画
+/// </summary>
+void SceneManager::Draw() {
+	if (!stack_.empty()) {
+		scenes_[ToIndex(stack_.back())]->Draw();
+	}
+}
 
-		break;
-	case Scene::kGameClear:
+/// <summary>
+/// 次のシーンの準備を裏で始める（作成済みなら何もしない）
+/// </summary>
+/// <param name="scene"></param>
+void SceneManager::Prepare(Scene scene) {
+	// 作成済みか、準備は1つずつ
+	if (scenes_[ToIndex(scene)] || preparingScene_ != Scene::kCount) {
+		return;
+	}
 
-		break;
-	case Scene::kGameOver:
+	BaseScene* created = Create(scene);
+	scenes_[ToIndex(scene)] = created;
+	preparingScene_ = scene;
+	preloader_.Start([created]() { created->Prepare(); });
+}
 
-		break;
+/// <summary>
+/// 待たずに切り替えられるか
+/// </summary>
+/// <param name="scene"></param>
+/// <returns></returns>
+bool SceneManager::IsReady(Scene scene) const {
+	if (!scenes_[ToIndex(scene)]) {
+		return false;
 	}
+	return preparingScene_ != scene || preloader_.IsReady();
 }
-// 更新
-void SceneManager::Update() {
-	//シーンチェンジの処理
-	ChangeScene();
 
-	switch (scene_) {
-	case Scene::kTitle:
+/// <summary>
+/// シーンを積んで切り替える
+/// </summary>
+/// <param name="scene"></param>
+void SceneManager::Push(Scene scene) {
+	if (!scenes_[ToIndex(scene)]) {
+		scenes_[ToIndex(scene)] = Create(scene);
+	}
 
-		break;
-	case Scene::kSelect:
+	Activate(scene);
+	stack_.push_back(scene);
+}
 
-		break;
-	case Scene::kGamePlay:
+/// <summary>
+/// 現在のシーンを降ろして、下のシーンを Reset して再開
+/// </summary>
+void SceneManager::Pop() {
+	// 一番下のシーンは降ろさない
+	if (stack_.size() <= 1) {
+		return;
+	}
 
-		//ゲームシーンの更新
-		gameScene_->Update();
+	stack_.pop_back();
+	Activate(stack_.back());
+}
 
-		break;
-	case Scene::kGameClear:
+/// <summary>
+/// 現在のシーンを Reset してやり直す
+/// </summary>
+void SceneManager::Restart() {
+	if (!stack_.empty()) {
+		Activate(stack_.back());
+	}
+}
 
-		break;
-	case Scene::kGameOver:
+/// <summary>
+/// シーン遷移のルール
+/// </summary>
+void SceneManager::ChangeScene() {
+	if (stack_.empty()) {
+		return;
+	}
+
+	switch (stack_.back()) {
+	case Scene::kTitle: {
+		TitleScene* titleScene = static_cast<TitleScene*>(scenes_[ToIndex(Scene::kTitle)]);
+		auto* in = Input::GetInstance();
+
+		// --- ホットキー ---
+		// 1 or G -> 本編 / 2 or T -> チュートリアル（準備が済み次第切り替える）
+		if (in->TriggerKey(DIK_1) || in->TriggerKey(DIK_G)) {
+			requestedScene_ = Scene::kGame;
+		}
+		if (in->TriggerKey(DIK_2) || in->TriggerKey(DIK_T)) {
+			requestedScene_ = Scene::kTutorial;
+		}
+		if (requestedScene_ != Scene::kCount) {
+			Prepare(requestedScene_);
+		}
+
+		// フェードアウトの間に本編の準備を進めておく（何も指定が無ければデフォルトは本編へ）
+		if (titleScene->IsFadingOut()) {
+			Prepare(Scene::kGame);
+		}
 
+		// 切り替え先のモデルを1フレーム1個ずつ読み込んでおく（フェードアウトの1秒で足りる）
+		Scene target = requestedScene_;
+		if (target == Scene::kCount && (titleScene->IsFadingOut() || titleScene->IsFinished())) {
+			target = Scene::kGame;
+		}
+		bool isWarmedUp = target != Scene::kCount && WarmUpModels(target);
+
+		Scene next = requestedScene_;
+		if (next == Scene::kCount && titleScene->IsFinished()) {
+			next = Scene::kGame;
+		}
+
+		// 準備・読み込みが済んでいなければ、タイトルを出したまま待つ
+		if (next != Scene::kCount && IsReady(next) && isWarmedUp) {
+			requestedScene_ = Scene::kCount;
+			Push(next);
+		}
+	} break;
+
+	case Scene::kTutorial:
+	case Scene::kGame: {
+		BaseScene* current = scenes_[ToIndex(stack_.back())];
+		if (current->IsFinished()) {
+			if (current->IsRetryRequested()) {
+				// 死亡 → その場でやり直し
+				Restart();
+			} else {
+				// 終了 → タイトルへ
+				Pop();
+			}
+		}
+	} break;
+
+	default:
 		break;
 	}
 }
-// 描画
-void SceneManager::Draw() {
-switch (scene_) {
+
+/// <summary>
+/// シーンの生成
+/// </summary>
+BaseScene* SceneManager::Create(Scene scene) {
+	switch (scene) {
 	case Scene::kTitle:
+		return new TitleScene();
+	case Scene::kTutorial:
+		return new TutorialScene();
+	case Scene::kGame:
+		return new GameScene();
+	default:
+		return nullptr;
+	}
+}
 
-		break;
-	case Scene::kSelect:
+/// <summary>
+/// Initialize で使うモデルを1フレーム1個ずつ AssetCache に読み込む（切り替えフレームではキャッシュから引くだけにする）
+/// </summary>
+/// <param name="scene"></param>
+/// <returns>全て読み込み済みか</returns>
+bool SceneManager::WarmUpModels(Scene scene) {
+	BaseScene* target = scenes_[ToIndex(scene)];
+	if (!target) {
+		return false;
+	}
+	if (isInitialized_[ToIndex(scene)]) {
+		return true;
+	}
 
-		break;
-	case Scene::kGamePlay:
+	const std::vector<std::string>& names = target->GetModelNames();
+	std::vector<const Model*>& warmed = warmedModels_[ToIndex(scene)];
+	if (warmed.size() < names.size()) {
+		ALLOCATION_TAG(AllocationTag::kScene);
+		// 参照は Initialize が取るまで持っておく（参照0で解放する設定でも残る）
+		warmed.push_back(AssetCache::GetInstance()->AcquireModel(names[warmed.size()], true));
+	}
+	return warmed.size() == names.size();
+}
 
-		//ゲームシーンの描画
-		gameScene_->Draw();
+/// <summary>
+/// 読み込んでおいたモデルの参照を返す
+/// </summary>
+/// <param name="scene"></param>
+void SceneManager::ReleaseWarmedModels(Scene scene) {
+	for (const Model* model : warmedModels_[ToIndex(scene)]) {
+		AssetCache::GetInstance()->ReleaseModel(model);
+	}
+	warmedModels_[ToIndex(scene)].clear();
+}
 
-		break;
-	case Scene::kGameClear:
+/// <summary>
+/// 初回は Initialize、2回目以降は Reset
+/// </summary>
+void SceneManager::Activate(Scene scene) {
+	// 準備中なら回収してから
+	if (preparingScene_ == scene) {
+		preloader_.Wait();
+		preparingScene_ = Scene::kCount;
+	}
 
-		break;
-	case Scene::kGameOver:
+	ALLOCATION_TAG(AllocationTag::kScene);
 
-		break;
+	BaseScene* target = scenes_[ToIndex(scene)];
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+	if (!isInitialized_[ToIndex(scene)]) {
+		target->Initialize();
+		isInitialized_[ToIndex(scene)] = true;
+		ReleaseWarmedModels(scene);
+
+		timings_.initialize[ToIndex(scene)] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		Report("initialize", scene, timings_.initialize[ToIndex(scene)]);
+	} else {
+		target->Reset();
+
+		timings_.reset[ToIndex(scene)] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		Report("reset", scene, timings_.reset[ToIndex(scene)]);
 	}
-}
\ No newline at end of file
+}
+
+/// <summary>
+/// 計測結果の出力
+/// </summary>
+void SceneManager::Report(const char* label, Scene scene, double milliseconds) {
+#ifdef _DEBUG
+	char message[128];
+	std::snprintf(message, sizeof(message), "scene %s %s: %.3f ms%s\n", label, kSceneNames[ToIndex(scene)], milliseconds, milliseconds > kFrameBudgetMs ? " OVER BUDGET" : "");
+	OutputDebugStringA(message);
+#else
+	(void)label;
+	(void)scene;
+	(void)milliseconds;
+#endif
+}
@@ -1,34 +1,134 @@
 #pragma once
+#include "BaseScene.h"
+#include "KamataEngine.h"
+#include "ScenePreloader.h"
 
-// 前方宣言
-class GameScene;
+#include <array>
+#include <cstddef>
+#include <vector>
 
+/// <summary>
+/// シーンスタック（シーンは一度作ったら終了まで持ち続け、戻ってきたときは Reset で再開する）
+/// </summary>
 class SceneManager {
-private:
+public:
 	enum class Scene {
-		kUnknown = 0,
 		kTitle,    // タイトル
-		kSelect,  // 選択
-		kGamePlay, // ゲームプレイ
-		kGameClear,    // ゲームクリア
-		kGameOver, // ゲームオーバー
+		kTutorial, // チュートリアル
+		kGame,     // ゲームプレイ
+
+		kCount // 要素数（「無し」としても使う）
+	};
+
+	// 計測結果（ミリ秒）
+	struct Timings {
+		double worstChange = 0.0;                                          // 切り替えフレームの最大
+		std::array<double, static_cast<size_t>(Scene::kCount)> initialize{}; // 最初の Initialize
+		std::array<double, static_cast<size_t>(Scene::kCount)> reset{};      // 直近の Reset
 	};
 
-	// 現在のシーン
-	Scene scene_ = Scene::kUnknown;
+	// 1フレームの予算（ミリ秒）
+	static inline const double kFrameBudgetMs = 1000.0 / 60.0;
+
+private:
+	// シーンの実体
+	std::array<BaseScene*, static_cast<size_t>(Scene::kCount)> scenes_ = {};
+	// Initialize 済みか
+	std::array<bool, static_cast<size_t>(Scene::kCount)> isInitialized_ = {};
+
+	// シーンスタック（末尾が現在のシーン）
+	std::vector<Scene> stack_;
+
+	// 裏で準備中のシーン
+	Scene preparingScene_ = Scene::kCount;
+	ScenePreloader preloader_;
 
-	GameScene* gameScene_ = nullptr;
+	// 切り替え前に読み込んで参照を持っているモデル（Initialize が取ったあとで返す）
+	std::array<std::vector<const KamataEngine::Model*>, static_cast<size_t>(Scene::kCount)> warmedModels_;
+
+	// ホットキーで選ばれた次のシーン
+	Scene requestedScene_ = Scene::kCount;
+
+	Timings timings_;
 
 public:
-	//デストラクタ
+	/// <summary>
+	/// デストラクタ
+	/// </summary>
 	~SceneManager();
-	//初期化
-	void Initialize();
-	// シーンのチェンジ
-	void ChangeScene();
-	//更新
+
+	/// <summary>
+	/// 初期化
+	/// </summary>
+	/// <param name="first">最初のシーン</param>
+	void Initialize(Scene first = Scene::kTitle);
+	/// <summary>
+	/// 更新（シーン遷移 → 現在のシーンの更新）
+	/// </summary>
 	void Update();
-	//描画
+	/// <summary>
+	/// 描画
+	/// </summary>
 	void Draw();
-	
+
+	/// <summary>
+	/// 次のシーンの準備を裏で始める（作成済みなら何もしない）
+	/// </summary>
+	/// <param name="scene"></param>
+	void Prepare(Scene scene);
+	/// <summary>
+	/// 待たずに切り替えられるか
+	/// </summary>
+	/// <param name="scene"></param>
+	/// <returns></returns>
+	bool IsReady(Scene scene) const;
+	/// <summary>
+	/// シーンを積んで切り替える
+	/// </summary>
+	/// <param name="scene"></param>
+	void Push(Scene scene);
+	/// <summary>
+	/// 現在のシーンを降ろして、下のシーンを Reset して再開
+	/// </summary>
+	void Pop();
+	/// <summary>
+	/// 現在のシーンを Reset してやり直す
+	/// </summary>
+	void Restart();
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	Scene GetCurrentScene() const { return stack_.empty() ? Scene::kCount : stack_.back(); }
+	const Timings& GetTimings() const { return timings_; }
+
+private:
+	/// <summary>
+	/// シーン遷移のルール
+	/// </summary>
+	void ChangeScene();
+	/// <summary>
+	/// シーンの生成
+	/// </summary>
+	static BaseScene* Create(Scene scene);
+	/// <summary>
+	/// Initialize で使うモデルを1フレーム1個ずつ AssetCache に読み込む（切り替えフレームではキャッシュから引くだけにする）
+	/// </summary>
+	/// <param name="scene"></param>
+	/// <returns>全て読み込み済みか</returns>
+	bool WarmUpModels(Scene scene);
+	/// <summary>
+	/// 読み込んでおいたモデルの参照を返す
+	/// </summary>
+	/// <param name="scene"></param>
+	void ReleaseWarmedModels(Scene scene);
+	/// <summary>
+	/// 初回は Initialize、2回目以降は Reset
+	/// </summary>
+	void Activate(Scene scene);
+	/// <summary>
+	/// 計測結果の出力
+	/// </summary>
+	static void Report(const char* label, Scene scene, double milliseconds);
 };
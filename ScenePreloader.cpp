@@ -0,0 +1,66 @@
+#include "ScenePreloader.h"
+#include "Profiler.h"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+/// <summary>
+/// デストラクタ（準備中なら終わるまで待つ）
+/// </summary>
+ScenePreloader::~ScenePreloader() {
+	if (future_.valid()) {
+		future_.wait();
+	}
+}
+
+/// <summary>
+/// 準備を開始（GPUリソースには触れない処理だけを渡すこと）
+/// </summary>
+/// <param name="prepare"></param>
+void ScenePreloader::Start(std::function<void()> prepare) {
+	// 前回分が残っていれば先に回収
+	Wait();
+
+	future_ = std::async(std::launch::async, [prepare = std::move(prepare)]() {
+		PROFILE_THREAD_NAME("ScenePreloader");
+		PROFILE_ZONE("ScenePreloader::Prepare");
+		prepare();
+	});
+}
+
+/// <summary>
+/// 準備が終わったか（待たない）
+/// </summary>
+/// <returns></returns>
+bool ScenePreloader::IsReady() const { return future_.valid() && future_.wait_for(std::chrono::seconds(0)) == std::future_status::ready; }
+
+/// <summary>
+/// 準備が終わるまで待って回収する
+/// </summary>
+void ScenePreloader::Wait() {
+	if (future_.valid()) {
+		// 準備中の例外はここで呼び出し元へ
+		future_.get();
+	}
+}
+
+/// <summary>
+/// Resources/name/ 以下のファイルを読んでOSのキャッシュに載せておく
+/// </summary>
+/// <param name="modelNames"></param>
+void ScenePreloader::PrefetchModelFiles(const std::vector<std::string>& modelNames) {
+	std::vector<char> buffer(64 * 1024);
+
+	for (const std::string& name : modelNames) {
+		std::error_code errorCode;
+		for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator("Resources/" + name, errorCode)) {
+			if (!entry.is_regular_file()) {
+				continue;
+			}
+
+			std::ifstream file(entry.path(), std::ios::binary);
+			while (file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+			}
+		}
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <functional>
+#include <future>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 次のシーンの準備（ファイル読み込み・マップ解析など）をワーカースレッドで進める
+/// </summary>
+class ScenePreloader {
+private:
+	std::future<void> future_;
+
+public:
+	/// <summary>
+	/// デストラクタ（準備中なら終わるまで待つ）
+	/// </summary>
+	~ScenePreloader();
+
+	/// <summary>
+	/// 準備を開始（GPUリソースには触れない処理だけを渡すこと）
+	/// </summary>
+	/// <param name="prepare"></param>
+	void Start(std::function<void()> prepare);
+
+	/// <summary>
+	/// 準備中か、準備済みで未回収か
+	/// </summary>
+	/// <returns></returns>
+	bool IsStarted() const { return future_.valid(); }
+	/// <summary>
+	/// 準備が終わったか（待たない）
+	/// </summary>
+	/// <returns></returns>
+	bool IsReady() const;
+	/// <summary>
+	/// 準備が終わるまで待って回収する
+	/// </summary>
+	void Wait();
+
+	/// <summary>
+	/// Resources/name/ 以下のファイルを読んでOSのキャッシュに載せておく
+	/// </summary>
+	/// <param name="modelNames"></param>
+	static void PrefetchModelFiles(const std::vector<std::string>& modelNames);
+};
@@ -0,0 +1,182 @@
+#pragma once
+#include "KamataEngine.h"
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/// <summary>
+/// ゲームの状態を1本のバイト列に詰めた記録（ポインタを含まないので、丸ごとコピーすれば複製できる）
+/// 各クラスが SaveState で自分の POD の状態を書き、LoadState で同じ順に読む
+/// </summary>
+class SimulationSnapshot {
+public:
+	// 記録の先頭の目印
+	static inline const uint32_t kMagic = 0x50414E53; // "SNAP"
+	// 並びを変えたら上げる
+	static inline const uint32_t kVersion = 1;
+
+	/// <summary>
+	/// 記録を先頭から読むもの
+	/// </summary>
+	class Reader {
+	private:
+		const uint8_t* cursor_ = nullptr;
+		const uint8_t* end_ = nullptr;
+
+	public:
+		explicit Reader(const SimulationSnapshot& snapshot) : cursor_(snapshot.bytes_.data()), end_(snapshot.bytes_.data() + snapshot.bytes_.size()) {}
+
+		/// <summary>
+		/// 値を1つ読む
+		/// </summary>
+		/// <param name="value"></param>
+		template <typename T> void Read(T& value) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			assert(cursor_ + sizeof(T) <= end_);
+			std::memcpy(&value, cursor_, sizeof(T));
+			cursor_ += sizeof(T);
+		}
+
+		/// <summary>
+		/// 個数つきの配列を読む（容量が足りていれば確保しない）
+		/// </summary>
+		/// <param name="values"></param>
+		template <typename T> void ReadArray(std::vector<T>& values) {
+			static_assert(std::is_trivially_copyable_v<T>);
+			uint32_t count = 0;
+			Read(count);
+			assert(cursor_ + sizeof(T) * count <= end_);
+			values.resize(count);
+			if (count > 0) {
+				std::memcpy(values.data(), cursor_, sizeof(T) * count);
+			}
+			cursor_ += sizeof(T) * count;
+		}
+
+		/// <summary>
+		/// 最後まで読んだか
+		/// </summary>
+		/// <returns></returns>
+		bool IsEnd() const { return cursor_ == end_; }
+	};
+
+	/// <summary>
+	/// WorldTransform のうち、シミュレーションが書き換えるもの
+	/// </summary>
+	struct TransformState {
+		KamataEngine::Vector3 scale;
+		KamataEngine::Vector3 rotation;
+		KamataEngine::Vector3 translation;
+		KamataEngine::Matrix4x4 matWorld;
+
+		/// <summary>
+		/// 写す
+		/// </summary>
+		/// <param name="worldTransform"></param>
+		void Save(const KamataEngine::WorldTransform& worldTransform) {
+			scale = worldTransform.scale_;
+			rotation = worldTransform.rotation_;
+			translation = worldTransform.translation_;
+			matWorld = worldTransform.matWorld_;
+		}
+		/// <summary>
+		/// 戻す（行列は計算し直さずにそのまま戻し、定数バッファへ転送する）
+		/// </summary>
+		/// <param name="worldTransform"></param>
+		void Load(KamataEngine::WorldTransform& worldTransform) const {
+			worldTransform.scale_ = scale;
+			worldTransform.rotation_ = rotation;
+			worldTransform.translation_ = translation;
+			worldTransform.matWorld_ = matWorld;
+			worldTransform.TransferMatrix();
+		}
+	};
+
+private:
+	std::vector<uint8_t> bytes_;
+
+public:
+	/// <summary>
+	/// 書き込みを始める（容量は保持）
+	/// </summary>
+	void Begin() {
+		bytes_.clear();
+		Write(kMagic);
+		Write(kVersion);
+	}
+
+	/// <summary>
+	/// 値を1つ書く
+	/// </summary>
+	/// <param name="value"></param>
+	template <typename T> void Write(const T& value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		size_t offset = bytes_.size();
+		bytes_.resize(offset + sizeof(T));
+		std::memcpy(bytes_.data() + offset, &value, sizeof(T));
+	}
+
+	/// <summary>
+	/// 個数つきで配列を書く
+	/// </summary>
+	/// <param name="values"></param>
+	/// <param name="count"></param>
+	template <typename T> void WriteArray(const T* values, uint32_t count) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		Write(count);
+		size_t offset = bytes_.size();
+		bytes_.resize(offset + sizeof(T) * count);
+		if (count > 0) {
+			std::memcpy(bytes_.data() + offset, values, sizeof(T) * count);
+		}
+	}
+	template <typename T> void WriteArray(const std::vector<T>& values) { WriteArray(values.data(), static_cast<uint32_t>(values.size())); }
+
+	/// <summary>
+	/// 読み始める（先頭の目印と版を確かめる）
+	/// </summary>
+	/// <param name="reader"></param>
+	/// <returns>この版の記録か</returns>
+	bool BeginRead(Reader& reader) const {
+		if (bytes_.size() < sizeof(uint32_t) * 2) {
+			return false;
+		}
+		uint32_t magic = 0;
+		uint32_t version = 0;
+		reader.Read(magic);
+		reader.Read(version);
+		return magic == kMagic && version == kVersion;
+	}
+
+	/// <summary>
+	/// 記録があるか
+	/// </summary>
+	/// <returns></returns>
+	bool IsEmpty() const { return bytes_.empty(); }
+	/// <summary>
+	/// 捨てる（容量は保持）
+	/// </summary>
+	void Clear() { bytes_.clear(); }
+
+	/// <summary>
+	/// 中身のハッシュ（FNV-1a。同じ状態なら別のマシンでも同じ値になるので、同期ずれの検出に使う）
+	/// </summary>
+	/// <returns></returns>
+	uint64_t ComputeHash() const {
+		uint64_t hash = 0xCBF29CE484222325ull;
+		for (uint8_t byte : bytes_) {
+			hash = (hash ^ byte) * 0x100000001B3ull;
+		}
+		return hash;
+	}
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<uint8_t>& GetBytes() const { return bytes_; }
+	size_t GetSize() const { return bytes_.size(); }
+};
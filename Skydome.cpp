@@ -1,5 +1,6 @@
 #include "Skydome.h"
-#include <3d\Model.h>
+#include "RenderPipeline.h"
+#include <3d/Model.h>
 #include <cassert>
 
 using namespace KamataEngine;
@@ -27,4 +28,11 @@ void Skydome::Update() {
 void Skydome::Draw() {
 	//3Dモデルの描画
 	model_->Draw(worldTransform_, *camera_);
-}
\ No newline at end of file
+}
+
+/// <summary>
+/// 描画の記録に写す
+/// </summary>
+/// <param name="snapshot"></param>
+/// <param name="modelId"></param>
+void Skydome::Capture(FrameSnapshot& snapshot, uint32_t modelId) const { snapshot.Add(modelId, worldTransform_); }
\ No newline at end of file
@@ -1,6 +1,8 @@
 #pragma once
 #include "KamataEngine.h"
 
+struct FrameSnapshot;
+
 class Skydome {
 private:
 	// ワールド変換データ
@@ -27,4 +29,11 @@ public:
 	/// 描画
 	/// </summary>
 	void Draw();
+
+	/// <summary>
+	/// 描画の記録に写す（RenderPipeline 用）
+	/// </summary>
+	/// <param name="snapshot"></param>
+	/// <param name="modelId">バックエンドに登録したモデルID</param>
+	void Capture(FrameSnapshot& snapshot, uint32_t modelId) const;
 };
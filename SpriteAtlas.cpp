@@ -0,0 +1,82 @@
+#define NOMINMAX
+#include "SpriteAtlas.h"
+#include "TextureCache.h"
+
+#include <algorithm>
+#include <cassert>
+
+using namespace KamataEngine;
+
+/// <summary>
+/// ページのテクスチャを読む
+/// </summary>
+void SpriteAtlas::Initialize(const SpriteAtlasData& data) {
+	data_ = &data;
+	pageTextures_.clear();
+	pageTextures_.reserve(data.pageCount);
+	for (uint32_t i = 0; i < data.pageCount; ++i) {
+		pageTextures_.push_back(TextureCache::GetInstance()->Load(data.pages[i].path));
+	}
+}
+
+/// <summary>
+/// 名前で引く
+/// </summary>
+const SpriteAtlasEntry* SpriteAtlas::Find(const SpriteAtlasData& data, std::string_view name) {
+	const SpriteAtlasEntry* end = data.entries + data.entryCount;
+	const SpriteAtlasEntry* entry = std::lower_bound(data.entries, end, name, [](const SpriteAtlasEntry& a, std::string_view b) { return std::string_view(a.name) < b; });
+	if (entry == end || std::string_view(entry->name) != name) {
+		return nullptr;
+	}
+	return entry;
+}
+
+/// <summary>
+/// スプライトを作る
+/// </summary>
+Sprite* SpriteAtlas::CreateSprite(std::string_view name, const Vector2& position, const Vector4& color, const Vector2& anchorPoint) const {
+	const SpriteAtlasEntry* entry = Find(name);
+	// 無ければアトラスを作り直す（Tools/AtlasPacker）
+	assert(entry);
+	if (!entry) {
+		return nullptr;
+	}
+
+	// 元画像のアンカーの位置が、詰めた矩形のどこに当たるか
+	const float width = static_cast<float>(entry->width);
+	const float height = static_cast<float>(entry->height);
+	Vector2 anchor = {
+	    (anchorPoint.x * static_cast<float>(entry->sourceWidth) - static_cast<float>(entry->trimX)) / width,
+	    (anchorPoint.y * static_cast<float>(entry->sourceHeight) - static_cast<float>(entry->trimY)) / height,
+	};
+
+	Sprite* sprite = Sprite::Create(pageTextures_[entry->page], position, color, anchor);
+	sprite->SetTextureRect({static_cast<float>(entry->x), static_cast<float>(entry->y)}, {width, height});
+	sprite->SetSize({width, height});
+	return sprite;
+}
+
+/// <summary>
+/// 元画像を size の大きさで描いたのと同じになるようにする
+/// </summary>
+void SpriteAtlas::SetSpriteSize(Sprite* sprite, std::string_view name, const Vector2& size) const {
+	const SpriteAtlasEntry* entry = Find(name);
+	if (!sprite || !entry) {
+		return;
+	}
+	// 詰めた矩形も同じ倍率で
+	float scaleX = size.x / static_cast<float>(entry->sourceWidth);
+	float scaleY = size.y / static_cast<float>(entry->sourceHeight);
+	sprite->SetSize({static_cast<float>(entry->width) * scaleX, static_cast<float>(entry->height) * scaleY});
+}
+
+/// <summary>
+/// 元画像の大きさ
+/// </summary>
+Vector2 SpriteAtlas::GetSourceSize(std::string_view name) const {
+	const SpriteAtlasEntry* entry = Find(name);
+	if (!entry) {
+		return {0.0f, 0.0f};
+	}
+	return {static_cast<float>(entry->sourceWidth), static_cast<float>(entry->sourceHeight)};
+}
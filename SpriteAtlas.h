@@ -0,0 +1,104 @@
+#pragma once
+#include "KamataEngine.h"
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/// <summary>
+/// アトラスの1ページ
+/// </summary>
+struct SpriteAtlasPage {
+	const char* path; // TextureCache::Load に渡すパス
+	uint16_t width;
+	uint16_t height;
+};
+
+/// <summary>
+/// アトラスに詰めた画像1枚（元画像のパスで引く）
+/// </summary>
+struct SpriteAtlasEntry {
+	const char* name; // 元画像のパス（TextureManager::Load に渡していたもの）
+	uint16_t page;
+	uint16_t x; // ページ上の矩形（元画像の透明な余白を詰めたもの。ピクセル）
+	uint16_t y;
+	uint16_t width;
+	uint16_t height;
+	uint16_t trimX; // 詰めた矩形の、元画像の中での左上
+	uint16_t trimY;
+	uint16_t sourceWidth; // 元画像の大きさ
+	uint16_t sourceHeight;
+	float u0; // ページ上の UV
+	float v0;
+	float u1;
+	float v1;
+};
+
+/// <summary>
+/// アトラス全体（Tools/AtlasPacker が生成する表。entries は名前順）
+/// </summary>
+struct SpriteAtlasData {
+	const SpriteAtlasPage* pages;
+	uint32_t pageCount;
+	const SpriteAtlasEntry* entries;
+	uint32_t entryCount;
+};
+
+/// <summary>
+/// 小さな画像を詰めたアトラスから、名前でスプライトを作る
+/// （テクスチャの読み込みはページの数だけ。作ったスプライトは元画像を Sprite::Create したときと同じ位置・大きさに見える）
+/// </summary>
+class SpriteAtlas {
+private:
+	const SpriteAtlasData* data_ = nullptr;
+	// ページごとのテクスチャ
+	std::vector<uint32_t> pageTextures_;
+
+public:
+	/// <summary>
+	/// ページのテクスチャを読む
+	/// </summary>
+	/// <param name="data"></param>
+	void Initialize(const SpriteAtlasData& data);
+
+	/// <summary>
+	/// 名前で引く（無ければ nullptr。二分探索なのでテクスチャを読まなくても使える）
+	/// </summary>
+	/// <param name="data"></param>
+	/// <param name="name"></param>
+	/// <returns></returns>
+	static const SpriteAtlasEntry* Find(const SpriteAtlasData& data, std::string_view name);
+	const SpriteAtlasEntry* Find(std::string_view name) const { return data_ ? Find(*data_, name) : nullptr; }
+
+	/// <summary>
+	/// スプライトを作る（アンカーは元画像に対するもの。詰めた余白の分だけずらして渡す）
+	/// </summary>
+	/// <param name="name"></param>
+	/// <param name="position"></param>
+	/// <param name="color"></param>
+	/// <param name="anchorPoint"></param>
+	/// <returns>無い名前なら nullptr</returns>
+	KamataEngine::Sprite* CreateSprite(std::string_view name, const KamataEngine::Vector2& position, const KamataEngine::Vector4& color = {1, 1, 1, 1},
+	                                   const KamataEngine::Vector2& anchorPoint = {0.0f, 0.0f}) const;
+
+	/// <summary>
+	/// 元画像を size の大きさで描いたのと同じになるよう、スプライトの大きさを決める
+	/// </summary>
+	/// <param name="sprite"></param>
+	/// <param name="name"></param>
+	/// <param name="size">元画像の大きさに対する大きさ</param>
+	void SetSpriteSize(KamataEngine::Sprite* sprite, std::string_view name, const KamataEngine::Vector2& size) const;
+
+	/// <summary>
+	/// 元画像の大きさ（無い名前なら 0）
+	/// </summary>
+	/// <param name="name"></param>
+	/// <returns></returns>
+	KamataEngine::Vector2 GetSourceSize(std::string_view name) const;
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetPageCount() const { return static_cast<uint32_t>(pageTextures_.size()); }
+};
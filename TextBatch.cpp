@@ -0,0 +1,138 @@
+#define NOMINMAX
+#include "TextBatch.h"
+
+#include <algorithm>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 書体に無い文字の幅（空白も無ければ行の高さの半分）
+float GetMissingAdvance(const TextFont& font) {
+	if (font.firstCode <= ' ' && ' ' < font.firstCode + font.glyphCount) {
+		return static_cast<float>(font.glyphs[' ' - font.firstCode].advance);
+	}
+	return font.lineHeight * 0.5f;
+}
+
+} // namespace
+
+/// <summary>
+/// 文字列を積む
+/// </summary>
+float TextBatch::AddText(const TextFont& font, const char* text, const Vector2& position, float scale, uint32_t color, Align align) {
+	const float missingAdvance = GetMissingAdvance(font);
+	const float inverseWidth = 1.0f / font.atlasWidth;
+	const float inverseHeight = 1.0f / font.atlasHeight;
+
+	float maxWidth = 0.0f;
+	float top = position.y;
+	const char* line = text;
+	for (;;) {
+		// 揃えに合わせて行の書き始めを決める
+		float width = MeasureLine(font, line, scale);
+		maxWidth = (std::max)(maxWidth, width);
+		float penX = position.x;
+		if (align == Align::kCenter) {
+			penX -= width * 0.5f;
+		} else if (align == Align::kRight) {
+			penX -= width;
+		}
+
+		const char* c = line;
+		for (; *c != '\0' && *c != '\n'; ++c) {
+			const TextGlyph* glyph = FindGlyph(font, static_cast<unsigned char>(*c));
+			if (!glyph) {
+				penX += missingAdvance * scale;
+				continue;
+			}
+			if (glyph->width > 0 && glyph->height > 0) {
+				float left = penX + static_cast<float>(glyph->offsetX) * scale;
+				float right = left + static_cast<float>(glyph->width) * scale;
+				float glyphTop = top + static_cast<float>(glyph->offsetY) * scale;
+				float bottom = glyphTop + static_cast<float>(glyph->height) * scale;
+				float u0 = static_cast<float>(glyph->x) * inverseWidth;
+				float v0 = static_cast<float>(glyph->y) * inverseHeight;
+				float u1 = static_cast<float>(glyph->x + glyph->width) * inverseWidth;
+				float v1 = static_cast<float>(glyph->y + glyph->height) * inverseHeight;
+
+				vertices_.push_back(TextVertex{left, glyphTop, u0, v0, color});
+				vertices_.push_back(TextVertex{right, glyphTop, u1, v0, color});
+				vertices_.push_back(TextVertex{left, bottom, u0, v1, color});
+				vertices_.push_back(TextVertex{right, bottom, u1, v1, color});
+			}
+			penX += static_cast<float>(glyph->advance) * scale;
+		}
+
+		if (*c == '\0') {
+			break;
+		}
+		line = c + 1;
+		top += font.lineHeight * scale;
+	}
+	return maxWidth;
+}
+
+/// <summary>
+/// タイムを積む
+/// </summary>
+float TextBatch::AddTime(const TextFont& font, uint32_t frame, const Vector2& position, float scale, uint32_t color, Align align) {
+	char buffer[kTimeBufferSize];
+	FormatTime(frame, buffer);
+	return AddText(font, buffer, position, scale, color, align);
+}
+
+/// <summary>
+/// 1行の幅
+/// </summary>
+float TextBatch::MeasureLine(const TextFont& font, const char* text, float scale) {
+	const float missingAdvance = GetMissingAdvance(font);
+
+	float width = 0.0f;
+	for (const char* c = text; *c != '\0' && *c != '\n'; ++c) {
+		const TextGlyph* glyph = FindGlyph(font, static_cast<unsigned char>(*c));
+		width += glyph ? static_cast<float>(glyph->advance) : missingAdvance;
+	}
+	return width * scale;
+}
+
+/// <summary>
+/// frame フレームを "mm:ss.cc" にする
+/// </summary>
+void TextBatch::FormatTime(uint32_t frame, char* buffer) {
+	// 1/100 秒単位（99:59.99 で止める。掛け算であふれないよう先に抑える）
+	uint32_t centiseconds = (std::min)(frame, 6000u * 60) * 100 / 60;
+	centiseconds = (std::min)(centiseconds, 99u * 6000 + 5999);
+	uint32_t minutes = centiseconds / 6000;
+	uint32_t seconds = centiseconds / 100 % 60;
+	uint32_t fraction = centiseconds % 100;
+
+	buffer[0] = static_cast<char>('0' + minutes / 10);
+	buffer[1] = static_cast<char>('0' + minutes % 10);
+	buffer[2] = ':';
+	buffer[3] = static_cast<char>('0' + seconds / 10);
+	buffer[4] = static_cast<char>('0' + seconds % 10);
+	buffer[5] = '.';
+	buffer[6] = static_cast<char>('0' + fraction / 10);
+	buffer[7] = static_cast<char>('0' + fraction % 10);
+	buffer[8] = '\0';
+}
+
+/// <summary>
+/// 0～1の色を RGBA8 に詰める
+/// </summary>
+uint32_t TextBatch::PackColor(float r, float g, float b, float a) {
+	auto toByte = [](float v) { return static_cast<uint32_t>(std::clamp(v, 0.0f, 1.0f) * 255.0f + 0.5f); };
+
+	return (toByte(r) << 24) | (toByte(g) << 16) | (toByte(b) << 8) | toByte(a);
+}
+
+/// <summary>
+/// code の文字
+/// </summary>
+const TextGlyph* TextBatch::FindGlyph(const TextFont& font, unsigned char code) {
+	if (code < font.firstCode || code >= font.firstCode + font.glyphCount) {
+		return nullptr;
+	}
+	return &font.glyphs[code - font.firstCode];
+}
@@ -0,0 +1,128 @@
+#pragma once
+#include "KamataEngine.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// フォントの1文字（アトラス上のピクセル単位）
+/// </summary>
+struct TextGlyph {
+	uint16_t x;      // アトラス上の左上
+	uint16_t y;
+	uint16_t width;  // 大きさ（空白は 0）
+	uint16_t height;
+	int16_t offsetX; // 書き始めの位置・行の上端から見た左上
+	int16_t offsetY;
+	uint16_t advance; // 次の文字までの距離
+};
+
+/// <summary>
+/// 1書体分（文字コード firstCode から順に glyphCount 文字。アトラスは全ての書体で1枚）
+/// </summary>
+struct TextFont {
+	const TextGlyph* glyphs;
+	uint32_t firstCode;
+	uint32_t glyphCount;
+	float lineHeight;
+	float atlasWidth;
+	float atlasHeight;
+};
+
+/// <summary>
+/// 文字の四角形1頂点（左上・右上・左下・右下の順に4つで1文字）
+/// </summary>
+struct TextVertex {
+	float x; // スクリーン座標（ピクセル）
+	float y;
+	float u; // アトラスの UV
+	float v;
+	uint32_t color; // RGBA8（TextBatch::PackColor で作る）
+};
+
+/// <summary>
+/// HUD の文字列・タイムを1本の頂点列にまとめる（CPU だけで完結する。描くのは TextRenderer）
+/// </summary>
+class TextBatch {
+public:
+	// 横の揃え
+	enum class Align {
+		kLeft,
+		kCenter,
+		kRight,
+	};
+
+	// 1文字の頂点数
+	static inline const uint32_t kVerticesPerQuad = 4;
+	// FormatTime が書く最大の文字数（終端を含む。"99:59.99"）
+	static inline const size_t kTimeBufferSize = 9;
+	// 白（TextVertex::color の RGBA8）
+	static inline const uint32_t kColorWhite = 0xFFFFFFFF;
+
+private:
+	std::vector<TextVertex> vertices_;
+
+public:
+	/// <summary>
+	/// quadCount 文字分を先に確保する（描画中に確保しないよう）
+	/// </summary>
+	/// <param name="quadCount"></param>
+	void Reserve(uint32_t quadCount) { vertices_.reserve(static_cast<size_t>(quadCount) * kVerticesPerQuad); }
+
+	/// <summary>
+	/// 空にする（容量は残す）
+	/// </summary>
+	void Clear() { vertices_.clear(); }
+
+	/// <summary>
+	/// 文字列を積む（改行で次の行へ。書体に無い文字は空白として進める）
+	/// </summary>
+	/// <param name="font"></param>
+	/// <param name="text"></param>
+	/// <param name="position">1行目の上端と、揃えの基準になる x</param>
+	/// <param name="scale">アトラスのピクセルに対する倍率</param>
+	/// <param name="color">RGBA8</param>
+	/// <param name="align"></param>
+	/// <returns>一番長い行の幅</returns>
+	float AddText(const TextFont& font, const char* text, const KamataEngine::Vector2& position, float scale, uint32_t color, Align align = Align::kLeft);
+
+	/// <summary>
+	/// frame フレーム（60fps）を "mm:ss.cc" として積む
+	/// </summary>
+	float AddTime(const TextFont& font, uint32_t frame, const KamataEngine::Vector2& position, float scale, uint32_t color, Align align = Align::kLeft);
+
+	/// <summary>
+	/// 1行の幅（改行までを測る）
+	/// </summary>
+	/// <param name="font"></param>
+	/// <param name="text"></param>
+	/// <param name="scale"></param>
+	/// <returns></returns>
+	static float MeasureLine(const TextFont& font, const char* text, float scale);
+
+	/// <summary>
+	/// frame フレーム（60fps）を "mm:ss.cc" にする（99:59.99 で止める）
+	/// </summary>
+	/// <param name="frame"></param>
+	/// <param name="buffer">kTimeBufferSize 文字以上</param>
+	static void FormatTime(uint32_t frame, char* buffer);
+
+	/// <summary>
+	/// 0～1の色を TextVertex::color の RGBA8 に詰める
+	/// </summary>
+	static uint32_t PackColor(float r, float g, float b, float a);
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<TextVertex>& GetVertices() const { return vertices_; }
+	uint32_t GetQuadCount() const { return static_cast<uint32_t>(vertices_.size() / kVerticesPerQuad); }
+
+private:
+	/// <summary>
+	/// code の文字（書体に無ければ nullptr）
+	/// </summary>
+	static const TextGlyph* FindGlyph(const TextFont& font, unsigned char code);
+};
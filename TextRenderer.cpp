@@ -0,0 +1,56 @@
+#define NOMINMAX
+#include "TextRenderer.h"
+#include "TextureCache.h"
+#include <algorithm>
+#include <cassert>
+
+using namespace KamataEngine;
+
+/// <summary>
+/// デストラクタ
+/// </summary>
+TextRenderer::~TextRenderer() {
+	for (Sprite* sprite : sprites_) {
+		delete sprite;
+	}
+	sprites_.clear();
+}
+
+/// <summary>
+/// アトラスを読み、スプライトを作っておく
+/// </summary>
+void TextRenderer::Initialize(const std::string& texturePath, uint32_t atlasWidth, uint32_t atlasHeight, uint32_t quadCount) {
+	textureHandle_ = TextureCache::GetInstance()->Load(texturePath);
+	atlasWidth_ = static_cast<float>(atlasWidth);
+	atlasHeight_ = static_cast<float>(atlasHeight);
+
+	sprites_.reserve(quadCount);
+	while (sprites_.size() < quadCount) {
+		sprites_.push_back(Sprite::Create(textureHandle_, {0.0f, 0.0f}));
+	}
+}
+
+/// <summary>
+/// 描画（文字数は Initialize の quadCount まで）
+/// </summary>
+void TextRenderer::Draw(const TextBatch& batch) {
+	const std::vector<TextVertex>& vertices = batch.GetVertices();
+	// 描画中は確保しない（足りなければ Initialize の quadCount を増やす。リリースでは溢れた分を描かない）
+	assert(batch.GetQuadCount() <= sprites_.size());
+	const uint32_t quadCount = std::min(batch.GetQuadCount(), static_cast<uint32_t>(sprites_.size()));
+
+	for (uint32_t i = 0; i < quadCount; ++i) {
+		// 左上と右下の頂点だけで四角形が決まる
+		const TextVertex& leftTop = vertices[i * TextBatch::kVerticesPerQuad];
+		const TextVertex& rightBottom = vertices[i * TextBatch::kVerticesPerQuad + 3];
+
+		Sprite* sprite = sprites_[i];
+		sprite->SetPosition({leftTop.x, leftTop.y});
+		sprite->SetSize({rightBottom.x - leftTop.x, rightBottom.y - leftTop.y});
+		sprite->SetTextureRect({leftTop.u * atlasWidth_, leftTop.v * atlasHeight_}, {(rightBottom.u - leftTop.u) * atlasWidth_, (rightBottom.v - leftTop.v) * atlasHeight_});
+		uint32_t color = leftTop.color;
+		sprite->SetColor({static_cast<float>(color >> 24) / 255.0f, static_cast<float>((color >> 16) & 0xFF) / 255.0f, static_cast<float>((color >> 8) & 0xFF) / 255.0f,
+		                  static_cast<float>(color & 0xFF) / 255.0f});
+		sprite->Draw();
+	}
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "KamataEngine.h"
+#include "TextBatch.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// TextBatch の頂点列を KamataEngine の Sprite で描く
+/// （エンジンに任意の頂点バッファを描く口が無いので、1文字ずつアトラスの切り出しを変えたスプライトで描く。
+/// テクスチャはアトラス1枚だけで、スプライトは Initialize で決めた数を使い回し、描画中は増やさない）
+/// </summary>
+class TextRenderer {
+private:
+	uint32_t textureHandle_ = 0;
+	float atlasWidth_ = 1.0f;
+	float atlasHeight_ = 1.0f;
+	std::vector<KamataEngine::Sprite*> sprites_;
+
+public:
+	~TextRenderer();
+
+	/// <summary>
+	/// アトラスを読み、quadCount 文字分のスプライトを作っておく
+	/// </summary>
+	/// <param name="texturePath">TextureCache::Load に渡すパス</param>
+	/// <param name="atlasWidth"></param>
+	/// <param name="atlasHeight"></param>
+	/// <param name="quadCount"></param>
+	void Initialize(const std::string& texturePath, uint32_t atlasWidth, uint32_t atlasHeight, uint32_t quadCount);
+
+	/// <summary>
+	/// 描画（Sprite::PreDraw と PostDraw の間で呼ぶ。文字数は Initialize の quadCount まで）
+	/// </summary>
+	/// <param name="batch"></param>
+	void Draw(const TextBatch& batch);
+};
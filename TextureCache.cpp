@@ -0,0 +1,223 @@
+#include "TextureCache.h"
+#include "FileUtility.h"
+#include "MappedFile.h"
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+using namespace KamataEngine;
+
+/// <summary>
+/// インスタンスの取得
+/// </summary>
+/// <returns></returns>
+TextureCache* TextureCache::GetInstance() {
+	static TextureCache instance;
+	return &instance;
+}
+
+/// <summary>
+/// マニフェストを読む（無ければ全て元画像を読む）
+/// </summary>
+/// <param name="directory">Resources</param>
+/// <returns>マニフェストを読めたか</returns>
+bool TextureCache::Initialize(const std::string& directory) {
+	directory_ = directory;
+	entries_.clear();
+
+	std::ifstream file(directory_ + "/" + kManifestPath);
+	if (!file.is_open()) {
+		return false;
+	}
+	std::string line;
+	while (std::getline(file, line)) {
+		if (!line.empty() && line.back() == '\r') {
+			line.pop_back();
+		}
+		// 空行と # で始まる行は読み飛ばす
+		if (line.empty() || line[0] == '#') {
+			continue;
+		}
+		std::string sourcePath;
+		Entry entry;
+		if (ParseManifestLine(line, sourcePath, entry)) {
+			entries_[sourcePath] = entry;
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// テクスチャを読む（TextureManager::Load の代わり。焼いたものがあればそちらを渡す）
+/// </summary>
+/// <param name="fileName">Resources からの相対パス</param>
+/// <returns>テクスチャハンドル</returns>
+uint32_t TextureCache::Load(const std::string& fileName) {
+	const Entry* entry = FindFresh(fileName);
+	if (entry) {
+		++stats_.cookedLoads;
+		return TextureManager::Load(entry->cookedPath);
+	}
+	++stats_.fallbackLoads;
+	return TextureManager::Load(fileName);
+}
+
+/// <summary>
+/// 実際に読むパス（焼いたものが使えればそのパス、使えなければ fileName）
+/// </summary>
+/// <param name="fileName"></param>
+/// <returns></returns>
+std::string TextureCache::Resolve(const std::string& fileName) const {
+	const Entry* entry = FindFresh(fileName);
+	return entry ? entry->cookedPath : fileName;
+}
+
+/// <summary>
+/// 焼いたものをマップして開く（使えなければ false）
+/// </summary>
+/// <param name="fileName"></param>
+/// <param name="texture"></param>
+/// <returns></returns>
+bool TextureCache::Open(const std::string& fileName, DdsTexture& texture) const {
+	const Entry* entry = FindFresh(fileName);
+	if (!entry || !texture.Open(directory_ + "/" + entry->cookedPath)) {
+		return false;
+	}
+	// マニフェストと中身が食い違っていれば使わない
+	if (texture.GetFormat() != entry->format || texture.GetWidth() != entry->width || texture.GetHeight() != entry->height || texture.GetMipCount() != entry->mipCount) {
+		texture.Close();
+		return false;
+	}
+	return true;
+}
+
+/// <summary>
+/// マニフェストの1行を読む（形式が違えば false）
+/// </summary>
+/// <param name="line"></param>
+/// <param name="sourcePath"></param>
+/// <param name="entry"></param>
+/// <returns></returns>
+bool TextureCache::ParseManifestLine(const std::string& line, std::string& sourcePath, Entry& entry) {
+	// 元画像,元のバイト数,元の CRC32(16進),焼いたファイル,焼いたバイト数,形式,幅,高さ,ミップ数,元の更新時刻
+	// （更新時刻の無い古いマニフェストも読む。そのときは CRC32 で比べる）
+	std::vector<std::string> fields;
+	std::stringstream stream(line);
+	std::string field;
+	while (std::getline(stream, field, ',')) {
+		fields.push_back(field);
+	}
+	if ((fields.size() != 9 && fields.size() != 10) || fields[0].empty() || fields[3].empty()) {
+		return false;
+	}
+
+	sourcePath = fields[0];
+	entry.sourceSize = std::strtoull(fields[1].c_str(), nullptr, 10);
+	entry.sourceCrc = static_cast<uint32_t>(std::strtoul(fields[2].c_str(), nullptr, 16));
+	entry.cookedPath = fields[3];
+	entry.cookedSize = std::strtoull(fields[4].c_str(), nullptr, 10);
+	if (fields[5] == DdsTexture::GetFormatName(DdsTexture::Format::kBC1)) {
+		entry.format = DdsTexture::Format::kBC1;
+	} else if (fields[5] == DdsTexture::GetFormatName(DdsTexture::Format::kBC3)) {
+		entry.format = DdsTexture::Format::kBC3;
+	} else {
+		return false;
+	}
+	entry.width = static_cast<uint32_t>(std::strtoul(fields[6].c_str(), nullptr, 10));
+	entry.height = static_cast<uint32_t>(std::strtoul(fields[7].c_str(), nullptr, 10));
+	entry.mipCount = static_cast<uint32_t>(std::strtoul(fields[8].c_str(), nullptr, 10));
+	entry.sourceTime = fields.size() == 10 ? std::strtoll(fields[9].c_str(), nullptr, 10) : 0;
+	return entry.width > 0 && entry.height > 0 && entry.mipCount > 0;
+}
+
+/// <summary>
+/// マニフェストの1行を書く（改行は付けない）
+/// </summary>
+/// <param name="sourcePath"></param>
+/// <param name="entry"></param>
+/// <returns></returns>
+std::string TextureCache::FormatManifestLine(const std::string& sourcePath, const Entry& entry) {
+	char crc[16];
+	std::snprintf(crc, sizeof(crc), "%08x", entry.sourceCrc);
+	return sourcePath + "," + std::to_string(entry.sourceSize) + "," + crc + "," + entry.cookedPath + "," + std::to_string(entry.cookedSize) + "," +
+	       DdsTexture::GetFormatName(entry.format) + "," + std::to_string(entry.width) + "," + std::to_string(entry.height) + "," + std::to_string(entry.mipCount) + "," +
+	       std::to_string(entry.sourceTime);
+}
+
+/// <summary>
+/// CRC32（PNG・zip と同じ多項式）
+/// </summary>
+/// <param name="data"></param>
+/// <param name="size"></param>
+/// <returns></returns>
+uint32_t TextureCache::ComputeCrc32(const uint8_t* data, size_t size) {
+	static const std::array<uint32_t, 256> table = [] {
+		std::array<uint32_t, 256> result = {};
+		for (uint32_t i = 0; i < 256; ++i) {
+			uint32_t value = i;
+			for (int bit = 0; bit < 8; ++bit) {
+				value = value & 1 ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+			}
+			result[i] = value;
+		}
+		return result;
+	}();
+	uint32_t crc = 0xFFFFFFFFu;
+	for (size_t i = 0; i < size; ++i) {
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
+
+/// <summary>
+/// マニフェストの行を引く（使えるかは見ない）
+/// </summary>
+/// <param name="fileName"></param>
+/// <returns></returns>
+const TextureCache::Entry* TextureCache::Find(const std::string& fileName) const {
+	auto it = entries_.find(fileName);
+	return it != entries_.end() ? &it->second : nullptr;
+}
+
+/// <summary>
+/// 焼いたものが使えるか（焼いたファイルのバイト数と、元画像のバイト数・更新時刻または CRC32 がマニフェストと合うか）
+/// </summary>
+const TextureCache::Entry* TextureCache::FindFresh(const std::string& fileName) const {
+	const Entry* entry = isEnabled_ ? Find(fileName) : nullptr;
+	if (!entry) {
+		return nullptr;
+	}
+
+	std::error_code errorCode;
+	uint64_t cookedSize = std::filesystem::file_size(directory_ + "/" + entry->cookedPath, errorCode);
+	if (errorCode || cookedSize != entry->cookedSize) {
+		return nullptr;
+	}
+	// 元画像を同梱しないときは焼いたものだけで良い
+	const std::string sourcePath = directory_ + "/" + fileName;
+	FileUtility::Stamp sourceStamp = FileUtility::GetStamp(sourcePath);
+	if (sourceStamp.size == 0 && sourceStamp.time == 0) {
+		return entry;
+	}
+	if (sourceStamp.size != entry->sourceSize) {
+		return nullptr;
+	}
+	// 焼いたときから触られていなければ中身は読まない
+	if (entry->sourceTime != 0 && sourceStamp.time == entry->sourceTime) {
+		return entry;
+	}
+	// 同じバイト数のまま書き換えられたかもしれない（チェックアウトで時刻だけ変わったときもここに来る。ツールを回せば時刻が揃う）
+	if (sourceStamp.size == 0) {
+		return ComputeCrc32(nullptr, 0) == entry->sourceCrc ? entry : nullptr;
+	}
+	MappedFile source;
+	if (!source.Open(sourcePath)) {
+		return nullptr;
+	}
+	return ComputeCrc32(source.GetData(), source.GetSize()) == entry->sourceCrc ? entry : nullptr;
+}
@@ -0,0 +1,137 @@
+#pragma once
+#include "DdsTexture.h"
+#include "KamataEngine.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/// <summary>
+/// Tools/TextureBaker で焼いたテクスチャ（ミップ付き・ブロック圧縮の DDS）を、元画像の代わりに読む
+/// ・マニフェスト（Resources/textureCache/manifest.csv）に元画像のバイト数・CRC32・更新時刻と焼いたファイルが並ぶ
+/// ・焼いたものが無い・元画像が焼いた後に変わっていれば、元画像をそのまま読む
+///   （バイト数と更新時刻が合えば中身は読まない。更新時刻だけ違えば CRC32 を計算して比べる）
+/// </summary>
+class TextureCache {
+public:
+	// マニフェストの場所（Resources からの相対パス）
+	static inline const char* const kManifestPath = "textureCache/manifest.csv";
+
+	// マニフェストの1行
+	struct Entry {
+		std::string cookedPath;   // 焼いたファイル（Resources からの相対パス）
+		uint64_t sourceSize = 0;  // 焼いたときの元画像のバイト数
+		uint32_t sourceCrc = 0;   // 焼いたときの元画像の CRC32
+		int64_t sourceTime = 0;   // 焼いたときの元画像の更新時刻（FileUtility::GetStamp の time。0 なら不明で、常に CRC32 を比べる）
+		uint64_t cookedSize = 0;  // 焼いたファイルのバイト数
+		DdsTexture::Format format = DdsTexture::Format::kBC1;
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t mipCount = 0;
+	};
+
+	// 統計
+	struct Stats {
+		uint32_t cookedLoads = 0;   // 焼いたものを読んだ回数
+		uint32_t fallbackLoads = 0; // 元画像を読んだ回数
+	};
+
+private:
+	std::string directory_;
+	// 元画像のパス → 焼いたもの
+	std::unordered_map<std::string, Entry> entries_;
+	bool isEnabled_ = true;
+
+	Stats stats_;
+
+public:
+	/// <summary>
+	/// インスタンスの取得
+	/// </summary>
+	/// <returns></returns>
+	static TextureCache* GetInstance();
+
+	/// <summary>
+	/// マニフェストを読む（無ければ全て元画像を読む）
+	/// </summary>
+	/// <param name="directory">Resources</param>
+	/// <returns>マニフェストを読めたか</returns>
+	bool Initialize(const std::string& directory = "Resources");
+
+	/// <summary>
+	/// テクスチャを読む（TextureManager::Load の代わり。焼いたものがあればそちらを渡す）
+	/// </summary>
+	/// <param name="fileName">Resources からの相対パス</param>
+	/// <returns>テクスチャハンドル</returns>
+	uint32_t Load(const std::string& fileName);
+
+	/// <summary>
+	/// 実際に読むパス（焼いたものが使えればそのパス、使えなければ fileName）
+	/// </summary>
+	/// <param name="fileName"></param>
+	/// <returns></returns>
+	std::string Resolve(const std::string& fileName) const;
+
+	/// <summary>
+	/// 焼いたものをマップして開く（使えなければ false）
+	/// </summary>
+	/// <param name="fileName"></param>
+	/// <param name="texture"></param>
+	/// <returns></returns>
+	bool Open(const std::string& fileName, DdsTexture& texture) const;
+
+	/// <summary>
+	/// マニフェストの1行を読む（形式が違えば false）
+	/// </summary>
+	/// <param name="line"></param>
+	/// <param name="sourcePath"></param>
+	/// <param name="entry"></param>
+	/// <returns></returns>
+	static bool ParseManifestLine(const std::string& line, std::string& sourcePath, Entry& entry);
+	/// <summary>
+	/// マニフェストの1行を書く（改行は付けない）
+	/// </summary>
+	/// <param name="sourcePath"></param>
+	/// <param name="entry"></param>
+	/// <returns></returns>
+	static std::string FormatManifestLine(const std::string& sourcePath, const Entry& entry);
+
+	/// <summary>
+	/// CRC32（PNG・zip と同じ多項式）
+	/// </summary>
+	/// <param name="data"></param>
+	/// <param name="size"></param>
+	/// <returns></returns>
+	static uint32_t ComputeCrc32(const uint8_t* data, size_t size);
+
+	/// <summary>
+	/// 焼いたものを使うか（false なら常に元画像）
+	/// </summary>
+	/// <param name="isEnabled"></param>
+	void SetEnabled(bool isEnabled) { isEnabled_ = isEnabled; }
+
+	/// <summary>
+	/// 統計のリセット
+	/// </summary>
+	void ResetStats() { stats_ = {}; }
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const Stats& GetStats() const { return stats_; }
+	const Entry* Find(const std::string& fileName) const;
+	uint32_t GetEntryCount() const { return static_cast<uint32_t>(entries_.size()); }
+
+private:
+	TextureCache() = default;
+	~TextureCache() = default;
+	TextureCache(const TextureCache&) = delete;
+	TextureCache& operator=(const TextureCache&) = delete;
+
+	/// <summary>
+	/// 焼いたものが使えるか（焼いたファイルのバイト数と、元画像のバイト数・更新時刻または CRC32 がマニフェストと合うか）
+	/// </summary>
+	const Entry* FindFresh(const std::string& fileName) const;
+};
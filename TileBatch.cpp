@@ -0,0 +1,105 @@
+#include "TileBatch.h"
+#include <algorithm>
+
+using namespace KamataEngine;
+
+/// <summary>
+/// マップから指定種別のタイルを集めてバッファを作る
+/// </summary>
+/// <param name="mapChipField"></param>
+/// <param name="type"></param>
+void TileBatch::Build(const MapChipField& mapChipField, MapChipType type) {
+	instances_.clear();
+
+	numBlockVirtical_ = mapChipField.GetNumBlockVirtical();
+	numBlockHorizontal_ = mapChipField.GetNumBlockHorizontal();
+
+	// 先に数えて1回で確保する
+	uint32_t count = 0;
+	for (uint32_t i = 0; i < numBlockVirtical_; ++i) {
+		for (uint32_t j = 0; j < numBlockHorizontal_; ++j) {
+			if (mapChipField.GetMapChipTypeByIndex(j, i) == type) {
+				++count;
+			}
+		}
+	}
+	instances_.reserve(count);
+
+	// 列ごとに詰める（可視範囲を x で切り出せるように）
+	for (uint32_t j = 0; j < numBlockHorizontal_; ++j) {
+		for (uint32_t i = 0; i < numBlockVirtical_; ++i) {
+			if (mapChipField.GetMapChipTypeByIndex(j, i) != type) {
+				continue;
+			}
+
+			Vector3 position = mapChipField.GetMapChipPositionByIndex(j, i);
+			instances_.push_back(TileInstance{i * numBlockHorizontal_ + j, position.x, position.y, position.z});
+		}
+	}
+}
+
+/// <summary>
+/// 横方向 [left, right] に中心が入るインスタンスの範囲（二分探索）
+/// </summary>
+/// <param name="left"></param>
+/// <param name="right"></param>
+/// <returns></returns>
+TileBatch::Range TileBatch::GetVisibleRange(float left, float right) const {
+	std::vector<TileInstance>::const_iterator first =
+	    std::lower_bound(instances_.begin(), instances_.end(), left, [](const TileInstance& instance, float x) { return instance.x < x; });
+	std::vector<TileInstance>::const_iterator last =
+	    std::upper_bound(first, instances_.end(), right, [](float x, const TileInstance& instance) { return x < instance.x; });
+
+	Range range;
+	range.first = static_cast<uint32_t>(first - instances_.begin());
+	range.count = static_cast<uint32_t>(last - first);
+	return range;
+}
+
+/// <summary>
+/// カメラに写るインスタンスの範囲（写る横幅の両端に余白を足す）
+/// </summary>
+/// <param name="camera"></param>
+/// <returns></returns>
+TileBatch::Range TileBatch::GetVisibleRange(const Camera& camera) const {
+	// タイルは全て z = 0 の面に並ぶ
+	float halfWidth = GetVisibleHalfWidth(camera, 0.0f);
+	if (halfWidth < 0.0f) {
+		return Range{0, GetInstanceCount()};
+	}
+
+	halfWidth += kVisibleMargin;
+	return GetVisibleRange(camera.translation_.x - halfWidth, camera.translation_.x + halfWidth);
+}
+
+/// <summary>
+/// 奥行き planeZ の面でカメラに写る横幅の半分（投影行列の画角・縦横比と、カメラから面までの距離から）
+/// </summary>
+/// <param name="camera"></param>
+/// <param name="planeZ"></param>
+/// <returns>求められなければ負の値</returns>
+float TileBatch::GetVisibleHalfWidth(const Camera& camera, float planeZ) {
+	// 透視投影の m[0][0] は 1 / (tan(画角Y / 2) * 縦横比)
+	float scaleX = camera.matProjection.m[0][0];
+	float distance = planeZ - camera.translation_.z;
+	if (scaleX <= 0.0f || distance <= 0.0f) {
+		return -1.0f;
+	}
+	return distance / scaleX;
+}
+
+/// <summary>
+/// インスタンスのワールド行列（行ベクトル形式、行優先16要素）
+/// </summary>
+/// <param name="instance"></param>
+/// <param name="out"></param>
+void TileBatch::WriteWorldMatrix(const TileInstance& instance, float out[16]) {
+	// ブロックは拡縮・回転なしなので平行移動だけ
+	const float matrix[16] = {
+	    1.0f,       0.0f,       0.0f,       0.0f,
+	    0.0f,       1.0f,       0.0f,       0.0f,
+	    0.0f,       0.0f,       1.0f,       0.0f,
+	    instance.x, instance.y, instance.z, 1.0f,
+	};
+	std::copy(matrix, matrix + 16, out);
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include "KamataEngine.h"
+#include "MapChipField.h"
+
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// タイル1個分のインスタンスデータ（16バイト）
+/// </summary>
+struct TileInstance {
+	uint32_t tileIndex; // タイル番号（yIndex * 横のブロック数 + xIndex）
+	float x;            // 中心のワールド座標
+	float y;
+	float z;
+};
+static_assert(sizeof(TileInstance) == 16, "TileInstance はGPUバッファにそのまま詰める前提");
+
+/// <summary>
+/// 同じ種類のタイルを1本の連続バッファにまとめ、1回のインスタンス描画で出せるようにする
+/// </summary>
+class TileBatch {
+public:
+	// 連続したインスタンスの範囲
+	struct Range {
+		uint32_t first = 0;
+		uint32_t count = 0;
+	};
+
+	// カメラに写る範囲の両端に足す余白（中心が外でも半ブロック以内なら端が写る）
+	static inline const float kVisibleMargin = 0.5f;
+
+private:
+	// インスタンス（x昇順 → y昇順。横方向の可視範囲が連続区間になる）
+	std::vector<TileInstance> instances_;
+
+	// 縦・横のブロック数（タイル番号の復元用）
+	uint32_t numBlockVirtical_ = 0;
+	uint32_t numBlockHorizontal_ = 0;
+
+public:
+	/// <summary>
+	/// マップから指定種別のタイルを集めてバッファを作る
+	/// </summary>
+	/// <param name="mapChipField"></param>
+	/// <param name="type"></param>
+	void Build(const MapChipField& mapChipField, MapChipType type = MapChipType::kBlock);
+
+	/// <summary>
+	/// 横方向 [left, right] に中心が入るインスタンスの範囲（二分探索）
+	/// </summary>
+	/// <param name="left"></param>
+	/// <param name="right"></param>
+	/// <returns></returns>
+	Range GetVisibleRange(float left, float right) const;
+	/// <summary>
+	/// カメラに写るインスタンスの範囲（写る横幅の両端に余白を足す）
+	/// </summary>
+	/// <param name="camera"></param>
+	/// <returns></returns>
+	Range GetVisibleRange(const KamataEngine::Camera& camera) const;
+
+	/// <summary>
+	/// 奥行き planeZ の面でカメラに写る横幅の半分（投影行列の画角・縦横比と、カメラから面までの距離から）
+	/// </summary>
+	/// <param name="camera"></param>
+	/// <param name="planeZ"></param>
+	/// <returns>求められなければ負の値</returns>
+	static float GetVisibleHalfWidth(const KamataEngine::Camera& camera, float planeZ);
+
+	/// <summary>
+	/// インスタンスのワールド行列（行ベクトル形式、行優先16要素）
+	/// </summary>
+	/// <param name="instance"></param>
+	/// <param name="out"></param>
+	static void WriteWorldMatrix(const TileInstance& instance, float out[16]);
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	const std::vector<TileInstance>& GetInstances() const { return instances_; }
+	uint32_t GetInstanceCount() const { return static_cast<uint32_t>(instances_.size()); }
+	uint32_t GetTileCount() const { return numBlockVirtical_ * numBlockHorizontal_; }
+	uint32_t GetNumBlockHorizontal() const { return numBlockHorizontal_; }
+	uint32_t GetXIndex(const TileInstance& instance) const { return instance.tileIndex % numBlockHorizontal_; }
+	uint32_t GetYIndex(const TileInstance& instance) const { return instance.tileIndex / numBlockHorizontal_; }
+};
@@ -1,6 +1,8 @@
 #define NOMINMAX
 
 #include "TitleScene.h"
+#include "AssetCache.h"
+#include "UiAtlas.h"
 #include "WorldTransformUpdater.h"
 #include <algorithm>
 #include <cmath>
@@ -16,15 +18,15 @@ TitleScene::~TitleScene() {
 	delete fade_;
 
 	// モデル
-	delete model_;
-	delete modelTitleLogo_;
+	AssetCache::GetInstance()->ReleaseModel(model_);
+	AssetCache::GetInstance()->ReleaseModel(modelTitleLogo_);
 	// カメラ
 	delete camera_;
 
-	delete modelSkydome_;
+	AssetCache::GetInstance()->ReleaseModel(modelSkydome_);
 	delete skydome_;
 
-	delete modelTitleCloud_;
+	AssetCache::GetInstance()->ReleaseModel(modelTitleCloud_);
 
 	delete spriteStartText_;
 	delete spriteTutorialText_;
@@ -50,8 +52,8 @@ void TitleScene::Initialize() {
 	/// ===========================================
 
 	// 3Dモデルの生成
-	model_ = Model::CreateFromOBJ("text", true);
-	modelTitleLogo_ = Model::CreateFromOBJ("titleLogo", true);
+	model_ = AssetCache::GetInstance()->AcquireModel("text", true);
+	modelTitleLogo_ = AssetCache::GetInstance()->AcquireModel("titleLogo", true);
 
 	// アニメーションの経過時間
 	elapsedTimer_ = 0.0f;
@@ -75,7 +77,7 @@ void TitleScene::Initialize() {
 	camera_->farZ = 2000.0f; // ← 追加（描画範囲を広めに）
 	camera_->Initialize();
 
-	modelTitleCloud_ = Model::CreateFromOBJ("titleCloud", true); // titleCloud.obj を読み込む
+	modelTitleCloud_ = AssetCache::GetInstance()->AcquireModel("titleCloud", true); // titleCloud.obj を読み込む
 	worldTransformTitleCloud_.Initialize();
 
 	// ロゴの少し後ろに1個だけ、やや大きめで
@@ -83,18 +85,31 @@ void TitleScene::Initialize() {
 	// 　　　　　　　　　　　　　　　       ↑ 奥行き（+Zが奥側なら正、逆なら -16.0f に）
 	worldTransformTitleCloud_.scale_ = {14.0f, 12.0f, 1.0f};
 
-	modelSkydome_ = Model::CreateFromOBJ("skyDome", true);
+	modelSkydome_ = AssetCache::GetInstance()->AcquireModel("skyDome", true);
 	skydome_ = new Skydome();
 	skydome_->Initialize(modelSkydome_, camera_);
 
-	uint32_t texStart = TextureManager::Load("text/gameStartText.png");
-	uint32_t texTutorial = TextureManager::Load("text/tutorialText.png");
+	uiAtlas_.Initialize(UiAtlas::kData);
 
-	spriteStartText_ = Sprite::Create(texStart, {640.0f, 500.0f}, {1, 1, 1, 1}, {0.5f, 0.5f});
-	spriteTutorialText_ = Sprite::Create(texTutorial, {640.0f, 640.0f}, {1, 1, 1, 1}, {0.5f, 0.5f});
+	spriteStartText_ = uiAtlas_.CreateSprite("text/gameStartText.png", {640.0f, 500.0f}, {1, 1, 1, 1}, {0.5f, 0.5f});
+	spriteTutorialText_ = uiAtlas_.CreateSprite("text/tutorialText.png", {640.0f, 640.0f}, {1, 1, 1, 1}, {0.5f, 0.5f});
 
 }
 
+/// <summary>
+/// 開始時の状態に戻す（タイトルに戻ってきたとき）
+/// </summary>
+void TitleScene::Reset() {
+	isFinished_ = false;
+	phase_ = Phase::kFadeIn;
+
+	// フェード開始
+	fade_->Start(Fade::Status::FadeIn, duration_);
+
+	// アニメーションの経過時間
+	elapsedTimer_ = 0.0f;
+}
+
 /// <summary>
 /// 更新
 /// </summary>
@@ -222,4 +237,5 @@ void TitleScene::Draw() {
 /// ゲッター
 /// </summary>
 /// <returns></returns>
-bool TitleScene::IsFinished() const { return isFinished_; }
\ No newline at end of file
+bool TitleScene::IsFinished() const { return isFinished_; }
+bool TitleScene::IsFadingOut() const { return phase_ == Phase::kFadeOut; }
\ No newline at end of file
@@ -1,9 +1,11 @@
 #pragma once
+#include "BaseScene.h"
 #include "Fade.h"
 #include "KamataEngine.h"
 #include "Skydome.h"
+#include "SpriteAtlas.h"
 
-class TitleScene {
+class TitleScene : public BaseScene {
 public:
 	// シーンのフェーズ
 	enum class Phase {
@@ -65,7 +67,8 @@ private:
 	KamataEngine::Model* modelTitleCloud_ = nullptr;
 	KamataEngine::WorldTransform worldTransformTitleCloud_;
 
-	// スプライト
+	// スプライト（文字の画像のアトラスから）
+	SpriteAtlas uiAtlas_;
 	KamataEngine::Sprite* spriteStartText_ = nullptr;
 	KamataEngine::Sprite* spriteTutorialText_ = nullptr;
 
@@ -73,16 +76,20 @@ public:
 	/// <summary>
 	/// デストラクタ
 	/// </summary>
-	~TitleScene();
+	~TitleScene() override;
 
 	/// <summary>
 	/// 初期化
 	/// </summary>
-	void Initialize();
+	void Initialize() override;
+	/// <summary>
+	/// 開始時の状態に戻す（タイトルに戻ってきたとき）
+	/// </summary>
+	void Reset() override;
 	/// <summary>
 	/// 更新
 	/// </summary>
-	void Update();
+	void Update() override;
 
 	// 補助関数
 	static float Lerp(float a, float b, float t);
@@ -96,11 +103,12 @@ public:
 	/// <summary>
 	/// 描画
 	/// </summary>
-	void Draw();
+	void Draw() override;
 
 	/// <summary>
 	/// ゲッター
 	/// </summary>
 	/// <returns></returns>
-	bool IsFinished() const;
+	bool IsFinished() const override;
+	bool IsFadingOut() const;
 };
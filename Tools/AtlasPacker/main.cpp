@@ -0,0 +1,560 @@
+// 小さな画像をアトラス（数枚の大きなテクスチャ）に詰め、名前から矩形・UV を引く表（C++ のヘッダ）を生成する
+//
+// ビルド（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -I. Tools/AtlasPacker/main.cpp Tools/Common/PngImage.cpp -o atlasPacker
+// 実行（リポジトリ直下で。画像は --root からの相対パスで渡し、それがそのまま表の名前になる）:
+//   ./atlasPacker --out text/uiAtlas --header UiAtlas.h --name UiAtlas
+//       text/backTitleText.png text/clear.png text/gameStartText.png text/startText.png text/tutorialText.png
+//       text/tutorial/attack.png text/tutorial/done.png text/tutorial/jump.png text/tutorial/move.png
+// オプション:
+//   --root ディレクトリ   画像とページの置き場所（既定 Resources）
+//   --max-size ピクセル   1ページの最大の一辺（既定 2048。入り切らなければページを増やす）
+//   --padding ピクセル    画像の間とページの縁の透明なすき間（既定 2）
+//   --algorithm 名前      maxrects / skyline / auto（既定 auto。両方で詰めて、ページの面積が小さい方を使う）
+//   --no-trim             画像の透明な余白を詰めない
+//
+// 配置:
+//   画像ごとに不透明な範囲だけを切り出し（元画像の中での位置は表に残す）、ページには大きさを2の累乗にした中で
+//   一番小さいものから順に、全部入るものを探す。入り切らなければ最大の大きさのページに入るだけ入れて次のページへ。
+//   ページの中は、残っている画像の中から一番うまく収まるものを1つずつ置いていく
+//   （maxrects: 空き矩形のうち短い辺の余りが最小の所 / skyline: 上端が一番低くなる所）。
+//   書き出した後にページを読み直して、全ての画像が元と同じ画素で入っていることを確かめる。
+#define NOMINMAX
+#include "Tools/Common/PngImage.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Rect {
+	uint32_t x;
+	uint32_t y;
+	uint32_t width;
+	uint32_t height;
+};
+
+// 置き場所の良さ（小さいほど良い。first が同じなら second で比べる）
+struct Score {
+	uint64_t first = UINT64_MAX;
+	uint64_t second = UINT64_MAX;
+
+	bool operator<(const Score& other) const { return first != other.first ? first < other.first : second < other.second; }
+};
+
+///===========================================
+/// MaxRects（空き矩形の一覧を持ち、置くたびに割って重なりを除く）
+/// ===========================================
+
+class MaxRectsPacker {
+private:
+	std::vector<Rect> freeRects_;
+
+public:
+	static const char* GetName() { return "maxrects"; }
+
+	void Reset(uint32_t width, uint32_t height) { freeRects_.assign(1, Rect{0, 0, width, height}); }
+
+	// 短い辺の余りが一番小さい空き矩形の左上に置く
+	bool Find(uint32_t width, uint32_t height, Rect& rect, Score& score) const {
+		bool isFound = false;
+		for (const Rect& free : freeRects_) {
+			if (width > free.width || height > free.height) {
+				continue;
+			}
+			uint64_t leftoverX = free.width - width;
+			uint64_t leftoverY = free.height - height;
+			Score candidate = {(std::min)(leftoverX, leftoverY), (std::max)(leftoverX, leftoverY)};
+			if (candidate < score) {
+				score = candidate;
+				rect = {free.x, free.y, width, height};
+				isFound = true;
+			}
+		}
+		return isFound;
+	}
+
+	void Place(const Rect& used) {
+		std::vector<Rect> next;
+		next.reserve(freeRects_.size() + 4);
+		for (const Rect& free : freeRects_) {
+			if (used.x >= free.x + free.width || used.x + used.width <= free.x || used.y >= free.y + free.height || used.y + used.height <= free.y) {
+				next.push_back(free);
+				continue;
+			}
+			// 重なった空き矩形は、置いた矩形の上下左右の残りに割る
+			if (used.x > free.x) {
+				next.push_back({free.x, free.y, used.x - free.x, free.height});
+			}
+			if (used.x + used.width < free.x + free.width) {
+				next.push_back({used.x + used.width, free.y, free.x + free.width - (used.x + used.width), free.height});
+			}
+			if (used.y > free.y) {
+				next.push_back({free.x, free.y, free.width, used.y - free.y});
+			}
+			if (used.y + used.height < free.y + free.height) {
+				next.push_back({free.x, used.y + used.height, free.width, free.y + free.height - (used.y + used.height)});
+			}
+		}
+
+		// 他の空き矩形に含まれるものを除く
+		freeRects_.clear();
+		for (size_t i = 0; i < next.size(); ++i) {
+			bool isContained = false;
+			for (size_t j = 0; j < next.size() && !isContained; ++j) {
+				if (i == j) {
+					continue;
+				}
+				const Rect& a = next[i];
+				const Rect& b = next[j];
+				bool isInside = a.x >= b.x && a.y >= b.y && a.x + a.width <= b.x + b.width && a.y + a.height <= b.y + b.height;
+				// 同じ矩形が2つあれば後ろの方だけ残す
+				bool isSame = a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+				isContained = isInside && (!isSame || i < j);
+			}
+			if (!isContained) {
+				freeRects_.push_back(next[i]);
+			}
+		}
+	}
+};
+
+///===========================================
+/// Skyline（各列の高さの輪郭だけを持ち、上に積んでいく）
+/// ===========================================
+
+class SkylinePacker {
+private:
+	struct Node {
+		uint32_t x;
+		uint32_t y;
+		uint32_t width;
+	};
+	std::vector<Node> nodes_;
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+
+public:
+	static const char* GetName() { return "skyline"; }
+
+	void Reset(uint32_t width, uint32_t height) {
+		width_ = width;
+		height_ = height;
+		nodes_.assign(1, Node{0, 0, width});
+	}
+
+	// 上端が一番低くなる所（同じなら左）に置く
+	bool Find(uint32_t width, uint32_t height, Rect& rect, Score& score) const {
+		bool isFound = false;
+		for (size_t i = 0; i < nodes_.size(); ++i) {
+			uint32_t x = nodes_[i].x;
+			if (x + width > width_) {
+				break;
+			}
+			// 幅に掛かる輪郭の一番高い所に載せる
+			uint32_t y = 0;
+			uint32_t covered = 0;
+			for (size_t j = i; covered < width; ++j) {
+				y = (std::max)(y, nodes_[j].y);
+				covered += nodes_[j].width;
+			}
+			if (y + height > height_) {
+				continue;
+			}
+			Score candidate = {y + height, x};
+			if (candidate < score) {
+				score = candidate;
+				rect = {x, y, width, height};
+				isFound = true;
+			}
+		}
+		return isFound;
+	}
+
+	void Place(const Rect& used) {
+		size_t index = 0;
+		while (nodes_[index].x != used.x) {
+			++index;
+		}
+		nodes_.insert(nodes_.begin() + index, Node{used.x, used.y + used.height, used.width});
+
+		// 後ろの輪郭のうち、置いた幅に隠れた分を削る
+		for (size_t i = index + 1; i < nodes_.size();) {
+			uint32_t right = nodes_[i - 1].x + nodes_[i - 1].width;
+			if (nodes_[i].x >= right) {
+				break;
+			}
+			uint32_t shrink = right - nodes_[i].x;
+			if (shrink >= nodes_[i].width) {
+				nodes_.erase(nodes_.begin() + i);
+				continue;
+			}
+			nodes_[i].x += shrink;
+			nodes_[i].width -= shrink;
+			break;
+		}
+
+		// 同じ高さの隣はつなぐ
+		for (size_t i = 0; i + 1 < nodes_.size();) {
+			if (nodes_[i].y == nodes_[i + 1].y) {
+				nodes_[i].width += nodes_[i + 1].width;
+				nodes_.erase(nodes_.begin() + i + 1);
+			} else {
+				++i;
+			}
+		}
+	}
+};
+
+///===========================================
+/// 詰める
+/// ===========================================
+
+// 詰める画像1枚
+struct Item {
+	std::string name;
+	PngImage image;
+	// 元画像の中で使う範囲
+	uint32_t trimX = 0;
+	uint32_t trimY = 0;
+	uint32_t width = 0;
+	uint32_t height = 0;
+	// 置いた場所
+	uint32_t page = 0;
+	uint32_t x = 0;
+	uint32_t y = 0;
+};
+
+// 1ページ
+struct Page {
+	uint32_t width;
+	uint32_t height;
+};
+
+// 詰めた結果
+struct Layout {
+	const char* algorithm = "";
+	std::vector<Page> pages;
+	// items と同じ並び
+	std::vector<Rect> rects;
+	std::vector<uint32_t> itemPages;
+	uint64_t pageArea = 0;
+};
+
+/// <summary>
+/// indices の画像を width x height のページに入るだけ入れる
+/// </summary>
+/// <returns>置けた画像（items の番号）。rects / itemPages に書く</returns>
+template <typename Packer>
+std::vector<uint32_t> FillPage(const std::vector<Item>& items, const std::vector<uint32_t>& indices, uint32_t width, uint32_t height, uint32_t padding, uint32_t page, Layout& layout) {
+	// 画像の右下に padding を足して置き、ページの左上も padding 空ける
+	Packer packer;
+	packer.Reset(width - padding, height - padding);
+
+	std::vector<uint32_t> remaining = indices;
+	std::vector<uint32_t> placed;
+	while (!remaining.empty()) {
+		// 残りの中で一番うまく収まるものを選ぶ
+		Score bestScore;
+		Rect bestRect = {};
+		size_t best = remaining.size();
+		for (size_t i = 0; i < remaining.size(); ++i) {
+			const Item& item = items[remaining[i]];
+			Rect rect;
+			Score score = bestScore;
+			if (packer.Find(item.width + padding, item.height + padding, rect, score) && score < bestScore) {
+				bestScore = score;
+				bestRect = rect;
+				best = i;
+			}
+		}
+		if (best == remaining.size()) {
+			break;
+		}
+		packer.Place(bestRect);
+		uint32_t index = remaining[best];
+		layout.rects[index] = {bestRect.x + padding, bestRect.y + padding, items[index].width, items[index].height};
+		layout.itemPages[index] = page;
+		placed.push_back(index);
+		remaining.erase(remaining.begin() + best);
+	}
+	return placed;
+}
+
+/// <summary>
+/// 全ての画像をページに分けて詰める
+/// </summary>
+template <typename Packer> bool Pack(const std::vector<Item>& items, uint32_t maxSize, uint32_t padding, Layout& layout) {
+	layout = {};
+	layout.algorithm = Packer::GetName();
+	layout.rects.resize(items.size());
+	layout.itemPages.resize(items.size());
+
+	// 2の累乗のページの大きさを面積の小さい順に（同じなら正方形に近い方）
+	std::vector<Page> sizes;
+	for (uint32_t width = 64; width <= maxSize; width <<= 1) {
+		for (uint32_t height = 64; height <= maxSize; height <<= 1) {
+			sizes.push_back({width, height});
+		}
+	}
+	std::stable_sort(sizes.begin(), sizes.end(), [](const Page& a, const Page& b) {
+		uint64_t areaA = static_cast<uint64_t>(a.width) * a.height;
+		uint64_t areaB = static_cast<uint64_t>(b.width) * b.height;
+		if (areaA != areaB) {
+			return areaA < areaB;
+		}
+		uint32_t skewA = (std::max)(a.width, a.height) - (std::min)(a.width, a.height);
+		uint32_t skewB = (std::max)(b.width, b.height) - (std::min)(b.width, b.height);
+		return skewA != skewB ? skewA < skewB : a.width > b.width;
+	});
+
+	std::vector<uint32_t> remaining(items.size());
+	for (uint32_t i = 0; i < items.size(); ++i) {
+		remaining[i] = i;
+		if (items[i].width + padding * 2 > maxSize || items[i].height + padding * 2 > maxSize) {
+			std::fprintf(stderr, "%s (%ux%u) does not fit in %ux%u\n", items[i].name.c_str(), items[i].width, items[i].height, maxSize, maxSize);
+			return false;
+		}
+	}
+
+	while (!remaining.empty()) {
+		const uint32_t page = static_cast<uint32_t>(layout.pages.size());
+		// 残り全部が入る一番小さいページ
+		bool isAllPlaced = false;
+		for (const Page& size : sizes) {
+			uint64_t itemArea = 0;
+			for (uint32_t index : remaining) {
+				itemArea += static_cast<uint64_t>(items[index].width + padding) * (items[index].height + padding);
+			}
+			if (itemArea > static_cast<uint64_t>(size.width) * size.height) {
+				continue;
+			}
+			if (FillPage<Packer>(items, remaining, size.width, size.height, padding, page, layout).size() == remaining.size()) {
+				layout.pages.push_back(size);
+				remaining.clear();
+				isAllPlaced = true;
+				break;
+			}
+		}
+		if (isAllPlaced) {
+			break;
+		}
+		// 入り切らなければ最大のページに入るだけ
+		std::vector<uint32_t> placed = FillPage<Packer>(items, remaining, maxSize, maxSize, padding, page, layout);
+		layout.pages.push_back({maxSize, maxSize});
+		for (uint32_t index : placed) {
+			remaining.erase(std::find(remaining.begin(), remaining.end(), index));
+		}
+	}
+
+	for (const Page& page : layout.pages) {
+		layout.pageArea += static_cast<uint64_t>(page.width) * page.height;
+	}
+	return true;
+}
+
+/// <summary>
+/// 詰め具合を出す
+/// </summary>
+void Report(const std::vector<Item>& items, const Layout& layout) {
+	std::vector<uint64_t> used(layout.pages.size(), 0);
+	std::vector<uint32_t> counts(layout.pages.size(), 0);
+	for (size_t i = 0; i < items.size(); ++i) {
+		used[layout.itemPages[i]] += static_cast<uint64_t>(items[i].width) * items[i].height;
+		++counts[layout.itemPages[i]];
+	}
+	uint64_t totalUsed = 0;
+	for (size_t page = 0; page < layout.pages.size(); ++page) {
+		uint64_t area = static_cast<uint64_t>(layout.pages[page].width) * layout.pages[page].height;
+		std::printf("  %-8s page %zu: %4ux%-4u %2u images, %5.1f%% filled\n", layout.algorithm, page, layout.pages[page].width, layout.pages[page].height, counts[page],
+		            100.0 * static_cast<double>(used[page]) / static_cast<double>(area));
+		totalUsed += used[page];
+	}
+	std::printf("  %-8s total : %zu pages, %llu px, %5.1f%% filled\n", layout.algorithm, layout.pages.size(), static_cast<unsigned long long>(layout.pageArea),
+	            100.0 * static_cast<double>(totalUsed) / static_cast<double>(layout.pageArea));
+}
+
+std::string PagePath(const std::string& out, size_t page) { return out + std::to_string(page) + ".png"; }
+
+} // namespace
+
+int main(int argc, char** argv) {
+	std::string root = "Resources";
+	std::string out = "text/uiAtlas";
+	std::string headerPath = "UiAtlas.h";
+	std::string name = "UiAtlas";
+	std::string algorithm = "auto";
+	uint32_t maxSize = 2048;
+	uint32_t padding = 2;
+	bool isTrim = true;
+	std::vector<std::string> inputs;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--root" && i + 1 < argc) {
+			root = argv[++i];
+		} else if (arg == "--out" && i + 1 < argc) {
+			out = argv[++i];
+		} else if (arg == "--header" && i + 1 < argc) {
+			headerPath = argv[++i];
+		} else if (arg == "--name" && i + 1 < argc) {
+			name = argv[++i];
+		} else if (arg == "--algorithm" && i + 1 < argc) {
+			algorithm = argv[++i];
+		} else if (arg == "--max-size" && i + 1 < argc) {
+			maxSize = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (arg == "--padding" && i + 1 < argc) {
+			padding = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+		} else if (arg == "--no-trim") {
+			isTrim = false;
+		} else if (arg.rfind("--", 0) == 0) {
+			std::fprintf(stderr, "unknown option %s\n", arg.c_str());
+			return 1;
+		} else {
+			inputs.push_back(arg);
+		}
+	}
+	if (inputs.empty() || (algorithm != "auto" && algorithm != "maxrects" && algorithm != "skyline") || maxSize < 64 || maxSize > 16384) {
+		std::fprintf(stderr, "usage: %s [--root dir] [--out path] [--header path] [--name type] [--algorithm auto|maxrects|skyline] [--max-size px] [--padding px] [--no-trim] images...\n",
+		             argv[0]);
+		return 1;
+	}
+
+	// 読んで、不透明な範囲を切り出す
+	std::vector<Item> items(inputs.size());
+	uint64_t sourceArea = 0;
+	for (size_t i = 0; i < inputs.size(); ++i) {
+		Item& item = items[i];
+		item.name = inputs[i];
+		std::string error;
+		if (!item.image.Load(root + "/" + item.name, &error)) {
+			std::fprintf(stderr, "failed to load %s/%s: %s\n", root.c_str(), item.name.c_str(), error.c_str());
+			return 1;
+		}
+		sourceArea += static_cast<uint64_t>(item.image.GetWidth()) * item.image.GetHeight();
+		uint32_t right = item.image.GetWidth();
+		uint32_t bottom = item.image.GetHeight();
+		if (!isTrim || !item.image.GetOpaqueBounds(item.trimX, item.trimY, right, bottom)) {
+			// 全て透明なら元の大きさのまま
+			item.trimX = 0;
+			item.trimY = 0;
+			right = item.image.GetWidth();
+			bottom = item.image.GetHeight();
+		}
+		item.width = right - item.trimX;
+		item.height = bottom - item.trimY;
+	}
+	// 名前順（表を二分探索で引くため）
+	std::sort(items.begin(), items.end(), [](const Item& a, const Item& b) { return a.name < b.name; });
+	for (size_t i = 1; i < items.size(); ++i) {
+		if (items[i].name == items[i - 1].name) {
+			std::fprintf(stderr, "duplicate image %s\n", items[i].name.c_str());
+			return 1;
+		}
+	}
+
+	// 詰める（auto なら両方で詰めて比べる）
+	std::printf("%zu images, %llu px as separate textures\n", items.size(), static_cast<unsigned long long>(sourceArea));
+	Layout layout;
+	if (algorithm != "skyline") {
+		if (!Pack<MaxRectsPacker>(items, maxSize, padding, layout)) {
+			return 1;
+		}
+		Report(items, layout);
+	}
+	if (algorithm != "maxrects") {
+		Layout skyline;
+		if (!Pack<SkylinePacker>(items, maxSize, padding, skyline)) {
+			return 1;
+		}
+		Report(items, skyline);
+		if (algorithm == "skyline" || skyline.pages.size() < layout.pages.size() || (skyline.pages.size() == layout.pages.size() && skyline.pageArea < layout.pageArea)) {
+			layout = skyline;
+		}
+	}
+	for (size_t i = 0; i < items.size(); ++i) {
+		items[i].page = layout.itemPages[i];
+		items[i].x = layout.rects[i].x;
+		items[i].y = layout.rects[i].y;
+	}
+	std::printf("using %s: %zu textures -> %zu, %.1f%% of the pixels\n", layout.algorithm, items.size(), layout.pages.size(),
+	            100.0 * static_cast<double>(layout.pageArea) / static_cast<double>(sourceArea));
+
+	// ページを書き、読み直して確かめる
+	for (size_t page = 0; page < layout.pages.size(); ++page) {
+		PngImage image;
+		image.Resize(layout.pages[page].width, layout.pages[page].height);
+		for (const Item& item : items) {
+			if (item.page == page) {
+				image.Blit(item.image, item.trimX, item.trimY, item.width, item.height, item.x, item.y);
+			}
+		}
+		std::string path = root + "/" + PagePath(out, page);
+		if (!image.Save(path)) {
+			std::fprintf(stderr, "failed to write %s\n", path.c_str());
+			return 1;
+		}
+
+		PngImage written;
+		if (!written.Load(path)) {
+			std::fprintf(stderr, "failed to read back %s\n", path.c_str());
+			return 1;
+		}
+		for (const Item& item : items) {
+			if (item.page != page) {
+				continue;
+			}
+			for (uint32_t row = 0; row < item.height; ++row) {
+				if (std::memcmp(written.At(item.x, item.y + row), item.image.At(item.trimX, item.trimY + row), static_cast<size_t>(item.width) * 4) != 0) {
+					std::fprintf(stderr, "%s does not match in %s\n", item.name.c_str(), path.c_str());
+					return 1;
+				}
+			}
+		}
+		std::printf("%s: written\n", path.c_str());
+	}
+
+	// 表を書く
+	std::ofstream header(headerPath, std::ios::binary);
+	if (!header) {
+		std::fprintf(stderr, "failed to write %s\n", headerPath.c_str());
+		return 1;
+	}
+	header << "// Tools/AtlasPacker で生成（手で書き換えない）\n";
+	header << "#pragma once\n";
+	header << "#include \"SpriteAtlas.h\"\n\n";
+	header << "/// <summary>\n";
+	header << "/// アトラスに詰めた画像の表（" << layout.algorithm << "、" << items.size() << " 枚 → " << layout.pages.size() << " ページ）\n";
+	header << "/// </summary>\n";
+	header << "struct " << name << " {\n";
+	header << "\tstatic inline const SpriteAtlasPage kPages[" << layout.pages.size() << "] = {\n";
+	for (size_t page = 0; page < layout.pages.size(); ++page) {
+		header << "\t    {\"" << PagePath(out, page) << "\", " << layout.pages[page].width << ", " << layout.pages[page].height << "},\n";
+	}
+	header << "\t};\n";
+	header << "\t// 名前順（SpriteAtlas::Find が二分探索する）\n";
+	header << "\t//  名前, ページ, x, y, 幅, 高さ, 元画像の中の x, y, 元画像の幅, 高さ, UV\n";
+	header << "\tstatic inline const SpriteAtlasEntry kEntries[" << items.size() << "] = {\n";
+	for (const Item& item : items) {
+		const Page& page = layout.pages[item.page];
+		char uv[128];
+		std::snprintf(uv, sizeof(uv), "%.6ff, %.6ff, %.6ff, %.6ff", static_cast<double>(item.x) / page.width, static_cast<double>(item.y) / page.height,
+		              static_cast<double>(item.x + item.width) / page.width, static_cast<double>(item.y + item.height) / page.height);
+		header << "\t    {\"" << item.name << "\", " << item.page << ", " << item.x << ", " << item.y << ", " << item.width << ", " << item.height << ", " << item.trimX << ", " << item.trimY
+		       << ", " << item.image.GetWidth() << ", " << item.image.GetHeight() << ", " << uv << "},\n";
+	}
+	header << "\t};\n";
+	header << "\tstatic inline const SpriteAtlasData kData = {kPages, " << layout.pages.size() << ", kEntries, " << items.size() << "};\n";
+	header << "};\n";
+	if (!header) {
+		std::fprintf(stderr, "failed to write %s\n", headerPath.c_str());
+		return 1;
+	}
+	std::printf("%s: written\n", headerPath.c_str());
+	return 0;
+}
@@ -0,0 +1,389 @@
+#define NOMINMAX
+#include "Tools/Common/BlockCompression.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+
+// 16画素ぶんの色（0..255 の float）
+struct ColorBlock {
+	float rgb[16][3];
+	bool isUsed[16]; // 合わせる画素か（α が 0 の画素は BC3 では見えない）
+	uint32_t usedCount;
+};
+
+uint16_t PackColor565(const float color[3]) {
+	auto quantize = [](float value, float maxValue) {
+		return static_cast<uint16_t>(std::clamp(std::lround(value * maxValue / 255.0f), 0l, static_cast<long>(maxValue)));
+	};
+	return static_cast<uint16_t>(quantize(color[0], 31.0f) << 11 | quantize(color[1], 63.0f) << 5 | quantize(color[2], 31.0f));
+}
+
+void UnpackColor565(uint16_t packed, int color[3]) {
+	int r = packed >> 11 & 0x1F;
+	int g = packed >> 5 & 0x3F;
+	int b = packed & 0x1F;
+	color[0] = r << 3 | r >> 2;
+	color[1] = g << 2 | g >> 4;
+	color[2] = b << 3 | b >> 2;
+}
+
+// 端点2色から4色の表を作る（c0 <= c1 の BC1 なら3色＋透明）
+void MakePalette(uint16_t color0, uint16_t color1, bool isFourColor, int palette[4][4]) {
+	UnpackColor565(color0, palette[0]);
+	UnpackColor565(color1, palette[1]);
+	palette[0][3] = 255;
+	palette[1][3] = 255;
+	for (int c = 0; c < 3; ++c) {
+		if (isFourColor) {
+			palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+			palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+		} else {
+			palette[2][c] = (palette[0][c] + palette[1][c]) / 2;
+			palette[3][c] = 0;
+		}
+	}
+	palette[2][3] = 255;
+	palette[3][3] = isFourColor ? 255 : 0;
+}
+
+// 各画素に一番近い色を選ぶ（4色モード）。二乗誤差の合計を返す
+float ChooseIndices(const ColorBlock& block, uint16_t color0, uint16_t color1, uint8_t indices[16]) {
+	int palette[4][4];
+	MakePalette(color0, color1, true, palette);
+	float error = 0.0f;
+	for (int i = 0; i < 16; ++i) {
+		float best = 1.0e30f;
+		for (uint8_t p = 0; p < 4; ++p) {
+			float distance = 0.0f;
+			for (int c = 0; c < 3; ++c) {
+				float d = block.rgb[i][c] - static_cast<float>(palette[p][c]);
+				distance += d * d;
+			}
+			if (distance < best) {
+				best = distance;
+				indices[i] = p;
+			}
+		}
+		if (block.isUsed[i]) {
+			error += best;
+		}
+	}
+	return error;
+}
+
+// 選んだ番号のまま、端点を最小二乗で求め直す
+bool RefineEndpoints(const ColorBlock& block, const uint8_t indices[16], float endpoint0[3], float endpoint1[3]) {
+	// 番号ごとの c0 の割合
+	static const float kWeights[4] = {1.0f, 0.0f, 2.0f / 3.0f, 1.0f / 3.0f};
+	float aa = 0.0f;
+	float ab = 0.0f;
+	float bb = 0.0f;
+	float ax[3] = {};
+	float bx[3] = {};
+	for (int i = 0; i < 16; ++i) {
+		if (!block.isUsed[i]) {
+			continue;
+		}
+		float a = kWeights[indices[i]];
+		float b = 1.0f - a;
+		aa += a * a;
+		ab += a * b;
+		bb += b * b;
+		for (int c = 0; c < 3; ++c) {
+			ax[c] += a * block.rgb[i][c];
+			bx[c] += b * block.rgb[i][c];
+		}
+	}
+	float determinant = aa * bb - ab * ab;
+	if (std::abs(determinant) < 1.0e-6f) {
+		return false;
+	}
+	for (int c = 0; c < 3; ++c) {
+		endpoint0[c] = std::clamp((ax[c] * bb - bx[c] * ab) / determinant, 0.0f, 255.0f);
+		endpoint1[c] = std::clamp((bx[c] * aa - ax[c] * ab) / determinant, 0.0f, 255.0f);
+	}
+	return true;
+}
+
+void EncodeColor(const ColorBlock& block, uint8_t* out) {
+	uint16_t color0 = 0;
+	uint16_t color1 = 0;
+	uint8_t indices[16] = {};
+
+	if (block.usedCount > 0) {
+		// 平均と共分散
+		float mean[3] = {};
+		for (int i = 0; i < 16; ++i) {
+			if (block.isUsed[i]) {
+				for (int c = 0; c < 3; ++c) {
+					mean[c] += block.rgb[i][c];
+				}
+			}
+		}
+		for (float& m : mean) {
+			m /= static_cast<float>(block.usedCount);
+		}
+		float covariance[3][3] = {};
+		for (int i = 0; i < 16; ++i) {
+			if (!block.isUsed[i]) {
+				continue;
+			}
+			float d[3] = {block.rgb[i][0] - mean[0], block.rgb[i][1] - mean[1], block.rgb[i][2] - mean[2]};
+			for (int r = 0; r < 3; ++r) {
+				for (int c = 0; c < 3; ++c) {
+					covariance[r][c] += d[r] * d[c];
+				}
+			}
+		}
+
+		// 主軸（べき乗法）
+		float axis[3] = {1.0f, 1.0f, 1.0f};
+		for (int iteration = 0; iteration < 8; ++iteration) {
+			float next[3];
+			for (int r = 0; r < 3; ++r) {
+				next[r] = covariance[r][0] * axis[0] + covariance[r][1] * axis[1] + covariance[r][2] * axis[2];
+			}
+			float length = std::sqrt(next[0] * next[0] + next[1] * next[1] + next[2] * next[2]);
+			if (length < 1.0e-6f) {
+				break;
+			}
+			for (int c = 0; c < 3; ++c) {
+				axis[c] = next[c] / length;
+			}
+		}
+
+		// 主軸上の両端
+		float minT = 0.0f;
+		float maxT = 0.0f;
+		for (int i = 0; i < 16; ++i) {
+			if (!block.isUsed[i]) {
+				continue;
+			}
+			float t = (block.rgb[i][0] - mean[0]) * axis[0] + (block.rgb[i][1] - mean[1]) * axis[1] + (block.rgb[i][2] - mean[2]) * axis[2];
+			minT = (std::min)(minT, t);
+			maxT = (std::max)(maxT, t);
+		}
+		float endpoint0[3];
+		float endpoint1[3];
+		for (int c = 0; c < 3; ++c) {
+			endpoint0[c] = std::clamp(mean[c] + axis[c] * maxT, 0.0f, 255.0f);
+			endpoint1[c] = std::clamp(mean[c] + axis[c] * minT, 0.0f, 255.0f);
+		}
+		color0 = PackColor565(endpoint0);
+		color1 = PackColor565(endpoint1);
+		float error = ChooseIndices(block, color0, color1, indices);
+
+		// 最小二乗で詰め直し、良くなったときだけ使う
+		if (RefineEndpoints(block, indices, endpoint0, endpoint1)) {
+			uint16_t refined0 = PackColor565(endpoint0);
+			uint16_t refined1 = PackColor565(endpoint1);
+			uint8_t refinedIndices[16];
+			if (ChooseIndices(block, refined0, refined1, refinedIndices) < error) {
+				color0 = refined0;
+				color1 = refined1;
+				std::memcpy(indices, refinedIndices, sizeof(indices));
+			}
+		}
+
+		// 4色モードは color0 > color1
+		if (color0 < color1) {
+			std::swap(color0, color1);
+			for (uint8_t& index : indices) {
+				index = index < 2 ? static_cast<uint8_t>(1 - index) : static_cast<uint8_t>(5 - index);
+			}
+		} else if (color0 == color1) {
+			std::memset(indices, 0, sizeof(indices));
+		}
+	}
+
+	uint32_t bits = 0;
+	for (int i = 0; i < 16; ++i) {
+		bits |= static_cast<uint32_t>(indices[i]) << (i * 2);
+	}
+	out[0] = static_cast<uint8_t>(color0);
+	out[1] = static_cast<uint8_t>(color0 >> 8);
+	out[2] = static_cast<uint8_t>(color1);
+	out[3] = static_cast<uint8_t>(color1 >> 8);
+	for (int i = 0; i < 4; ++i) {
+		out[4 + i] = static_cast<uint8_t>(bits >> (i * 8));
+	}
+}
+
+void MakeAlphaPalette(uint8_t alpha0, uint8_t alpha1, int palette[8]) {
+	palette[0] = alpha0;
+	palette[1] = alpha1;
+	if (alpha0 > alpha1) {
+		for (int i = 1; i <= 6; ++i) {
+			palette[i + 1] = ((7 - i) * alpha0 + i * alpha1) / 7;
+		}
+	} else {
+		for (int i = 1; i <= 4; ++i) {
+			palette[i + 1] = ((5 - i) * alpha0 + i * alpha1) / 5;
+		}
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+}
+
+void EncodeAlpha(const uint8_t* pixels, uint8_t* out) {
+	uint8_t alpha0 = 0;
+	uint8_t alpha1 = 255;
+	for (int i = 0; i < 16; ++i) {
+		alpha0 = (std::max)(alpha0, pixels[i * 4 + 3]);
+		alpha1 = (std::min)(alpha1, pixels[i * 4 + 3]);
+	}
+
+	uint64_t bits = 0;
+	if (alpha0 > alpha1) {
+		int palette[8];
+		MakeAlphaPalette(alpha0, alpha1, palette);
+		for (int i = 0; i < 16; ++i) {
+			int alpha = pixels[i * 4 + 3];
+			uint64_t best = 0;
+			for (int p = 1; p < 8; ++p) {
+				if (std::abs(palette[p] - alpha) < std::abs(palette[best] - alpha)) {
+					best = static_cast<uint64_t>(p);
+				}
+			}
+			bits |= best << (i * 3);
+		}
+	}
+	out[0] = alpha0;
+	out[1] = alpha1;
+	for (int i = 0; i < 6; ++i) {
+		out[2 + i] = static_cast<uint8_t>(bits >> (i * 8));
+	}
+}
+
+ColorBlock MakeColorBlock(const uint8_t* pixels, bool isAlphaMasked) {
+	ColorBlock block;
+	block.usedCount = 0;
+	for (int i = 0; i < 16; ++i) {
+		for (int c = 0; c < 3; ++c) {
+			block.rgb[i][c] = static_cast<float>(pixels[i * 4 + c]);
+		}
+		block.isUsed[i] = !isAlphaMasked || pixels[i * 4 + 3] > 0;
+		block.usedCount += block.isUsed[i] ? 1 : 0;
+	}
+	return block;
+}
+
+} // namespace
+
+/// <summary>
+/// 4x4 画素（RGBA8。左上から行ごと）を BC1 にする（αは見ない）
+/// </summary>
+void BlockCompression::EncodeBC1(const uint8_t* pixels, uint8_t* out) { EncodeColor(MakeColorBlock(pixels, false), out); }
+
+/// <summary>
+/// 4x4 画素を BC3 にする（α が 0 の画素の色は合わせない）
+/// </summary>
+void BlockCompression::EncodeBC3(const uint8_t* pixels, uint8_t* out) {
+	EncodeAlpha(pixels, out);
+	EncodeColor(MakeColorBlock(pixels, true), out + 8);
+}
+
+/// <summary>
+/// BC1 を 4x4 画素に戻す
+/// </summary>
+void BlockCompression::DecodeBC1(const uint8_t* block, uint8_t* pixels) {
+	uint16_t color0 = static_cast<uint16_t>(block[0] | block[1] << 8);
+	uint16_t color1 = static_cast<uint16_t>(block[2] | block[3] << 8);
+	int palette[4][4];
+	MakePalette(color0, color1, color0 > color1, palette);
+	uint32_t bits = static_cast<uint32_t>(block[4]) | static_cast<uint32_t>(block[5]) << 8 | static_cast<uint32_t>(block[6]) << 16 | static_cast<uint32_t>(block[7]) << 24;
+	for (int i = 0; i < 16; ++i) {
+		const int* color = palette[bits >> (i * 2) & 0x3];
+		for (int c = 0; c < 4; ++c) {
+			pixels[i * 4 + c] = static_cast<uint8_t>(color[c]);
+		}
+	}
+}
+
+/// <summary>
+/// BC3 を 4x4 画素に戻す
+/// </summary>
+void BlockCompression::DecodeBC3(const uint8_t* block, uint8_t* pixels) {
+	// 色は常に4色モード
+	uint16_t color0 = static_cast<uint16_t>(block[8] | block[9] << 8);
+	uint16_t color1 = static_cast<uint16_t>(block[10] | block[11] << 8);
+	int palette[4][4];
+	MakePalette(color0, color1, true, palette);
+	uint32_t colorBits = static_cast<uint32_t>(block[12]) | static_cast<uint32_t>(block[13]) << 8 | static_cast<uint32_t>(block[14]) << 16 | static_cast<uint32_t>(block[15]) << 24;
+
+	int alphaPalette[8];
+	MakeAlphaPalette(block[0], block[1], alphaPalette);
+	uint64_t alphaBits = 0;
+	for (int i = 0; i < 6; ++i) {
+		alphaBits |= static_cast<uint64_t>(block[2 + i]) << (i * 8);
+	}
+
+	for (int i = 0; i < 16; ++i) {
+		const int* color = palette[colorBits >> (i * 2) & 0x3];
+		for (int c = 0; c < 3; ++c) {
+			pixels[i * 4 + c] = static_cast<uint8_t>(color[c]);
+		}
+		pixels[i * 4 + 3] = static_cast<uint8_t>(alphaPalette[alphaBits >> (i * 3) & 0x7]);
+	}
+}
+
+/// <summary>
+/// 画像全体を圧縮する（右端・下端の半端なブロックは端の画素を繰り返して埋める）
+/// </summary>
+std::vector<uint8_t> BlockCompression::Compress(const uint8_t* pixels, uint32_t width, uint32_t height, bool isBC3) {
+	const uint32_t blockColumns = (width + 3) / 4;
+	const uint32_t blockRows = (height + 3) / 4;
+	const uint32_t blockSize = isBC3 ? kBC3BlockSize : kBC1BlockSize;
+	std::vector<uint8_t> blocks(static_cast<size_t>(blockColumns) * blockRows * blockSize);
+
+	uint8_t tile[64];
+	for (uint32_t blockY = 0; blockY < blockRows; ++blockY) {
+		for (uint32_t blockX = 0; blockX < blockColumns; ++blockX) {
+			for (uint32_t i = 0; i < 16; ++i) {
+				uint32_t x = (std::min)(blockX * 4 + i % 4, width - 1);
+				uint32_t y = (std::min)(blockY * 4 + i / 4, height - 1);
+				std::memcpy(tile + i * 4, pixels + (static_cast<size_t>(y) * width + x) * 4, 4);
+			}
+			uint8_t* out = blocks.data() + (static_cast<size_t>(blockY) * blockColumns + blockX) * blockSize;
+			if (isBC3) {
+				EncodeBC3(tile, out);
+			} else {
+				EncodeBC1(tile, out);
+			}
+		}
+	}
+	return blocks;
+}
+
+/// <summary>
+/// 画像全体を展開する
+/// </summary>
+std::vector<uint8_t> BlockCompression::Decompress(const uint8_t* blocks, uint32_t width, uint32_t height, bool isBC3) {
+	const uint32_t blockColumns = (width + 3) / 4;
+	const uint32_t blockRows = (height + 3) / 4;
+	const uint32_t blockSize = isBC3 ? kBC3BlockSize : kBC1BlockSize;
+	std::vector<uint8_t> pixels(static_cast<size_t>(width) * height * 4);
+
+	uint8_t tile[64];
+	for (uint32_t blockY = 0; blockY < blockRows; ++blockY) {
+		for (uint32_t blockX = 0; blockX < blockColumns; ++blockX) {
+			const uint8_t* block = blocks + (static_cast<size_t>(blockY) * blockColumns + blockX) * blockSize;
+			if (isBC3) {
+				DecodeBC3(block, tile);
+			} else {
+				DecodeBC1(block, tile);
+			}
+			for (uint32_t i = 0; i < 16; ++i) {
+				uint32_t x = blockX * 4 + i % 4;
+				uint32_t y = blockY * 4 + i / 4;
+				if (x < width && y < height) {
+					std::memcpy(pixels.data() + (static_cast<size_t>(y) * width + x) * 4, tile + i * 4, 4);
+				}
+			}
+		}
+	}
+	return pixels;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+/// <summary>
+/// ツール用の BC1 / BC3 の圧縮と展開（外部ライブラリを使わない）
+/// ・色: 4x4 画素の主軸（共分散の最大固有ベクトル）上の両端を端点にし、最小二乗で1回詰め直す
+/// ・α（BC3）: 最小と最大を端点にした8段階
+/// </summary>
+class BlockCompression {
+public:
+	// 1ブロックのバイト数
+	static inline const uint32_t kBC1BlockSize = 8;
+	static inline const uint32_t kBC3BlockSize = 16;
+
+	/// <summary>
+	/// 4x4 画素（RGBA8。左上から行ごと）を BC1 にする（αは見ない）
+	/// </summary>
+	/// <param name="pixels"></param>
+	/// <param name="out">8バイト</param>
+	static void EncodeBC1(const uint8_t* pixels, uint8_t* out);
+	/// <summary>
+	/// 4x4 画素を BC3 にする（α が 0 の画素の色は合わせない）
+	/// </summary>
+	/// <param name="pixels"></param>
+	/// <param name="out">16バイト</param>
+	static void EncodeBC3(const uint8_t* pixels, uint8_t* out);
+
+	/// <summary>
+	/// BC1 を 4x4 画素に戻す
+	/// </summary>
+	/// <param name="block"></param>
+	/// <param name="pixels">64バイト</param>
+	static void DecodeBC1(const uint8_t* block, uint8_t* pixels);
+	/// <summary>
+	/// BC3 を 4x4 画素に戻す
+	/// </summary>
+	/// <param name="block"></param>
+	/// <param name="pixels">64バイト</param>
+	static void DecodeBC3(const uint8_t* block, uint8_t* pixels);
+
+	/// <summary>
+	/// 画像全体を圧縮する（右端・下端の半端なブロックは端の画素を繰り返して埋める）
+	/// </summary>
+	/// <param name="pixels">RGBA8</param>
+	/// <param name="width"></param>
+	/// <param name="height"></param>
+	/// <param name="isBC3">false なら BC1</param>
+	/// <returns>ブロック列（左上から行ごと）</returns>
+	static std::vector<uint8_t> Compress(const uint8_t* pixels, uint32_t width, uint32_t height, bool isBC3);
+	/// <summary>
+	/// 画像全体を展開する
+	/// </summary>
+	/// <param name="blocks"></param>
+	/// <param name="width"></param>
+	/// <param name="height"></param>
+	/// <param name="isBC3"></param>
+	/// <returns>RGBA8</returns>
+	static std::vector<uint8_t> Decompress(const uint8_t* blocks, uint32_t width, uint32_t height, bool isBC3);
+};
@@ -0,0 +1,821 @@
+#define NOMINMAX
+#include "PngImage.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+namespace {
+
+const uint8_t kSignature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+// 色の種類（IHDR の color type）
+enum ColorType : uint8_t {
+	kGray = 0,
+	kRgb = 2,
+	kPalette = 3,
+	kGrayAlpha = 4,
+	kRgba = 6,
+};
+
+uint32_t ReadBigEndian(const uint8_t* p) { return (static_cast<uint32_t>(p[0]) << 24) | (static_cast<uint32_t>(p[1]) << 16) | (static_cast<uint32_t>(p[2]) << 8) | p[3]; }
+
+void WriteBigEndian(std::vector<uint8_t>& out, uint32_t value) {
+	out.push_back(static_cast<uint8_t>(value >> 24));
+	out.push_back(static_cast<uint8_t>(value >> 16));
+	out.push_back(static_cast<uint8_t>(value >> 8));
+	out.push_back(static_cast<uint8_t>(value));
+}
+
+uint32_t Adler32(const uint8_t* data, size_t size) {
+	uint32_t a = 1;
+	uint32_t b = 0;
+	while (size > 0) {
+		// 5552 バイトまでは 32bit であふれない
+		size_t block = (std::min)(size, static_cast<size_t>(5552));
+		size -= block;
+		for (size_t i = 0; i < block; ++i) {
+			a += data[i];
+			b += a;
+		}
+		data += block;
+		a %= 65521;
+		b %= 65521;
+	}
+	return (b << 16) | a;
+}
+
+///===========================================
+/// 展開（RFC 1950 / 1951）
+/// ===========================================
+
+const uint16_t kLengthBase[29] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t kLengthExtra[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t kDistanceBase[30] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t kDistanceExtra[30] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+// 符号長の符号長が並ぶ順
+const uint8_t kCodeLengthOrder[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+const int kMaxBits = 15;
+
+/// <summary>
+/// LSB から順に読むビット列
+/// </summary>
+class BitReader {
+private:
+	const uint8_t* data_;
+	size_t size_;
+	size_t position_ = 0;
+	uint32_t buffer_ = 0;
+	int count_ = 0;
+
+public:
+	BitReader(const uint8_t* data, size_t size) : data_(data), size_(size) {}
+
+	// 読み過ぎたか（足りない分は 0 として読む）
+	bool overrun = false;
+
+	uint32_t Bits(int count) {
+		while (count_ < count) {
+			uint32_t byte = 0;
+			if (position_ < size_) {
+				byte = data_[position_++];
+			} else {
+				overrun = true;
+			}
+			buffer_ |= byte << count_;
+			count_ += 8;
+		}
+		uint32_t value = buffer_ & ((1u << count) - 1);
+		buffer_ >>= count;
+		count_ -= count;
+		return value;
+	}
+
+	// バイト境界まで捨てて、読み途中のバイトを返す
+	void AlignToByte() {
+		buffer_ = 0;
+		count_ = 0;
+	}
+
+	size_t GetPosition() const { return position_; }
+	void Skip(size_t count) { position_ += count; }
+};
+
+/// <summary>
+/// 正準ハフマン符号（長さごとの数と、符号順の記号）
+/// </summary>
+struct Huffman {
+	uint16_t counts[kMaxBits + 1];
+	uint16_t symbols[288];
+
+	// 長さの並びから作る（過剰な符号なら false。足りない符号は許す）
+	bool Build(const uint8_t* lengths, int count) {
+		std::memset(counts, 0, sizeof(counts));
+		for (int i = 0; i < count; ++i) {
+			++counts[lengths[i]];
+		}
+		int left = 1;
+		for (int length = 1; length <= kMaxBits; ++length) {
+			left <<= 1;
+			left -= counts[length];
+			if (left < 0) {
+				return false;
+			}
+		}
+		uint16_t offsets[kMaxBits + 1];
+		offsets[1] = 0;
+		for (int length = 1; length < kMaxBits; ++length) {
+			offsets[length + 1] = offsets[length] + counts[length];
+		}
+		for (int i = 0; i < count; ++i) {
+			if (lengths[i] != 0) {
+				symbols[offsets[lengths[i]]++] = static_cast<uint16_t>(i);
+			}
+		}
+		return true;
+	}
+
+	// 1記号読む（読めなければ -1）
+	int Decode(BitReader& reader) const {
+		int code = 0;
+		int first = 0;
+		int index = 0;
+		for (int length = 1; length <= kMaxBits; ++length) {
+			code |= static_cast<int>(reader.Bits(1));
+			int count = counts[length];
+			if (code - count < first) {
+				return symbols[index + (code - first)];
+			}
+			index += count;
+			first += count;
+			first <<= 1;
+			code <<= 1;
+		}
+		return -1;
+	}
+};
+
+/// <summary>
+/// ハフマン符号で詰めた1ブロックを展開する
+/// </summary>
+bool InflateCodes(BitReader& reader, const Huffman& literal, const Huffman& distance, std::vector<uint8_t>& out) {
+	for (;;) {
+		int symbol = literal.Decode(reader);
+		if (symbol < 0 || reader.overrun) {
+			return false;
+		}
+		if (symbol < 256) {
+			out.push_back(static_cast<uint8_t>(symbol));
+			continue;
+		}
+		if (symbol == 256) {
+			return true;
+		}
+		symbol -= 257;
+		if (symbol >= 29) {
+			return false;
+		}
+		size_t length = kLengthBase[symbol] + reader.Bits(kLengthExtra[symbol]);
+		int distanceSymbol = distance.Decode(reader);
+		if (distanceSymbol < 0 || distanceSymbol >= 30) {
+			return false;
+		}
+		size_t back = kDistanceBase[distanceSymbol] + reader.Bits(kDistanceExtra[distanceSymbol]);
+		if (back > out.size()) {
+			return false;
+		}
+		// 重なることがあるので1バイトずつ
+		size_t from = out.size() - back;
+		for (size_t i = 0; i < length; ++i) {
+			out.push_back(out[from + i]);
+		}
+	}
+}
+
+///===========================================
+/// 圧縮（固定ハフマン）
+/// ===========================================
+
+/// <summary>
+/// LSB から順に書くビット列
+/// </summary>
+class BitWriter {
+private:
+	std::vector<uint8_t>& out_;
+	uint32_t buffer_ = 0;
+	int count_ = 0;
+
+public:
+	explicit BitWriter(std::vector<uint8_t>& out) : out_(out) {}
+
+	void Bits(uint32_t value, int count) {
+		buffer_ |= value << count_;
+		count_ += count;
+		while (count_ >= 8) {
+			out_.push_back(static_cast<uint8_t>(buffer_));
+			buffer_ >>= 8;
+			count_ -= 8;
+		}
+	}
+
+	// ハフマン符号は MSB から書く
+	void Code(uint32_t code, int count) {
+		uint32_t reversed = 0;
+		for (int i = 0; i < count; ++i) {
+			reversed = (reversed << 1) | ((code >> i) & 1);
+		}
+		Bits(reversed, count);
+	}
+
+	void Flush() {
+		if (count_ > 0) {
+			out_.push_back(static_cast<uint8_t>(buffer_));
+		}
+		buffer_ = 0;
+		count_ = 0;
+	}
+};
+
+// 固定ハフマンのリテラル・長さの符号
+void WriteFixedLiteral(BitWriter& writer, uint32_t symbol) {
+	if (symbol < 144) {
+		writer.Code(0x30 + symbol, 8);
+	} else if (symbol < 256) {
+		writer.Code(0x190 + symbol - 144, 9);
+	} else if (symbol < 280) {
+		writer.Code(symbol - 256, 7);
+	} else {
+		writer.Code(0xC0 + symbol - 280, 8);
+	}
+}
+
+const size_t kWindowSize = 32768;
+const size_t kMinMatch = 3;
+const size_t kMaxMatch = 258;
+const int kHashBits = 15;
+// 一致を探す候補の数（多いほど縮むが遅い）
+const int kMaxChain = 64;
+
+uint32_t Hash3(const uint8_t* p) { return ((static_cast<uint32_t>(p[0]) << 16 | static_cast<uint32_t>(p[1]) << 8 | p[2]) * 2654435761u) >> (32 - kHashBits); }
+
+///===========================================
+/// フィルタ
+/// ===========================================
+
+uint8_t Paeth(uint8_t a, uint8_t b, uint8_t c) {
+	int p = static_cast<int>(a) + b - c;
+	int pa = std::abs(p - a);
+	int pb = std::abs(p - b);
+	int pc = std::abs(p - c);
+	if (pa <= pb && pa <= pc) {
+		return a;
+	}
+	return pb <= pc ? b : c;
+}
+
+} // namespace
+
+/// <summary>
+/// 透明で埋めた大きさにする
+/// </summary>
+void PngImage::Resize(uint32_t width, uint32_t height) {
+	width_ = width;
+	height_ = height;
+	pixels_.assign(static_cast<size_t>(width) * height * 4, 0);
+}
+
+/// <summary>
+/// 読む
+/// </summary>
+bool PngImage::Load(const std::string& filePath, std::string* error) {
+	std::ifstream file(filePath, std::ios::binary);
+	if (!file) {
+		if (error) {
+			*error = "cannot open";
+		}
+		return false;
+	}
+	std::vector<uint8_t> data((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return Decode(data.data(), data.size(), error);
+}
+
+/// <summary>
+/// メモリ上の PNG を読む
+/// </summary>
+bool PngImage::Decode(const uint8_t* data, size_t size, std::string* error) {
+	auto fail = [&](const char* message) {
+		if (error) {
+			*error = message;
+		}
+		width_ = 0;
+		height_ = 0;
+		pixels_.clear();
+		return false;
+	};
+
+	if (size < 8 || std::memcmp(data, kSignature, 8) != 0) {
+		return fail("not a PNG");
+	}
+
+	uint32_t width = 0;
+	uint32_t height = 0;
+	uint8_t colorType = 0;
+	uint8_t palette[256][4] = {};
+	uint32_t paletteCount = 0;
+	// グレー / RGB の透過色（tRNS）
+	bool hasColorKey = false;
+	uint16_t colorKey[3] = {};
+	std::vector<uint8_t> compressed;
+
+	size_t position = 8;
+	bool hasEnd = false;
+	while (!hasEnd) {
+		if (size - position < 12) {
+			return fail("truncated chunk");
+		}
+		uint32_t length = ReadBigEndian(data + position);
+		if (length > size - position - 12) {
+			return fail("truncated chunk");
+		}
+		const uint8_t* type = data + position + 4;
+		const uint8_t* body = data + position + 8;
+		if (Crc32(type, length + 4) != ReadBigEndian(body + length)) {
+			return fail("CRC mismatch");
+		}
+		position += 12 + length;
+
+		if (std::memcmp(type, "IHDR", 4) == 0) {
+			if (length != 13) {
+				return fail("bad IHDR");
+			}
+			width = ReadBigEndian(body);
+			height = ReadBigEndian(body + 4);
+			uint8_t bitDepth = body[8];
+			colorType = body[9];
+			if (bitDepth != 8) {
+				return fail("only 8-bit images are supported");
+			}
+			if (colorType != kGray && colorType != kRgb && colorType != kPalette && colorType != kGrayAlpha && colorType != kRgba) {
+				return fail("bad color type");
+			}
+			if (body[10] != 0 || body[11] != 0) {
+				return fail("bad compression or filter method");
+			}
+			if (body[12] != 0) {
+				return fail("interlaced images are not supported");
+			}
+			if (width == 0 || height == 0 || width > 16384 || height > 16384) {
+				return fail("bad size");
+			}
+		} else if (std::memcmp(type, "PLTE", 4) == 0) {
+			if (length % 3 != 0 || length / 3 > 256) {
+				return fail("bad PLTE");
+			}
+			paletteCount = length / 3;
+			for (uint32_t i = 0; i < paletteCount; ++i) {
+				palette[i][0] = body[i * 3];
+				palette[i][1] = body[i * 3 + 1];
+				palette[i][2] = body[i * 3 + 2];
+				palette[i][3] = 255;
+			}
+		} else if (std::memcmp(type, "tRNS", 4) == 0) {
+			if (colorType == kPalette) {
+				for (uint32_t i = 0; i < length && i < 256; ++i) {
+					palette[i][3] = body[i];
+				}
+			} else if (colorType == kGray && length >= 2) {
+				hasColorKey = true;
+				colorKey[0] = static_cast<uint16_t>(body[0] << 8 | body[1]);
+			} else if (colorType == kRgb && length >= 6) {
+				hasColorKey = true;
+				for (int i = 0; i < 3; ++i) {
+					colorKey[i] = static_cast<uint16_t>(body[i * 2] << 8 | body[i * 2 + 1]);
+				}
+			}
+		} else if (std::memcmp(type, "IDAT", 4) == 0) {
+			compressed.insert(compressed.end(), body, body + length);
+		} else if (std::memcmp(type, "IEND", 4) == 0) {
+			hasEnd = true;
+		} else if ((type[0] & 0x20) == 0) {
+			// 知らない必須チャンク
+			return fail("unknown critical chunk");
+		}
+	}
+	if (width == 0) {
+		return fail("missing IHDR");
+	}
+	if (colorType == kPalette && paletteCount == 0) {
+		return fail("missing PLTE");
+	}
+
+	const uint32_t channels = colorType == kGray ? 1 : colorType == kRgb ? 3 : colorType == kPalette ? 1 : colorType == kGrayAlpha ? 2 : 4;
+	const size_t stride = static_cast<size_t>(width) * channels;
+
+	std::vector<uint8_t> raw;
+	raw.reserve((stride + 1) * height);
+	if (!Inflate(compressed.data(), compressed.size(), raw)) {
+		return fail("bad zlib stream");
+	}
+	if (raw.size() < (stride + 1) * height) {
+		return fail("not enough image data");
+	}
+
+	// フィルタを戻す（その場で。前の行は戻し済み）
+	for (uint32_t y = 0; y < height; ++y) {
+		uint8_t filter = raw[y * (stride + 1)];
+		uint8_t* line = &raw[y * (stride + 1) + 1];
+		const uint8_t* previous = y > 0 ? &raw[(y - 1) * (stride + 1) + 1] : nullptr;
+		for (size_t x = 0; x < stride; ++x) {
+			uint8_t a = x >= channels ? line[x - channels] : 0;
+			uint8_t b = previous ? previous[x] : 0;
+			uint8_t c = previous && x >= channels ? previous[x - channels] : 0;
+			switch (filter) {
+			case 0:
+				break;
+			case 1:
+				line[x] = static_cast<uint8_t>(line[x] + a);
+				break;
+			case 2:
+				line[x] = static_cast<uint8_t>(line[x] + b);
+				break;
+			case 3:
+				line[x] = static_cast<uint8_t>(line[x] + ((a + b) >> 1));
+				break;
+			case 4:
+				line[x] = static_cast<uint8_t>(line[x] + Paeth(a, b, c));
+				break;
+			default:
+				return fail("bad filter type");
+			}
+		}
+	}
+
+	// RGBA8 にそろえる
+	Resize(width, height);
+	for (uint32_t y = 0; y < height; ++y) {
+		const uint8_t* line = &raw[y * (stride + 1) + 1];
+		uint8_t* dst = At(0, y);
+		for (uint32_t x = 0; x < width; ++x, dst += 4) {
+			const uint8_t* src = line + x * channels;
+			switch (colorType) {
+			case kGray:
+				dst[0] = dst[1] = dst[2] = src[0];
+				dst[3] = hasColorKey && src[0] == colorKey[0] ? 0 : 255;
+				break;
+			case kRgb:
+				dst[0] = src[0];
+				dst[1] = src[1];
+				dst[2] = src[2];
+				dst[3] = hasColorKey && src[0] == colorKey[0] && src[1] == colorKey[1] && src[2] == colorKey[2] ? 0 : 255;
+				break;
+			case kPalette:
+				if (src[0] >= paletteCount) {
+					return fail("palette index out of range");
+				}
+				std::memcpy(dst, palette[src[0]], 4);
+				break;
+			case kGrayAlpha:
+				dst[0] = dst[1] = dst[2] = src[0];
+				dst[3] = src[1];
+				break;
+			default:
+				std::memcpy(dst, src, 4);
+				break;
+			}
+		}
+	}
+	return true;
+}
+
+/// <summary>
+/// 書く
+/// </summary>
+bool PngImage::Save(const std::string& filePath) const {
+	std::vector<uint8_t> data = Encode();
+	std::ofstream file(filePath, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+	file.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+	return static_cast<bool>(file);
+}
+
+/// <summary>
+/// PNG のバイト列にする
+/// </summary>
+std::vector<uint8_t> PngImage::Encode() const {
+	const size_t stride = static_cast<size_t>(width_) * 4;
+
+	// 行ごとに、差の絶対値の和が一番小さいフィルタを選ぶ
+	std::vector<uint8_t> raw((stride + 1) * height_);
+	std::vector<uint8_t> candidate(stride);
+	for (uint32_t y = 0; y < height_; ++y) {
+		const uint8_t* line = &pixels_[y * stride];
+		const uint8_t* previous = y > 0 ? &pixels_[(y - 1) * stride] : nullptr;
+		uint8_t* out = &raw[y * (stride + 1)];
+		uint64_t bestCost = UINT64_MAX;
+		for (uint8_t filter = 0; filter <= 4; ++filter) {
+			uint64_t cost = 0;
+			for (size_t x = 0; x < stride; ++x) {
+				uint8_t a = x >= 4 ? line[x - 4] : 0;
+				uint8_t b = previous ? previous[x] : 0;
+				uint8_t c = previous && x >= 4 ? previous[x - 4] : 0;
+				uint8_t predicted = filter == 0 ? 0 : filter == 1 ? a : filter == 2 ? b : filter == 3 ? static_cast<uint8_t>((a + b) >> 1) : Paeth(a, b, c);
+				candidate[x] = static_cast<uint8_t>(line[x] - predicted);
+				cost += static_cast<uint64_t>(std::abs(static_cast<int8_t>(candidate[x])));
+			}
+			if (cost < bestCost) {
+				bestCost = cost;
+				out[0] = filter;
+				std::memcpy(out + 1, candidate.data(), stride);
+			}
+		}
+	}
+	std::vector<uint8_t> compressed = Deflate(raw.data(), raw.size());
+
+	std::vector<uint8_t> data(kSignature, kSignature + 8);
+	auto writeChunk = [&data](const char* type, const uint8_t* body, size_t length) {
+		WriteBigEndian(data, static_cast<uint32_t>(length));
+		size_t start = data.size();
+		data.insert(data.end(), type, type + 4);
+		data.insert(data.end(), body, body + length);
+		WriteBigEndian(data, Crc32(&data[start], length + 4));
+	};
+
+	std::vector<uint8_t> header;
+	WriteBigEndian(header, width_);
+	WriteBigEndian(header, height_);
+	header.push_back(8);     // ビット深度
+	header.push_back(kRgba); // 色の種類
+	header.push_back(0);     // 圧縮
+	header.push_back(0);     // フィルタ
+	header.push_back(0);     // インターレース無し
+	writeChunk("IHDR", header.data(), header.size());
+	writeChunk("IDAT", compressed.data(), compressed.size());
+	writeChunk("IEND", nullptr, 0);
+	return data;
+}
+
+/// <summary>
+/// src の一部を写す
+/// </summary>
+void PngImage::Blit(const PngImage& src, uint32_t srcX, uint32_t srcY, uint32_t width, uint32_t height, uint32_t x, uint32_t y) {
+	if (srcX >= src.width_ || srcY >= src.height_ || x >= width_ || y >= height_) {
+		return;
+	}
+	width = (std::min)({width, src.width_ - srcX, width_ - x});
+	height = (std::min)({height, src.height_ - srcY, height_ - y});
+	for (uint32_t row = 0; row < height; ++row) {
+		std::memcpy(At(x, y + row), src.At(srcX, srcY + row), static_cast<size_t>(width) * 4);
+	}
+}
+
+/// <summary>
+/// 不透明な画素を囲む最小の矩形
+/// </summary>
+bool PngImage::GetOpaqueBounds(uint32_t& left, uint32_t& top, uint32_t& right, uint32_t& bottom) const {
+	left = width_;
+	top = height_;
+	right = 0;
+	bottom = 0;
+	for (uint32_t y = 0; y < height_; ++y) {
+		for (uint32_t x = 0; x < width_; ++x) {
+			if (At(x, y)[3] != 0) {
+				left = (std::min)(left, x);
+				top = (std::min)(top, y);
+				right = (std::max)(right, x + 1);
+				bottom = (std::max)(bottom, y + 1);
+			}
+		}
+	}
+	return left < right;
+}
+
+/// <summary>
+/// zlib 形式を展開する
+/// </summary>
+bool PngImage::Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& out) {
+	if (size < 6) {
+		return false;
+	}
+	// CMF / FLG（deflate・辞書無し）
+	if ((data[0] & 0x0F) != 8 || (data[0] >> 4) > 7 || (data[0] << 8 | data[1]) % 31 != 0 || (data[1] & 0x20) != 0) {
+		return false;
+	}
+	const size_t start = out.size();
+	BitReader reader(data + 2, size - 6);
+
+	bool isFinal = false;
+	while (!isFinal) {
+		isFinal = reader.Bits(1) != 0;
+		uint32_t type = reader.Bits(2);
+		if (type == 0) {
+			// 無圧縮
+			reader.AlignToByte();
+			size_t position = reader.GetPosition();
+			if (size - 6 - position < 4) {
+				return false;
+			}
+			const uint8_t* p = data + 2 + position;
+			uint32_t length = p[0] | p[1] << 8;
+			uint32_t inverse = p[2] | p[3] << 8;
+			if ((length ^ 0xFFFF) != inverse || size - 6 - position - 4 < length) {
+				return false;
+			}
+			out.insert(out.end(), p + 4, p + 4 + length);
+			reader.Skip(4 + length);
+		} else if (type == 1) {
+			// 固定ハフマン
+			static Huffman fixedLiteral;
+			static Huffman fixedDistance;
+			static bool isFixedBuilt = false;
+			if (!isFixedBuilt) {
+				uint8_t lengths[288];
+				std::fill(lengths, lengths + 144, static_cast<uint8_t>(8));
+				std::fill(lengths + 144, lengths + 256, static_cast<uint8_t>(9));
+				std::fill(lengths + 256, lengths + 280, static_cast<uint8_t>(7));
+				std::fill(lengths + 280, lengths + 288, static_cast<uint8_t>(8));
+				fixedLiteral.Build(lengths, 288);
+				std::fill(lengths, lengths + 30, static_cast<uint8_t>(5));
+				fixedDistance.Build(lengths, 30);
+				isFixedBuilt = true;
+			}
+			if (!InflateCodes(reader, fixedLiteral, fixedDistance, out)) {
+				return false;
+			}
+		} else if (type == 2) {
+			// 動的ハフマン
+			uint32_t literalCount = reader.Bits(5) + 257;
+			uint32_t distanceCount = reader.Bits(5) + 1;
+			uint32_t codeLengthCount = reader.Bits(4) + 4;
+			if (literalCount > 286 || distanceCount > 30) {
+				return false;
+			}
+			uint8_t lengths[320] = {};
+			for (uint32_t i = 0; i < codeLengthCount; ++i) {
+				lengths[kCodeLengthOrder[i]] = static_cast<uint8_t>(reader.Bits(3));
+			}
+			Huffman codeLength;
+			if (!codeLength.Build(lengths, 19)) {
+				return false;
+			}
+			uint32_t index = 0;
+			while (index < literalCount + distanceCount) {
+				int symbol = codeLength.Decode(reader);
+				if (symbol < 0 || reader.overrun) {
+					return false;
+				}
+				if (symbol < 16) {
+					lengths[index++] = static_cast<uint8_t>(symbol);
+					continue;
+				}
+				uint8_t value = 0;
+				uint32_t repeat = 0;
+				if (symbol == 16) {
+					if (index == 0) {
+						return false;
+					}
+					value = lengths[index - 1];
+					repeat = 3 + reader.Bits(2);
+				} else if (symbol == 17) {
+					repeat = 3 + reader.Bits(3);
+				} else {
+					repeat = 11 + reader.Bits(7);
+				}
+				if (index + repeat > literalCount + distanceCount) {
+					return false;
+				}
+				std::fill(lengths + index, lengths + index + repeat, value);
+				index += repeat;
+			}
+			if (lengths[256] == 0) {
+				return false;
+			}
+			Huffman literal;
+			Huffman distance;
+			if (!literal.Build(lengths, static_cast<int>(literalCount)) || !distance.Build(lengths + literalCount, static_cast<int>(distanceCount))) {
+				return false;
+			}
+			if (!InflateCodes(reader, literal, distance, out)) {
+				return false;
+			}
+		} else {
+			return false;
+		}
+		if (reader.overrun) {
+			return false;
+		}
+	}
+
+	return Adler32(out.data() + start, out.size() - start) == ReadBigEndian(data + size - 4);
+}
+
+/// <summary>
+/// zlib 形式に圧縮する（LZ77 + 固定ハフマンの1ブロック）
+/// </summary>
+std::vector<uint8_t> PngImage::Deflate(const uint8_t* data, size_t size) {
+	std::vector<uint8_t> out = {0x78, 0x01};
+	BitWriter writer(out);
+	writer.Bits(1, 1); // 最後のブロック
+	writer.Bits(1, 2); // 固定ハフマン
+
+	// 同じハッシュの直前の位置をたどる表
+	std::vector<int32_t> head(static_cast<size_t>(1) << kHashBits, -1);
+	std::vector<int32_t> previous(kWindowSize, -1);
+	auto insert = [&](size_t position) {
+		if (position + kMinMatch <= size) {
+			uint32_t hash = Hash3(data + position);
+			previous[position % kWindowSize] = head[hash];
+			head[hash] = static_cast<int32_t>(position);
+		}
+	};
+
+	size_t position = 0;
+	while (position < size) {
+		size_t bestLength = 0;
+		size_t bestDistance = 0;
+		if (position + kMinMatch <= size) {
+			const size_t maxLength = (std::min)(kMaxMatch, size - position);
+			int32_t candidate = head[Hash3(data + position)];
+			for (int chain = 0; chain < kMaxChain && candidate >= 0; ++chain) {
+				size_t distance = position - static_cast<size_t>(candidate);
+				if (distance > kWindowSize - 1) {
+					break;
+				}
+				size_t length = 0;
+				const uint8_t* a = data + candidate;
+				const uint8_t* b = data + position;
+				while (length < maxLength && a[length] == b[length]) {
+					++length;
+				}
+				if (length > bestLength) {
+					bestLength = length;
+					bestDistance = distance;
+					if (length == maxLength) {
+						break;
+					}
+				}
+				int32_t next = previous[static_cast<size_t>(candidate) % kWindowSize];
+				// 窓から外れた古い位置は上書きされていることがある
+				if (next >= candidate) {
+					break;
+				}
+				candidate = next;
+			}
+		}
+
+		if (bestLength >= kMinMatch) {
+			uint32_t lengthSymbol = 0;
+			while (lengthSymbol < 28 && kLengthBase[lengthSymbol + 1] <= bestLength) {
+				++lengthSymbol;
+			}
+			WriteFixedLiteral(writer, 257 + lengthSymbol);
+			writer.Bits(static_cast<uint32_t>(bestLength - kLengthBase[lengthSymbol]), kLengthExtra[lengthSymbol]);
+			uint32_t distanceSymbol = 0;
+			while (distanceSymbol < 29 && kDistanceBase[distanceSymbol + 1] <= bestDistance) {
+				++distanceSymbol;
+			}
+			writer.Code(distanceSymbol, 5);
+			writer.Bits(static_cast<uint32_t>(bestDistance - kDistanceBase[distanceSymbol]), kDistanceExtra[distanceSymbol]);
+			for (size_t i = 0; i < bestLength; ++i) {
+				insert(position + i);
+			}
+			position += bestLength;
+		} else {
+			WriteFixedLiteral(writer, data[position]);
+			insert(position);
+			++position;
+		}
+	}
+	WriteFixedLiteral(writer, 256);
+	writer.Flush();
+
+	WriteBigEndian(out, Adler32(data, size));
+	return out;
+}
+
+/// <summary>
+/// CRC-32
+/// </summary>
+uint32_t PngImage::Crc32(const uint8_t* data, size_t size, uint32_t crc) {
+	static uint32_t table[256];
+	static bool isTableBuilt = false;
+	if (!isTableBuilt) {
+		for (uint32_t i = 0; i < 256; ++i) {
+			uint32_t value = i;
+			for (int bit = 0; bit < 8; ++bit) {
+				value = value & 1 ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+			}
+			table[i] = value;
+		}
+		isTableBuilt = true;
+	}
+	crc = ~crc;
+	for (size_t i = 0; i < size; ++i) {
+		crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+	}
+	return ~crc;
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// ツール用の PNG の読み書き（外部ライブラリを使わない）
+/// ・読み: 8bit のグレー / RGB / パレット / グレー+α / RGBA（インターレース無し）を RGBA8 にそろえる
+/// ・書き: RGBA8 を、行ごとにフィルタを選び、LZ77 + 固定ハフマンの deflate で詰める
+/// </summary>
+class PngImage {
+private:
+	uint32_t width_ = 0;
+	uint32_t height_ = 0;
+	// RGBA8。上の行から
+	std::vector<uint8_t> pixels_;
+
+public:
+	/// <summary>
+	/// 透明で埋めた大きさ width x height にする
+	/// </summary>
+	/// <param name="width"></param>
+	/// <param name="height"></param>
+	void Resize(uint32_t width, uint32_t height);
+
+	/// <summary>
+	/// 読む（対応していない形式・壊れていれば false。理由は error に入れる）
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <param name="error"></param>
+	/// <returns></returns>
+	bool Load(const std::string& filePath, std::string* error = nullptr);
+	/// <summary>
+	/// メモリ上の PNG を読む
+	/// </summary>
+	bool Decode(const uint8_t* data, size_t size, std::string* error = nullptr);
+
+	/// <summary>
+	/// 書く
+	/// </summary>
+	/// <param name="filePath"></param>
+	/// <returns></returns>
+	bool Save(const std::string& filePath) const;
+	/// <summary>
+	/// PNG のバイト列にする
+	/// </summary>
+	std::vector<uint8_t> Encode() const;
+
+	/// <summary>
+	/// src の (srcX, srcY) から width x height を (x, y) に写す（はみ出す分は写さない）
+	/// </summary>
+	void Blit(const PngImage& src, uint32_t srcX, uint32_t srcY, uint32_t width, uint32_t height, uint32_t x, uint32_t y);
+
+	/// <summary>
+	/// 不透明な画素を囲む最小の矩形（全て透明なら false）
+	/// </summary>
+	bool GetOpaqueBounds(uint32_t& left, uint32_t& top, uint32_t& right, uint32_t& bottom) const;
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	uint32_t GetWidth() const { return width_; }
+	uint32_t GetHeight() const { return height_; }
+	const std::vector<uint8_t>& GetPixels() const { return pixels_; }
+	std::vector<uint8_t>& GetPixels() { return pixels_; }
+	uint8_t* At(uint32_t x, uint32_t y) { return &pixels_[(static_cast<size_t>(y) * width_ + x) * 4]; }
+	const uint8_t* At(uint32_t x, uint32_t y) const { return &pixels_[(static_cast<size_t>(y) * width_ + x) * 4]; }
+
+	/// <summary>
+	/// zlib 形式の展開・圧縮（PNG の IDAT 用。他のツールからも使う）
+	/// </summary>
+	static bool Inflate(const uint8_t* data, size_t size, std::vector<uint8_t>& out);
+	static std::vector<uint8_t> Deflate(const uint8_t* data, size_t size);
+
+	/// <summary>
+	/// CRC-32（PNG のチャンク用）
+	/// </summary>
+	static uint32_t Crc32(const uint8_t* data, size_t size, uint32_t crc = 0);
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstdio>
+
+/// <summary>
+/// ツールのテスト用の確認（外部ライブラリを使わない）
+/// ・CHECK(式) が偽なら場所と式を出して失敗を数える（そのまま続ける）
+/// ・最後に TestCheck::Finish() の戻り値を main から返す（全て通れば 0、そうでなければ 1）
+/// </summary>
+namespace TestCheck {
+
+// 確認した数・失敗した数
+inline int gCheckCount = 0;
+inline int gFailCount = 0;
+
+/// <summary>
+/// 1つ確かめる
+/// </summary>
+/// <param name="isPassed"></param>
+/// <param name="expression"></param>
+/// <param name="file"></param>
+/// <param name="line"></param>
+/// <returns>isPassed</returns>
+inline bool Check(bool isPassed, const char* expression, const char* file, int line) {
+	++gCheckCount;
+	if (!isPassed) {
+		++gFailCount;
+		std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", file, line, expression);
+	}
+	return isPassed;
+}
+
+/// <summary>
+/// 結果を出す
+/// </summary>
+/// <returns>main の戻り値</returns>
+inline int Finish() {
+	std::printf("%d checks, %d failed\n%s\n", gCheckCount, gFailCount, gFailCount == 0 ? "ALL PASSED" : "FAILED");
+	return gFailCount == 0 ? 0 : 1;
+}
+
+} // namespace TestCheck
+
+#define CHECK(expression) ::TestCheck::Check(static_cast<bool>(expression), #expression, __FILE__, __LINE__)
@@ -0,0 +1,360 @@
+#include "Tools/Common/TileMeshBuilder.h"
+#include <array>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+namespace {
+
+// まとめた面（タイル番号の範囲、終端は含まない）
+struct FaceRect {
+	uint32_t x0, y0, x1, y1;
+};
+
+/// <summary>
+/// 面のマスクを長方形にまとめる（使った面はマスクから消す）
+/// </summary>
+/// <param name="mask">横width×縦heightの面の有無</param>
+/// <param name="mergeX">横方向にまとめてよいか</param>
+/// <param name="mergeY">縦方向にまとめてよいか</param>
+/// <param name="out"></param>
+void MergeFaces(std::vector<uint8_t>& mask, uint32_t width, uint32_t height, bool mergeX, bool mergeY, std::vector<FaceRect>& out) {
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			if (!mask[y * width + x]) {
+				continue;
+			}
+
+			// 横に伸ばす
+			uint32_t x1 = x + 1;
+			if (mergeX) {
+				while (x1 < width && mask[y * width + x1]) {
+					++x1;
+				}
+			}
+
+			// 同じ幅のまま縦に伸ばす
+			uint32_t y1 = y + 1;
+			if (mergeY) {
+				while (y1 < height) {
+					bool isFullRow = true;
+					for (uint32_t i = x; i < x1; ++i) {
+						if (!mask[y1 * width + i]) {
+							isFullRow = false;
+							break;
+						}
+					}
+					if (!isFullRow) {
+						break;
+					}
+					++y1;
+				}
+			}
+
+			// 使った面を消す
+			for (uint32_t j = y; j < y1; ++j) {
+				for (uint32_t i = x; i < x1; ++i) {
+					mask[j * width + i] = 0;
+				}
+			}
+
+			out.push_back(FaceRect{x, y, x1, y1});
+		}
+	}
+}
+
+/// <summary>
+/// 四角形を追加（cross(du, dv) が外向き法線）
+/// </summary>
+void AddQuad(TileMesh& mesh, const float origin[3], const float du[3], const float dv[3], const float normal[3], const TileMeshBuilder::AtlasCell& cell) {
+	uint32_t base = static_cast<uint32_t>(mesh.vertices.size());
+
+	const float corners[4][2] = {
+	    {0.0f, 0.0f},
+        {1.0f, 0.0f},
+        {1.0f, 1.0f},
+        {0.0f, 1.0f}
+    };
+	for (const float(&corner)[2] : corners) {
+		TileMeshVertex vertex{};
+		for (int i = 0; i < 3; ++i) {
+			vertex.position[i] = origin[i] + du[i] * corner[0] + dv[i] * corner[1];
+			vertex.normal[i] = normal[i];
+		}
+		// 単色セルなので面全体で同じUV（まとめた面でも模様が伸びない）
+		vertex.uv[0] = cell.u;
+		vertex.uv[1] = cell.v;
+		mesh.vertices.push_back(vertex);
+	}
+
+	const uint32_t quadIndices[6] = {0, 1, 2, 0, 2, 3};
+	for (uint32_t index : quadIndices) {
+		mesh.indices.push_back(base + index);
+	}
+
+	++mesh.quadCount;
+}
+
+} // namespace
+
+/// <summary>
+/// メッシュ生成（隣接ブロックとの間の面は出さない）
+/// </summary>
+/// <param name="mapChipField"></param>
+/// <param name="options"></param>
+/// <returns></returns>
+TileMesh TileMeshBuilder::Build(const MapChipField& mapChipField, const Options& options) {
+	TileMesh mesh;
+
+	const uint32_t width = mapChipField.GetNumBlockHorizontal();
+	const uint32_t height = mapChipField.GetNumBlockVirtical();
+
+	// ブロックかどうか（範囲外はブロックなし扱い）
+	auto isBlock = [&](int64_t x, int64_t y) {
+		if (x < 0 || y < 0 || x >= width || y >= height) {
+			return false;
+		}
+		return mapChipField.GetMapChipTypeByIndex(static_cast<uint32_t>(x), static_cast<uint32_t>(y)) == MapChipType::kBlock;
+	};
+
+	for (uint32_t y = 0; y < height; ++y) {
+		for (uint32_t x = 0; x < width; ++x) {
+			if (isBlock(x, y)) {
+				++mesh.blockCount;
+			}
+		}
+	}
+
+	// 面の向き（y は添字が下向きなので「上」は y - 1）
+	enum Face { kFront, kBack, kTop, kBottom, kRight, kLeft, kNumFace };
+	const int neighborOffset[kNumFace][2] = {
+	    {0,  0 },
+        {0,  0 },
+        {0,  -1},
+        {0,  1 },
+        {1,  0 },
+        {-1, 0 }
+    };
+
+	const float half = kBlockSize / 2.0f;
+	std::vector<uint8_t> mask(static_cast<size_t>(width) * height);
+	std::vector<FaceRect> rects;
+
+	for (int face = 0; face < kNumFace; ++face) {
+		// その向きに外へ見えている面
+		for (uint32_t y = 0; y < height; ++y) {
+			for (uint32_t x = 0; x < width; ++x) {
+				bool isVisible = isBlock(x, y);
+				if (isVisible && face != kFront && face != kBack) {
+					isVisible = !isBlock(static_cast<int64_t>(x) + neighborOffset[face][0], static_cast<int64_t>(y) + neighborOffset[face][1]);
+				}
+				mask[static_cast<size_t>(y) * width + x] = isVisible ? 1 : 0;
+			}
+		}
+
+		// 同一平面になる方向にだけまとめる
+		bool mergeX = options.greedyMerge && (face == kFront || face == kBack || face == kTop || face == kBottom);
+		bool mergeY = options.greedyMerge && (face == kFront || face == kBack || face == kRight || face == kLeft);
+
+		rects.clear();
+		MergeFaces(mask, width, height, mergeX, mergeY, rects);
+
+		const AtlasCell& cell = (face == kTop) ? options.topCell : options.sideCell;
+
+		for (const FaceRect& rect : rects) {
+			// ワールド座標の範囲（MapChipField::GetMapChipPositionByIndex と同じ並び）
+			float left = kBlockSize * rect.x0 - half;
+			float right = kBlockSize * rect.x1 - half;
+			float top = kBlockSize * (height - 1 - rect.y0) + half;
+			float bottom = kBlockSize * (height - rect.y1) - half;
+			float w = right - left;
+			float h = top - bottom;
+			float d = kBlockSize;
+
+			switch (face) {
+			case kFront: {
+				const float origin[3] = {left, bottom, -half}, du[3] = {0, h, 0}, dv[3] = {w, 0, 0}, normal[3] = {0, 0, -1};
+				AddQuad(mesh, origin, du, dv, normal, cell);
+			} break;
+			case kBack: {
+				const float origin[3] = {left, bottom, half}, du[3] = {w, 0, 0}, dv[3] = {0, h, 0}, normal[3] = {0, 0, 1};
+				AddQuad(mesh, origin, du, dv, normal, cell);
+			} break;
+			case kTop: {
+				const float origin[3] = {left, top, -half}, du[3] = {0, 0, d}, dv[3] = {w, 0, 0}, normal[3] = {0, 1, 0};
+				AddQuad(mesh, origin, du, dv, normal, cell);
+			} break;
+			case kBottom: {
+				const float origin[3] = {left, bottom, -half}, du[3] = {w, 0, 0}, dv[3] = {0, 0, d}, normal[3] = {0, -1, 0};
+				AddQuad(mesh, origin, du, dv, normal, cell);
+			} break;
+			case kRight: {
+				const float origin[3] = {right, bottom, -half}, du[3] = {0, h, 0}, dv[3] = {0, 0, d}, normal[3] = {1, 0, 0};
+				AddQuad(mesh, origin, du, dv, normal, cell);
+			} break;
+			case kLeft: {
+				const float origin[3] = {left, bottom, -half}, du[3] = {0, 0, d}, dv[3] = {0, h, 0}, normal[3] = {-1, 0, 0};
+				AddQuad(mesh, origin, du, dv, normal, cell);
+			} break;
+			}
+		}
+	}
+
+	return mesh;
+}
+
+/// <summary>
+/// 体積（発散定理）
+/// </summary>
+/// <param name="mesh"></param>
+/// <returns></returns>
+float TileMeshBuilder::ComputeVolume(const TileMesh& mesh) {
+	double volume = 0.0;
+
+	for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+		const float* a = mesh.vertices[mesh.indices[i]].position;
+		const float* b = mesh.vertices[mesh.indices[i + 1]].position;
+		const float* c = mesh.vertices[mesh.indices[i + 2]].position;
+
+		// dot(a, cross(b, c)) / 6
+		double cx = static_cast<double>(b[1]) * c[2] - static_cast<double>(b[2]) * c[1];
+		double cy = static_cast<double>(b[2]) * c[0] - static_cast<double>(b[0]) * c[2];
+		double cz = static_cast<double>(b[0]) * c[1] - static_cast<double>(b[1]) * c[0];
+		volume += (a[0] * cx + a[1] * cy + a[2] * cz) / 6.0;
+	}
+
+	return static_cast<float>(volume);
+}
+
+/// <summary>
+/// 閉じた面になっているか（辺を1ブロック単位に分け、向きの付いた辺それぞれに逆向きの相手がちょうど1本ずつ対応し、体積がブロック数と一致）
+/// </summary>
+/// <param name="mesh"></param>
+/// <returns></returns>
+bool TileMeshBuilder::IsWatertight(const TileMesh& mesh) {
+	// 頂点は全て半ブロック刻みの格子の上にある（ブロックの境目は中心から半ブロック）
+	const float kGridScale = 2.0f / kBlockSize;
+	const int32_t kUnitLength = 2;
+	auto toGrid = [&](const float position[3], std::array<int32_t, 3>& out) {
+		for (int i = 0; i < 3; ++i) {
+			float scaled = position[i] * kGridScale;
+			out[i] = static_cast<int32_t>(std::lround(scaled));
+			if (std::abs(scaled - static_cast<float>(out[i])) > 1.0e-3f) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	// 向きの付いた辺（始点・終点の格子座標）→ 本数
+	using Edge = std::array<int32_t, 6>;
+	std::map<Edge, uint32_t> edges;
+	auto addEdge = [&](const std::array<int32_t, 3>& a, const std::array<int32_t, 3>& b) { ++edges[Edge{a[0], a[1], a[2], b[0], b[1], b[2]}]; };
+
+	if (mesh.indices.size() % 3 != 0) {
+		return false;
+	}
+	for (size_t i = 0; i < mesh.indices.size(); i += 3) {
+		for (size_t k = 0; k < 3; ++k) {
+			uint32_t indexA = mesh.indices[i + k];
+			uint32_t indexB = mesh.indices[i + (k + 1) % 3];
+			std::array<int32_t, 3> a;
+			std::array<int32_t, 3> b;
+			if (indexA >= mesh.vertices.size() || indexB >= mesh.vertices.size() || !toGrid(mesh.vertices[indexA].position, a) ||
+			    !toGrid(mesh.vertices[indexB].position, b) || a == b) {
+				return false;
+			}
+
+			// 軸に沿った辺は1ブロックずつに分ける（まとめた面の長い辺と、隣の短い辺を T 字の所で突き合わせるため）
+			int axisCount = 0;
+			int axis = 0;
+			for (int j = 0; j < 3; ++j) {
+				if (a[j] != b[j]) {
+					++axisCount;
+					axis = j;
+				}
+			}
+			if (axisCount != 1) {
+				// 四角形の対角線はその四角形の中で閉じる
+				addEdge(a, b);
+				continue;
+			}
+			int32_t length = b[axis] - a[axis];
+			if (length % kUnitLength != 0) {
+				return false;
+			}
+			int32_t step = length > 0 ? kUnitLength : -kUnitLength;
+			std::array<int32_t, 3> from = a;
+			for (int32_t n = 0; n < std::abs(length) / kUnitLength; ++n) {
+				std::array<int32_t, 3> to = from;
+				to[axis] += step;
+				addEdge(from, to);
+				from = to;
+			}
+		}
+	}
+
+	// 逆向きの辺と1本ずつ組になる（抜けた面・重なった面・裏返った面があれば数が合わない）
+	// 角だけで接するブロックの辺は4枚の面が共有するが、向きごとに2本ずつで組になる
+	for (const auto& [edge, count] : edges) {
+		auto twin = edges.find(Edge{edge[3], edge[4], edge[5], edge[0], edge[1], edge[2]});
+		if (twin == edges.end() || twin->second != count) {
+			return false;
+		}
+	}
+
+	// 全体が裏返っていても辺は組になるので、体積の符号と大きさも見る
+	const float kEpsilon = 1.0e-3f;
+	float expectedVolume = kBlockSize * kBlockSize * kBlockSize * mesh.blockCount;
+	return std::abs(ComputeVolume(mesh) - expectedVolume) <= kEpsilon * (1.0f + expectedVolume);
+}
+
+/// <summary>
+/// Model::CreateFromOBJ で読める形式で書き出す（directory/name.obj, name.mtl）
+/// </summary>
+bool TileMeshBuilder::WriteObj(const TileMesh& mesh, const std::string& directory, const std::string& name, const std::string& textureFileName) {
+	std::error_code errorCode;
+	std::filesystem::create_directories(directory, errorCode);
+
+	// マテリアル
+	std::ofstream mtl(directory + "/" + name + ".mtl");
+	if (!mtl.is_open()) {
+		return false;
+	}
+	mtl << "newmtl Material\n";
+	mtl << "map_Kd " << textureFileName << "\n";
+	mtl.close();
+	if (mtl.fail()) {
+		return false;
+	}
+
+	std::ofstream obj(directory + "/" + name + ".obj");
+	if (!obj.is_open()) {
+		return false;
+	}
+
+	// OBJ は右手系（ローダーが x を反転して読む）なので、x を反転・面の並びを逆にして書く
+	obj << "mtllib " << name << ".mtl\n";
+	obj << "o " << name << "\n";
+	for (const TileMeshVertex& vertex : mesh.vertices) {
+		obj << "v " << -vertex.position[0] << " " << vertex.position[1] << " " << vertex.position[2] << "\n";
+	}
+	for (const TileMeshVertex& vertex : mesh.vertices) {
+		obj << "vt " << vertex.uv[0] << " " << 1.0f - vertex.uv[1] << "\n";
+	}
+	for (const TileMeshVertex& vertex : mesh.vertices) {
+		obj << "vn " << -vertex.normal[0] << " " << vertex.normal[1] << " " << vertex.normal[2] << "\n";
+	}
+	obj << "usemtl Material\n";
+	for (size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+		uint32_t a = mesh.indices[i] + 1;
+		uint32_t b = mesh.indices[i + 2] + 1;
+		uint32_t c = mesh.indices[i + 1] + 1;
+		obj << "f " << a << "/" << a << "/" << a << " " << b << "/" << b << "/" << b << " " << c << "/" << c << "/" << c << "\n";
+	}
+
+	// 閉じるときの書き込みの失敗も見る
+	obj.close();
+	return !obj.fail();
+}
@@ -0,0 +1,81 @@
+#pragma once
+#include "MapChipField.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// <summary>
+/// 焼き込みタイルメッシュの頂点
+/// </summary>
+struct TileMeshVertex {
+	float position[3];
+	float normal[3];
+	float uv[2];
+};
+
+/// <summary>
+/// 焼き込みタイルメッシュ（ワールド座標、三角形は外側から見て反時計回り）
+/// </summary>
+struct TileMesh {
+	std::vector<TileMeshVertex> vertices;
+	std::vector<uint32_t> indices;
+	uint32_t blockCount = 0; // 元になったブロック数
+	uint32_t quadCount = 0;  // 面（四角形）の数
+};
+
+/// <summary>
+/// マップチップのブロックを1つの静的メッシュに焼き込む（Tools/TileMeshBaker が OBJ に書き出す）
+/// </summary>
+class TileMeshBuilder {
+public:
+	// アトラス上の色セル（UV、左上原点）
+	struct AtlasCell {
+		float u;
+		float v;
+	};
+
+	struct Options {
+		// 同一平面の面を貪欲法でまとめるか
+		bool greedyMerge = true;
+		// 上面・それ以外の面に使う Atlas.png の色セル（64px格子のセル中心）
+		AtlasCell topCell = {224.0f / 512.0f, 288.0f / 512.0f};
+		AtlasCell sideCell = {32.0f / 512.0f, 224.0f / 512.0f};
+	};
+
+private:
+	// ブロック1個のサイズ（MapChipFieldと同じ）
+	static inline const float kBlockSize = 1.0f;
+
+public:
+	/// <summary>
+	/// メッシュ生成（隣接ブロックとの間の面は出さない）
+	/// </summary>
+	/// <param name="mapChipField"></param>
+	/// <param name="options"></param>
+	/// <returns></returns>
+	static TileMesh Build(const MapChipField& mapChipField, const Options& options);
+
+	/// <summary>
+	/// 体積（発散定理）
+	/// </summary>
+	/// <param name="mesh"></param>
+	/// <returns></returns>
+	static float ComputeVolume(const TileMesh& mesh);
+	/// <summary>
+	/// 閉じた面になっているか（辺を1ブロック単位に分け、向きの付いた辺それぞれに逆向きの相手がちょうど1本ずつ対応し、体積がブロック数と一致）
+	/// </summary>
+	/// <param name="mesh"></param>
+	/// <returns></returns>
+	static bool IsWatertight(const TileMesh& mesh);
+
+	/// <summary>
+	/// Model::CreateFromOBJ で読める形式で書き出す（directory/name.obj, name.mtl）
+	/// </summary>
+	/// <param name="mesh"></param>
+	/// <param name="directory">出力先（例: Resources/tileMesh）</param>
+	/// <param name="name">モデル名</param>
+	/// <param name="textureFileName">mtl から参照するテクスチャ名（directory内）</param>
+	/// <returns>成功したか</returns>
+	static bool WriteObj(const TileMesh& mesh, const std::string& directory, const std::string& name, const std::string& textureFileName);
+};
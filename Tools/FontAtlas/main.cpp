@@ -0,0 +1,273 @@
+// HUD の文字（大きい数字 Resources/text/number/*.png と ASCII の Resources/debugfont.png）を
+// 1枚のアトラスに詰め、TextBatch で使う文字の表（HudFont.h）を生成する
+//
+// ビルド（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -I. Tools/FontAtlas/main.cpp Tools/Common/PngImage.cpp -o fontAtlas
+// 実行（リポジトリ直下で）:
+//   ./fontAtlas [--atlas Resources/text/hudFont.png] [--header HudFont.h]
+//
+// 配置:
+//   数字・コロン・ドットは不透明な範囲で左右を詰め、上下は全ての数字で共通の範囲にそろえる（並べたときに高さがずれないよう）。
+//   数字は等幅（タイムの桁が揺れないよう、一番幅の広い数字に合わせて中央寄せ）。
+//   debugfont.png は 9x18 のマスが1行14文字で ' ' から並んでいるので、マスのまま写す。
+//   文字の間は kPadding ピクセル空けて、線形補間で隣の文字がにじまないようにする。
+#define NOMINMAX
+#include "Tools/Common/PngImage.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+const uint32_t kAtlasWidth = 512;
+// 文字の間の透明なすき間
+const uint32_t kPadding = 2;
+
+// 数字の並び（TextFont は '.' から ':' までの連続した文字コードで引く。'/' は空白）
+const char kDigitFirstCode = '.';
+const char kDigitLastCode = ':';
+// 数字の間（一番広い数字の幅に足す）
+const uint32_t kDigitSpacing = 12;
+// コロン・ドットの左右の余白
+const uint32_t kSeparatorSpacing = 12;
+
+// debugfont.png のマス
+const uint32_t kAsciiCellWidth = 9;
+const uint32_t kAsciiCellHeight = 18;
+const uint32_t kAsciiColumns = 14;
+const char kAsciiFirstCode = ' ';
+const char kAsciiLastCode = '~';
+
+// 1文字分（アトラス上のピクセル単位）
+struct Glyph {
+	char code;
+	// 元画像と、その中の範囲
+	const PngImage* source;
+	uint32_t sourceX;
+	uint32_t sourceY;
+	uint32_t width;
+	uint32_t height;
+	int32_t offsetX;
+	int32_t offsetY;
+	uint32_t advance;
+	// アトラス上の位置
+	uint32_t x;
+	uint32_t y;
+};
+
+/// <summary>
+/// 左から順に並べ、はみ出したら次の段へ（同じ書体の文字は高さがそろっているので、段に詰めるだけで十分）
+/// </summary>
+/// <returns>使った高さ</returns>
+uint32_t PlaceInRows(std::vector<Glyph>& glyphs, uint32_t top) {
+	uint32_t x = kPadding;
+	uint32_t y = top;
+	uint32_t rowHeight = 0;
+	for (Glyph& glyph : glyphs) {
+		if (glyph.width == 0) {
+			continue;
+		}
+		if (x + glyph.width + kPadding > kAtlasWidth) {
+			x = kPadding;
+			y += rowHeight + kPadding;
+			rowHeight = 0;
+		}
+		glyph.x = x;
+		glyph.y = y;
+		x += glyph.width + kPadding;
+		rowHeight = (std::max)(rowHeight, glyph.height);
+	}
+	return y + rowHeight + kPadding;
+}
+
+std::string EscapeChar(char code) {
+	if (code == '\\' || code == '\'') {
+		return std::string("'\\") + code + "'";
+	}
+	return std::string("'") + code + "'";
+}
+
+/// <summary>
+/// 文字の表を C++ のヘッダにして書く
+/// </summary>
+void WriteGlyphTable(std::ofstream& out, const char* name, const std::vector<Glyph>& glyphs) {
+	out << "\tstatic inline const TextGlyph " << name << "[" << glyphs.size() << "] = {\n";
+	for (const Glyph& glyph : glyphs) {
+		out << "\t    {" << glyph.x << ", " << glyph.y << ", " << glyph.width << ", " << glyph.height << ", " << glyph.offsetX << ", " << glyph.offsetY << ", " << glyph.advance
+		    << "}, // " << EscapeChar(glyph.code) << "\n";
+	}
+	out << "\t};\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	std::string atlasPath = "Resources/text/hudFont.png";
+	std::string headerPath = "HudFont.h";
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--atlas" && i + 1 < argc) {
+			atlasPath = argv[++i];
+		} else if (arg == "--header" && i + 1 < argc) {
+			headerPath = argv[++i];
+		} else {
+			std::fprintf(stderr, "usage: %s [--atlas path] [--header path]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	///===========================================
+	/// 数字
+	/// ===========================================
+
+	const uint32_t digitCount = static_cast<uint32_t>(kDigitLastCode - kDigitFirstCode + 1);
+	std::vector<PngImage> digitImages(digitCount);
+	std::vector<Glyph> digits(digitCount);
+	uint32_t bandTop = UINT32_MAX;
+	uint32_t bandBottom = 0;
+	uint32_t maxDigitWidth = 0;
+	for (uint32_t i = 0; i < digitCount; ++i) {
+		char code = static_cast<char>(kDigitFirstCode + i);
+		Glyph& glyph = digits[i];
+		glyph = {};
+		glyph.code = code;
+		if (code == '/') {
+			continue;
+		}
+		std::string name = code == '.' ? "dot" : code == ':' ? "colon" : std::string(1, code);
+		std::string path = "Resources/text/number/" + name + ".png";
+		std::string error;
+		if (!digitImages[i].Load(path, &error)) {
+			std::fprintf(stderr, "failed to load %s: %s\n", path.c_str(), error.c_str());
+			return 1;
+		}
+		uint32_t left = 0;
+		uint32_t top = 0;
+		uint32_t right = 0;
+		uint32_t bottom = 0;
+		if (!digitImages[i].GetOpaqueBounds(left, top, right, bottom)) {
+			std::fprintf(stderr, "%s is empty\n", path.c_str());
+			return 1;
+		}
+		glyph.source = &digitImages[i];
+		glyph.sourceX = left;
+		glyph.width = right - left;
+		bandTop = (std::min)(bandTop, top);
+		bandBottom = (std::max)(bandBottom, bottom);
+		if (code >= '0' && code <= '9') {
+			maxDigitWidth = (std::max)(maxDigitWidth, glyph.width);
+		}
+	}
+	const uint32_t digitAdvance = maxDigitWidth + kDigitSpacing;
+	uint32_t separatorAdvance = 0;
+	for (Glyph& glyph : digits) {
+		if (glyph.code == '.' || glyph.code == ':') {
+			separatorAdvance = (std::max)(separatorAdvance, glyph.width + kSeparatorSpacing * 2);
+		}
+	}
+	for (Glyph& glyph : digits) {
+		glyph.advance = glyph.code >= '0' && glyph.code <= '9' ? digitAdvance : separatorAdvance;
+		if (glyph.source) {
+			glyph.sourceY = bandTop;
+			glyph.height = bandBottom - bandTop;
+			glyph.offsetX = static_cast<int32_t>(glyph.advance - glyph.width) / 2;
+		}
+	}
+
+	///===========================================
+	/// ASCII
+	/// ===========================================
+
+	PngImage debugFont;
+	std::string error;
+	if (!debugFont.Load("Resources/debugfont.png", &error)) {
+		std::fprintf(stderr, "failed to load Resources/debugfont.png: %s\n", error.c_str());
+		return 1;
+	}
+	const uint32_t asciiCount = static_cast<uint32_t>(kAsciiLastCode - kAsciiFirstCode + 1);
+	std::vector<Glyph> ascii(asciiCount);
+	for (uint32_t i = 0; i < asciiCount; ++i) {
+		Glyph& glyph = ascii[i];
+		glyph = {};
+		glyph.code = static_cast<char>(kAsciiFirstCode + i);
+		glyph.advance = kAsciiCellWidth;
+		if (glyph.code == ' ') {
+			continue;
+		}
+		glyph.source = &debugFont;
+		glyph.sourceX = i % kAsciiColumns * kAsciiCellWidth;
+		glyph.sourceY = i / kAsciiColumns * kAsciiCellHeight;
+		glyph.width = kAsciiCellWidth;
+		glyph.height = kAsciiCellHeight;
+		if (glyph.sourceY + kAsciiCellHeight > debugFont.GetHeight()) {
+			std::fprintf(stderr, "debugfont.png is smaller than expected\n");
+			return 1;
+		}
+	}
+
+	///===========================================
+	/// 詰めて書き出す
+	/// ===========================================
+
+	uint32_t height = PlaceInRows(digits, kPadding);
+	height = PlaceInRows(ascii, height);
+	uint32_t atlasHeight = 1;
+	while (atlasHeight < height) {
+		atlasHeight <<= 1;
+	}
+
+	PngImage atlas;
+	atlas.Resize(kAtlasWidth, atlasHeight);
+	uint64_t usedPixels = 0;
+	for (const std::vector<Glyph>* glyphs : {&digits, &ascii}) {
+		for (const Glyph& glyph : *glyphs) {
+			if (glyph.source) {
+				atlas.Blit(*glyph.source, glyph.sourceX, glyph.sourceY, glyph.width, glyph.height, glyph.x, glyph.y);
+				usedPixels += static_cast<uint64_t>(glyph.width) * glyph.height;
+			}
+		}
+	}
+	if (!atlas.Save(atlasPath)) {
+		std::fprintf(stderr, "failed to write %s\n", atlasPath.c_str());
+		return 1;
+	}
+
+	std::ofstream header(headerPath, std::ios::binary);
+	if (!header) {
+		std::fprintf(stderr, "failed to write %s\n", headerPath.c_str());
+		return 1;
+	}
+	header << "// Tools/FontAtlas で生成（手で書き換えない）\n";
+	header << "#pragma once\n";
+	header << "#include \"TextBatch.h\"\n\n";
+	header << "/// <summary>\n";
+	header << "/// HUD のフォント（アトラス1枚に、大きい数字と ASCII の2書体）\n";
+	header << "/// </summary>\n";
+	header << "struct HudFont {\n";
+	header << "\tstatic inline const char* const kTexturePath = \"" << atlasPath.substr(atlasPath.find("Resources/") == 0 ? 10 : 0) << "\";\n";
+	header << "\tstatic inline const uint32_t kAtlasWidth = " << kAtlasWidth << ";\n";
+	header << "\tstatic inline const uint32_t kAtlasHeight = " << atlasHeight << ";\n\n";
+	header << "\t// 大きい数字（" << EscapeChar(kDigitFirstCode) << " 〜 " << EscapeChar(kDigitLastCode) << "。'/' は空白。等幅）\n";
+	WriteGlyphTable(header, "kDigitGlyphs", digits);
+	header << "\tstatic inline const TextFont kDigits = {kDigitGlyphs, " << static_cast<int>(kDigitFirstCode) << ", " << digitCount << ", " << (bandBottom - bandTop) << ".0f, " << kAtlasWidth
+	       << ".0f, " << atlasHeight << ".0f};\n\n";
+	header << "\t// ASCII（" << EscapeChar(kAsciiFirstCode) << " 〜 " << EscapeChar(kAsciiLastCode) << "。" << kAsciiCellWidth << "x" << kAsciiCellHeight << " の等幅）\n";
+	WriteGlyphTable(header, "kAsciiGlyphs", ascii);
+	header << "\tstatic inline const TextFont kAscii = {kAsciiGlyphs, " << static_cast<int>(kAsciiFirstCode) << ", " << asciiCount << ", " << kAsciiCellHeight << ".0f, " << kAtlasWidth
+	       << ".0f, " << atlasHeight << ".0f};\n";
+	header << "};\n";
+	if (!header) {
+		std::fprintf(stderr, "failed to write %s\n", headerPath.c_str());
+		return 1;
+	}
+
+	std::printf("%s: %ux%u, %u glyphs, %.1f%% of the atlas used\n", atlasPath.c_str(), kAtlasWidth, atlasHeight, digitCount + asciiCount,
+	            100.0 * static_cast<double>(usedPixels) / (static_cast<double>(kAtlasWidth) * atlasHeight));
+	std::printf("%s: written\n", headerPath.c_str());
+	return 0;
+}
@@ -0,0 +1,1423 @@
+// ゲームプレイの主要な処理を、入力サイズを変えながら繰り返し計測して JSON で出す
+//
+// ビルド（Linux, リポジトリ直下で。描画はヘッドレス版エンジンで何もしない）:
+//   g++ -std=c++20 -O2 -pthread -I. -ITools/Headless Tools/GameplayBench/main.cpp Tools/Headless/HeadlessEngine.cpp
+//       $(ls *.cpp | grep -v -E '^(main|SceneManager|TitleScene|TutorialScene|MakeAffineMatrix)\.cpp$') -o gameplayBench
+// 実行（Resources/blocks.csv を読むのでリポジトリ直下で）:
+//   ./gameplayBench [--out 結果.json] [--filter 名前の一部] [--reps 回数] [--quick]
+#include "AABB.h"
+#include "AffineMatrix.h"
+#include "BlockTransforms.h"
+#include "DdsTexture.h"
+#include "FileUtility.h"
+#include "Enemy.h"
+#include "EnemySpawner.h"
+#include "Fireworks.h"
+#include "FlowField.h"
+#include "GhostRace.h"
+#include "GhostRecording.h"
+#include "HudFont.h"
+#include "JobSystem.h"
+#include "GameScene.h"
+#include "MapChipField.h"
+#include "NavGraph.h"
+#include "Player.h"
+#include "Random.h"
+#include "RenderPipeline.h"
+#include "SpriteAtlas.h"
+#include "TextBatch.h"
+#include "TextureCache.h"
+#include "UiAtlas.h"
+#include "WorldTransformUpdater.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace KamataEngine;
+
+namespace {
+
+///====================================================
+/// 計測の枠組み
+///====================================================
+
+// 最適化で消されないよう結果を流し込む先
+volatile uint64_t gSink = 0;
+
+template <typename T> void Consume(const T& value) {
+	uint64_t bits = 0;
+	std::memcpy(&bits, &value, std::min(sizeof(T), sizeof(bits)));
+	gSink = gSink + bits;
+}
+
+// 設定
+struct Config {
+	std::string outPath;     // 空なら標準出力
+	std::string filter;      // 名前にこれを含むものだけ
+	uint32_t warmupReps = 3; // 捨てる回数
+	uint32_t reps = 15;      // 計測する回数
+	double minRepMs = 5.0;   // 1回の計測の最短時間（足りなければ反復数を倍にする）
+	bool quick = false;      // 大きいサイズを省く
+};
+
+// 1項目の結果
+struct Result {
+	std::string name;
+	std::string size;          // 入力サイズ（表示用）
+	uint64_t itemsPerOp = 1;   // 1操作で処理する要素数
+	uint64_t iterations = 0;   // 1回の計測あたりの操作数
+	std::vector<double> nsPerOp; // 計測ごとの 1操作あたりの時間
+};
+
+// 統計
+struct Summary {
+	double min = 0.0;
+	double median = 0.0;
+	double mean = 0.0;
+	double stddev = 0.0;
+	double max = 0.0;
+};
+
+Summary Summarize(std::vector<double> values) {
+	Summary summary;
+	if (values.empty()) {
+		return summary;
+	}
+	std::sort(values.begin(), values.end());
+	summary.min = values.front();
+	summary.max = values.back();
+	size_t half = values.size() / 2;
+	summary.median = values.size() % 2 == 1 ? values[half] : (values[half - 1] + values[half]) * 0.5;
+
+	double total = 0.0;
+	for (double value : values) {
+		total += value;
+	}
+	summary.mean = total / static_cast<double>(values.size());
+
+	double variance = 0.0;
+	for (double value : values) {
+		variance += (value - summary.mean) * (value - summary.mean);
+	}
+	summary.stddev = values.size() > 1 ? std::sqrt(variance / static_cast<double>(values.size() - 1)) : 0.0;
+	return summary;
+}
+
+/// <summary>
+/// 計測の実行役（kernel(n) は n 回分の操作をする）
+/// </summary>
+class Runner {
+private:
+	Config config_;
+	std::vector<Result> results_;
+
+public:
+	explicit Runner(const Config& config) : config_(config) {}
+
+	const Config& GetConfig() const { return config_; }
+	const std::vector<Result>& GetResults() const { return results_; }
+
+	bool IsSelected(const std::string& name) const { return config_.filter.empty() || name.find(config_.filter) != std::string::npos; }
+
+	/// <summary>
+	/// 反復数を自動で決めて計測
+	/// </summary>
+	void Run(const std::string& name, const std::string& size, uint64_t itemsPerOp, const std::function<void(uint64_t)>& kernel) { RunFixed(name, size, itemsPerOp, 0, kernel); }
+
+	/// <summary>
+	/// 反復数を決めて計測（iterations == 0 なら自動）
+	/// </summary>
+	void RunFixed(const std::string& name, const std::string& size, uint64_t itemsPerOp, uint64_t iterations, const std::function<void(uint64_t)>& kernel) {
+		Measure(name, size, itemsPerOp, iterations, nullptr, kernel);
+	}
+
+	/// <summary>
+	/// 毎回の計測の前に setup(n) で n 回分の入力を用意してから計測（setup の時間は含めない）
+	/// </summary>
+	void RunWithSetup(const std::string& name, const std::string& size, uint64_t itemsPerOp, const std::function<void(uint64_t)>& setup,
+	                  const std::function<void(uint64_t)>& kernel) {
+		Measure(name, size, itemsPerOp, 0, setup, kernel);
+	}
+
+private:
+	void Measure(const std::string& name, const std::string& size, uint64_t itemsPerOp, uint64_t iterations, const std::function<void(uint64_t)>& setup,
+	             const std::function<void(uint64_t)>& kernel) {
+		if (!IsSelected(name)) {
+			return;
+		}
+
+		// 1回が minRepMs を超えるまで反復数を倍にする
+		if (iterations == 0) {
+			iterations = 1;
+			while (TimeNs(setup, kernel, iterations) < config_.minRepMs * 1.0e6 && iterations < (1ull << 30)) {
+				iterations *= 2;
+			}
+		}
+
+		for (uint32_t i = 0; i < config_.warmupReps; ++i) {
+			TimeNs(setup, kernel, iterations);
+		}
+
+		Result result;
+		result.name = name;
+		result.size = size;
+		result.itemsPerOp = itemsPerOp;
+		result.iterations = iterations;
+		for (uint32_t i = 0; i < config_.reps; ++i) {
+			result.nsPerOp.push_back(TimeNs(setup, kernel, iterations) / static_cast<double>(iterations));
+		}
+
+		Summary summary = Summarize(result.nsPerOp);
+		std::fprintf(stderr, "%-40s %-12s %12.1f ns/op (min %.1f, sd %.1f) %10.2f ns/item\n", name.c_str(), size.c_str(), summary.median, summary.min, summary.stddev,
+		             summary.median / static_cast<double>(itemsPerOp));
+		results_.push_back(std::move(result));
+	}
+
+public:
+	/// <summary>
+	/// JSON で書き出す
+	/// </summary>
+	void WriteJson(std::FILE* file) const {
+		std::fprintf(file, "{\n  \"config\": {\"warmup_reps\": %u, \"reps\": %u, \"min_rep_ms\": %.1f},\n  \"benchmarks\": [\n", config_.warmupReps, config_.reps, config_.minRepMs);
+		for (size_t i = 0; i < results_.size(); ++i) {
+			const Result& result = results_[i];
+			Summary summary = Summarize(result.nsPerOp);
+			std::fprintf(file,
+			             "    {\"name\": \"%s\", \"size\": \"%s\", \"items_per_op\": %llu, \"iterations\": %llu, \"ns_per_op\": {\"min\": %.3f, \"median\": %.3f, \"mean\": %.3f, "
+			             "\"stddev\": %.3f, \"max\": %.3f}, \"ns_per_item\": %.4f, \"ops_per_sec\": %.1f}%s\n",
+			             result.name.c_str(), result.size.c_str(), static_cast<unsigned long long>(result.itemsPerOp), static_cast<unsigned long long>(result.iterations), summary.min,
+			             summary.median, summary.mean, summary.stddev, summary.max, summary.median / static_cast<double>(result.itemsPerOp),
+			             summary.median > 0.0 ? 1.0e9 / summary.median : 0.0, i + 1 < results_.size() ? "," : "");
+		}
+		std::fprintf(file, "  ]\n}\n");
+	}
+
+private:
+	static double TimeNs(const std::function<void(uint64_t)>& setup, const std::function<void(uint64_t)>& kernel, uint64_t iterations) {
+		if (setup) {
+			setup(iterations);
+		}
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		kernel(iterations);
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+};
+
+///====================================================
+/// 入力データ
+///====================================================
+
+// 計測に使うマップの大きさ
+struct FieldSize {
+	uint32_t width;
+	uint32_t height;
+};
+
+std::string SizeLabel(const FieldSize& size) { return std::to_string(size.width) + "x" + std::to_string(size.height); }
+
+/// <summary>
+/// 地面・足場・壁を置いたマップの CSV を書く（同じ大きさなら毎回同じ内容。敵は地面の上に等間隔）
+/// </summary>
+std::string WriteFieldCsv(const FieldSize& size, uint32_t enemyCount = 0) {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "gameplay_bench";
+	std::filesystem::create_directories(directory);
+	std::filesystem::path path = directory / ("field_" + SizeLabel(size) + "_" + std::to_string(enemyCount) + ".csv");
+
+	std::mt19937 engine(size.width * 31 + size.height);
+	std::uniform_int_distribution<int> percent(0, 99);
+
+	std::ofstream file(path);
+	for (uint32_t y = 0; y < size.height; ++y) {
+		for (uint32_t x = 0; x < size.width; ++x) {
+			int type = 0;
+			if (y + 2 >= size.height || x == 0 || x + 1 == size.width) {
+				type = 1; // 地面と左右の壁
+			} else if (y % 5 == 0 && percent(engine) < 30) {
+				type = 1; // 足場
+			}
+			if (y + 3 == size.height && x + 3 == size.width) {
+				type = 2; // ゴール
+			} else if (y + 3 == size.height && enemyCount > 0 && x > 0 && x + 3 < size.width && x % std::max<uint32_t>(1, (size.width - 4) / enemyCount) == 0) {
+				type = 3; // 敵の出現位置
+			}
+			file << type << (x + 1 < size.width ? "," : "\n");
+		}
+	}
+	return path.string();
+}
+
+///====================================================
+/// 各計測
+///====================================================
+
+void BenchMapChipField(Runner& runner, const std::vector<FieldSize>& sizes) {
+	for (const FieldSize& size : sizes) {
+		std::string path = WriteFieldCsv(size);
+		std::string label = SizeLabel(size);
+		uint64_t tiles = static_cast<uint64_t>(size.width) * size.height;
+
+		runner.RunFixed("MapChipField::LoadMapChipCsv", label, tiles, 0, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				MapChipField field;
+				field.LoadMapChipCsv(path);
+				Consume(field.GetNumBlockHorizontal());
+			}
+		});
+
+		MapChipField field;
+		field.LoadMapChipCsv(path);
+
+		// 引く場所はあらかじめ決めておく
+		const size_t kQueryCount = 4096;
+		std::mt19937 engine(1234);
+		std::vector<MapChipField::IndexSet> indices(kQueryCount);
+		std::vector<Vector3> positions(kQueryCount);
+		for (size_t i = 0; i < kQueryCount; ++i) {
+			indices[i] = {static_cast<uint32_t>(engine() % size.width), static_cast<uint32_t>(engine() % size.height)};
+			positions[i] = field.GetMapChipPositionByIndex(indices[i].xIndex, indices[i].yIndex);
+			positions[i].x += static_cast<float>(engine() % 100) / 100.0f - 0.5f;
+			positions[i].y += static_cast<float>(engine() % 100) / 100.0f - 0.5f;
+		}
+
+		runner.Run("MapChipField::GetMapChipTypeByIndex", label, 1, [&](uint64_t n) {
+			uint64_t sum = 0;
+			for (uint64_t i = 0; i < n; ++i) {
+				const MapChipField::IndexSet& index = indices[i & (kQueryCount - 1)];
+				sum += static_cast<uint64_t>(field.GetMapChipTypeByIndex(index.xIndex, index.yIndex));
+			}
+			Consume(sum);
+		});
+
+		runner.Run("MapChipField::GetMapChipIndexSetByPosition", label, 1, [&](uint64_t n) {
+			uint64_t sum = 0;
+			for (uint64_t i = 0; i < n; ++i) {
+				MapChipField::IndexSet index = field.GetMapChipIndexSetByPosition(positions[i & (kQueryCount - 1)]);
+				sum += index.xIndex + index.yIndex;
+			}
+			Consume(sum);
+		});
+	}
+}
+
+/// <summary>
+/// これまでのブロックの持ち方（行ごとの配列に1個ずつ new した WorldTransform。ブロックの無い所は nullptr）
+/// </summary>
+struct LegacyBlockTransforms {
+	std::vector<std::vector<WorldTransform*>> blocks;
+
+	void Generate(const MapChipField& field) {
+		blocks.resize(field.GetNumBlockVirtical());
+		for (uint32_t i = 0; i < field.GetNumBlockVirtical(); ++i) {
+			blocks[i].resize(field.GetNumBlockHorizontal());
+		}
+		for (uint32_t i = 0; i < field.GetNumBlockVirtical(); ++i) {
+			for (uint32_t j = 0; j < field.GetNumBlockHorizontal(); ++j) {
+				if (field.GetMapChipTypeByIndex(j, i) == MapChipType::kBlock) {
+					WorldTransform* worldTransform = new WorldTransform();
+					worldTransform->Initialize();
+					worldTransform->translation_ = field.GetMapChipPositionByIndex(j, i);
+					blocks[i][j] = worldTransform;
+				}
+			}
+		}
+	}
+	void Update() {
+		for (std::vector<WorldTransform*>& line : blocks) {
+			for (WorldTransform* worldTransform : line) {
+				if (!worldTransform) {
+					continue;
+				}
+				WorldTransformUpdate(*worldTransform);
+			}
+		}
+	}
+	void Clear() {
+		for (std::vector<WorldTransform*>& line : blocks) {
+			for (WorldTransform* worldTransform : line) {
+				delete worldTransform;
+			}
+		}
+		blocks.clear();
+	}
+};
+
+void BenchBlockTransforms(Runner& runner, const std::vector<FieldSize>& sizes) {
+	for (const FieldSize& size : sizes) {
+		MapChipField field;
+		field.LoadMapChipCsv(WriteFieldCsv(size));
+		TileBatch tileBatch;
+		tileBatch.Build(field);
+		uint64_t blocks = tileBatch.GetInstanceCount();
+		std::string label = SizeLabel(size) + ", " + std::to_string(blocks) + " blocks";
+
+		// 作る（TileBatch はどちらの持ち方でも描画用に作るので含めない。前の回のものは setup で消す）
+		std::vector<BlockTransforms> built;
+		std::vector<LegacyBlockTransforms> legacyBuilt;
+		auto clearAll = [&]() {
+			built.clear();
+			for (LegacyBlockTransforms& legacy : legacyBuilt) {
+				legacy.Clear();
+			}
+			legacyBuilt.clear();
+		};
+		runner.RunWithSetup(
+		    "BlockTransforms::Generate", label, blocks,
+		    [&](uint64_t n) {
+			    clearAll();
+			    built.resize(n);
+		    },
+		    [&](uint64_t n) {
+			    for (uint64_t i = 0; i < n; ++i) {
+				    built[i].Generate(tileBatch);
+			    }
+			    Consume(built.back().GetCount());
+		    });
+		runner.RunWithSetup(
+		    "BlockTransforms::Generate (legacy nested)", label, blocks,
+		    [&](uint64_t n) {
+			    clearAll();
+			    legacyBuilt.resize(n);
+		    },
+		    [&](uint64_t n) {
+			    for (uint64_t i = 0; i < n; ++i) {
+				    legacyBuilt[i].Generate(field);
+			    }
+			    Consume(legacyBuilt.back().blocks.size());
+		    });
+
+		// 毎フレームの行列更新（ジョブシステムは起動していないので1スレッド）
+		BlockTransforms blockTransforms;
+		blockTransforms.Generate(tileBatch);
+		runner.Run("BlockTransforms::Update", label, blocks, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				blockTransforms.Update();
+			}
+			Consume(blockTransforms.GetTransforms()[blockTransforms.GetCount() - 1].matWorld_.m[3][0]);
+		});
+		LegacyBlockTransforms legacy;
+		legacy.Generate(field);
+		runner.Run("BlockTransforms::Update (legacy nested)", label, blocks, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				legacy.Update();
+			}
+			Consume(legacy.blocks.back().front()->matWorld_.m[3][0]);
+		});
+		legacy.Clear();
+
+		// 消す（作るのは setup で）
+		runner.RunWithSetup(
+		    "BlockTransforms::Clear", label, blocks,
+		    [&](uint64_t n) {
+			    clearAll();
+			    built.resize(n);
+			    for (BlockTransforms& transforms : built) {
+				    transforms.Generate(tileBatch);
+			    }
+		    },
+		    [&](uint64_t n) {
+			    for (uint64_t i = 0; i < n; ++i) {
+				    built[i].Clear();
+			    }
+			    Consume(built.back().GetCount());
+		    });
+		runner.RunWithSetup(
+		    "BlockTransforms::Clear (legacy nested)", label, blocks,
+		    [&](uint64_t n) {
+			    clearAll();
+			    legacyBuilt.resize(n);
+			    for (LegacyBlockTransforms& transforms : legacyBuilt) {
+				    transforms.Generate(field);
+			    }
+		    },
+		    [&](uint64_t n) {
+			    for (uint64_t i = 0; i < n; ++i) {
+				    legacyBuilt[i].Clear();
+			    }
+			    Consume(legacyBuilt.back().blocks.size());
+		    });
+		clearAll();
+	}
+}
+
+void BenchAABB(Runner& runner, const std::vector<uint32_t>& counts) {
+	for (uint32_t count : counts) {
+		std::mt19937 engine(count);
+		std::uniform_real_distribution<float> coordinate(0.0f, 100.0f);
+		std::vector<AABB> boxes(count);
+		for (AABB& box : boxes) {
+			Vector3 center = {coordinate(engine), coordinate(engine) * 0.2f, 0.0f};
+			box.min = center - Vector3{0.4f, 0.4f, 0.4f};
+			box.max = center + Vector3{0.4f, 0.4f, 0.4f};
+		}
+
+		// count 個の箱を1つずつ隣と比べる
+		runner.Run("IsAABBCollision", std::to_string(count) + " boxes", count, [&](uint64_t n) {
+			uint64_t hits = 0;
+			for (uint64_t i = 0; i < n; ++i) {
+				for (uint32_t j = 0; j + 1 < count; ++j) {
+					hits += IsAABBCollision(boxes[j], boxes[j + 1]) ? 1 : 0;
+				}
+				hits += IsAABBCollision(boxes[count - 1], boxes[0]) ? 1 : 0;
+			}
+			Consume(hits);
+		});
+	}
+}
+
+void BenchMatrix(Runner& runner) {
+	Vector3 scale = {1.0f, 1.5f, 1.0f};
+	Vector3 rotation = {0.1f, 1.2f, 0.3f};
+	Vector3 translation = {10.0f, 2.0f, -3.0f};
+
+	runner.Run("MakeAffineMatrix", "1", 1, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			rotation.y += 0.001f;
+			Matrix4x4 matrix = MakeAffineMatrix(scale, rotation, translation);
+			Consume(matrix.m[3][0] + matrix.m[0][0]);
+		}
+	});
+
+	Matrix4x4 a = MakeAffineMatrix(scale, rotation, translation);
+	Matrix4x4 b = MakeAffineMatrix(translation, scale, rotation);
+	runner.Run("Multiply", "1", 1, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			a = Multiply(a, b);
+			a.m[3][3] = 1.0f;
+		}
+		Consume(a.m[0][0]);
+	});
+}
+
+void BenchPlayer(Runner& runner, const std::vector<FieldSize>& sizes) {
+	Camera camera;
+	camera.Initialize();
+	std::unique_ptr<Model> model(Model::CreateFromOBJ("player"));
+
+	for (const FieldSize& size : sizes) {
+		MapChipField field;
+		field.LoadMapChipCsv(WriteFieldCsv(size));
+		Vector3 start = field.GetMapChipPositionByIndex(2, size.height - 4);
+
+		Player player;
+		player.Initialize(model.get(), model.get(), &camera, start);
+		player.SetMapChipField(&field);
+
+		// 右を押しっぱなしにして定期的にジャンプ（壁・足場・天井との判定を一通り通す）
+		uint64_t frame = 0;
+		runner.Run("Player::Update (map collision)", SizeLabel(size), 1, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i, ++frame) {
+				PlayerInput playerInput;
+				playerInput.buttons = static_cast<uint8_t>(PlayerInput::kRight | (frame % 40 < 10 ? PlayerInput::kJump : 0));
+				player.SetInput(playerInput);
+				player.Update();
+
+				// 端まで行ったら最初から
+				if (frame % 2048 == 2047) {
+					player.Reset(start);
+				}
+			}
+			Consume(player.GetWorldPosition().x);
+		});
+	}
+}
+
+void BenchEnemy(Runner& runner, const std::vector<uint32_t>& counts) {
+	Camera camera;
+	camera.Initialize();
+	std::unique_ptr<Model> model(Model::CreateFromOBJ("enemy"));
+
+	// 地面の上を歩かせる（壁に当たると待ち→旋回）
+	FieldSize size = {200, 20};
+	MapChipField field;
+	field.LoadMapChipCsv(WriteFieldCsv(size));
+
+	for (uint32_t count : counts) {
+		std::vector<std::unique_ptr<Enemy>> enemies;
+		for (uint32_t i = 0; i < count; ++i) {
+			enemies.push_back(std::make_unique<Enemy>());
+			enemies.back()->Initialize(model.get(), &camera, field.GetMapChipPositionByIndex(1 + i % (size.width - 2), size.height - 3));
+			enemies.back()->SetMapChipField(&field);
+		}
+
+		runner.Run("Enemy::Update (BehaviorWalkUpdate)", std::to_string(count) + " enemies", count, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				for (std::unique_ptr<Enemy>& enemy : enemies) {
+					enemy->Update();
+				}
+			}
+			Consume(enemies.front()->GetWorldPosition().x);
+		});
+	}
+}
+
+void BenchEnemySpawner(Runner& runner, const std::vector<uint32_t>& counts) {
+	Camera camera;
+	camera.Initialize();
+	std::unique_ptr<Model> model(Model::CreateFromOBJ("enemy"));
+
+	// 横に長いマップに敵を並べ、カメラを左から右へ流す（4ブロックに1体）
+	for (uint32_t count : counts) {
+		FieldSize size = {count * 4 + 4, 20};
+		MapChipField field;
+		field.LoadMapChipCsv(WriteFieldCsv(size, count));
+
+		EnemySpawner spawner;
+		spawner.Initialize(&field, model.get(), &camera, nullptr);
+
+		float cameraX = 0.0f;
+		runner.Run("EnemySpawner (activation + update)", std::to_string(spawner.GetRecordCount()) + " enemies", 1, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				cameraX += 0.5f;
+				if (cameraX > static_cast<float>(size.width)) {
+					cameraX = 0.0f;
+				}
+				spawner.UpdateActivation(cameraX);
+				spawner.Update();
+			}
+			Consume(spawner.GetActiveEnemies().size());
+		});
+	}
+}
+
+void BenchFlowField(Runner& runner, const std::vector<FieldSize>& sizes) {
+	const FlowField::Reach reach = FlowField::MakeReach(Player::GetJumpAcceleration(), Player::GetGravityAcceleration(), Enemy::GetWalkSpeed(), Player::GetMaxJumpCount());
+
+	for (const FieldSize& size : sizes) {
+		std::string label = SizeLabel(size);
+		MapChipField field;
+		field.LoadMapChipCsv(WriteFieldCsv(size));
+
+		FlowField flowField;
+		runner.RunFixed("FlowField::Initialize", label, static_cast<uint64_t>(size.width) * size.height, 0, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				flowField.Initialize(&field, reach);
+			}
+			Consume(flowField.GetEdgeCount());
+		});
+		// --filter で上を飛ばしたときも、空の場で作り直しを測らないようにする
+		if (flowField.GetNodeCount() == 0) {
+			flowField.Initialize(&field, reach);
+		}
+
+		// 目標を地面の上で左右に入れ替えながら全体を作り直す（敵1体ごとに探索した場合の1体分の費用）
+		const Vector3 targets[] = {field.GetMapChipPositionByIndex(2, size.height - 3), field.GetMapChipPositionByIndex(size.width - 3, size.height - 3)};
+		uint64_t flip = 0;
+		runner.Run("FlowField full rebuild", label + " (" + std::to_string(flowField.GetNodeCount()) + " nodes)", flowField.GetNodeCount(), [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				flowField.Update(targets[++flip & 1], 0);
+				flowField.Flush();
+			}
+			Consume(flowField.GetCompletedBuilds());
+		});
+
+		// 敵1体あたりの費用（完成した表を1回引くだけ）
+		std::vector<Vector3> positions(1024);
+		std::mt19937 engine(7);
+		std::uniform_int_distribution<uint32_t> column(1, size.width - 2);
+		for (Vector3& position : positions) {
+			position = field.GetMapChipPositionByIndex(column(engine), size.height - 3);
+		}
+		runner.Run("FlowField::GetStep", label, positions.size(), [&](uint64_t n) {
+			FlowField::Step step{};
+			uint64_t found = 0;
+			for (uint64_t i = 0; i < n; ++i) {
+				for (const Vector3& position : positions) {
+					found += flowField.GetStep(position, step);
+				}
+			}
+			Consume(found);
+		});
+	}
+}
+
+/// <summary>
+/// 比較用のタイル単位の A*（NavGraph と同じ動き方を、足場ではなく立てるタイル1つずつをノードにして探す）
+/// ・辺は隣のタイルへの歩きと、NavGraph の辺（踏み切る列のタイル → 着く列のタイル。軌道で確かめた同じコスト）
+/// ・見積もりは NavGraph と同じ横の距離 / runSpeed（目印は使わない）
+/// </summary>
+class TileAStar {
+public:
+	static inline const uint32_t kNoNode = UINT32_MAX;
+
+private:
+	struct Edge {
+		uint32_t to;
+		float cost;
+	};
+	struct OpenEntry {
+		float f;
+		float g;
+		uint32_t node;
+	};
+
+	const NavGraph* graph_ = nullptr;
+	float walkFramesPerTile_ = 0.0f;
+	// 足場ごとの最初のノード（足場の左端の列）
+	std::vector<uint32_t> surfaceFirstNode_;
+	std::vector<uint32_t> xOfNode_;
+	std::vector<uint32_t> offsets_;
+	std::vector<Edge> edges_;
+
+	// 探索の作業領域
+	std::vector<float> gScores_;
+	std::vector<uint32_t> stamps_;
+	std::vector<OpenEntry> open_;
+	uint32_t searchStamp_ = 0;
+	uint32_t lastExpandedCount_ = 0;
+
+public:
+	void Build(const NavGraph& graph, float runSpeed) {
+		graph_ = &graph;
+		walkFramesPerTile_ = 1.0f / runSpeed;
+		const std::vector<NavGraph::Surface>& surfaces = graph.GetSurfaces();
+		const std::vector<NavGraph::Link>& links = graph.GetLinks();
+
+		surfaceFirstNode_.clear();
+		xOfNode_.clear();
+		for (const NavGraph::Surface& surface : surfaces) {
+			surfaceFirstNode_.push_back(static_cast<uint32_t>(xOfNode_.size()));
+			for (uint32_t x = surface.left; x <= surface.right; ++x) {
+				xOfNode_.push_back(x);
+			}
+		}
+
+		offsets_.assign(1, 0);
+		edges_.clear();
+		for (uint32_t s = 0; s < static_cast<uint32_t>(surfaces.size()); ++s) {
+			const NavGraph::Surface& surface = surfaces[s];
+			for (uint32_t x = surface.left; x <= surface.right; ++x) {
+				uint32_t node = surfaceFirstNode_[s] + (x - surface.left);
+				if (x > surface.left) {
+					edges_.push_back({node - 1, walkFramesPerTile_});
+				}
+				if (x < surface.right) {
+					edges_.push_back({node + 1, walkFramesPerTile_});
+				}
+				for (uint32_t i = surface.linkBegin; i < surface.linkEnd; ++i) {
+					if (links[i].takeoffX == x) {
+						edges_.push_back({surfaceFirstNode_[links[i].to] + (links[i].landingX - surfaces[links[i].to].left), links[i].cost});
+					}
+				}
+				offsets_.push_back(static_cast<uint32_t>(edges_.size()));
+			}
+		}
+
+		gScores_.assign(xOfNode_.size(), 0.0f);
+		stamps_.assign(xOfNode_.size(), 0);
+		searchStamp_ = 0;
+	}
+
+	uint32_t FindNode(const Vector3& position) const {
+		uint32_t surface = graph_->FindSurface(position);
+		if (surface == NavGraph::kNoSurface) {
+			return kNoNode;
+		}
+		const NavGraph::Surface& found = graph_->GetSurfaces()[surface];
+		uint32_t x = static_cast<uint32_t>(std::max(0.0f, position.x + 0.5f));
+		return surfaceFirstNode_[surface] + (std::clamp(x, found.left, found.right) - found.left);
+	}
+
+	bool FindPath(const Vector3& start, const Vector3& goal, float* cost = nullptr) {
+		lastExpandedCount_ = 0;
+		uint32_t startNode = FindNode(start);
+		uint32_t goalNode = FindNode(goal);
+		if (startNode == kNoNode || goalNode == kNoNode) {
+			return false;
+		}
+		const uint32_t goalX = xOfNode_[goalNode];
+		auto estimate = [&](uint32_t node) { return static_cast<float>(xOfNode_[node] > goalX ? xOfNode_[node] - goalX : goalX - xOfNode_[node]) * walkFramesPerTile_; };
+		auto greater = [](const OpenEntry& a, const OpenEntry& b) { return a.f > b.f || (a.f == b.f && a.g < b.g); };
+
+		if (++searchStamp_ == 0) {
+			std::fill(stamps_.begin(), stamps_.end(), 0);
+			searchStamp_ = 1;
+		}
+		open_.clear();
+		stamps_[startNode] = searchStamp_;
+		gScores_[startNode] = 0.0f;
+		open_.push_back({estimate(startNode), 0.0f, startNode});
+
+		while (!open_.empty()) {
+			std::pop_heap(open_.begin(), open_.end(), greater);
+			OpenEntry entry = open_.back();
+			open_.pop_back();
+			if (entry.g > gScores_[entry.node]) {
+				continue;
+			}
+			if (entry.node == goalNode) {
+				if (cost) {
+					*cost = entry.g;
+				}
+				return true;
+			}
+			++lastExpandedCount_;
+			for (uint32_t k = offsets_[entry.node]; k < offsets_[entry.node + 1]; ++k) {
+				const Edge& edge = edges_[k];
+				float next = entry.g + edge.cost;
+				if (stamps_[edge.to] == searchStamp_ && gScores_[edge.to] <= next) {
+					continue;
+				}
+				stamps_[edge.to] = searchStamp_;
+				gScores_[edge.to] = next;
+				open_.push_back({next + estimate(edge.to), next, edge.to});
+				std::push_heap(open_.begin(), open_.end(), greater);
+			}
+		}
+		return false;
+	}
+
+	uint32_t GetNodeCount() const { return static_cast<uint32_t>(xOfNode_.size()); }
+	uint32_t GetEdgeCount() const { return static_cast<uint32_t>(edges_.size()); }
+	uint32_t GetLastExpandedCount() const { return lastExpandedCount_; }
+};
+
+void BenchNavGraph(Runner& runner, const std::vector<FieldSize>& sizes) {
+	const NavGraph::Physics physics = NavGraph::MakePlayerPhysics();
+
+	for (const FieldSize& size : sizes) {
+		std::string label = SizeLabel(size);
+		std::string csvPath = WriteFieldCsv(size);
+		MapChipField field;
+		field.LoadMapChipCsv(csvPath);
+
+		NavGraph graph;
+		runner.RunFixed("NavGraph::Build", label, static_cast<uint64_t>(size.width) * size.height, 1, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				graph.Build(field, physics);
+			}
+			Consume(graph.GetLinks().size());
+		});
+		// --filter で作る計測を外したときも、以降の計測に使うので作っておく
+		if (graph.GetSurfaces().empty()) {
+			graph.Build(field, physics);
+		}
+		std::string graphLabel = label + " (" + std::to_string(graph.GetSurfaces().size()) + " surfaces, " + std::to_string(graph.GetLinks().size()) + " links)";
+
+		// 2回目以降のロード（キャッシュを読むだけ）
+		std::string cachePath = NavGraph::GetCachePath(csvPath);
+		graph.WriteCache(cachePath, csvPath);
+		NavGraph loaded;
+		runner.Run("NavGraph::ReadCache", graphLabel, 1, [&](uint64_t n) {
+			uint64_t ok = 0;
+			for (uint64_t i = 0; i < n; ++i) {
+				ok += loaded.ReadCache(cachePath, csvPath, physics);
+			}
+			Consume(ok);
+		});
+
+		// 立てる場所どうしの組をばらばらに選んで探す
+		const std::vector<NavGraph::Surface>& surfaces = graph.GetSurfaces();
+		std::vector<std::pair<Vector3, Vector3>> queries(256);
+		std::mt19937 engine(11);
+		std::uniform_int_distribution<size_t> pick(0, surfaces.size() - 1);
+		auto randomPosition = [&]() {
+			const NavGraph::Surface& surface = surfaces[pick(engine)];
+			return field.GetMapChipPositionByIndex((surface.left + surface.right) / 2, surface.row);
+		};
+		for (std::pair<Vector3, Vector3>& query : queries) {
+			query = {randomPosition(), randomPosition()};
+		}
+
+		std::vector<NavGraph::PathLink> path;
+		uint64_t found = 0;
+		runner.Run("NavGraph::FindPath", graphLabel, queries.size(), [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				for (const std::pair<Vector3, Vector3>& query : queries) {
+					found += graph.FindPath(query.first, query.second, path);
+				}
+			}
+			Consume(found);
+		});
+
+		// 同じ組を、同じ辺のままタイル単位で探す（足場にまとめたことで何倍速くなったか）
+		TileAStar tileAStar;
+		tileAStar.Build(graph, physics.runSpeed);
+		std::string tileLabel = label + " (" + std::to_string(tileAStar.GetNodeCount()) + " tiles, " + std::to_string(tileAStar.GetEdgeCount()) + " edges)";
+		runner.Run("NavGraph::FindPath (tile A* baseline)", tileLabel, queries.size(), [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				for (const std::pair<Vector3, Vector3>& query : queries) {
+					found += tileAStar.FindPath(query.first, query.second);
+				}
+			}
+			Consume(found);
+		});
+
+		// 1回ずつ回して、見つかった数・展開したノード数・経路のコストを比べる
+		// 足場の探索は着いた列を1つに決めるので、タイル単位の最短より長くなることがある
+		if (!runner.IsSelected("NavGraph::FindPath")) {
+			continue;
+		}
+		uint64_t graphFound = 0;
+		uint64_t tileFound = 0;
+		uint64_t graphExpanded = 0;
+		uint64_t tileExpanded = 0;
+		double costRatio = 0.0;
+		for (const std::pair<Vector3, Vector3>& query : queries) {
+			float graphCost = 0.0f;
+			float tileCost = 0.0f;
+			bool isGraphFound = graph.FindPath(query.first, query.second, path, &graphCost);
+			bool isTileFound = tileAStar.FindPath(query.first, query.second, &tileCost);
+			graphFound += isGraphFound;
+			tileFound += isTileFound;
+			graphExpanded += graph.GetLastExpandedCount();
+			tileExpanded += tileAStar.GetLastExpandedCount();
+			if (isGraphFound && isTileFound && tileCost > 0.0f) {
+				costRatio += graphCost / tileCost;
+			}
+		}
+		std::fprintf(stderr, "  %s: found %llu / %llu of %zu, expanded %.1f surfaces / %.1f tiles per query, path cost %.3fx of tile optimum\n", label.c_str(),
+		             static_cast<unsigned long long>(graphFound), static_cast<unsigned long long>(tileFound), queries.size(), static_cast<double>(graphExpanded) / queries.size(),
+		             static_cast<double>(tileExpanded) / queries.size(), graphFound > 0 ? costRatio / static_cast<double>(graphFound) : 0.0);
+	}
+}
+
+void BenchFireworks(Runner& runner, const std::vector<int>& counts) {
+	Camera camera;
+	camera.Initialize();
+	std::unique_ptr<Model> model(Model::CreateFromOBJ("fireworks"));
+
+	for (int count : counts) {
+		Fireworks fireworks;
+		fireworks.Initialize(model.get(), &camera);
+		// 計測中に消えないよう寿命を長くする
+		fireworks.Burst({0.0f, 10.0f, 0.0f}, count, 3.0f, 7.0f, 1.0e6f, 1.0e6f);
+
+		runner.Run("Fireworks::Update", std::to_string(count) + " sparks", static_cast<uint64_t>(count), [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				fireworks.Update(1.0f / 60.0f);
+			}
+		});
+	}
+}
+
+void BenchJobSystem(Runner& runner, const std::vector<uint32_t>& enemyCounts) {
+	Camera camera;
+	camera.Initialize();
+	std::unique_ptr<Model> enemyModel(Model::CreateFromOBJ("enemy"));
+	std::unique_ptr<Model> sparkModel(Model::CreateFromOBJ("fireworks"));
+
+	FieldSize size = {200, 20};
+	MapChipField field;
+	field.LoadMapChipCsv(WriteFieldCsv(size));
+
+	// 1スレッドとコア数で比べる（他の計測はジョブシステムを起動せず1スレッドのまま）
+	std::vector<uint32_t> threadCounts = {1};
+	uint32_t coreCount = std::max(1u, std::thread::hardware_concurrency());
+	for (uint32_t threads = 2; threads < coreCount; threads *= 2) {
+		threadCounts.push_back(threads);
+	}
+	if (coreCount > 1) {
+		threadCounts.push_back(coreCount);
+	}
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	for (uint32_t threads : threadCounts) {
+		jobSystem->Initialize(threads - 1);
+		std::string threadLabel = std::to_string(threads) + " threads";
+
+		runner.Run("JobSystem::ParallelFor (empty)", threadLabel, 1, [&](uint64_t n) {
+			uint64_t sum = 0;
+			for (uint64_t i = 0; i < n; ++i) {
+				jobSystem->ParallelFor("Bench", 4096, 64, [&](uint32_t begin, uint32_t end) { Consume(end - begin); });
+				++sum;
+			}
+			Consume(sum);
+		});
+
+		for (uint32_t count : enemyCounts) {
+			std::vector<std::unique_ptr<Enemy>> enemies;
+			for (uint32_t i = 0; i < count; ++i) {
+				enemies.push_back(std::make_unique<Enemy>());
+				enemies.back()->Initialize(enemyModel.get(), &camera, field.GetMapChipPositionByIndex(1 + i % (size.width - 2), size.height - 3));
+				enemies.back()->SetMapChipField(&field);
+			}
+			runner.Run("JobSystem Enemy::Update", std::to_string(count) + " enemies, " + threadLabel, count, [&](uint64_t n) {
+				for (uint64_t i = 0; i < n; ++i) {
+					jobSystem->ParallelFor("Enemy::Update (job)", count, EnemySpawner::kUpdateChunkSize, [&](uint32_t begin, uint32_t end) {
+						for (uint32_t e = begin; e < end; ++e) {
+							enemies[e]->Update();
+						}
+					});
+				}
+				Consume(enemies.front()->GetWorldPosition().x);
+			});
+		}
+
+		Fireworks fireworks;
+		fireworks.Initialize(sparkModel.get(), &camera);
+		fireworks.Burst({0.0f, 10.0f, 0.0f}, 27000, 3.0f, 7.0f, 1.0e6f, 1.0e6f);
+		runner.Run("JobSystem Fireworks::Update", "27000 sparks, " + threadLabel, 27000, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				fireworks.Update(1.0f / 60.0f);
+			}
+		});
+	}
+	jobSystem->Finalize();
+}
+
+void BenchRenderPipeline(Runner& runner, const std::vector<uint32_t>& enemyCounts) {
+	Camera camera;
+	camera.Initialize();
+	std::unique_ptr<Model> enemyModel(Model::CreateFromOBJ("enemy"));
+
+	FieldSize size = {200, 20};
+	MapChipField field;
+	field.LoadMapChipCsv(WriteFieldCsv(size));
+
+	ModelRenderBackend backend;
+	backend.Initialize(&camera);
+	uint32_t enemyModelId = backend.RegisterModel(enemyModel.get());
+
+	for (uint32_t count : enemyCounts) {
+		std::vector<std::unique_ptr<Enemy>> enemies;
+		for (uint32_t i = 0; i < count; ++i) {
+			enemies.push_back(std::make_unique<Enemy>());
+			enemies.back()->Initialize(enemyModel.get(), &camera, field.GetMapChipPositionByIndex(1 + i % (size.width - 2), size.height - 3));
+			enemies.back()->SetMapChipField(&field);
+		}
+
+		// 1フレーム = 更新 → 記録 → （組み立て）→ 描画。描画スレッドありなら組み立てが次のフレームの更新と重なる
+		for (bool useThread : {false, true}) {
+			RenderPipeline pipeline;
+			pipeline.Initialize(backend.GetStaticTransformCount(), useThread);
+
+			runner.Run(useThread ? "RenderPipeline frame (pipelined)" : "RenderPipeline frame (serial)", std::to_string(count) + " enemies", count, [&](uint64_t n) {
+				for (uint64_t i = 0; i < n; ++i) {
+					for (const std::unique_ptr<Enemy>& enemy : enemies) {
+						enemy->Update();
+					}
+
+					FrameSnapshot& snapshot = pipeline.BeginSnapshot();
+					snapshot.matView = camera.matView;
+					snapshot.matProjection = camera.matProjection;
+					for (const std::unique_ptr<Enemy>& enemy : enemies) {
+						snapshot.Add(enemyModelId, enemy->GetWorldTransform());
+					}
+					pipeline.Publish();
+
+					pipeline.Execute(backend);
+				}
+				Consume(pipeline.GetExecutedFrame());
+			});
+			pipeline.Finalize();
+		}
+	}
+}
+
+void BenchRandom(Runner& runner) {
+	Random::SetGlobalSeed(Random::kDefaultSeed);
+	runner.Run("Random::GeneraterFloat", "1", 1, [&](uint64_t n) {
+		float sum = 0.0f;
+		for (uint64_t i = 0; i < n; ++i) {
+			sum += Random::GeneraterFloat(-1.0f, 1.0f);
+		}
+		Consume(sum);
+	});
+
+	// 比較用：以前の実装（呼ぶたびに random_device で mt19937_64 をシードし直し、分布を作る）
+	runner.Run("Random::GeneraterFloat (mt19937_64 reseeded)", "1", 1, [&](uint64_t n) {
+		std::random_device seedGenerator;
+		std::mt19937_64 engine;
+		float sum = 0.0f;
+		for (uint64_t i = 0; i < n; ++i) {
+			engine.seed(seedGenerator());
+			std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+			sum += distribution(engine);
+		}
+		Consume(sum);
+	});
+
+	Random::Stream stream(1, 0);
+	runner.Run("Random::Stream::NextFloat", "1", 1, [&](uint64_t n) {
+		float sum = 0.0f;
+		for (uint64_t i = 0; i < n; ++i) {
+			sum += stream.NextFloat(-1.0f, 1.0f);
+		}
+		Consume(sum);
+	});
+
+	for (size_t count : {size_t(64), size_t(4096)}) {
+		std::vector<float> values(count);
+		runner.Run("Random::Stream::FillUniform", std::to_string(count), count, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				stream.FillUniform(values, -1.0f, 1.0f);
+				Consume(values[0]);
+			}
+		});
+	}
+
+	std::vector<Vector3> directions(4096);
+	runner.Run("Random::Stream::FillUnitVectors", "4096", directions.size(), [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			stream.FillUnitVectors(directions);
+			Consume(directions[0].x);
+		}
+	});
+}
+
+void BenchGhostRace(Runner& runner, const std::vector<uint32_t>& counts) {
+	Camera camera;
+	camera.Initialize();
+	std::unique_ptr<Model> model(Model::CreateFromOBJ("player"));
+
+	FieldSize size = {1000, 100};
+	MapChipField field;
+	field.LoadMapChipCsv(WriteFieldCsv(size));
+	Vector3 start = field.GetMapChipPositionByIndex(2, size.height - 4);
+
+	// 1分ぶんの走り（右を押しっぱなしで、走りごとに違う間隔でジャンプ・攻撃）
+	const uint32_t kRunFrames = 3600;
+	const uint32_t kRunVariations = 16;
+	Player player;
+	player.Initialize(model.get(), model.get(), &camera, start);
+	player.SetMapChipField(&field);
+	auto run = [&](GhostRecording& recording, uint32_t variation) {
+		player.Reset(start);
+		recording.Begin();
+		for (uint32_t frame = 0; frame < kRunFrames; ++frame) {
+			PlayerInput playerInput;
+			uint8_t buttons = PlayerInput::kRight;
+			if (frame % (30 + variation * 3) < 10) {
+				buttons |= PlayerInput::kJump;
+			}
+			if (frame % (90 + variation * 7) == 0) {
+				buttons |= PlayerInput::kAttack;
+			}
+			playerInput.buttons = buttons;
+			player.SetInput(playerInput);
+			player.Update();
+			recording.Record(player.GetWorldTransform(), player.IsAttackEffect() ? GhostRecording::kFlagAttackEffect : 0);
+		}
+		recording.Finish();
+	};
+
+	// 記録（Player::Update の後に毎フレーム呼ぶ分だけ）
+	GhostRecording recording;
+	runner.Run("GhostRecording::Record", "3600 frames", kRunFrames, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			recording.Begin();
+			for (uint32_t frame = 0; frame < kRunFrames; ++frame) {
+				recording.Record(player.GetWorldTransform(), 0);
+			}
+		}
+		Consume(recording.GetBytes().size());
+	});
+
+	// 走りを作って一覧に入れ、ファイルを介して読み直す（読み直したものが同じかは Tools/GhostRecordingTest で確かめる）
+	GhostBoard board;
+	board.Load("", GhostBoard::ComputeMapKey(field));
+	std::vector<GhostRecording> runs(kRunVariations);
+	size_t runBytes = 0;
+	for (uint32_t i = 0; i < kRunVariations; ++i) {
+		run(runs[i], i);
+		runBytes += runs[i].GetBytes().size();
+	}
+	for (uint32_t i = 0; i < GhostBoard::kCapacity; ++i) {
+		board.Submit(runs[i % kRunVariations]);
+	}
+	std::string boardPath = (std::filesystem::temp_directory_path() / "gameplay_bench" / "ghosts.bin").string();
+	board.Save(boardPath);
+
+	double bytesPerFrame = static_cast<double>(runBytes) / (static_cast<double>(kRunVariations) * kRunFrames);
+	char bytesLabel[64];
+	std::snprintf(bytesLabel, sizeof(bytesLabel), "%.2f B/frame", bytesPerFrame);
+
+	GhostBoard loaded;
+	runner.Run("GhostBoard::Load", std::to_string(GhostBoard::kCapacity) + " runs, " + bytesLabel, GhostBoard::kCapacity, [&](uint64_t n) {
+		uint64_t ok = 0;
+		for (uint64_t i = 0; i < n; ++i) {
+			ok += loaded.Load(boardPath, board.GetMapKey());
+		}
+		Consume(ok);
+	});
+
+	// 補間の誤差（記録した走りの全フレームで、再生した位置と元の位置の差の最大）
+	float maxError = 0.0f;
+	{
+		GhostRecording exact;
+		std::vector<Vector3> positions;
+		player.Reset(start);
+		exact.Begin();
+		for (uint32_t frame = 0; frame < kRunFrames; ++frame) {
+			PlayerInput playerInput;
+			playerInput.buttons = static_cast<uint8_t>(PlayerInput::kRight | (frame % 30 < 10 ? PlayerInput::kJump : 0));
+			player.SetInput(playerInput);
+			player.Update();
+			exact.Record(player.GetWorldTransform(), 0);
+			positions.push_back(player.GetWorldTransform().translation_);
+		}
+		exact.Finish();
+		std::vector<GhostRecording> exactRuns = {exact};
+		GhostRace race;
+		race.Initialize(exactRuns);
+		for (uint32_t frame = 0; frame < kRunFrames; ++frame) {
+			race.Update(frame);
+			const Matrix4x4& matWorld = race.GetMatrices()[0];
+			maxError = std::max({maxError, std::abs(matWorld.m[3][0] - positions[frame].x), std::abs(matWorld.m[3][1] - positions[frame].y)});
+		}
+	}
+
+	// 何百体を同時に再生（1フレームぶんの補間と行列の計算、描画の記録へ写すところまで）
+	for (uint32_t count : counts) {
+		std::vector<GhostRecording> recordings;
+		size_t recordingBytes = 0;
+		for (uint32_t i = 0; i < count; ++i) {
+			recordings.push_back(board.GetEntries()[i % board.GetEntries().size()]);
+			recordingBytes += recordings.back().GetBytes().size();
+		}
+		GhostRace race;
+		race.Initialize(recordings);
+
+		char label[128];
+		std::snprintf(label, sizeof(label), "%u ghosts (%zu B/ghost playback + %zu B/ghost run, max err %.3f)", count, race.GetPlaybackBytes() / count, recordingBytes / count, maxError);
+
+		uint32_t frame = 0;
+		runner.Run("GhostRace::Update", label, count, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				race.Update(frame);
+				frame = (frame + 1) % (kRunFrames + 120);
+			}
+			Consume(race.GetMatrices()[0].m[3][0]);
+		});
+
+		FrameSnapshot snapshot;
+		runner.Run("GhostRace::Capture", std::to_string(count) + " ghosts", count, [&](uint64_t n) {
+			for (uint64_t i = 0; i < n; ++i) {
+				snapshot.Clear();
+				race.Capture(snapshot, 1, 2, 1);
+			}
+			Consume(snapshot.items.size());
+		});
+	}
+}
+
+void BenchTextBatch(Runner& runner) {
+	// 積んだ四角形が正しいかは Tools/TextBatchTest で確かめる
+	TextBatch batch;
+	batch.Reserve(1024);
+
+	// HUD の1フレーム分（走行タイム＋統計4行。GameScene::BuildHud と同じ量）
+	const char* stats = "BEST    00:41.23\nROUTE   3 JUMPS\nGHOSTS  256\nENEMIES 12/340";
+	const uint32_t statsColor = TextBatch::PackColor(1.0f, 1.0f, 1.0f, 0.85f);
+	batch.AddTime(HudFont::kDigits, 0, {640.0f, 16.0f}, 0.3f, TextBatch::kColorWhite, TextBatch::Align::kCenter);
+	batch.AddText(HudFont::kAscii, stats, {16.0f, 16.0f}, 2.0f, statsColor);
+	const uint32_t hudQuads = batch.GetQuadCount();
+
+	char label[96];
+	std::snprintf(label, sizeof(label), "%u quads, %zu B vertices", hudQuads, static_cast<size_t>(hudQuads) * TextBatch::kVerticesPerQuad * sizeof(TextVertex));
+	uint32_t frame = 0;
+	runner.Run("TextBatch HUD frame", label, hudQuads, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			batch.Clear();
+			batch.AddTime(HudFont::kDigits, frame++, {640.0f, 16.0f}, 0.3f, TextBatch::kColorWhite, TextBatch::Align::kCenter);
+			batch.AddText(HudFont::kAscii, stats, {16.0f, 16.0f}, 2.0f, statsColor);
+		}
+		Consume(batch.GetVertices().back().x);
+	});
+
+	// 長い文字列（デバッグ表示の1画面ぶん）
+	std::string page;
+	for (uint32_t line = 0; line < 16; ++line) {
+		for (uint32_t c = 0; c < 63; ++c) {
+			page += static_cast<char>(' ' + 1 + (line * 63 + c) % 94);
+		}
+		page += '\n';
+	}
+	batch.Clear();
+	batch.AddText(HudFont::kAscii, page.c_str(), {0.0f, 0.0f}, 1.0f, TextBatch::kColorWhite);
+	const uint32_t pageQuads = batch.GetQuadCount();
+	runner.Run("TextBatch::AddText", std::to_string(pageQuads) + " quads", pageQuads, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			batch.Clear();
+			batch.AddText(HudFont::kAscii, page.c_str(), {0.0f, 0.0f}, 1.0f, TextBatch::kColorWhite);
+		}
+		Consume(batch.GetVertices().back().y);
+	});
+}
+
+void BenchSpriteAtlas(Runner& runner) {
+	// 表が正しいかは Tools/SpriteAtlasTest で確かめる
+	const SpriteAtlasData& data = UiAtlas::kData;
+
+	// 全ての名前を引く（シーンの初期化でスプライトを作るときの分）
+	runner.Run("SpriteAtlas::Find", std::to_string(data.entryCount) + " entries", data.entryCount, [&](uint64_t n) {
+		uint32_t sum = 0;
+		for (uint64_t i = 0; i < n; ++i) {
+			for (uint32_t j = 0; j < data.entryCount; ++j) {
+				sum += SpriteAtlas::Find(data, data.entries[j].name)->width;
+			}
+		}
+		Consume(sum);
+	});
+}
+
+void BenchTextureCache(Runner& runner) {
+	// 焼いたテクスチャ（2048x1024 の BC3、ミップ12段。中身は適当）と元画像（UI のアトラスくらいの 200 KB）、マニフェストを一時ディレクトリに作る
+	// 引けるかどうかは Tools/TextureCacheTest で確かめる
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "gameplay_bench" / "textures";
+	std::filesystem::create_directories(directory / "textureCache");
+	const uint32_t width = 2048;
+	const uint32_t height = 1024;
+	const uint32_t mipCount = DdsTexture::GetFullMipCount(width, height);
+	std::vector<std::vector<uint8_t>> levels;
+	for (uint32_t level = 0; level < mipCount; ++level) {
+		levels.emplace_back(DdsTexture::GetLevelSize(DdsTexture::Format::kBC3, std::max(width >> level, 1u), std::max(height >> level, 1u)), static_cast<uint8_t>(level));
+	}
+	const std::string cookedPath = (directory / "textureCache" / "ui.dds").string();
+	const std::string sourcePath = (directory / "ui.png").string();
+	const std::string source(200 * 1024, 'x');
+	std::ofstream(sourcePath, std::ios::binary) << source;
+
+	TextureCache::Entry entry;
+	entry.cookedPath = "textureCache/ui.dds";
+	entry.sourceSize = source.size();
+	entry.sourceCrc = TextureCache::ComputeCrc32(reinterpret_cast<const uint8_t*>(source.data()), source.size());
+	entry.sourceTime = FileUtility::GetStamp(sourcePath).time;
+	entry.format = DdsTexture::Format::kBC3;
+	entry.width = width;
+	entry.height = height;
+	entry.mipCount = mipCount;
+	DdsTexture::Write(cookedPath, entry.format, width, height, levels);
+	entry.cookedSize = std::filesystem::file_size(cookedPath);
+	// 同じ中身の元画像を、時刻の無い行（チェックアウトし直して時刻が合わなくなったのと同じ）で引く
+	std::ofstream((directory / "untimed.png").string(), std::ios::binary) << source;
+	TextureCache::Entry untimed = entry;
+	untimed.sourceTime = 0;
+	{
+		std::ofstream manifest(directory / "textureCache" / "manifest.csv", std::ios::binary);
+		manifest << TextureCache::FormatManifestLine("ui.png", entry) << "\n" << TextureCache::FormatManifestLine("untimed.png", untimed) << "\n";
+	}
+	TextureCache* cache = TextureCache::GetInstance();
+	cache->Initialize(directory.string());
+
+	char label[64];
+	std::snprintf(label, sizeof(label), "%ux%u BC3, %u mips, %llu KB", width, height, mipCount, static_cast<unsigned long long>(entry.cookedSize / 1024));
+	DdsTexture texture;
+	runner.Run("DdsTexture::Open", label, 1, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			texture.Open(cookedPath);
+			Consume(texture.GetLevel(mipCount - 1).data);
+		}
+	});
+	texture.Close();
+	runner.Run("TextureCache::Resolve", "fresh entry (size + time)", 1, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			Consume(cache->Resolve("ui.png").size());
+		}
+	});
+	runner.Run("TextureCache::Resolve", "time differs (CRC32 of " + std::to_string(source.size() / 1024) + " KB)", 1, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			Consume(cache->Resolve("untimed.png").size());
+		}
+	});
+
+	// 後のシーンの計測はゲームと同じ状態で
+	cache->Initialize("Resources");
+	std::error_code errorCode;
+	std::filesystem::remove_all(directory, errorCode);
+}
+
+void BenchSceneRestart(Runner& runner) {
+	// 初回の Initialize（モデル・テクスチャの読み込みはヘッドレス版なので CPU 側の処理だけ）
+	runner.RunFixed("GameScene::Initialize", "blocks.csv", 1, 1, [&](uint64_t) {
+		std::unique_ptr<GameScene> scene = std::make_unique<GameScene>();
+		scene->Initialize();
+	});
+
+	// 死亡後のやり直し
+	GameScene scene;
+	scene.Initialize();
+	runner.Run("GameScene::Reset", "blocks.csv", 1, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			scene.Reset();
+		}
+	});
+
+	// 状態の記録と復元（巻き戻し・リプレイの1回分）
+	SimulationSnapshot snapshot;
+	runner.Run("GameScene::SaveSnapshot", "blocks.csv", 1, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			scene.SaveSnapshot(snapshot);
+		}
+		Consume(snapshot.GetSize());
+	});
+	runner.Run("GameScene::LoadSnapshot", "blocks.csv", 1, [&](uint64_t n) {
+		for (uint64_t i = 0; i < n; ++i) {
+			scene.LoadSnapshot(snapshot);
+		}
+	});
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	Config config;
+	for (int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+		if (argument == "--out" && i + 1 < argc) {
+			config.outPath = argv[++i];
+		} else if (argument == "--filter" && i + 1 < argc) {
+			config.filter = argv[++i];
+		} else if (argument == "--reps" && i + 1 < argc) {
+			config.reps = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+		} else if (argument == "--quick") {
+			config.quick = true;
+		} else {
+			std::fprintf(stderr, "usage: %s [--out file.json] [--filter name] [--reps n] [--quick]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	Runner runner(config);
+
+	std::vector<FieldSize> fieldSizes = {{100, 20}, {1000, 100}};
+	if (!config.quick) {
+		fieldSizes.push_back({1000, 1000});
+	}
+
+	BenchMapChipField(runner, fieldSizes);
+	BenchBlockTransforms(runner, {{100, 20}, {1000, 100}});
+	BenchAABB(runner, {64, 4096});
+	BenchMatrix(runner);
+	BenchPlayer(runner, {{100, 20}, {1000, 100}});
+	BenchEnemy(runner, config.quick ? std::vector<uint32_t>{3, 100} : std::vector<uint32_t>{3, 100, 1000});
+	BenchEnemySpawner(runner, config.quick ? std::vector<uint32_t>{1000} : std::vector<uint32_t>{1000, 10000});
+	BenchFlowField(runner, fieldSizes);
+	BenchNavGraph(runner, fieldSizes);
+	BenchFireworks(runner, config.quick ? std::vector<int>{270, 2700} : std::vector<int>{270, 2700, 27000});
+	BenchJobSystem(runner, config.quick ? std::vector<uint32_t>{1000} : std::vector<uint32_t>{1000, 10000});
+	BenchRenderPipeline(runner, config.quick ? std::vector<uint32_t>{1000} : std::vector<uint32_t>{1000, 10000});
+	BenchRandom(runner);
+	BenchGhostRace(runner, config.quick ? std::vector<uint32_t>{256} : std::vector<uint32_t>{16, 256, 1024});
+	BenchTextBatch(runner);
+	BenchSpriteAtlas(runner);
+	BenchTextureCache(runner);
+	BenchSceneRestart(runner);
+
+	if (config.outPath.empty()) {
+		runner.WriteJson(stdout);
+	} else {
+		std::FILE* file = std::fopen(config.outPath.c_str(), "w");
+		if (!file) {
+			std::fprintf(stderr, "cannot open %s\n", config.outPath.c_str());
+			return 1;
+		}
+		runner.WriteJson(file);
+		std::fclose(file);
+	}
+
+	return 0;
+}
@@ -0,0 +1,253 @@
+// ゴーストの記録（GhostRecording / GhostBoard）と再生（GhostRace）を、作った動きで確かめる
+// ・記録して読み直したサンプルが、量子化した元の値と一致するか（向きの反転・フラグの切り替えを含む）
+// ・再生した位置が、記録したフレームでは元の位置、間のフレームでは前後の中点になるか。巻き戻しても同じか
+// ・一覧が速い順に並び、同じタイムは先に出したものが上で、kCapacity 件を超えたら遅いものが落ちるか
+// ・保存して読み直すと同じか。別のマップ・壊れたファイル・無いファイルは空で読むか
+//
+// ビルド（Linux, リポジトリ直下で。描画はヘッドレス版エンジンで何もしない）:
+//   g++ -std=c++20 -O2 -pthread -I. -ITools/Headless Tools/GhostRecordingTest/main.cpp Tools/Headless/HeadlessEngine.cpp
+//       $(ls *.cpp | grep -v -E '^(main|SceneManager|TitleScene|TutorialScene|MakeAffineMatrix)\.cpp$') -o ghostRecordingTest
+// 実行:
+//   ./ghostRecordingTest
+// 全て期待どおりなら 0、そうでなければ 1 を返す
+#define NOMINMAX
+#include "GhostRace.h"
+#include "GhostRecording.h"
+#include "Tools/Common/TestCheck.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+#include <string>
+#include <vector>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 作る走りのフレーム数
+const uint32_t kRunFrames = 600;
+
+/// <summary>
+/// 作った動きの1フレーム（右へ走り、一定の間隔で跳び、途中で振り返る）
+/// </summary>
+WorldTransform MakeFrame(uint32_t frame, uint32_t variation) {
+	WorldTransform worldTransform;
+	float t = static_cast<float>(frame);
+	uint32_t jumpPeriod = 40 + variation * 4;
+	float jumpT = static_cast<float>(frame % jumpPeriod);
+	worldTransform.translation_ = {2.0f + t * 0.15f, 3.0f + std::max(0.0f, jumpT * (0.4f - 0.02f * jumpT)), -0.5f};
+	worldTransform.rotation_.y = frame < kRunFrames / 2 ? std::numbers::pi_v<float> * 0.5f : -std::numbers::pi_v<float> * 0.5f;
+	return worldTransform;
+}
+
+uint8_t MakeFlags(uint32_t frame) { return frame % 90 < 12 ? GhostRecording::kFlagAttackEffect : 0; }
+
+/// <summary>
+/// 作った動きを記録する（ゴールは frames フレーム目）
+/// </summary>
+GhostRecording MakeRecording(uint32_t frames, uint32_t variation) {
+	GhostRecording recording;
+	recording.Begin();
+	for (uint32_t frame = 0; frame < frames; ++frame) {
+		recording.Record(MakeFrame(frame, variation), MakeFlags(frame));
+	}
+	recording.Finish();
+	return recording;
+}
+
+int32_t Quantize(float value) { return static_cast<int32_t>(std::lround(value * GhostRecording::kPositionScale)); }
+
+/// <summary>
+/// 記録して読み直す
+/// </summary>
+void TestRecordAndRead() {
+	GhostRecording recording = MakeRecording(kRunFrames, 0);
+	CHECK(recording.IsFinished() && recording.GetClearFrame() == kRunFrames);
+	CHECK(recording.GetSampleCount() == kRunFrames / GhostRecording::kSampleInterval);
+	CHECK(recording.GetZ() == -0.5f);
+	CHECK(recording.Validate());
+	// 予測との差なので、1サンプルは数バイトに収まる
+	CHECK(recording.GetBytes().size() < static_cast<size_t>(recording.GetSampleCount()) * 4);
+
+	GhostRecording::Reader reader;
+	reader.Begin(recording);
+	uint32_t mismatches = 0;
+	for (uint32_t frame = 0; frame < kRunFrames; frame += GhostRecording::kSampleInterval) {
+		GhostRecording::Sample sample;
+		if (!reader.Next(sample)) {
+			++mismatches;
+			break;
+		}
+		WorldTransform expected = MakeFrame(frame, 0);
+		float rotationY = GhostRecording::ToRotation(sample.rotationY);
+		if (sample.x != Quantize(expected.translation_.x) || sample.y != Quantize(expected.translation_.y) || sample.flags != MakeFlags(frame) ||
+		    std::abs(rotationY - expected.rotation_.y) > 2.0f * std::numbers::pi_v<float> / GhostRecording::kRotationSteps) {
+			++mismatches;
+		}
+	}
+	CHECK(mismatches == 0);
+	CHECK(reader.IsEnd() && reader.GetOffset() == recording.GetBytes().size());
+
+	// ゴールしていない・空の記録
+	GhostRecording empty;
+	empty.Begin();
+	CHECK(!empty.Validate() && !empty.IsFinished());
+}
+
+/// <summary>
+/// 再生
+/// </summary>
+void TestRace() {
+	std::vector<GhostRecording> recordings = {MakeRecording(kRunFrames, 0), MakeRecording(kRunFrames / 2, 1)};
+	GhostRace race;
+	race.Initialize(recordings);
+	CHECK(race.GetCount() == 2);
+
+	// 記録したフレームは元の位置（量子化の分だけずれる）、間のフレームは前後の中点
+	const float quantizationError = 0.5f / GhostRecording::kPositionScale + 1.0e-4f;
+	float maxSampleError = 0.0f;
+	float maxMidpointError = 0.0f;
+	auto check = [&](uint32_t frame) {
+		race.Update(frame);
+		const Matrix4x4& matWorld = race.GetMatrices()[0];
+		if (frame % GhostRecording::kSampleInterval == 0) {
+			WorldTransform expected = MakeFrame(frame, 0);
+			maxSampleError = std::max({maxSampleError, std::abs(matWorld.m[3][0] - expected.translation_.x), std::abs(matWorld.m[3][1] - expected.translation_.y)});
+		} else {
+			WorldTransform before = MakeFrame(frame - 1, 0);
+			WorldTransform after = MakeFrame(frame + 1, 0);
+			float x = (before.translation_.x + after.translation_.x) * 0.5f;
+			float y = (before.translation_.y + after.translation_.y) * 0.5f;
+			maxMidpointError = std::max({maxMidpointError, std::abs(matWorld.m[3][0] - x), std::abs(matWorld.m[3][1] - y)});
+		}
+	};
+	for (uint32_t frame = 0; frame + 1 < kRunFrames; ++frame) {
+		check(frame);
+	}
+	CHECK(maxSampleError <= quantizationError);
+	CHECK(maxMidpointError <= quantizationError);
+	CHECK(race.GetMatrices()[0].m[3][2] == -0.5f);
+
+	// 巻き戻して飛び飛びに進めても同じ
+	maxSampleError = 0.0f;
+	maxMidpointError = 0.0f;
+	for (uint32_t frame : {101u, 7u, 350u, 351u, 0u, 598u, 33u}) {
+		check(frame);
+	}
+	CHECK(maxSampleError <= quantizationError);
+	CHECK(maxMidpointError <= quantizationError);
+
+	// 短い方はゴール後、最後のサンプルで止まる
+	race.Update(kRunFrames / 2 + 100);
+	Vector3 stopped = {race.GetMatrices()[1].m[3][0], race.GetMatrices()[1].m[3][1], 0.0f};
+	race.Update(kRunFrames / 2 + 200);
+	CHECK(race.GetMatrices()[1].m[3][0] == stopped.x && race.GetMatrices()[1].m[3][1] == stopped.y);
+	WorldTransform last = MakeFrame(kRunFrames / 2 - GhostRecording::kSampleInterval, 1);
+	CHECK(std::abs(stopped.x - last.translation_.x) <= quantizationError && std::abs(stopped.y - last.translation_.y) <= quantizationError);
+}
+
+/// <summary>
+/// 一覧の並び
+/// </summary>
+void TestBoardOrder() {
+	GhostBoard board;
+	board.Load("", 1);
+	CHECK(board.GetEntries().empty() && board.GetMapKey() == 1);
+
+	GhostRecording unfinished;
+	unfinished.Begin();
+	unfinished.Record(MakeFrame(0, 0), 0);
+	CHECK(board.Submit(unfinished) == -1);
+
+	CHECK(board.Submit(MakeRecording(300, 0)) == 0);
+	CHECK(board.Submit(MakeRecording(200, 1)) == 0);
+	CHECK(board.Submit(MakeRecording(400, 2)) == 2);
+	// 同じタイムなら先に出したものが上
+	GhostRecording tie = MakeRecording(300, 3);
+	CHECK(board.Submit(tie) == 2);
+	if (CHECK(board.GetEntries().size() == 4)) {
+		CHECK(board.GetEntries()[0].GetClearFrame() == 200 && board.GetEntries()[1].GetClearFrame() == 300 && board.GetEntries()[3].GetClearFrame() == 400);
+		CHECK(board.GetEntries()[2].GetBytes() == tie.GetBytes());
+		// 記録中の余分な容量は持ち込まない
+		CHECK(board.GetEntries()[2].GetBytes().capacity() < GhostRecording::kReserveBytes);
+	}
+
+	// 満杯になったら遅いものが落ちる
+	GhostBoard full;
+	full.Load("", 1);
+	for (uint32_t i = 0; i < GhostBoard::kCapacity; ++i) {
+		full.Submit(MakeRecording(100 + i, 0));
+	}
+	CHECK(full.GetEntries().size() == GhostBoard::kCapacity);
+	CHECK(full.Submit(MakeRecording(100 + GhostBoard::kCapacity, 0)) == -1);
+	CHECK(full.Submit(MakeRecording(50, 0)) == 0);
+	CHECK(full.GetEntries().size() == GhostBoard::kCapacity);
+	CHECK(full.GetEntries().front().GetClearFrame() == 50 && full.GetEntries().back().GetClearFrame() == 100 + GhostBoard::kCapacity - 2);
+}
+
+/// <summary>
+/// 保存と読み込み
+/// </summary>
+void TestBoardFile() {
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "ghostRecordingTest";
+	std::filesystem::create_directories(directory);
+	const std::string path = (directory / "ghosts.bin").string();
+	const uint64_t mapKey = 0x123456789ABCDEF0ull;
+
+	GhostBoard board;
+	board.Load("", mapKey);
+	for (uint32_t i = 0; i < 16; ++i) {
+		board.Submit(MakeRecording(kRunFrames - i * 7, i));
+	}
+	CHECK(board.Save(path));
+	CHECK(!std::filesystem::exists(path + ".tmp"));
+
+	GhostBoard loaded;
+	if (CHECK(loaded.Load(path, mapKey)) && CHECK(loaded.GetEntries().size() == board.GetEntries().size())) {
+		uint32_t mismatches = 0;
+		for (size_t i = 0; i < board.GetEntries().size(); ++i) {
+			const GhostRecording& a = board.GetEntries()[i];
+			const GhostRecording& b = loaded.GetEntries()[i];
+			mismatches += a.GetBytes() != b.GetBytes() || a.GetSampleCount() != b.GetSampleCount() || a.GetClearFrame() != b.GetClearFrame() || a.GetZ() != b.GetZ();
+		}
+		CHECK(mismatches == 0);
+	}
+
+	// 別のマップの記録は読まない
+	CHECK(!loaded.Load(path, mapKey + 1));
+	CHECK(loaded.GetEntries().empty() && loaded.GetMapKey() == mapKey + 1);
+
+	// 途中で切れたファイル
+	std::string truncatedPath = (directory / "truncated.bin").string();
+	std::filesystem::copy_file(path, truncatedPath, std::filesystem::copy_options::overwrite_existing);
+	std::filesystem::resize_file(truncatedPath, std::filesystem::file_size(path) - 3);
+	CHECK(!loaded.Load(truncatedPath, mapKey));
+	CHECK(loaded.GetEntries().empty());
+
+	// 先頭が違うファイル
+	std::string brokenPath = (directory / "broken.bin").string();
+	std::ofstream(brokenPath, std::ios::binary) << "not a ghost board file";
+	CHECK(!loaded.Load(brokenPath, mapKey));
+
+	// 無いファイル
+	CHECK(!loaded.Load((directory / "missing.bin").string(), mapKey));
+	CHECK(loaded.GetEntries().empty());
+
+	std::error_code errorCode;
+	std::filesystem::remove_all(directory, errorCode);
+}
+
+} // namespace
+
+int main() {
+	TestRecordAndRead();
+	TestRace();
+	TestBoardOrder();
+	TestBoardFile();
+	return TestCheck::Finish();
+}
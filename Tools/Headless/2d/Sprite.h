@@ -0,0 +1,51 @@
+#pragma once
+#include "../math/MathUtility.h"
+#include <cstdint>
+#include <string>
+
+namespace KamataEngine {
+
+/// <summary>
+/// スプライト（描画しない）
+/// </summary>
+class Sprite {
+public:
+	static Sprite* Create(uint32_t textureHandle, Vector2 position, Vector4 color = {1, 1, 1, 1}, Vector2 anchorpoint = {0.0f, 0.0f}, bool isFlipX = false, bool isFlipY = false);
+	static void PreDraw(void* commandList = nullptr) { (void)commandList; }
+	static void PostDraw() {}
+
+	void Draw() {}
+	void SetSize(const Vector2& size) { size_ = size; }
+	void SetColor(const Vector4& color) { color_ = color; }
+	void SetPosition(const Vector2& position) { position_ = position; }
+	void SetTextureRect(const Vector2& leftTop, const Vector2& size) {
+		texLeftTop_ = leftTop;
+		texSize_ = size;
+	}
+	void SetTextureHandle(uint32_t textureHandle) { textureHandle_ = textureHandle; }
+	const Vector2& GetSize() const { return size_; }
+	const Vector2& GetPosition() const { return position_; }
+	const Vector2& GetAnchorPoint() const { return anchorPoint_; }
+	const Vector2& GetTextureLeftTop() const { return texLeftTop_; }
+	const Vector2& GetTextureSize() const { return texSize_; }
+	uint32_t GetTextureHandle() const { return textureHandle_; }
+
+private:
+	uint32_t textureHandle_ = 0;
+	Vector2 position_ = {};
+	Vector2 anchorPoint_ = {};
+	Vector2 size_ = {100.0f, 100.0f};
+	Vector2 texLeftTop_ = {};
+	Vector2 texSize_ = {};
+	Vector4 color_ = {1, 1, 1, 1};
+};
+
+/// <summary>
+/// テクスチャ（パスごとに番号を振るだけ）
+/// </summary>
+class TextureManager {
+public:
+	static uint32_t Load(const std::string& fileName);
+};
+
+} // namespace KamataEngine
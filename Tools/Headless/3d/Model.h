@@ -0,0 +1,26 @@
+#pragma once
+#include "WorldTransform.h"
+#include <string>
+
+namespace KamataEngine {
+
+/// <summary>
+/// モデル（描画しない。読み込み回数だけ数える）
+/// </summary>
+class Model {
+public:
+	static Model* CreateFromOBJ(const std::string& modelName, bool smoothing = false);
+	static void PreDraw() {}
+	static void PostDraw() {}
+
+	void Draw(const WorldTransform&, const Camera&, const ObjectColor* = nullptr) {}
+	void SetAlpha(float alpha) { alpha_ = alpha; }
+
+	// 作った数
+	static inline uint32_t createdCount = 0;
+
+private:
+	float alpha_ = 1.0f;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,46 @@
+#pragma once
+#include "../math/MathUtility.h"
+
+namespace KamataEngine {
+
+/// <summary>
+/// ワールド変換（GPUの定数バッファを持たない）
+/// </summary>
+class WorldTransform {
+public:
+	Vector3 scale_ = {1, 1, 1};
+	Vector3 rotation_ = {};
+	Vector3 translation_ = {};
+	Matrix4x4 matWorld_ = {};
+	const WorldTransform* parent_ = nullptr;
+
+	void Initialize();
+	void TransferMatrix() {}
+};
+
+/// <summary>
+/// カメラ（GPUの定数バッファを持たない）
+/// </summary>
+class Camera {
+public:
+	Vector3 rotation_ = {};
+	Vector3 translation_ = {0, 0, -50};
+	float farZ = 1000.0f;
+	Matrix4x4 matView = {};
+	Matrix4x4 matProjection = {};
+
+	void Initialize();
+	void UpdateMatrix();
+	void TransferMatrix() {}
+};
+
+class ObjectColor {
+public:
+	void Initialize() {}
+	void SetColor(const Vector4& color) { color_ = color; }
+
+private:
+	Vector4 color_ = {1, 1, 1, 1};
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,198 @@
+// KamataEngine.h（ヘッドレス版）の実体
+#include "KamataEngine.h"
+
+#include <cmath>
+#include <numbers>
+#include <unordered_map>
+
+namespace KamataEngine {
+
+///====================================================
+/// 数学
+///====================================================
+
+Vector3& Vector3::operator+=(const Vector3& other) {
+	x += other.x;
+	y += other.y;
+	z += other.z;
+	return *this;
+}
+
+Vector3& Vector3::operator-=(const Vector3& other) {
+	x -= other.x;
+	y -= other.y;
+	z -= other.z;
+	return *this;
+}
+
+Vector3 operator+(const Vector3& a, const Vector3& b) { return {a.x + b.x, a.y + b.y, a.z + b.z}; }
+Vector3 operator-(const Vector3& a, const Vector3& b) { return {a.x - b.x, a.y - b.y, a.z - b.z}; }
+Vector3 operator-(const Vector3& v) { return {-v.x, -v.y, -v.z}; }
+Vector3 operator*(const Vector3& v, float s) { return {v.x * s, v.y * s, v.z * s}; }
+Vector3 operator*(float s, const Vector3& v) { return v * s; }
+Vector3 operator/(const Vector3& v, float s) { return {v.x / s, v.y / s, v.z / s}; }
+
+Matrix4x4 operator*(const Matrix4x4& a, const Matrix4x4& b) {
+	Matrix4x4 result = {};
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			for (int k = 0; k < 4; ++k) {
+				result.m[row][column] += a.m[row][k] * b.m[k][column];
+			}
+		}
+	}
+	return result;
+}
+
+namespace MathUtility {
+
+Matrix4x4 MakeScaleMatrix(const Vector3& scale) {
+	Matrix4x4 result = {};
+	result.m[0][0] = scale.x;
+	result.m[1][1] = scale.y;
+	result.m[2][2] = scale.z;
+	result.m[3][3] = 1.0f;
+	return result;
+}
+
+Matrix4x4 MakeRotateXMatrix(float radian) {
+	Matrix4x4 result = MakeScaleMatrix({1, 1, 1});
+	result.m[1][1] = std::cos(radian);
+	result.m[1][2] = std::sin(radian);
+	result.m[2][1] = -std::sin(radian);
+	result.m[2][2] = std::cos(radian);
+	return result;
+}
+
+Matrix4x4 MakeRotateYMatrix(float radian) {
+	Matrix4x4 result = MakeScaleMatrix({1, 1, 1});
+	result.m[0][0] = std::cos(radian);
+	result.m[0][2] = -std::sin(radian);
+	result.m[2][0] = std::sin(radian);
+	result.m[2][2] = std::cos(radian);
+	return result;
+}
+
+Matrix4x4 MakeRotateZMatrix(float radian) {
+	Matrix4x4 result = MakeScaleMatrix({1, 1, 1});
+	result.m[0][0] = std::cos(radian);
+	result.m[0][1] = std::sin(radian);
+	result.m[1][0] = -std::sin(radian);
+	result.m[1][1] = std::cos(radian);
+	return result;
+}
+
+Matrix4x4 MakeTranslateMatrix(const Vector3& translate) {
+	Matrix4x4 result = MakeScaleMatrix({1, 1, 1});
+	result.m[3][0] = translate.x;
+	result.m[3][1] = translate.y;
+	result.m[3][2] = translate.z;
+	return result;
+}
+
+Vector3 Transform(const Vector3& v, const Matrix4x4& m) {
+	Vector3 result = {
+	    v.x * m.m[0][0] + v.y * m.m[1][0] + v.z * m.m[2][0] + m.m[3][0],
+	    v.x * m.m[0][1] + v.y * m.m[1][1] + v.z * m.m[2][1] + m.m[3][1],
+	    v.x * m.m[0][2] + v.y * m.m[1][2] + v.z * m.m[2][2] + m.m[3][2],
+	};
+	float w = v.x * m.m[0][3] + v.y * m.m[1][3] + v.z * m.m[2][3] + m.m[3][3];
+	return w != 0.0f ? result / w : result;
+}
+
+float Length(const Vector3& v) { return std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z); }
+
+Vector3 Normalize(const Vector3& v) {
+	float length = Length(v);
+	return length != 0.0f ? v / length : v;
+}
+
+} // namespace MathUtility
+
+///====================================================
+/// 3D
+///====================================================
+
+void WorldTransform::Initialize() { matWorld_ = MathUtility::MakeScaleMatrix({1, 1, 1}); }
+
+void Camera::Initialize() { UpdateMatrix(); }
+
+void Camera::UpdateMatrix() {
+	// ビュー = (回転 → 平行移動) の逆
+	Matrix4x4 rotate = MathUtility::MakeRotateZMatrix(rotation_.z) * MathUtility::MakeRotateXMatrix(rotation_.x) * MathUtility::MakeRotateYMatrix(rotation_.y);
+	Matrix4x4 inverseRotate = {};
+	for (int row = 0; row < 4; ++row) {
+		for (int column = 0; column < 4; ++column) {
+			inverseRotate.m[row][column] = rotate.m[column][row];
+		}
+	}
+	matView = MathUtility::MakeTranslateMatrix(-translation_) * inverseRotate;
+
+	// 透視投影（画角45度、16:9）
+	const float kNearZ = 0.1f;
+	const float kAspect = 1280.0f / 720.0f;
+	float cot = 1.0f / std::tan(std::numbers::pi_v<float> / 8.0f);
+	matProjection = {};
+	matProjection.m[0][0] = cot / kAspect;
+	matProjection.m[1][1] = cot;
+	matProjection.m[2][2] = farZ / (farZ - kNearZ);
+	matProjection.m[2][3] = 1.0f;
+	matProjection.m[3][2] = -kNearZ * farZ / (farZ - kNearZ);
+}
+
+Model* Model::CreateFromOBJ(const std::string&, bool) {
+	++createdCount;
+	return new Model();
+}
+
+///====================================================
+/// 2D
+///====================================================
+
+Sprite* Sprite::Create(uint32_t textureHandle, Vector2 position, Vector4 color, Vector2 anchorpoint, bool, bool) {
+	Sprite* sprite = new Sprite();
+	sprite->textureHandle_ = textureHandle;
+	sprite->position_ = position;
+	sprite->anchorPoint_ = anchorpoint;
+	sprite->color_ = color;
+	return sprite;
+}
+
+uint32_t TextureManager::Load(const std::string& fileName) {
+	// 実機と同じく、同じパスには同じ番号を返す
+	static std::unordered_map<std::string, uint32_t> handles;
+	auto it = handles.try_emplace(fileName, static_cast<uint32_t>(handles.size() + 1)).first;
+	return it->second;
+}
+
+///====================================================
+/// その他
+///====================================================
+
+Input* Input::GetInstance() {
+	static Input instance;
+	return &instance;
+}
+
+DebugCamera::DebugCamera(int, int) { camera_.Initialize(); }
+
+AxisIndicator* AxisIndicator::GetInstance() {
+	static AxisIndicator instance;
+	return &instance;
+}
+
+DirectXCommon* DirectXCommon::GetInstance() {
+	static DirectXCommon instance;
+	return &instance;
+}
+
+void Initialize(const wchar_t*) {}
+
+bool Update() {
+	Input::GetInstance()->Update();
+	return false;
+}
+
+void Finalize() {}
+
+} // namespace KamataEngine
@@ -0,0 +1,105 @@
+#pragma once
+// KamataEngine のうち、このリポジトリが使う部分だけを GPU・ウィンドウ無しで用意したもの。
+// Linux でゲームロジックをビルドして計測・検証するためのもので、描画は何もしない。
+#include "2d/Sprite.h"
+#include "3d/Model.h"
+#include "3d/WorldTransform.h"
+#include "math/MathUtility.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <list>
+#include <string>
+#include <vector>
+
+enum {
+	DIK_ESCAPE = 0x01,
+	DIK_1 = 0x02,
+	DIK_2 = 0x03,
+	DIK_W = 0x11,
+	DIK_E = 0x12,
+	DIK_R = 0x13,
+	DIK_T = 0x14,
+	DIK_RETURN = 0x1C,
+	DIK_A = 0x1E,
+	DIK_S = 0x1F,
+	DIK_D = 0x20,
+	DIK_F = 0x21,
+	DIK_G = 0x22,
+	DIK_J = 0x24,
+	DIK_LSHIFT = 0x2A,
+	DIK_Z = 0x2C,
+	DIK_X = 0x2D,
+	DIK_SPACE = 0x39,
+	DIK_F8 = 0x42,
+	DIK_F9 = 0x43,
+	DIK_F10 = 0x44,
+	DIK_F11 = 0x57,
+	DIK_UP = 0xC8,
+	DIK_LEFT = 0xCB,
+	DIK_RIGHT = 0xCD,
+	DIK_DOWN = 0xD0,
+};
+
+namespace KamataEngine {
+
+/// <summary>
+/// キー入力（SetKey で押下状態を与え、Update でフレームを進める）
+/// </summary>
+class Input {
+public:
+	static Input* GetInstance();
+
+	bool PushKey(int key) const { return keys_[key & 0xFF]; }
+	bool TriggerKey(int key) const { return keys_[key & 0xFF] && !previousKeys_[key & 0xFF]; }
+
+	// ヘッドレス専用
+	void SetKey(int key, bool isPressed) { keys_[key & 0xFF] = isPressed; }
+	void Update() { previousKeys_ = keys_; }
+	void Clear() {
+		keys_.fill(false);
+		previousKeys_.fill(false);
+	}
+
+private:
+	std::array<bool, 256> keys_ = {};
+	std::array<bool, 256> previousKeys_ = {};
+};
+
+class DebugCamera {
+public:
+	DebugCamera(int width, int height);
+	void SetFarZ(float farZ) { camera_.farZ = farZ; }
+	void Update() {}
+	const Camera& GetCamera() { return camera_; }
+
+private:
+	Camera camera_;
+};
+
+class AxisIndicator {
+public:
+	static AxisIndicator* GetInstance();
+	void SetVisible(bool isVisible) { isVisible_ = isVisible; }
+	void SetTargetCamera(const Camera* camera) { camera_ = camera; }
+	void Draw() {}
+
+private:
+	bool isVisible_ = false;
+	const Camera* camera_ = nullptr;
+};
+
+class DirectXCommon {
+public:
+	static DirectXCommon* GetInstance();
+	void PreDraw() {}
+	void PostDraw() {}
+	void* GetCommandList() { return nullptr; }
+};
+
+void Initialize(const wchar_t* title);
+bool Update();
+void Finalize();
+
+} // namespace KamataEngine
@@ -0,0 +1,30 @@
+#pragma once
+#include "Matrix4x4.h"
+#include "Vector2.h"
+#include "Vector3.h"
+#include "Vector4.h"
+
+namespace KamataEngine {
+
+Vector3 operator+(const Vector3& a, const Vector3& b);
+Vector3 operator-(const Vector3& a, const Vector3& b);
+Vector3 operator-(const Vector3& v);
+Vector3 operator*(const Vector3& v, float s);
+Vector3 operator*(float s, const Vector3& v);
+Vector3 operator/(const Vector3& v, float s);
+Matrix4x4 operator*(const Matrix4x4& a, const Matrix4x4& b);
+
+namespace MathUtility {
+
+Matrix4x4 MakeScaleMatrix(const Vector3& scale);
+Matrix4x4 MakeRotateXMatrix(float radian);
+Matrix4x4 MakeRotateYMatrix(float radian);
+Matrix4x4 MakeRotateZMatrix(float radian);
+Matrix4x4 MakeTranslateMatrix(const Vector3& translate);
+Vector3 Transform(const Vector3& v, const Matrix4x4& m);
+float Length(const Vector3& v);
+Vector3 Normalize(const Vector3& v);
+
+} // namespace MathUtility
+
+} // namespace KamataEngine
@@ -0,0 +1,9 @@
+#pragma once
+
+namespace KamataEngine {
+
+struct Matrix4x4 {
+	float m[4][4];
+};
+
+} // namespace KamataEngine
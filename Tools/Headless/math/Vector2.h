@@ -0,0 +1,10 @@
+#pragma once
+
+namespace KamataEngine {
+
+struct Vector2 {
+	float x;
+	float y;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstdint>
+
+namespace KamataEngine {
+
+struct Vector3 {
+	float x;
+	float y;
+	float z;
+
+	Vector3& operator+=(const Vector3& other);
+	Vector3& operator-=(const Vector3& other);
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,12 @@
+#pragma once
+
+namespace KamataEngine {
+
+struct Vector4 {
+	float x;
+	float y;
+	float z;
+	float w;
+};
+
+} // namespace KamataEngine
@@ -0,0 +1,320 @@
+// 2人対戦の同期（LockstepSession）を、1台の中でループバックの UDP を使って検証する
+// 2つのセッションを交互に1フレームずつ進め、遅延・揺れ・損失を加えた条件ごとに
+// 同期ずれが起きないこと（最後の状態が両者と、確定した入力だけで最初から回し直したものの3つで一致すること）と、
+// 帯域・1フレームの CPU 時間（巻き戻しのやり直しを含む）を出す。わざと地形を変えた相手で、ずれを検出できることも確かめる
+//
+// ビルド（Linux, リポジトリ直下で。描画はヘッドレス版エンジンで何もしない）:
+//   g++ -std=c++20 -O2 -pthread -I. -ITools/Headless Tools/LockstepTest/main.cpp Tools/Headless/HeadlessEngine.cpp
+//       $(ls *.cpp | grep -v -E '^(main|SceneManager|TitleScene|TutorialScene|MakeAffineMatrix)\.cpp$') -o lockstepTest
+// 実行（Resources/blocks.csv を読むのでリポジトリ直下で）:
+//   ./lockstepTest [--frames フレーム数] [--seed シード]
+// 全ての条件で期待どおりなら 0、そうでなければ 1 を返す
+#include "LockstepSession.h"
+#include "MapChipField.h"
+#include "Random.h"
+#include "VersusSimulation.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 1フレームの時間（ミリ秒）
+const double kFrameMs = 1000.0 / 60.0;
+// 最後に入力を揃えるために回す最大フレーム数
+const uint32_t kDrainFrames = 600;
+
+// 検証する条件
+struct Scenario {
+	const char* name;
+	double latencyMs;    // 片道
+	double jitterMs;
+	float lossRate;
+	uint32_t inputDelay;
+	uint32_t maxRollback;
+	uint32_t startOffset;  // 2P が遅れて始めるフレーム数
+	bool isCorrupted;      // 2P だけ地形を変える（同期ずれが検出されるべき）
+};
+
+// 1つの条件の結果
+struct Report {
+	bool isPassed = false;
+	uint32_t frame = 0;
+	LockstepSession::Stats stats[VersusSimulation::kPlayerCount];
+	double p50Ms = 0.0;
+	double p99Ms = 0.0;
+	std::string message;
+};
+
+/// <summary>
+/// 人が遊んでいるような入力を出す（押しっぱなしの時間が長く、ときどきジャンプ・攻撃）
+/// </summary>
+class Bot {
+private:
+	Random::Stream random_;
+	PlayerInput held_;
+	uint32_t holdFrames_ = 0;
+
+public:
+	Bot(uint64_t seed, uint32_t player) : random_(seed, 100 + player) {}
+
+	PlayerInput Next() {
+		if (holdFrames_ == 0) {
+			uint32_t roll = random_.NextUint32(100);
+			held_.buttons = roll < 65 ? PlayerInput::kRight : (roll < 80 ? PlayerInput::kLeft : 0);
+			holdFrames_ = 10 + random_.NextUint32(40);
+		}
+		--holdFrames_;
+
+		PlayerInput input = held_;
+		uint32_t roll = random_.NextUint32(100);
+		if (roll < 6) {
+			input.buttons |= PlayerInput::kJump;
+		} else if (roll < 8) {
+			input.buttons |= PlayerInput::kAttack;
+		}
+		return input;
+	}
+};
+
+/// <summary>
+/// 状態のハッシュ
+/// </summary>
+uint64_t HashOf(const VersusSimulation& simulation) {
+	SimulationSnapshot snapshot;
+	simulation.SaveState(snapshot);
+	return snapshot.ComputeHash();
+}
+
+/// <summary>
+/// 開始位置の下の地面を抜いた地形を書く（2人とも最初のフレームから落ちるので、必ず結果が変わる）
+/// </summary>
+std::string WriteCorruptedField(const std::string& sourcePath) {
+	std::ifstream source(sourcePath);
+	std::vector<std::string> lines;
+	for (std::string line; std::getline(source, line);) {
+		lines.push_back(line);
+	}
+	// 16行目（0始まり）の 1〜6列目を空白に
+	if (lines.size() > 16) {
+		for (size_t column = 1; column <= 6; ++column) {
+			lines[16][column * 2] = '0';
+		}
+	}
+
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "lockstep_corrupted.csv";
+	std::ofstream file(path);
+	for (const std::string& line : lines) {
+		file << line << "\n";
+	}
+	return path.string();
+}
+
+/// <summary>
+/// 確定した入力を記録に足す
+/// </summary>
+void AppendConfirmed(const LockstepSession& session, std::vector<VersusSimulation::Inputs>& log) {
+	while (log.size() < session.GetConfirmedFrameCount()) {
+		log.push_back(session.GetConfirmedInputs(static_cast<uint32_t>(log.size())));
+	}
+}
+
+/// <summary>
+/// 1つの条件を回す
+/// </summary>
+Report Run(const Scenario& scenario, uint32_t frames, uint64_t seed, Model* model) {
+	Report report;
+
+	const std::string fieldPath = "Resources/blocks.csv";
+	MapChipField fields[VersusSimulation::kPlayerCount];
+	fields[0].LoadMapChipCsv(fieldPath);
+	fields[1].LoadMapChipCsv(scenario.isCorrupted ? WriteCorruptedField(fieldPath) : fieldPath);
+
+	Camera camera;
+	camera.Initialize();
+
+	VersusSimulation simulations[VersusSimulation::kPlayerCount];
+	LockstepSession sessions[VersusSimulation::kPlayerCount];
+	for (uint32_t i = 0; i < VersusSimulation::kPlayerCount; ++i) {
+		simulations[i].Initialize(&fields[i], model, model, &camera);
+
+		LockstepSession::Config config;
+		config.localPlayer = i;
+		config.inputDelay = scenario.inputDelay;
+		config.maxRollback = scenario.maxRollback;
+		if (!sessions[i].Initialize(&simulations[i], config)) {
+			report.message = "cannot open socket";
+			return report;
+		}
+	}
+	for (uint32_t i = 0; i < VersusSimulation::kPlayerCount; ++i) {
+		sessions[i].SetPeer(UdpSocket::Address::Loopback(sessions[1 - i].GetLocalPort()));
+
+		LockstepSession::Conditions conditions;
+		conditions.latencyMs = scenario.latencyMs;
+		conditions.jitterMs = scenario.jitterMs;
+		conditions.lossRate = scenario.lossRate;
+		conditions.seed = seed;
+		sessions[i].SetConditions(conditions);
+	}
+
+	Bot bots[VersusSimulation::kPlayerCount] = {Bot(seed, 0), Bot(seed, 1)};
+	std::vector<VersusSimulation::Inputs> logs[VersusSimulation::kPlayerCount];
+	std::vector<double> updateMs;
+	updateMs.reserve(frames * 2);
+
+	// 時刻は実時間ではなくフレーム数から作る（遅延の再現だけに使うので、待たずに回せる）
+	uint32_t tick = 0;
+	for (; tick < frames; ++tick) {
+		double nowMs = tick * kFrameMs;
+		for (uint32_t i = 0; i < VersusSimulation::kPlayerCount; ++i) {
+			if (i == 1 && tick < scenario.startOffset) {
+				continue;
+			}
+			sessions[i].Update(bots[i].Next(), nowMs);
+			updateMs.push_back(sessions[i].GetStats().lastUpdateMs);
+			AppendConfirmed(sessions[i], logs[i]);
+		}
+	}
+
+	// 回線を元に戻して、先に進んでいる方のフレームに揃えて入力が揃うまで待つ（遅れている方だけ何も押さずに進める）
+	for (LockstepSession& session : sessions) {
+		session.SetConditions(LockstepSession::Conditions{});
+	}
+	const uint32_t targetFrame = std::max(sessions[0].GetFrame(), sessions[1].GetFrame());
+	for (uint32_t drain = 0; drain < kDrainFrames; ++drain, ++tick) {
+		if (sessions[0].GetFrame() == targetFrame && sessions[1].GetFrame() == targetFrame && sessions[0].IsStateConfirmed() && sessions[1].IsStateConfirmed()) {
+			break;
+		}
+		double nowMs = tick * kFrameMs;
+		for (uint32_t i = 0; i < VersusSimulation::kPlayerCount; ++i) {
+			if (sessions[i].GetFrame() < targetFrame) {
+				sessions[i].Update(PlayerInput{}, nowMs);
+			} else {
+				sessions[i].Poll(nowMs);
+			}
+			AppendConfirmed(sessions[i], logs[i]);
+		}
+	}
+
+	for (uint32_t i = 0; i < VersusSimulation::kPlayerCount; ++i) {
+		report.stats[i] = sessions[i].GetStats();
+	}
+	report.frame = sessions[0].GetFrame();
+
+	std::sort(updateMs.begin(), updateMs.end());
+	if (!updateMs.empty()) {
+		report.p50Ms = updateMs[updateMs.size() / 2];
+		report.p99Ms = updateMs[std::min(updateMs.size() - 1, updateMs.size() * 99 / 100)];
+	}
+
+	const bool isDesyncDetected = sessions[0].IsDesynced() || sessions[1].IsDesynced();
+	if (scenario.isCorrupted) {
+		report.isPassed = isDesyncDetected;
+		report.message = isDesyncDetected ? "desync detected at frame " + std::to_string(std::min(report.stats[0].desyncFrame, report.stats[1].desyncFrame)) : "desync NOT detected";
+		return report;
+	}
+
+	if (isDesyncDetected) {
+		report.message = "desync at frame " + std::to_string(std::min(report.stats[0].desyncFrame, report.stats[1].desyncFrame));
+		return report;
+	}
+	if (sessions[0].GetFrame() != sessions[1].GetFrame() || !sessions[0].IsStateConfirmed() || !sessions[1].IsStateConfirmed()) {
+		report.message = "inputs did not converge";
+		return report;
+	}
+	if (logs[0].size() < report.frame || logs[1].size() < report.frame || !std::equal(logs[0].begin(), logs[0].begin() + report.frame, logs[1].begin())) {
+		report.message = "confirmed inputs differ";
+		return report;
+	}
+
+	// 確定した入力だけで最初から回し直したものと比べる（巻き戻しで辿り着いた状態が、最初から正しい入力で進めた状態と同じか）
+	MapChipField referenceField;
+	referenceField.LoadMapChipCsv(fieldPath);
+	VersusSimulation reference;
+	reference.Initialize(&referenceField, model, model, &camera);
+	for (uint32_t frame = 0; frame < report.frame; ++frame) {
+		reference.Step(logs[0][frame]);
+	}
+
+	const uint64_t hashes[] = {HashOf(simulations[0]), HashOf(simulations[1]), HashOf(reference)};
+	if (hashes[0] != hashes[1] || hashes[0] != hashes[2]) {
+		report.message = "final state differs";
+		return report;
+	}
+	if (report.stats[0].hashesCompared == 0 || report.stats[1].hashesCompared == 0) {
+		report.message = "no hashes compared";
+		return report;
+	}
+
+	report.isPassed = true;
+	report.message = "ok";
+	return report;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	uint32_t frames = 1800;
+	uint64_t seed = 1;
+	for (int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+		if (argument == "--frames" && i + 1 < argc) {
+			frames = static_cast<uint32_t>(std::max(1, std::atoi(argv[++i])));
+		} else if (argument == "--seed" && i + 1 < argc) {
+			seed = std::strtoull(argv[++i], nullptr, 10);
+		} else {
+			std::fprintf(stderr, "usage: %s [--frames n] [--seed n]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	const Scenario scenarios[] = {
+	    {"lan",                0.0,   0.0,  0.00f, 2, 8,  0,  false},
+	    {"30ms",               30.0,  5.0,  0.00f, 2, 8,  0,  false},
+	    {"30ms 5% loss",       30.0,  5.0,  0.05f, 2, 8,  0,  false},
+	    {"80ms 10% loss",      80.0,  20.0, 0.10f, 3, 12, 0,  false},
+	    {"150ms 20% loss",     150.0, 30.0, 0.20f, 4, 20, 0,  false},
+	    {"30ms late start",    30.0,  5.0,  0.02f, 2, 8,  20, false},
+	    {"no delay 50ms",      50.0,  10.0, 0.05f, 0, 12, 0,  false},
+	    {"corrupted terrain",  30.0,  5.0,  0.05f, 2, 8,  0,  true},
+	};
+
+	std::unique_ptr<Model> model(Model::CreateFromOBJ("player"));
+
+	std::printf("%-18s %6s %6s %8s %7s %6s %6s %6s %8s %9s %9s %8s %8s %9s  %s\n", "scenario", "frames", "delay", "rollback", "resim", "depth", "stall", "sync", "dropped", "B/s", "B/s+hdr",
+	            "p50 us", "p99 us", "resim us", "result");
+
+	bool isAllPassed = true;
+	for (const Scenario& scenario : scenarios) {
+		Report report = Run(scenario, frames, seed, model.get());
+		isAllPassed = isAllPassed && report.isPassed;
+
+		// 2人分を合わせた値（帯域は片方向あたり）
+		const LockstepSession::Stats& a = report.stats[0];
+		const LockstepSession::Stats& b = report.stats[1];
+		double seconds = std::max(1.0, static_cast<double>(report.frame)) / 60.0;
+		double payloadPerSecond = static_cast<double>(a.bytesSent + b.bytesSent) / 2.0 / seconds;
+		double withHeaderPerSecond = payloadPerSecond + static_cast<double>(a.packetsSent + b.packetsSent) / 2.0 / seconds * UdpSocket::kHeaderBytes;
+		uint64_t resimulated = a.resimulatedFrames + b.resimulatedFrames;
+		double resimUs = resimulated > 0 ? (a.totalRollbackMs + b.totalRollbackMs) * 1000.0 / static_cast<double>(resimulated) : 0.0;
+
+		std::printf("%-18s %6u %6u %8llu %7llu %6u %6llu %6llu %8llu %9.0f %9.0f %8.2f %8.2f %9.2f  %s\n", scenario.name, report.frame, scenario.inputDelay,
+		            static_cast<unsigned long long>(a.rollbacks + b.rollbacks), static_cast<unsigned long long>(resimulated), std::max(a.maxRollbackDepth, b.maxRollbackDepth),
+		            static_cast<unsigned long long>(a.stalls + b.stalls), static_cast<unsigned long long>(a.timeSyncWaits + b.timeSyncWaits),
+		            static_cast<unsigned long long>(a.packetsDropped + b.packetsDropped), payloadPerSecond, withHeaderPerSecond, report.p50Ms * 1000.0, report.p99Ms * 1000.0, resimUs,
+		            report.message.c_str());
+	}
+
+	std::printf("%s\n", isAllPassed ? "ALL PASSED" : "FAILED");
+	return isAllPassed ? 0 : 1;
+}
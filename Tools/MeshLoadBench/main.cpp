@@ -0,0 +1,79 @@
+// GameScene が読み込むモデルを CPU 側だけで読み込み、アセットごとと合計の時間を出す
+//
+// ビルド（Linux, リポジトリ直下で）:
+//   g++ -std=c++20 -O2 -pthread -I. Tools/MeshLoadBench/main.cpp ObjMeshLoader.cpp FileUtility.cpp MappedFile.cpp Profiler.cpp -o meshLoadBench
+//   （-DENABLE_PROFILER を付けると区間計測が有効になる）
+// 実行:
+//   ./meshLoadBench [Resourcesのパス] [スレッド数] [トレースの出力先]
+#include "ObjMeshLoader.h"
+#include "Profiler.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+// GameScene::Initialize と同じ顔ぶれ
+const std::vector<std::string> kModelNames = {
+    "player", "attackEffect", "deathParticle", "enemy", "hitEffect", "block", "cloud", "goal", "fireworks", "skyDome",
+};
+
+/// <summary>
+/// 1回分の読み込みと結果の表示
+/// </summary>
+void Run(const char* label, const std::string& directory, const ObjMeshLoader::Options& options) {
+	std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+	std::vector<ObjMeshLoader::Result> results = ObjMeshLoader::LoadAll(directory, kModelNames, options);
+	double total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	std::printf("== %s (threads=%u)\n", label, options.threadCount);
+	for (const ObjMeshLoader::Result& result : results) {
+		std::printf("  %-14s %8.3f ms  %6zu verts %7zu indices  %s\n", result.name.c_str(), result.milliseconds, result.mesh.vertices.size(), result.mesh.indices.size(),
+		            !result.succeeded ? "FAILED" : (result.fromCache ? "cache" : "parsed"));
+	}
+	std::printf("  %-14s %8.3f ms\n", "total", total);
+}
+
+/// <summary>
+/// キャッシュを消す
+/// </summary>
+void RemoveCaches(const std::string& directory) {
+	for (const std::string& name : kModelNames) {
+		std::error_code errorCode;
+		std::filesystem::remove(directory + "/" + name + "/" + name + ObjMeshLoader::kCacheExtension, errorCode);
+	}
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	std::string directory = argc > 1 ? argv[1] : "Resources";
+	uint32_t threadCount = argc > 2 ? static_cast<uint32_t>(std::atoi(argv[2])) : 0;
+	std::string tracePath = argc > 3 ? argv[3] : "";
+
+	PROFILE_THREAD_NAME("main");
+
+	ObjMeshLoader::Options serial{false, 1};
+	ObjMeshLoader::Options parallel{false, threadCount};
+	ObjMeshLoader::Options cached{true, threadCount};
+
+	Run("parse, serial", directory, serial);
+	Run("parse, parallel", directory, parallel);
+
+	// 1回目でキャッシュを作り、2回目はマップして読む
+	RemoveCaches(directory);
+	Run("first launch (parse + write cache)", directory, cached);
+	Run("next launch (mapped cache)", directory, cached);
+
+#ifdef PROFILER_ENABLED
+	if (!tracePath.empty()) {
+		std::printf("trace: %s %s\n", tracePath.c_str(), Profiler::GetInstance()->WriteChromeTrace(tracePath) ? "written" : "FAILED");
+	}
+#endif
+
+	return 0;
+}
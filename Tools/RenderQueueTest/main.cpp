@@ -0,0 +1,172 @@
+// 描画キュー（RenderQueue）のソート・バッチ化を、何も描画しないバックエンド（NullRenderBackend）に流して確かめる
+// モデル・マテリアルが混ざったコマンドを積み、バッチ数・コマンド数・インスタンス数・状態の切り替え回数が
+// 期待どおりになるか、バッチに渡るコマンドの並びが正しいかを見る
+//
+// ビルド（Linux, リポジトリ直下で。エンジンは使わない）:
+//   g++ -std=c++20 -O2 -I. Tools/RenderQueueTest/main.cpp RenderQueue.cpp -o renderQueueTest
+// 実行:
+//   ./renderQueueTest
+// 全て期待どおりなら 0、そうでなければ 1 を返す
+#include "RenderQueue.h"
+#include "Tools/Common/TestCheck.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+/// <summary>
+/// 数えるのに加えて、受け取ったバッチとその先頭コマンドを残すバックエンド
+/// </summary>
+class RecordingBackend : public NullRenderBackend {
+public:
+	struct Record {
+		RenderBatch batch;
+		std::vector<RenderCommand> commands;
+	};
+	std::vector<Record> records;
+
+	void BeginFrame() override {
+		NullRenderBackend::BeginFrame();
+		records.clear();
+	}
+	void DrawBatch(const RenderBatch& batch, const RenderCommand* commands) override {
+		NullRenderBackend::DrawBatch(batch, commands);
+		records.push_back(Record{batch, std::vector<RenderCommand>(commands, commands + batch.commandCount)});
+	}
+};
+
+/// <summary>
+/// モデル・マテリアルが混ざった1フレーム
+/// </summary>
+void TestMixedFrame() {
+	RenderQueue queue;
+	RecordingBackend backend;
+
+	// わざとばらばらの順で積む
+	queue.Submit(2, 0, 5);
+	queue.Submit(1, 1, 3);
+	queue.Submit(1, 0, 0);
+	queue.SubmitInstanced(1, 0, 10, 4);
+	queue.SubmitInstanced(2, 1, 20, 0); // 空なので積まれない
+	queue.Submit(2, 1, 7);
+	queue.Submit(RenderCommand{1, 0, 1, 0}); // これも空
+	CHECK(queue.GetCommands().size() == 5);
+
+	queue.Flush(backend);
+
+	// (1,0) t0 + t10x4 / (1,1) t3 / (2,0) t5 / (2,1) t7
+	const NullRenderBackend::Stats& stats = backend.GetStats();
+	CHECK(stats.frames == 1);
+	CHECK(stats.batches == 4);
+	CHECK(stats.commands == 5);
+	CHECK(stats.instances == 8);
+	CHECK(stats.modelChanges == 2);
+	CHECK(stats.materialChanges == 4);
+
+	// バッチの中身（ソート済みの並びで渡っているか）
+	if (CHECK(backend.records.size() == 4)) {
+		const RecordingBackend::Record& first = backend.records[0];
+		CHECK(first.batch.modelId == 1 && first.batch.materialId == 0);
+		CHECK(first.batch.firstCommand == 0 && first.batch.commandCount == 2 && first.batch.instanceCount == 5);
+		CHECK(first.commands[0].transformIndex == 0 && first.commands[0].instanceCount == 1);
+		CHECK(first.commands[1].transformIndex == 10 && first.commands[1].instanceCount == 4);
+
+		const RecordingBackend::Record& second = backend.records[1];
+		CHECK(second.batch.modelId == 1 && second.batch.materialId == 1 && second.batch.firstCommand == 2);
+		CHECK(second.commands[0].transformIndex == 3);
+
+		const RecordingBackend::Record& third = backend.records[2];
+		CHECK(third.batch.modelId == 2 && third.batch.materialId == 0 && third.batch.firstCommand == 3);
+		CHECK(third.commands[0].transformIndex == 5);
+
+		const RecordingBackend::Record& fourth = backend.records[3];
+		CHECK(fourth.batch.modelId == 2 && fourth.batch.materialId == 1 && fourth.batch.firstCommand == 4);
+		CHECK(fourth.commands[0].transformIndex == 7);
+	}
+
+	// Flush の後は空
+	CHECK(queue.GetCommands().empty());
+	CHECK(queue.GetBatches().empty());
+}
+
+/// <summary>
+/// モデルが変わってもマテリアルが同じなら、マテリアルの切り替えは数えない
+/// </summary>
+void TestSharedMaterial() {
+	RenderQueue queue;
+	NullRenderBackend backend;
+
+	queue.Submit(3, 2, 0);
+	queue.Submit(1, 2, 1);
+	queue.Submit(2, 2, 2);
+	queue.Submit(1, 2, 3);
+	queue.Flush(backend);
+
+	const NullRenderBackend::Stats& stats = backend.GetStats();
+	CHECK(stats.batches == 3);
+	CHECK(stats.commands == 4);
+	CHECK(stats.modelChanges == 3);
+	CHECK(stats.materialChanges == 1);
+}
+
+/// <summary>
+/// 複数フレーム（フレームの頭では状態が未確定に戻る）と、空のフレーム
+/// </summary>
+void TestFrames() {
+	RenderQueue queue;
+	NullRenderBackend backend;
+
+	for (uint32_t frame = 0; frame < 3; ++frame) {
+		queue.SubmitInstanced(0, 0, 0, 100);
+		queue.Submit(4, 1, 100);
+		queue.Flush(backend);
+	}
+	// 空のフレームでもフレーム数だけは数える
+	queue.Flush(backend);
+
+	const NullRenderBackend::Stats& stats = backend.GetStats();
+	CHECK(stats.frames == 4);
+	CHECK(stats.batches == 6);
+	CHECK(stats.commands == 6);
+	CHECK(stats.instances == 303);
+	CHECK(stats.modelChanges == 6);
+	CHECK(stats.materialChanges == 6);
+
+	backend.ResetStats();
+	CHECK(backend.GetStats().frames == 0 && backend.GetStats().batches == 0);
+}
+
+/// <summary>
+/// Draw はキューを空にしないので、同じバッチを何度でも流せる
+/// </summary>
+void TestDrawKeepsQueue() {
+	RenderQueue queue;
+	NullRenderBackend backend;
+
+	queue.Submit(1, 0, 0);
+	queue.Submit(1, 0, 1);
+	queue.BuildBatches();
+	CHECK(queue.GetBatches().size() == 1);
+
+	queue.Draw(backend);
+	queue.Draw(backend);
+	CHECK(backend.GetStats().frames == 2);
+	CHECK(backend.GetStats().batches == 2);
+	CHECK(backend.GetStats().instances == 4);
+	CHECK(queue.GetCommands().size() == 2);
+
+	queue.Clear();
+	CHECK(queue.GetCommands().empty() && queue.GetBatches().empty());
+}
+
+} // namespace
+
+int main() {
+	TestMixedFrame();
+	TestSharedMaterial();
+	TestFrames();
+	TestDrawKeepsQueue();
+	return TestCheck::Finish();
+}
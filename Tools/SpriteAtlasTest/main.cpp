@@ -0,0 +1,123 @@
+// UI のスプライトアトラス（SpriteAtlas と、Tools/AtlasPacker が生成した UiAtlas の表）を確かめる
+// ・表が名前順で、全ての画像が引け、矩形と UV が一致し、同じページで重ならず、ページの画像があるか
+// ・無い名前（空・前方一致・範囲の外）は引けないか
+// ・作ったスプライトが、元画像を Sprite::Create したときと同じ位置に見えるアンカー・矩形・大きさになるか
+//
+// ビルド（Linux, リポジトリ直下で。Sprite はヘッドレス版エンジンのもの）:
+//   g++ -std=c++20 -O2 -I. -ITools/Headless Tools/SpriteAtlasTest/main.cpp SpriteAtlas.cpp TextureCache.cpp DdsTexture.cpp FileUtility.cpp MappedFile.cpp
+//       Tools/Headless/HeadlessEngine.cpp -o spriteAtlasTest
+// 実行（ページの画像を探すのでリポジトリ直下で）:
+//   ./spriteAtlasTest
+// 全て期待どおりなら 0、そうでなければ 1 を返す
+#include "SpriteAtlas.h"
+#include "Tools/Common/TestCheck.h"
+#include "UiAtlas.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+using namespace KamataEngine;
+
+namespace {
+
+/// <summary>
+/// 生成した表
+/// </summary>
+void TestUiAtlas() {
+	const SpriteAtlasData& data = UiAtlas::kData;
+	CHECK(data.pageCount > 0 && data.entryCount > 0);
+	for (uint32_t i = 0; i < data.pageCount; ++i) {
+		CHECK(std::filesystem::exists(std::string("Resources/") + data.pages[i].path));
+	}
+
+	for (uint32_t i = 0; i < data.entryCount; ++i) {
+		const SpriteAtlasEntry& entry = data.entries[i];
+		if (!CHECK(entry.page < data.pageCount)) {
+			continue;
+		}
+		const SpriteAtlasPage& page = data.pages[entry.page];
+		bool isValid = SpriteAtlas::Find(data, entry.name) == &entry && (i == 0 || std::strcmp(data.entries[i - 1].name, entry.name) < 0) &&
+		               entry.x + entry.width <= page.width && entry.y + entry.height <= page.height && entry.trimX + entry.width <= entry.sourceWidth &&
+		               entry.trimY + entry.height <= entry.sourceHeight && std::abs(entry.u0 * page.width - entry.x) < 1.0e-2f &&
+		               std::abs(entry.v0 * page.height - entry.y) < 1.0e-2f && std::abs(entry.u1 * page.width - (entry.x + entry.width)) < 1.0e-2f &&
+		               std::abs(entry.v1 * page.height - (entry.y + entry.height)) < 1.0e-2f;
+		for (uint32_t j = 0; isValid && j < i; ++j) {
+			const SpriteAtlasEntry& other = data.entries[j];
+			isValid = other.page != entry.page || other.x + other.width <= entry.x || entry.x + entry.width <= other.x || other.y + other.height <= entry.y ||
+			          entry.y + entry.height <= other.y;
+		}
+		if (!CHECK(isValid)) {
+			std::fprintf(stderr, "  UiAtlas entry %s is broken\n", entry.name);
+		}
+	}
+
+	// 無い名前（空・前方一致・全ての名前より前・後）
+	CHECK(SpriteAtlas::Find(data, "text/missing.png") == nullptr);
+	CHECK(SpriteAtlas::Find(data, "") == nullptr);
+	CHECK(SpriteAtlas::Find(data, "text/clear") == nullptr);
+	CHECK(SpriteAtlas::Find(data, "a") == nullptr);
+	CHECK(SpriteAtlas::Find(data, "zzz") == nullptr);
+}
+
+// 100x50 の元画像の余白を詰めて、(10,5) からの 60x30 をページの (200,100) に置いたもの
+const SpriteAtlasPage kTestPages[2] = {
+    {"test/page0.png", 256, 256},
+    {"test/page1.png", 512, 256},
+};
+const SpriteAtlasEntry kTestEntries[2] = {
+    {"a.png", 1, 200, 100, 60, 30, 10, 5, 100, 50, 200.0f / 512.0f, 100.0f / 256.0f, 260.0f / 512.0f, 130.0f / 256.0f},
+    {"b.png", 0, 0, 0, 16, 16, 0, 0, 16, 16, 0.0f, 0.0f, 16.0f / 256.0f, 16.0f / 256.0f},
+};
+const SpriteAtlasData kTestData = {kTestPages, 2, kTestEntries, 2};
+
+/// <summary>
+/// スプライトを作る
+/// </summary>
+void TestCreateSprite() {
+	SpriteAtlas atlas;
+	CHECK(atlas.Find("a.png") == nullptr);
+	atlas.Initialize(kTestData);
+	CHECK(atlas.GetPageCount() == 2);
+	CHECK(atlas.Find("a.png") == &kTestEntries[0]);
+
+	// 元画像の中央をアンカーにすると、詰めた矩形の中では ((50-10)/60, (25-5)/30)
+	std::unique_ptr<Sprite> sprite(atlas.CreateSprite("a.png", {320.0f, 240.0f}, {1, 1, 1, 1}, {0.5f, 0.5f}));
+	if (CHECK(sprite != nullptr)) {
+		CHECK(sprite->GetPosition().x == 320.0f && sprite->GetPosition().y == 240.0f);
+		CHECK(std::abs(sprite->GetAnchorPoint().x - 40.0f / 60.0f) < 1.0e-6f && std::abs(sprite->GetAnchorPoint().y - 20.0f / 30.0f) < 1.0e-6f);
+		CHECK(sprite->GetTextureLeftTop().x == 200.0f && sprite->GetTextureLeftTop().y == 100.0f);
+		CHECK(sprite->GetTextureSize().x == 60.0f && sprite->GetTextureSize().y == 30.0f);
+		CHECK(sprite->GetSize().x == 60.0f && sprite->GetSize().y == 30.0f);
+		// ページのテクスチャ
+		CHECK(sprite->GetTextureHandle() == TextureManager::Load("test/page1.png"));
+
+		// 元画像を 200x100 で描くなら、詰めた矩形も倍の 120x60
+		atlas.SetSpriteSize(sprite.get(), "a.png", {200.0f, 100.0f});
+		CHECK(sprite->GetSize().x == 120.0f && sprite->GetSize().y == 60.0f);
+		// 無い名前では変えない
+		atlas.SetSpriteSize(sprite.get(), "missing.png", {1.0f, 1.0f});
+		CHECK(sprite->GetSize().x == 120.0f);
+	}
+
+	// 左上をアンカーにすると、詰めた余白の分だけ負になる
+	std::unique_ptr<Sprite> corner(atlas.CreateSprite("a.png", {0.0f, 0.0f}));
+	if (CHECK(corner != nullptr)) {
+		CHECK(std::abs(corner->GetAnchorPoint().x + 10.0f / 60.0f) < 1.0e-6f && std::abs(corner->GetAnchorPoint().y + 5.0f / 30.0f) < 1.0e-6f);
+	}
+
+	CHECK(atlas.GetSourceSize("a.png").x == 100.0f && atlas.GetSourceSize("a.png").y == 50.0f);
+	CHECK(atlas.GetSourceSize("missing.png").x == 0.0f && atlas.GetSourceSize("missing.png").y == 0.0f);
+}
+
+} // namespace
+
+int main() {
+	TestUiAtlas();
+	TestCreateSprite();
+	return TestCheck::Finish();
+}
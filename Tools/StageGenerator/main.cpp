@@ -0,0 +1,270 @@
+// MapChipField で読めるステージ CSV を、大きさ・密度・敵の数を指定して生成する（シードが同じなら同じ結果）
+//
+// ビルド（リポジトリ直下で）:
+//   g++ -std=c++20 -O2 Tools/StageGenerator/main.cpp -o stageGenerator
+// 実行:
+//   ./stageGenerator --width 1000 --height 1000 --enemies 10000 --seed 7 --out Resources/stress.csv
+//
+// 出力する値（MapChipField の mapChipTable と同じ）:
+//   0 空白 / 1 ブロック / 2 ゴール / 3 敵の出現位置
+//
+// 配置:
+//   外周は壁。左下はプレイヤーの開始位置（GameScene の (5, 15)）が立てる足場にする。
+//   地面は下3段で、ところどころ穴を掘る。空中には足場、地面からは柱を生やす。
+//   ゴールは右端の地面の上。敵は「下がブロックの空白」に均等に散らす。
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// マップチップの値
+enum Tile : uint8_t {
+	kBlank = 0,
+	kBlock = 1,
+	kGoal = 2,
+	kEnemySpawn = 3,
+};
+
+// プレイヤーの開始位置（GameScene::Initialize と同じ）
+const uint32_t kPlayerStartX = 5;
+const uint32_t kPlayerStartY = 15;
+// 開始位置のまわりで敵を置かない幅
+const uint32_t kSafeColumns = 12;
+
+// 設定
+struct Options {
+	uint32_t width = 100;
+	uint32_t height = 20;
+	uint64_t seed = 1;
+	uint32_t enemies = 3;
+	float platformDensity = 0.06f; // 足場の置きやすさ（列ごとの確率）
+	float wallDensity = 0.03f;     // 柱の置きやすさ（列ごとの確率）
+	float gapDensity = 0.04f;      // 地面の穴の開けやすさ（列ごとの確率）
+	std::string outPath = "stage.csv";
+};
+
+/// <summary>
+/// 生成に使う乱数（splitmix64。標準の分布は実装ごとに結果が変わるので使わない）
+/// </summary>
+class SplitMix64 {
+private:
+	uint64_t state_;
+
+public:
+	explicit SplitMix64(uint64_t seed) : state_(seed) {}
+
+	uint64_t Next() {
+		uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		return z ^ (z >> 31);
+	}
+
+	// [0, 1)
+	float NextFloat() { return static_cast<float>(Next() >> 40) * (1.0f / 16777216.0f); }
+	// [min, max]
+	uint32_t NextRange(uint32_t min, uint32_t max) { return min + static_cast<uint32_t>(Next() % (static_cast<uint64_t>(max) - min + 1)); }
+};
+
+/// <summary>
+/// ステージ（y = 0 が一番上の行）
+/// </summary>
+class Stage {
+private:
+	uint32_t width_;
+	uint32_t height_;
+	std::vector<uint8_t> tiles_;
+
+public:
+	Stage(uint32_t width, uint32_t height) : width_(width), height_(height), tiles_(static_cast<size_t>(width) * height, kBlank) {}
+
+	uint32_t GetWidth() const { return width_; }
+	uint32_t GetHeight() const { return height_; }
+
+	uint8_t Get(uint32_t x, uint32_t y) const { return tiles_[static_cast<size_t>(y) * width_ + x]; }
+	void Set(uint32_t x, uint32_t y, uint8_t tile) {
+		if (x < width_ && y < height_) {
+			tiles_[static_cast<size_t>(y) * width_ + x] = tile;
+		}
+	}
+	void Fill(uint32_t x0, uint32_t y0, uint32_t x1, uint32_t y1, uint8_t tile) {
+		for (uint32_t y = y0; y <= y1 && y < height_; ++y) {
+			for (uint32_t x = x0; x <= x1 && x < width_; ++x) {
+				Set(x, y, tile);
+			}
+		}
+	}
+
+	size_t Count(uint8_t tile) const { return static_cast<size_t>(std::count(tiles_.begin(), tiles_.end(), tile)); }
+
+	/// <summary>
+	/// CSV で書き出す
+	/// </summary>
+	bool WriteCsv(const std::string& path) const {
+		std::ofstream file(path, std::ios::binary);
+		if (!file) {
+			return false;
+		}
+
+		// 1行ずつまとめて書く
+		std::string line;
+		line.reserve(static_cast<size_t>(width_) * 2);
+		for (uint32_t y = 0; y < height_; ++y) {
+			line.clear();
+			for (uint32_t x = 0; x < width_; ++x) {
+				line += static_cast<char>('0' + Get(x, y));
+				line += x + 1 < width_ ? ',' : '\n';
+			}
+			file.write(line.data(), static_cast<std::streamsize>(line.size()));
+		}
+		return static_cast<bool>(file);
+	}
+};
+
+/// <summary>
+/// ステージを生成
+/// </summary>
+Stage Generate(const Options& options, uint32_t& placedEnemies) {
+	SplitMix64 random(options.seed);
+	Stage stage(options.width, options.height);
+
+	const uint32_t w = options.width;
+	const uint32_t h = options.height;
+	const uint32_t groundTop = h - 3;
+
+	// 外周
+	stage.Fill(0, 0, w - 1, 0, kBlock);
+	stage.Fill(0, 0, 0, h - 1, kBlock);
+	stage.Fill(w - 1, 0, w - 1, h - 1, kBlock);
+
+	// 地面（ところどころ穴。一番下の段は残して落下死にはしない）
+	stage.Fill(0, groundTop, w - 1, h - 1, kBlock);
+	for (uint32_t x = kSafeColumns; x + 6 < w; ++x) {
+		if (random.NextFloat() < options.gapDensity) {
+			uint32_t gapWidth = random.NextRange(2, 4);
+			stage.Fill(x, groundTop, x + gapWidth - 1, h - 2, kBlank);
+			x += gapWidth + 2;
+		}
+	}
+
+	// 地面から生える柱
+	for (uint32_t x = kSafeColumns; x + 6 < w; ++x) {
+		if (stage.Get(x, groundTop) == kBlock && random.NextFloat() < options.wallDensity) {
+			uint32_t wallHeight = random.NextRange(1, 3);
+			stage.Fill(x, groundTop - wallHeight, x, groundTop - 1, kBlock);
+			x += 3;
+		}
+	}
+
+	// 空中の足場（4行おきの段に置く。ジャンプで届く間隔）
+	for (int64_t row = static_cast<int64_t>(groundTop) - 4; row >= 3; row -= 4) {
+		uint32_t y = static_cast<uint32_t>(row);
+		for (uint32_t x = 2; x + 3 < w; ++x) {
+			if (random.NextFloat() < options.platformDensity) {
+				uint32_t length = random.NextRange(3, 8);
+				stage.Fill(x, y, std::min(x + length - 1, w - 2), y, kBlock);
+				x += length + 2;
+			}
+		}
+	}
+
+	// プレイヤーの開始位置：上を空けて、すぐ下を足場にする（blocks.csv と同じ形）
+	stage.Fill(1, 1, kSafeColumns - 1, kPlayerStartY, kBlank);
+	stage.Fill(0, kPlayerStartY + 1, kPlayerStartX + 1, h - 1, kBlock);
+
+	// ゴール：右端の地面の上
+	uint32_t goalX = w - 4;
+	stage.Fill(goalX - 1, groundTop - 3, goalX + 1, groundTop - 1, kBlank);
+	stage.Fill(goalX - 1, groundTop, goalX + 1, h - 1, kBlock);
+	stage.Set(goalX, groundTop - 1, kGoal);
+
+	// 敵：立てる場所（下がブロックの空白）から重複なく選ぶ
+	std::vector<uint32_t> candidates;
+	for (uint32_t y = 1; y + 1 < h; ++y) {
+		for (uint32_t x = kSafeColumns; x + 5 < w; ++x) {
+			if (stage.Get(x, y) == kBlank && stage.Get(x, y + 1) == kBlock) {
+				candidates.push_back(y * w + x);
+			}
+		}
+	}
+
+	placedEnemies = std::min<uint32_t>(options.enemies, static_cast<uint32_t>(candidates.size()));
+	for (uint32_t i = 0; i < placedEnemies; ++i) {
+		// 部分的なフィッシャー–イェーツ
+		uint32_t pick = random.NextRange(i, static_cast<uint32_t>(candidates.size()) - 1);
+		std::swap(candidates[i], candidates[pick]);
+		stage.Set(candidates[i] % w, candidates[i] / w, kEnemySpawn);
+	}
+
+	return stage;
+}
+
+/// <summary>
+/// 引数の解析
+/// </summary>
+bool ParseOptions(int argc, char** argv, Options& options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+		if (i + 1 >= argc) {
+			return false;
+		}
+		const char* value = argv[++i];
+
+		if (argument == "--width") {
+			options.width = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		} else if (argument == "--height") {
+			options.height = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		} else if (argument == "--seed") {
+			options.seed = std::strtoull(value, nullptr, 10);
+		} else if (argument == "--enemies") {
+			options.enemies = static_cast<uint32_t>(std::strtoul(value, nullptr, 10));
+		} else if (argument == "--platforms") {
+			options.platformDensity = std::strtof(value, nullptr);
+		} else if (argument == "--walls") {
+			options.wallDensity = std::strtof(value, nullptr);
+		} else if (argument == "--gaps") {
+			options.gapDensity = std::strtof(value, nullptr);
+		} else if (argument == "--out") {
+			options.outPath = value;
+		} else {
+			return false;
+		}
+	}
+
+	// 開始位置とゴールが入る大きさは必要
+	return options.width >= 2 * kSafeColumns && options.height >= kPlayerStartY + 5;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		std::fprintf(stderr,
+		             "usage: %s [--width n(>=24)] [--height n(>=20)] [--seed n] [--enemies n]\n"
+		             "          [--platforms p] [--walls p] [--gaps p] [--out file.csv]\n",
+		             argv[0]);
+		return 1;
+	}
+
+	uint32_t placedEnemies = 0;
+	Stage stage = Generate(options, placedEnemies);
+
+	if (!stage.WriteCsv(options.outPath)) {
+		std::fprintf(stderr, "cannot write %s\n", options.outPath.c_str());
+		return 1;
+	}
+
+	size_t tiles = static_cast<size_t>(options.width) * options.height;
+	std::printf("%s: %ux%u (%zu tiles), %zu blocks, %u enemies", options.outPath.c_str(), options.width, options.height, tiles, stage.Count(kBlock), placedEnemies);
+	if (placedEnemies < options.enemies) {
+		std::printf(" (requested %u, not enough floor)", options.enemies);
+	}
+	std::printf(", seed %llu\n", static_cast<unsigned long long>(options.seed));
+	return 0;
+}
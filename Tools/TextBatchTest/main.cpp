@@ -0,0 +1,175 @@
+// HUD の文字（TextBatch）が積む四角形を確かめる
+// ・タイムの書式（繰り上がり・上限で止まる）、色の詰め方
+// ・小さな書体で、四角形の位置・UV・色、改行・揃え・書体に無い文字の進み方がちょうど期待どおりか
+// ・HUD の数字でタイムが8文字の四角形になり、中央揃えで左右対称に並び、UV がアトラスに収まるか
+//
+// ビルド（Linux, リポジトリ直下で。Vector2 はヘッドレス版エンジンのもの）:
+//   g++ -std=c++20 -O2 -I. -ITools/Headless Tools/TextBatchTest/main.cpp TextBatch.cpp -o textBatchTest
+// 実行:
+//   ./textBatchTest
+// 全て期待どおりなら 0、そうでなければ 1 を返す
+#define NOMINMAX
+#include "HudFont.h"
+#include "TextBatch.h"
+#include "Tools/Common/TestCheck.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+using namespace KamataEngine;
+
+namespace {
+
+/// <summary>
+/// タイムの書式
+/// </summary>
+void TestFormatTime() {
+	const struct {
+		uint32_t frame;
+		const char* text;
+	} kCases[] = {
+	    {0, "00:00.00"},
+	    {1, "00:00.01"},
+	    {59, "00:00.98"},
+	    {60, "00:01.00"},
+	    {3723, "01:02.05"},
+	    {60 * 60 * 10, "10:00.00"},
+	    {60 * 60 * 100 - 1, "99:59.98"},
+	    {60 * 60 * 100, "99:59.99"},
+	    {UINT32_MAX, "99:59.99"},
+	};
+	for (const auto& timeCase : kCases) {
+		char buffer[TextBatch::kTimeBufferSize];
+		TextBatch::FormatTime(timeCase.frame, buffer);
+		if (!CHECK(std::strcmp(buffer, timeCase.text) == 0)) {
+			std::fprintf(stderr, "  FormatTime(%u) = %s, expected %s\n", timeCase.frame, buffer, timeCase.text);
+		}
+	}
+}
+
+/// <summary>
+/// 色の詰め方（RGBA の順に上位から。範囲外は丸める）
+/// </summary>
+void TestPackColor() {
+	CHECK(TextBatch::PackColor(1.0f, 1.0f, 1.0f, 1.0f) == TextBatch::kColorWhite);
+	CHECK(TextBatch::PackColor(1.0f, 0.0f, 0.0f, 0.5f) == 0xFF000080);
+	CHECK(TextBatch::PackColor(0.0f, 1.0f, 0.0f, 0.0f) == 0x00FF0000);
+	CHECK(TextBatch::PackColor(-1.0f, 0.0f, 2.0f, 1.0f) == 0x0000FFFF);
+}
+
+// 'A' 'B' 'C' の3文字だけの書体（アトラス 64x32。'B' は空白のように大きさ 0。空白は無い）
+const TextGlyph kTestGlyphs[3] = {
+    {0, 0, 8, 10, 1, 2, 10},  // 'A'
+    {0, 0, 0, 0, 0, 0, 6},    // 'B'
+    {16, 8, 4, 12, -1, 0, 5}, // 'C'
+};
+const TextFont kTestFont = {kTestGlyphs, 'A', 3, 20.0f, 64.0f, 32.0f};
+
+/// <summary>
+/// 小さな書体での位置・UV・改行・揃え
+/// </summary>
+void TestLayout() {
+	TextBatch batch;
+	const uint32_t color = 0x11223344;
+
+	// "AB?C"：'B' は四角形を作らずに進み、'?' は書体に無いので行の高さの半分（10）進む。倍率 2
+	float width = batch.AddText(kTestFont, "AB?C", {100.0f, 50.0f}, 2.0f, color);
+	CHECK(width == (10.0f + 6.0f + 10.0f + 5.0f) * 2.0f);
+	CHECK(TextBatch::MeasureLine(kTestFont, "AB?C\nAAAA", 2.0f) == width);
+	if (CHECK(batch.GetQuadCount() == 2)) {
+		const std::vector<TextVertex>& vertices = batch.GetVertices();
+		// 'A'：左上 (100 + 1*2, 50 + 2*2)、大きさ 16x20、UV は (0,0)-(8/64,10/32)
+		const TextVertex& a = vertices[0];
+		CHECK(a.x == 102.0f && a.y == 54.0f && a.u == 0.0f && a.v == 0.0f && a.color == color);
+		CHECK(vertices[1].x == 118.0f && vertices[1].y == 54.0f && vertices[1].u == 8.0f / 64.0f && vertices[1].v == 0.0f);
+		CHECK(vertices[2].x == 102.0f && vertices[2].y == 74.0f && vertices[2].u == 0.0f && vertices[2].v == 10.0f / 32.0f);
+		CHECK(vertices[3].x == 118.0f && vertices[3].y == 74.0f && vertices[3].color == color);
+		// 'C'：書き始めは 100 + (10+6+10)*2 = 152、左上は 152 - 1*2
+		const TextVertex& c = vertices[4];
+		CHECK(c.x == 150.0f && c.y == 50.0f && c.u == 16.0f / 64.0f && c.v == 8.0f / 32.0f);
+		CHECK(vertices[7].x == 158.0f && vertices[7].y == 74.0f && vertices[7].u == 20.0f / 64.0f && vertices[7].v == 20.0f / 32.0f);
+	}
+
+	// 改行は行の高さ×倍率だけ下へ。揃えは行ごと
+	const struct {
+		TextBatch::Align align;
+		float firstLineX;  // 1行目 "AA"（幅 20）の 'A' の左上
+		float secondLineX; // 2行目 "A"（幅 10）の 'A' の左上
+	} kAlignCases[] = {
+	    {TextBatch::Align::kLeft, 201.0f, 201.0f},
+	    {TextBatch::Align::kCenter, 191.0f, 196.0f},
+	    {TextBatch::Align::kRight, 181.0f, 191.0f},
+	};
+	for (const auto& alignCase : kAlignCases) {
+		batch.Clear();
+		width = batch.AddText(kTestFont, "AA\nA", {200.0f, 0.0f}, 1.0f, color, alignCase.align);
+		CHECK(width == 20.0f);
+		if (CHECK(batch.GetQuadCount() == 3)) {
+			const std::vector<TextVertex>& vertices = batch.GetVertices();
+			CHECK(vertices[0].x == alignCase.firstLineX && vertices[0].y == 2.0f);
+			CHECK(vertices[4].x == alignCase.firstLineX + 10.0f);
+			CHECK(vertices[8].x == alignCase.secondLineX && vertices[8].y == 22.0f);
+		}
+	}
+
+	// 空の文字列・空行だけ
+	batch.Clear();
+	CHECK(batch.AddText(kTestFont, "", {0.0f, 0.0f}, 1.0f, color) == 0.0f);
+	CHECK(batch.AddText(kTestFont, "\n\n", {0.0f, 0.0f}, 1.0f, color) == 0.0f);
+	CHECK(batch.GetQuadCount() == 0);
+
+	// Clear は容量を残す
+	batch.Reserve(64);
+	size_t capacity = batch.GetVertices().capacity();
+	batch.AddText(kTestFont, "ACACAC", {0.0f, 0.0f}, 1.0f, color);
+	batch.Clear();
+	CHECK(batch.GetVertices().empty() && batch.GetVertices().capacity() == capacity && capacity >= 64 * TextBatch::kVerticesPerQuad);
+}
+
+/// <summary>
+/// HUD の書体
+/// </summary>
+void TestHudFont() {
+	// 中央揃えのタイム：8文字が全て四角形になり、左右対称に並び、UV がアトラスの中に収まる
+	TextBatch batch;
+	const float kScale = 0.5f;
+	float width = batch.AddTime(HudFont::kDigits, 3723, {640.0f, 0.0f}, kScale, TextBatch::kColorWhite, TextBatch::Align::kCenter);
+	CHECK(batch.GetQuadCount() == 8);
+	CHECK(std::abs(width - TextBatch::MeasureLine(HudFont::kDigits, "01:02.05", kScale)) < 1.0e-3f);
+
+	const std::vector<TextVertex>& vertices = batch.GetVertices();
+	uint32_t broken = 0;
+	float left = 1.0e9f;
+	float right = -1.0e9f;
+	for (size_t i = 0; i < vertices.size(); i += TextBatch::kVerticesPerQuad) {
+		const TextVertex& leftTop = vertices[i];
+		const TextVertex& rightBottom = vertices[i + 3];
+		bool isValid = leftTop.u >= 0.0f && rightBottom.u <= 1.0f && leftTop.v >= 0.0f && rightBottom.v <= 1.0f && leftTop.x < rightBottom.x && leftTop.y < rightBottom.y &&
+		               std::abs((rightBottom.x - leftTop.x) - (rightBottom.u - leftTop.u) * HudFont::kAtlasWidth * kScale) < 1.0e-2f &&
+		               vertices[i + 1].x == rightBottom.x && vertices[i + 2].y == rightBottom.y;
+		broken += !isValid;
+		left = std::min(left, leftTop.x);
+		right = std::max(right, rightBottom.x);
+	}
+	CHECK(broken == 0);
+	// 両端の数字（0 と 5）の余白の差だけずれる
+	CHECK(std::abs((640.0f - left) - (right - 640.0f)) <= 4.0f);
+
+	// 統計の行：空白は四角形を作らない（GameScene::BuildHud と同じ並び）
+	batch.Clear();
+	batch.AddText(HudFont::kAscii, "BEST    00:41.23\nROUTE   3 JUMPS", {16.0f, 16.0f}, 2.0f, TextBatch::PackColor(1.0f, 1.0f, 1.0f, 0.85f));
+	CHECK(batch.GetQuadCount() == 12 + 11);
+}
+
+} // namespace
+
+int main() {
+	TestFormatTime();
+	TestPackColor();
+	TestLayout();
+	TestHudFont();
+	return TestCheck::Finish();
+}
@@ -0,0 +1,336 @@
+// Resources の画像を、ミップ付き・ブロック圧縮の DDS に焼き、マニフェストを書く（ゲームは TextureCache が読む）
+//
+// ビルド（Linux, リポジトリ直下で。TextureManager はヘッドレス版エンジンのもの）:
+//   g++ -std=c++20 -O2 -I. -ITools/Headless Tools/TextureBaker/main.cpp Tools/Common/PngImage.cpp Tools/Common/BlockCompression.cpp
+//       TextureCache.cpp DdsTexture.cpp FileUtility.cpp MappedFile.cpp Tools/Headless/HeadlessEngine.cpp -o textureBaker
+// 実行（リポジトリ直下で。画像は --root からの相対パス。省略すると kDefaultImages）:
+//   ./textureBaker [--root Resources] [--force] [画像...]
+//
+// 画像ごとに:
+//   ・元画像のバイト数と CRC32 がマニフェストと同じで、焼いたファイルも残っていれば焼き直さない（--force で常に焼く）
+//   ・元画像の更新時刻は焼き直さないときも書き直す（ゲームは時刻が合えば CRC32 を計算しない）
+//   ・α が全て 255 なら BC1、そうでなければ BC3。ミップは 1x1 まで、α で重み付けした 2x2 の平均で縮める
+//   ・Resources/textureCache/ に元画像と同じ並びで .dds を書き、読み直して中身と画質（PSNR）を確かめる
+//   ・PNG を展開する時間と、DDS をマップする時間、VRAM（ミップ込み。RGBA8 と圧縮後）を並べて出す
+// 最後にマニフェスト（Resources/textureCache/manifest.csv）を書き直し、TextureCache で全て引けることを確かめる。
+// 読めない画像（JPEG など）はマニフェストに入れない（ゲームは元画像を読む）。
+#define NOMINMAX
+#include "DdsTexture.h"
+#include "FileUtility.h"
+#include "TextureCache.h"
+#include "Tools/Common/BlockCompression.h"
+#include "Tools/Common/PngImage.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+// シーンが読む画像（モデルの skydome・block・Atlas と、文字のアトラス2枚）
+const char* const kDefaultImages[] = {
+    "skydome/skydome.png", "block/block.png", "block/Atlas.png", "text/hudFont.png", "text/uiAtlas0.png",
+};
+
+// DDS のヘッダ（"DDS " と124バイト）。残りがそのまま VRAM に載る
+const uint64_t kDdsHeaderSize = 128;
+
+// 焼いた結果1枚分（表に出すもの）
+struct Report {
+	std::string name;
+	TextureCache::Entry entry;
+	bool isCooked = false; // 今回焼いたか（false なら前回のまま）
+	double pngMilliseconds = 0.0;
+	double ddsMilliseconds = 0.0;
+	uint64_t rgbaBytes = 0; // RGBA8 でミップまで持ったときの VRAM
+	double psnr = 0.0;      // ミップ0段目の PSNR（dB）
+};
+
+std::vector<uint8_t> ReadFile(const std::string& path) {
+	std::ifstream file(path, std::ios::binary);
+	if (!file.is_open()) {
+		return {};
+	}
+	return std::vector<uint8_t>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/// <summary>
+/// 縦横半分にする（2x2 の平均。色は α で重み付けし、透明な画素の色がにじまないようにする）
+/// </summary>
+std::vector<uint8_t> Downsample(const std::vector<uint8_t>& pixels, uint32_t width, uint32_t height, uint32_t& nextWidth, uint32_t& nextHeight) {
+	nextWidth = (std::max)(width / 2, 1u);
+	nextHeight = (std::max)(height / 2, 1u);
+	std::vector<uint8_t> next(static_cast<size_t>(nextWidth) * nextHeight * 4);
+	for (uint32_t y = 0; y < nextHeight; ++y) {
+		for (uint32_t x = 0; x < nextWidth; ++x) {
+			const uint32_t sourceX[2] = {(std::min)(x * 2, width - 1), (std::min)(x * 2 + 1, width - 1)};
+			const uint32_t sourceY[2] = {(std::min)(y * 2, height - 1), (std::min)(y * 2 + 1, height - 1)};
+			uint32_t alphaSum = 0;
+			uint32_t weighted[3] = {};
+			uint32_t plain[3] = {};
+			for (uint32_t sy : sourceY) {
+				for (uint32_t sx : sourceX) {
+					const uint8_t* pixel = &pixels[(static_cast<size_t>(sy) * width + sx) * 4];
+					alphaSum += pixel[3];
+					for (int c = 0; c < 3; ++c) {
+						weighted[c] += pixel[c] * pixel[3];
+						plain[c] += pixel[c];
+					}
+				}
+			}
+			uint8_t* out = &next[(static_cast<size_t>(y) * nextWidth + x) * 4];
+			for (int c = 0; c < 3; ++c) {
+				out[c] = static_cast<uint8_t>(alphaSum > 0 ? (weighted[c] + alphaSum / 2) / alphaSum : (plain[c] + 2) / 4);
+			}
+			out[3] = static_cast<uint8_t>((alphaSum + 2) / 4);
+		}
+	}
+	return next;
+}
+
+// 見た目の差（色は α を掛けてから比べる。透明な画素の色は BC3 では合わせないため）
+double ComputePsnr(const std::vector<uint8_t>& a, const std::vector<uint8_t>& b, bool hasAlpha) {
+	double sum = 0.0;
+	size_t count = 0;
+	for (size_t i = 0; i < a.size(); i += 4) {
+		const double alphaA = a[i + 3] / 255.0;
+		const double alphaB = b[i + 3] / 255.0;
+		for (size_t c = 0; c < 3; ++c) {
+			double d = a[i + c] * alphaA - b[i + c] * alphaB;
+			sum += d * d;
+		}
+		count += 3;
+		if (hasAlpha) {
+			double d = static_cast<double>(a[i + 3]) - static_cast<double>(b[i + 3]);
+			sum += d * d;
+			++count;
+		}
+	}
+	if (sum == 0.0) {
+		return 99.0;
+	}
+	return 10.0 * std::log10(255.0 * 255.0 / (sum / static_cast<double>(count)));
+}
+
+/// <summary>
+/// 1枚焼く
+/// </summary>
+bool Cook(const std::string& root, const std::string& name, const std::vector<uint8_t>& file, Report& report) {
+	PngImage image;
+	std::string error;
+	auto start = std::chrono::steady_clock::now();
+	if (!image.Decode(file.data(), file.size(), &error)) {
+		std::fprintf(stderr, "%s: skipped (%s)\n", name.c_str(), error.c_str());
+		return false;
+	}
+	report.pngMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+	const uint32_t width = image.GetWidth();
+	const uint32_t height = image.GetHeight();
+	const std::vector<uint8_t>& source = image.GetPixels();
+	bool hasAlpha = false;
+	for (size_t i = 3; i < source.size() && !hasAlpha; i += 4) {
+		hasAlpha = source[i] != 255;
+	}
+	const DdsTexture::Format format = hasAlpha ? DdsTexture::Format::kBC3 : DdsTexture::Format::kBC1;
+	const bool isBC3 = format == DdsTexture::Format::kBC3;
+
+	// ミップを縮めながら圧縮する
+	const uint32_t mipCount = DdsTexture::GetFullMipCount(width, height);
+	std::vector<std::vector<uint8_t>> levels;
+	std::vector<uint8_t> pixels = source;
+	uint32_t levelWidth = width;
+	uint32_t levelHeight = height;
+	report.rgbaBytes = 0;
+	for (uint32_t level = 0; level < mipCount; ++level) {
+		levels.push_back(BlockCompression::Compress(pixels.data(), levelWidth, levelHeight, isBC3));
+		report.rgbaBytes += static_cast<uint64_t>(levelWidth) * levelHeight * 4;
+		if (level + 1 < mipCount) {
+			uint32_t nextWidth;
+			uint32_t nextHeight;
+			pixels = Downsample(pixels, levelWidth, levelHeight, nextWidth, nextHeight);
+			levelWidth = nextWidth;
+			levelHeight = nextHeight;
+		}
+	}
+
+	// 元画像と同じ並びで textureCache/ の下に置く
+	std::filesystem::path cookedPath = std::filesystem::path("textureCache") / name;
+	cookedPath.replace_extension(".dds");
+	std::filesystem::path fullPath = std::filesystem::path(root) / cookedPath;
+	std::error_code errorCode;
+	std::filesystem::create_directories(fullPath.parent_path(), errorCode);
+	if (!DdsTexture::Write(fullPath.string(), format, width, height, levels)) {
+		std::fprintf(stderr, "%s: failed to write %s\n", name.c_str(), fullPath.string().c_str());
+		return false;
+	}
+
+	// 読み直して、書いたとおりか確かめる（ゲームと同じ読み方で）
+	DdsTexture texture;
+	start = std::chrono::steady_clock::now();
+	bool isOpened = texture.Open(fullPath.string());
+	report.ddsMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	bool isValid = isOpened && texture.GetFormat() == format && texture.GetWidth() == width && texture.GetHeight() == height && texture.GetMipCount() == mipCount;
+	for (uint32_t level = 0; isValid && level < mipCount; ++level) {
+		const DdsTexture::Level& read = texture.GetLevel(level);
+		isValid = read.size == levels[level].size() && std::memcmp(read.data, levels[level].data(), read.size) == 0;
+	}
+	if (!isValid) {
+		std::fprintf(stderr, "%s: %s does not read back\n", name.c_str(), fullPath.string().c_str());
+		return false;
+	}
+	report.psnr = ComputePsnr(source, BlockCompression::Decompress(texture.GetLevel(0).data, width, height, isBC3), isBC3);
+
+	report.entry.cookedPath = cookedPath.generic_string();
+	report.entry.cookedSize = std::filesystem::file_size(fullPath, errorCode);
+	report.entry.format = format;
+	report.entry.width = width;
+	report.entry.height = height;
+	report.entry.mipCount = mipCount;
+	report.isCooked = true;
+	return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	std::string root = "Resources";
+	bool isForced = false;
+	std::vector<std::string> names;
+	for (int i = 1; i < argc; ++i) {
+		std::string arg = argv[i];
+		if (arg == "--root" && i + 1 < argc) {
+			root = argv[++i];
+		} else if (arg == "--force") {
+			isForced = true;
+		} else if (arg.rfind("--", 0) == 0) {
+			std::fprintf(stderr, "usage: %s [--root dir] [--force] [images...]\n", argv[0]);
+			return 1;
+		} else {
+			names.push_back(arg);
+		}
+	}
+	if (names.empty()) {
+		names.assign(std::begin(kDefaultImages), std::end(kDefaultImages));
+	}
+
+	// 前回のマニフェスト（変わっていない画像は焼き直さない）
+	const std::string manifestPath = root + "/" + TextureCache::kManifestPath;
+	std::unordered_map<std::string, TextureCache::Entry> previous;
+	{
+		std::ifstream file(manifestPath);
+		std::string line;
+		while (std::getline(file, line)) {
+			std::string sourcePath;
+			TextureCache::Entry entry;
+			if (!line.empty() && line[0] != '#' && TextureCache::ParseManifestLine(line, sourcePath, entry)) {
+				previous[sourcePath] = entry;
+			}
+		}
+	}
+
+	std::vector<Report> reports;
+	for (const std::string& name : names) {
+		std::vector<uint8_t> file = ReadFile(root + "/" + name);
+		if (file.empty()) {
+			std::fprintf(stderr, "%s: skipped (cannot read)\n", name.c_str());
+			continue;
+		}
+
+		Report report;
+		report.name = name;
+		uint64_t sourceSize = file.size();
+		// ゲームと同じ関数で計算する（TextureCache が時刻の違う元画像を比べるときの値）
+		uint32_t sourceCrc = TextureCache::ComputeCrc32(file.data(), file.size());
+
+		auto it = previous.find(name);
+		std::error_code errorCode;
+		if (!isForced && it != previous.end() && it->second.sourceSize == sourceSize && it->second.sourceCrc == sourceCrc &&
+		    std::filesystem::file_size(root + "/" + it->second.cookedPath, errorCode) == it->second.cookedSize && !errorCode) {
+			report.entry = it->second;
+		} else if (!Cook(root, name, file, report)) {
+			continue;
+		}
+		report.entry.sourceSize = sourceSize;
+		report.entry.sourceCrc = sourceCrc;
+		report.entry.sourceTime = FileUtility::GetStamp(root + "/" + name).time;
+		reports.push_back(report);
+	}
+
+	// 表
+	std::printf("%-22s %-10s %-4s %4s %9s %9s %9s %9s %8s %8s %7s\n", "image", "size", "fmt", "mips", "png KB", "dds KB", "rgba VRAM", "bc VRAM", "png ms", "dds ms", "PSNR");
+	uint64_t totalPng = 0;
+	uint64_t totalDds = 0;
+	uint64_t totalRgba = 0;
+	uint64_t totalBlocks = 0;
+	double totalPngMilliseconds = 0.0;
+	double totalDdsMilliseconds = 0.0;
+	for (const Report& report : reports) {
+		char size[24];
+		std::snprintf(size, sizeof(size), "%ux%u", report.entry.width, report.entry.height);
+		if (!report.isCooked) {
+			std::printf("%-22s %-10s %-4s %4u %9.1f %9.1f  (up to date)\n", report.name.c_str(), size, DdsTexture::GetFormatName(report.entry.format), report.entry.mipCount,
+			            static_cast<double>(report.entry.sourceSize) / 1024.0, static_cast<double>(report.entry.cookedSize) / 1024.0);
+			continue;
+		}
+		std::printf("%-22s %-10s %-4s %4u %9.1f %9.1f %9.1f %9.1f %8.2f %8.3f %6.1fdB\n", report.name.c_str(), size, DdsTexture::GetFormatName(report.entry.format), report.entry.mipCount,
+		            static_cast<double>(report.entry.sourceSize) / 1024.0, static_cast<double>(report.entry.cookedSize) / 1024.0, static_cast<double>(report.rgbaBytes) / 1024.0,
+		            static_cast<double>(report.entry.cookedSize - kDdsHeaderSize) / 1024.0, report.pngMilliseconds, report.ddsMilliseconds, report.psnr);
+		totalPng += report.entry.sourceSize;
+		totalDds += report.entry.cookedSize;
+		totalRgba += report.rgbaBytes;
+		totalBlocks += report.entry.cookedSize - kDdsHeaderSize;
+		totalPngMilliseconds += report.pngMilliseconds;
+		totalDdsMilliseconds += report.ddsMilliseconds;
+	}
+	if (totalPng > 0) {
+		std::printf("%-22s %-10s %-4s %4s %9.1f %9.1f %9.1f %9.1f %8.2f %8.3f\n", "total (cooked now)", "", "", "", static_cast<double>(totalPng) / 1024.0,
+		            static_cast<double>(totalDds) / 1024.0, static_cast<double>(totalRgba) / 1024.0, static_cast<double>(totalBlocks) / 1024.0, totalPngMilliseconds,
+		            totalDdsMilliseconds);
+	}
+
+	// マニフェストを書き直す
+	{
+		std::error_code errorCode;
+		std::filesystem::create_directories(std::filesystem::path(manifestPath).parent_path(), errorCode);
+		std::ofstream file(manifestPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			std::fprintf(stderr, "failed to write %s\n", manifestPath.c_str());
+			return 1;
+		}
+		file << "# Tools/TextureBaker で生成（手で書き換えない）\n";
+		file << "# 元画像,元のバイト数,元の CRC32,焼いたファイル,焼いたバイト数,形式,幅,高さ,ミップ数,元の更新時刻\n";
+		for (const Report& report : reports) {
+			file << TextureCache::FormatManifestLine(report.name, report.entry) << "\n";
+		}
+		if (!file.good()) {
+			std::fprintf(stderr, "failed to write %s\n", manifestPath.c_str());
+			return 1;
+		}
+	}
+
+	// ゲームと同じ読み方で、全て焼いたものに置き換わることを確かめる
+	TextureCache* cache = TextureCache::GetInstance();
+	if (!cache->Initialize(root) || cache->GetEntryCount() != reports.size()) {
+		std::fprintf(stderr, "%s does not read back\n", manifestPath.c_str());
+		return 1;
+	}
+	for (const Report& report : reports) {
+		DdsTexture texture;
+		if (cache->Resolve(report.name) != report.entry.cookedPath || !cache->Open(report.name, texture)) {
+			std::fprintf(stderr, "%s: TextureCache does not resolve to %s\n", report.name.c_str(), report.entry.cookedPath.c_str());
+			return 1;
+		}
+	}
+	std::printf("%s: %zu entries\n", manifestPath.c_str(), reports.size());
+	return 0;
+}
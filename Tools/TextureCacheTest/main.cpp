@@ -0,0 +1,213 @@
+// 焼いたテクスチャのキャッシュ（TextureCache）が、焼いたものと元画像のどちらを読むかを確かめる
+// ・マニフェストの1行を書いて読み直すと元に戻るか。古い形式（更新時刻なし）・壊れた行の扱い
+// ・CRC32 がツールの PngImage::Crc32 と同じ値になるか
+// ・焼いたものが無い・マニフェストに無い・止めたとき・元画像のバイト数が変わったときは元画像を読むか
+// ・元画像がバイト数を変えずに書き換えられたら元画像を読み、時刻だけ変わったなら焼いたものを読むか
+//
+// ビルド（Linux, リポジトリ直下で。TextureManager はヘッドレス版エンジンのもの）:
+//   g++ -std=c++20 -O2 -I. -ITools/Headless Tools/TextureCacheTest/main.cpp TextureCache.cpp DdsTexture.cpp FileUtility.cpp MappedFile.cpp
+//       Tools/Common/PngImage.cpp Tools/Headless/HeadlessEngine.cpp -o textureCacheTest
+// 実行:
+//   ./textureCacheTest
+// 全て期待どおりなら 0、そうでなければ 1 を返す
+#define NOMINMAX
+#include "DdsTexture.h"
+#include "FileUtility.h"
+#include "TextureCache.h"
+#include "Tools/Common/PngImage.h"
+#include "Tools/Common/TestCheck.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+/// <summary>
+/// マニフェストの1行
+/// </summary>
+void TestManifestLine() {
+	TextureCache::Entry entry;
+	entry.cookedPath = "textureCache/text/hudFont.dds";
+	entry.sourceSize = 12444;
+	entry.sourceCrc = 0xFB4A80C4;
+	entry.sourceTime = -1234567890123456789ll;
+	entry.cookedSize = 349680;
+	entry.format = DdsTexture::Format::kBC3;
+	entry.width = 512;
+	entry.height = 256;
+	entry.mipCount = 10;
+
+	std::string line = TextureCache::FormatManifestLine("text/hudFont.png", entry);
+	CHECK(line == "text/hudFont.png,12444,fb4a80c4,textureCache/text/hudFont.dds,349680,BC3,512,256,10,-1234567890123456789");
+
+	std::string sourcePath;
+	TextureCache::Entry read;
+	if (CHECK(TextureCache::ParseManifestLine(line, sourcePath, read))) {
+		CHECK(sourcePath == "text/hudFont.png");
+		CHECK(read.cookedPath == entry.cookedPath && read.sourceSize == entry.sourceSize && read.sourceCrc == entry.sourceCrc && read.sourceTime == entry.sourceTime);
+		CHECK(read.cookedSize == entry.cookedSize && read.format == entry.format && read.width == entry.width && read.height == entry.height && read.mipCount == entry.mipCount);
+	}
+
+	// 更新時刻の無い古い行は読めて、時刻は 0（常に CRC32 で比べる）
+	TextureCache::Entry old;
+	old.sourceTime = 99;
+	CHECK(TextureCache::ParseManifestLine("block/block.png,59242,c2ea11af,textureCache/block/block.dds,699192,BC1,1024,1024,11", sourcePath, old));
+	CHECK(old.sourceTime == 0 && old.sourceCrc == 0xC2EA11AF && old.format == DdsTexture::Format::kBC1);
+
+	// 壊れた行
+	TextureCache::Entry broken;
+	CHECK(!TextureCache::ParseManifestLine("broken,line", sourcePath, broken));
+	CHECK(!TextureCache::ParseManifestLine("a.png,1,0,a.dds,1,BC7,4,4,1,0", sourcePath, broken));
+	CHECK(!TextureCache::ParseManifestLine("a.png,1,0,a.dds,1,BC1,0,4,1,0", sourcePath, broken));
+	CHECK(!TextureCache::ParseManifestLine(",1,0,a.dds,1,BC1,4,4,1,0", sourcePath, broken));
+	CHECK(!TextureCache::ParseManifestLine("a.png,1,0,a.dds,1,BC1,4,4,1,0,extra", sourcePath, broken));
+}
+
+/// <summary>
+/// CRC32
+/// </summary>
+void TestCrc32() {
+	const char* check = "123456789";
+	CHECK(TextureCache::ComputeCrc32(reinterpret_cast<const uint8_t*>(check), std::strlen(check)) == 0xCBF43926u);
+	CHECK(TextureCache::ComputeCrc32(nullptr, 0) == 0u);
+
+	// 以前のツールが書いたマニフェストの値（PngImage::Crc32）と同じ
+	std::vector<uint8_t> data(100000);
+	for (size_t i = 0; i < data.size(); ++i) {
+		data[i] = static_cast<uint8_t>(i * 131 + (i >> 7));
+	}
+	CHECK(TextureCache::ComputeCrc32(data.data(), data.size()) == PngImage::Crc32(data.data(), data.size()));
+}
+
+/// <summary>
+/// 元画像を書く（更新時刻は time に揃える。ファイルシステムの時刻の細かさに左右されないように）
+/// </summary>
+void WriteSource(const std::filesystem::path& path, const std::string& content, std::filesystem::file_time_type time) {
+	std::ofstream(path, std::ios::binary | std::ios::trunc) << content;
+	std::filesystem::last_write_time(path, time);
+}
+
+/// <summary>
+/// 焼いたものと元画像のどちらを読むか
+/// </summary>
+void TestResolve() {
+	// 焼いたテクスチャ（256x128 の BC3、ミップ付き。中身は段ごとに違う値）とマニフェストを一時ディレクトリに作る
+	std::filesystem::path directory = std::filesystem::temp_directory_path() / "textureCacheTest";
+	std::error_code errorCode;
+	std::filesystem::remove_all(directory, errorCode);
+	std::filesystem::create_directories(directory / "textureCache");
+
+	const uint32_t width = 256;
+	const uint32_t height = 128;
+	const uint32_t mipCount = DdsTexture::GetFullMipCount(width, height);
+	std::vector<std::vector<uint8_t>> levels;
+	for (uint32_t level = 0; level < mipCount; ++level) {
+		levels.emplace_back(DdsTexture::GetLevelSize(DdsTexture::Format::kBC3, std::max(width >> level, 1u), std::max(height >> level, 1u)), static_cast<uint8_t>(level));
+	}
+	const std::filesystem::path cookedPath = directory / "textureCache" / "ui.dds";
+	const std::filesystem::path sourcePath = directory / "ui.png";
+	const std::filesystem::path manifestPath = directory / TextureCache::kManifestPath;
+	const std::string content(1000, 'x');
+	const std::filesystem::file_time_type bakedTime = std::filesystem::file_time_type::clock::now() - std::chrono::hours(1);
+	WriteSource(sourcePath, content, bakedTime);
+
+	TextureCache::Entry entry;
+	entry.cookedPath = "textureCache/ui.dds";
+	entry.sourceSize = content.size();
+	entry.sourceCrc = TextureCache::ComputeCrc32(reinterpret_cast<const uint8_t*>(content.data()), content.size());
+	entry.sourceTime = FileUtility::GetStamp(sourcePath.string()).time;
+	entry.format = DdsTexture::Format::kBC3;
+	entry.width = width;
+	entry.height = height;
+	entry.mipCount = mipCount;
+	CHECK(entry.sourceTime != 0);
+	CHECK(DdsTexture::Write(cookedPath.string(), entry.format, width, height, levels));
+	entry.cookedSize = std::filesystem::file_size(cookedPath);
+	TextureCache::Entry missing = entry;
+	missing.cookedPath = "textureCache/missing.dds";
+	auto writeManifest = [&](const TextureCache::Entry& uiEntry) {
+		std::ofstream manifest(manifestPath, std::ios::binary | std::ios::trunc);
+		manifest << "# comment\n"
+		         << TextureCache::FormatManifestLine("ui.png", uiEntry) << "\r\n"
+		         << TextureCache::FormatManifestLine("missing.png", missing) << "\n\nbroken,line\n";
+	};
+	writeManifest(entry);
+
+	// マニフェストが無ければ全て元画像
+	TextureCache* cache = TextureCache::GetInstance();
+	CHECK(!cache->Initialize((directory / "none").string()));
+	CHECK(cache->GetEntryCount() == 0 && cache->Resolve("ui.png") == "ui.png");
+
+	// 焼いたものが引け、ミップが書いたとおりに切り出せる
+	CHECK(cache->Initialize(directory.string()));
+	CHECK(cache->GetEntryCount() == 2);
+	CHECK(cache->Resolve("ui.png") == entry.cookedPath);
+	DdsTexture texture;
+	if (CHECK(cache->Open("ui.png", texture)) && CHECK(texture.GetMipCount() == mipCount)) {
+		for (uint32_t level = 0; level < mipCount; ++level) {
+			const DdsTexture::Level& read = texture.GetLevel(level);
+			CHECK(read.size == levels[level].size() && std::memcmp(read.data, levels[level].data(), read.size) == 0 && read.rowPitch * read.rowCount == read.size);
+		}
+	}
+	texture.Close();
+
+	// 焼いたファイルが無い・マニフェストに無い・止めたときは元画像
+	CHECK(cache->Resolve("missing.png") == "missing.png");
+	CHECK(cache->Resolve("other.png") == "other.png");
+	cache->SetEnabled(false);
+	CHECK(cache->Resolve("ui.png") == "ui.png");
+	cache->SetEnabled(true);
+
+	// 元画像のバイト数が変わった
+	WriteSource(sourcePath, content + "x", bakedTime);
+	CHECK(cache->Resolve("ui.png") == "ui.png");
+	CHECK(!cache->Open("ui.png", texture));
+
+	// バイト数を変えずに書き換えた（時刻は進む）
+	std::string edited = content;
+	edited[500] = 'y';
+	WriteSource(sourcePath, edited, bakedTime + std::chrono::minutes(5));
+	CHECK(cache->Resolve("ui.png") == "ui.png");
+	CHECK(!cache->Open("ui.png", texture));
+
+	// 中身は同じで時刻だけ変わった（チェックアウトし直したとき）
+	WriteSource(sourcePath, content, bakedTime + std::chrono::minutes(10));
+	CHECK(cache->Resolve("ui.png") == entry.cookedPath);
+	CHECK(cache->Open("ui.png", texture));
+	texture.Close();
+
+	// 時刻の無い古いマニフェストでも、中身で比べる
+	TextureCache::Entry untimed = entry;
+	untimed.sourceTime = 0;
+	writeManifest(untimed);
+	CHECK(cache->Initialize(directory.string()));
+	CHECK(cache->Resolve("ui.png") == entry.cookedPath);
+	WriteSource(sourcePath, edited, bakedTime);
+	CHECK(cache->Resolve("ui.png") == "ui.png");
+
+	// 元画像を同梱しないときは焼いたものだけで良い
+	std::filesystem::remove(sourcePath);
+	CHECK(cache->Resolve("ui.png") == entry.cookedPath);
+
+	// 焼いたファイルのバイト数が変わった
+	std::filesystem::resize_file(cookedPath, entry.cookedSize - 1);
+	CHECK(cache->Resolve("ui.png") == "ui.png");
+
+	cache->Initialize((directory / "none").string());
+	std::filesystem::remove_all(directory, errorCode);
+}
+
+} // namespace
+
+int main() {
+	TestManifestLine();
+	TestCrc32();
+	TestResolve();
+	return TestCheck::Finish();
+}
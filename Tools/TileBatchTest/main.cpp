@@ -0,0 +1,269 @@
+// ブロックのインスタンスバッファ（TileBatch）を確かめる
+// ・Build の後、インスタンスが列順（x 昇順 → 同じ列は上から）に並び、指定した種別のタイルがちょうど1回ずつ入るか
+// ・GetVisibleRange がマップの両端と空の列をまたぐ範囲で、総当たりで数えたものと一致するか
+// ・カメラから求めた範囲が、写る横幅（投影行列の画角と距離から）に余白を足したものになっているか
+// ・WriteWorldMatrix が、これまでの WorldTransform（WorldTransformUpdate）の行列と一致するか
+//
+// ビルド（Linux, リポジトリ直下で。描画はヘッドレス版エンジンで何もしない）:
+//   g++ -std=c++20 -O2 -pthread -I. -ITools/Headless Tools/TileBatchTest/main.cpp Tools/Headless/HeadlessEngine.cpp
+//       $(ls *.cpp | grep -v -E '^(main|SceneManager|TitleScene|TutorialScene|MakeAffineMatrix)\.cpp$') -o tileBatchTest
+// 実行（Resources/blocks.csv を読むのでリポジトリ直下で）:
+//   ./tileBatchTest
+// 全て期待どおりなら 0、そうでなければ 1 を返す
+#include "MapChipField.h"
+#include "TileBatch.h"
+#include "Tools/Common/TestCheck.h"
+#include "WorldTransformUpdater.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <numbers>
+#include <string>
+#include <vector>
+
+using namespace KamataEngine;
+
+namespace {
+
+// 両端にブロックがあり、途中に空の列（2, 3, 5 列目）があるマップ
+// 1 列目の下はゴール、5 列目の下は敵の出現位置（どちらもブロックではない）
+const char* const kEdgeMapCsv = "1,0,0,0,1,0,1\n"
+                                "1,1,0,0,0,0,1\n"
+                                "0,0,0,0,1,0,0\n"
+                                "1,2,0,0,1,3,1\n";
+
+/// <summary>
+/// 一時ファイルに書いたマップを読む
+/// </summary>
+/// <param name="csv"></param>
+/// <param name="mapChipField"></param>
+void LoadCsv(const char* csv, MapChipField& mapChipField) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "tileBatchTest.csv";
+	{
+		std::ofstream file(path);
+		file << csv;
+	}
+	mapChipField.LoadMapChipCsv(path.string());
+	std::filesystem::remove(path);
+}
+
+/// <summary>
+/// 総当たりで数えた [left, right] の範囲（先頭は left 以上の最初のインスタンス）
+/// </summary>
+TileBatch::Range LinearRange(const TileBatch& tileBatch, float left, float right) {
+	const std::vector<TileInstance>& instances = tileBatch.GetInstances();
+	TileBatch::Range range = {static_cast<uint32_t>(instances.size()), 0};
+	for (uint32_t i = 0; i < static_cast<uint32_t>(instances.size()); ++i) {
+		if (instances[i].x >= left) {
+			range.first = i;
+			break;
+		}
+	}
+	for (uint32_t i = range.first; i < static_cast<uint32_t>(instances.size()) && instances[i].x <= right; ++i) {
+		++range.count;
+	}
+	return range;
+}
+
+/// <summary>
+/// 並びと中身
+/// </summary>
+void TestBuildOrder(const MapChipField& mapChipField, MapChipType type) {
+	TileBatch tileBatch;
+	tileBatch.Build(mapChipField, type);
+
+	const std::vector<TileInstance>& instances = tileBatch.GetInstances();
+	const uint32_t width = mapChipField.GetNumBlockHorizontal();
+	const uint32_t height = mapChipField.GetNumBlockVirtical();
+	CHECK(tileBatch.GetTileCount() == width * height);
+	CHECK(tileBatch.GetNumBlockHorizontal() == width);
+
+	// 指定した種別のタイルがちょうど1回ずつ
+	std::vector<uint32_t> seen(static_cast<size_t>(width) * height, 0);
+	uint32_t expectedCount = 0;
+	for (uint32_t i = 0; i < height; ++i) {
+		for (uint32_t j = 0; j < width; ++j) {
+			expectedCount += mapChipField.GetMapChipTypeByIndex(j, i) == type ? 1 : 0;
+		}
+	}
+	CHECK(tileBatch.GetInstanceCount() == expectedCount);
+
+	bool isAllMatched = true;
+	bool isOrdered = true;
+	for (size_t i = 0; i < instances.size(); ++i) {
+		const TileInstance& instance = instances[i];
+		uint32_t xIndex = tileBatch.GetXIndex(instance);
+		uint32_t yIndex = tileBatch.GetYIndex(instance);
+		Vector3 position = mapChipField.GetMapChipPositionByIndex(xIndex, yIndex);
+
+		isAllMatched = isAllMatched && instance.tileIndex < seen.size() && mapChipField.GetMapChipTypeByIndex(xIndex, yIndex) == type;
+		isAllMatched = isAllMatched && instance.x == position.x && instance.y == position.y && instance.z == position.z;
+		if (instance.tileIndex < seen.size()) {
+			++seen[instance.tileIndex];
+		}
+
+		// 列 → 行の順（x は減らない）
+		if (i > 0) {
+			const TileInstance& previous = instances[i - 1];
+			uint32_t previousX = tileBatch.GetXIndex(previous);
+			uint32_t previousY = tileBatch.GetYIndex(previous);
+			isOrdered = isOrdered && previous.x <= instance.x && (previousX < xIndex || (previousX == xIndex && previousY < yIndex));
+		}
+	}
+	CHECK(isAllMatched);
+	CHECK(isOrdered);
+
+	bool isUnique = true;
+	for (uint32_t count : seen) {
+		isUnique = isUnique && count <= 1;
+	}
+	CHECK(isUnique);
+}
+
+/// <summary>
+/// 両端と空の列をまたぐ範囲
+/// </summary>
+void TestVisibleRange() {
+	MapChipField mapChipField;
+	LoadCsv(kEdgeMapCsv, mapChipField);
+	CHECK(mapChipField.GetNumBlockHorizontal() == 7 && mapChipField.GetNumBlockVirtical() == 4);
+
+	TestBuildOrder(mapChipField, MapChipType::kBlock);
+	TestBuildOrder(mapChipField, MapChipType::kGoal);
+
+	TileBatch tileBatch;
+	tileBatch.Build(mapChipField);
+	// 列ごとの数: 3, 1, 0, 0, 3, 0, 3
+	CHECK(tileBatch.GetInstanceCount() == 10);
+
+	auto isRange = [&](float left, float right, uint32_t first, uint32_t count) {
+		TileBatch::Range range = tileBatch.GetVisibleRange(left, right);
+		return range.first == first && range.count == count;
+	};
+
+	// 全体
+	CHECK(isRange(-100.0f, 100.0f, 0, 10));
+	// 左端（ちょうど中心まで・その手前まで）
+	CHECK(isRange(-5.0f, 0.0f, 0, 3));
+	CHECK(isRange(-5.0f, -0.5f, 0, 0));
+	// 右端
+	CHECK(isRange(6.0f, 50.0f, 7, 3));
+	CHECK(isRange(6.5f, 50.0f, 10, 0));
+	// 空の列だけ（先頭は次の列の頭）
+	CHECK(isRange(2.0f, 3.0f, 4, 0));
+	CHECK(isRange(1.5f, 3.5f, 4, 0));
+	CHECK(isRange(5.0f, 5.0f, 7, 0));
+	// 空の列をまたぐ
+	CHECK(isRange(1.0f, 4.0f, 3, 4));
+	CHECK(isRange(3.0f, 6.0f, 4, 6));
+	// 1列だけ
+	CHECK(isRange(4.0f, 4.0f, 4, 3));
+	// 左右が逆なら空
+	CHECK(tileBatch.GetVisibleRange(4.0f, 1.0f).count == 0);
+
+	// 半ブロック刻みの全ての組み合わせで総当たりと比べる
+	bool isAllMatched = true;
+	for (int32_t left = -4; left <= 16; ++left) {
+		for (int32_t right = left; right <= 16; ++right) {
+			TileBatch::Range range = tileBatch.GetVisibleRange(left * 0.5f - 0.5f, right * 0.5f - 0.5f);
+			TileBatch::Range expected = LinearRange(tileBatch, left * 0.5f - 0.5f, right * 0.5f - 0.5f);
+			isAllMatched = isAllMatched && range.count == expected.count && (range.count == 0 || range.first == expected.first);
+		}
+	}
+	CHECK(isAllMatched);
+
+	// 何も無いマップ
+	TileBatch empty;
+	empty.Build(mapChipField, MapChipType::kEnemySpawn);
+	CHECK(empty.GetInstanceCount() == 1);
+	empty.Build(MapChipField{});
+	CHECK(empty.GetInstanceCount() == 0 && empty.GetVisibleRange(-1.0f, 1.0f).count == 0);
+}
+
+/// <summary>
+/// カメラから求めた範囲
+/// </summary>
+void TestCameraRange() {
+	MapChipField mapChipField;
+	mapChipField.LoadMapChipCsv("Resources/blocks.csv");
+	TileBatch tileBatch;
+	tileBatch.Build(mapChipField);
+	CHECK(tileBatch.GetInstanceCount() > 0);
+
+	Camera camera;
+	camera.translation_ = {30.0f, 6.0f, -15.0f};
+	camera.UpdateMatrix();
+
+	// 画角 45 度・16:9 の投影で、15 離れた面の横幅の半分
+	float halfWidth = TileBatch::GetVisibleHalfWidth(camera, 0.0f);
+	float expectedHalfWidth = 15.0f * std::tan(std::numbers::pi_v<float> / 8.0f) * (1280.0f / 720.0f);
+	CHECK(std::fabs(halfWidth - expectedHalfWidth) < 1.0e-3f);
+
+	TileBatch::Range range = tileBatch.GetVisibleRange(camera);
+	TileBatch::Range expected = tileBatch.GetVisibleRange(camera.translation_.x - halfWidth - TileBatch::kVisibleMargin, camera.translation_.x + halfWidth + TileBatch::kVisibleMargin);
+	CHECK(range.first == expected.first && range.count == expected.count);
+	CHECK(range.count > 0 && range.count < tileBatch.GetInstanceCount());
+
+	// 一部でも写るブロックは全て範囲に入る
+	bool isAllCovered = true;
+	const std::vector<TileInstance>& instances = tileBatch.GetInstances();
+	for (uint32_t i = 0; i < static_cast<uint32_t>(instances.size()); ++i) {
+		bool isVisible = std::fabs(instances[i].x - camera.translation_.x) - 0.5f < halfWidth;
+		bool isInRange = i >= range.first && i < range.first + range.count;
+		isAllCovered = isAllCovered && (!isVisible || isInRange);
+	}
+	CHECK(isAllCovered);
+
+	// 離れると広くなる
+	camera.translation_.z = -30.0f;
+	camera.UpdateMatrix();
+	CHECK(std::fabs(TileBatch::GetVisibleHalfWidth(camera, 0.0f) - expectedHalfWidth * 2.0f) < 1.0e-3f);
+	CHECK(tileBatch.GetVisibleRange(camera).count > range.count);
+
+	// 面の向こう側にカメラがあれば求められないので全て
+	camera.translation_.z = 5.0f;
+	camera.UpdateMatrix();
+	CHECK(TileBatch::GetVisibleHalfWidth(camera, 0.0f) < 0.0f);
+	range = tileBatch.GetVisibleRange(camera);
+	CHECK(range.first == 0 && range.count == tileBatch.GetInstanceCount());
+}
+
+/// <summary>
+/// インスタンスの行列とこれまでの WorldTransform の行列
+/// </summary>
+void TestWorldMatrix() {
+	MapChipField mapChipField;
+	mapChipField.LoadMapChipCsv("Resources/blocks.csv");
+	TileBatch tileBatch;
+	tileBatch.Build(mapChipField);
+
+	bool isAllMatched = true;
+	for (const TileInstance& instance : tileBatch.GetInstances()) {
+		// これまでのブロック1個分と同じ作り方
+		WorldTransform worldTransform;
+		worldTransform.Initialize();
+		worldTransform.translation_ = mapChipField.GetMapChipPositionByIndex(tileBatch.GetXIndex(instance), tileBatch.GetYIndex(instance));
+		WorldTransformUpdate(worldTransform);
+
+		float matrix[16];
+		TileBatch::WriteWorldMatrix(instance, matrix);
+		for (int row = 0; row < 4; ++row) {
+			for (int column = 0; column < 4; ++column) {
+				isAllMatched = isAllMatched && std::fabs(matrix[row * 4 + column] - worldTransform.matWorld_.m[row][column]) < 1.0e-6f;
+			}
+		}
+	}
+	CHECK(isAllMatched);
+}
+
+} // namespace
+
+int main() {
+	TestVisibleRange();
+	TestCameraRange();
+	TestWorldMatrix();
+	return TestCheck::Finish();
+}
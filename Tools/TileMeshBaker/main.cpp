@@ -0,0 +1,108 @@
+// マップのブロックを1つの静的メッシュ（隠れた面を除き、同一平面の面をまとめたもの）に焼き、OBJ で書き出す
+// ゲームはブロックを TileBatch のインスタンス描画で出すので、これは確認・DCC ツールへの受け渡し用
+//
+// ビルド（リポジトリ直下で。Vector3 はヘッドレス版エンジンのもの）:
+//   g++ -std=c++20 -O2 -I. -ITools/Headless Tools/TileMeshBaker/main.cpp Tools/Common/TileMeshBuilder.cpp MapChipField.cpp -o tileMeshBaker
+// 実行（リポジトリ直下で）:
+//   ./tileMeshBaker [--map Resources/blocks.csv] [--out Resources/tileMesh] [--name tileMesh] [--no-merge]
+//
+// 出力:
+//   --out に 名前.obj / 名前.mtl と、mtl から参照する Atlas.png（Resources/block/Atlas.png の写し）
+//   メッシュが閉じていない・書き出しや写しに失敗したら何も残さず 1 を返す
+#include "MapChipField.h"
+#include "Tools/Common/TileMeshBuilder.h"
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <system_error>
+
+namespace {
+
+// 面の色に使うアトラス
+const char* const kAtlasPath = "Resources/block/Atlas.png";
+const char* const kAtlasFileName = "Atlas.png";
+
+// 設定
+struct Options {
+	std::string mapPath = "Resources/blocks.csv";
+	std::string outDirectory = "Resources/tileMesh";
+	std::string name = "tileMesh";
+	bool greedyMerge = true;
+};
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+	for (int i = 1; i < argc; ++i) {
+		std::string argument = argv[i];
+		if (argument == "--map" && i + 1 < argc) {
+			options.mapPath = argv[++i];
+		} else if (argument == "--out" && i + 1 < argc) {
+			options.outDirectory = argv[++i];
+		} else if (argument == "--name" && i + 1 < argc) {
+			options.name = argv[++i];
+		} else if (argument == "--no-merge") {
+			options.greedyMerge = false;
+		} else {
+			return false;
+		}
+	}
+	return !options.name.empty();
+}
+
+/// <summary>
+/// 書きかけのファイルを消す
+/// </summary>
+void RemoveOutputs(const Options& options) {
+	std::error_code errorCode;
+	std::filesystem::remove(options.outDirectory + "/" + options.name + ".obj", errorCode);
+	std::filesystem::remove(options.outDirectory + "/" + options.name + ".mtl", errorCode);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!ParseOptions(argc, argv, options)) {
+		std::fprintf(stderr, "usage: %s [--map file.csv] [--out directory] [--name name] [--no-merge]\n", argv[0]);
+		return 1;
+	}
+
+	// MapChipField は読めないと assert で止まるので先に確かめる
+	std::error_code errorCode;
+	if (!std::filesystem::is_regular_file(options.mapPath, errorCode)) {
+		std::fprintf(stderr, "cannot open %s\n", options.mapPath.c_str());
+		return 1;
+	}
+	MapChipField mapChipField;
+	mapChipField.LoadMapChipCsv(options.mapPath);
+
+	TileMeshBuilder::Options buildOptions;
+	buildOptions.greedyMerge = options.greedyMerge;
+	TileMesh mesh = TileMeshBuilder::Build(mapChipField, buildOptions);
+
+	std::printf("%s: %ux%u, %u blocks -> %u quads, %zu vertices, %zu indices, volume %.1f\n", options.mapPath.c_str(), mapChipField.GetNumBlockHorizontal(),
+	            mapChipField.GetNumBlockVirtical(), mesh.blockCount, mesh.quadCount, mesh.vertices.size(), mesh.indices.size(), TileMeshBuilder::ComputeVolume(mesh));
+
+	if (!TileMeshBuilder::IsWatertight(mesh)) {
+		std::fprintf(stderr, "mesh is not watertight\n");
+		return 1;
+	}
+
+	if (!TileMeshBuilder::WriteObj(mesh, options.outDirectory, options.name, kAtlasFileName)) {
+		std::fprintf(stderr, "cannot write %s/%s.obj\n", options.outDirectory.c_str(), options.name.c_str());
+		RemoveOutputs(options);
+		return 1;
+	}
+
+	std::string atlasPath = options.outDirectory + "/" + kAtlasFileName;
+	std::filesystem::copy_file(kAtlasPath, atlasPath, std::filesystem::copy_options::overwrite_existing, errorCode);
+	if (errorCode) {
+		std::fprintf(stderr, "cannot copy %s to %s: %s\n", kAtlasPath, atlasPath.c_str(), errorCode.message().c_str());
+		RemoveOutputs(options);
+		return 1;
+	}
+
+	std::printf("wrote %s/%s.obj\n", options.outDirectory.c_str(), options.name.c_str());
+	return 0;
+}
@@ -0,0 +1,169 @@
+// ブロックを焼き込んだメッシュ（TileMeshBuilder）を、形の決まった小さいマップで確かめる
+// ・面をまとめる・まとめないそれぞれで、四角形・頂点・インデックスの数がちょうど期待どおりか
+// ・T 字に突き合う面・角だけで接するブロック・穴のある形でも閉じた面と判定されるか
+// ・面を抜く・重ねる・裏返す・ずらすと閉じていないと判定されるか（ずらしても面積の総和と体積は変わらない）
+//
+// ビルド（リポジトリ直下で。Vector3 はヘッドレス版エンジンのもの）:
+//   g++ -std=c++20 -O2 -I. -ITools/Headless Tools/TileMeshTest/main.cpp Tools/Common/TileMeshBuilder.cpp MapChipField.cpp -o tileMeshTest
+// 実行（Resources/blocks.csv も読むのでリポジトリ直下で）:
+//   ./tileMeshTest
+// 全て期待どおりなら 0、そうでなければ 1 を返す
+#include "MapChipField.h"
+#include "Tools/Common/TestCheck.h"
+#include "Tools/Common/TileMeshBuilder.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <utility>
+
+namespace {
+
+// 形の決まったマップと、まとめる・まとめないときの四角形の数
+struct Shape {
+	const char* name;
+	const char* csv;
+	uint32_t blockCount;
+	uint32_t mergedQuads;
+	uint32_t unmergedQuads;
+};
+
+const Shape kShapes[] = {
+    {"single",   "1\n",                      1, 6,  6 },
+    {"row",      "1,1,1\n",                  3, 6,  14},
+    {"square",   "1,1\n1,1\n",               4, 6,  16},
+    // 左の列の前面が2段分の1枚になり、右下のブロックの面と T 字に突き合う
+    {"L",        "1,0\n1,1\n",               3, 10, 14},
+    // 角だけで接する（共有する辺に4枚の面が集まる）
+    {"diagonal", "1,0\n0,1\n",               2, 12, 12},
+    // 真ん中が空いた輪
+    {"ring",     "1,1,1\n1,0,1\n1,1,1\n",    8, 16, 32},
+    // ブロックの無いマップ
+    {"empty",    "0,2,3\n",                  0, 0,  0 },
+};
+
+/// <summary>
+/// 一時ファイルに書いたマップを読む
+/// </summary>
+void LoadCsv(const char* csv, MapChipField& mapChipField) {
+	std::filesystem::path path = std::filesystem::temp_directory_path() / "tileMeshTest.csv";
+	{
+		std::ofstream file(path);
+		file << csv;
+	}
+	mapChipField.LoadMapChipCsv(path.string());
+	std::filesystem::remove(path);
+}
+
+/// <summary>
+/// 数と閉じているか
+/// </summary>
+void TestShapes() {
+	for (const Shape& shape : kShapes) {
+		MapChipField mapChipField;
+		LoadCsv(shape.csv, mapChipField);
+
+		for (bool greedyMerge : {true, false}) {
+			TileMeshBuilder::Options options;
+			options.greedyMerge = greedyMerge;
+			TileMesh mesh = TileMeshBuilder::Build(mapChipField, options);
+
+			uint32_t quads = greedyMerge ? shape.mergedQuads : shape.unmergedQuads;
+			bool isPassed = true;
+			isPassed = CHECK(mesh.blockCount == shape.blockCount) && isPassed;
+			isPassed = CHECK(mesh.quadCount == quads) && isPassed;
+			isPassed = CHECK(mesh.vertices.size() == quads * 4) && isPassed;
+			isPassed = CHECK(mesh.indices.size() == quads * 6) && isPassed;
+			isPassed = CHECK(std::fabs(TileMeshBuilder::ComputeVolume(mesh) - static_cast<float>(shape.blockCount)) < 1.0e-4f) && isPassed;
+			isPassed = CHECK(TileMeshBuilder::IsWatertight(mesh)) && isPassed;
+			if (!isPassed) {
+				std::fprintf(stderr, "  shape %s (%s): %u quads, %zu vertices, %zu indices\n", shape.name, greedyMerge ? "merged" : "unmerged", mesh.quadCount, mesh.vertices.size(),
+				             mesh.indices.size());
+			}
+		}
+	}
+}
+
+/// <summary>
+/// 壊したメッシュ
+/// </summary>
+void TestBrokenMeshes() {
+	MapChipField mapChipField;
+	LoadCsv("1,0\n1,1\n", mapChipField);
+	const TileMesh mesh = TileMeshBuilder::Build(mapChipField, TileMeshBuilder::Options{});
+	CHECK(TileMeshBuilder::IsWatertight(mesh));
+
+	// 面を1枚抜く
+	TileMesh missing = mesh;
+	missing.indices.resize(missing.indices.size() - 6);
+	CHECK(!TileMeshBuilder::IsWatertight(missing));
+
+	// 面を1枚重ねる
+	TileMesh duplicated = mesh;
+	duplicated.indices.insert(duplicated.indices.end(), mesh.indices.begin(), mesh.indices.begin() + 6);
+	CHECK(!TileMeshBuilder::IsWatertight(duplicated));
+
+	// 三角形を1枚裏返す
+	TileMesh flipped = mesh;
+	std::swap(flipped.indices[1], flipped.indices[2]);
+	CHECK(!TileMeshBuilder::IsWatertight(flipped));
+
+	// 全体を裏返す（辺は組になるが体積が負になる）
+	TileMesh inverted = mesh;
+	for (size_t i = 0; i < inverted.indices.size(); i += 3) {
+		std::swap(inverted.indices[i + 1], inverted.indices[i + 2]);
+	}
+	CHECK(!TileMeshBuilder::IsWatertight(inverted));
+
+	// 半端なインデックス
+	TileMesh truncated = mesh;
+	truncated.indices.pop_back();
+	CHECK(!TileMeshBuilder::IsWatertight(truncated));
+
+	// 前面を1枚、同じ平面のまま横へずらす（面積の総和と体積は変わらないが、穴が開いて別の所に浮く）
+	MapChipField row;
+	LoadCsv("1,1,1\n", row);
+	TileMeshBuilder::Options unmerged;
+	unmerged.greedyMerge = false;
+	TileMesh shifted = TileMeshBuilder::Build(row, unmerged);
+	for (size_t quad = 0; quad < shifted.vertices.size() / 4; ++quad) {
+		if (shifted.vertices[quad * 4].normal[2] < 0.0f) {
+			for (size_t i = 0; i < 4; ++i) {
+				shifted.vertices[quad * 4 + i].position[0] += 10.0f;
+			}
+			break;
+		}
+	}
+	CHECK(std::fabs(TileMeshBuilder::ComputeVolume(shifted) - 3.0f) < 1.0e-4f);
+	CHECK(!TileMeshBuilder::IsWatertight(shifted));
+}
+
+/// <summary>
+/// ゲームのマップ
+/// </summary>
+void TestGameMap() {
+	MapChipField mapChipField;
+	mapChipField.LoadMapChipCsv("Resources/blocks.csv");
+
+	TileMeshBuilder::Options unmerged;
+	unmerged.greedyMerge = false;
+	TileMesh merged = TileMeshBuilder::Build(mapChipField, TileMeshBuilder::Options{});
+	TileMesh separate = TileMeshBuilder::Build(mapChipField, unmerged);
+
+	CHECK(merged.blockCount > 0 && merged.blockCount == separate.blockCount);
+	CHECK(merged.quadCount < separate.quadCount);
+	CHECK(TileMeshBuilder::IsWatertight(merged));
+	CHECK(TileMeshBuilder::IsWatertight(separate));
+	std::printf("blocks.csv: %u blocks, %u quads merged / %u unmerged\n", merged.blockCount, merged.quadCount, separate.quadCount);
+}
+
+} // namespace
+
+int main() {
+	TestShapes();
+	TestBrokenMeshes();
+	TestGameMap();
+	return TestCheck::Finish();
+}
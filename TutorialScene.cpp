@@ -1,11 +1,21 @@
 #define NOMINMAX
 #include "TutorialScene.h"
 #include "AABB.h"
+#include "AssetCache.h"
 #include "WorldTransformUpdater.h"
 #include "Random.h"
+#include "ScenePreloader.h"
+#include "UiAtlas.h"
 
 using namespace KamataEngine;
 
+namespace {
+
+// Initialize で AssetCache から取るモデル（SceneManager が切り替え前に読み込んでおく）
+const std::vector<std::string> kModelNames = {"player", "attackEffect", "goal", "block", "skyDome", "cloud"};
+
+} // namespace
+
 // ===== ユーティリティ =====
 float TutorialScene::Lerp(float a, float b, float t) { return a + (b - a) * t; }
 float TutorialScene::Smooth01(float t) {
@@ -28,37 +38,19 @@ void TutorialScene::ShowOnly(Sprite* target) {
 
 // ===== UIロード =====
 void TutorialScene::LoadUI() {
-	texMove_ = TextureManager::Load("text/tutorial/move.png");     // 「← → で移動」
-	texJump_ = TextureManager::Load("text/tutorial/jump.png");     // 「スペースでジャンプ」
-	texDone_ = TextureManager::Load("text/tutorial/done.png");     // 「完了！Enterで進む」
+	uiAtlas_.Initialize(UiAtlas::kData);
 
-	sprMove_ = Sprite::Create(texMove_, uiCenter_, {1, 1, 1, 1}, {0.5f, 0.5f});
-	sprJump_ = Sprite::Create(texJump_, uiCenter_, {1, 1, 1, 0}, {0.5f, 0.5f});
-	sprDone_ = Sprite::Create(texDone_, uiCenter_, {1, 1, 1, 0}, {0.5f, 0.5f});
+	sprMove_ = uiAtlas_.CreateSprite("text/tutorial/move.png", uiCenter_, {1, 1, 1, 1}, {0.5f, 0.5f}); // 「← → で移動」
+	sprJump_ = uiAtlas_.CreateSprite("text/tutorial/jump.png", uiCenter_, {1, 1, 1, 0}, {0.5f, 0.5f}); // 「スペースでジャンプ」
+	sprDone_ = uiAtlas_.CreateSprite("text/tutorial/done.png", uiCenter_, {1, 1, 1, 0}, {0.5f, 0.5f}); // 「完了！Enterで進む」
 }
 
 // ===== ブロック生成（GameSceneと同じ流儀） =====
 void TutorialScene::GenerateBlocks() {
-	modelBlock_ = Model::CreateFromOBJ("block", true);
-
-	uint32_t v = mapChipField_->GetNumBlockVirtical();
-	uint32_t h = mapChipField_->GetNumBlockHorizontal();
-
-	worldTransformBlocks_.resize(v);
-	for (uint32_t i = 0; i < v; ++i) {
-		worldTransformBlocks_[i].resize(h);
-	}
+	modelBlock_ = AssetCache::GetInstance()->AcquireModel("block", true);
 
-	for (uint32_t i = 0; i < v; ++i) {
-		for (uint32_t j = 0; j < h; ++j) {
-			if (mapChipField_->GetMapChipTypeByIndex(j, i) == MapChipType::kBlock) {
-				WorldTransform* wt = new WorldTransform();
-				wt->Initialize();
-				wt->translation_ = mapChipField_->GetMapChipPositionByIndex(j, i);
-				worldTransformBlocks_[i][j] = wt;
-			}
-		}
-	}
+	// Prepare で並べた順のまま連続配列に確保
+	blockTransforms_.Generate(blockBatch_);
 }
 
 // ===== ゴール検索（GameSceneの要点を踏襲） =====
@@ -78,7 +70,7 @@ void TutorialScene::FindAndPlaceGoal() {
 			break;
 	}
 
-	modelGoal_ = Model::CreateFromOBJ("goal", true);
+	modelGoal_ = AssetCache::GetInstance()->AcquireModel("goal", true);
 }
 
 // ===== 入力アクション検知（ゆるめ） =====
@@ -101,24 +93,19 @@ TutorialScene::~TutorialScene() {
 	delete fade_;
 
 	// プレイヤー関連
-	delete modelPlayer_;
-	delete modelAttack_;
+	AssetCache::GetInstance()->ReleaseModel(modelPlayer_);
+	AssetCache::GetInstance()->ReleaseModel(modelAttack_);
 	delete player_;
 
 	// マップ/ブロック
-	delete modelBlock_;
-	for (auto& line : worldTransformBlocks_) {
-		for (WorldTransform* wt : line) {
-			delete wt;
-		}
-	}
-	worldTransformBlocks_.clear();
+	AssetCache::GetInstance()->ReleaseModel(modelBlock_);
+	blockTransforms_.Clear();
 
 	// ゴール
-	delete modelGoal_;
+	AssetCache::GetInstance()->ReleaseModel(modelGoal_);
 
 	// 天球
-	delete modelSkydome_;
+	AssetCache::GetInstance()->ReleaseModel(modelSkydome_);
 	delete skydome_;
 
 	// マップ
@@ -133,7 +120,7 @@ TutorialScene::~TutorialScene() {
 	delete sprJump_;
 	delete sprDone_;
 
-	delete modelCloud_;
+	AssetCache::GetInstance()->ReleaseModel(modelCloud_);
 	modelCloud_ = nullptr;
 	for (size_t i = 0; i < worldTransformClouds_.size(); ++i) {
 		delete worldTransformClouds_[i];
@@ -141,20 +128,36 @@ TutorialScene::~TutorialScene() {
 	worldTransformClouds_.clear();
 }
 
+// 準備（ワーカースレッドで呼べる。GPUリソースには触れない）
+void TutorialScene::Prepare() {
+	// ===== マップ =====
+	mapChipField_ = new MapChipField;
+	// チュートリアル用CSVに差し替えてOK（無ければ blocks.csv で可）
+	mapChipField_->LoadMapChipCsv("Resources/tutorialBlocks.csv");
+
+	// ブロックを列順に並べる（トランスフォームは GenerateBlocks で確保）
+	blockBatch_.Build(*mapChipField_);
+
+	// モデルの読み込みはメインスレッドなので、ファイルだけ先に読んでおく
+	ScenePreloader::PrefetchModelFiles({"player", "attackEffect", "block", "goal", "skydome", "cloud"});
+
+	isPrepared_ = true;
+}
+
 void TutorialScene::Initialize() {
 	// ===== フェード =====
 	fade_ = new Fade();
 	fade_->Initialize();
 	fade_->Start(Fade::Status::FadeIn, duration_);
 
-	// ===== マップ =====
-	mapChipField_ = new MapChipField;
-	// チュートリアル用CSVに差し替えてOK（無ければ blocks.csv で可）
-	mapChipField_->LoadMapChipCsv("Resources/tutorialBlocks.csv");
+	// ===== マップ（準備がまだならここで） =====
+	if (!isPrepared_) {
+		Prepare();
+	}
 
 	// ===== プレイヤー =====
-	modelPlayer_ = Model::CreateFromOBJ("player", true);
-	modelAttack_ = Model::CreateFromOBJ("attackEffect", true);
+	modelPlayer_ = AssetCache::GetInstance()->AcquireModel("player", true);
+	modelAttack_ = AssetCache::GetInstance()->AcquireModel("attackEffect", true);
 
 	player_ = new Player();
 	// 開始位置（例：インデックス 5,15）。必要なら差し替え
@@ -169,7 +172,7 @@ void TutorialScene::Initialize() {
 	GenerateBlocks();
 
 	// ===== 天球 =====
-	modelSkydome_ = Model::CreateFromOBJ("skyDome", true);
+	modelSkydome_ = AssetCache::GetInstance()->AcquireModel("skyDome", true);
 	skydome_ = new Skydome();
 	skydome_->Initialize(modelSkydome_, &camera_);
 
@@ -193,10 +196,10 @@ void TutorialScene::Initialize() {
 	///===========================================
 	/// 雲（背景）
 	///===========================================
-	modelCloud_ = Model::CreateFromOBJ("cloud", true);
+	modelCloud_ = AssetCache::GetInstance()->AcquireModel("cloud", true);
 
-	// 乱数エンジン初期化（毎回同じ配置で良いなら省略可）
-	Random::SeedEngine();
+	// 背景配置用の列（シードは Random::SetGlobalSeed で決まる）
+	Random::Stream& random = Random::GetStream(Random::System::kScenery);
 
 	// マップの横幅から X 範囲を決める（左右に少し余白）
 	uint32_t mapW = mapChipField_->GetNumBlockHorizontal();
@@ -221,11 +224,11 @@ void TutorialScene::Initialize() {
 		WorldTransform* wt = new WorldTransform();
 		wt->Initialize();
 
-		// ランダム座標とスケール（Random::GeneraterFloat(min, max) を使用）
-		float x = Random::GeneraterFloat(xMin, xMax);
-		float y = Random::GeneraterFloat(yMin, yMax);
-		float z = Random::GeneraterFloat(zMin, zMax);
-		float s = Random::GeneraterFloat(sMin, sMax);
+		// ランダム座標とスケール
+		float x = random.NextFloat(xMin, xMax);
+		float y = random.NextFloat(yMin, yMax);
+		float z = random.NextFloat(zMin, zMax);
+		float s = random.NextFloat(sMin, sMax);
 
 		wt->translation_ = {x, y, z};
 		wt->scale_ = {s, s, 1.0f};
@@ -235,7 +238,6 @@ void TutorialScene::Initialize() {
 
 	// （必要ならスケール設定も同様に：wt0->scale_ = {8,8,1}; など）
 
-	Random::SeedEngine(); // 乱数エンジン初期化
 
 	// ===== UI =====
 	LoadUI();
@@ -261,17 +263,32 @@ void TutorialScene::Update() {
 	}
 }
 
+// ===== Initialize で AssetCache から取るモデル =====
+const std::vector<std::string>& TutorialScene::GetModelNames() const { return kModelNames; }
+
+// ===== やり直し（確保済みのものを使い回して最初のステップへ） =====
+void TutorialScene::Reset() {
+	isFinished_ = false;
+	phase_ = Phase::kFadeIn;
+	step_ = Step::kMove;
+	fade_->Start(Fade::Status::FadeIn, duration_);
+
+	// プレイヤーを開始位置へ
+	player_->Reset(mapChipField_->GetMapChipPositionByIndex(5, 15));
+	cameraController_->Reset();
+
+	// 本編と入れ替わりで使うので、軸表示の対象を戻す
+	AxisIndicator::GetInstance()->SetVisible(true);
+	AxisIndicator::GetInstance()->SetTargetCamera(&debugCamera_->GetCamera());
+
+	ShowOnly(sprMove_); // 最初は移動ヒント
+}
+
 // ---- フェーズ別 ----
 void TutorialScene::UpdateFadeIn() {
 	fade_->Update();
 	// 背景の最低限の行列更新
-	for (auto& line : worldTransformBlocks_) {
-		for (WorldTransform* wt : line) {
-			if (!wt)
-				continue;
-			WorldTransformUpdate(*wt);
-		}
-	}
+	blockTransforms_.Update();
 	if (hasGoal_) {
 		WorldTransformUpdate(worldTransformGoal_);
 	}
@@ -290,6 +307,7 @@ void TutorialScene::UpdateRun() {
 #endif
 
 	// ===== プレイヤー/カメラ =====
+	player_->SetInput(PlayerInput::FromKeyboard());
 	player_->Update();
 
 	if (isDebugCameraActive_) {
@@ -306,13 +324,7 @@ void TutorialScene::UpdateRun() {
 	skydome_->Update();
 
 	// ===== ブロック行列更新 =====
-	for (auto& line : worldTransformBlocks_) {
-		for (WorldTransform* wt : line) {
-			if (!wt)
-				continue;
-			WorldTransformUpdate(*wt);
-		}
-	}
+	blockTransforms_.Update();
 	if (hasGoal_) {
 		WorldTransformUpdate(worldTransformGoal_);
 	}
@@ -347,13 +359,7 @@ void TutorialScene::UpdateFadeOut() {
 
 	// 最低限の更新（見た目維持）
 	skydome_->Update();
-	for (auto& line : worldTransformBlocks_) {
-		for (WorldTransform* wt : line) {
-			if (!wt)
-				continue;
-			WorldTransformUpdate(*wt);
-		}
-	}
+	blockTransforms_.Update();
 	if (hasGoal_) {
 		WorldTransformUpdate(worldTransformGoal_);
 	}
@@ -369,13 +375,7 @@ void TutorialScene::Draw() {
 	Model::PreDraw();
 
 	// ブロック
-	for (auto& line : worldTransformBlocks_) {
-		for (WorldTransform* wt : line) {
-			if (!wt)
-				continue;
-			modelBlock_->Draw(*wt, camera_);
-		}
-	}
+	blockTransforms_.Draw(modelBlock_, camera_);
 
 	// ゴール
 	if (hasGoal_) {
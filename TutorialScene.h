@@ -1,12 +1,15 @@
 #pragma once
+#include "BaseScene.h"
+#include "BlockTransforms.h"
 #include "CameraController.h"
 #include "Fade.h"
 #include "KamataEngine.h"
 #include "MapChipField.h"
 #include "Player.h"
 #include "Skydome.h"
+#include "SpriteAtlas.h"
 
-class TutorialScene {
+class TutorialScene : public BaseScene {
 public:
 	// シーンのフェーズ
 	enum class Phase { kFadeIn, kRun, kFadeOut };
@@ -25,6 +28,7 @@ private:
 
 	// ===== フラグ / 状態 =====
 	bool isFinished_ = false;
+	bool isPrepared_ = false;
 	Phase phase_ = Phase::kFadeIn;
 	Step step_ = Step::kMove;
 
@@ -36,7 +40,8 @@ private:
 	// ===== マップ =====
 	MapChipField* mapChipField_ = nullptr;
 	KamataEngine::Model* modelBlock_ = nullptr;
-	std::vector<std::vector<KamataEngine::WorldTransform*>> worldTransformBlocks_;
+	TileBatch blockBatch_;
+	BlockTransforms blockTransforms_;
 
 	// ===== ゴール =====
 	KamataEngine::Model* modelGoal_ = nullptr;
@@ -56,10 +61,8 @@ private:
 	CameraController* cameraController_ = nullptr;
 
 	// ===== UI（説明スプライト） =====
-	// 画像は任意：text/tutorial/*.png を想定。無ければ任意のパスに差し替え可
-	uint32_t texMove_ = 0;
-	uint32_t texJump_ = 0;
-	uint32_t texDone_ = 0;
+	// 画像は text/tutorial/*.png（文字の画像のアトラスから。差し替えたら Tools/AtlasPacker で作り直す）
+	SpriteAtlas uiAtlas_;
 
 	KamataEngine::Sprite* sprMove_ = nullptr;
 	KamataEngine::Sprite* sprJump_ = nullptr;
@@ -97,9 +100,12 @@ private:
 	void UpdateFadeOut();
 
 public:
-	~TutorialScene();
-	void Initialize();
-	void Update();
-	void Draw();
-	bool IsFinished() const { return isFinished_; }
+	~TutorialScene() override;
+	void Prepare() override;
+	void Initialize() override;
+	void Reset() override;
+	const std::vector<std::string>& GetModelNames() const override;
+	void Update() override;
+	void Draw() override;
+	bool IsFinished() const override { return isFinished_; }
 };
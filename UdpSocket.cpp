@@ -0,0 +1,244 @@
+#include "UdpSocket.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <WinSock2.h>
+#include <WS2tcpip.h>
+#include <mstcpip.h>
+#pragma comment(lib, "ws2_32.lib")
+#else
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <cstdlib>
+
+namespace {
+
+/// <summary>
+/// sockaddr_in に詰める
+/// </summary>
+sockaddr_in ToSockaddr(const UdpSocket::Address& address) {
+	sockaddr_in result{};
+	result.sin_family = AF_INET;
+	result.sin_addr.s_addr = htonl(address.host);
+	result.sin_port = htons(address.port);
+	return result;
+}
+
+#ifdef _WIN32
+
+/// <summary>
+/// WinSock の初期化（最初に開くときに1回だけ）
+/// </summary>
+bool StartupWinSock() {
+	static const bool isStarted = []() {
+		WSADATA data{};
+		return WSAStartup(MAKEWORD(2, 2), &data) == 0;
+	}();
+	return isStarted;
+}
+
+#endif
+
+} // namespace
+
+/// <summary>
+/// "127.0.0.1:7000" の形式から作る
+/// </summary>
+bool UdpSocket::Address::Parse(const std::string& text, Address& address) {
+	size_t colon = text.rfind(':');
+	if (colon == std::string::npos) {
+		return false;
+	}
+
+	in_addr host{};
+	if (inet_pton(AF_INET, text.substr(0, colon).c_str(), &host) != 1) {
+		return false;
+	}
+
+	int port = std::atoi(text.c_str() + colon + 1);
+	if (port <= 0 || port > 0xFFFF) {
+		return false;
+	}
+
+	address.host = ntohl(host.s_addr);
+	address.port = static_cast<uint16_t>(port);
+	return true;
+}
+
+/// <summary>
+/// デストラクタ
+/// </summary>
+UdpSocket::~UdpSocket() { Close(); }
+
+#ifdef _WIN32
+
+/// <summary>
+/// 開く
+/// </summary>
+bool UdpSocket::Open(uint16_t port) {
+	Close();
+
+	if (!StartupWinSock()) {
+		return false;
+	}
+
+	SOCKET handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (handle == INVALID_SOCKET) {
+		return false;
+	}
+
+	sockaddr_in bindAddress{};
+	bindAddress.sin_family = AF_INET;
+	bindAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+	bindAddress.sin_port = htons(port);
+	u_long isNonBlocking = 1;
+	if (bind(handle, reinterpret_cast<const sockaddr*>(&bindAddress), sizeof(bindAddress)) != 0 || ioctlsocket(handle, FIONBIO, &isNonBlocking) != 0) {
+		closesocket(handle);
+		return false;
+	}
+
+	// 相手がまだ開いていないときの ICMP で受信が失敗し続けないように
+	BOOL isReported = FALSE;
+	DWORD bytesReturned = 0;
+	WSAIoctl(handle, SIO_UDP_CONNRESET, &isReported, sizeof(isReported), nullptr, 0, &bytesReturned, nullptr, nullptr);
+
+	sockaddr_in boundAddress{};
+	int boundSize = sizeof(boundAddress);
+	getsockname(handle, reinterpret_cast<sockaddr*>(&boundAddress), &boundSize);
+
+	socket_ = static_cast<uintptr_t>(handle);
+	port_ = ntohs(boundAddress.sin_port);
+	return true;
+}
+
+/// <summary>
+/// 閉じる
+/// </summary>
+void UdpSocket::Close() {
+	if (IsOpen()) {
+		closesocket(static_cast<SOCKET>(socket_));
+	}
+	socket_ = static_cast<uintptr_t>(INVALID_SOCKET);
+	port_ = 0;
+}
+
+/// <summary>
+/// 送る
+/// </summary>
+bool UdpSocket::Send(const Address& to, const void* data, size_t size) {
+	if (!IsOpen()) {
+		return false;
+	}
+	sockaddr_in address = ToSockaddr(to);
+	int sent = sendto(static_cast<SOCKET>(socket_), static_cast<const char*>(data), static_cast<int>(size), 0, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+	return sent == static_cast<int>(size);
+}
+
+/// <summary>
+/// 届いているものを1つ受け取る
+/// </summary>
+size_t UdpSocket::Receive(Address& from, void* buffer, size_t capacity) {
+	if (!IsOpen()) {
+		return 0;
+	}
+	sockaddr_in address{};
+	int addressSize = sizeof(address);
+	int received = recvfrom(static_cast<SOCKET>(socket_), static_cast<char*>(buffer), static_cast<int>(capacity), 0, reinterpret_cast<sockaddr*>(&address), &addressSize);
+	// 何も無い（WSAEWOULDBLOCK）・大きすぎて切られた（WSAEMSGSIZE）ものは無かったことにする
+	if (received <= 0) {
+		return 0;
+	}
+	from.host = ntohl(address.sin_addr.s_addr);
+	from.port = ntohs(address.sin_port);
+	return static_cast<size_t>(received);
+}
+
+/// <summary>
+/// 開いているか
+/// </summary>
+bool UdpSocket::IsOpen() const { return socket_ != static_cast<uintptr_t>(INVALID_SOCKET); }
+
+#else
+
+/// <summary>
+/// 開く
+/// </summary>
+bool UdpSocket::Open(uint16_t port) {
+	Close();
+
+	int handle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (handle < 0) {
+		return false;
+	}
+
+	sockaddr_in bindAddress{};
+	bindAddress.sin_family = AF_INET;
+	bindAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+	bindAddress.sin_port = htons(port);
+	if (bind(handle, reinterpret_cast<const sockaddr*>(&bindAddress), sizeof(bindAddress)) != 0 || fcntl(handle, F_SETFL, fcntl(handle, F_GETFL, 0) | O_NONBLOCK) != 0) {
+		close(handle);
+		return false;
+	}
+
+	sockaddr_in boundAddress{};
+	socklen_t boundSize = sizeof(boundAddress);
+	getsockname(handle, reinterpret_cast<sockaddr*>(&boundAddress), &boundSize);
+
+	socket_ = handle;
+	port_ = ntohs(boundAddress.sin_port);
+	return true;
+}
+
+/// <summary>
+/// 閉じる
+/// </summary>
+void UdpSocket::Close() {
+	if (IsOpen()) {
+		close(socket_);
+	}
+	socket_ = -1;
+	port_ = 0;
+}
+
+/// <summary>
+/// 送る
+/// </summary>
+bool UdpSocket::Send(const Address& to, const void* data, size_t size) {
+	if (!IsOpen()) {
+		return false;
+	}
+	sockaddr_in address = ToSockaddr(to);
+	ssize_t sent = sendto(socket_, data, size, 0, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+	return sent == static_cast<ssize_t>(size);
+}
+
+/// <summary>
+/// 届いているものを1つ受け取る
+/// </summary>
+size_t UdpSocket::Receive(Address& from, void* buffer, size_t capacity) {
+	if (!IsOpen()) {
+		return 0;
+	}
+	sockaddr_in address{};
+	socklen_t addressSize = sizeof(address);
+	ssize_t received = recvfrom(socket_, buffer, capacity, 0, reinterpret_cast<sockaddr*>(&address), &addressSize);
+	// 何も無い（EAGAIN）・相手がまだ開いていない（ECONNREFUSED）ものは無かったことにする
+	if (received <= 0) {
+		return 0;
+	}
+	from.host = ntohl(address.sin_addr.s_addr);
+	from.port = ntohs(address.sin_port);
+	return static_cast<size_t>(received);
+}
+
+/// <summary>
+/// 開いているか
+/// </summary>
+bool UdpSocket::IsOpen() const { return socket_ >= 0; }
+
+#endif
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/// <summary>
+/// ノンブロッキングの UDP ソケット（IPv4 のみ）
+/// </summary>
+class UdpSocket {
+public:
+	/// <summary>
+	/// 送り先・送り元（ホストのバイト順）
+	/// </summary>
+	struct Address {
+		uint32_t host = 0;
+		uint16_t port = 0;
+
+		/// <summary>
+		/// "127.0.0.1:7000" の形式から作る
+		/// </summary>
+		/// <param name="text"></param>
+		/// <param name="address"></param>
+		/// <returns>読めたか</returns>
+		static bool Parse(const std::string& text, Address& address);
+		/// <summary>
+		/// 127.0.0.1 の指定ポート
+		/// </summary>
+		/// <param name="port"></param>
+		/// <returns></returns>
+		static Address Loopback(uint16_t port) { return Address{0x7F000001u, port}; }
+
+		bool operator==(const Address& other) const { return host == other.host && port == other.port; }
+		bool operator!=(const Address& other) const { return !(*this == other); }
+	};
+
+	// IPv4 + UDP のヘッダの大きさ（帯域の見積もり用）
+	static inline const uint32_t kHeaderBytes = 28;
+
+private:
+#ifdef _WIN32
+	uintptr_t socket_ = ~static_cast<uintptr_t>(0);
+#else
+	int socket_ = -1;
+#endif
+
+	// 実際に開いたポート
+	uint16_t port_ = 0;
+
+public:
+	UdpSocket() = default;
+	~UdpSocket();
+	UdpSocket(const UdpSocket&) = delete;
+	UdpSocket& operator=(const UdpSocket&) = delete;
+
+	/// <summary>
+	/// 開く
+	/// </summary>
+	/// <param name="port">受け付けるポート（0 なら空いているものを使う）</param>
+	/// <returns>成功したか</returns>
+	bool Open(uint16_t port);
+	/// <summary>
+	/// 閉じる
+	/// </summary>
+	void Close();
+
+	/// <summary>
+	/// 送る（送れなかったものは捨てる。UDP なので届くとは限らない）
+	/// </summary>
+	/// <param name="to"></param>
+	/// <param name="data"></param>
+	/// <param name="size"></param>
+	/// <returns>送れたか</returns>
+	bool Send(const Address& to, const void* data, size_t size);
+	/// <summary>
+	/// 届いているものを1つ受け取る（待たない）
+	/// </summary>
+	/// <param name="from"></param>
+	/// <param name="buffer"></param>
+	/// <param name="capacity"></param>
+	/// <returns>受け取った大きさ（無ければ 0）</returns>
+	size_t Receive(Address& from, void* buffer, size_t capacity);
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	bool IsOpen() const;
+	uint16_t GetPort() const { return port_; }
+};
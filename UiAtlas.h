@@ -0,0 +1,26 @@
+// Tools/AtlasPacker で生成（手で書き換えない）
+#pragma once
+#include "SpriteAtlas.h"
+
+/// <summary>
+/// アトラスに詰めた画像の表（maxrects、9 枚 → 1 ページ）
+/// </summary>
+struct UiAtlas {
+	static inline const SpriteAtlasPage kPages[1] = {
+	    {"text/uiAtlas0.png", 2048, 1024},
+	};
+	// 名前順（SpriteAtlas::Find が二分探索する）
+	//  名前, ページ, x, y, 幅, 高さ, 元画像の中の x, y, 元画像の幅, 高さ, UV
+	static inline const SpriteAtlasEntry kEntries[9] = {
+	    {"text/backTitleText.png", 0, 701, 926, 696, 96, 16, 105, 720, 300, 0.342285f, 0.904297f, 0.682129f, 0.998047f},
+	    {"text/clear.png", 0, 2, 659, 697, 268, 0, 21, 720, 300, 0.000977f, 0.643555f, 0.341309f, 0.905273f},
+	    {"text/gameStartText.png", 0, 1338, 499, 622, 142, 50, 26, 720, 200, 0.653320f, 0.487305f, 0.957031f, 0.625977f},
+	    {"text/startText.png", 0, 2, 394, 753, 263, 34, 26, 800, 300, 0.000977f, 0.384766f, 0.368652f, 0.641602f},
+	    {"text/tutorial/attack.png", 0, 817, 2, 1092, 242, 51, 50, 1200, 300, 0.398926f, 0.001953f, 0.932129f, 0.238281f},
+	    {"text/tutorial/done.png", 0, 2, 2, 813, 390, 101, 41, 1000, 512, 0.000977f, 0.001953f, 0.397949f, 0.382812f},
+	    {"text/tutorial/jump.png", 0, 817, 246, 1088, 251, 53, 28, 1200, 300, 0.398926f, 0.240234f, 0.930176f, 0.485352f},
+	    {"text/tutorial/move.png", 0, 701, 659, 969, 265, 27, 21, 1000, 300, 0.342285f, 0.643555f, 0.815430f, 0.902344f},
+	    {"text/tutorialText.png", 0, 757, 499, 579, 144, 82, 34, 720, 200, 0.369629f, 0.487305f, 0.652344f, 0.627930f},
+	};
+	static inline const SpriteAtlasData kData = {kPages, 1, kEntries, 9};
+};
@@ -0,0 +1,147 @@
+#include "VersusSimulation.h"
+#include "MapChipField.h"
+#include "Profiler.h"
+#include <cassert>
+
+using namespace KamataEngine;
+
+/// <summary>
+/// デストラクタ
+/// </summary>
+VersusSimulation::~VersusSimulation() {
+	for (Player*& player : players_) {
+		delete player;
+		player = nullptr;
+	}
+}
+
+/// <summary>
+/// 初期化
+/// </summary>
+void VersusSimulation::Initialize(MapChipField* mapChipField, Model* modelPlayer, Model* modelAttack, Camera* camera) {
+	assert(mapChipField);
+
+	mapChipField_ = mapChipField;
+
+	// ゴールを探す（最初に見つかった1つ）
+	hasGoal_ = false;
+	for (uint32_t y = 0; y < mapChipField_->GetNumBlockVirtical() && !hasGoal_; ++y) {
+		for (uint32_t x = 0; x < mapChipField_->GetNumBlockHorizontal(); ++x) {
+			if (mapChipField_->GetMapChipTypeByIndex(x, y) == MapChipType::kGoal) {
+				Vector3 position = mapChipField_->GetMapChipPositionByIndex(x, y);
+				goal_.min = {position.x - kGoalWidth * 0.5f, position.y - kGoalHeight * 0.5f, position.z - kGoalWidth * 0.5f};
+				goal_.max = {position.x + kGoalWidth * 0.5f, position.y + kGoalHeight * 0.5f, position.z + kGoalWidth * 0.5f};
+				hasGoal_ = true;
+				break;
+			}
+		}
+	}
+
+	for (uint32_t i = 0; i < kPlayerCount; ++i) {
+		if (!players_[i]) {
+			players_[i] = new Player();
+		}
+		players_[i]->Initialize(modelPlayer, modelAttack, camera, mapChipField_->GetMapChipPositionByIndex(kStartIndices[i][0], kStartIndices[i][1]));
+		players_[i]->SetMapChipField(mapChipField_);
+	}
+
+	Reset();
+}
+
+/// <summary>
+/// 開始時の状態に戻す
+/// </summary>
+void VersusSimulation::Reset() {
+	for (uint32_t i = 0; i < kPlayerCount; ++i) {
+		players_[i]->Reset(mapChipField_->GetMapChipPositionByIndex(kStartIndices[i][0], kStartIndices[i][1]));
+		players_[i]->UpdateMatricesOnly();
+	}
+	frame_ = 0;
+	result_ = Result::kNone;
+}
+
+/// <summary>
+/// 1フレーム進める
+/// </summary>
+/// <param name="inputs"></param>
+void VersusSimulation::Step(const Inputs& inputs) {
+	PROFILE_ZONE("VersusSimulation::Step");
+
+	++frame_;
+	if (result_ != Result::kNone) {
+		return;
+	}
+
+	// 番号順に動かす（互いに当たらないので順番は結果に影響しないが、固定しておく）
+	for (uint32_t i = 0; i < kPlayerCount; ++i) {
+		players_[i]->SetInput(inputs[i]);
+		players_[i]->Update();
+	}
+
+	if (!hasGoal_) {
+		return;
+	}
+
+	// ゴール判定（同じフレームに着いたら引き分け）
+	bool isReached[kPlayerCount] = {};
+	for (uint32_t i = 0; i < kPlayerCount; ++i) {
+		isReached[i] = IsAABBCollision(players_[i]->GetAABB(), goal_);
+	}
+	if (isReached[0] && isReached[1]) {
+		result_ = Result::kDraw;
+	} else if (isReached[0]) {
+		result_ = Result::kPlayer1;
+	} else if (isReached[1]) {
+		result_ = Result::kPlayer2;
+	}
+}
+
+/// <summary>
+/// 状態を記録に書く
+/// </summary>
+/// <param name="snapshot"></param>
+void VersusSimulation::SaveState(SimulationSnapshot& snapshot) const {
+	snapshot.Begin();
+
+	State state;
+	state.frame = frame_;
+	state.result = result_;
+	snapshot.Write(state);
+
+	for (const Player* player : players_) {
+		player->SaveState(snapshot);
+	}
+}
+
+/// <summary>
+/// 状態を記録から戻す
+/// </summary>
+/// <param name="snapshot"></param>
+/// <returns>戻せたか</returns>
+bool VersusSimulation::LoadState(const SimulationSnapshot& snapshot) {
+	SimulationSnapshot::Reader reader(snapshot);
+	if (!snapshot.BeginRead(reader)) {
+		return false;
+	}
+
+	State state;
+	reader.Read(state);
+	frame_ = state.frame;
+	result_ = state.result;
+
+	for (Player* player : players_) {
+		player->LoadState(reader);
+	}
+
+	assert(reader.IsEnd());
+	return true;
+}
+
+/// <summary>
+/// 描画
+/// </summary>
+void VersusSimulation::Draw() {
+	for (Player* player : players_) {
+		player->Draw();
+	}
+}
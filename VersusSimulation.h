@@ -0,0 +1,105 @@
+#pragma once
+#include "AABB.h"
+#include "KamataEngine.h"
+#include "Player.h"
+#include "PlayerInput.h"
+#include "SimulationSnapshot.h"
+
+#include <array>
+#include <cstdint>
+
+class MapChipField;
+
+/// <summary>
+/// 2人対戦（ゴールへの競争）のシミュレーション部分
+/// 入力だけで進み、乱数・時刻・キーボードを読まないので、同じ入力列を与えればどのマシンでも同じ結果になる
+/// </summary>
+class VersusSimulation {
+public:
+	// 人数
+	static inline const uint32_t kPlayerCount = 2;
+
+	// 結果
+	enum class Result : uint32_t {
+		kNone,     // 決着前
+		kPlayer1,  // 1P の勝ち
+		kPlayer2,  // 2P の勝ち
+		kDraw,     // 同じフレームに到着
+	};
+
+	using Inputs = std::array<PlayerInput, kPlayerCount>;
+
+private:
+	// 開始位置（マップのインデックス）
+	static inline const uint32_t kStartIndices[kPlayerCount][2] = {{5, 15}, {3, 15}};
+	// ゴールの当たり判定の大きさ（GameScene と同じ）
+	static inline const float kGoalWidth = 1.0f;
+	static inline const float kGoalHeight = 1.0f;
+
+	// マップ（持たない）
+	MapChipField* mapChipField_ = nullptr;
+
+	std::array<Player*, kPlayerCount> players_ = {};
+
+	// ゴール
+	AABB goal_ = {};
+	bool hasGoal_ = false;
+
+	// 進めたフレーム数
+	uint32_t frame_ = 0;
+	// 結果
+	Result result_ = Result::kNone;
+
+	// 記録に書く状態（プレイヤー以外）
+	struct State {
+		uint32_t frame;
+		Result result;
+	};
+
+public:
+	/// <summary>
+	/// デストラクタ
+	/// </summary>
+	~VersusSimulation();
+
+	/// <summary>
+	/// 初期化（マップ上のゴールを探して、2人を開始位置に置く）
+	/// </summary>
+	/// <param name="mapChipField"></param>
+	/// <param name="modelPlayer"></param>
+	/// <param name="modelAttack"></param>
+	/// <param name="camera"></param>
+	void Initialize(MapChipField* mapChipField, KamataEngine::Model* modelPlayer, KamataEngine::Model* modelAttack, KamataEngine::Camera* camera);
+
+	/// <summary>
+	/// 開始時の状態に戻す
+	/// </summary>
+	void Reset();
+
+	/// <summary>
+	/// 1フレーム進める（決着後はフレーム数だけ進む）
+	/// </summary>
+	/// <param name="inputs">全員のこのフレームの入力</param>
+	void Step(const Inputs& inputs);
+
+	/// <summary>
+	/// 状態を記録に書く / 記録から戻す
+	/// </summary>
+	/// <param name="snapshot"></param>
+	void SaveState(SimulationSnapshot& snapshot) const;
+	bool LoadState(const SimulationSnapshot& snapshot);
+
+	/// <summary>
+	/// 描画
+	/// </summary>
+	void Draw();
+
+	/// <summary>
+	/// ゲッター
+	/// </summary>
+	/// <returns></returns>
+	Player* GetPlayer(uint32_t index) const { return players_[index]; }
+	uint32_t GetFrame() const { return frame_; }
+	Result GetResult() const { return result_; }
+	bool IsFinished() const { return result_ != Result::kNone; }
+};
@@ -1,39 +1,17 @@
-#include "GameScene.h"
+#include "AllocationTracker.h"
+#include "AssetCache.h"
+#include "FrameStats.h"
+#include "JobSystem.h"
 #include "KamataEngine.h"
-#include "TitleScene.h"
-#include "TutorialScene.h"
+#include "Profiler.h"
+#include "Random.h"
+#include "SceneManager.h"
+#include "TextureCache.h"
 #include <Windows.h>
+#include <chrono>
 
 using namespace KamataEngine;
 
-GameScene* gameScene = nullptr;
-TitleScene* titleScene = nullptr;
-TutorialScene* tutorialScene = nullptr;
-
-enum class Scene {
-	kUnknown = 0,
-
-	kTitle,
-	kTutorial,
-	kGame
-};
-
-// 現在のシーン
-Scene scene = Scene::kUnknown;
-
-/// <summary>
-/// シーンの切り替え処理
-/// </summary>
-void ChangeScene();
-/// <summary>
-/// シーンの更新
-/// </summary>
-void UpdateScene();
-/// <summary>
-/// シーンの描画
-/// </summary>
-void DrawScene();
-
 // Windowsアプリでのエントリーポイント(main関数)
 int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 
@@ -41,11 +19,23 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 
 	DirectXCommon* dxCommon = DirectXCommon::GetInstance();
 
+	PROFILE_THREAD_NAME("main");
+
+	// ジョブシステム（コア数 - 1 のワーカー。メインスレッドも待つ間はジョブを手伝う）
+	JobSystem::GetInstance()->Initialize();
+
+	// 乱数のシード（起動ごとに変える。再現したいときは固定値を渡す）
+	Random::SetGlobalSeed(Random::MakeNondeterministicSeed());
+
+	// 焼いたテクスチャのマニフェスト（Tools/TextureBaker。無ければ元画像を読む）
+	TextureCache::GetInstance()->Initialize("Resources");
+
 	// 最初のシーンの初期化
-	scene = Scene::kTitle;
+	SceneManager* sceneManager = new SceneManager;
+	sceneManager->Initialize(SceneManager::Scene::kTitle);
 
-	titleScene = new TitleScene;
-	titleScene->Initialize();
+	// 前のフレームの開始時刻（フレーム間隔の計測用）
+	std::chrono::steady_clock::time_point previousFrameStart = std::chrono::steady_clock::now();
 
 	// メインループ
 	while (true) {
@@ -54,153 +44,64 @@ int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
 			break;
 		}
 
-		// シーン切り替え
-		ChangeScene();
-		// 現在シーンの更新
-		UpdateScene();
+		PROFILE_ZONE("Frame");
+
+		// 前のフレームの確保を締めて、定常状態なら検査する
+		AllocationTracker::GetInstance()->BeginFrame();
+
+		// フレーム間隔（垂直同期待ちを含む）
+		std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+		FrameStats::GetInstance()->Record("Frame.Interval", std::chrono::duration<double, std::milli>(frameStart - previousFrameStart).count());
+		previousFrameStart = frameStart;
+
+		// F10 でフレーム統計を書き出す
+		if (Input::GetInstance()->TriggerKey(DIK_F10)) {
+			FrameStats::GetInstance()->WriteCsv("frame_stats.csv");
+		}
+
+		// F8 でジョブを1スレッドで順番に実行する（デバッグ用。もう一度押すと戻る）
+		if (Input::GetInstance()->TriggerKey(DIK_F8)) {
+			JobSystem::GetInstance()->SetSingleThreaded(!JobSystem::GetInstance()->IsSingleThreaded());
+		}
+
+#ifdef PROFILER_ENABLED
+		// F9 で計測結果を書き出す（chrome://tracing や Perfetto で開く）
+		if (Input::GetInstance()->TriggerKey(DIK_F9)) {
+			Profiler::GetInstance()->WriteChromeTrace("profile_trace.json");
+		}
+#endif
+
+		// シーン切り替えと現在シーンの更新
+		sceneManager->Update();
 
 		// 描画前処理
 		dxCommon->PreDraw();
 
 		// 現在のシーンを描画
-		DrawScene();
+		sceneManager->Draw();
 
 		AxisIndicator::GetInstance()->Draw();
 
+		// 垂直同期待ちを含まない、CPU側の処理時間
+		FrameStats::GetInstance()->Record("Frame.Cpu", std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - frameStart).count());
+
 		// 描画後処理
 		dxCommon->PostDraw();
 	}
 
-	KamataEngine::Finalize();
-
-	delete tutorialScene;
-	delete titleScene;
-	delete gameScene;
-
-	return 0;
-}
-
-/// <summary>
-/// シーンの切り替え処理
-/// </summary>
-void ChangeScene() {
-	switch (scene) {
-	case Scene::kTitle: {
-		auto* in = Input::GetInstance();
-
-		// --- main内だけで選択を完了させるホットキー ---
-		// 1 or G -> 本編 / 2 or T -> チュートリアル
-		if (in->TriggerKey(DIK_1) || in->TriggerKey(DIK_G)) {
-			scene = Scene::kGame;
-
-			delete titleScene;
-			titleScene = nullptr;
-			gameScene = new GameScene;
-			gameScene->Initialize();
-			break;
-		}
-		if (in->TriggerKey(DIK_2) || in->TriggerKey(DIK_T)) {
-			scene = Scene::kTutorial;
-
-			delete titleScene;
-			titleScene = nullptr;
-			tutorialScene = new TutorialScene;
-			tutorialScene->Initialize();
-			break;
-		}
+	// 終了時にもフレーム統計を書き出す
+	FrameStats::GetInstance()->WriteCsv("frame_stats.csv");
 
-		// --- 既存の TitleScene 側の終了判定にも対応（従来互換）---
-		if (titleScene && titleScene->IsFinished()) {
-			// 何も指定が無ければデフォルトは本編へ
-			scene = Scene::kGame;
+	// シーンの解放（準備中のシーンがあれば終わるまで待つ）
+	delete sceneManager;
 
-			delete titleScene;
-			titleScene = nullptr;
-			gameScene = new GameScene;
-			gameScene->Initialize();
-		}
-	} break;
-
-	case Scene::kTutorial:
-		if (tutorialScene && tutorialScene->IsFinished()) {
-			// チュートリアル終了後はタイトルへ戻す
-			scene = Scene::kTitle;
-
-			delete tutorialScene;
-			tutorialScene = nullptr;
-			titleScene = new TitleScene;
-			titleScene->Initialize();
-
-			// ※もしチュートリアル直後に本編へ進めたいなら、上の4行を以下に置き換え:
-			// scene = Scene::kGame;
-			// delete tutorialScene; tutorialScene = nullptr;
-			// gameScene = new GameScene; gameScene->Initialize();
-		}
-		break;
+	// ワーカーを止める
+	JobSystem::GetInstance()->Finalize();
 
-	case Scene::kGame:
-		if (gameScene && gameScene->IsFinished()) {
-			// 本編終了 → タイトルへ
-			scene = Scene::kTitle;
-
-			delete gameScene;
-			gameScene = nullptr;
-			titleScene = new TitleScene;
-			titleScene->Initialize();
-		}
-		break;
-
-	default:
-		break;
-	}
-}
+	// 共有アセットはエンジンより先に解放
+	AssetCache::GetInstance()->Finalize();
 
-/// <summary>
-/// シーンの更新
-/// </summary>
-void UpdateScene() {
-	switch (scene) {
-	case Scene::kTitle:
-		if (titleScene) {
-			titleScene->Update();
-		}
-		break;
-	case Scene::kTutorial:
-		if (tutorialScene) {
-			tutorialScene->Update();
-		}
-		break;
-	case Scene::kGame:
-		if (gameScene) {
-			gameScene->Update();
-		}
-		break;
-	default:
-		break;
-	}
-}
+	KamataEngine::Finalize();
 
-/// <summary>
-/// シーンの描画
-/// </summary>
-void DrawScene() {
-	switch (scene) {
-	case Scene::kTitle:
-		if (titleScene) {
-			titleScene->Draw();
-		}
-		break;
-	case Scene::kTutorial:
-		if (tutorialScene) {
-			tutorialScene->Draw();
-		}
-		break;
-	case Scene::kGame:
-		if (gameScene) {
-			gameScene->Draw();
-		}
-		break;
-	default:
-		break;
-	}
+	return 0;
 }